@@ -16,6 +16,7 @@ found in the LICENSE file.
 #include <mitkDataStorage.h>
 #include <mitkPlaneGeometry.h>
 #include <mitkPlaneGeometryData.h>
+#include <mitkPropertyKey.h>
 #include <mitkTimeGeometry.h>
 
 #include <mitkCameraController.h>
@@ -328,6 +329,15 @@ namespace mitk
       return m_Name.c_str();
     }
 
+    /**
+     * \brief Return the name of the base renderer as interned key, e.g. to identify
+     * its renderer-specific property lists without string comparisons.
+     */
+    const PropertyKey& GetNameKey() const
+    {
+      return m_NameKey;
+    }
+
     /**
      * \brief Return the size in x-direction of the base renderer.
      */
@@ -488,6 +498,7 @@ namespace mitk
     unsigned long m_CurrentWorldPlaneGeometryTransformTime;
 
     std::string m_Name;
+    PropertyKey m_NameKey;
 
     double m_Bounds[6];
 
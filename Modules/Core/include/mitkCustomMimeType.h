@@ -17,11 +17,14 @@ found in the LICENSE file.
 
 #include <mitkServiceInterface.h>
 
+#include <cstddef>
 #include <string>
+#include <utility>
 #include <vector>
 
 namespace mitk
 {
+  class FileHeader;
   class MimeType;
 
   /**
@@ -44,6 +47,9 @@ namespace mitk
   class MITKCORE_EXPORT CustomMimeType
   {
   public:
+    /** \brief Offset and byte sequence identifying a file format. */
+    typedef std::pair<std::size_t, std::string> MagicBytesType;
+
     CustomMimeType();
     CustomMimeType(const std::string &name);
     CustomMimeType(const CustomMimeType &other);
@@ -105,12 +111,34 @@ namespace mitk
     */
     std::string GetFilenameWithoutExtension(const std::string &path) const;
 
+    /**
+    * \brief Returns all byte sequences that identify files of this MimeType.
+    */
+    std::vector<MagicBytesType> GetMagicBytes() const;
+
+    /**
+    * \brief Checks if the header of a file contains any of the magic bytes of this MimeType
+    *
+    * Returns true if no magic bytes are declared.
+    */
+    bool MatchesMagicBytes(const FileHeader &header) const;
+
     void SetName(const std::string &name);
     void SetCategory(const std::string &category);
     void SetExtension(const std::string &extension);
     void AddExtension(const std::string &extension);
     void SetComment(const std::string &comment);
 
+    /**
+    * \brief Declares a byte sequence found at the given offset in every file of this MimeType.
+    *
+    * Mime types with magic bytes are only considered for existing files whose header contains
+    * any of their sequences. mitk::MimeTypeProvider checks this for all mime types in a single pass
+    * over the file header, before AppliesTo() is called. Only declare magic bytes that are mandatory
+    * for the format, files without them are not going to be opened with this MimeType anymore.
+    */
+    void AddMagicBytes(const std::string &bytes, std::size_t offset = 0);
+
     void Swap(CustomMimeType &r);
 
     virtual CustomMimeType *Clone() const;
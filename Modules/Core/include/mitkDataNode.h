@@ -23,6 +23,7 @@ found in the LICENSE file.
 #include <iostream>
 
 #include "mitkColorProperty.h"
+#include "mitkPropertyKey.h"
 #include "mitkPropertyList.h"
 #include "mitkStringProperty.h"
 //#include "mitkMapper.h"
@@ -30,7 +31,10 @@ found in the LICENSE file.
 #include "mitkGeometry3D.h"
 #include "mitkLevelWindow.h"
 #include <map>
+#include <mutex>
 #include <set>
+#include <tuple>
+#include <typeinfo>
 
 class vtkLinearTransform;
 
@@ -269,6 +273,34 @@ namespace mitk
       return property != nullptr;
     }
 
+    /**
+     * \brief Get the property with the interned key \a propertyKey in the same way as
+     * GetProperty(const char*, const mitk::BaseRenderer*, bool) const.
+     *
+     * The result of the lookup is cached per key and renderer. A cached result stays valid until a property
+     * is added to, replaced in or removed from one of the involved property lists (see
+     * PropertyList::GetKeysMTime()), or the data of this node is exchanged. Changes of property values do not
+     * invalidate the cache. Hence, repeated lookups do not involve any string comparisons, which makes this
+     * overload the preferred choice for code that is executed per rendered frame (e.g. mappers).
+     */
+    mitk::BaseProperty *GetProperty(const PropertyKey &propertyKey,
+                                    const mitk::BaseRenderer *renderer = nullptr,
+                                    bool fallBackOnDataProperties = true) const;
+
+    /**
+     * \brief Get the property of type T with the interned key \a propertyKey.
+     *
+     * In addition to the lookup, the type check of the found property is cached as well.
+     * \sa GetProperty(const PropertyKey&, const mitk::BaseRenderer*, bool) const
+     */
+    template <typename T>
+    bool GetProperty(T *&property, const PropertyKey &propertyKey, const mitk::BaseRenderer *renderer = nullptr) const
+    {
+      property = static_cast<T *>(this->GetCachedProperty(
+        propertyKey, renderer, true, typeid(T), [](BaseProperty *p) -> void * { return dynamic_cast<T *>(p); }));
+      return property != nullptr;
+    }
+
     /**
      * \brief Convenience access method for GenericProperty<T> properties
      * (T being the type of the second parameter)
@@ -296,6 +328,12 @@ namespace mitk
      */
     bool GetBoolProperty(const char *propertyKey, bool &boolValue, const mitk::BaseRenderer *renderer = nullptr) const;
 
+    /**
+     * \brief Convenience access method for bool properties with an interned key
+     * \return \a true property was found
+     */
+    bool GetBoolProperty(const PropertyKey &propertyKey, bool &boolValue, const mitk::BaseRenderer *renderer = nullptr) const;
+
     /**
      * \brief Convenience access method for int properties (instances of
      * IntProperty)
@@ -303,6 +341,12 @@ namespace mitk
      */
     bool GetIntProperty(const char *propertyKey, int &intValue, const mitk::BaseRenderer *renderer = nullptr) const;
 
+    /**
+     * \brief Convenience access method for int properties with an interned key
+     * \return \a true property was found
+     */
+    bool GetIntProperty(const PropertyKey &propertyKey, int &intValue, const mitk::BaseRenderer *renderer = nullptr) const;
+
     /**
      * \brief Convenience access method for float properties (instances of
      * FloatProperty)
@@ -312,6 +356,14 @@ namespace mitk
                           float &floatValue,
                           const mitk::BaseRenderer *renderer = nullptr) const;
 
+    /**
+     * \brief Convenience access method for float properties with an interned key
+     * \return \a true property was found
+     */
+    bool GetFloatProperty(const PropertyKey &propertyKey,
+                          float &floatValue,
+                          const mitk::BaseRenderer *renderer = nullptr) const;
+
     /**
      * \brief Convenience access method for double properties (instances of
      * DoubleProperty)
@@ -341,6 +393,12 @@ namespace mitk
      */
     bool GetColor(float rgb[3], const mitk::BaseRenderer *renderer = nullptr, const char *propertyKey = "color") const;
 
+    /**
+     * \brief Convenience access method for color properties with an interned key
+     * \return \a true property was found
+     */
+    bool GetColor(float rgb[3], const mitk::BaseRenderer *renderer, const PropertyKey &propertyKey) const;
+
     /**
      * \brief Convenience access method for level-window properties (instances of
      * LevelWindowProperty)
@@ -451,6 +509,21 @@ namespace mitk
      */
     bool GetOpacity(float &opacity, const mitk::BaseRenderer *renderer, const char *propertyKey = "opacity") const;
 
+    /**
+     * \brief Convenience access method for opacity properties with an interned key
+     * \return \a true property was found
+     */
+    bool GetOpacity(float &opacity, const mitk::BaseRenderer *renderer, const PropertyKey &propertyKey) const;
+
+    /**
+     * \brief Convenience access method for visibility properties with an interned key
+     * \return \a true property was found
+     */
+    bool GetVisibility(bool &visible, const mitk::BaseRenderer *renderer, const PropertyKey &propertyKey) const
+    {
+      return GetBoolProperty(propertyKey, visible, renderer);
+    }
+
     /**
      * \brief Convenience access method for boolean properties (instances
      * of BoolProperty). Return value is the value of the property. If the property is
@@ -486,6 +559,16 @@ namespace mitk
       return IsOn(propertyKey, renderer, defaultIsOn);
     }
 
+    /**
+     * \brief Convenience access method for visibility properties with an interned key
+     * \sa IsVisible(const mitk::BaseRenderer*, const char*, bool) const
+     */
+    bool IsVisible(const mitk::BaseRenderer *renderer, const PropertyKey &propertyKey, bool defaultIsOn = true) const
+    {
+      GetBoolProperty(propertyKey, defaultIsOn, renderer);
+      return defaultIsOn;
+    }
+
     /**
      * \brief Convenience method for setting color properties (instances of
      * ColorProperty)
@@ -583,6 +666,19 @@ namespace mitk
     /// Invoked when the property list was modified. Calls Modified() of the DataNode
     virtual void PropertyListModified(const itk::Object *caller, const itk::EventObject &event);
 
+    using PropertyCastFunction = void *(*)(BaseProperty *);
+
+    /**
+     * \brief Looks up a property via the lookup cache and returns the result of \a cast applied to it.
+     *
+     * The result of \a cast is cached as well and reused as long as it is requested for the same \a type.
+     */
+    void *GetCachedProperty(const PropertyKey &propertyKey,
+                            const mitk::BaseRenderer *renderer,
+                            bool fallBackOnDataProperties,
+                            const std::type_info &type,
+                            PropertyCastFunction cast) const;
+
     /// \brief Mapper-slots
     mutable MapperVector m_Mappers;
 
@@ -609,6 +705,26 @@ namespace mitk
     itk::TimeStamp m_DataReferenceChangedTime;
 
     unsigned long m_PropertyListModifiedObserverTag;
+
+  private:
+    struct CachedPropertyLookup
+    {
+      const PropertyList *RendererPropertyList = nullptr;
+      const PropertyList *DataPropertyList = nullptr;
+      BaseProperty *Property = nullptr;
+      const std::type_info *CastType = nullptr;
+      void *CastProperty = nullptr;
+      itk::TimeStamp LookupTime;
+    };
+
+    bool IsValid(const CachedPropertyLookup &lookup, const mitk::BaseRenderer *renderer, bool fallBackOnDataProperties) const;
+
+    /// \brief Cached lookups by property key id, renderer name id and fallBackOnDataProperties
+    mutable std::map<std::tuple<PropertyKey::IdType, PropertyKey::IdType, bool>, CachedPropertyLookup> m_PropertyLookupCache;
+    mutable std::mutex m_PropertyLookupCacheMutex;
+
+    /// \brief Timestamp of the last time a PropertyList was added to m_MapOfPropertyLists
+    mutable itk::TimeStamp m_MapOfPropertyListsModifiedTime;
   };
 
   MITKCORE_EXPORT std::istream &operator>>(std::istream &i, DataNode::Pointer &dtn);
@@ -36,6 +36,14 @@ namespace mitk
    * mitk::ExtractSliceFilter. It is more robust, easy to use, and produces
    * an mitk::Image with valid geometry. Generally it is not as fast as
    * mitk::ExtractSliceFilter, though.
+   *
+   * Enable fast resampling (see SetFastResampling()) for interactive use. In
+   * this mode, nearest neighbor and linear interpolation are done by dedicated
+   * kernels that split the output into blocks of rows processed in parallel.
+   * Each row is walked by incremental stepping in continuous index space
+   * instead of transforming every single pixel. Results match the default
+   * path except for floating-point rounding at pixel and image borders.
+   * Cubic interpolation is not affected by this setting.
    */
   class MITKCORE_EXPORT ExtractSliceFilter2 final : public ImageToImageFilter
   {
@@ -60,6 +68,9 @@ namespace mitk
     Interpolator GetInterpolator() const;
     void SetInterpolator(Interpolator interpolator);
 
+    bool GetFastResampling() const;
+    void SetFastResampling(bool fastResampling);
+
   private:
     using Superclass::SetInput;
 
@@ -67,8 +78,6 @@ namespace mitk
     ~ExtractSliceFilter2() override;
 
     void AllocateOutputs() override;
-    // void BeforeThreadedGenerateData() override;
-    // void ThreadedGenerateData(const OutputImageRegionType& outputRegionForThread, itk::ThreadIdType threadId) override;
     void GenerateData() override;
     void VerifyInputInformation() const override;
 
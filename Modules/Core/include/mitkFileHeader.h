@@ -0,0 +1,87 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef mitkFileHeader_h
+#define mitkFileHeader_h
+
+#include <MitkCoreExports.h>
+
+#include <cstddef>
+#include <memory>
+#include <string>
+
+namespace mitk
+{
+  /**
+   * @ingroup IO
+   *
+   * @brief The first bytes of a file, read once and shared by everyone who needs to peek into the file.
+   *
+   * Mime types and file readers should use this class instead of opening a file themselves when they
+   * only need to look at its beginning (magic bytes, text headers, ...). While a FileHeader::Scope exists,
+   * headers are reused on the current thread, so determining the format of a file results in a single read
+   * even if many mime types and readers are involved. Without a scope, every call of Read() reads the file.
+   *
+   * Instances are immutable and cheap to copy. It is safe to read headers from multiple threads.
+   */
+  class MITKCORE_EXPORT FileHeader
+  {
+  public:
+    /**
+     * \brief Reuses the headers read by the current thread while it exists.
+     *
+     * A scope should only span a single determination of the format of a file, e.g. the construction
+     * of a FileReaderSelector, since changes of the file are not noticed within it. Scopes can be nested.
+     */
+    class MITKCORE_EXPORT Scope
+    {
+    public:
+      Scope();
+      ~Scope();
+
+      Scope(const Scope &) = delete;
+      Scope &operator=(const Scope &) = delete;
+    };
+
+    /** \brief Constructs an invalid header. */
+    FileHeader();
+
+    /**
+     * \brief Returns the header of the regular file at the given (local 8-bit encoded) path.
+     *
+     * At most GetMaximumSize() bytes are read. The returned header is invalid if the path
+     * does not refer to a readable regular file. Within a Scope, the header that was read
+     * before for the same path is returned.
+     */
+    static FileHeader Read(const std::string &path);
+
+    /** \brief Number of bytes that are read from the beginning of a file (64 KiB). */
+    static std::size_t GetMaximumSize();
+
+    bool IsValid() const;
+
+    /** \brief True if the header contains the whole file. */
+    bool IsComplete() const;
+
+    std::size_t GetSize() const;
+    const char *GetData() const;
+
+    /** \brief Checks if the header contains the given bytes at the given offset. */
+    bool Matches(const std::string &bytes, std::size_t offset = 0) const;
+
+  private:
+    struct Impl;
+    std::shared_ptr<const Impl> m_Data;
+  };
+}
+
+#endif
@@ -49,6 +49,12 @@ namespace mitk
 
     virtual std::vector<MimeType> GetMimeTypes() const = 0;
 
+    /**
+     * @brief Get all mime types that apply to the given file, sorted by descending rank.
+     *
+     * If the path refers to an existing file, mime types which declare magic bytes
+     * (see CustomMimeType::AddMagicBytes()) are only returned if the file header contains them.
+     */
     virtual std::vector<MimeType> GetMimeTypesForFile(const std::string &filePath) const = 0;
 
     virtual std::vector<MimeType> GetMimeTypesForCategory(const std::string &category) const = 0;
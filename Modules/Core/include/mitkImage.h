@@ -28,6 +28,9 @@ found in the LICENSE file.
 #include <itkHistogram.h>
 #endif
 
+#include <atomic>
+#include <condition_variable>
+
 class vtkImageData;
 
 namespace itk
@@ -610,10 +613,44 @@ namespace mitk
 
     /** A mutex, which needs to be locked to manage m_Readers and m_Writers */
     mutable std::mutex m_ReadWriteLock;
+
+    /** Number of ImageReadAccessors with ImageAccessorBase::SharedReadAccess. They are not stored in m_Readers. */
+    mutable std::atomic<unsigned int> m_SharedReaderCount;
+    /** Number of ImageWriteAccessors that hold or wait for write access. Shared readers wait while it is not 0. */
+    mutable std::atomic<unsigned int> m_WriterCount;
+    /** Notifies accessors waiting for a change of m_SharedReaderCount or m_WriterCount (used with m_ReadWriteLock) */
+    mutable std::condition_variable m_SharedAccessCondition;
     /** A mutex, which needs to be locked to manage m_VtkReaders */
     mutable std::mutex m_VtkReadersLock;
   };
 
+  /**
+  * @brief Event that is invoked by an image after a part of its pixels was written directly (e.g. a slice written
+  * by a segmentation tool or its undo operation).
+  *
+  * The event is invoked after Modified() was called. It carries the time step and a world geometry that encloses the
+  * modified voxels, so observers (e.g. incremental statistics) do not have to rescan the whole image.
+  */
+  class MITKCORE_EXPORT ImageRegionModifiedEvent : public itk::AnyEvent
+  {
+  public:
+    typedef ImageRegionModifiedEvent Self;
+    typedef itk::AnyEvent Superclass;
+    ImageRegionModifiedEvent(TimeStepType timeStep = 0, const BaseGeometry *geometry = nullptr)
+      : m_TimeStep(timeStep), m_Geometry(geometry) {}
+    ImageRegionModifiedEvent(const Self &s) : Superclass(s), m_TimeStep(s.m_TimeStep), m_Geometry(s.m_Geometry) {}
+    ~ImageRegionModifiedEvent() override {}
+    const char *GetEventName() const override { return "ImageRegionModifiedEvent"; }
+    bool CheckEvent(const ::itk::EventObject *e) const override { return dynamic_cast<const Self *>(e); }
+    ::itk::EventObject *MakeObject() const override { return new Self(m_TimeStep, m_Geometry); }
+    TimeStepType GetTimeStep() const { return m_TimeStep; }
+    const BaseGeometry *GetGeometry() const { return m_Geometry; }
+  private:
+    TimeStepType m_TimeStep;
+    BaseGeometry::ConstPointer m_Geometry;
+    void operator=(const Self &);
+  };
+
   /**
   * @brief Equal A function comparing two images for being equal in meta- and imagedata
   *
@@ -76,7 +76,12 @@ namespace mitk
          time.*/
       ForceCoherentMemory = 2,
       /** Ignores the lock mechanism for immediate access. Only possible with read accessors. */
-      IgnoreLock = 4
+      IgnoreLock = 4,
+      /** Shared read access to the whole image, which excludes all write accessors instead of overlapping ones.
+         Such readers are only counted atomically and do not lock any mutex unless a write accessor holds or waits
+         for access, so many threads can read concurrently. Only possible with read accessors. A thread must not
+         request write access to an image it holds shared read access for.*/
+      SharedReadAccess = 8
     };
 
     virtual ~ImageAccessorBase();
@@ -141,6 +146,14 @@ namespace mitk
     /** \brief Prevents a recursive mutex lock by comparing thread ids of competing image accessors */
     void PreventRecursiveMutexLock(ImageAccessorBase *iAB);
 
+    /** \brief Remembers that the current thread holds shared read access to the image (see SharedReadAccess) */
+    static void AddSharedReadAccessOfCurrentThread(const Image *image);
+    static void RemoveSharedReadAccessOfCurrentThread(const Image *image);
+
+    /** \brief Checks if the current thread holds shared read access to the image, which a write request of the
+     * same thread would wait for forever */
+    static bool HasSharedReadAccessOfCurrentThread(const Image *image);
+
     virtual const Image *GetImage() const = 0;
 
   private:
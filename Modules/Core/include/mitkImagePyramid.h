@@ -0,0 +1,108 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef mitkImagePyramid_h
+#define mitkImagePyramid_h
+
+#include <MitkCoreExports.h>
+#include <mitkImage.h>
+
+#include <itkFixedArray.h>
+
+#include <map>
+#include <utility>
+#include <vector>
+
+namespace mitk
+{
+  /**
+   * \brief Lazily built multiresolution pyramid of the time steps of an image.
+   *
+   * Level 0 is the image itself. The target spacing of level l is 2^l times the smallest spacing of the
+   * image, i.e., each axis is shrunk by the largest integral factor that does not exceed this spacing, so
+   * the finer axes of anisotropic images are reduced first. Voxels are averaged over the shrunk blocks or,
+   * if averaging is disabled (e.g. for binary images), sub-sampled.
+   *
+   * New levels are added as long as the largest extent of the previous level exceeds the minimum size.
+   * A level is only computed when it is requested for a time step and it is recomputed as soon as the image
+   * was modified.
+   *
+   * \sa ImageVtkMapper2D, which reslices large images at display resolution while the user interacts.
+   */
+  class MITKCORE_EXPORT ImagePyramid : public itk::Object
+  {
+  public:
+    mitkClassMacroItkParent(ImagePyramid, itk::Object);
+    itkFactorylessNewMacro(Self);
+
+    using ShrinkFactorsType = itk::FixedArray<unsigned int, 3>;
+
+    void SetImage(const Image *image);
+    const Image *GetImage() const;
+
+    /** \brief Levels are only added while the previous level is larger than this size in any direction (default 512).*/
+    void SetMinimumSize(unsigned int minimumSize);
+    itkGetConstMacro(MinimumSize, unsigned int);
+
+    /** \brief Average the voxels of each shrunk block (default) or pick the first one.*/
+    void SetAveraging(bool averaging);
+    itkGetConstMacro(Averaging, bool);
+    itkBooleanMacro(Averaging);
+
+    unsigned int GetNumberOfLevels() const;
+
+    /** \brief Factors by which the axes of the image are shrunk in the given level.*/
+    ShrinkFactorsType GetShrinkFactors(unsigned int level) const;
+
+    /** \brief Returns the coarsest level whose spacing does not exceed the given size of a displayed pixel (in mm).*/
+    unsigned int GetLevelForResolution(ScalarType mmPerPixel) const;
+
+    /**
+     * \brief Returns the given level of a time step of the image, which is computed if necessary.
+     *
+     * Level 0 is the image itself. The other levels are images with a single time step that cover the
+     * same region of space as the time step they were computed from.
+     */
+    const Image *GetLevel(unsigned int level, TimeStepType timeStep);
+
+    /** \brief Releases the memory of all computed levels.*/
+    void ReleaseLevels();
+
+  protected:
+    ImagePyramid();
+    ~ImagePyramid() override;
+
+    void PrintSelf(std::ostream &os, itk::Indent indent) const override;
+
+  private:
+    itk::ModifiedTimeType GetImageMTime(TimeStepType timeStep) const;
+    void UpdateShrinkFactors() const;
+    Image::Pointer ComputeLevel(unsigned int level, TimeStepType timeStep) const;
+
+    struct Level
+    {
+      Image::Pointer LevelImage;
+      itk::ModifiedTimeType ImageMTime = 0;
+    };
+
+    Image::ConstPointer m_Image;
+    unsigned int m_MinimumSize;
+    bool m_Averaging;
+
+    mutable ScalarType m_MinimumSpacing;
+    mutable std::vector<ShrinkFactorsType> m_ShrinkFactors;
+    mutable itk::ModifiedTimeType m_ShrinkFactorsMTime;
+    std::map<std::pair<unsigned int, TimeStepType>, Level> m_Levels;
+  };
+}
+
+#endif
@@ -63,6 +63,12 @@ namespace mitk
     /** \brief manages a consistent read access and locks the ordered image part */
     void OrganizeReadAccess();
 
+    /** \brief registers a reader with ImageAccessorBase::SharedReadAccess, waits while write accessors exist */
+    void OrganizeSharedReadAccess();
+
+    /** \brief unregisters a reader with ImageAccessorBase::SharedReadAccess and notifies waiting write accessors */
+    void ReleaseSharedReadAccess();
+
     ImageReadAccessor &operator=(const ImageReadAccessor &); // Not implemented on purpose.
     ImageReadAccessor(const ImageReadAccessor &);
 
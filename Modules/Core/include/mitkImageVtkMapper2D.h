@@ -19,6 +19,7 @@ found in the LICENSE file.
 // MITK Rendering
 #include "mitkBaseRenderer.h"
 #include "mitkExtractSliceFilter.h"
+#include "mitkImagePyramid.h"
 #include "mitkVtkMapper.h"
 
 // VTK
@@ -88,6 +89,12 @@ namespace mitk
    *   - \b "texture interpolation": (BoolProperty) texture interpolation of the image
    *   - \b "reslice interpolation": (VtkResliceInterpolationProperty) reslice interpolation of the image
    *   - \b "in plane resample extent by geometry": (BoolProperty) Do it or not
+   *   - \b "Image Rendering.Pyramid": (BoolProperty) While the user interacts (level of detail 0), reslice a
+   *          coarser level of an ImagePyramid of the image that matches the size of a displayed pixel. The
+   *          full resolution is restored with the next level of detail (see RenderingManager). Only large images
+   *          have coarser levels. Coarser levels are only used if the next level of detail is guaranteed
+   *          (see RenderingManager::IsLODIncreaseGuaranteed()). Editing an image recomputes its pyramid, so
+   *          it should only be enabled for large images that are not edited.
    *   - \b "bounding box": (BoolProperty) Is the Bounding Box of the image shown or not
    *   - \b "layer": (IntProperty) Layer of the image
    *   - \b "volume annotation color": (ColorProperty) color of the volume annotation, TODO has to be reimplemented
@@ -103,6 +110,7 @@ namespace mitk
    *   - \b "texture interpolation", mitk::BoolProperty::New( false ) )
    *   - \b "reslice interpolation", mitk::VtkResliceInterpolationProperty::New() )
    *   - \b "in plane resample extent by geometry", mitk::BoolProperty::New( false ) )
+   *   - \b "Image Rendering.Pyramid", mitk::BoolProperty::New( false ) )
    *   - \b "bounding box", mitk::BoolProperty::New( false ) )
    *   - \b "layer", mitk::IntProperty::New(10), renderer, overwrite)
    *   - \b "Image Rendering.Transfer Function":  Default color transfer function for CTs
@@ -130,6 +138,10 @@ namespace mitk
      * data. */
     void Update(mitk::BaseRenderer *renderer) override;
 
+    /** \brief Level of detail is enabled while a coarser level of the image pyramid is shown instead of the
+      * full resolution (see GetInteractionPyramidLevel()). */
+    bool IsLODEnabled(mitk::BaseRenderer *renderer) const override;
+
     //### methods of MITK-VTK rendering pipeline
     vtkProp *GetVtkProp(mitk::BaseRenderer *renderer) override;
     //### end of methods of MITK-VTK rendering pipeline
@@ -194,6 +206,15 @@ namespace mitk
       /** \brief mmPerPixel relation between pixel and mm. (World spacing).*/
       mitk::ScalarType *m_mmPerPixel;
 
+      /** \brief Level of the image pyramid the current slice was resliced from (0 means full resolution). */
+      unsigned int m_PyramidLevel = 0;
+
+      /** \brief Time of the last reslice at full resolution. */
+      itk::TimeStamp m_FullResolutionUpdateTime;
+
+      /** \brief Zoom (mm per display unit) of the renderer at the last reslice at full resolution. */
+      mitk::ScalarType m_FullResolutionMMPerPixel = 0.0;
+
       /** \brief This filter is used to apply the level window to Grayvalue and RBG(A) images. */
       vtkSmartPointer<vtkMitkLevelWindowFilter> m_LevelWindowFilter;
 
@@ -221,6 +242,21 @@ namespace mitk
     /** \brief Get the LocalStorage corresponding to the current renderer. */
     LocalStorage* GetLocalStorage(mitk::BaseRenderer* renderer);
 
+    /** \brief Returns the level of the image pyramid that matches the size of a displayed pixel of the renderer
+      * or 0 if the pyramid is disabled or cannot be used (e.g. for thick slices).
+      */
+    unsigned int GetDisplayPyramidLevel(mitk::BaseRenderer *renderer);
+
+    /** \brief Returns the display pyramid level while the plane or the zoom of the renderer differs from the
+      * last reslice at full resolution, i.e. while the user scrolls or zooms, and 0 otherwise.
+      * Also returns 0 if the rendering is not followed by one with a higher level of detail
+      * (see RenderingManager::IsLODIncreaseGuaranteed()).
+      */
+    unsigned int GetInteractionPyramidLevel(mitk::BaseRenderer *renderer);
+
+    /** \brief Multiresolution pyramid of the input image, shared by all renderers. */
+    ImagePyramid::Pointer m_ImagePyramid;
+
     /** \brief Transforms the actor to the actual position in 3D.
       *   \param renderer The current renderer corresponding to the render window.
       */
@@ -100,6 +100,23 @@ namespace mitk
     //## @param limit the maximum number of items on the stack
     void SetUndoLimit(std::size_t limit) override;
 
+    //##Documentation
+    //## @brief Gets the limit on the memory of the undo history in bytes (0 means no limit).
+    std::size_t GetMemoryLimit() const override;
+
+    //##Documentation
+    //## @brief Sets a limit on the memory of the undo history in bytes.
+    //## If the memory of all items on the undo and redo stack exceeds the
+    //## limit, the oldest undo items will be dropped from the bottom of the
+    //## undo stack. The 0 value means that there is no limit.
+    void SetMemoryLimit(std::size_t limit) override;
+
+    //##Documentation
+    //## @brief Returns the memory of all items on the undo and redo stack in bytes,
+    //## as reported by UndoStackItem::GetMemorySize(). Changes are signaled by an
+    //## UndoMemoryUsageEvent.
+    std::size_t GetMemoryUsage() const;
+
     //##Documentation
     //## @brief Returns the ObjectEventId of the
     //## top element in the OperationHistory
@@ -128,6 +145,10 @@ namespace mitk
     //## elements in the list and to clear the list
     void ClearList(UndoContainer *list);
 
+    //## @brief Pushes a new item onto the undo stack and drops
+    //## the oldest items as required by the undo and memory limit
+    void PushUndoItem(UndoStackItem *stackItem);
+
     UndoContainer m_UndoList;
 
     UndoContainer m_RedoList;
@@ -135,8 +156,17 @@ namespace mitk
   private:
     int FirstObjectEventIdOfCurrentGroup(UndoContainer &stack);
 
+    //## @brief Drops the oldest undo items until the limits are met
+    void EnforceLimits();
+
+    void DeleteItem(UndoStackItem *item);
+
     std::size_t m_UndoLimit;
 
+    std::size_t m_MemoryLimit;
+
+    std::size_t m_MemoryUsage;
+
   };
 
 #pragma GCC visibility push(default)
@@ -151,6 +181,8 @@ namespace mitk
   /// Additional unused events, if anybody wants to put an artificial limit to the possible number of items in the stack
   itkEventMacroDeclaration(UndoFullEvent, UndoStackEvent);
   itkEventMacroDeclaration(RedoFullEvent, UndoStackEvent);
+  /// Signals a change of LimitedLinearUndo::GetMemoryUsage()
+  itkEventMacroDeclaration(UndoMemoryUsageEvent, UndoStackEvent);
 
 #pragma GCC visibility pop
 
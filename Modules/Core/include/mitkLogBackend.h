@@ -25,6 +25,10 @@ namespace mitk
   public:
     void ProcessMessage(const LogMessage&) override;
 
+    /** \brief Flushes the console and the log file.
+     */
+    void Flush() override;
+
     /** \brief Registers MITK log backend.
      */
     static void Register();
@@ -15,14 +15,14 @@ found in the LICENSE file.
 
 #include <MitkCoreExports.h>
 
+#include <mitkCustomMimeType.h>
+
 #include <usSharedData.h>
 
 #include <vector>
 
 namespace mitk
 {
-  class CustomMimeType;
-
   /**
    * @ingroup IO
    *
@@ -62,6 +62,9 @@ namespace mitk
     /** @see mitk::CustomMimeType::GetFileNameWithoutExtension()*/
     std::string GetFilenameWithoutExtension(const std::string &path) const;
 
+    /** @see mitk::CustomMimeType::GetMagicBytes()*/
+    std::vector<CustomMimeType::MagicBytesType> GetMagicBytes() const;
+
     /** @see mitk::CustomMimeType::AppliesTo()*/
     bool AppliesTo(const std::string &path) const;
 
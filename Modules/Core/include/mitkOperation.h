@@ -39,6 +39,13 @@ namespace mitk
 
     OperationType GetOperationType();
 
+    //##Documentation
+    //## @brief Approximate number of bytes this operation occupies in memory.
+    //##
+    //## Used by undo models to limit the memory of their stacks. Operations that hold
+    //## considerable data (e.g. image slices) should add its size.
+    virtual std::size_t GetMemorySize() const;
+
   protected:
     OperationType m_OperationType;
   };
@@ -0,0 +1,76 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef mitkPropertyKey_h
+#define mitkPropertyKey_h
+
+#include <MitkCoreExports.h>
+
+#include <cstddef>
+#include <functional>
+#include <string>
+
+namespace mitk
+{
+  /**
+   * \brief Interned property key.
+   *
+   * Constructing a PropertyKey looks up (and if necessary adds) its name in a process-wide registry once and
+   * assigns it a unique id. Afterwards, keys are compared and hashed by their ids, i.e., without any string
+   * comparisons. Interned names are never released, so keys are meant to be created once for a fixed set of
+   * names, typically as static constants in code that queries properties per rendered frame:
+   *
+   * \code
+   * static const mitk::PropertyKey OpacityKey("opacity");
+   * node->GetOpacity(opacity, renderer, OpacityKey);
+   * \endcode
+   *
+   * Creating keys is thread-safe. A default constructed key has an empty name.
+   *
+   * \sa DataNode::GetProperty(const PropertyKey&, const BaseRenderer*, bool) const
+   */
+  class MITKCORE_EXPORT PropertyKey final
+  {
+  public:
+    using IdType = std::size_t;
+
+    PropertyKey();
+    explicit PropertyKey(const std::string &name);
+    explicit PropertyKey(const char *name);
+
+    const std::string &GetName() const { return *m_Name; }
+    IdType GetId() const { return m_Id; }
+    bool IsEmpty() const { return 0 == m_Id; }
+
+    bool operator==(const PropertyKey &other) const { return m_Id == other.m_Id; }
+    bool operator!=(const PropertyKey &other) const { return m_Id != other.m_Id; }
+    bool operator<(const PropertyKey &other) const { return m_Id < other.m_Id; }
+
+  private:
+    const std::string *m_Name;
+    IdType m_Id;
+  };
+}
+
+namespace std
+{
+  template <>
+  struct hash<mitk::PropertyKey>
+  {
+    std::size_t operator()(const mitk::PropertyKey &key) const noexcept
+    {
+      return std::hash<mitk::PropertyKey::IdType>()(key.GetId());
+    }
+  };
+}
+
+#endif
@@ -15,6 +15,7 @@ found in the LICENSE file.
 
 #include <mitkIPropertyOwner.h>
 #include <mitkGenericProperty.h>
+#include <mitkPropertyKey.h>
 
 #include <nlohmann/json_fwd.hpp>
 
@@ -86,6 +87,11 @@ namespace mitk
      */
     mitk::BaseProperty *GetProperty(const std::string &propertyKey) const;
 
+    /**
+     * @brief Get a property by its interned key.
+     */
+    mitk::BaseProperty *GetProperty(const PropertyKey &propertyKey) const;
+
     /**
      * @brief Set a property object in the list/map by reference.
      *
@@ -217,6 +223,14 @@ namespace mitk
      */
     itk::ModifiedTimeType GetMTime() const override;
 
+    /**
+     * @brief Get the timestamp of the last time a property was added to, replaced in or removed from the list.
+     *
+     * In contrast to GetMTime(), changes of the values of the properties are not considered. As long as this
+     * timestamp does not change, looking up a key yields the same property object.
+     */
+    itk::ModifiedTimeType GetKeysMTime() const;
+
     /**
      * @brief Remove a property from the list/map.
      */
@@ -259,6 +273,11 @@ namespace mitk
      */
     PropertyMap m_Properties;
 
+    /**
+     * @brief Has to be modified whenever properties are added to, replaced in or removed from m_Properties.
+     */
+    itk::TimeStamp m_KeysModifiedTime;
+
   private:
     itk::LightObject::Pointer InternalClone() const override;
   };
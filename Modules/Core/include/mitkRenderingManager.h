@@ -300,6 +300,16 @@ namespace mitk
     /** Force a sub-class to start a timer for a pending hires-rendering request */
     virtual void StartOrResetTimer(){};
 
+    /** Returns true if the sub-class starts a timer in StartOrResetTimer(), i.e. if a rendering
+     * with level of detail 0 is followed by a rendering with a higher level of detail. */
+    virtual bool HasLODTimer() const { return false; }
+
+    /** Returns true if the current rendering is followed by a rendering with a higher level of detail.
+     * This is only the case for renderings that were requested by RequestUpdate() (not forced by
+     * ForceImmediateUpdate(), e.g. for screenshots), if there is a timer (see HasLODTimer()) and if
+     * the increase of the level of detail is not blocked. */
+    bool IsLODIncreaseGuaranteed() const;
+
     /** To be called by a sub-class from a timer callback */
     void ExecutePendingHighResRenderingRequest();
 
@@ -396,6 +406,8 @@ namespace mitk
 
     bool m_LODAbortMechanismEnabled;
 
+    bool m_ExecutingPendingRequests;
+
     BoolVector m_ShadingEnabled;
 
     bool m_ClippingPlaneEnabled;
@@ -17,9 +17,14 @@ found in the LICENSE file.
 
 #include <itkBSplineInterpolateImageFunction.h>
 #include <itkLinearInterpolateImageFunction.h>
+#include <itkMultiThreaderBase.h>
 #include <itkNearestNeighborInterpolateImageFunction.h>
 
+#include <algorithm>
+#include <array>
+#include <cmath>
 #include <limits>
+#include <vector>
 
 struct mitk::ExtractSliceFilter2::Impl
 {
@@ -28,11 +33,13 @@ struct mitk::ExtractSliceFilter2::Impl
 
   PlaneGeometry::Pointer OutputGeometry;
   mitk::ExtractSliceFilter2::Interpolator Interpolator;
+  bool FastResampling;
   itk::Object::Pointer InterpolateImageFunction;
 };
 
 mitk::ExtractSliceFilter2::Impl::Impl()
-  : Interpolator(NearestNeighbor)
+  : Interpolator(NearestNeighbor),
+    FastResampling(false)
 {
 }
 
@@ -132,6 +139,273 @@ namespace
     }
   }
 
+  /** \brief Continuous index space description of the output plane.
+   *
+   * The continuous index of output pixel (x, y) is Origin + x * XStep + y * YStep.
+   * Indices are relative to the start of the buffered region of the input image.
+   */
+  struct IndexStepping
+  {
+    std::array<double, 3> Origin;
+    std::array<double, 3> XStep;
+    std::array<double, 3> YStep;
+  };
+
+  /** \brief Clip the columns of a row to the range whose continuous indices are inside the input image.
+   *
+   * Uses the same inside test as itk::ImageRegion::IsInside(), i.e., [-0.5, size - 0.5] per axis.
+   */
+  void ClipRow(const std::array<double, 3>& rowOrigin, const std::array<double, 3>& xStep, const std::array<itk::IndexValueType, 3>& size, std::size_t width, std::size_t& xBegin, std::size_t& xEnd)
+  {
+    double tMin = 0.0;
+    double tMax = static_cast<double>(width) - 1.0;
+
+    for (int i = 0; i < 3; ++i)
+    {
+      const double lower = -0.5;
+      const double upper = static_cast<double>(size[i]) - 0.5;
+
+      if (0.0 == xStep[i])
+      {
+        if (!(rowOrigin[i] >= lower && rowOrigin[i] <= upper))
+        {
+          xBegin = xEnd = 0;
+          return;
+        }
+
+        continue;
+      }
+
+      double t0 = (lower - rowOrigin[i]) / xStep[i];
+      double t1 = (upper - rowOrigin[i]) / xStep[i];
+
+      if (t0 > t1)
+        std::swap(t0, t1);
+
+      tMin = std::max(tMin, t0);
+      tMax = std::min(tMax, t1);
+    }
+
+    if (!(tMin <= tMax))
+    {
+      xBegin = xEnd = 0;
+      return;
+    }
+
+    xBegin = static_cast<std::size_t>(std::ceil(tMin));
+    xEnd = std::min(width, static_cast<std::size_t>(std::floor(tMax)) + 1);
+
+    if (xBegin > xEnd)
+      xBegin = xEnd;
+  }
+
+  /** \brief Scratch buffers of a single row block.
+   *
+   * The kernels first compute offsets and weights of a whole row in plain
+   * arithmetic loops over these arrays, which the compiler is able to
+   * vectorize, and then gather the input pixels in a separate loop.
+   */
+  struct RowBuffers
+  {
+    explicit RowBuffers(std::size_t width)
+      : Offset(width),
+        Step(),
+        Weight()
+    {
+      for (int i = 0; i < 3; ++i)
+      {
+        Step[i].resize(width);
+        Weight[i].resize(width);
+      }
+    }
+
+    std::vector<std::ptrdiff_t> Offset;
+    std::array<std::vector<std::ptrdiff_t>, 3> Step;
+    std::array<std::vector<double>, 3> Weight;
+  };
+
+  inline itk::IndexValueType Clamp(itk::IndexValueType value, itk::IndexValueType maxValue)
+  {
+    return std::min(std::max(value, itk::IndexValueType(0)), maxValue);
+  }
+
+  template <typename TPixel>
+  void ResampleRowNearestNeighbor(const TPixel* input, const std::array<itk::IndexValueType, 3>& size, const std::array<std::ptrdiff_t, 3>& stride, const std::array<double, 3>& rowOrigin, const std::array<double, 3>& xStep, std::size_t xBegin, std::size_t xEnd, RowBuffers& buffers, TPixel* output)
+  {
+    auto* offset = buffers.Offset.data();
+
+    for (std::size_t x = xBegin; x < xEnd; ++x)
+      offset[x] = 0;
+
+    for (int i = 0; i < 3; ++i)
+    {
+      const double origin = rowOrigin[i] + 0.5; // Round half up, indices are >= -0.5
+      const double step = xStep[i];
+      const auto maxIndex = size[i] - 1;
+      const auto axisStride = stride[i];
+
+      for (std::size_t x = xBegin; x < xEnd; ++x)
+        offset[x] += Clamp(static_cast<itk::IndexValueType>(origin + step * x), maxIndex) * axisStride;
+    }
+
+    for (std::size_t x = xBegin; x < xEnd; ++x)
+      output[x] = input[offset[x]];
+  }
+
+  template <typename TPixel>
+  void ResampleRowLinear(const TPixel* input, const std::array<itk::IndexValueType, 3>& size, const std::array<std::ptrdiff_t, 3>& stride, const std::array<double, 3>& rowOrigin, const std::array<double, 3>& xStep, std::size_t xBegin, std::size_t xEnd, RowBuffers& buffers, TPixel* output)
+  {
+    auto* offset = buffers.Offset.data();
+
+    for (std::size_t x = xBegin; x < xEnd; ++x)
+      offset[x] = 0;
+
+    // Border handling matches itk::LinearInterpolateImageFunction: neighbors
+    // outside of the image are clamped to the nearest border pixel.
+    for (int i = 0; i < 3; ++i)
+    {
+      const double origin = rowOrigin[i] + 1.0; // Floor by truncation, indices are >= -0.5
+      const double step = xStep[i];
+      const auto maxIndex = size[i] - 1;
+      const auto axisStride = stride[i];
+      auto* axisStep = buffers.Step[i].data();
+      auto* weight = buffers.Weight[i].data();
+
+      for (std::size_t x = xBegin; x < xEnd; ++x)
+      {
+        const double index = origin + step * x;
+        const auto floorIndex = static_cast<itk::IndexValueType>(index) - 1;
+        const auto lowerIndex = Clamp(floorIndex, maxIndex);
+        const auto upperIndex = Clamp(floorIndex + 1, maxIndex);
+
+        weight[x] = index - 1.0 - floorIndex;
+        offset[x] += lowerIndex * axisStride;
+        axisStep[x] = (upperIndex - lowerIndex) * axisStride;
+      }
+    }
+
+    const auto* stepX = buffers.Step[0].data();
+    const auto* stepY = buffers.Step[1].data();
+    const auto* stepZ = buffers.Step[2].data();
+    const auto* weightX = buffers.Weight[0].data();
+    const auto* weightY = buffers.Weight[1].data();
+    const auto* weightZ = buffers.Weight[2].data();
+
+    for (std::size_t x = xBegin; x < xEnd; ++x)
+    {
+      const TPixel* p = input + offset[x];
+      const auto sx = stepX[x];
+      const auto sy = stepY[x];
+      const auto sz = stepZ[x];
+      const double wx = weightX[x];
+      const double wy = weightY[x];
+      const double wz = weightZ[x];
+
+      const double v00 = p[0] + wx * (static_cast<double>(p[sx]) - p[0]);
+      const double v10 = p[sy] + wx * (static_cast<double>(p[sy + sx]) - p[sy]);
+      const double v01 = p[sz] + wx * (static_cast<double>(p[sz + sx]) - p[sz]);
+      const double v11 = p[sz + sy] + wx * (static_cast<double>(p[sz + sy + sx]) - p[sz + sy]);
+
+      const double v0 = v00 + wy * (v10 - v00);
+      const double v1 = v01 + wy * (v11 - v01);
+
+      output[x] = static_cast<TPixel>(v0 + wz * (v1 - v0));
+    }
+  }
+
+  template <typename TPixel, unsigned int VImageDimension>
+  void GenerateDataFast(const itk::Image<TPixel, VImageDimension>* inputImage, mitk::Image* outputImage, mitk::ExtractSliceFilter2::Interpolator interpolator, itk::MultiThreaderBase* multiThreader)
+  {
+    static_assert(3 == VImageDimension, "Fast resampling requires 3-d input images.");
+
+    auto outputGeometry = outputImage->GetSlicedGeometry()->GetPlaneGeometry(0);
+
+    auto spacing = outputGeometry->GetSpacing();
+    auto xDirection = outputGeometry->GetAxisVector(0);
+    auto yDirection = outputGeometry->GetAxisVector(1);
+
+    xDirection.Normalize();
+    yDirection.Normalize();
+
+    const auto& physicalPointToIndex = inputImage->GetPhysicalPointToIndexMatrix();
+    const auto xIndexStep = physicalPointToIndex * (xDirection * spacing[0]);
+    const auto yIndexStep = physicalPointToIndex * (yDirection * spacing[1]);
+
+    const auto originIndex = inputImage->template TransformPhysicalPointToContinuousIndex<mitk::ScalarType>(outputGeometry->GetOrigin());
+
+    const auto bufferedRegion = inputImage->GetBufferedRegion();
+
+    IndexStepping stepping;
+    std::array<itk::IndexValueType, 3> size;
+    std::array<std::ptrdiff_t, 3> stride;
+
+    for (int i = 0; i < 3; ++i)
+    {
+      stepping.Origin[i] = originIndex[i] - bufferedRegion.GetIndex(i);
+      stepping.XStep[i] = xIndexStep[i];
+      stepping.YStep[i] = yIndexStep[i];
+      size[i] = static_cast<itk::IndexValueType>(bufferedRegion.GetSize(i));
+    }
+
+    stride[0] = 1;
+    stride[1] = size[0];
+    stride[2] = size[0] * size[1];
+
+    const std::size_t width = outputGeometry->GetExtent(0);
+    const std::size_t height = outputGeometry->GetExtent(1);
+
+    if (0 == width || 0 == height)
+      return;
+
+    mitk::ImageWriteAccessor writeAccess(outputImage, nullptr, mitk::ImageAccessorBase::IgnoreLock);
+    auto data = static_cast<TPixel*>(writeAccess.GetData());
+    const TPixel* input = inputImage->GetBufferPointer();
+
+    const TPixel backgroundPixel = std::numeric_limits<TPixel>::lowest();
+
+    // Split the output into row blocks. Use more blocks than threads to
+    // balance the load of rows that are partially outside of the input image.
+    const std::size_t numberOfWorkUnits = std::max(1u, multiThreader->GetNumberOfWorkUnits());
+    const std::size_t rowsPerBlock = std::max<std::size_t>(1, height / (4 * numberOfWorkUnits));
+    const std::size_t numberOfBlocks = (height + rowsPerBlock - 1) / rowsPerBlock;
+
+    auto resampleBlock = [&](itk::SizeValueType block)
+    {
+      RowBuffers buffers(width);
+
+      const std::size_t yBegin = block * rowsPerBlock;
+      const std::size_t yEnd = std::min(height, yBegin + rowsPerBlock);
+
+      std::array<double, 3> rowOrigin;
+
+      for (std::size_t y = yBegin; y < yEnd; ++y)
+      {
+        for (int i = 0; i < 3; ++i)
+          rowOrigin[i] = stepping.Origin[i] + stepping.YStep[i] * y;
+
+        std::size_t xBegin = 0;
+        std::size_t xEnd = 0;
+        ClipRow(rowOrigin, stepping.XStep, size, width, xBegin, xEnd);
+
+        TPixel* row = data + width * y;
+
+        std::fill(row, row + xBegin, backgroundPixel);
+        std::fill(row + xEnd, row + width, backgroundPixel);
+
+        if (mitk::ExtractSliceFilter2::Linear == interpolator)
+        {
+          ResampleRowLinear(input, size, stride, rowOrigin, stepping.XStep, xBegin, xEnd, buffers, row);
+        }
+        else
+        {
+          ResampleRowNearestNeighbor(input, size, stride, rowOrigin, stepping.XStep, xBegin, xEnd, buffers, row);
+        }
+      }
+    };
+
+    multiThreader->ParallelizeArray(0, numberOfBlocks, resampleBlock, nullptr);
+  }
+
   void VerifyInputImage(const mitk::Image* inputImage)
   {
     auto dimension = inputImage->GetDimension();
@@ -196,21 +470,6 @@ void mitk::ExtractSliceFilter2::AllocateOutputs()
   }
 }
 
-/*void mitk::ExtractSliceFilter2::BeforeThreadedGenerateData()
-{
-  if (nullptr != m_Impl->InterpolateImageFunction && this->GetInput()->GetMTime() < this->GetMTime())
-    return;
-
-  const auto* inputImage = this->GetInput();
-  AccessFixedDimensionByItk_2(inputImage, CreateInterpolateImageFunction, 3, this->GetInterpolator(), m_Impl->InterpolateImageFunction);
-}
-
-void mitk::ExtractSliceFilter2::ThreadedGenerateData(const OutputImageRegionType& outputRegionForThread, itk::ThreadIdType)
-{
-  const auto* inputImage = this->GetInput();
-  AccessFixedDimensionByItk_3(inputImage, ::GenerateData, 3, this->GetOutput(), outputRegionForThread, m_Impl->InterpolateImageFunction);
-}*/
-
 void mitk::ExtractSliceFilter2::GenerateData()
 {
   if (nullptr != m_Impl->InterpolateImageFunction && this->GetInput()->GetMTime() < this->GetMTime())
@@ -221,6 +480,13 @@ void mitk::ExtractSliceFilter2::GenerateData()
   AccessFixedDimensionByItk_2(inputImage, CreateInterpolateImageFunction, 3, this->GetInterpolator(), m_Impl->InterpolateImageFunction);
 
   this->AllocateOutputs();
+
+  if (m_Impl->FastResampling && Cubic != m_Impl->Interpolator)
+  {
+    AccessFixedDimensionByItk_3(inputImage, GenerateDataFast, 3, this->GetOutput(), m_Impl->Interpolator, this->GetMultiThreader());
+    return;
+  }
+
   auto outputRegion = this->GetOutput()->GetLargestPossibleRegion();
 
   AccessFixedDimensionByItk_3(inputImage, ::GenerateData, 3, this->GetOutput(), outputRegion, m_Impl->InterpolateImageFunction);
@@ -272,6 +538,20 @@ void mitk::ExtractSliceFilter2::SetInterpolator(Interpolator interpolator)
   }
 }
 
+bool mitk::ExtractSliceFilter2::GetFastResampling() const
+{
+  return m_Impl->FastResampling;
+}
+
+void mitk::ExtractSliceFilter2::SetFastResampling(bool fastResampling)
+{
+  if (m_Impl->FastResampling != fastResampling)
+  {
+    m_Impl->FastResampling = fastResampling;
+    this->Modified();
+  }
+}
+
 void mitk::ExtractSliceFilter2::VerifyInputInformation() const
 {
   Superclass::VerifyInputInformation();
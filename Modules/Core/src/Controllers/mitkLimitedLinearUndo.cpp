@@ -13,6 +13,8 @@ found in the LICENSE file.
 #include "mitkLimitedLinearUndo.h"
 #include <mitkRenderingManager.h>
 
+#include <algorithm>
+
 namespace mitk
 {
   itkEventMacroDefinition(UndoStackEvent, itk::ModifiedEvent);
@@ -22,10 +24,13 @@ namespace mitk
   itkEventMacroDefinition(RedoNotEmptyEvent, UndoStackEvent);
   itkEventMacroDefinition(UndoFullEvent, UndoStackEvent);
   itkEventMacroDefinition(RedoFullEvent, UndoStackEvent);
+  itkEventMacroDefinition(UndoMemoryUsageEvent, UndoStackEvent);
 }
 
 mitk::LimitedLinearUndo::LimitedLinearUndo()
-: m_UndoLimit(0)
+: m_UndoLimit(0),
+  m_MemoryLimit(0),
+  m_MemoryUsage(0)
 {
   // nothing to do
 }
@@ -43,16 +48,19 @@ void mitk::LimitedLinearUndo::ClearList(UndoContainer *list)
   {
     UndoStackItem *item = list->back();
     list->pop_back();
-    delete item;
+    this->DeleteItem(item);
   }
 }
 
-bool mitk::LimitedLinearUndo::SetOperationEvent(UndoStackItem *stackItem)
+void mitk::LimitedLinearUndo::DeleteItem(UndoStackItem *item)
 {
-  auto *operationEvent = dynamic_cast<OperationEvent *>(stackItem);
-  if (!operationEvent)
-    return false;
+  // clamped, in case the size of an item changed while it was on the stack
+  m_MemoryUsage -= std::min(m_MemoryUsage, item->GetMemorySize());
+  delete item;
+}
 
+void mitk::LimitedLinearUndo::PushUndoItem(UndoStackItem *stackItem)
+{
   // clear the redolist, if a new operation is saved
   if (!m_RedoList.empty())
   {
@@ -60,15 +68,41 @@ bool mitk::LimitedLinearUndo::SetOperationEvent(UndoStackItem *stackItem)
     InvokeEvent(RedoEmptyEvent());
   }
 
-  if (0 != m_UndoLimit && m_UndoList.size() == m_UndoLimit)
+  m_UndoList.push_back(stackItem);
+  m_MemoryUsage += stackItem->GetMemorySize();
+
+  this->EnforceLimits();
+
+  InvokeEvent(UndoNotEmptyEvent());
+  InvokeEvent(UndoMemoryUsageEvent());
+}
+
+void mitk::LimitedLinearUndo::EnforceLimits()
+{
+  bool dropped = false;
+
+  // the newest item is kept, even if it exceeds the memory limit on its own
+  while (m_UndoList.size() > 1 &&
+         ((0 != m_UndoLimit && m_UndoList.size() > m_UndoLimit) ||
+          (0 != m_MemoryLimit && m_MemoryUsage > m_MemoryLimit)))
   {
     auto item = m_UndoList.front();
     m_UndoList.pop_front();
-    delete item;
+    this->DeleteItem(item);
+    dropped = true;
   }
-  m_UndoList.push_back(operationEvent);
 
-  InvokeEvent(UndoNotEmptyEvent());
+  if (dropped)
+    InvokeEvent(UndoFullEvent());
+}
+
+bool mitk::LimitedLinearUndo::SetOperationEvent(UndoStackItem *stackItem)
+{
+  auto *operationEvent = dynamic_cast<OperationEvent *>(stackItem);
+  if (!operationEvent)
+    return false;
+
+  this->PushUndoItem(operationEvent);
 
   return true;
 }
@@ -166,17 +200,27 @@ bool mitk::LimitedLinearUndo::Redo(int oeid)
 
 void mitk::LimitedLinearUndo::Clear()
 {
+  const auto memoryUsage = m_MemoryUsage;
+
   this->ClearList(&m_UndoList);
   InvokeEvent(UndoEmptyEvent());
 
   this->ClearList(&m_RedoList);
   InvokeEvent(RedoEmptyEvent());
+
+  if (memoryUsage != m_MemoryUsage)
+    InvokeEvent(UndoMemoryUsageEvent());
 }
 
 void mitk::LimitedLinearUndo::ClearRedoList()
 {
+  const auto memoryUsage = m_MemoryUsage;
+
   this->ClearList(&m_RedoList);
   InvokeEvent(RedoEmptyEvent());
+
+  if (memoryUsage != m_MemoryUsage)
+    InvokeEvent(UndoMemoryUsageEvent());
 }
 
 bool mitk::LimitedLinearUndo::RedoListEmpty()
@@ -193,14 +237,40 @@ void mitk::LimitedLinearUndo::SetUndoLimit(std::size_t undoLimit)
 {
   if (undoLimit != m_UndoLimit)
   {
-    if (m_UndoList.size() > undoLimit)
-    {
-      m_UndoList.erase(m_UndoList.begin(), m_UndoList.end() - undoLimit);
-    }
     m_UndoLimit = undoLimit;
+
+    const auto memoryUsage = m_MemoryUsage;
+    this->EnforceLimits();
+
+    if (memoryUsage != m_MemoryUsage)
+      InvokeEvent(UndoMemoryUsageEvent());
+  }
+}
+
+std::size_t mitk::LimitedLinearUndo::GetMemoryLimit() const
+{
+  return m_MemoryLimit;
+}
+
+void mitk::LimitedLinearUndo::SetMemoryLimit(std::size_t memoryLimit)
+{
+  if (memoryLimit != m_MemoryLimit)
+  {
+    m_MemoryLimit = memoryLimit;
+
+    const auto memoryUsage = m_MemoryUsage;
+    this->EnforceLimits();
+
+    if (memoryUsage != m_MemoryUsage)
+      InvokeEvent(UndoMemoryUsageEvent());
   }
 }
 
+std::size_t mitk::LimitedLinearUndo::GetMemoryUsage() const
+{
+  return m_MemoryUsage;
+}
+
 int mitk::LimitedLinearUndo::GetLastObjectEventIdInList()
 {
   return m_UndoList.back()->GetObjectEventId();
@@ -72,6 +72,11 @@ void mitk::UndoStackItem::ReverseAndExecute()
   ReverseOperations();
 }
 
+std::size_t mitk::UndoStackItem::GetMemorySize() const
+{
+  return sizeof(*this) + m_Description.capacity();
+}
+
 // ******************** mitk::OperationEvent ********************
 
 mitk::Operation *mitk::OperationEvent::GetOperation()
@@ -148,3 +153,16 @@ bool mitk::OperationEvent::IsValid()
 {
   return !m_Invalid;
 }
+
+std::size_t mitk::OperationEvent::GetMemorySize() const
+{
+  std::size_t size = UndoStackItem::GetMemorySize() + sizeof(*this) - sizeof(UndoStackItem);
+
+  if (nullptr != m_Operation)
+    size += m_Operation->GetMemorySize();
+
+  if (nullptr != m_UndoOperation)
+    size += m_UndoOperation->GetMemorySize();
+
+  return size;
+}
@@ -41,6 +41,7 @@ namespace mitk
       m_MaxLOD(1),
       m_LODIncreaseBlocked(false),
       m_LODAbortMechanismEnabled(false),
+      m_ExecutingPendingRequests(false),
       m_ClippingPlaneEnabled(false),
       m_TimeNavigationController(TimeNavigationController::New()),
       m_DataStorage(nullptr),
@@ -543,6 +544,10 @@ namespace mitk
   {
     m_UpdatePending = false;
 
+    // renderings of requests are allowed to use a lower level of detail (see IsLODIncreaseGuaranteed())
+    const bool executingPendingRequests = m_ExecutingPendingRequests;
+    m_ExecutingPendingRequests = true;
+
     // Satisfy all pending update requests
     RenderWindowList::const_iterator it;
     int i = 0;
@@ -553,6 +558,13 @@ namespace mitk
         this->ForceImmediateUpdate(it->first);
       }
     }
+
+    m_ExecutingPendingRequests = executingPendingRequests;
+  }
+
+  bool RenderingManager::IsLODIncreaseGuaranteed() const
+  {
+    return m_ExecutingPendingRequests && !m_LODIncreaseBlocked && this->HasLODTimer();
   }
 
   void RenderingManager::RenderingStartCallback(vtkObject *caller, unsigned long, void *, void *)
@@ -26,23 +26,7 @@ bool mitk::VerboseLimitedLinearUndo::SetOperationEvent(UndoStackItem *undoStackI
   if (!undoStackItem)
     return false;
 
-  // clear the redolist, if a new operation is saved
-  if (!m_RedoList.empty())
-  {
-    this->ClearList(&m_RedoList);
-    InvokeEvent(RedoEmptyEvent());
-  }
-
-  std::size_t undoLimit = this->GetUndoLimit();
-  if (0 != undoLimit && m_UndoList.size() == undoLimit)
-  {
-    auto item = m_UndoList.front();
-    m_UndoList.pop_front();
-    delete item;
-  }
-  m_UndoList.push_back(undoStackItem);
-
-  InvokeEvent(UndoNotEmptyEvent());
+  this->PushUndoItem(undoStackItem);
 
   return true;
 }
@@ -209,7 +209,10 @@ mitk::PropertyList *mitk::DataNode::GetPropertyList(const std::string &rendererN
   mitk::PropertyList::Pointer &propertyList = m_MapOfPropertyLists[rendererName];
 
   if (propertyList.IsNull())
+  {
     propertyList = mitk::PropertyList::New();
+    m_MapOfPropertyListsModifiedTime.Modified();
+  }
 
   assert(m_MapOfPropertyLists[rendererName].IsNotNull());
 
@@ -247,6 +250,106 @@ mitk::BaseProperty *mitk::DataNode::GetProperty(const char *propertyKey, const m
   return property;
 }
 
+mitk::BaseProperty *mitk::DataNode::GetProperty(const PropertyKey &propertyKey, const mitk::BaseRenderer *renderer, bool fallBackOnDataProperties) const
+{
+  return static_cast<BaseProperty *>(this->GetCachedProperty(
+    propertyKey, renderer, fallBackOnDataProperties, typeid(BaseProperty), [](BaseProperty *p) -> void * { return p; }));
+}
+
+bool mitk::DataNode::IsValid(const CachedPropertyLookup &lookup, const mitk::BaseRenderer *renderer, bool fallBackOnDataProperties) const
+{
+  const auto lookupTime = lookup.LookupTime.GetMTime();
+
+  if (lookupTime < m_PropertyList->GetKeysMTime())
+    return false;
+
+  if (nullptr != renderer)
+  {
+    // a renderer-specific property list may have been created after the lookup
+    if (lookupTime < m_MapOfPropertyListsModifiedTime.GetMTime())
+      return false;
+
+    if (nullptr != lookup.RendererPropertyList && lookupTime < lookup.RendererPropertyList->GetKeysMTime())
+      return false;
+  }
+
+  if (fallBackOnDataProperties)
+  {
+    if (lookupTime < m_DataReferenceChangedTime.GetMTime())
+      return false;
+
+    const PropertyList *dataPropertyList = m_Data.IsNotNull() ? m_Data->GetPropertyList().GetPointer() : nullptr;
+
+    if (dataPropertyList != lookup.DataPropertyList)
+      return false;
+
+    if (nullptr != dataPropertyList && lookupTime < dataPropertyList->GetKeysMTime())
+      return false;
+  }
+
+  return true;
+}
+
+void *mitk::DataNode::GetCachedProperty(const PropertyKey &propertyKey,
+                                        const mitk::BaseRenderer *renderer,
+                                        bool fallBackOnDataProperties,
+                                        const std::type_info &type,
+                                        PropertyCastFunction cast) const
+{
+  if (propertyKey.IsEmpty())
+    return nullptr;
+
+  const auto rendererId = nullptr != renderer ? renderer->GetNameKey().GetId() : PropertyKey::IdType(0);
+
+  std::lock_guard<std::mutex> lock(m_PropertyLookupCacheMutex);
+
+  auto &lookup = m_PropertyLookupCache[std::make_tuple(propertyKey.GetId(), rendererId, fallBackOnDataProperties)];
+
+  if (!lookup.LookupTime.GetMTime() || !this->IsValid(lookup, renderer, fallBackOnDataProperties))
+  {
+    lookup.RendererPropertyList = nullptr;
+    lookup.DataPropertyList = nullptr;
+    lookup.Property = nullptr;
+    lookup.CastType = nullptr;
+    lookup.CastProperty = nullptr;
+
+    if (nullptr != renderer)
+    {
+      auto it = m_MapOfPropertyLists.find(renderer->GetName());
+
+      if (m_MapOfPropertyLists.end() != it)
+      {
+        lookup.RendererPropertyList = it->second;
+        lookup.Property = it->second->GetProperty(propertyKey);
+      }
+    }
+
+    if (nullptr == lookup.Property)
+      lookup.Property = m_PropertyList->GetProperty(propertyKey);
+
+    if (fallBackOnDataProperties && m_Data.IsNotNull())
+    {
+      lookup.DataPropertyList = m_Data->GetPropertyList();
+
+      if (nullptr == lookup.Property)
+        lookup.Property = lookup.DataPropertyList->GetProperty(propertyKey);
+    }
+
+    lookup.LookupTime.Modified();
+  }
+
+  if (nullptr == lookup.Property)
+    return nullptr;
+
+  if (nullptr == lookup.CastType || type != *lookup.CastType)
+  {
+    lookup.CastProperty = cast(lookup.Property);
+    lookup.CastType = &type;
+  }
+
+  return lookup.CastProperty;
+}
+
 mitk::DataNode::GroupTagList mitk::DataNode::GetGroupTags() const
 {
   GroupTagList groups;
@@ -277,6 +380,16 @@ bool mitk::DataNode::GetBoolProperty(const char *propertyKey, bool &boolValue, c
   return true;
 }
 
+bool mitk::DataNode::GetBoolProperty(const PropertyKey &propertyKey, bool &boolValue, const mitk::BaseRenderer *renderer) const
+{
+  mitk::BoolProperty *boolprop = nullptr;
+  if (!this->GetProperty(boolprop, propertyKey, renderer))
+    return false;
+
+  boolValue = boolprop->GetValue();
+  return true;
+}
+
 bool mitk::DataNode::GetIntProperty(const char *propertyKey, int &intValue, const mitk::BaseRenderer *renderer) const
 {
   mitk::IntProperty::Pointer intprop = dynamic_cast<mitk::IntProperty *>(GetProperty(propertyKey, renderer));
@@ -287,6 +400,16 @@ bool mitk::DataNode::GetIntProperty(const char *propertyKey, int &intValue, cons
   return true;
 }
 
+bool mitk::DataNode::GetIntProperty(const PropertyKey &propertyKey, int &intValue, const mitk::BaseRenderer *renderer) const
+{
+  mitk::IntProperty *intprop = nullptr;
+  if (!this->GetProperty(intprop, propertyKey, renderer))
+    return false;
+
+  intValue = intprop->GetValue();
+  return true;
+}
+
 bool mitk::DataNode::GetFloatProperty(const char *propertyKey,
                                       float &floatValue,
                                       const mitk::BaseRenderer *renderer) const
@@ -299,6 +422,18 @@ bool mitk::DataNode::GetFloatProperty(const char *propertyKey,
   return true;
 }
 
+bool mitk::DataNode::GetFloatProperty(const PropertyKey &propertyKey,
+                                      float &floatValue,
+                                      const mitk::BaseRenderer *renderer) const
+{
+  mitk::FloatProperty *floatprop = nullptr;
+  if (!this->GetProperty(floatprop, propertyKey, renderer))
+    return false;
+
+  floatValue = floatprop->GetValue();
+  return true;
+}
+
 bool mitk::DataNode::GetDoubleProperty(const char *propertyKey,
                                        double &doubleValue,
                                        const mitk::BaseRenderer *renderer) const
@@ -347,6 +482,16 @@ bool mitk::DataNode::GetColor(float rgb[3], const mitk::BaseRenderer *renderer,
   return true;
 }
 
+bool mitk::DataNode::GetColor(float rgb[3], const mitk::BaseRenderer *renderer, const PropertyKey &propertyKey) const
+{
+  mitk::ColorProperty *colorprop = nullptr;
+  if (!this->GetProperty(colorprop, propertyKey, renderer))
+    return false;
+
+  memcpy(rgb, colorprop->GetColor().GetDataPointer(), 3 * sizeof(float));
+  return true;
+}
+
 bool mitk::DataNode::GetOpacity(float &opacity, const mitk::BaseRenderer *renderer, const char *propertyKey) const
 {
   mitk::FloatProperty::Pointer opacityprop = dynamic_cast<mitk::FloatProperty *>(GetProperty(propertyKey, renderer));
@@ -357,6 +502,16 @@ bool mitk::DataNode::GetOpacity(float &opacity, const mitk::BaseRenderer *render
   return true;
 }
 
+bool mitk::DataNode::GetOpacity(float &opacity, const mitk::BaseRenderer *renderer, const PropertyKey &propertyKey) const
+{
+  mitk::FloatProperty *opacityprop = nullptr;
+  if (!this->GetProperty(opacityprop, propertyKey, renderer))
+    return false;
+
+  opacity = opacityprop->GetValue();
+  return true;
+}
+
 bool mitk::DataNode::GetLevelWindow(mitk::LevelWindow &levelWindow,
                                     const mitk::BaseRenderer *renderer,
                                     const char *propertyKey) const
@@ -13,6 +13,15 @@ found in the LICENSE file.
 #include "mitkImageAccessorBase.h"
 #include "mitkImage.h"
 
+#include <algorithm>
+#include <vector>
+
+namespace
+{
+  /** Images the current thread holds shared read access for (one entry per accessor) */
+  thread_local std::vector<const mitk::Image *> SharedReadImagesOfCurrentThread;
+}
+
 mitk::ImageAccessorBase::ThreadIDType mitk::ImageAccessorBase::CurrentThreadHandle()
 {
 #ifdef ITK_USE_SPROC
@@ -88,10 +97,18 @@ mitk::ImageAccessorBase::ImageAccessorBase(ImageConstPointer image,
   {
     m_CoherentMemory = true;
 
-    // Organize first image channel
-    image->m_ReadWriteLock.lock();
-    imageDataItem = image->GetChannelData();
-    image->m_ReadWriteLock.unlock();
+    // Organize first image channel. GetChannelData() locks the data arrays itself,
+    // so shared readers do not need to serialize on m_ReadWriteLock here.
+    if (OptionFlags & SharedReadAccess)
+    {
+      imageDataItem = image->GetChannelData();
+    }
+    else
+    {
+      image->m_ReadWriteLock.lock();
+      imageDataItem = image->GetChannelData();
+      image->m_ReadWriteLock.unlock();
+    }
 
     // Set memory area
     m_AddressBegin = imageDataItem->m_Data;
@@ -182,3 +199,21 @@ void mitk::ImageAccessorBase::PreventRecursiveMutexLock(mitk::ImageAccessorBase
   }
 #endif
 }
+
+void mitk::ImageAccessorBase::AddSharedReadAccessOfCurrentThread(const Image *image)
+{
+  SharedReadImagesOfCurrentThread.push_back(image);
+}
+
+void mitk::ImageAccessorBase::RemoveSharedReadAccessOfCurrentThread(const Image *image)
+{
+  auto it = std::find(SharedReadImagesOfCurrentThread.begin(), SharedReadImagesOfCurrentThread.end(), image);
+  if (it != SharedReadImagesOfCurrentThread.end())
+    SharedReadImagesOfCurrentThread.erase(it);
+}
+
+bool mitk::ImageAccessorBase::HasSharedReadAccessOfCurrentThread(const Image *image)
+{
+  return std::find(SharedReadImagesOfCurrentThread.cbegin(), SharedReadImagesOfCurrentThread.cend(), image) !=
+         SharedReadImagesOfCurrentThread.cend();
+}
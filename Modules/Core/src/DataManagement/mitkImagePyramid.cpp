@@ -0,0 +1,274 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include <mitkImagePyramid.h>
+
+#include <vtkImageData.h>
+#include <vtkImageShrink3D.h>
+#include <vtkSmartPointer.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace
+{
+  // more levels are never needed for the extents of images that fit into memory
+  constexpr unsigned int MaximumNumberOfLevels = 16;
+}
+
+mitk::ImagePyramid::ImagePyramid()
+  : m_MinimumSize(512),
+    m_Averaging(true),
+    m_MinimumSpacing(1.0),
+    m_ShrinkFactorsMTime(0)
+{
+}
+
+mitk::ImagePyramid::~ImagePyramid()
+{
+}
+
+void mitk::ImagePyramid::SetImage(const Image *image)
+{
+  if (m_Image != image)
+  {
+    m_Image = image;
+    m_ShrinkFactors.clear();
+    m_Levels.clear();
+    this->Modified();
+  }
+}
+
+const mitk::Image *mitk::ImagePyramid::GetImage() const
+{
+  return m_Image;
+}
+
+void mitk::ImagePyramid::SetMinimumSize(unsigned int minimumSize)
+{
+  if (m_MinimumSize != minimumSize)
+  {
+    m_MinimumSize = minimumSize;
+    m_ShrinkFactors.clear();
+    m_Levels.clear();
+    this->Modified();
+  }
+}
+
+void mitk::ImagePyramid::SetAveraging(bool averaging)
+{
+  if (m_Averaging != averaging)
+  {
+    m_Averaging = averaging;
+    m_Levels.clear();
+    this->Modified();
+  }
+}
+
+itk::ModifiedTimeType mitk::ImagePyramid::GetImageMTime(TimeStepType timeStep) const
+{
+  const auto *geometry = m_Image->GetGeometry(timeStep);
+
+  return nullptr != geometry ? std::max(m_Image->GetMTime(), geometry->GetMTime()) : m_Image->GetMTime();
+}
+
+void mitk::ImagePyramid::UpdateShrinkFactors() const
+{
+  const bool isValid = m_Image.IsNotNull() && m_Image->IsInitialized();
+  const auto imageMTime = isValid ? this->GetImageMTime(0) : 0;
+
+  if (!m_ShrinkFactors.empty() && imageMTime == m_ShrinkFactorsMTime)
+    return;
+
+  ShrinkFactorsType fullResolution;
+  fullResolution.Fill(1);
+
+  m_ShrinkFactors.assign(1, fullResolution);
+  m_ShrinkFactorsMTime = imageMTime;
+  m_MinimumSpacing = 1.0;
+
+  if (!isValid)
+    return;
+
+  const auto spacing = m_Image->GetGeometry()->GetSpacing();
+
+  unsigned int dimensions[3];
+  ScalarType minimumSpacing = std::numeric_limits<ScalarType>::max();
+
+  for (unsigned int i = 0; i < 3; ++i)
+  {
+    dimensions[i] = i < m_Image->GetDimension() ? m_Image->GetDimension(i) : 1;
+
+    if (1 < dimensions[i])
+      minimumSpacing = std::min(minimumSpacing, spacing[i]);
+  }
+
+  if (std::numeric_limits<ScalarType>::max() == minimumSpacing || minimumSpacing <= 0.0)
+    return;
+
+  m_MinimumSpacing = minimumSpacing;
+
+  for (unsigned int level = 1; level < MaximumNumberOfLevels; ++level)
+  {
+    const auto &previousFactors = m_ShrinkFactors.back();
+
+    unsigned int largestExtent = 0;
+    for (unsigned int i = 0; i < 3; ++i)
+      largestExtent = std::max(largestExtent, dimensions[i] / previousFactors[i]);
+
+    if (largestExtent <= m_MinimumSize)
+      break;
+
+    const ScalarType targetSpacing = m_MinimumSpacing * static_cast<ScalarType>(1u << level);
+
+    ShrinkFactorsType factors;
+    for (unsigned int i = 0; i < 3; ++i)
+    {
+      const auto factor = static_cast<unsigned int>(std::floor(targetSpacing / spacing[i] + 1e-6));
+      factors[i] = 1 < dimensions[i] ? std::clamp(factor, 1u, dimensions[i]) : 1;
+    }
+
+    if (factors == previousFactors)
+      break;
+
+    m_ShrinkFactors.push_back(factors);
+  }
+}
+
+unsigned int mitk::ImagePyramid::GetNumberOfLevels() const
+{
+  this->UpdateShrinkFactors();
+  return static_cast<unsigned int>(m_ShrinkFactors.size());
+}
+
+mitk::ImagePyramid::ShrinkFactorsType mitk::ImagePyramid::GetShrinkFactors(unsigned int level) const
+{
+  this->UpdateShrinkFactors();
+
+  if (level >= m_ShrinkFactors.size())
+    mitkThrow() << "Level " << level << " of image pyramid does not exist. Number of levels: " << m_ShrinkFactors.size();
+
+  return m_ShrinkFactors[level];
+}
+
+unsigned int mitk::ImagePyramid::GetLevelForResolution(ScalarType mmPerPixel) const
+{
+  this->UpdateShrinkFactors();
+
+  unsigned int level = 0;
+
+  while (level + 1 < m_ShrinkFactors.size() && m_MinimumSpacing * static_cast<ScalarType>(2u << level) <= mmPerPixel)
+    ++level;
+
+  return level;
+}
+
+const mitk::Image *mitk::ImagePyramid::GetLevel(unsigned int level, TimeStepType timeStep)
+{
+  if (m_Image.IsNull())
+    return nullptr;
+
+  if (0 == level)
+    return m_Image;
+
+  this->UpdateShrinkFactors();
+
+  if (level >= m_ShrinkFactors.size())
+    mitkThrow() << "Level " << level << " of image pyramid does not exist. Number of levels: " << m_ShrinkFactors.size();
+
+  if (!m_Image->GetTimeGeometry()->IsValidTimeStep(timeStep))
+    mitkThrow() << "Invalid time step " << timeStep << " requested from image pyramid.";
+
+  auto &entry = m_Levels[std::make_pair(level, timeStep)];
+
+  if (entry.LevelImage.IsNull() || entry.ImageMTime != this->GetImageMTime(timeStep))
+  {
+    entry.LevelImage = this->ComputeLevel(level, timeStep);
+    entry.ImageMTime = this->GetImageMTime(timeStep);
+  }
+
+  return entry.LevelImage;
+}
+
+void mitk::ImagePyramid::ReleaseLevels()
+{
+  m_Levels.clear();
+}
+
+mitk::Image::Pointer mitk::ImagePyramid::ComputeLevel(unsigned int level, TimeStepType timeStep) const
+{
+  const auto &factors = m_ShrinkFactors[level];
+
+  auto *input = const_cast<Image *>(m_Image.GetPointer())->GetVtkImageData(static_cast<int>(timeStep));
+
+  if (nullptr == input)
+    mitkThrow() << "Cannot access time step " << timeStep << " of image to compute image pyramid.";
+
+  auto shrink = vtkSmartPointer<vtkImageShrink3D>::New();
+  shrink->SetInputData(input);
+  shrink->SetShrinkFactors(static_cast<int>(factors[0]), static_cast<int>(factors[1]), static_cast<int>(factors[2]));
+  shrink->SetAveraging(m_Averaging);
+  shrink->Update();
+
+  auto *output = shrink->GetOutput();
+
+  int outputDimensions[3];
+  output->GetDimensions(outputDimensions);
+
+  // The level covers the same region of space: its voxels are scaled by the shrink factors and
+  // averaged voxels are located at the centers of the shrunk blocks.
+  const auto *timeStepGeometry = m_Image->GetGeometry(timeStep);
+  auto geometry = timeStepGeometry->Clone();
+
+  Point3D origin = timeStepGeometry->GetOrigin();
+
+  if (m_Averaging)
+  {
+    Point3D blockCenter;
+    for (unsigned int i = 0; i < 3; ++i)
+      blockCenter[i] = 0.5 * (factors[i] - 1);
+
+    timeStepGeometry->IndexToWorld(blockCenter, origin);
+  }
+
+  Vector3D spacing = timeStepGeometry->GetSpacing();
+  for (unsigned int i = 0; i < 3; ++i)
+    spacing[i] *= factors[i];
+
+  geometry->SetSpacing(spacing);
+  geometry->SetOrigin(origin);
+
+  auto bounds = geometry->GetBounds();
+  for (unsigned int i = 0; i < 3; ++i)
+  {
+    bounds[2 * i] = 0;
+    bounds[2 * i + 1] = outputDimensions[i];
+  }
+  geometry->SetBounds(bounds);
+
+  auto levelImage = Image::New();
+  levelImage->Initialize(m_Image->GetPixelType(), *geometry);
+  levelImage->SetVolume(output->GetScalarPointer());
+
+  return levelImage;
+}
+
+void mitk::ImagePyramid::PrintSelf(std::ostream &os, itk::Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+
+  os << indent << "MinimumSize: " << m_MinimumSize << std::endl;
+  os << indent << "Averaging: " << m_Averaging << std::endl;
+  os << indent << "NumberOfLevels: " << this->GetNumberOfLevels() << std::endl;
+  os << indent << "NumberOfComputedLevels: " << m_Levels.size() << std::endl;
+}
@@ -14,6 +14,8 @@ found in the LICENSE file.
 
 #include "mitkImage.h"
 
+#include <mutex>
+
 mitk::ImageReadAccessor::ImageReadAccessor(ImageConstPointer image, const mitk::ImageDataItem *iDI, int OptionFlags)
   : ImageAccessorBase(image, iDI, OptionFlags), m_Image(image)
 {
@@ -21,7 +23,10 @@ mitk::ImageReadAccessor::ImageReadAccessor(ImageConstPointer image, const mitk::
   {
     try
     {
-      OrganizeReadAccess();
+      if (OptionFlags & ImageAccessorBase::SharedReadAccess)
+        OrganizeSharedReadAccess();
+      else
+        OrganizeReadAccess();
     }
     catch (...)
     {
@@ -38,7 +43,10 @@ mitk::ImageReadAccessor::ImageReadAccessor(ImagePointer image, const mitk::Image
   {
     try
     {
-      OrganizeReadAccess();
+      if (OptionFlags & ImageAccessorBase::SharedReadAccess)
+        OrganizeSharedReadAccess();
+      else
+        OrganizeReadAccess();
     }
     catch (...)
     {
@@ -56,7 +64,13 @@ mitk::ImageReadAccessor::ImageReadAccessor(const mitk::Image *image, const Image
 
 mitk::ImageReadAccessor::~ImageReadAccessor()
 {
-  if (!(m_Options & ImageAccessorBase::IgnoreLock))
+  if (!(m_Options & ImageAccessorBase::IgnoreLock) && (m_Options & ImageAccessorBase::SharedReadAccess))
+  {
+    ReleaseSharedReadAccess();
+    ImageAccessorBase::RemoveSharedReadAccessOfCurrentThread(m_Image);
+    delete m_WaitLock;
+  }
+  else if (!(m_Options & ImageAccessorBase::IgnoreLock))
   {
     // Future work: In case of non-coherent memory, copied area needs to be deleted
 
@@ -145,3 +159,60 @@ void mitk::ImageReadAccessor::OrganizeReadAccess()
   // fflush(0);
   m_Image->m_ReadWriteLock.unlock();
 }
+
+void mitk::ImageReadAccessor::OrganizeSharedReadAccess()
+{
+  if (ImageAccessorBase::HasSharedReadAccessOfCurrentThread(m_Image))
+  {
+    // Nested read of this thread: no write accessor can hold access while this thread reads. Waiting for queued
+    // write accessors would deadlock, because they wait for the shared access this thread already holds.
+    m_Image->m_SharedReaderCount.fetch_add(1);
+    ImageAccessorBase::AddSharedReadAccessOfCurrentThread(m_Image);
+    return;
+  }
+
+  while (true)
+  {
+    // Register first and check for write accessors afterwards. Write accessors are counted before they check
+    // for shared readers, so at least one of both sees the other one.
+    m_Image->m_SharedReaderCount.fetch_add(1);
+
+    if (m_Image->m_WriterCount.load() == 0)
+    {
+      ImageAccessorBase::AddSharedReadAccessOfCurrentThread(m_Image);
+      return;
+    }
+
+    // A write accessor holds or waits for access. Step back, so it does not wait for us.
+    ReleaseSharedReadAccess();
+
+    m_Image->m_ReadWriteLock.lock();
+
+    for (auto *w : m_Image->m_Writers)
+    {
+      // throws if this thread holds the write accessor
+      PreventRecursiveMutexLock(w);
+    }
+
+    if (m_Options & ExceptionIfLocked)
+    {
+      m_Image->m_ReadWriteLock.unlock();
+      mitkThrowException(mitk::MemoryIsLockedException)
+        << "The image being ordered by the ImageAccessor is already in use and locked";
+    }
+
+    // WAIT until all write accessors are released and try again
+    std::unique_lock<std::mutex> lock(m_Image->m_ReadWriteLock, std::adopt_lock);
+    m_Image->m_SharedAccessCondition.wait(lock, [this]() { return m_Image->m_WriterCount.load() == 0; });
+  }
+}
+
+void mitk::ImageReadAccessor::ReleaseSharedReadAccess()
+{
+  if (m_Image->m_SharedReaderCount.fetch_sub(1) == 1 && m_Image->m_WriterCount.load() > 0)
+  {
+    // the last shared reader wakes up write accessors waiting for it
+    std::lock_guard<std::mutex> lock(m_Image->m_ReadWriteLock);
+    m_Image->m_SharedAccessCondition.notify_all();
+  }
+}
@@ -12,11 +12,25 @@ found in the LICENSE file.
 
 #include "mitkImageWriteAccessor.h"
 
+#include <mutex>
+
 mitk::ImageWriteAccessor::ImageWriteAccessor(ImagePointer image, const mitk::ImageDataItem *iDI, int OptionFlags)
   : ImageAccessorBase(image.GetPointer(), iDI, OptionFlags), m_Image(image)
 
 {
-  OrganizeWriteAccess();
+  try
+  {
+    OrganizeWriteAccess();
+  }
+  catch (...)
+  {
+    // OrganizeWriteAccess() keeps this accessor counted if it throws
+    m_Image->m_ReadWriteLock.lock();
+    m_Image->m_WriterCount.fetch_sub(1);
+    m_Image->m_SharedAccessCondition.notify_all();
+    m_Image->m_ReadWriteLock.unlock();
+    throw;
+  }
 }
 
 mitk::ImageWriteAccessor::~ImageWriteAccessor()
@@ -30,6 +44,10 @@ mitk::ImageWriteAccessor::~ImageWriteAccessor()
   auto it = std::find(m_Image->m_Writers.begin(), m_Image->m_Writers.end(), this);
   m_Image->m_Writers.erase(it);
 
+  // wake up shared readers waiting for the release of all write accessors
+  m_Image->m_WriterCount.fetch_sub(1);
+  m_Image->m_SharedAccessCondition.notify_all();
+
   // delete lock, if there are no waiting ImageAccessors
   if (m_WaitLock->m_WaiterCount <= 0)
   {
@@ -53,6 +71,32 @@ void mitk::ImageWriteAccessor::OrganizeWriteAccess()
 {
   m_Image->m_ReadWriteLock.lock();
 
+  // Counted before checking for shared readers, see ImageReadAccessor::OrganizeSharedReadAccess()
+  m_Image->m_WriterCount.fetch_add(1);
+
+  // Shared readers are not stored in m_Readers, but exclude every write access
+  if (m_Image->m_SharedReaderCount.load() > 0)
+  {
+    if (ImageAccessorBase::HasSharedReadAccessOfCurrentThread(m_Image))
+    {
+      m_Image->m_ReadWriteLock.unlock();
+      mitkThrow() << "Prohibited image access: the image is read with shared access by this thread and cannot be "
+                     "written!";
+    }
+
+    if (m_Options & ExceptionIfLocked)
+    {
+      m_Image->m_ReadWriteLock.unlock();
+      mitkThrowException(mitk::MemoryIsLockedException)
+        << "The image part being ordered by the ImageAccessor is already in use and locked";
+    }
+
+    // WAIT for the release of all shared readers
+    std::unique_lock<std::mutex> lock(m_Image->m_ReadWriteLock, std::adopt_lock);
+    m_Image->m_SharedAccessCondition.wait(lock, [this]() { return m_Image->m_SharedReaderCount.load() == 0; });
+    lock.release();
+  }
+
   bool readOverlap = false;
   bool writeOverlap = false;
 
@@ -114,8 +158,10 @@ void mitk::ImageWriteAccessor::OrganizeWriteAccess()
     // afterwards.
     if (!(m_Options & ExceptionIfLocked))
     {
-      // WAIT
+      // WAIT, without blocking shared readers meanwhile
       overlapLock->m_WaiterCount += 1;
+      m_Image->m_WriterCount.fetch_sub(1);
+      m_Image->m_SharedAccessCondition.notify_all();
       m_Image->m_ReadWriteLock.unlock();
       ImageAccessorBase::WaitForReleaseOf(overlapLock);
 
@@ -0,0 +1,66 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include <mitkPropertyKey.h>
+
+#include <mutex>
+#include <unordered_map>
+
+namespace
+{
+  struct PropertyKeyRegistry
+  {
+    PropertyKeyRegistry()
+    {
+      // id 0 is reserved for the empty key
+      Ids.emplace(std::string(), 0);
+    }
+
+    std::mutex Mutex;
+    std::unordered_map<std::string, mitk::PropertyKey::IdType> Ids;
+  };
+
+  PropertyKeyRegistry &GetRegistry()
+  {
+    // intentionally leaked so that static keys can safely be used during static destruction
+    static auto *registry = new PropertyKeyRegistry;
+    return *registry;
+  }
+
+  // The keys of an unordered_map are node-based and never move, so their addresses stay valid.
+  mitk::PropertyKey::IdType Intern(const std::string &name, const std::string *&internedName)
+  {
+    auto &registry = GetRegistry();
+    std::lock_guard<std::mutex> lock(registry.Mutex);
+
+    auto iter = registry.Ids.emplace(name, registry.Ids.size()).first;
+    internedName = &iter->first;
+
+    return iter->second;
+  }
+}
+
+mitk::PropertyKey::PropertyKey()
+  : PropertyKey(std::string())
+{
+}
+
+mitk::PropertyKey::PropertyKey(const std::string &name)
+  : m_Name(nullptr),
+    m_Id(Intern(name, m_Name))
+{
+}
+
+mitk::PropertyKey::PropertyKey(const char *name)
+  : PropertyKey(std::string(nullptr != name ? name : ""))
+{
+}
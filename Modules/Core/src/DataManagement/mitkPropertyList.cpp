@@ -56,6 +56,11 @@ mitk::BaseProperty *mitk::PropertyList::GetProperty(const std::string &propertyK
     return nullptr;
 }
 
+mitk::BaseProperty *mitk::PropertyList::GetProperty(const PropertyKey &propertyKey) const
+{
+  return this->GetProperty(propertyKey.GetName());
+}
+
 mitk::BaseProperty * mitk::PropertyList::GetNonConstProperty(const std::string &propertyKey, const std::string &/*contextName*/, bool /*fallBackOnDefaultContext*/)
 {
   return this->GetProperty(propertyKey);
@@ -104,6 +109,7 @@ void mitk::PropertyList::SetProperty(const std::string &propertyKey, BasePropert
 
   // no? add it.
   m_Properties.insert(PropertyMap::value_type(propertyKey, property));
+  m_KeysModifiedTime.Modified();
   this->Modified();
 }
 
@@ -123,6 +129,7 @@ void mitk::PropertyList::ReplaceProperty(const std::string &propertyKey, BasePro
 
   // no? add/replace it.
   m_Properties.insert(PropertyMap::value_type(propertyKey, property));
+  m_KeysModifiedTime.Modified();
   Modified();
 }
 
@@ -135,12 +142,14 @@ void mitk::PropertyList::RemoveProperty(const std::string &propertyKey, const st
   {
     it->second = nullptr;
     m_Properties.erase(it);
+    m_KeysModifiedTime.Modified();
     Modified();
   }
 }
 
 mitk::PropertyList::PropertyList()
 {
+  m_KeysModifiedTime.Modified();
 }
 
 mitk::PropertyList::PropertyList(const mitk::PropertyList &other) : itk::Object()
@@ -149,6 +158,8 @@ mitk::PropertyList::PropertyList(const mitk::PropertyList &other) : itk::Object(
   {
     m_Properties.insert(std::make_pair(i->first, i->second->Clone()));
   }
+
+  m_KeysModifiedTime.Modified();
 }
 
 mitk::PropertyList::~PropertyList()
@@ -178,6 +189,11 @@ itk::ModifiedTimeType mitk::PropertyList::GetMTime() const
   return Superclass::GetMTime();
 }
 
+itk::ModifiedTimeType mitk::PropertyList::GetKeysMTime() const
+{
+  return m_KeysModifiedTime.GetMTime();
+}
+
 bool mitk::PropertyList::DeleteProperty(const std::string &propertyKey)
 {
   auto it = m_Properties.find(propertyKey);
@@ -186,6 +202,7 @@ bool mitk::PropertyList::DeleteProperty(const std::string &propertyKey)
   {
     it->second = nullptr;
     m_Properties.erase(it);
+    m_KeysModifiedTime.Modified();
     Modified();
     return true;
   }
@@ -201,6 +218,7 @@ void mitk::PropertyList::Clear()
     ++it;
   }
   m_Properties.clear();
+  m_KeysModifiedTime.Modified();
 }
 
 itk::LightObject::Pointer mitk::PropertyList::InternalClone() const
@@ -419,4 +437,5 @@ void mitk::PropertyList::FromJSON(const nlohmann::json& j)
   }
 
   m_Properties = properties;
+  m_KeysModifiedTime.Modified();
 }
@@ -12,6 +12,7 @@ found in the LICENSE file.
 
 #include "mitkCustomMimeType.h"
 
+#include "mitkFileHeader.h"
 #include "mitkMimeType.h"
 
 #include <mitkUtf8Util.h>
@@ -47,6 +48,7 @@ namespace mitk
     std::string m_Category;
     std::vector<std::string> m_Extensions;
     std::string m_Comment;
+    std::vector<MagicBytesType> m_MagicBytes;
   };
 
   CustomMimeType::~CustomMimeType() { delete d; }
@@ -59,6 +61,7 @@ namespace mitk
     d->m_Category = other.GetCategory();
     d->m_Extensions = other.GetExtensions();
     d->m_Comment = other.GetComment();
+    d->m_MagicBytes = other.GetMagicBytes();
   }
 
   CustomMimeType &CustomMimeType::operator=(const CustomMimeType &other)
@@ -110,6 +113,17 @@ namespace mitk
     return filename;
   }
 
+  std::vector<CustomMimeType::MagicBytesType> CustomMimeType::GetMagicBytes() const { return d->m_MagicBytes; }
+  bool CustomMimeType::MatchesMagicBytes(const FileHeader &header) const
+  {
+    if (d->m_MagicBytes.empty())
+      return true;
+
+    return std::any_of(d->m_MagicBytes.begin(), d->m_MagicBytes.end(), [&header](const MagicBytesType &magicBytes) {
+      return header.Matches(magicBytes.second, magicBytes.first);
+    });
+  }
+
   bool CustomMimeType::ParsePathForExtension(const std::string &path,
                                              std::string &extension,
                                              std::string &filename) const
@@ -151,6 +165,12 @@ namespace mitk
   }
 
   void CustomMimeType::SetComment(const std::string &comment) { d->m_Comment = comment; }
+  void CustomMimeType::AddMagicBytes(const std::string &bytes, std::size_t offset)
+  {
+    if (!bytes.empty())
+      d->m_MagicBytes.emplace_back(offset, bytes);
+  }
+
   void CustomMimeType::Swap(CustomMimeType &r)
   {
     Impl *d1 = d;
@@ -0,0 +1,111 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkFileHeader.h"
+
+#include "mitkUtf8Util.h"
+
+#include <itksys/SystemTools.hxx>
+
+#include <algorithm>
+#include <fstream>
+#include <map>
+
+namespace mitk
+{
+  struct FileHeader::Impl
+  {
+    std::string m_Data;
+    unsigned long m_FileSize = 0;
+  };
+
+  namespace
+  {
+    /** Headers of the current thread, kept while a FileHeader::Scope exists. */
+    struct ScopeData
+    {
+      unsigned int m_Depth = 0;
+      std::map<std::string, FileHeader> m_Headers;
+    };
+
+    thread_local ScopeData scopeData;
+  }
+
+  FileHeader::Scope::Scope() { ++scopeData.m_Depth; }
+
+  FileHeader::Scope::~Scope()
+  {
+    if (0 == --scopeData.m_Depth)
+      scopeData.m_Headers.clear();
+  }
+
+  FileHeader::FileHeader() {}
+
+  FileHeader FileHeader::Read(const std::string &path)
+  {
+    if (0 < scopeData.m_Depth)
+    {
+      auto iter = scopeData.m_Headers.find(path);
+
+      if (iter != scopeData.m_Headers.end())
+        return iter->second;
+    }
+
+    FileHeader result;
+    const auto utf8Path = Utf8Util::Local8BitToUtf8(path);
+
+    if (!path.empty() && itksys::SystemTools::FileExists(utf8Path, true))
+    {
+      std::ifstream stream(path, std::ios::binary);
+
+      if (stream.is_open())
+      {
+        const auto fileSize = itksys::SystemTools::FileLength(utf8Path);
+
+        auto data = std::make_shared<Impl>();
+        data->m_Data.resize(std::min<std::size_t>(fileSize, GetMaximumSize()));
+        stream.read(&data->m_Data[0], static_cast<std::streamsize>(data->m_Data.size()));
+        data->m_Data.resize(static_cast<std::size_t>(stream.gcount()));
+        data->m_FileSize = fileSize;
+
+        result.m_Data = data;
+      }
+    }
+
+    // invalid headers are kept, too, so files that cannot be read are not tried again
+    if (0 < scopeData.m_Depth)
+      scopeData.m_Headers[path] = result;
+
+    return result;
+  }
+
+  std::size_t FileHeader::GetMaximumSize() { return 64 * 1024; }
+
+  bool FileHeader::IsValid() const { return m_Data != nullptr; }
+
+  bool FileHeader::IsComplete() const
+  {
+    return m_Data != nullptr && m_Data->m_Data.size() == m_Data->m_FileSize;
+  }
+
+  std::size_t FileHeader::GetSize() const { return m_Data != nullptr ? m_Data->m_Data.size() : 0; }
+
+  const char *FileHeader::GetData() const { return m_Data != nullptr ? m_Data->m_Data.data() : nullptr; }
+
+  bool FileHeader::Matches(const std::string &bytes, std::size_t offset) const
+  {
+    if (m_Data == nullptr || offset > m_Data->m_Data.size() || bytes.size() > m_Data->m_Data.size() - offset)
+      return false;
+
+    return 0 == m_Data->m_Data.compare(offset, bytes.size(), bytes);
+  }
+}
@@ -13,6 +13,7 @@ found in the LICENSE file.
 #include "mitkFileReaderSelector.h"
 
 #include <mitkCoreServices.h>
+#include <mitkFileHeader.h>
 #include <mitkFileReaderRegistry.h>
 #include <mitkIMimeTypeProvider.h>
 #include <mitkUtf8Util.h>
@@ -23,6 +24,8 @@ found in the LICENSE file.
 
 #include <itksys/SystemTools.hxx>
 
+#include <set>
+
 namespace mitk
 {
   struct FileReaderSelector::Item::Impl : us::SharedData
@@ -35,6 +38,38 @@ namespace mitk
     long m_Id;
   };
 
+  namespace
+  {
+    struct Candidate
+    {
+      us::ServiceReference<IFileReader> m_FileReaderRef;
+      IFileReader *m_FileReader = nullptr;
+      IFileReader::ConfidenceLevel m_ConfidenceLevel = IFileReader::Unsupported;
+      MimeType m_MimeType;
+      long m_Id = -1;
+    };
+
+    /** Asks all readers for their confidence level. Readers are not required to be thread-safe,
+        so they are probed one after the other. Readers that look at the file header share it
+        (see FileHeader::Scope). */
+    void DetermineConfidenceLevels(const std::string &path, std::vector<Candidate> &candidates)
+    {
+      for (auto &candidate : candidates)
+      {
+        try
+        {
+          candidate.m_FileReader->SetInput(path);
+          candidate.m_ConfidenceLevel = candidate.m_FileReader->GetConfidenceLevel();
+        }
+        catch (const std::exception &e)
+        {
+          // Log the error but continue
+          MITK_WARN << "IFileReader::GetConfidenceLevel exception: " << e.what();
+        }
+      }
+    }
+  }
+
   struct FileReaderSelector::Impl : us::SharedData
   {
     Impl() : m_BestId(-1), m_SelectedId(m_BestId) {}
@@ -54,6 +89,9 @@ namespace mitk
       return;
     }
 
+    // the file is read only once for all mime types and readers
+    FileHeader::Scope headerScope;
+
     mitk::CoreServicePointer<mitk::IMimeTypeProvider> mimeTypeProvider(mitk::CoreServices::GetMimeTypeProvider());
 
     // Get all mime types and associated readers for the given file path
@@ -62,50 +100,51 @@ namespace mitk
     if (m_Data->m_MimeTypes.empty())
       return;
 
-    for (std::vector<MimeType>::const_iterator mimeTypeIter = m_Data->m_MimeTypes.begin(),
-                                               mimeTypeIterEnd = m_Data->m_MimeTypes.end();
-         mimeTypeIter != mimeTypeIterEnd;
-         ++mimeTypeIter)
+    // Collect the readers for all mime types (in descending rank order). A reader registered for multiple
+    // mime types is probed only once for its first one, which is where it ended up before as well.
+    std::vector<Candidate> candidates;
+    std::set<IFileReader *> readers;
+
+    for (const auto &mimeType : m_Data->m_MimeTypes)
     {
-      std::vector<FileReaderRegistry::ReaderReference> refs = m_Data->m_ReaderRegistry.GetReferences(*mimeTypeIter);
-      for (std::vector<FileReaderRegistry::ReaderReference>::const_iterator readerIter = refs.begin(),
-                                                                            iterEnd = refs.end();
-           readerIter != iterEnd;
-           ++readerIter)
+      for (const auto &readerRef : m_Data->m_ReaderRegistry.GetReferences(mimeType))
       {
-        IFileReader *reader = m_Data->m_ReaderRegistry.GetReader(*readerIter);
-        if (reader == nullptr)
+        IFileReader *reader = m_Data->m_ReaderRegistry.GetReader(readerRef);
+        if (reader == nullptr || !readers.insert(reader).second)
           continue;
+
         try
         {
-          reader->SetInput(path);
-          IFileReader::ConfidenceLevel confidenceLevel = reader->GetConfidenceLevel();
-          if (confidenceLevel == IFileReader::Unsupported)
-          {
-            continue;
-          }
-
-          Item item;
-          item.d->m_FileReaderRef = *readerIter;
-          item.d->m_FileReader = reader;
-          item.d->m_ConfidenceLevel = confidenceLevel;
-          item.d->m_MimeType = *mimeTypeIter;
-          item.d->m_Id = us::any_cast<long>(readerIter->GetProperty(us::ServiceConstants::SERVICE_ID()));
-          m_Data->m_Items.insert(std::make_pair(item.d->m_Id, item));
-          // m_Data->m_MimeTypes.insert(mimeType);
+          Candidate candidate;
+          candidate.m_FileReaderRef = readerRef;
+          candidate.m_FileReader = reader;
+          candidate.m_MimeType = mimeType;
+          candidate.m_Id = us::any_cast<long>(readerRef.GetProperty(us::ServiceConstants::SERVICE_ID()));
+          candidates.push_back(candidate);
         }
         catch (const us::BadAnyCastException &e)
         {
           MITK_WARN << "Unexpected: " << e.what();
         }
-        catch (const std::exception &e)
-        {
-          // Log the error but continue
-          MITK_WARN << "IFileWriter::GetConfidenceLevel exception: " << e.what();
-        }
       }
     }
 
+    DetermineConfidenceLevels(path, candidates);
+
+    for (const auto &candidate : candidates)
+    {
+      if (candidate.m_ConfidenceLevel == IFileReader::Unsupported)
+        continue;
+
+      Item item;
+      item.d->m_FileReaderRef = candidate.m_FileReaderRef;
+      item.d->m_FileReader = candidate.m_FileReader;
+      item.d->m_ConfidenceLevel = candidate.m_ConfidenceLevel;
+      item.d->m_MimeType = candidate.m_MimeType;
+      item.d->m_Id = candidate.m_Id;
+      m_Data->m_Items.insert(std::make_pair(item.d->m_Id, item));
+    }
+
     // get the "best" reader
 
     if (!m_Data->m_Items.empty())
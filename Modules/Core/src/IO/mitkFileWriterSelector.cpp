@@ -24,12 +24,37 @@ found in the LICENSE file.
 
 #include <itksys/SystemTools.hxx>
 
+#include <algorithm>
 #include <iterator>
 #include <limits>
 #include <set>
 
 namespace mitk
 {
+  namespace
+  {
+    /** Like IMimeTypeProvider::GetMimeTypesForFile() but without checking magic bytes, as the content of an
+        already existing file must not matter for writing. */
+    std::vector<MimeType> GetMimeTypesForOutputFile(const std::vector<MimeType> &mimeTypes, const std::string &path)
+    {
+      std::vector<MimeType> result;
+      for (const auto &mimeType : mimeTypes)
+      {
+        try
+        {
+          if (mimeType.AppliesTo(path))
+            result.push_back(mimeType);
+        }
+        catch (...)
+        {
+        }
+      }
+      std::sort(result.begin(), result.end());
+      std::reverse(result.begin(), result.end());
+      return result;
+    }
+  }
+
   struct FileWriterSelector::Item::Impl : us::SharedData
   {
     Impl() : m_FileWriter(nullptr), m_ConfidenceLevel(IFileWriter::Unsupported), m_BaseDataIndex(0), m_Id(-1) {}
@@ -64,7 +89,7 @@ namespace mitk
     if (destMimeType.empty() && !path.empty())
     {
       // try to derive a mime-type from the file
-      std::vector<MimeType> mimeTypes = mimeTypeProvider->GetMimeTypesForFile(path);
+      std::vector<MimeType> mimeTypes = GetMimeTypesForOutputFile(mimeTypeProvider->GetMimeTypes(), path);
       if (!mimeTypes.empty())
       {
         for (unsigned int index = 0; index < mimeTypes.size(); index++)
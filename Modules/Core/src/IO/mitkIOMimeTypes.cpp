@@ -300,6 +300,7 @@ namespace mitk
     CustomMimeType mimeType(NRRD_MIMETYPE_NAME());
     mimeType.AddExtension("nrrd");
     mimeType.AddExtension("nhdr");
+    mimeType.AddMagicBytes("NRRD");
     mimeType.SetCategory("Images");
     mimeType.SetComment("NRRD");
     return mimeType;
@@ -15,6 +15,9 @@ found in the LICENSE file.
 #include "mitkIOMimeTypes.h"
 #include "mitkImage.h"
 #include "mitkImageVtkReadAccessor.h"
+#include "mitkVtkLegacyFileHeader.h"
+
+#include <mitkFileHeader.h>
 
 #include <vtkErrorCode.h>
 #include <vtkSmartPointer.h>
@@ -61,6 +64,19 @@ namespace mitk
   {
     if (AbstractFileIO::GetReaderConfidenceLevel() == Unsupported)
       return Unsupported;
+
+    if (this->GetInputStream() == nullptr)
+    {
+      VtkLegacyFileHeader header;
+      auto parseResult = VtkLegacyFileHeader::Parse(FileHeader::Read(this->GetInputLocation()), header);
+
+      if (VtkLegacyFileHeader::ParseResult::Valid == parseResult)
+        return header.IsDataset("structured_points") ? Supported : Unsupported;
+
+      if (VtkLegacyFileHeader::ParseResult::Invalid == parseResult)
+        return Unsupported;
+    }
+
     vtkSmartPointer<vtkStructuredPointsReader> reader = vtkSmartPointer<vtkStructuredPointsReader>::New();
     reader->SetFileName(this->GetLocalFileName().c_str());
     if (reader->IsFileStructuredPoints())
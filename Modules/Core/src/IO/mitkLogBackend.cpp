@@ -67,6 +67,18 @@ void mitk::LogBackend::ProcessMessage(const LogMessage& message)
   logMutex.unlock();
 }
 
+void mitk::LogBackend::Flush()
+{
+  logMutex.lock();
+
+  std::cout.flush();
+
+  if (logFile)
+    logFile->flush();
+
+  logMutex.unlock();
+}
+
 void mitk::LogBackend::Register()
 {
   if (mitkLogBackend)
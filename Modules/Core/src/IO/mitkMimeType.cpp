@@ -57,6 +57,11 @@ namespace mitk
     return m_Data->m_CustomMimeType->GetFilenameWithoutExtension(path);
   }
 
+  std::vector<CustomMimeType::MagicBytesType> MimeType::GetMagicBytes() const
+  {
+    return m_Data->m_CustomMimeType->GetMagicBytes();
+  }
+
   bool MimeType::AppliesTo(const std::string &path) const { return m_Data->m_CustomMimeType->AppliesTo(path); }
   bool MimeType::MatchesExtension(const std::string &path) const
   {
@@ -12,6 +12,7 @@ found in the LICENSE file.
 
 #include "mitkMimeTypeProvider.h"
 
+#include "mitkFileHeader.h"
 #include "mitkLog.h"
 
 #include <usGetModuleContext.h>
@@ -51,8 +52,28 @@ namespace mitk
   std::vector<MimeType> MimeTypeProvider::GetMimeTypesForFile(const std::string &filePath) const
   {
     std::vector<MimeType> result;
+
+    // mime types with magic bytes are filtered by a single look at the file header
+    FileHeader::Scope headerScope;
+    FileHeader header;
+    std::set<std::string> matchingMagicBytes;
+
+    if (!m_MimeTypeNamesWithMagicBytes.empty())
+    {
+      header = FileHeader::Read(filePath);
+
+      if (header.IsValid())
+        matchingMagicBytes = this->GetMimeTypeNamesMatchingMagicBytes(header);
+    }
+
     for (const auto &elem : m_NameToMimeType)
     {
+      if (header.IsValid() && m_MimeTypeNamesWithMagicBytes.count(elem.first) != 0 &&
+          matchingMagicBytes.count(elem.first) == 0)
+      {
+        continue;
+      }
+
       try
       {
         if (elem.second.AppliesTo(filePath))
@@ -114,6 +135,7 @@ namespace mitk
 
       // get the highest ranked mime-type
       m_NameToMimeType[name] = *(m_NameToMimeTypes[name].rbegin());
+      this->UpdateMagicBytesIndex();
     }
     return result;
   }
@@ -138,6 +160,49 @@ namespace mitk
       // get the highest ranked mime-type
       m_NameToMimeType[name] = *(mimeTypes.rbegin());
     }
+    this->UpdateMagicBytesIndex();
+  }
+
+  void MimeTypeProvider::UpdateMagicBytesIndex()
+  {
+    m_MagicBytesIndex.clear();
+    m_MagicBytesOffsets.clear();
+    m_MimeTypeNamesWithMagicBytes.clear();
+
+    for (const auto &elem : m_NameToMimeType)
+    {
+      for (const auto &magicBytes : elem.second.GetMagicBytes())
+      {
+        auto key = std::make_pair(magicBytes.first, magicBytes.second.front());
+        m_MagicBytesIndex[key].emplace_back(magicBytes.second, elem.first);
+        m_MagicBytesOffsets.insert(magicBytes.first);
+        m_MimeTypeNamesWithMagicBytes.insert(elem.first);
+      }
+    }
+  }
+
+  std::set<std::string> MimeTypeProvider::GetMimeTypeNamesMatchingMagicBytes(const FileHeader &header) const
+  {
+    std::set<std::string> result;
+
+    for (auto offset : m_MagicBytesOffsets)
+    {
+      if (offset >= header.GetSize())
+        break;
+
+      auto iter = m_MagicBytesIndex.find(std::make_pair(offset, header.GetData()[offset]));
+
+      if (iter == m_MagicBytesIndex.end())
+        continue;
+
+      for (const auto &entry : iter->second)
+      {
+        if (header.Matches(entry.first, offset))
+          result.insert(entry.second);
+      }
+    }
+
+    return result;
   }
 
   MimeType MimeTypeProvider::GetMimeType(const ServiceReferenceType &reference) const
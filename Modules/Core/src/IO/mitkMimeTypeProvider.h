@@ -19,10 +19,13 @@ found in the LICENSE file.
 #include "usServiceTracker.h"
 #include "usServiceTrackerCustomizer.h"
 
+#include <map>
 #include <set>
 
 namespace mitk
 {
+  class FileHeader;
+
   struct MimeTypeTrackerTypeTraits : public us::TrackedTypeTraitsBase<MimeType, MimeTypeTrackerTypeTraits>
   {
     typedef MimeType TrackedType;
@@ -55,12 +58,23 @@ namespace mitk
 
     MimeType GetMimeType(const ServiceReferenceType &reference) const;
 
+    void UpdateMagicBytesIndex();
+
+    /** Returns the names of all mime types with magic bytes found in the header. */
+    std::set<std::string> GetMimeTypeNamesMatchingMagicBytes(const FileHeader &header) const;
+
     us::ServiceTracker<CustomMimeType, MimeTypeTrackerTypeTraits> *m_Tracker;
 
     typedef std::map<std::string, std::set<MimeType>> MapType;
     MapType m_NameToMimeTypes;
 
     std::map<std::string, MimeType> m_NameToMimeType;
+
+    // magic bytes of the mime types in m_NameToMimeType, keyed by offset and first byte
+    typedef std::pair<std::string, std::string> MagicBytesEntry; // bytes and mime type name
+    std::map<std::pair<std::size_t, char>, std::vector<MagicBytesEntry>> m_MagicBytesIndex;
+    std::set<std::size_t> m_MagicBytesOffsets;
+    std::set<std::string> m_MimeTypeNamesWithMagicBytes;
   };
 }
 
@@ -24,3 +24,8 @@ mitk::OperationType mitk::Operation::GetOperationType()
 {
   return m_OperationType;
 }
+
+std::size_t mitk::Operation::GetMemorySize() const
+{
+  return sizeof(*this);
+}
@@ -14,6 +14,9 @@ found in the LICENSE file.
 
 #include "mitkIOMimeTypes.h"
 #include "mitkSurface.h"
+#include "mitkVtkLegacyFileHeader.h"
+
+#include <mitkFileHeader.h>
 
 #include <vtkErrorCode.h>
 #include <vtkPolyDataReader.h>
@@ -61,6 +64,24 @@ namespace mitk
   {
     if (AbstractFileIO::GetReaderConfidenceLevel() == Unsupported)
       return Unsupported;
+
+    if (this->GetInputStream() == nullptr)
+    {
+      VtkLegacyFileHeader header;
+      auto parseResult = VtkLegacyFileHeader::Parse(FileHeader::Read(this->GetInputLocation()), header);
+
+      if (VtkLegacyFileHeader::ParseResult::Valid == parseResult)
+      {
+        if (!header.IsDataset("polydata"))
+          return Unsupported;
+
+        return header.Title == "vtk output" ? Supported : PartiallySupported;
+      }
+
+      if (VtkLegacyFileHeader::ParseResult::Invalid == parseResult)
+        return Unsupported;
+    }
+
     vtkSmartPointer<vtkPolyDataReader> reader = vtkSmartPointer<vtkPolyDataReader>::New();
     reader->SetFileName(this->GetLocalFileName().c_str());
     if (reader->IsFilePolyData())
@@ -0,0 +1,125 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkVtkLegacyFileHeader.h"
+
+#include <mitkFileHeader.h>
+
+#include <algorithm>
+#include <cctype>
+
+namespace
+{
+  // vtkDataReader reads lines and strings into buffers of 256 characters
+  constexpr std::size_t MaximumLength = 255;
+
+  class Tokenizer
+  {
+  public:
+    explicit Tokenizer(const mitk::FileHeader &header)
+      : m_End(header.GetData() + header.GetSize()), m_Position(header.GetData()), m_IsComplete(header.IsComplete())
+    {
+    }
+
+    bool ReadLine(std::string &line)
+    {
+      if (m_Position == m_End)
+        return false;
+
+      auto end = std::find(m_Position, m_End, '\n');
+
+      if (end == m_End && !m_IsComplete)
+        return false; // the line may continue beyond the header
+
+      line.assign(m_Position, std::min<std::size_t>(end - m_Position, MaximumLength));
+
+      if (!line.empty() && line.back() == '\r')
+        line.pop_back();
+
+      m_Position = end != m_End ? end + 1 : end;
+      return true;
+    }
+
+    bool ReadString(std::string &token)
+    {
+      while (m_Position != m_End && std::isspace(static_cast<unsigned char>(*m_Position)))
+        ++m_Position;
+
+      auto end = m_Position;
+
+      while (end != m_End && !std::isspace(static_cast<unsigned char>(*end)))
+        ++end;
+
+      if (m_Position == end || (end == m_End && !m_IsComplete))
+        return false; // no token or the token may continue beyond the header
+
+      token.assign(m_Position, std::min<std::size_t>(end - m_Position, MaximumLength));
+      std::transform(token.begin(), token.end(), token.begin(), ::tolower);
+
+      m_Position = end;
+      return true;
+    }
+
+  private:
+    const char *m_End;
+    const char *m_Position;
+    bool m_IsComplete;
+  };
+}
+
+mitk::VtkLegacyFileHeader::ParseResult mitk::VtkLegacyFileHeader::Parse(const FileHeader &header,
+                                                                        VtkLegacyFileHeader &result)
+{
+  if (!header.IsValid())
+    return ParseResult::Undecided;
+
+  // Running out of data means the end of the file if the header is complete, which is invalid.
+  // Otherwise the remaining part of the file is unknown.
+  const auto outOfData = header.IsComplete() ? ParseResult::Invalid : ParseResult::Undecided;
+
+  Tokenizer tokenizer(header);
+  std::string line;
+
+  if (!tokenizer.ReadLine(line))
+    return outOfData;
+
+  std::transform(line.begin(), line.end(), line.begin(), ::tolower);
+
+  if (0 != line.compare(0, 14, "# vtk datafile"))
+    return ParseResult::Invalid;
+
+  if (!tokenizer.ReadLine(result.Title))
+    return outOfData;
+
+  if (!tokenizer.ReadString(line))
+    return outOfData;
+
+  if (0 != line.compare(0, 5, "ascii") && 0 != line.compare(0, 6, "binary"))
+    return ParseResult::Invalid;
+
+  if (!tokenizer.ReadString(line))
+    return outOfData;
+
+  if (0 != line.compare(0, 7, "dataset"))
+    return ParseResult::Invalid;
+
+  if (!tokenizer.ReadString(result.DatasetType))
+    return outOfData;
+
+  return ParseResult::Valid;
+}
+
+bool mitk::VtkLegacyFileHeader::IsDataset(const std::string &type) const
+{
+  // vtkDataReader only compares the length of the expected type
+  return 0 == DatasetType.compare(0, type.size(), type);
+}
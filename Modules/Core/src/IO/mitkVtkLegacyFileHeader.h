@@ -0,0 +1,48 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef mitkVtkLegacyFileHeader_h
+#define mitkVtkLegacyFileHeader_h
+
+#include <string>
+
+namespace mitk
+{
+  class FileHeader;
+
+  /**
+   * @internal
+   * @brief Title and dataset type of a legacy VTK file, parsed like vtkDataReader does.
+   *
+   * Allows the legacy VTK readers to determine their confidence level from the shared
+   * mitk::FileHeader instead of opening the file with a VTK reader again.
+   */
+  struct VtkLegacyFileHeader
+  {
+    enum class ParseResult
+    {
+      Valid,
+      Invalid,  ///< Not a legacy VTK file
+      Undecided ///< The header is too short, ask VTK instead
+    };
+
+    static ParseResult Parse(const FileHeader &header, VtkLegacyFileHeader &result);
+
+    /** \brief Checks the dataset type, e.g. "structured_points" or "polydata". */
+    bool IsDataset(const std::string &type) const;
+
+    std::string Title;
+    std::string DatasetType; ///< Lower case
+  };
+}
+
+#endif
@@ -20,6 +20,7 @@ found in the LICENSE file.
 #include <mitkPlaneGeometry.h>
 #include <mitkProperties.h>
 #include <mitkPropertyNameHelper.h>
+#include <mitkRenderingManager.h>
 #include <mitkResliceMethodProperty.h>
 #include <mitkVtkResliceInterpolationProperty.h>
 
@@ -55,6 +56,8 @@ found in the LICENSE file.
 #include <itkRGBAPixel.h>
 #include <mitkRenderingModeProperty.h>
 
+#include <cmath>
+
 namespace
 {
   bool IsBinaryImage(mitk::Image* image)
@@ -100,6 +103,7 @@ namespace
 }
 
 mitk::ImageVtkMapper2D::ImageVtkMapper2D()
+  : m_ImagePyramid(ImagePyramid::New())
 {
 }
 
@@ -188,14 +192,25 @@ void mitk::ImageVtkMapper2D::GenerateDataForRenderer(mitk::BaseRenderer *rendere
     return;
   }
 
+  // reslice a coarser level of the image pyramid if requested (see Update()), which
+  // consists of a single time step
+  const Image *resliceInput = image;
+  TimeStepType resliceTimeStep = this->GetTimestep();
+
+  if (0 < localStorage->m_PyramidLevel)
+  {
+    resliceInput = m_ImagePyramid->GetLevel(localStorage->m_PyramidLevel, resliceTimeStep);
+    resliceTimeStep = 0;
+  }
+
   // set main input for ExtractSliceFilter
-  localStorage->m_Reslicer->SetInput(image);
+  localStorage->m_Reslicer->SetInput(resliceInput);
   localStorage->m_Reslicer->SetWorldGeometry(worldGeometry);
-  localStorage->m_Reslicer->SetTimeStep(this->GetTimestep());
+  localStorage->m_Reslicer->SetTimeStep(resliceTimeStep);
 
   // set the transformation of the image to adapt reslice axis
   localStorage->m_Reslicer->SetResliceTransformByGeometry(
-    image->GetTimeGeometry()->GetGeometryForTimeStep(this->GetTimestep()));
+    resliceInput->GetTimeGeometry()->GetGeometryForTimeStep(resliceTimeStep));
 
   // is the geometry of the slice based on the input image or the worldgeometry?
   bool inPlaneResampleExtentByGeometry = false;
@@ -704,8 +719,15 @@ void mitk::ImageVtkMapper2D::Update(mitk::BaseRenderer *renderer)
   const DataNode *node = this->GetDataNode();
   data->UpdateOutputInformation();
 
+  // While the user interacts (level of detail 0), a coarser level of the image pyramid is shown
+  // if available. The next level of detail restores the full resolution (see GetInteractionPyramidLevel()).
+  const auto pyramidLevel = 0 == RenderingManager::GetInstance()->GetNextLOD(renderer)
+    ? this->GetInteractionPyramidLevel(renderer)
+    : 0;
+
   // check if something important has changed and we need to rerender
-  if ((localStorage->m_LastUpdateTime < node->GetMTime()) ||
+  if ((localStorage->m_PyramidLevel != pyramidLevel) ||
+      (localStorage->m_LastUpdateTime < node->GetMTime()) ||
       (localStorage->m_LastUpdateTime < data->GetPipelineMTime()) ||
       (localStorage->m_LastUpdateTime < renderer->GetCurrentWorldPlaneGeometryUpdateTime()) ||
       (localStorage->m_LastUpdateTime < renderer->GetCurrentWorldPlaneGeometry()->GetMTime()) ||
@@ -713,7 +735,14 @@ void mitk::ImageVtkMapper2D::Update(mitk::BaseRenderer *renderer)
       (localStorage->m_LastUpdateTime < node->GetPropertyList(renderer)->GetMTime()) ||
       (localStorage->m_LastUpdateTime < data->GetPropertyList()->GetMTime()))
   {
+    localStorage->m_PyramidLevel = pyramidLevel;
     this->GenerateDataForRenderer(renderer);
+
+    if (0 == pyramidLevel)
+    {
+      localStorage->m_FullResolutionUpdateTime.Modified();
+      localStorage->m_FullResolutionMMPerPixel = renderer->GetScaleFactorMMPerDisplayUnit();
+    }
   }
 
   // since we have checked that nothing important has changed, we can set
@@ -721,6 +750,80 @@ void mitk::ImageVtkMapper2D::Update(mitk::BaseRenderer *renderer)
   localStorage->m_LastUpdateTime.Modified();
 }
 
+bool mitk::ImageVtkMapper2D::IsLODEnabled(mitk::BaseRenderer *renderer) const
+{
+  // called before Update() (see VtkPropRenderer::PrepareMapperQueue()), so it has to evaluate the current state
+  return 0 < const_cast<ImageVtkMapper2D *>(this)->GetInteractionPyramidLevel(renderer);
+}
+
+unsigned int mitk::ImageVtkMapper2D::GetInteractionPyramidLevel(mitk::BaseRenderer *renderer)
+{
+  const auto *worldPlaneGeometry = renderer->GetCurrentWorldPlaneGeometry();
+
+  if (nullptr == worldPlaneGeometry)
+    return 0;
+
+  // a coarser level must not remain visible, e.g. in screenshots or without a timer for the next level of detail
+  if (!RenderingManager::GetInstance()->IsLODIncreaseGuaranteed())
+    return 0;
+
+  const auto *localStorage = m_LSH.GetLocalStorage(renderer);
+
+  // The full resolution slice is kept as long as the plane and the zoom did not change since it was resliced,
+  // e.g. if only the data or its properties changed.
+  const bool planeChanged =
+    localStorage->m_FullResolutionUpdateTime < renderer->GetCurrentWorldPlaneGeometryUpdateTime() ||
+    localStorage->m_FullResolutionUpdateTime < worldPlaneGeometry->GetMTime();
+
+  const bool zoomChanged = localStorage->m_FullResolutionMMPerPixel != renderer->GetScaleFactorMMPerDisplayUnit();
+
+  if (!planeChanged && !zoomChanged)
+    return 0;
+
+  return this->GetDisplayPyramidLevel(renderer);
+}
+
+unsigned int mitk::ImageVtkMapper2D::GetDisplayPyramidLevel(mitk::BaseRenderer *renderer)
+{
+  const auto *image = this->GetInput();
+  const auto *node = this->GetDataNode();
+
+  bool usePyramid = false;
+  node->GetBoolProperty("Image Rendering.Pyramid", usePyramid, renderer);
+
+  if (!usePyramid || nullptr == image || !image->IsInitialized())
+    return 0;
+
+  // the pyramid does not reduce the output of the reslicer if its extent is defined by the world geometry
+  bool inPlaneResampleExtentByGeometry = false;
+  node->GetBoolProperty("in plane resample extent by geometry", inPlaneResampleExtentByGeometry, renderer);
+
+  if (inPlaneResampleExtentByGeometry)
+    return 0;
+
+  // thick slices are computed from the full resolution
+  const auto *worldPlaneGeometryNode = renderer->GetCurrentWorldPlaneGeometryNode();
+  ResliceMethodProperty *resliceMethodEnumProperty = nullptr;
+
+  if (nullptr != worldPlaneGeometryNode &&
+      worldPlaneGeometryNode->GetProperty(resliceMethodEnumProperty, "reslice.thickslices", renderer) &&
+      nullptr != resliceMethodEnumProperty && 0 < resliceMethodEnumProperty->GetValueAsId())
+    return 0;
+
+  const auto mmPerPixel = renderer->GetScaleFactorMMPerDisplayUnit();
+
+  if (!std::isfinite(mmPerPixel) || mmPerPixel <= 0.0)
+    return 0;
+
+  bool binary = false;
+  node->GetBoolProperty("binary", binary, renderer);
+
+  m_ImagePyramid->SetImage(image);
+  m_ImagePyramid->SetAveraging(!binary);
+
+  return m_ImagePyramid->GetLevelForResolution(mmPerPixel);
+}
+
 void mitk::ImageVtkMapper2D::SetDefaultProperties(mitk::DataNode *node, mitk::BaseRenderer *renderer, bool overwrite)
 {
   mitk::Image::Pointer image = dynamic_cast<mitk::Image *>(node->GetData());
@@ -729,6 +832,7 @@ void mitk::ImageVtkMapper2D::SetDefaultProperties(mitk::DataNode *node, mitk::Ba
   node->AddProperty("depthOffset", mitk::FloatProperty::New(0.0), renderer, overwrite);
   node->AddProperty("outline binary", mitk::BoolProperty::New(false), renderer, overwrite);
   node->AddProperty("outline width", mitk::FloatProperty::New(1.0), renderer, overwrite);
+  node->AddProperty("Image Rendering.Pyramid", mitk::BoolProperty::New(false), renderer, overwrite);
   node->AddProperty("outline binary shadow", mitk::BoolProperty::New(false), renderer, overwrite);
   node->AddProperty("outline binary shadow color", ColorProperty::New(0.0, 0.0, 0.0), renderer, overwrite);
   node->AddProperty("outline shadow width", mitk::FloatProperty::New(1.5), renderer, overwrite);
@@ -53,6 +53,12 @@ found in the LICENSE file.
 #include <vtkTransform.h>
 #include <vtkWorldPointPicker.h>
 
+namespace
+{
+  const mitk::PropertyKey VisibleKey("visible");
+  const mitk::PropertyKey LayerKey("layer");
+}
+
 mitk::VtkPropRenderer::VtkPropRenderer(const char *name, vtkRenderWindow *renWin)
   : BaseRenderer(name, renWin),
     m_CameraInitializedForMapperID(0)
@@ -241,7 +247,7 @@ void mitk::VtkPropRenderer::PrepareMapperQueue()
       continue;
 
     bool visible = true;
-    node->GetVisibility(visible, this, "visible");
+    node->GetVisibility(visible, this, VisibleKey);
 
     // The information about LOD-enabled mappers is required by RenderingManager
     if (mapper->IsLODEnabled(this) && visible)
@@ -250,7 +256,7 @@ void mitk::VtkPropRenderer::PrepareMapperQueue()
     }
     // mapper without a layer property get layer number 1
     int layer = 1;
-    node->GetIntProperty("layer", layer, this);
+    node->GetIntProperty(LayerKey, layer, this);
     int nr = (layer << 16) + mapperNo;
     m_MappersMap.insert(std::pair<int, Mapper *>(nr, mapper));
     mapperNo++;
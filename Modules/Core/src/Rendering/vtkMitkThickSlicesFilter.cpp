@@ -20,8 +20,10 @@ found in the LICENSE file.
 #include "vtkPointData.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 
+#include <algorithm>
 #include <cmath>
 #include <sstream>
+#include <vector>
 
 vtkStandardNewMacro(vtkMitkThickSlicesFilter);
 
@@ -105,9 +107,46 @@ int vtkMitkThickSlicesFilter::RequestUpdateExtent(vtkInformation *,
 }
 
 //----------------------------------------------------------------------------
-// This execute method handles boundaries.
-// it handles boundaries. Pixels are just replicated to get values
-// out of extent.
+// The reductions below process whole rows: for every output row the
+// corresponding rows of all slices of the slab are combined into an
+// accumulator row. These rows are contiguous in memory (single component
+// input), so the inner loops over x can be vectorized by the compiler,
+// in contrast to a loop along z for every single pixel.
+namespace
+{
+  template <class T>
+  void MaximumOfRows(T *accumulator, const T *row, int length)
+  {
+    for (int x = 0; x < length; ++x)
+      accumulator[x] = row[x] > accumulator[x] ? row[x] : accumulator[x];
+  }
+
+  template <class T>
+  void MinimumOfRows(T *accumulator, const T *row, int length)
+  {
+    for (int x = 0; x < length; ++x)
+      accumulator[x] = row[x] < accumulator[x] ? row[x] : accumulator[x];
+  }
+
+  template <class TAccumulator, class T>
+  void AddRow(TAccumulator *accumulator, const T *row, int length)
+  {
+    for (int x = 0; x < length; ++x)
+      accumulator[x] += static_cast<TAccumulator>(row[x]);
+  }
+
+  template <class T>
+  void AddWeightedRow(double *accumulator, const T *row, double weight, int length)
+  {
+    for (int x = 0; x < length; ++x)
+      accumulator[x] += static_cast<double>(row[x]) * weight;
+  }
+}
+
+//----------------------------------------------------------------------------
+// Computes the projection of all slices of the input for the rows of outExt.
+// vtkThreadedImageAlgorithm splits the output extent along y, so every
+// thread processes its own block of rows.
 template <class T>
 void vtkMitkThickSlicesFilterExecute(vtkMitkThickSlicesFilter *self,
                                      vtkImageData *inData,
@@ -117,223 +156,109 @@ void vtkMitkThickSlicesFilterExecute(vtkMitkThickSlicesFilter *self,
                                      int outExt[6],
                                      int /*id*/)
 {
-  int idxX, idxY;
-  int maxX, maxY;
-  vtkIdType inIncX, inIncY, inIncZ;
-  vtkIdType outIncX, outIncY, outIncZ;
-  // int axesNum;
   int *inExt = inData->GetExtent();
-  int *wholeExtent;
-  vtkIdType *inIncs;
-  // int useYMin, useYMax, useXMin, useXMax;
+  vtkIdType *inIncs = inData->GetIncrements();
+  vtkIdType *outIncs = outData->GetIncrements();
 
-  // find the region to loop over
-  maxX = outExt[1] - outExt[0];
-  maxY = outExt[3] - outExt[2];
+  const int length = outExt[1] - outExt[0] + 1;
+  const int maxY = outExt[3] - outExt[2];
 
-  //  maxZ = outExt[5] - outExt[4];
-
-  // Get the dimensionality of the gradient.
-  // axesNum = self->GetDimensionality();
-
-  // Get increments to march through data
-  inData->GetContinuousIncrements(outExt, inIncX, inIncY, inIncZ);
-  outData->GetContinuousIncrements(outExt, outIncX, outIncY, outIncZ);
-  /*
-// The data spacing is important for computing the gradient.
-// central differences (2 * ratio).
-// Negative because below we have (min - max) for dx ...
-inData->GetSpacing(r);
-r[0] = -0.5 / r[0];
-r[1] = -0.5 / r[1];
-r[2] = -0.5 / r[2];
-    */
-  // get some other info we need
-  inIncs = inData->GetIncrements();
-  wholeExtent = inData->GetExtent();
+  if (length <= 0 || maxY < 0)
+    return;
 
   // Move the pointer to the correct starting position.
   inPtr += (outExt[0] - inExt[0]) * inIncs[0] + (outExt[2] - inExt[2]) * inIncs[1] + (outExt[4] - inExt[4]) * inIncs[2];
 
-  // Loop through output pixels
-
-  int _minZ = /*-5 + outExt[4];  if( _minZ  < wholeExtent[4]) _minZ=*/wholeExtent[4];
-  int _maxZ = /* 5 + outExt[4];  if( _maxZ  > wholeExtent[5]) _maxZ=*/wholeExtent[5];
+  const int minZ = inExt[4];
+  const int maxZ = inExt[5];
 
-  if (_maxZ < _minZ)
+  if (maxZ < minZ)
     return;
 
-  double invNum = 1.0 / (_maxZ - _minZ + 1);
+  const int mode = self->GetThickSliceMode();
 
-  switch (self->GetThickSliceMode())
+  // Weights of the WEIGHTED mode. The first slice of the slab is not
+  // weighted (kept for compatibility with earlier results).
+  const int size = maxZ - minZ;
+  std::vector<double> weights(size);
+  if (mode == vtkMitkThickSlicesFilter::WEIGHTED)
   {
-    default:
-    case vtkMitkThickSlicesFilter::MIP:
+    double mean = 0.5 * double(minZ + maxZ);
+    double sigma_sq = double(size) / 6.0;
+    sigma_sq *= sigma_sq;
+    double sum = 0;
+    int i = 0;
+    for (int z = minZ + 1; z <= maxZ; z++)
     {
-      // MIP
-      for (idxY = 0; idxY <= maxY; idxY++)
-      {
-        // useYMin = ((idxY + outExt[2]) <= wholeExtent[2]) ? 0 : -inIncs[1];
-        // useYMax = ((idxY + outExt[2]) >= wholeExtent[3]) ? 0 : inIncs[1];
-        for (idxX = 0; idxX <= maxX; idxX++)
-        {
-          // useXMin = ((idxX + outExt[0]) <= wholeExtent[0]) ? 0 : -inIncs[0];
-          // useXMax = ((idxX + outExt[0]) >= wholeExtent[1]) ? 0 : inIncs[0];
-
-          T mip = inPtr[_minZ * inIncs[2]];
-
-          for (int z = _minZ + 1; z <= _maxZ; z++)
-          {
-            T value = inPtr[z * inIncs[2]];
-            if (value > mip)
-              mip = value;
-          }
-
-          // do X axis
-          *outPtr = mip;
-          outPtr++;
-          inPtr++;
-        }
-        outPtr += outIncY;
-        inPtr += inIncY;
-      }
+      double val = exp(-(((double)z - mean) / sigma_sq));
+      weights[i++] = val;
+      sum += val;
     }
-    break;
-
-    case vtkMitkThickSlicesFilter::SUM:
+    for (i = 0; i < size; i++)
     {
-      // MIP
-      for (idxY = 0; idxY <= maxY; idxY++)
-      {
-        // useYMin = ((idxY + outExt[2]) <= wholeExtent[2]) ? 0 : -inIncs[1];
-        // useYMax = ((idxY + outExt[2]) >= wholeExtent[3]) ? 0 : inIncs[1];
-        for (idxX = 0; idxX <= maxX; idxX++)
-        {
-          // useXMin = ((idxX + outExt[0]) <= wholeExtent[0]) ? 0 : -inIncs[0];
-          // useXMax = ((idxX + outExt[0]) >= wholeExtent[1]) ? 0 : inIncs[0];
-
-          double sum = 0;
-
-          for (int z = _minZ; z <= _maxZ; z++)
-          {
-            T value = inPtr[z * inIncs[2]];
-            sum += value;
-          }
-
-          // do X axis
-          *outPtr = static_cast<T>(invNum * sum);
-          outPtr++;
-          inPtr++;
-        }
-        outPtr += outIncY;
-        inPtr += inIncY;
-      }
+      weights[i] /= sum;
     }
-    break;
+  }
+
+  const double invNum = 1.0 / (maxZ - minZ + 1);
 
-    case vtkMitkThickSlicesFilter::WEIGHTED:
+  std::vector<double> sumRow;
+  std::vector<long double> longSumRow;
+
+  for (int idxY = 0; idxY <= maxY; ++idxY)
+  {
+    const T *inRow = inPtr + idxY * inIncs[1];
+    T *outRow = outPtr + idxY * outIncs[1];
+
+    switch (mode)
     {
-      const int size = _maxZ - _minZ;
-      std::vector<double> weights(size);
-      double mean = 0.5 * double(_minZ + _maxZ);
-      double sigma_sq = double(size) / 6.0;
-      sigma_sq *= sigma_sq;
-      double sum = 0;
-      int i = 0;
-      for (int z = _minZ + 1; z <= _maxZ; z++)
+      default:
+      case vtkMitkThickSlicesFilter::MIP:
       {
-        double val = exp(-(((double)z - mean) / sigma_sq));
-        weights[i++] = val;
-        sum += val;
+        std::copy(inRow + minZ * inIncs[2], inRow + minZ * inIncs[2] + length, outRow);
+        for (int z = minZ + 1; z <= maxZ; ++z)
+          MaximumOfRows(outRow, inRow + z * inIncs[2], length);
       }
-      for (i = 0; i < size; i++)
+      break;
+
+      case vtkMitkThickSlicesFilter::MINIP:
       {
-        weights[i] /= sum;
+        std::copy(inRow + minZ * inIncs[2], inRow + minZ * inIncs[2] + length, outRow);
+        for (int z = minZ + 1; z <= maxZ; ++z)
+          MinimumOfRows(outRow, inRow + z * inIncs[2], length);
       }
+      break;
 
-      for (idxY = 0; idxY <= maxY; idxY++)
+      case vtkMitkThickSlicesFilter::SUM:
       {
-        // useYMin = ((idxY + outExt[2]) <= wholeExtent[2]) ? 0 : -inIncs[1];
-        // useYMax = ((idxY + outExt[2]) >= wholeExtent[3]) ? 0 : inIncs[1];
-        for (idxX = 0; idxX <= maxX; idxX++)
-        {
-          // useXMin = ((idxX + outExt[0]) <= wholeExtent[0]) ? 0 : -inIncs[0];
-          // useXMax = ((idxX + outExt[0]) >= wholeExtent[1]) ? 0 : inIncs[0];
-
-          T mip = inPtr[_minZ * inIncs[2]];
-          i = 0;
-          double mymip = 0;
-          for (int z = _minZ + 1; z <= _maxZ; z++)
-          {
-            double value = inPtr[z * inIncs[2]];
-            mymip += value * weights[i++];
-          }
-          mip = static_cast<T>(mymip);
-          // do X axis
-          *outPtr = mip;
-          outPtr++;
-          inPtr++;
-        }
-        outPtr += outIncY;
-        inPtr += inIncY;
+        sumRow.assign(length, 0.0);
+        for (int z = minZ; z <= maxZ; ++z)
+          AddRow(sumRow.data(), inRow + z * inIncs[2], length);
+        for (int x = 0; x < length; ++x)
+          outRow[x] = static_cast<T>(invNum * sumRow[x]);
       }
-    }
-    break;
+      break;
 
-    case vtkMitkThickSlicesFilter::MINIP:
-    {
-      for (idxY = 0; idxY <= maxY; idxY++)
+      case vtkMitkThickSlicesFilter::WEIGHTED:
       {
-        for (idxX = 0; idxX <= maxX; idxX++)
-        {
-          T mip = inPtr[_minZ * inIncs[2]];
-
-          for (int z = _minZ + 1; z <= _maxZ; z++)
-          {
-            T value = inPtr[z * inIncs[2]];
-            if (value < mip)
-              mip = value;
-          }
-
-          // do X axis
-          *outPtr = mip;
-          outPtr++;
-          inPtr++;
-        }
-        outPtr += outIncY;
-        inPtr += inIncY;
+        sumRow.assign(length, 0.0);
+        for (int z = minZ + 1; z <= maxZ; ++z)
+          AddWeightedRow(sumRow.data(), inRow + z * inIncs[2], weights[z - minZ - 1], length);
+        for (int x = 0; x < length; ++x)
+          outRow[x] = static_cast<T>(sumRow[x]);
       }
-    }
-    break;
-
-    case vtkMitkThickSlicesFilter::MEAN:
-    {
-      const int size = _maxZ - _minZ;
+      break;
 
-      // MEAN
-      for (idxY = 0; idxY <= maxY; idxY++)
+      case vtkMitkThickSlicesFilter::MEAN:
       {
-        for (idxX = 0; idxX <= maxX; idxX++)
-        {
-          long double sum = 0;
-          for (int z = _minZ; z <= _maxZ; z++)
-          {
-            T value = inPtr[z * inIncs[2]];
-            sum += value;
-          }
-
-          T mip = static_cast<T>(sum / size);
-
-          // do X axis
-          *outPtr = mip;
-          outPtr++;
-          inPtr++;
-        }
-        outPtr += outIncY;
-        inPtr += inIncY;
+        longSumRow.assign(length, 0.0L);
+        for (int z = minZ; z <= maxZ; ++z)
+          AddRow(longSumRow.data(), inRow + z * inIncs[2], length);
+        for (int x = 0; x < length; ++x)
+          outRow[x] = static_cast<T>(longSumRow[x] / size);
       }
+      break;
     }
-    break;
   }
 }
 
@@ -0,0 +1,141 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include <mitkExtractSliceFilter2.h>
+#include <mitkImageGenerator.h>
+#include <mitkImageReadAccessor.h>
+#include <mitkTestFixture.h>
+#include <mitkTestingMacros.h>
+
+#include <cmath>
+#include <limits>
+
+class mitkExtractSliceFilter2TestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkExtractSliceFilter2TestSuite);
+  MITK_TEST(FastResampling_NearestNeighbor_MatchesDefault);
+  MITK_TEST(FastResampling_Linear_MatchesDefault);
+  MITK_TEST(FastResampling_PlaneOutsideImage_Background);
+  CPPUNIT_TEST_SUITE_END();
+
+  mitk::Image::Pointer m_ShortImage;
+  mitk::Image::Pointer m_FloatImage;
+
+  static mitk::PlaneGeometry::Pointer CreateObliquePlane(unsigned int width, unsigned int height, mitk::ScalarType spacing, const mitk::Point3D& origin)
+  {
+    mitk::Vector3D right;
+    right[0] = 0.83; right[1] = 0.41; right[2] = 0.37;
+
+    mitk::Vector3D down;
+    down[0] = -0.29; down[1] = 0.87; down[2] = -0.31;
+
+    mitk::Vector3D planeSpacing;
+    planeSpacing.Fill(spacing);
+
+    auto plane = mitk::PlaneGeometry::New();
+    plane->InitializeStandardPlane(width, height, right, down, &planeSpacing);
+    plane->SetOrigin(origin);
+    plane->SetImageGeometry(true);
+
+    return plane;
+  }
+
+  static mitk::Image::Pointer Extract(mitk::Image* image, mitk::PlaneGeometry* plane, mitk::ExtractSliceFilter2::Interpolator interpolator, bool fastResampling)
+  {
+    auto filter = mitk::ExtractSliceFilter2::New();
+    filter->SetInput(image);
+    filter->SetOutputGeometry(plane);
+    filter->SetInterpolator(interpolator);
+    filter->SetFastResampling(fastResampling);
+    filter->Update();
+
+    return filter->GetOutput();
+  }
+
+  template <typename TPixel>
+  static void CompareSlices(mitk::Image* expected, mitk::Image* actual, double tolerance, double maxMismatchRatio)
+  {
+    mitk::ImageReadAccessor expectedAccessor(expected);
+    mitk::ImageReadAccessor actualAccessor(actual);
+
+    auto expectedData = static_cast<const TPixel*>(expectedAccessor.GetData());
+    auto actualData = static_cast<const TPixel*>(actualAccessor.GetData());
+
+    const std::size_t numberOfPixels = expected->GetDimension(0) * expected->GetDimension(1);
+    std::size_t mismatches = 0;
+
+    for (std::size_t i = 0; i < numberOfPixels; ++i)
+    {
+      if (std::abs(static_cast<double>(expectedData[i]) - static_cast<double>(actualData[i])) > tolerance)
+        ++mismatches;
+    }
+
+    // Pixels exactly on a rounding or image border may fall to either side
+    // due to the different order of floating-point operations.
+    CPPUNIT_ASSERT_MESSAGE("Fast resampling deviates from default resampling.",
+      mismatches <= static_cast<std::size_t>(maxMismatchRatio * numberOfPixels));
+  }
+
+public:
+  void setUp() override
+  {
+    m_ShortImage = mitk::ImageGenerator::GenerateRandomImage<short>(64, 48, 40, 1, 0.8, 0.9, 1.5, 1000.0, -1000.0);
+    m_FloatImage = mitk::ImageGenerator::GenerateRandomImage<float>(64, 48, 40, 1, 0.8, 0.9, 1.5, 1.0, 0.0);
+  }
+
+  void tearDown() override
+  {
+    m_ShortImage = nullptr;
+    m_FloatImage = nullptr;
+  }
+
+  void FastResampling_NearestNeighbor_MatchesDefault()
+  {
+    mitk::Point3D origin;
+    origin[0] = -3.7; origin[1] = 2.3; origin[2] = 9.1;
+    auto plane = CreateObliquePlane(96, 80, 0.7, origin);
+
+    auto expected = Extract(m_ShortImage, plane, mitk::ExtractSliceFilter2::NearestNeighbor, false);
+    auto actual = Extract(m_ShortImage, plane, mitk::ExtractSliceFilter2::NearestNeighbor, true);
+
+    CompareSlices<short>(expected, actual, 0.0, 0.001);
+  }
+
+  void FastResampling_Linear_MatchesDefault()
+  {
+    mitk::Point3D origin;
+    origin[0] = -3.7; origin[1] = 2.3; origin[2] = 9.1;
+    auto plane = CreateObliquePlane(96, 80, 0.7, origin);
+
+    auto expected = Extract(m_FloatImage, plane, mitk::ExtractSliceFilter2::Linear, false);
+    auto actual = Extract(m_FloatImage, plane, mitk::ExtractSliceFilter2::Linear, true);
+
+    CompareSlices<float>(expected, actual, 1e-4, 0.001);
+  }
+
+  void FastResampling_PlaneOutsideImage_Background()
+  {
+    mitk::Point3D origin;
+    origin[0] = 500.0; origin[1] = 500.0; origin[2] = 500.0;
+    auto plane = CreateObliquePlane(16, 16, 1.0, origin);
+
+    auto actual = Extract(m_ShortImage, plane, mitk::ExtractSliceFilter2::Linear, true);
+
+    mitk::ImageReadAccessor accessor(actual);
+    auto data = static_cast<const short*>(accessor.GetData());
+
+    for (std::size_t i = 0; i < 16 * 16; ++i)
+      CPPUNIT_ASSERT_EQUAL(std::numeric_limits<short>::lowest(), data[i]);
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkExtractSliceFilter2)
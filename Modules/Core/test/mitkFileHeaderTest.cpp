@@ -0,0 +1,189 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkTestingMacros.h"
+#include <mitkTestFixture.h>
+
+#include <mitkCoreServices.h>
+#include <mitkCustomMimeType.h>
+#include <mitkFileHeader.h>
+#include <mitkFileReaderSelector.h>
+#include <mitkIMimeTypeProvider.h>
+#include <mitkIOMimeTypes.h>
+#include <mitkIOUtil.h>
+#include <mitkImageGenerator.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+
+class mitkFileHeaderTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkFileHeaderTestSuite);
+  MITK_TEST(Read_SmallFile_IsComplete);
+  MITK_TEST(Read_LargeFile_IsTruncated);
+  MITK_TEST(Read_ModifiedFile_ReturnsNewContent);
+  MITK_TEST(Read_WithinScope_ReusesHeader);
+  MITK_TEST(Read_NoRegularFile_IsInvalid);
+  MITK_TEST(MatchesMagicBytes);
+  MITK_TEST(GetMimeTypesForFile_ChecksMagicBytes);
+  MITK_TEST(FileReaderSelector_FindsReader);
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+  std::string m_FilePath;
+
+  void WriteFile(const std::string &content)
+  {
+    std::ofstream stream(m_FilePath, std::ios::binary | std::ios::trunc);
+    stream << content;
+  }
+
+  bool ContainsMimeType(const std::vector<mitk::MimeType> &mimeTypes, const std::string &name)
+  {
+    return std::any_of(mimeTypes.begin(), mimeTypes.end(), [&name](const mitk::MimeType &mimeType) {
+      return mimeType.GetName() == name;
+    });
+  }
+
+public:
+  void setUp() override
+  {
+    std::ofstream stream;
+    m_FilePath = mitk::IOUtil::CreateTemporaryFile(stream, std::ios::binary, "header-XXXXXX.nrrd");
+  }
+
+  void tearDown() override
+  {
+    std::remove(m_FilePath.c_str());
+  }
+
+  void Read_SmallFile_IsComplete()
+  {
+    this->WriteFile("NRRD0004\n# Complete NRRD file format specification at:\n");
+
+    auto header = mitk::FileHeader::Read(m_FilePath);
+
+    CPPUNIT_ASSERT(header.IsValid());
+    CPPUNIT_ASSERT(header.IsComplete());
+    CPPUNIT_ASSERT_EQUAL(std::size_t(55), header.GetSize());
+    CPPUNIT_ASSERT(header.Matches("NRRD"));
+    CPPUNIT_ASSERT(header.Matches("0004", 4));
+    CPPUNIT_ASSERT(!header.Matches("NRRD", 1));
+    CPPUNIT_ASSERT(!header.Matches("at:\nNRRD", 52));
+    CPPUNIT_ASSERT(!header.Matches("NRRD", 1000));
+  }
+
+  void Read_LargeFile_IsTruncated()
+  {
+    this->WriteFile(std::string(2 * mitk::FileHeader::GetMaximumSize(), 'x'));
+
+    auto header = mitk::FileHeader::Read(m_FilePath);
+
+    CPPUNIT_ASSERT(header.IsValid());
+    CPPUNIT_ASSERT(!header.IsComplete());
+    CPPUNIT_ASSERT_EQUAL(mitk::FileHeader::GetMaximumSize(), header.GetSize());
+  }
+
+  void Read_ModifiedFile_ReturnsNewContent()
+  {
+    this->WriteFile("NRRD0004\n");
+    CPPUNIT_ASSERT(mitk::FileHeader::Read(m_FilePath).Matches("NRRD"));
+
+    // content of the same size, written within the same second
+    this->WriteFile("NOPE0004\n");
+    auto header = mitk::FileHeader::Read(m_FilePath);
+
+    CPPUNIT_ASSERT(!header.Matches("NRRD"));
+    CPPUNIT_ASSERT(header.Matches("NOPE"));
+  }
+
+  void Read_WithinScope_ReusesHeader()
+  {
+    this->WriteFile("NRRD0004\n");
+
+    {
+      mitk::FileHeader::Scope scope;
+      CPPUNIT_ASSERT(mitk::FileHeader::Read(m_FilePath).Matches("NRRD"));
+
+      this->WriteFile("NOPE0004\n");
+
+      {
+        mitk::FileHeader::Scope nestedScope;
+        CPPUNIT_ASSERT(mitk::FileHeader::Read(m_FilePath).Matches("NRRD"));
+      }
+
+      CPPUNIT_ASSERT(mitk::FileHeader::Read(m_FilePath).Matches("NRRD"));
+    }
+
+    // the headers are forgotten with the outermost scope
+    CPPUNIT_ASSERT(mitk::FileHeader::Read(m_FilePath).Matches("NOPE"));
+  }
+
+  void Read_NoRegularFile_IsInvalid()
+  {
+    CPPUNIT_ASSERT(!mitk::FileHeader().IsValid());
+    CPPUNIT_ASSERT(!mitk::FileHeader::Read("").IsValid());
+    CPPUNIT_ASSERT(!mitk::FileHeader::Read(m_FilePath + ".does-not-exist").IsValid());
+    CPPUNIT_ASSERT(!mitk::FileHeader::Read(mitk::IOUtil::GetTempPath()).IsValid());
+  }
+
+  void MatchesMagicBytes()
+  {
+    this->WriteFile("\x89PNG\r\n");
+    auto header = mitk::FileHeader::Read(m_FilePath);
+
+    mitk::CustomMimeType mimeType("application/vnd.mitk.test");
+    CPPUNIT_ASSERT(mimeType.MatchesMagicBytes(header));
+
+    mimeType.AddMagicBytes("GIF8");
+    CPPUNIT_ASSERT(!mimeType.MatchesMagicBytes(header));
+
+    mimeType.AddMagicBytes("PNG", 1);
+    CPPUNIT_ASSERT(mimeType.MatchesMagicBytes(header));
+    CPPUNIT_ASSERT_EQUAL(std::size_t(2), mimeType.GetMagicBytes().size());
+
+    // copies keep their magic bytes
+    mitk::MimeType registeredMimeType(mimeType, 0, 0);
+    CPPUNIT_ASSERT_EQUAL(std::size_t(2), registeredMimeType.GetMagicBytes().size());
+    CPPUNIT_ASSERT(mitk::CustomMimeType(registeredMimeType).MatchesMagicBytes(header));
+  }
+
+  void GetMimeTypesForFile_ChecksMagicBytes()
+  {
+    mitk::CoreServicePointer<mitk::IMimeTypeProvider> mimeTypeProvider(mitk::CoreServices::GetMimeTypeProvider());
+    const auto nrrd = mitk::IOMimeTypes::NRRD_MIMETYPE_NAME();
+
+    this->WriteFile("NRRD0004\n");
+    CPPUNIT_ASSERT(this->ContainsMimeType(mimeTypeProvider->GetMimeTypesForFile(m_FilePath), nrrd));
+
+    this->WriteFile("Not a NRRD file\n");
+    CPPUNIT_ASSERT(!this->ContainsMimeType(mimeTypeProvider->GetMimeTypesForFile(m_FilePath), nrrd));
+
+    // files that do not exist yet are matched by their name
+    CPPUNIT_ASSERT(this->ContainsMimeType(mimeTypeProvider->GetMimeTypesForFile(m_FilePath + ".nrrd"), nrrd));
+  }
+
+  void FileReaderSelector_FindsReader()
+  {
+    mitk::IOUtil::Save(mitk::ImageGenerator::GenerateGradientImage<float>(4, 4, 4, 1), m_FilePath);
+
+    mitk::FileReaderSelector selector(m_FilePath);
+
+    CPPUNIT_ASSERT(!selector.IsEmpty());
+    CPPUNIT_ASSERT(selector.GetDefault().GetReader() != nullptr);
+    CPPUNIT_ASSERT(selector.GetDefault().GetConfidenceLevel() != mitk::IFileReader::Unsupported);
+    CPPUNIT_ASSERT_EQUAL(selector.GetDefaultId(), selector.GetSelectedId());
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkFileHeader)
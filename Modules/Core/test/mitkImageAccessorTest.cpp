@@ -20,10 +20,14 @@ found in the LICENSE file.
 #include <fstream>
 #include <itksys/SystemTools.hxx>
 #include <mitkTestingMacros.h>
+#include <atomic>
+#include <chrono>
 #include <cstdlib>
 #include <ctime>
 #include <mutex>
 #include <random>
+#include <thread>
+#include <vector>
 
 struct ThreadData
 {
@@ -158,6 +162,38 @@ itk::ITK_THREAD_RETURN_TYPE ThreadMethod(ThreadData *threadData)
   return itk::ITK_THREAD_RETURN_DEFAULT_VALUE;
 }
 
+// Reads the whole image with shared access while other threads write single slices.
+itk::ITK_THREAD_RETURN_TYPE SharedReadThreadMethod(ThreadData *threadData, bool write)
+{
+  mitk::Image::Pointer im = threadData->Data;
+
+  try
+  {
+    if (write)
+    {
+      testMutex.lock();
+      mitk::ImageDataItem *iDi = im->GetSliceData(0);
+      testMutex.unlock();
+
+      mitk::ImageWriteAccessor writeAccessor(im, iDi);
+      *static_cast<char *>(writeAccessor.GetData()) = 1;
+    }
+    else
+    {
+      mitk::ImageReadAccessor readAccessor(im, nullptr, mitk::ImageAccessorBase::SharedReadAccess);
+      if (readAccessor.GetData() == nullptr)
+        threadData->Successful = false;
+    }
+  }
+  catch (const mitk::Exception &e)
+  {
+    threadData->Successful = false;
+    e.Print(std::cout);
+  }
+
+  return itk::ITK_THREAD_RETURN_DEFAULT_VALUE;
+}
+
 int mitkImageAccessorTest(int argc, char *argv[])
 {
   MITK_TEST_BEGIN("mitkImageAccessorTest");
@@ -205,6 +241,43 @@ int mitkImageAccessorTest(int argc, char *argv[])
     MITK_TEST_CONDITION_REQUIRED(false, "Ignoring the lock mechanism leads to exception.");
   }
 
+  // shared read access
+  MITK_TEST_OUTPUT(<< "Testing a write request of a thread with shared read access, should end in an exception ...");
+
+  MITK_TEST_FOR_EXCEPTION_BEGIN(mitk::Exception)
+  mitk::ImageReadAccessor first(image, nullptr, mitk::ImageAccessorBase::SharedReadAccess);
+  mitk::ImageWriteAccessor second(image);
+  MITK_TEST_FOR_EXCEPTION_END(mitk::Exception)
+
+  MITK_TEST_OUTPUT(<< "Testing a shared read request of a thread with write access, should end in an exception ...");
+
+  MITK_TEST_FOR_EXCEPTION_BEGIN(mitk::Exception)
+  mitk::ImageWriteAccessor first(image);
+  mitk::ImageReadAccessor second(image, nullptr, mitk::ImageAccessorBase::SharedReadAccess);
+  MITK_TEST_FOR_EXCEPTION_END(mitk::Exception)
+
+  try
+  {
+    mitk::ImageReadAccessor first(image, nullptr, mitk::ImageAccessorBase::SharedReadAccess);
+    mitk::ImageReadAccessor second(image, nullptr, mitk::ImageAccessorBase::SharedReadAccess);
+    mitk::ImageReadAccessor third(image);
+    MITK_TEST_CONDITION_REQUIRED(first.GetData() == third.GetData(), "Testing concurrent shared and default read access");
+  }
+  catch (const mitk::Exception & /*e*/)
+  {
+    MITK_TEST_CONDITION_REQUIRED(false, "Shared read access leads to exception.");
+  }
+
+  try
+  {
+    mitk::ImageWriteAccessor first(image, nullptr, mitk::ImageAccessorBase::ExceptionIfLocked);
+    MITK_TEST_CONDITION_REQUIRED(true, "Testing write access after the release of shared readers");
+  }
+  catch (const mitk::MemoryIsLockedException & /*e*/)
+  {
+    MITK_TEST_CONDITION_REQUIRED(false, "Released shared readers still lock the image.");
+  }
+
   // CREATE THREADS
 
   image->GetGeometry()->Initialize();
@@ -230,5 +303,47 @@ int mitkImageAccessorTest(int argc, char *argv[])
 
   MITK_TEST_CONDITION_REQUIRED(TestSuccessful, "Testing image access from multiple threads");
 
+  // shared readers and writers from multiple threads
+  ThreadData sharedThreadData;
+  sharedThreadData.Data = image;
+
+  std::array<std::thread, noOfThreads> sharedThreads;
+
+  for (size_t i = 0; i < noOfThreads; ++i)
+    sharedThreads[i] = std::thread(SharedReadThreadMethod, &sharedThreadData, i % 4 == 0);
+
+  for (size_t i = 0; i < noOfThreads; ++i)
+  {
+    if (sharedThreads[i].joinable())
+      sharedThreads[i].join();
+  }
+
+  MITK_TEST_CONDITION_REQUIRED(sharedThreadData.Successful, "Testing shared read and write access from multiple threads");
+
+  // nested shared read of a thread while a write accessor of another thread waits for it
+  {
+    std::atomic<bool> written(false);
+    std::thread writer;
+
+    {
+      mitk::ImageReadAccessor outer(image, nullptr, mitk::ImageAccessorBase::SharedReadAccess);
+
+      writer = std::thread([&image, &written]() {
+        mitk::ImageWriteAccessor writeAccessor(image);
+        written = true;
+      });
+
+      // give the write accessor time to queue up
+      std::this_thread::sleep_for(std::chrono::milliseconds(200));
+
+      mitk::ImageReadAccessor inner(image, nullptr, mitk::ImageAccessorBase::SharedReadAccess);
+      MITK_TEST_CONDITION_REQUIRED(outer.GetData() == inner.GetData() && !written,
+                                   "Testing nested shared read access while a write accessor is waiting");
+    }
+
+    writer.join();
+    MITK_TEST_CONDITION_REQUIRED(written, "Testing write access after the release of nested shared readers");
+  }
+
   MITK_TEST_END();
 }
@@ -0,0 +1,159 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+// Testing
+#include <mitkTestFixture.h>
+#include <mitkTestingMacros.h>
+
+// MITK includes
+#include <mitkExceptionMacro.h>
+#include <mitkImageGenerator.h>
+#include <mitkImagePixelReadAccessor.h>
+#include <mitkImagePyramid.h>
+
+class mitkImagePyramidTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkImagePyramidTestSuite);
+  MITK_TEST(SmallImage_SingleLevel);
+  MITK_TEST(AnisotropicImage_ShrinkFactors);
+  MITK_TEST(GetLevel_Geometry);
+  MITK_TEST(GetLevel_AveragedValues);
+  MITK_TEST(GetLevel_SubsampledValues);
+  MITK_TEST(GetLevel_RecomputedAfterModification);
+  MITK_TEST(GetLevelForResolution);
+  MITK_TEST(GetLevel_InvalidRequests_Throw);
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+  mitk::Image::Pointer m_Image;
+  mitk::ImagePyramid::Pointer m_Pyramid;
+
+public:
+  void setUp() override
+  {
+    // voxel values are their linear indices: x + 16 * y + 256 * z
+    m_Image = mitk::ImageGenerator::GenerateGradientImage<float>(16, 16, 4, 1.0f, 1.0f, 2.0f);
+
+    m_Pyramid = mitk::ImagePyramid::New();
+    m_Pyramid->SetMinimumSize(4);
+    m_Pyramid->SetImage(m_Image);
+  }
+
+  void tearDown() override
+  {
+    m_Pyramid = nullptr;
+    m_Image = nullptr;
+  }
+
+  void SmallImage_SingleLevel()
+  {
+    auto pyramid = mitk::ImagePyramid::New();
+    pyramid->SetImage(m_Image);
+
+    CPPUNIT_ASSERT_EQUAL(1u, pyramid->GetNumberOfLevels());
+    CPPUNIT_ASSERT(m_Image.GetPointer() == pyramid->GetLevel(0, 0));
+  }
+
+  void AnisotropicImage_ShrinkFactors()
+  {
+    CPPUNIT_ASSERT_EQUAL(3u, m_Pyramid->GetNumberOfLevels());
+
+    // the finer axes are shrunk first until the voxels are isotropic
+    auto factors = m_Pyramid->GetShrinkFactors(1);
+    CPPUNIT_ASSERT_EQUAL(2u, factors[0]);
+    CPPUNIT_ASSERT_EQUAL(2u, factors[1]);
+    CPPUNIT_ASSERT_EQUAL(1u, factors[2]);
+
+    factors = m_Pyramid->GetShrinkFactors(2);
+    CPPUNIT_ASSERT_EQUAL(4u, factors[0]);
+    CPPUNIT_ASSERT_EQUAL(4u, factors[1]);
+    CPPUNIT_ASSERT_EQUAL(2u, factors[2]);
+  }
+
+  void GetLevel_Geometry()
+  {
+    const auto *level = m_Pyramid->GetLevel(1, 0);
+
+    CPPUNIT_ASSERT(nullptr != level);
+    CPPUNIT_ASSERT_EQUAL(8u, level->GetDimension(0));
+    CPPUNIT_ASSERT_EQUAL(8u, level->GetDimension(1));
+    CPPUNIT_ASSERT_EQUAL(4u, level->GetDimension(2));
+
+    mitk::Vector3D expectedSpacing;
+    expectedSpacing.Fill(2.0);
+    CPPUNIT_ASSERT(mitk::Equal(expectedSpacing, level->GetGeometry()->GetSpacing()));
+
+    // averaged voxels are located at the centers of the shrunk blocks
+    mitk::Point3D expectedOrigin;
+    expectedOrigin[0] = 0.5;
+    expectedOrigin[1] = 0.5;
+    expectedOrigin[2] = 0.0;
+    CPPUNIT_ASSERT(mitk::Equal(expectedOrigin, level->GetGeometry()->GetOrigin()));
+  }
+
+  void GetLevel_AveragedValues()
+  {
+    mitk::ImagePixelReadAccessor<float, 3> accessor(m_Pyramid->GetLevel(1, 0));
+
+    itk::Index<3> index = {{0, 0, 0}};
+    CPPUNIT_ASSERT_DOUBLES_EQUAL((0.0 + 1.0 + 16.0 + 17.0) / 4.0, accessor.GetPixelByIndex(index), mitk::eps);
+
+    index = {{3, 2, 1}};
+    const double first = 6 + 16 * 4 + 256 * 1;
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(first + 0.5 + 8.0, accessor.GetPixelByIndex(index), mitk::eps);
+  }
+
+  void GetLevel_SubsampledValues()
+  {
+    m_Pyramid->AveragingOff();
+
+    const auto *level = m_Pyramid->GetLevel(1, 0);
+    CPPUNIT_ASSERT(mitk::Equal(m_Image->GetGeometry()->GetOrigin(), level->GetGeometry()->GetOrigin()));
+
+    mitk::ImagePixelReadAccessor<float, 3> accessor(level);
+
+    itk::Index<3> index = {{3, 2, 1}};
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(6 + 16 * 4 + 256 * 1, accessor.GetPixelByIndex(index), mitk::eps);
+  }
+
+  void GetLevel_RecomputedAfterModification()
+  {
+    const auto *level = m_Pyramid->GetLevel(1, 0);
+    CPPUNIT_ASSERT(level == m_Pyramid->GetLevel(1, 0));
+
+    m_Image->Modified();
+    CPPUNIT_ASSERT(level != m_Pyramid->GetLevel(1, 0));
+
+    level = m_Pyramid->GetLevel(1, 0);
+    m_Pyramid->ReleaseLevels();
+    CPPUNIT_ASSERT(level != m_Pyramid->GetLevel(1, 0));
+  }
+
+  void GetLevelForResolution()
+  {
+    CPPUNIT_ASSERT_EQUAL(0u, m_Pyramid->GetLevelForResolution(0.5));
+    CPPUNIT_ASSERT_EQUAL(0u, m_Pyramid->GetLevelForResolution(1.9));
+    CPPUNIT_ASSERT_EQUAL(1u, m_Pyramid->GetLevelForResolution(2.0));
+    CPPUNIT_ASSERT_EQUAL(1u, m_Pyramid->GetLevelForResolution(3.9));
+    CPPUNIT_ASSERT_EQUAL(2u, m_Pyramid->GetLevelForResolution(4.0));
+    CPPUNIT_ASSERT_EQUAL(2u, m_Pyramid->GetLevelForResolution(100.0));
+  }
+
+  void GetLevel_InvalidRequests_Throw()
+  {
+    CPPUNIT_ASSERT_THROW(m_Pyramid->GetShrinkFactors(3), mitk::Exception);
+    CPPUNIT_ASSERT_THROW(m_Pyramid->GetLevel(3, 0), mitk::Exception);
+    CPPUNIT_ASSERT_THROW(m_Pyramid->GetLevel(1, 1), mitk::Exception);
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkImagePyramid)
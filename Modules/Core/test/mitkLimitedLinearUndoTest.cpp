@@ -0,0 +1,180 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+// Testing
+#include "mitkTestFixture.h"
+#include "mitkTestingMacros.h"
+
+// MITK includes
+#include <mitkInteractionConst.h>
+#include <mitkLimitedLinearUndo.h>
+#include <mitkOperation.h>
+
+// ITK includes
+#include <itkCommand.h>
+
+namespace
+{
+  /** Operation that pretends to hold the given number of bytes.*/
+  class SizedTestOperation : public mitk::Operation
+  {
+  public:
+    SizedTestOperation(std::size_t size, int &counter) : Operation(mitk::OpTEST), m_Size(size), m_Counter(counter)
+    {
+      ++m_Counter;
+    }
+
+    ~SizedTestOperation() override { --m_Counter; }
+
+    std::size_t GetMemorySize() const override { return m_Size; }
+
+  private:
+    std::size_t m_Size;
+    int &m_Counter;
+  };
+}
+
+class mitkLimitedLinearUndoTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkLimitedLinearUndoTestSuite);
+  MITK_TEST(GetMemoryUsage_CountsUndoAndRedoItems);
+  MITK_TEST(SetOperationEvent_MemoryLimitReached_DropsOldestItems);
+  MITK_TEST(SetOperationEvent_ItemExceedsMemoryLimit_KeepsNewestItem);
+  MITK_TEST(SetMemoryLimit_DropsOldestItems);
+  MITK_TEST(SetUndoLimit_DropsAndFreesOldestItems);
+  MITK_TEST(MemoryUsageEvent_IsInvoked);
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+  static constexpr std::size_t ItemSize = 1000;
+
+  mitk::LimitedLinearUndo::Pointer m_Undo;
+  int m_NumberOfOperations;
+  unsigned int m_NumberOfMemoryUsageEvents;
+
+  void AddItem(std::size_t operationSize = ItemSize)
+  {
+    auto doOp = new SizedTestOperation(operationSize, m_NumberOfOperations);
+    auto undoOp = new SizedTestOperation(operationSize, m_NumberOfOperations);
+    m_Undo->SetOperationEvent(new mitk::OperationEvent(nullptr, doOp, undoOp, "Test"));
+    mitk::OperationEvent::IncCurrObjectEventId();
+  }
+
+  void OnMemoryUsageChanged() { ++m_NumberOfMemoryUsageEvents; }
+
+public:
+  void setUp() override
+  {
+    m_Undo = mitk::LimitedLinearUndo::New();
+    m_NumberOfOperations = 0;
+    m_NumberOfMemoryUsageEvents = 0;
+  }
+
+  void tearDown() override
+  {
+    m_Undo = nullptr;
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("All operations are freed.", 0, m_NumberOfOperations);
+  }
+
+  void GetMemoryUsage_CountsUndoAndRedoItems()
+  {
+    CPPUNIT_ASSERT_EQUAL(std::size_t(0), m_Undo->GetMemoryUsage());
+
+    this->AddItem();
+    const auto itemUsage = m_Undo->GetMemoryUsage();
+    CPPUNIT_ASSERT(itemUsage >= 2 * ItemSize);
+
+    this->AddItem();
+    CPPUNIT_ASSERT_EQUAL(2 * itemUsage, m_Undo->GetMemoryUsage());
+
+    m_Undo->Undo();
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Items on the redo stack are counted.", 2 * itemUsage, m_Undo->GetMemoryUsage());
+
+    m_Undo->ClearRedoList();
+    CPPUNIT_ASSERT_EQUAL(itemUsage, m_Undo->GetMemoryUsage());
+
+    m_Undo->Clear();
+    CPPUNIT_ASSERT_EQUAL(std::size_t(0), m_Undo->GetMemoryUsage());
+  }
+
+  void SetOperationEvent_MemoryLimitReached_DropsOldestItems()
+  {
+    this->AddItem();
+    const auto itemUsage = m_Undo->GetMemoryUsage();
+    m_Undo->Clear();
+
+    m_Undo->SetMemoryLimit(3 * itemUsage);
+
+    for (int i = 0; i < 10; ++i)
+      this->AddItem();
+
+    CPPUNIT_ASSERT_EQUAL(3 * itemUsage, m_Undo->GetMemoryUsage());
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Dropped items are freed.", 6, m_NumberOfOperations);
+  }
+
+  void SetOperationEvent_ItemExceedsMemoryLimit_KeepsNewestItem()
+  {
+    m_Undo->SetMemoryLimit(ItemSize);
+
+    this->AddItem();
+    this->AddItem(10 * ItemSize);
+
+    CPPUNIT_ASSERT_EQUAL(2, m_NumberOfOperations);
+    CPPUNIT_ASSERT(m_Undo->GetMemoryUsage() > m_Undo->GetMemoryLimit());
+    CPPUNIT_ASSERT(m_Undo->Undo() == false); // false: undo stack is empty afterwards
+    CPPUNIT_ASSERT(!m_Undo->RedoListEmpty());
+  }
+
+  void SetMemoryLimit_DropsOldestItems()
+  {
+    for (int i = 0; i < 4; ++i)
+      this->AddItem();
+
+    const auto itemUsage = m_Undo->GetMemoryUsage() / 4;
+
+    m_Undo->SetMemoryLimit(2 * itemUsage);
+
+    CPPUNIT_ASSERT_EQUAL(2 * itemUsage, m_Undo->GetMemoryUsage());
+    CPPUNIT_ASSERT_EQUAL(4, m_NumberOfOperations);
+  }
+
+  void SetUndoLimit_DropsAndFreesOldestItems()
+  {
+    for (int i = 0; i < 4; ++i)
+      this->AddItem();
+
+    m_Undo->SetUndoLimit(1);
+
+    CPPUNIT_ASSERT_EQUAL(2, m_NumberOfOperations);
+
+    this->AddItem();
+    CPPUNIT_ASSERT_EQUAL(2, m_NumberOfOperations);
+  }
+
+  void MemoryUsageEvent_IsInvoked()
+  {
+    auto command = itk::SimpleMemberCommand<mitkLimitedLinearUndoTestSuite>::New();
+    command->SetCallbackFunction(this, &mitkLimitedLinearUndoTestSuite::OnMemoryUsageChanged);
+    m_Undo->AddObserver(mitk::UndoMemoryUsageEvent(), command);
+
+    this->AddItem();
+    CPPUNIT_ASSERT_EQUAL(1u, m_NumberOfMemoryUsageEvents);
+
+    m_Undo->Undo();
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Moving items between the stacks does not change the usage.", 1u, m_NumberOfMemoryUsageEvents);
+
+    m_Undo->ClearRedoList();
+    CPPUNIT_ASSERT_EQUAL(2u, m_NumberOfMemoryUsageEvents);
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkLimitedLinearUndo)
@@ -20,6 +20,10 @@ found in the LICENSE file.
 #include <mitkStandardFileLocations.h>
 #include <thread>
 #include <mitkUtf8Util.h>
+#include <condition_variable>
+#include <mutex>
+#include <set>
+#include <vector>
 
 /** Documentation
  *
@@ -49,6 +53,68 @@ public:
 private:
   bool m_Called;
 };
+/** Documentation
+ *
+ * @brief This backend records the messages it processed and can be paused to test the asynchronous logging.
+ */
+class TestBackendRecorder : public mitk::LogBackendBase
+{
+public:
+  void ProcessMessage(const mitk::LogMessage& message) override
+  {
+    std::unique_lock<std::mutex> lock(m_Mutex);
+    m_Resumed.wait(lock, [this]() { return !m_Paused; });
+    m_Messages.push_back(message.Message);
+    m_ThreadIDs.insert(std::this_thread::get_id());
+  }
+
+  void Flush() override
+  {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    ++m_NumberOfFlushes;
+  }
+
+  OutputType GetOutputType() const override
+  {
+    return OutputType::Other;
+  }
+
+  void SetPaused(bool paused)
+  {
+    {
+      std::lock_guard<std::mutex> lock(m_Mutex);
+      m_Paused = paused;
+    }
+    m_Resumed.notify_all();
+  }
+
+  std::vector<std::string> GetMessages()
+  {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    return m_Messages;
+  }
+
+  std::set<std::thread::id> GetThreadIDs()
+  {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    return m_ThreadIDs;
+  }
+
+  unsigned int GetNumberOfFlushes()
+  {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    return m_NumberOfFlushes;
+  }
+
+private:
+  std::mutex m_Mutex;
+  std::condition_variable m_Resumed;
+  bool m_Paused = false;
+  std::vector<std::string> m_Messages;
+  std::set<std::thread::id> m_ThreadIDs;
+  unsigned int m_NumberOfFlushes = 0;
+};
+
 /** Documentation
   *
   * @brief Objects of this class can start an internal thread by calling the Start() method.
@@ -275,6 +341,88 @@ public:
     mitk::UnregisterBackend(&myCoutBackend);
     MITK_TEST_CONDITION_REQUIRED(success, "Test disable / enable logging backends.")
   }
+
+  static void TestAsynchronousLogging()
+  {
+    TestBackendRecorder recorder;
+    mitk::RegisterBackend(&recorder);
+    mitk::ResetLogCounters();
+
+    mitk::EnableAsynchronousLogging(64, mitk::LogOverflowPolicy::Block);
+    MITK_TEST_CONDITION_REQUIRED(mitk::IsAsynchronousLoggingEnabled(), "Test enabling asynchronous logging.");
+
+    const unsigned int numberOfThreads = 4;
+    const unsigned int numberOfMessages = 1000;
+    std::vector<std::thread> threads;
+
+    for (unsigned int threadIdx = 0; threadIdx < numberOfThreads; ++threadIdx)
+    {
+      threads.emplace_back([threadIdx, numberOfMessages]() {
+        for (unsigned int i = 0; i < numberOfMessages; ++i)
+          MITK_INFO << threadIdx << " " << i;
+      });
+    }
+
+    for (auto& thread : threads)
+      thread.join();
+
+    MITK_WARN << "last message";
+    mitk::FlushLog();
+
+    auto messages = recorder.GetMessages();
+    MITK_TEST_CONDITION_REQUIRED(messages.size() == numberOfThreads * numberOfMessages + 1,
+                                 "Test that no message is lost with blocking overflow policy.");
+    MITK_TEST_CONDITION_REQUIRED(messages.back() == "last message", "Test that messages are written in order.");
+    MITK_TEST_CONDITION_REQUIRED(recorder.GetThreadIDs().size() == 1 &&
+                                 recorder.GetThreadIDs().count(std::this_thread::get_id()) == 0,
+                                 "Test that messages are written by the writer thread.");
+    MITK_TEST_CONDITION_REQUIRED(recorder.GetNumberOfFlushes() < messages.size(), "Test batched flushes.");
+
+    bool inOrder = true;
+    for (unsigned int threadIdx = 0; threadIdx < numberOfThreads; ++threadIdx)
+    {
+      unsigned int expected = 0;
+      const std::string prefix = std::to_string(threadIdx) + " ";
+
+      for (const auto& message : messages)
+      {
+        if (0 == message.compare(0, prefix.size(), prefix))
+          inOrder &= message == prefix + std::to_string(expected++);
+      }
+    }
+    MITK_TEST_CONDITION_REQUIRED(inOrder, "Test that messages of each thread keep their order.");
+
+    MITK_TEST_CONDITION_REQUIRED(mitk::GetNumberOfLogMessages(mitk::LogLevel::Info) == numberOfThreads * numberOfMessages,
+                                 "Test info message counter.");
+    MITK_TEST_CONDITION_REQUIRED(mitk::GetNumberOfLogMessages(mitk::LogLevel::Warn) == 1, "Test warning message counter.");
+    MITK_TEST_CONDITION_REQUIRED(mitk::GetNumberOfDroppedLogMessages(mitk::LogLevel::Info) == 0,
+                                 "Test that no message was dropped.");
+
+    // a paused backend stalls the writer thread, so the queue runs full
+    mitk::EnableAsynchronousLogging(16, mitk::LogOverflowPolicy::Drop);
+    mitk::ResetLogCounters();
+    recorder.SetPaused(true);
+
+    for (unsigned int i = 0; i < 100; ++i)
+      MITK_ERROR << "dropped?";
+
+    recorder.SetPaused(false);
+    mitk::DisableAsynchronousLogging();
+    MITK_TEST_CONDITION_REQUIRED(!mitk::IsAsynchronousLoggingEnabled(), "Test disabling asynchronous logging.");
+
+    const auto numberOfDropped = mitk::GetNumberOfDroppedLogMessages(mitk::LogLevel::Error);
+    const auto numberOfWritten = recorder.GetMessages().size() - messages.size();
+    MITK_TEST_CONDITION_REQUIRED(numberOfDropped > 0, "Test that messages are dropped if the queue is full.");
+    MITK_TEST_CONDITION_REQUIRED(numberOfDropped + numberOfWritten == 100, "Test that dropped messages are counted.");
+
+    // synchronous logging is back
+    MITK_INFO << "synchronous";
+    MITK_TEST_CONDITION_REQUIRED(recorder.GetMessages().back() == "synchronous" &&
+                                 recorder.GetThreadIDs().count(std::this_thread::get_id()) == 1,
+                                 "Test synchronous logging after disabling asynchronous logging.");
+
+    mitk::UnregisterBackend(&recorder);
+  }
 };
 
 int mitkLogTest(int /* argc */, char * /*argv*/ [])
@@ -292,6 +440,7 @@ int mitkLogTest(int /* argc */, char * /*argv*/ [])
   mitkLogTestClass::TestThreadSaveLog(false); // false = to console
   mitkLogTestClass::TestThreadSaveLog(true);  // true = to file
   mitkLogTestClass::TestEnableDisableBackends();
+  mitkLogTestClass::TestAsynchronousLogging();
   // TODO actually test file somehow?
 
   // always end with this!
@@ -0,0 +1,255 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkPropertyKey.h"
+
+#include "mitkDataNode.h"
+#include "mitkPointSet.h"
+#include "mitkProperties.h"
+#include "mitkStringProperty.h"
+
+#include "mitkTestFixture.h"
+#include "mitkTestingMacros.h"
+
+#include <thread>
+#include <vector>
+
+class mitkPropertyKeyTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkPropertyKeyTestSuite);
+
+  MITK_TEST(Interning);
+  MITK_TEST(Interning_MultipleThreads);
+  MITK_TEST(PropertyList_KeysMTime);
+  MITK_TEST(DataNode_GetProperty);
+  MITK_TEST(DataNode_GetProperty_FollowsValueChanges);
+  MITK_TEST(DataNode_GetProperty_InvalidatedByPropertyListChanges);
+  MITK_TEST(DataNode_GetProperty_FallBackOnDataProperties);
+  MITK_TEST(DataNode_GetProperty_Typed);
+
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+  mitk::DataNode::Pointer m_Node;
+
+public:
+  void setUp() override
+  {
+    m_Node = mitk::DataNode::New();
+    m_Node->SetBoolProperty("test.bool", true);
+    m_Node->SetFloatProperty("test.float", 0.5f);
+    m_Node->SetColor(0.1f, 0.2f, 0.3f, nullptr, "test.color");
+  }
+
+  void tearDown() override
+  {
+    m_Node = nullptr;
+  }
+
+  void Interning()
+  {
+    const mitk::PropertyKey key("test.interning");
+    const mitk::PropertyKey sameKey(std::string("test.interning"));
+    const mitk::PropertyKey otherKey("test.interning.other");
+
+    CPPUNIT_ASSERT(key == sameKey);
+    CPPUNIT_ASSERT(key != otherKey);
+    CPPUNIT_ASSERT_EQUAL(key.GetId(), sameKey.GetId());
+    CPPUNIT_ASSERT(&key.GetName() == &sameKey.GetName());
+    CPPUNIT_ASSERT_EQUAL(std::string("test.interning"), key.GetName());
+    CPPUNIT_ASSERT(std::hash<mitk::PropertyKey>()(key) == std::hash<mitk::PropertyKey>()(sameKey));
+
+    const mitk::PropertyKey emptyKey;
+    CPPUNIT_ASSERT(emptyKey.IsEmpty());
+    CPPUNIT_ASSERT(emptyKey == mitk::PropertyKey(""));
+    CPPUNIT_ASSERT(emptyKey == mitk::PropertyKey(static_cast<const char *>(nullptr)));
+    CPPUNIT_ASSERT(!key.IsEmpty());
+  }
+
+  void Interning_MultipleThreads()
+  {
+    const unsigned int numberOfThreads = 4;
+    const unsigned int numberOfKeys = 100;
+
+    std::vector<std::vector<mitk::PropertyKey::IdType>> ids(numberOfThreads);
+    std::vector<std::thread> threads;
+
+    for (unsigned int t = 0; t < numberOfThreads; ++t)
+    {
+      threads.emplace_back([&ids, t, numberOfKeys]() {
+        for (unsigned int i = 0; i < numberOfKeys; ++i)
+          ids[t].push_back(mitk::PropertyKey("test.threads." + std::to_string(i)).GetId());
+      });
+    }
+
+    for (auto &thread : threads)
+      thread.join();
+
+    for (unsigned int t = 1; t < numberOfThreads; ++t)
+      CPPUNIT_ASSERT(ids[0] == ids[t]);
+  }
+
+  void PropertyList_KeysMTime()
+  {
+    auto propertyList = mitk::PropertyList::New();
+    auto keysMTime = propertyList->GetKeysMTime();
+
+    propertyList->SetBoolProperty("a", true);
+    CPPUNIT_ASSERT(keysMTime < propertyList->GetKeysMTime());
+    keysMTime = propertyList->GetKeysMTime();
+
+    // changing the value of an existing property does not change the keys
+    propertyList->SetBoolProperty("a", false);
+    propertyList->SetProperty("a", mitk::BoolProperty::New(true));
+    CPPUNIT_ASSERT_EQUAL(keysMTime, propertyList->GetKeysMTime());
+    CPPUNIT_ASSERT(keysMTime < propertyList->GetMTime());
+
+    propertyList->ReplaceProperty("a", mitk::IntProperty::New(1));
+    CPPUNIT_ASSERT(keysMTime < propertyList->GetKeysMTime());
+    keysMTime = propertyList->GetKeysMTime();
+
+    propertyList->DeleteProperty("a");
+    CPPUNIT_ASSERT(keysMTime < propertyList->GetKeysMTime());
+    keysMTime = propertyList->GetKeysMTime();
+
+    propertyList->SetBoolProperty("b", true);
+    keysMTime = propertyList->GetKeysMTime();
+    propertyList->Clear();
+    CPPUNIT_ASSERT(keysMTime < propertyList->GetKeysMTime());
+
+    CPPUNIT_ASSERT(nullptr == propertyList->GetProperty(mitk::PropertyKey("b")));
+    propertyList->SetBoolProperty("b", true);
+    CPPUNIT_ASSERT(propertyList->GetProperty("b") == propertyList->GetProperty(mitk::PropertyKey("b")));
+  }
+
+  void DataNode_GetProperty()
+  {
+    const mitk::PropertyKey boolKey("test.bool");
+    const mitk::PropertyKey missingKey("test.missing");
+
+    CPPUNIT_ASSERT(m_Node->GetProperty("test.bool") == m_Node->GetProperty(boolKey));
+    CPPUNIT_ASSERT(m_Node->GetProperty(boolKey) == m_Node->GetProperty(boolKey));
+    CPPUNIT_ASSERT(nullptr == m_Node->GetProperty(missingKey));
+    CPPUNIT_ASSERT(nullptr == m_Node->GetProperty(mitk::PropertyKey()));
+
+    bool boolValue = false;
+    CPPUNIT_ASSERT(m_Node->GetBoolProperty(boolKey, boolValue));
+    CPPUNIT_ASSERT(boolValue);
+
+    float floatValue = 0.0f;
+    CPPUNIT_ASSERT(m_Node->GetFloatProperty(mitk::PropertyKey("test.float"), floatValue));
+    CPPUNIT_ASSERT_EQUAL(0.5f, floatValue);
+    CPPUNIT_ASSERT(m_Node->GetOpacity(floatValue, nullptr, mitk::PropertyKey("test.float")));
+
+    float rgb[3] = {0.0f, 0.0f, 0.0f};
+    CPPUNIT_ASSERT(m_Node->GetColor(rgb, nullptr, mitk::PropertyKey("test.color")));
+    CPPUNIT_ASSERT_EQUAL(0.2f, rgb[1]);
+
+    // type mismatches
+    int intValue = 0;
+    CPPUNIT_ASSERT(!m_Node->GetIntProperty(boolKey, intValue));
+    CPPUNIT_ASSERT(!m_Node->GetColor(rgb, nullptr, boolKey));
+
+    CPPUNIT_ASSERT(m_Node->IsVisible(nullptr, missingKey, true));
+    CPPUNIT_ASSERT(!m_Node->IsVisible(nullptr, missingKey, false));
+    CPPUNIT_ASSERT(m_Node->IsVisible(nullptr, boolKey, false));
+  }
+
+  void DataNode_GetProperty_FollowsValueChanges()
+  {
+    const mitk::PropertyKey boolKey("test.bool");
+
+    bool boolValue = false;
+    m_Node->GetBoolProperty(boolKey, boolValue);
+    CPPUNIT_ASSERT(boolValue);
+
+    m_Node->SetBoolProperty("test.bool", false);
+    CPPUNIT_ASSERT(m_Node->GetBoolProperty(boolKey, boolValue));
+    CPPUNIT_ASSERT(!boolValue);
+  }
+
+  void DataNode_GetProperty_InvalidatedByPropertyListChanges()
+  {
+    const mitk::PropertyKey key("test.changing");
+
+    CPPUNIT_ASSERT(nullptr == m_Node->GetProperty(key));
+
+    m_Node->SetIntProperty("test.changing", 1);
+    int intValue = 0;
+    CPPUNIT_ASSERT(m_Node->GetIntProperty(key, intValue));
+    CPPUNIT_ASSERT_EQUAL(1, intValue);
+
+    m_Node->ReplaceProperty("test.changing", mitk::IntProperty::New(2));
+    CPPUNIT_ASSERT(m_Node->GetIntProperty(key, intValue));
+    CPPUNIT_ASSERT_EQUAL(2, intValue);
+
+    m_Node->ReplaceProperty("test.changing", mitk::BoolProperty::New(true));
+    CPPUNIT_ASSERT(!m_Node->GetIntProperty(key, intValue));
+
+    bool boolValue = false;
+    CPPUNIT_ASSERT(m_Node->GetBoolProperty(key, boolValue));
+    CPPUNIT_ASSERT(boolValue);
+
+    m_Node->GetPropertyList()->DeleteProperty("test.changing");
+    CPPUNIT_ASSERT(nullptr == m_Node->GetProperty(key));
+  }
+
+  void DataNode_GetProperty_FallBackOnDataProperties()
+  {
+    const mitk::PropertyKey key("test.data");
+
+    auto data = mitk::PointSet::New();
+    data->SetProperty("test.data", mitk::StringProperty::New("data"));
+
+    CPPUNIT_ASSERT(nullptr == m_Node->GetProperty(key));
+
+    m_Node->SetData(data);
+    CPPUNIT_ASSERT(data->GetProperty("test.data") == m_Node->GetProperty(key));
+    CPPUNIT_ASSERT(nullptr == m_Node->GetProperty(key, nullptr, false));
+
+    // properties of the node take precedence
+    m_Node->SetStringProperty("test.data", "node");
+    CPPUNIT_ASSERT(m_Node->GetPropertyList()->GetProperty("test.data") == m_Node->GetProperty(key));
+    m_Node->GetPropertyList()->DeleteProperty("test.data");
+    CPPUNIT_ASSERT(data->GetProperty("test.data") == m_Node->GetProperty(key));
+
+    data->GetPropertyList()->DeleteProperty("test.data");
+    CPPUNIT_ASSERT(nullptr == m_Node->GetProperty(key));
+
+    auto otherData = mitk::PointSet::New();
+    otherData->SetProperty("test.data", mitk::StringProperty::New("other data"));
+    m_Node->SetData(otherData);
+    CPPUNIT_ASSERT(otherData->GetProperty("test.data") == m_Node->GetProperty(key));
+  }
+
+  void DataNode_GetProperty_Typed()
+  {
+    const mitk::PropertyKey floatKey("test.float");
+
+    mitk::FloatProperty *floatProperty = nullptr;
+    CPPUNIT_ASSERT(m_Node->GetProperty(floatProperty, floatKey));
+    CPPUNIT_ASSERT(m_Node->GetProperty("test.float") == floatProperty);
+
+    mitk::BoolProperty *boolProperty = nullptr;
+    CPPUNIT_ASSERT(!m_Node->GetProperty(boolProperty, floatKey));
+    CPPUNIT_ASSERT(nullptr == boolProperty);
+
+    mitk::BaseProperty *baseProperty = nullptr;
+    CPPUNIT_ASSERT(m_Node->GetProperty(baseProperty, floatKey));
+    CPPUNIT_ASSERT(floatProperty == baseProperty);
+
+    CPPUNIT_ASSERT(m_Node->GetProperty(floatProperty, floatKey));
+    CPPUNIT_ASSERT(baseProperty == floatProperty);
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkPropertyKey)
@@ -20,6 +20,12 @@ found in the LICENSE file.
 #include <vtkDataArray.h>
 #include <vtkImageData.h>
 #include <vtkPointData.h>
+#include <vtkSmartPointer.h>
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
 
 class vtkMitkThickSlicesFilterTestHelper
 {
@@ -56,6 +62,107 @@ public:
     MITK_INFO << "actual value: " << static_cast<double>(value[0]);
     MITK_TEST_CONDITION_REQUIRED(value[0] == expectedValue, "Resulting image has correct pixel-value");
   }
+
+  template <class T>
+  static vtkSmartPointer<vtkImageData> CreateRandomImage(int scalarType, int dimX, int dimY, int dimZ)
+  {
+    auto image = vtkSmartPointer<vtkImageData>::New();
+    image->SetDimensions(dimX, dimY, dimZ);
+    image->AllocateScalars(scalarType, 1);
+
+    std::mt19937 generator(42);
+    std::uniform_real_distribution<double> distribution(0.0, 200.0);
+
+    auto *data = static_cast<T *>(image->GetScalarPointer());
+    const auto numberOfPoints = image->GetNumberOfPoints();
+    for (vtkIdType i = 0; i < numberOfPoints; ++i)
+      data[i] = static_cast<T>(distribution(generator));
+
+    return image;
+  }
+
+  /** Projection of a single pixel along z as computed by the filter, used as reference.*/
+  template <class T>
+  static T ComputeReferenceValue(vtkImageData *image, int x, int y, int mode)
+  {
+    const int maxZ = image->GetDimensions()[2] - 1;
+    const int size = maxZ;
+    auto value = [image, x, y](int z) { return *static_cast<T *>(image->GetScalarPointer(x, y, z)); };
+
+    switch (mode)
+    {
+      case vtkMitkThickSlicesFilter::MIP:
+      case vtkMitkThickSlicesFilter::MINIP:
+      {
+        T result = value(0);
+        for (int z = 1; z <= maxZ; ++z)
+          result = mode == vtkMitkThickSlicesFilter::MIP ? std::max(result, value(z)) : std::min(result, value(z));
+        return result;
+      }
+      case vtkMitkThickSlicesFilter::SUM:
+      {
+        double sum = 0;
+        for (int z = 0; z <= maxZ; ++z)
+          sum += value(z);
+        return static_cast<T>(sum / (maxZ + 1));
+      }
+      case vtkMitkThickSlicesFilter::WEIGHTED:
+      {
+        std::vector<double> weights;
+        const double mean = 0.5 * maxZ;
+        double sigma_sq = double(size) / 6.0;
+        sigma_sq *= sigma_sq;
+        double sum = 0;
+        for (int z = 1; z <= maxZ; ++z)
+        {
+          weights.push_back(std::exp(-((z - mean) / sigma_sq)));
+          sum += weights.back();
+        }
+        double result = 0;
+        for (int z = 1; z <= maxZ; ++z)
+          result += static_cast<double>(value(z)) * (weights[z - 1] / sum);
+        return static_cast<T>(result);
+      }
+      default:
+      {
+        long double sum = 0;
+        for (int z = 0; z <= maxZ; ++z)
+          sum += value(z);
+        return static_cast<T>(sum / size);
+      }
+    }
+  }
+
+  template <class T>
+  static void TestAgainstReference(int scalarType, const char *typeName)
+  {
+    auto image = CreateRandomImage<T>(scalarType, 67, 45, 7);
+
+    auto filter = vtkSmartPointer<vtkMitkThickSlicesFilter>::New();
+    filter->SetInputData(image);
+
+    for (int mode = vtkMitkThickSlicesFilter::MIP; mode <= vtkMitkThickSlicesFilter::MEAN; ++mode)
+    {
+      filter->SetThickSliceMode(mode);
+      filter->Modified();
+      filter->Update();
+
+      vtkImageData *output = filter->GetOutput();
+      bool equal = output->GetScalarType() == scalarType;
+
+      for (int y = 0; equal && y < 45; ++y)
+      {
+        for (int x = 0; equal && x < 67; ++x)
+        {
+          const T expected = ComputeReferenceValue<T>(image, x, y, mode);
+          const T actual = *static_cast<T *>(output->GetScalarPointer(x, y, 0));
+          equal = std::abs(static_cast<double>(expected) - static_cast<double>(actual)) <= 1e-4 * std::abs(static_cast<double>(expected));
+        }
+      }
+
+      MITK_TEST_CONDITION(equal, "Projection mode " << mode << " of " << typeName << " image matches the per pixel reference");
+    }
+  }
 };
 
 /**
@@ -151,5 +258,13 @@ int vtkMitkThickSlicesFilterTest(int, char *[])
 
   thickSliceFilter->Delete();
 
+  //////////////////////////////////////////////////////////////////////////
+  // Random images of different pixel types, compared pixel by pixel with a
+  // reduction along z. The extent is not a multiple of the thread pieces.
+  vtkMitkThickSlicesFilterTestHelper::TestAgainstReference<unsigned char>(VTK_UNSIGNED_CHAR, "unsigned char");
+  vtkMitkThickSlicesFilterTestHelper::TestAgainstReference<short>(VTK_SHORT, "short");
+  vtkMitkThickSlicesFilterTestHelper::TestAgainstReference<float>(VTK_FLOAT, "float");
+  vtkMitkThickSlicesFilterTestHelper::TestAgainstReference<double>(VTK_DOUBLE, "double");
+
   MITK_TEST_END()
 }
@@ -81,7 +81,7 @@ LDAPFilter::operator bool_type() const
 
 bool LDAPFilter::Match(const ServiceReferenceBase& reference) const
 {
-  return d->ldapExpr.Evaluate(reference.d->GetProperties(), true);
+  return d->ldapExpr.Evaluate(*reference.d->GetProperties(), true);
 }
 
 bool LDAPFilter::Match(const ServiceProperties& dictionary) const
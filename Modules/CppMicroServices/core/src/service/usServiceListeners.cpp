@@ -194,8 +194,7 @@ void ServiceListeners::ServiceChanged(ServiceListenerEntries& receivers,
   }
 }
 
-void ServiceListeners::GetMatchingServiceListeners(const ServiceEvent& evt, ServiceListenerEntries& set,
-                                                   bool lockProps)
+void ServiceListeners::GetMatchingServiceListeners(const ServiceEvent& evt, ServiceListenerEntries& set)
 {
   US_UNUSED(Lock(this));
 
@@ -210,7 +209,7 @@ void ServiceListeners::GetMatchingServiceListeners(const ServiceEvent& evt, Serv
     if (receivers.count(*sse) == 0) continue;
     const LDAPExpr& ldapExpr = sse->GetLDAPExpr();
     if (ldapExpr.IsNull() ||
-        ldapExpr.Evaluate(evt.GetServiceReference().d->GetProperties(), false))
+        ldapExpr.Evaluate(*evt.GetServiceReference().d->GetProperties(), false))
     {
       set.insert(*sse);
     }
@@ -221,14 +220,14 @@ void ServiceListeners::GetMatchingServiceListeners(const ServiceEvent& evt, Serv
 
   // Check the cache
   const std::vector<std::string> c(any_cast<std::vector<std::string> >
-                                 (evt.GetServiceReference().d->GetProperty(ServiceConstants::OBJECTCLASS(), lockProps)));
+                                 (evt.GetServiceReference().d->GetProperty(ServiceConstants::OBJECTCLASS())));
   for (std::vector<std::string>::const_iterator objClass = c.begin();
        objClass != c.end(); ++objClass)
   {
     AddToSet(set, receivers, OBJECTCLASS_IX, *objClass);
   }
 
-  long service_id = any_cast<long>(evt.GetServiceReference().d->GetProperty(ServiceConstants::SERVICE_ID(), lockProps));
+  long service_id = any_cast<long>(evt.GetServiceReference().d->GetProperty(ServiceConstants::SERVICE_ID()));
   std::stringstream ss;
   ss << service_id;
   AddToSet(set, receivers, SERVICE_ID_IX, ss.str());
@@ -150,8 +150,7 @@ public:
    *
    *
    */
-  void GetMatchingServiceListeners(const ServiceEvent& evt, ServiceListenerEntries& listeners,
-                                   bool lockProps = true);
+  void GetMatchingServiceListeners(const ServiceEvent& evt, ServiceListenerEntries& listeners);
 
 
   std::vector<ServiceListenerHook::ListenerInfo> GetListenerInfoCollection() const;
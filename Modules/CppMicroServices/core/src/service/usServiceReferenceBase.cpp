@@ -82,16 +82,13 @@ ServiceReferenceBase::~ServiceReferenceBase()
 
 Any ServiceReferenceBase::GetProperty(const std::string& key) const
 {
-  MutexLock lock(d->registration->propsLock);
-
-  return d->registration->properties.Value(key);
+  return d->registration->GetProperties()->Value(key);
 }
 
 void ServiceReferenceBase::GetPropertyKeys(std::vector<std::string>& keys) const
 {
-  MutexLock lock(d->registration->propsLock);
-
-  const std::vector<std::string>& ks = d->registration->properties.Keys();
+  const ServiceRegistrationBasePrivate::PropertiesPointer properties = d->registration->GetProperties();
+  const std::vector<std::string>& ks = properties->Keys();
   keys.assign(ks.begin(), ks.end());
 }
 
@@ -67,8 +67,9 @@ InterfaceMap ServiceReferenceBasePrivate::GetServiceFromFactory(Module* module,
       US_WARN << "ServiceFactory produced null";
       return smap;
     }
+    const ServiceRegistrationBasePrivate::PropertiesPointer properties = registration->GetProperties();
     const std::vector<std::string>& classes =
-        ref_any_cast<std::vector<std::string> >(registration->properties.Value(ServiceConstants::OBJECTCLASS()));
+        ref_any_cast<std::vector<std::string> >(properties->Value(ServiceConstants::OBJECTCLASS()));
     for (std::vector<std::string>::const_iterator i = classes.begin();
          i != classes.end(); ++i)
     {
@@ -294,22 +295,14 @@ bool ServiceReferenceBasePrivate::UngetService(Module* module, bool checkRefCoun
   return hadReferences && removeService;
 }
 
-const ServicePropertiesImpl& ServiceReferenceBasePrivate::GetProperties() const
+std::shared_ptr<const ServicePropertiesImpl> ServiceReferenceBasePrivate::GetProperties() const
 {
-  return registration->properties;
+  return registration->GetProperties();
 }
 
-Any ServiceReferenceBasePrivate::GetProperty(const std::string& key, bool lock) const
+Any ServiceReferenceBasePrivate::GetProperty(const std::string& key) const
 {
-  if (lock)
-  {
-    MutexLock lock(registration->propsLock);
-    return registration->properties.Value(key);
-  }
-  else
-  {
-    return registration->properties.Value(key);
-  }
+  return registration->GetProperties()->Value(key);
 }
 
 bool ServiceReferenceBasePrivate::IsConvertibleTo(const std::string& interfaceId) const
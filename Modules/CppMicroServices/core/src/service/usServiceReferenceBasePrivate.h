@@ -27,6 +27,7 @@
 
 #include "usServiceInterface.h"
 
+#include <memory>
 #include <string>
 
 US_BEGIN_NAMESPACE
@@ -94,9 +95,10 @@ public:
    * Get all properties registered with this service.
    *
    * @return A ServiceProperties object containing properties or being empty
-   *         if service has been removed.
+   *         if service has been removed. The object is not modified by later
+   *         changes of the properties.
    */
-  const ServicePropertiesImpl& GetProperties() const;
+  std::shared_ptr<const ServicePropertiesImpl> GetProperties() const;
 
   /**
    * Returns the property value to which the specified property key is mapped
@@ -112,13 +114,10 @@ public:
    * still be interrogated.
    *
    * @param key The property key.
-   * @param lock If <code>true</code>, access of the properties of the service
-   * referenced by this <code>ServiceReference</code> object will be
-   * synchronized.
    * @return The property value to which the key is mapped; an invalid Any
    * if there is no property named after the key.
    */
-  Any GetProperty(const std::string& key, bool lock) const;
+  Any GetProperty(const std::string& key) const;
 
   bool IsConvertibleTo(const std::string& interfaceId) const;
 
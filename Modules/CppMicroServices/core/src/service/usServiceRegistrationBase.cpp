@@ -111,20 +111,22 @@ void ServiceRegistrationBase::SetProperties(const ServiceProperties& props)
 
       std::vector<std::string> classes;
       {
+        // serializes concurrent modifications; readers use the properties they retrieved before
         MutexLock lock3(d->propsLock);
 
+        const ServiceRegistrationBasePrivate::PropertiesPointer oldProperties = d->GetProperties();
         {
-          const Any& any = d->properties.Value(ServiceConstants::SERVICE_RANKING());
+          const Any& any = oldProperties->Value(ServiceConstants::SERVICE_RANKING());
           if (any.Type() == typeid(int)) old_rank = any_cast<int>(any);
         }
 
-        d->module->coreCtx->listeners.GetMatchingServiceListeners(modifiedEndMatchEvent, before, false);
-        classes = ref_any_cast<std::vector<std::string> >(d->properties.Value(ServiceConstants::OBJECTCLASS()));
-        long int sid = any_cast<long int>(d->properties.Value(ServiceConstants::SERVICE_ID()));
-        d->properties = ServiceRegistry::CreateServiceProperties(props, classes, false, false, sid);
+        d->module->coreCtx->listeners.GetMatchingServiceListeners(modifiedEndMatchEvent, before);
+        classes = ref_any_cast<std::vector<std::string> >(oldProperties->Value(ServiceConstants::OBJECTCLASS()));
+        long int sid = any_cast<long int>(oldProperties->Value(ServiceConstants::SERVICE_ID()));
+        d->SetProperties(ServiceRegistry::CreateServiceProperties(props, classes, false, false, sid));
 
         {
-          const Any& any = d->properties.Value(ServiceConstants::SERVICE_RANKING());
+          const Any& any = d->GetProperties()->Value(ServiceConstants::SERVICE_RANKING());
           if (any.Type() == typeid(int)) new_rank = any_cast<int>(any);
         }
       }
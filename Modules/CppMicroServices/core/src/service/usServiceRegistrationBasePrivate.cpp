@@ -32,7 +32,7 @@ ServiceRegistrationBasePrivate::ServiceRegistrationBasePrivate(
   ModulePrivate* module, const InterfaceMap& service,
   const ServicePropertiesImpl& props)
   : ref(0), service(service), module(module), reference(this),
-    properties(props), available(true), unregistering(false)
+    available(true), unregistering(false), properties(std::make_shared<const ServicePropertiesImpl>(props))
 {
   // The reference counter is initialized to 0 because it will be
   // incremented by the "reference" member.
@@ -49,6 +49,16 @@ bool ServiceRegistrationBasePrivate::IsUsedByModule(Module* p) const
       (prototypeServiceInstances.find(p) != prototypeServiceInstances.end());
 }
 
+ServiceRegistrationBasePrivate::PropertiesPointer ServiceRegistrationBasePrivate::GetProperties() const
+{
+  return std::atomic_load(&properties);
+}
+
+void ServiceRegistrationBasePrivate::SetProperties(const ServicePropertiesImpl& props)
+{
+  std::atomic_store(&properties, PropertiesPointer(std::make_shared<const ServicePropertiesImpl>(props)));
+}
+
 const InterfaceMap& ServiceRegistrationBasePrivate::GetInterfaces() const
 {
   return service;
@@ -28,6 +28,8 @@
 #include "usServicePropertiesImpl_p.h"
 #include "usAtomicInt_p.h"
 
+#include <memory>
+
 US_BEGIN_NAMESPACE
 
 class ModulePrivate;
@@ -65,6 +67,7 @@ public:
   typedef US_UNORDERED_MAP_TYPE<Module*,int> ModuleToRefsMap;
   typedef US_UNORDERED_MAP_TYPE<Module*, InterfaceMap> ModuleToServiceMap;
   typedef US_UNORDERED_MAP_TYPE<Module*, std::list<InterfaceMap> > ModuleToServicesMap;
+  typedef std::shared_ptr<const ServicePropertiesImpl> PropertiesPointer;
 
   /**
    * Modules dependent on this service. Integer is used as
@@ -92,10 +95,6 @@ public:
    */
   ServiceReferenceBase reference;
 
-  /**
-   * Service properties.
-   */
-  ServicePropertiesImpl properties;
 
   /**
    * Is service available. I.e., if <code>true</code> then holders
@@ -131,12 +130,29 @@ public:
    */
   bool IsUsedByModule(Module* m) const;
 
+  /**
+   * Returns the current service properties. The returned object is never
+   * modified, so it can be read without holding propsLock.
+   */
+  PropertiesPointer GetProperties() const;
+
+  /**
+   * Atomically replaces the service properties. Concurrent readers keep
+   * the properties they already retrieved.
+   */
+  void SetProperties(const ServicePropertiesImpl& props);
+
   const InterfaceMap& GetInterfaces() const;
 
   void* GetService(const std::string& interfaceId) const;
 
 private:
 
+  /**
+   * Service properties. Only accessed via std::atomic_load and std::atomic_store.
+   */
+  PropertiesPointer properties;
+
   // purposely not implemented
   ServiceRegistrationBasePrivate(const ServiceRegistrationBasePrivate&);
   ServiceRegistrationBasePrivate& operator=(const ServiceRegistrationBasePrivate&);
@@ -19,7 +19,9 @@
 
 ============================================================================*/
 
+#include <atomic>
 #include <iterator>
+#include <memory>
 #include <stdexcept>
 #include <cassert>
 
@@ -65,8 +67,18 @@ ServicePropertiesImpl ServiceRegistry::CreateServiceProperties(const ServiceProp
   return ServicePropertiesImpl(props);
 }
 
+namespace {
+
+// Maximum number of cached LDAP expressions. The cache is cleared
+// if it is exceeded, e.g. by filters containing changing values.
+const std::size_t MAX_FILTER_CACHE_SIZE = 1024;
+
+}
+
 ServiceRegistry::ServiceRegistry(CoreModuleContext* coreCtx)
   : core(coreCtx)
+  , snapshot(std::make_shared<Snapshot>(Snapshot{
+      std::make_shared<std::vector<ServiceRegistrationBase> >(), MapClassServices()}))
 {
 
 }
@@ -78,12 +90,52 @@ ServiceRegistry::~ServiceRegistry()
 
 void ServiceRegistry::Clear()
 {
-  services.clear();
-  serviceRegistrations.clear();
-  classServices.clear();
+  {
+    MutexLock lock(mutex);
+    services.clear();
+    PublishSnapshot(std::make_shared<Snapshot>(Snapshot{
+      std::make_shared<std::vector<ServiceRegistrationBase> >(), MapClassServices()}));
+  }
+  {
+    MutexLock lock(filterCacheMutex);
+    filterCache.clear();
+  }
   core = nullptr;
 }
 
+ServiceRegistry::SnapshotPointer ServiceRegistry::GetSnapshot() const
+{
+  return std::atomic_load(&snapshot);
+}
+
+void ServiceRegistry::PublishSnapshot(const SnapshotPointer& newSnapshot)
+{
+  std::atomic_store(&snapshot, newSnapshot);
+}
+
+LDAPExpr ServiceRegistry::GetCompiledFilter(const std::string& filter) const
+{
+  {
+    MutexLock lock(filterCacheMutex);
+    MapFilterExpressions::const_iterator i = filterCache.find(filter);
+    if (i != filterCache.end())
+    {
+      return i->second;
+    }
+  }
+
+  // parse outside of the lock, invalid filters throw and are not cached
+  LDAPExpr ldap(filter);
+
+  MutexLock lock(filterCacheMutex);
+  if (filterCache.size() >= MAX_FILTER_CACHE_SIZE)
+  {
+    filterCache.clear();
+  }
+  filterCache.insert(std::make_pair(filter, ldap));
+  return ldap;
+}
+
 ServiceRegistrationBase ServiceRegistry::RegisterService(ModulePrivate* module,
                                                      const InterfaceMap& service,
                                                      const ServiceProperties& properties)
@@ -114,15 +166,28 @@ ServiceRegistrationBase ServiceRegistry::RegisterService(ModulePrivate* module,
   {
     MutexLock lock(mutex);
     services.insert(std::make_pair(res, classes));
-    serviceRegistrations.push_back(res);
+
+    std::shared_ptr<Snapshot> newSnapshot = std::make_shared<Snapshot>(*GetSnapshot());
+
+    std::shared_ptr<std::vector<ServiceRegistrationBase> > registrations =
+        std::make_shared<std::vector<ServiceRegistrationBase> >(*newSnapshot->serviceRegistrations);
+    registrations->push_back(res);
+    newSnapshot->serviceRegistrations = registrations;
+
     for (std::vector<std::string>::const_iterator i = classes.begin();
          i != classes.end(); ++i)
     {
-      std::vector<ServiceRegistrationBase>& s = classServices[*i];
+      ServiceRegistrationsPointer& current = newSnapshot->classServices[*i];
+      std::shared_ptr<std::vector<ServiceRegistrationBase> > s = current
+          ? std::make_shared<std::vector<ServiceRegistrationBase> >(*current)
+          : std::make_shared<std::vector<ServiceRegistrationBase> >();
       std::vector<ServiceRegistrationBase>::iterator ip =
-          std::lower_bound(s.begin(), s.end(), res);
-      s.insert(ip, res);
+          std::lower_bound(s->begin(), s->end(), res);
+      s->insert(ip, res);
+      current = s;
     }
+
+    PublishSnapshot(newSnapshot);
   }
 
   ServiceReferenceBase r = res.GetReference(std::string());
@@ -138,35 +203,43 @@ void ServiceRegistry::UpdateServiceRegistrationOrder(const ServiceRegistrationBa
                                                      const std::vector<std::string>& classes)
 {
   MutexLock lock(mutex);
+
+  std::shared_ptr<Snapshot> newSnapshot = std::make_shared<Snapshot>(*GetSnapshot());
+
   for (std::vector<std::string>::const_iterator i = classes.begin();
        i != classes.end(); ++i)
   {
-    std::vector<ServiceRegistrationBase>& s = classServices[*i];
-    s.erase(std::remove(s.begin(), s.end(), sr), s.end());
-    s.insert(std::lower_bound(s.begin(), s.end(), sr), sr);
+    ServiceRegistrationsPointer& current = newSnapshot->classServices[*i];
+    std::shared_ptr<std::vector<ServiceRegistrationBase> > s = current
+        ? std::make_shared<std::vector<ServiceRegistrationBase> >(*current)
+        : std::make_shared<std::vector<ServiceRegistrationBase> >();
+    s->erase(std::remove(s->begin(), s->end(), sr), s->end());
+    s->insert(std::lower_bound(s->begin(), s->end(), sr), sr);
+    current = s;
   }
+
+  PublishSnapshot(newSnapshot);
 }
 
 void ServiceRegistry::Get(const std::string& clazz,
                           std::vector<ServiceRegistrationBase>& serviceRegs) const
 {
-  MutexLock lock(mutex);
   Get_unlocked(clazz, serviceRegs);
 }
 
 void ServiceRegistry::Get_unlocked(const std::string& clazz,
                                    std::vector<ServiceRegistrationBase>& serviceRegs) const
 {
-  MapClassServices::const_iterator i = classServices.find(clazz);
-  if (i != classServices.end())
+  SnapshotPointer current = GetSnapshot();
+  MapClassServices::const_iterator i = current->classServices.find(clazz);
+  if (i != current->classServices.end())
   {
-    serviceRegs = i->second;
+    serviceRegs = *i->second;
   }
 }
 
 ServiceReferenceBase ServiceRegistry::Get(ModulePrivate* module, const std::string& clazz) const
 {
-  MutexLock lock(mutex);
   try
   {
     std::vector<ServiceReferenceBase> srs;
@@ -188,13 +261,15 @@ ServiceReferenceBase ServiceRegistry::Get(ModulePrivate* module, const std::stri
 void ServiceRegistry::Get(const std::string& clazz, const std::string& filter,
                           ModulePrivate* module, std::vector<ServiceReferenceBase>& res) const
 {
-  MutexLock lock(mutex);
   Get_unlocked(clazz, filter, module, res);
 }
 
 void ServiceRegistry::Get_unlocked(const std::string& clazz, const std::string& filter,
                           ModulePrivate* module, std::vector<ServiceReferenceBase>& res) const
 {
+  // the snapshot keeps the iterated registration lists alive
+  SnapshotPointer current = GetSnapshot();
+
   std::vector<ServiceRegistrationBase>::const_iterator s;
   std::vector<ServiceRegistrationBase>::const_iterator send;
   std::vector<ServiceRegistrationBase> v;
@@ -203,7 +278,7 @@ void ServiceRegistry::Get_unlocked(const std::string& clazz, const std::string&
   {
     if (!filter.empty())
     {
-      ldap = LDAPExpr(filter);
+      ldap = GetCompiledFilter(filter);
       LDAPExpr::ObjectClassSet matched;
       if (ldap.GetMatchedObjectClasses(matched))
       {
@@ -211,10 +286,10 @@ void ServiceRegistry::Get_unlocked(const std::string& clazz, const std::string&
         for(LDAPExpr::ObjectClassSet::const_iterator className = matched.begin();
             className != matched.end(); ++className)
         {
-          MapClassServices::const_iterator i = classServices.find(*className);
-          if (i != classServices.end())
+          MapClassServices::const_iterator i = current->classServices.find(*className);
+          if (i != current->classServices.end())
           {
-            std::copy(i->second.begin(), i->second.end(), std::back_inserter(v));
+            std::copy(i->second->begin(), i->second->end(), std::back_inserter(v));
           }
         }
         if (!v.empty())
@@ -229,23 +304,23 @@ void ServiceRegistry::Get_unlocked(const std::string& clazz, const std::string&
       }
       else
       {
-        s = serviceRegistrations.begin();
-        send = serviceRegistrations.end();
+        s = current->serviceRegistrations->begin();
+        send = current->serviceRegistrations->end();
       }
     }
     else
     {
-      s = serviceRegistrations.begin();
-      send = serviceRegistrations.end();
+      s = current->serviceRegistrations->begin();
+      send = current->serviceRegistrations->end();
     }
   }
   else
   {
-    MapClassServices::const_iterator it = classServices.find(clazz);
-    if (it != classServices.end())
+    MapClassServices::const_iterator it = current->classServices.find(clazz);
+    if (it != current->classServices.end())
     {
-      s = it->second.begin();
-      send = it->second.end();
+      s = it->second->begin();
+      send = it->second->end();
     }
     else
     {
@@ -253,17 +328,22 @@ void ServiceRegistry::Get_unlocked(const std::string& clazz, const std::string&
     }
     if (!filter.empty())
     {
-      ldap = LDAPExpr(filter);
+      ldap = GetCompiledFilter(filter);
     }
   }
 
   for (; s != send; ++s)
   {
-    ServiceReferenceBase sri = s->GetReference(clazz);
+    if (filter.empty())
+    {
+      res.push_back(s->GetReference(clazz));
+      continue;
+    }
 
-    if (filter.empty() || ldap.Evaluate(s->d->properties, false))
+    // evaluated on a snapshot, ServiceRegistrationBase::SetProperties may replace the properties concurrently
+    if (ldap.Evaluate(*s->d->GetProperties(), false))
     {
-      res.push_back(sri);
+      res.push_back(s->GetReference(clazz));
     }
   }
 
@@ -284,34 +364,52 @@ void ServiceRegistry::RemoveServiceRegistration(const ServiceRegistrationBase& s
 {
   MutexLock lock(mutex);
 
-  assert(sr.d->properties.Value(ServiceConstants::OBJECTCLASS()).Type() == typeid(std::vector<std::string>));
+  const ServiceRegistrationBasePrivate::PropertiesPointer properties = sr.d->GetProperties();
+  assert(properties->Value(ServiceConstants::OBJECTCLASS()).Type() == typeid(std::vector<std::string>));
   const std::vector<std::string>& classes = ref_any_cast<std::vector<std::string> >(
-        sr.d->properties.Value(ServiceConstants::OBJECTCLASS()));
+        properties->Value(ServiceConstants::OBJECTCLASS()));
   services.erase(sr);
-  serviceRegistrations.erase(std::remove(serviceRegistrations.begin(), serviceRegistrations.end(), sr),
-                             serviceRegistrations.end());
+
+  std::shared_ptr<Snapshot> newSnapshot = std::make_shared<Snapshot>(*GetSnapshot());
+
+  std::shared_ptr<std::vector<ServiceRegistrationBase> > registrations =
+      std::make_shared<std::vector<ServiceRegistrationBase> >(*newSnapshot->serviceRegistrations);
+  registrations->erase(std::remove(registrations->begin(), registrations->end(), sr),
+                       registrations->end());
+  newSnapshot->serviceRegistrations = registrations;
+
   for (std::vector<std::string>::const_iterator i = classes.begin();
        i != classes.end(); ++i)
   {
-    std::vector<ServiceRegistrationBase>& s = classServices[*i];
-    if (s.size() > 1)
+    MapClassServices::iterator current = newSnapshot->classServices.find(*i);
+    if (current == newSnapshot->classServices.end())
     {
-      s.erase(std::remove(s.begin(), s.end(), sr), s.end());
+      continue;
+    }
+
+    if (current->second->size() > 1)
+    {
+      std::shared_ptr<std::vector<ServiceRegistrationBase> > s =
+          std::make_shared<std::vector<ServiceRegistrationBase> >(*current->second);
+      s->erase(std::remove(s->begin(), s->end(), sr), s->end());
+      current->second = s;
     }
     else
     {
-      classServices.erase(*i);
+      newSnapshot->classServices.erase(current);
     }
   }
+
+  PublishSnapshot(newSnapshot);
 }
 
 void ServiceRegistry::GetRegisteredByModule(ModulePrivate* p,
                                             std::vector<ServiceRegistrationBase>& res) const
 {
-  MutexLock lock(mutex);
+  SnapshotPointer current = GetSnapshot();
 
-  for (std::vector<ServiceRegistrationBase>::const_iterator i = serviceRegistrations.begin();
-       i != serviceRegistrations.end(); ++i)
+  for (std::vector<ServiceRegistrationBase>::const_iterator i = current->serviceRegistrations->begin();
+       i != current->serviceRegistrations->end(); ++i)
   {
     if (i->d->module == p)
     {
@@ -323,10 +421,10 @@ void ServiceRegistry::GetRegisteredByModule(ModulePrivate* p,
 void ServiceRegistry::GetUsedByModule(Module* p,
                                       std::vector<ServiceRegistrationBase>& res) const
 {
-  MutexLock lock(mutex);
+  SnapshotPointer current = GetSnapshot();
 
-  for (std::vector<ServiceRegistrationBase>::const_iterator i = serviceRegistrations.begin();
-       i != serviceRegistrations.end(); ++i)
+  for (std::vector<ServiceRegistrationBase>::const_iterator i = current->serviceRegistrations->begin();
+       i != current->serviceRegistrations->end(); ++i)
   {
     if (i->d->IsUsedByModule(p))
     {
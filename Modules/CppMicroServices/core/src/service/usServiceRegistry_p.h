@@ -27,6 +27,9 @@
 #include "usServiceRegistration.h"
 
 #include "usThreads_p.h"
+#include "usLDAPExpr_p.h"
+
+#include <memory>
 
 US_BEGIN_NAMESPACE
 
@@ -61,7 +64,33 @@ public:
                                                        bool isFactory = false, bool isPrototypeFactory = false, long sid = -1);
 
   typedef US_UNORDERED_MAP_TYPE<ServiceRegistrationBase, std::vector<std::string> > MapServiceClasses;
-  typedef US_UNORDERED_MAP_TYPE<std::string, std::vector<ServiceRegistrationBase> > MapClassServices;
+  typedef std::shared_ptr<const std::vector<ServiceRegistrationBase> > ServiceRegistrationsPointer;
+  typedef US_UNORDERED_MAP_TYPE<std::string, ServiceRegistrationsPointer> MapClassServices;
+
+  /**
+   * Immutable state of the registry that is read by service lookups.
+   *
+   * Modifications of the registry copy the current snapshot, change the
+   * copy and publish it. Lookups therefore never wait for the registry
+   * mutex or for each other. Registration lists are shared between
+   * snapshots unless they change.
+   */
+  struct Snapshot
+  {
+    /**
+     * All registered services in the current framework.
+     */
+    ServiceRegistrationsPointer serviceRegistrations;
+
+    /**
+     * Mapping of classname to registered service.
+     * The List of registered services are ordered with the highest
+     * ranked service first.
+     */
+    MapClassServices classServices;
+  };
+
+  typedef std::shared_ptr<const Snapshot> SnapshotPointer;
 
   /**
    * All registered services in the current framework.
@@ -70,15 +99,6 @@ public:
    */
   MapServiceClasses services;
 
-  std::vector<ServiceRegistrationBase> serviceRegistrations;
-
-  /**
-   * Mapping of classname to registered service.
-   * The List of registered services are ordered with the highest
-   * ranked service first.
-   */
-  MapClassServices classServices;
-
   CoreModuleContext* core;
 
   ServiceRegistry(CoreModuleContext* coreCtx);
@@ -169,10 +189,37 @@ public:
    */
   void GetUsedByModule(Module* m, std::vector<ServiceRegistrationBase>& serviceRegs) const;
 
+  /**
+   * Returns the current snapshot of the registered services.
+   */
+  SnapshotPointer GetSnapshot() const;
+
+  /**
+   * Returns the parsed LDAP expression of the given filter.
+   *
+   * Expressions are cached by their filter string.
+   *
+   * @exception std::invalid_argument If the filter is not a valid LDAP filter.
+   */
+  LDAPExpr GetCompiledFilter(const std::string& filter) const;
+
 private:
 
   friend class ServiceHooks;
 
+  typedef US_UNORDERED_MAP_TYPE<std::string, LDAPExpr> MapFilterExpressions;
+
+  /**
+   * Only accessed with std::atomic_load / std::atomic_store.
+   * Writers additionally hold the registry mutex.
+   */
+  SnapshotPointer snapshot;
+
+  mutable MutexType filterCacheMutex;
+  mutable MapFilterExpressions filterCache;
+
+  void PublishSnapshot(const SnapshotPointer& newSnapshot);
+
   void Get_unlocked(const std::string& clazz, std::vector<ServiceRegistrationBase>& serviceRegs) const;
 
   void Get_unlocked(const std::string& clazz, const std::string& filter,
@@ -48,6 +48,10 @@ US_USE_NAMESPACE
 
 #include <vector>
 
+#ifdef US_ENABLE_THREADING_SUPPORT
+#include <thread>
+#endif
+
 class HighPrecisionTimer
 {
 
@@ -207,6 +211,8 @@ public:
   void TestModifyServices();
   void TestUnregisterServices();
 
+  void TestLookupServices();
+
 private:
 
   std::ostream& Log() const
@@ -218,6 +224,7 @@ private:
   void RegisterServices(int n);
   void ModifyServices();
   void UnregisterServices();
+  std::size_t LookupServices(int n);
 
 };
 
@@ -411,6 +418,68 @@ void ServiceRegistryPerformanceTest::UnregisterServices()
   regs.clear();
 }
 
+void ServiceRegistryPerformanceTest::TestLookupServices()
+{
+  Log() << "Look up services with a filter, and check the lookup rate against the number of registered services\n";
+
+  const int steps[] = { 1, 10, 100, 1000 };
+
+  for (std::size_t step = 0; step < sizeof(steps) / sizeof(steps[0]); ++step)
+  {
+    RegisterServices(steps[step] - static_cast<int>(regs.size()));
+
+    // each run returns about the same number of references
+    const int nLookups = 100000 / steps[step];
+
+    HighPrecisionTimer t;
+    t.Start();
+    std::size_t nFound = LookupServices(nLookups);
+    long long us = t.ElapsedMicro();
+
+    Log() << regs.size() << " services: " << nLookups << " lookups took " << us / 1000 << "ms ("
+          << (us > 0 ? nLookups * 1000000LL / us : 0) << " lookups/s)\n";
+    US_TEST_CONDITION_REQUIRED(nFound == nLookups * regs.size(),
+                               "Each lookup must find all registered services");
+
+#ifdef US_ENABLE_THREADING_SUPPORT
+    const unsigned int nThreads = 4;
+    std::vector<std::thread> threads;
+    std::vector<std::size_t> nFoundPerThread(nThreads, 0);
+
+    t.Start();
+    for (unsigned int i = 0; i < nThreads; ++i)
+    {
+      threads.push_back(std::thread([this, i, nLookups, &nFoundPerThread]() {
+        nFoundPerThread[i] = LookupServices(nLookups);
+      }));
+    }
+    for (unsigned int i = 0; i < nThreads; ++i)
+    {
+      threads[i].join();
+      nFound = nFoundPerThread[i];
+      US_TEST_CONDITION_REQUIRED(nFound == nLookups * regs.size(),
+                                 "Each concurrent lookup must find all registered services");
+    }
+    us = t.ElapsedMicro();
+
+    Log() << regs.size() << " services: " << nThreads * nLookups << " lookups in " << nThreads
+          << " threads took " << us / 1000 << "ms ("
+          << (us > 0 ? nThreads * nLookups * 1000000LL / us : 0) << " lookups/s)\n";
+#endif
+  }
+
+  UnregisterServices();
+}
+
+std::size_t ServiceRegistryPerformanceTest::LookupServices(int n)
+{
+  std::size_t nFound = 0;
+  for (int i = 0; i < n; ++i)
+  {
+    nFound += mc->GetServiceReferences<IPerfTestService>("(perf.service.value>=0)").size();
+  }
+  return nFound;
+}
 
 int usServiceRegistryPerformanceTest(int /*argc*/, char* /*argv*/[])
 {
@@ -424,5 +493,8 @@ int usServiceRegistryPerformanceTest(int /*argc*/, char* /*argv*/[])
   perfTest.TestUnregisterServices();
   perfTest.CleanupTestCase();
 
+  // without listeners, so that registering the services does not dominate the test time
+  perfTest.TestLookupServices();
+
   US_TEST_END()
 }
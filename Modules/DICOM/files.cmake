@@ -29,6 +29,8 @@ set(CPP_FILES
   mitkDICOMTagCache.cpp
   mitkDICOMGDCMTagCache.cpp
   mitkDICOMGenericTagCache.cpp
+  mitkDICOMPersistentTagIndex.cpp
+  mitkDICOMPersistentTagCache.cpp
   mitkDICOMEnums.cpp
   mitkDICOMReaderConfigurator.cpp
   mitkDICOMFileReaderSelector.cpp
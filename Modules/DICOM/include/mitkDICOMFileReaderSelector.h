@@ -14,6 +14,7 @@ found in the LICENSE file.
 #define mitkDICOMFileReaderSelector_h
 
 #include "mitkDICOMFileReader.h"
+#include "mitkDICOMPersistentTagIndex.h"
 
 #include <usModuleResource.h>
 
@@ -92,6 +93,11 @@ class MITKDICOM_EXPORT DICOMFileReaderSelector : public itk::LightObject
     /// Input files
     const StringList& GetInputFiles() const;
 
+    /// \brief Index used by the tag scanning to skip the header parsing of files that were scanned before (see DICOMPersistentTagIndex).
+    /// nullptr (default) scans all files.
+    void SetPersistentTagIndex(DICOMPersistentTagIndex* index);
+    DICOMPersistentTagIndex* GetPersistentTagIndex() const;
+
     /// Execute the analysis and selection process. The first reader with a minimal number of outputs will be returned.
     DICOMFileReader::Pointer GetFirstReaderWithMinimumNumberOfOutputImages();
 
@@ -108,6 +114,7 @@ class MITKDICOM_EXPORT DICOMFileReaderSelector : public itk::LightObject
     StringList m_PossibleConfigurations;
     StringList m_InputFilenames;
     ReaderList m_Readers;
+    DICOMPersistentTagIndex::Pointer m_PersistentTagIndex;
 
  };
 
@@ -17,6 +17,7 @@ found in the LICENSE file.
 
 #include <set>
 #include <memory>
+#include <vector>
 
 #include <gdcmScanner.h>
 
@@ -43,8 +44,20 @@ namespace mitk
 
       void InitCache(const std::set<DICOMTag>& scannedTags, const std::shared_ptr<gdcm::Scanner>& scanner, const StringList& inputFiles);
 
+      /**
+        \brief Initializes the cache with the results of a partitioned scan.
+        The input files were scanned in consecutive partitions; scanners[i] holds the
+        results of the files [partitionBegins[i], partitionBegins[i+1]) of inputFiles.
+        The resulting frame list is identical to the list of a single scanner that scanned all files.
+      */
+      void InitCache(const std::set<DICOMTag>& scannedTags, const std::vector<std::shared_ptr<gdcm::Scanner>>& scanners, const std::vector<std::size_t>& partitionBegins, const StringList& inputFiles);
+
+      /** Returns the (first) scanner of the cache. If the cache was initialized
+        with a partitioned scan, use GetScanners() to access all results.*/
       const gdcm::Scanner& GetScanner() const;
 
+      const std::vector<std::shared_ptr<gdcm::Scanner>>& GetScanners() const;
+
   protected:
 
       DICOMGDCMTagCache();
@@ -54,6 +67,10 @@ namespace mitk
 
       std::shared_ptr<gdcm::Scanner> m_Scanner;
 
+      /** All scanners of the scan. The frame infos reference the values held by the scanners,
+        so the scanners must be kept alive as long as the cache exists.*/
+      std::vector<std::shared_ptr<gdcm::Scanner>> m_Scanners;
+
       DICOMDatasetAccessingImageFrameList m_ScanResult;
 
     private:
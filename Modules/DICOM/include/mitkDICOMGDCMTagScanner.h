@@ -16,6 +16,7 @@ found in the LICENSE file.
 #include "mitkDICOMTagScanner.h"
 #include "mitkDICOMEnums.h"
 #include "mitkDICOMGDCMTagCache.h"
+#include "mitkDICOMPersistentTagIndex.h"
 
 namespace mitk
 {
@@ -41,6 +42,10 @@ namespace mitk
     results, care should be taken that all the tags and files of interest
     are communicated to DICOMGDCMTagScanner before requesting the results!
 
+    If a DICOMPersistentTagIndex is set, only files that are not (validly) contained
+    in the index are scanned. The results are added to the index, which is saved
+    after the scan. The scan cache is a DICOMPersistentTagCache in this case.
+
     @remark This scanner does only support the scanning for simple value tag.
     If you need to scann for sequence items or non-top-level elements, this scanner
     will not be sufficient. See i.a. DICOMDCMTKTagScanner for these cases.
@@ -77,6 +82,13 @@ namespace mitk
       */
       void SetInputFiles(const StringList& filenames) override;
 
+      /**
+        \brief Index that is used to skip the header parsing of files that were scanned before.
+        Pass nullptr (default) to scan all files.
+      */
+      void SetPersistentTagIndex(DICOMPersistentTagIndex* index);
+      DICOMPersistentTagIndex* GetPersistentTagIndex() const;
+
       /**
         \brief Start the scanning process.
         Calling Scan() will invalidate previous scans, forgetting
@@ -106,10 +118,14 @@ namespace mitk
       DICOMGDCMTagScanner();
       ~DICOMGDCMTagScanner() override;
 
+      /** Scans the passed files for all tags of interest (serially or in parallel, depending on the number of workers).*/
+      DICOMGDCMTagCache::Pointer ScanFiles(const StringList& filenames);
+
       std::set<DICOMTag> m_ScannedTags;
       StringList m_InputFilenames;
-      DICOMGDCMTagCache::Pointer m_Cache;
+      DICOMTagCache::Pointer m_Cache;
       std::shared_ptr<gdcm::Scanner> m_GDCMScanner;
+      DICOMPersistentTagIndex::Pointer m_PersistentTagIndex;
 
     private:
       DICOMGDCMTagScanner(const DICOMGDCMTagScanner&);
@@ -18,6 +18,7 @@ found in the LICENSE file.
 #include "mitkDICOMFileReader.h"
 #include "mitkDICOMDatasetSorter.h"
 #include "mitkDICOMGDCMImageFrameInfo.h"
+#include "mitkDICOMPersistentTagIndex.h"
 #include "mitkEquiDistantBlocksSorter.h"
 #include "mitkNormalDirectionConsistencySorter.h"
 #include "MitkDICOMExports.h"
@@ -259,6 +260,35 @@ class MITKDICOM_EXPORT DICOMITKSeriesGDCMReader : public DICOMFileReader
       return m_SimpleVolumeReading;
     };
 
+    /**
+    \brief Number of threads used to scan the tags of the input files (see DICOMTagScanner::SetNumberOfWorkers()).
+    1 (default) scans the files serially; 0 uses as many threads as the hardware supports.
+    The sorting result does not depend on this setting.
+    */
+    void SetNumberOfTagScannerWorkers(unsigned int numberOfWorkers)
+    {
+      m_NumberOfTagScannerWorkers = numberOfWorkers;
+    };
+
+    unsigned int GetNumberOfTagScannerWorkers() const
+    {
+      return m_NumberOfTagScannerWorkers;
+    };
+
+    /**
+    \brief Index used by the tag scanning to skip the header parsing of files that were scanned before (see DICOMPersistentTagIndex).
+    nullptr (default) scans all files.
+    */
+    void SetPersistentTagIndex(DICOMPersistentTagIndex* index)
+    {
+      m_PersistentTagIndex = index;
+    };
+
+    DICOMPersistentTagIndex* GetPersistentTagIndex() const
+    {
+      return m_PersistentTagIndex;
+    };
+
     double GetToleratedOriginError() const;
     bool IsToleratedOriginOffsetAbsolute() const;
 
@@ -371,6 +401,9 @@ class MITKDICOM_EXPORT DICOMITKSeriesGDCMReader : public DICOMFileReader
 
     DICOMTagCache::Pointer m_TagCache;
     bool m_ExternalCache;
+
+    unsigned int m_NumberOfTagScannerWorkers;
+    DICOMPersistentTagIndex::Pointer m_PersistentTagIndex;
 };
 
 }
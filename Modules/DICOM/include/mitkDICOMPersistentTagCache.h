@@ -0,0 +1,70 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef mitkDICOMPersistentTagCache_h
+#define mitkDICOMPersistentTagCache_h
+
+#include "mitkDICOMTagCache.h"
+#include "mitkDICOMPersistentTagIndex.h"
+
+#include <set>
+#include <vector>
+
+namespace mitk
+{
+
+  /**
+    \ingroup DICOMModule
+    \brief Tag cache implementation used by the DICOMGDCMTagScanner if a DICOMPersistentTagIndex is used.
+
+    The cache provides the scan result based on the records of the index. It gives
+    the same results as DICOMGDCMTagCache for a scan of the same files and tags.
+    The cache keeps the used records alive, so it stays valid if the index changes.
+  */
+  class MITKDICOM_EXPORT DICOMPersistentTagCache : public DICOMTagCache
+  {
+    public:
+
+      mitkClassMacro(DICOMPersistentTagCache, DICOMTagCache);
+      itkFactorylessNewMacro( DICOMPersistentTagCache );
+      itkCloneMacro(Self);
+
+      DICOMDatasetFinding GetTagValue(DICOMImageFrameInfo* frame, const DICOMTag& tag) const override;
+
+      FindingsListType GetTagValue(DICOMImageFrameInfo* frame, const DICOMTagPath& path) const override;
+
+      DICOMDatasetAccessingImageFrameList GetFrameInfoList() const override;
+
+      /**
+        \brief Initializes the cache.
+        records[i] is the record of inputFiles[i]; a nullptr record is treated like an unreadable file.
+      */
+      void InitCache(const std::set<DICOMTag>& scannedTags, const std::vector<DICOMPersistentTagIndex::FileRecordConstPointer>& records, const StringList& inputFiles);
+
+  protected:
+
+      DICOMPersistentTagCache();
+      ~DICOMPersistentTagCache() override;
+
+      std::set<DICOMTag> m_ScannedTags;
+
+      /** The frame infos reference the values of the records.*/
+      std::vector<DICOMPersistentTagIndex::FileRecordConstPointer> m_Records;
+
+      DICOMDatasetAccessingImageFrameList m_ScanResult;
+
+    private:
+      DICOMPersistentTagCache(const DICOMPersistentTagCache&);
+  };
+}
+
+#endif
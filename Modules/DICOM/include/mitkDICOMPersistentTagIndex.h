@@ -0,0 +1,142 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef mitkDICOMPersistentTagIndex_h
+#define mitkDICOMPersistentTagIndex_h
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+
+#include "itkObjectFactory.h"
+#include "mitkCommon.h"
+
+#include "mitkDICOMTag.h"
+
+#include "MitkDICOMExports.h"
+
+namespace mitk
+{
+
+  /**
+    \ingroup DICOMModule
+    \brief On-disk index of the tag values of scanned DICOM files.
+
+    The index stores the values of all scanned tags per file together with the size
+    and the modification time of the file at scan time. It can be passed to
+    DICOMGDCMTagScanner (or DICOMITKSeriesGDCMReader and DICOMFileReaderSelector,
+    which forward it to their scanner). The scanner then only parses the headers of
+    files that are not in the index, whose size or modification time changed or
+    which were scanned for fewer tags than currently requested.
+
+    The index is kept in memory and written to a compact binary file by Save().
+    Call Load() once after creation to reuse the results of previous sessions.
+    An index file that cannot be read (e.g. written by an incompatible version)
+    is ignored and rewritten on the next Save().
+
+    The class is thread safe; one index can be shared by several scanners.
+  */
+  class MITKDICOM_EXPORT DICOMPersistentTagIndex : public itk::Object
+  {
+    public:
+
+      mitkClassMacroItkParent(DICOMPersistentTagIndex, itk::Object);
+      mitkNewMacro1Param(DICOMPersistentTagIndex, const std::string&);
+
+      /** Scan result of one file. Records are immutable once they are stored in the index.*/
+      struct FileRecord
+      {
+        std::uint64_t FileSize = 0;
+        std::int64_t ModificationTime = 0;
+        /** All tags the file was scanned for.*/
+        std::set<DICOMTag> ScannedTags;
+        /** Values of the scanned tags that were found in the file.*/
+        std::map<DICOMTag, std::string> Values;
+      };
+
+      using FileRecordConstPointer = std::shared_ptr<const FileRecord>;
+
+      /** Path of the file the index is loaded from and saved to.*/
+      std::string GetIndexFile() const;
+
+      /**
+        \brief Replaces the content of the index by the content of the index file.
+        \return False if the file does not exist or cannot be read (e.g. because it is truncated).
+        The index is empty in this case.
+      */
+      bool Load();
+
+      /**
+        \brief Writes the index to the index file, if it has changed since the last Load() or Save().
+        The file is replaced atomically, so concurrent readers never see a partially written index.
+        \pre The directory of the index file must exist.
+      */
+      void Save();
+
+      /**
+        \brief Returns the record of the passed file, if it is still valid.
+        A record is valid if the size and modification time of the file did not change and
+        the file was scanned for all passed tags. Otherwise nullptr is returned.
+      */
+      FileRecordConstPointer Lookup(const std::string& filename, const std::set<DICOMTag>& tags) const;
+
+      /**
+        \brief Stores the values that were scanned for the passed tags.
+        The size and modification time are taken from the file. Values of other tags from a
+        previous, still valid record of the file are kept.
+        \return The stored record or nullptr if the file does not exist.
+        \remark Prefer the overload with the file stamp if the file could change while it is scanned.
+      */
+      FileRecordConstPointer Store(const std::string& filename, const std::set<DICOMTag>& tags, const std::map<DICOMTag, std::string>& values);
+
+      /**
+        \brief Stores the values that were scanned for the passed tags with the size and modification time
+        the file had before it was scanned (see GetFileStamp()).
+        If the file is modified during the scan, the record does not match the file and is not used by Lookup().
+        \return The stored record.
+      */
+      FileRecordConstPointer Store(const std::string& filename,
+                                   std::uint64_t fileSize,
+                                   std::int64_t modificationTime,
+                                   const std::set<DICOMTag>& tags,
+                                   const std::map<DICOMTag, std::string>& values);
+
+      /** Removes all records.*/
+      void Clear();
+
+      std::size_t GetNumberOfRecords() const;
+
+      /** Retrieves size and modification time of a file. Returns false if the file does not exist.*/
+      static bool GetFileStamp(const std::string& filename, std::uint64_t& fileSize, std::int64_t& modificationTime);
+
+    protected:
+
+      explicit DICOMPersistentTagIndex(const std::string& indexFile);
+      ~DICOMPersistentTagIndex() override;
+
+      /** Key of a file in the index (absolute path).*/
+      static std::string GetKey(const std::string& filename);
+
+    private:
+
+      std::string m_IndexFile;
+      std::map<std::string, FileRecordConstPointer> m_Records;
+      bool m_Dirty;
+      mutable std::mutex m_Mutex;
+
+      DICOMPersistentTagIndex(const DICOMPersistentTagIndex&);
+  };
+}
+
+#endif
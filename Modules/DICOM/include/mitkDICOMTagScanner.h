@@ -13,6 +13,7 @@ found in the LICENSE file.
 #ifndef mitkDICOMTagScanner_h
 #define mitkDICOMTagScanner_h
 
+#include <functional>
 #include <stack>
 #include <mutex>
 
@@ -35,6 +36,12 @@ namespace mitk
 
     This is an abstract base class for concrete scanner implementations.
 
+    By default the files are scanned one after another. If the number of workers
+    (see SetNumberOfWorkers()) is set to a value other than 1, the headers are
+    parsed concurrently by the given number of threads. The results of such a
+    parallel scan are identical to the results of a serial scan (same frames in
+    the same order with the same tag values).
+
     @remark When used in a process where multiple classes will access the scan
     results, care should be taken that all the tags and files of interest
     are communicated to DICOMTagScanner before requesting the results!
@@ -86,8 +93,30 @@ namespace mitk
       */
       virtual DICOMTagCache::Pointer GetScanCache() const = 0;
 
+      /**
+      \brief Number of threads that are used to parse the headers of the input files.
+      1 (default) scans the files serially; 0 uses the global default number of threads of ITK.
+      */
+      itkSetMacro(NumberOfWorkers, unsigned int);
+      itkGetConstMacro(NumberOfWorkers, unsigned int);
+
     protected:
 
+      /**
+      \brief Returns the number of threads that should be used to process the given number of jobs.
+      It respects the number of workers set by the user but never exceeds the number of jobs.
+      */
+      unsigned int GetEffectiveNumberOfWorkers(std::size_t numberOfJobs) const;
+
+      /**
+      \brief Calls the job function for every index in [0, numberOfJobs).
+      The jobs are distributed dynamically over GetEffectiveNumberOfWorkers() work units of
+      an itk::MultiThreaderBase; each work unit takes the next unprocessed job as soon as it is idle. If one of the jobs
+      throws, the remaining jobs are skipped and the first exception is rethrown in the
+      calling thread.
+      */
+      void ProcessJobs(std::size_t numberOfJobs, const std::function<void(std::size_t)>& job) const;
+
       /** \brief Return active C locale */
       static std::string GetActiveLocale();
       /**
@@ -111,6 +140,8 @@ namespace mitk
       mutable std::stack<std::string> m_ReplacedCLocales;
       mutable std::stack<std::locale> m_ReplacedCinLocales;
 
+      unsigned int m_NumberOfWorkers;
+
       DICOMTagScanner(const DICOMTagScanner&);
   };
 }
@@ -100,65 +100,108 @@ mitk::DICOMTagPath DcmPathToTagPath(DcmPath * dcmpath)
   return result;
 }
 
+namespace
+{
+  /** Reads the given file and extracts the values of all passed tag paths.
+    Returns nullptr if the file cannot be read.*/
+  mitk::DICOMGenericImageFrameInfo::Pointer ScanFile(const std::string& fileName, const std::set<mitk::DICOMTagPath>& scannedTags, DcmPathProcessor& processor)
+  {
+    DcmFileFormat dfile;
+    OFCondition cond = dfile.loadFile(fileName.c_str());
+    if (cond.bad())
+    {
+      MITK_ERROR << "Error when scanning for tags. Cannot open given file. File: " << fileName;
+      return nullptr;
+    }
+
+    mitk::DICOMGenericImageFrameInfo::Pointer info = mitk::DICOMGenericImageFrameInfo::New(fileName);
+
+    for (const auto& path : scannedTags)
+    {
+      std::string tagPath = mitk::DICOMTagPathToDCMTKSearchPath(path);
+      cond = processor.findOrCreatePath(dfile.getDataset(), tagPath.c_str());
+      if (cond.good())
+      {
+        OFList< DcmPath * > findings;
+        processor.getResults(findings);
+        for (const auto& finding : findings)
+        {
+          auto element = dynamic_cast<DcmElement*>(finding->back()->m_obj);
+          if (!element)
+          {
+            auto item = dynamic_cast<DcmItem*>(finding->back()->m_obj);
+            if (item)
+            {
+              element = item->getElement(finding->back()->m_itemNo);
+            }
+          }
+
+          if (element)
+          {
+            OFString value;
+            cond = element->getOFStringArray(value);
+            if (cond.good())
+            {
+              info->SetTagValue(DcmPathToTagPath(finding), std::string(value.c_str()));
+            }
+          }
+        }
+      }
+    }
+
+    return info;
+  }
+}
+
 void mitk::DICOMDCMTKTagScanner::Scan()
 {
   this->PushLocale();
 
   try
   {
-    DcmPathProcessor processor;
-    processor.setItemWildcardSupport(true);
-
     DICOMGenericTagCache::Pointer newCache = DICOMGenericTagCache::New();
 
-    for (const auto& fileName : this->m_InputFilenames)
+    if (this->GetEffectiveNumberOfWorkers(m_InputFilenames.size()) < 2)
     {
-      if (fs::is_directory(fileName))
-        continue;
+      DcmPathProcessor processor;
+      processor.setItemWildcardSupport(true);
 
-      DcmFileFormat dfile;
-      OFCondition cond = dfile.loadFile(fileName.c_str());
-      if (cond.bad())
+      for (const auto& fileName : this->m_InputFilenames)
       {
-        MITK_ERROR << "Error when scanning for tags. Cannot open given file. File: " << fileName;
+        if (fs::is_directory(fileName))
+          continue;
+
+        auto info = ScanFile(fileName, this->m_ScannedTags, processor);
+        if (info.IsNotNull())
+        {
+          newCache->AddFrameInfo(info);
+        }
       }
-      else
+    }
+    else
+    {
+      // Every file is parsed on its own; the results are collected per input index
+      // and added in input order, so the cache equals the one of a serial scan.
+      std::vector<DICOMGenericImageFrameInfo::Pointer> infos(m_InputFilenames.size());
+
+      this->ProcessJobs(m_InputFilenames.size(), [&](std::size_t fileIndex)
       {
-        DICOMGenericImageFrameInfo::Pointer info = DICOMGenericImageFrameInfo::New(fileName);
+        const auto& fileName = m_InputFilenames[fileIndex];
+        if (fs::is_directory(fileName))
+          return;
+
+        DcmPathProcessor processor;
+        processor.setItemWildcardSupport(true);
+
+        infos[fileIndex] = ScanFile(fileName, this->m_ScannedTags, processor);
+      });
 
-        for (const auto& path : this->m_ScannedTags)
+      for (const auto& info : infos)
+      {
+        if (info.IsNotNull())
         {
-          std::string tagPath = DICOMTagPathToDCMTKSearchPath(path);
-          cond = processor.findOrCreatePath(dfile.getDataset(), tagPath.c_str());
-          if (cond.good())
-          {
-            OFList< DcmPath * > findings;
-            processor.getResults(findings);
-            for (const auto& finding : findings)
-            {
-              auto element = dynamic_cast<DcmElement*>(finding->back()->m_obj);
-              if (!element)
-              {
-                auto item = dynamic_cast<DcmItem*>(finding->back()->m_obj);
-                if (item)
-                {
-                  element = item->getElement(finding->back()->m_itemNo);
-                }
-              }
-
-              if (element)
-              {
-                OFString value;
-                cond = element->getOFStringArray(value);
-                if (cond.good())
-                {
-                  info->SetTagValue(DcmPathToTagPath(finding), std::string(value.c_str()));
-                }
-              }
-            }
-          }
+          newCache->AddFrameInfo(info);
         }
-        newCache->AddFrameInfo(info);
       }
     }
 
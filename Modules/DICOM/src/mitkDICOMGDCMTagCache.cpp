@@ -14,6 +14,8 @@ found in the LICENSE file.
 #include "mitkDICOMEnums.h"
 #include "mitkDICOMGDCMImageFrameInfo.h"
 
+#include <mitkExceptionMacro.h>
+
 mitk::DICOMGDCMTagCache::DICOMGDCMTagCache()
 {
 }
@@ -83,17 +85,36 @@ mitk::DICOMDatasetAccessingImageFrameList mitk::DICOMGDCMTagCache::GetFrameInfoL
 void
 mitk::DICOMGDCMTagCache::InitCache(const std::set<DICOMTag>& scannedTags, const std::shared_ptr<gdcm::Scanner>& scanner, const StringList& inputFiles)
 {
+  this->InitCache(scannedTags, { scanner }, { 0 }, inputFiles);
+}
+
+void
+mitk::DICOMGDCMTagCache::InitCache(const std::set<DICOMTag>& scannedTags, const std::vector<std::shared_ptr<gdcm::Scanner>>& scanners, const std::vector<std::size_t>& partitionBegins, const StringList& inputFiles)
+{
+  if (scanners.empty() || scanners.size() != partitionBegins.size())
+  {
+    mitkThrow() << "Invalid call to DICOMGDCMTagCache::InitCache(). Each partition of the input files needs exactly one scanner. "
+                << "Number of scanners: " << scanners.size() << "; number of partitions: " << partitionBegins.size();
+  }
+
   m_ScannedTags = scannedTags;
   m_InputFilenames = inputFiles;
-  m_Scanner = scanner;
+  m_Scanners = scanners;
+  m_Scanner = m_Scanners.front();
 
   m_ScanResult.clear();
   m_ScanResult.reserve(m_InputFilenames.size());
 
-  for (auto inputIter = m_InputFilenames.cbegin(); inputIter != m_InputFilenames.cend(); ++inputIter)
+  std::size_t partition = 0;
+  for (std::size_t fileIndex = 0; fileIndex < m_InputFilenames.size(); ++fileIndex)
   {
-    m_ScanResult.push_back(DICOMGDCMImageFrameInfo::New(DICOMImageFrameInfo::New(*inputIter, 0),
-      m_Scanner->GetMapping(inputIter->c_str())).GetPointer());
+    while (partition + 1 < partitionBegins.size() && partitionBegins[partition + 1] <= fileIndex)
+    {
+      ++partition;
+    }
+
+    m_ScanResult.push_back(DICOMGDCMImageFrameInfo::New(DICOMImageFrameInfo::New(m_InputFilenames[fileIndex], 0),
+      m_Scanners[partition]->GetMapping(m_InputFilenames[fileIndex].c_str())).GetPointer());
   }
 }
 
@@ -102,3 +123,9 @@ mitk::DICOMGDCMTagCache::GetScanner() const
 {
   return *(this->m_Scanner);
 }
+
+const std::vector<std::shared_ptr<gdcm::Scanner>>&
+mitk::DICOMGDCMTagCache::GetScanners() const
+{
+  return this->m_Scanners;
+}
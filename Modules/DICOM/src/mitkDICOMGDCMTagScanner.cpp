@@ -13,9 +13,12 @@ found in the LICENSE file.
 #include "mitkDICOMGDCMTagScanner.h"
 #include "mitkDICOMGDCMTagCache.h"
 #include "mitkDICOMGDCMImageFrameInfo.h"
+#include "mitkDICOMPersistentTagCache.h"
 
 #include <gdcmScanner.h>
 
+#include <algorithm>
+
 mitk::DICOMGDCMTagScanner::DICOMGDCMTagScanner()
 {
   m_GDCMScanner = std::make_shared<gdcm::Scanner>();
@@ -89,16 +92,140 @@ void mitk::DICOMGDCMTagScanner::SetInputFiles( const StringList& filenames )
   m_InputFilenames = filenames;
 }
 
+void mitk::DICOMGDCMTagScanner::SetPersistentTagIndex( DICOMPersistentTagIndex* index )
+{
+  m_PersistentTagIndex = index;
+}
+
+mitk::DICOMPersistentTagIndex* mitk::DICOMGDCMTagScanner::GetPersistentTagIndex() const
+{
+  return m_PersistentTagIndex;
+}
+
+
+mitk::DICOMGDCMTagCache::Pointer mitk::DICOMGDCMTagScanner::ScanFiles(const StringList& filenames)
+{
+  DICOMGDCMTagCache::Pointer newCache = DICOMGDCMTagCache::New();
+
+  const auto numberOfWorkers = this->GetEffectiveNumberOfWorkers(filenames.size());
+
+  if (numberOfWorkers < 2)
+  {
+    m_GDCMScanner->Scan( filenames );
+    newCache->InitCache(m_ScannedTags, m_GDCMScanner, filenames);
+  }
+  else
+  {
+    // Scan consecutive partitions of the input files with independent gdcm::Scanner instances.
+    // Several partitions per worker keep all workers busy if some files (e.g. on a slow share)
+    // take longer than others.
+    const std::size_t numberOfPartitions = std::min<std::size_t>(filenames.size(), 4 * numberOfWorkers);
+    const std::size_t partitionSize = (filenames.size() + numberOfPartitions - 1) / numberOfPartitions;
+
+    std::vector<std::size_t> partitionBegins;
+    for (std::size_t begin = 0; begin < filenames.size(); begin += partitionSize)
+    {
+      partitionBegins.push_back(begin);
+    }
+
+    std::vector<std::shared_ptr<gdcm::Scanner>> scanners(partitionBegins.size());
+
+    this->ProcessJobs(partitionBegins.size(), [&](std::size_t partition)
+    {
+      const auto begin = filenames.cbegin() + partitionBegins[partition];
+      const auto end = filenames.cbegin() + std::min(partitionBegins[partition] + partitionSize, filenames.size());
+
+      auto scanner = std::make_shared<gdcm::Scanner>();
+      for (const auto& tag : m_ScannedTags)
+      {
+        scanner->AddTag(gdcm::Tag(tag.GetGroup(), tag.GetElement()));
+      }
+
+      scanner->Scan(gdcm::Directory::FilenamesType(begin, end));
+      scanners[partition] = scanner;
+    });
+
+    newCache->InitCache(m_ScannedTags, scanners, partitionBegins, filenames);
+  }
+
+  return newCache;
+}
 
 void mitk::DICOMGDCMTagScanner::Scan()
 {
   // TODO integrate push/pop locale??
-  m_GDCMScanner->Scan( m_InputFilenames );
+  if (m_PersistentTagIndex.IsNull())
+  {
+    m_Cache = this->ScanFiles(m_InputFilenames).GetPointer();
+    return;
+  }
 
-  DICOMGDCMTagCache::Pointer newCache = DICOMGDCMTagCache::New();
-  newCache->InitCache(m_ScannedTags, m_GDCMScanner, m_InputFilenames);
+  // only parse the headers of files without valid record in the index
+  std::vector<DICOMPersistentTagIndex::FileRecordConstPointer> records(m_InputFilenames.size());
+  StringList filesToScan;
+  std::vector<std::size_t> indicesToScan;
+
+  // size and modification time before the scan, so files changed during the scan are not stored as up to date
+  std::vector<std::uint64_t> fileSizes;
+  std::vector<std::int64_t> modificationTimes;
+  std::vector<bool> validStamps;
+
+  for (std::size_t fileIndex = 0; fileIndex < m_InputFilenames.size(); ++fileIndex)
+  {
+    records[fileIndex] = m_PersistentTagIndex->Lookup(m_InputFilenames[fileIndex], m_ScannedTags);
+    if (nullptr == records[fileIndex])
+    {
+      std::uint64_t fileSize = 0;
+      std::int64_t modificationTime = 0;
+      validStamps.push_back(DICOMPersistentTagIndex::GetFileStamp(m_InputFilenames[fileIndex], fileSize, modificationTime));
+      fileSizes.push_back(fileSize);
+      modificationTimes.push_back(modificationTime);
+
+      filesToScan.push_back(m_InputFilenames[fileIndex]);
+      indicesToScan.push_back(fileIndex);
+    }
+  }
+
+  MITK_DEBUG << "DICOMGDCMTagScanner: " << m_InputFilenames.size() - filesToScan.size() << " of " << m_InputFilenames.size()
+             << " files found in persistent tag index.";
+
+  if (!filesToScan.empty())
+  {
+    const auto scannedFrames = this->ScanFiles(filesToScan)->GetFrameInfoList();
+
+    for (std::size_t i = 0; i < indicesToScan.size(); ++i)
+    {
+      std::map<DICOMTag, std::string> values;
+      for (const auto& tag : m_ScannedTags)
+      {
+        const auto finding = scannedFrames[i]->GetTagValueAsString(tag);
+        if (finding.isValid)
+        {
+          values.emplace(tag, finding.value);
+        }
+      }
+
+      if (validStamps[i])
+      {
+        records[indicesToScan[i]] = m_PersistentTagIndex->Store(filesToScan[i], fileSizes[i], modificationTimes[i], m_ScannedTags, values);
+      }
+    }
+
+    try
+    {
+      m_PersistentTagIndex->Save();
+    }
+    catch (const std::exception& e)
+    {
+      // the scan result is valid anyway, only the next scan will not profit
+      MITK_WARN << "Cannot save persistent DICOM tag index. " << e.what();
+    }
+  }
+
+  DICOMPersistentTagCache::Pointer newCache = DICOMPersistentTagCache::New();
+  newCache->InitCache(m_ScannedTags, records, m_InputFilenames);
 
-  m_Cache = newCache;
+  m_Cache = newCache.GetPointer();
 }
 
 mitk::DICOMTagCache::Pointer
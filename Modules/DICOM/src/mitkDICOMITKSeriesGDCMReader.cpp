@@ -30,6 +30,7 @@ mitk::DICOMITKSeriesGDCMReader::DICOMITKSeriesGDCMReader( unsigned int decimalPl
 , m_SimpleVolumeReading( simpleVolumeImport )
 , m_DecimalPlacesForOrientation( decimalPlacesForOrientation )
 , m_ExternalCache(false)
+, m_NumberOfTagScannerWorkers(1)
 {
   this->EnsureMandatorySortersArePresent( decimalPlacesForOrientation, simpleVolumeImport );
 }
@@ -48,6 +49,8 @@ mitk::DICOMITKSeriesGDCMReader::DICOMITKSeriesGDCMReader( const DICOMITKSeriesGD
 , m_DecimalPlacesForOrientation( other.m_DecimalPlacesForOrientation )
 , m_TagCache( other.m_TagCache )
 , m_ExternalCache(other.m_ExternalCache)
+, m_NumberOfTagScannerWorkers(other.m_NumberOfTagScannerWorkers)
+, m_PersistentTagIndex(other.m_PersistentTagIndex)
 {
 }
 
@@ -71,6 +74,8 @@ mitk::DICOMITKSeriesGDCMReader& mitk::DICOMITKSeriesGDCMReader::
     this->m_ReplacedCinLocales               = other.m_ReplacedCinLocales;
     this->m_DecimalPlacesForOrientation      = other.m_DecimalPlacesForOrientation;
     this->m_TagCache                         = other.m_TagCache;
+    this->m_NumberOfTagScannerWorkers        = other.m_NumberOfTagScannerWorkers;
+    this->m_PersistentTagIndex               = other.m_PersistentTagIndex;
   }
   return *this;
 }
@@ -239,6 +244,8 @@ void mitk::DICOMITKSeriesGDCMReader::AnalyzeInputFiles()
 
     filescanner->SetInputFiles( inputFilenames );
     filescanner->AddTagPaths( this->GetTagsOfInterest() );
+    filescanner->SetNumberOfWorkers( m_NumberOfTagScannerWorkers );
+    filescanner->SetPersistentTagIndex( m_PersistentTagIndex );
 
     PushLocale();
     filescanner->Scan();
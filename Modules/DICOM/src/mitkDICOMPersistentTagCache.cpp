@@ -0,0 +1,117 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkDICOMPersistentTagCache.h"
+#include "mitkDICOMGDCMImageFrameInfo.h"
+
+#include <mitkExceptionMacro.h>
+
+#include <algorithm>
+
+mitk::DICOMPersistentTagCache::DICOMPersistentTagCache()
+{
+}
+
+mitk::DICOMPersistentTagCache::~DICOMPersistentTagCache()
+{
+}
+
+mitk::DICOMDatasetFinding mitk::DICOMPersistentTagCache::GetTagValue( DICOMImageFrameInfo* frame, const DICOMTag& tag ) const
+{
+  assert( frame );
+
+  for ( auto frameIter = m_ScanResult.cbegin(); frameIter != m_ScanResult.cend(); ++frameIter )
+  {
+    if ( **frameIter == *frame )
+    {
+      return (*frameIter)->GetTagValueAsString(tag);
+    }
+  }
+
+  if ( m_ScannedTags.find( tag ) == m_ScannedTags.cend() )
+  {
+    // callers are required to tell us about the tags they are interested in
+    std::stringstream errorstring;
+    errorstring << "Invalid call to DICOMPersistentTagCache::GetTagValue( ";
+    tag.Print( errorstring );
+    errorstring << " ). Tag was never mentioned before!";
+    MITK_ERROR << errorstring.str();
+    throw std::invalid_argument( errorstring.str() );
+  }
+
+  if ( std::find( m_InputFilenames.cbegin(), m_InputFilenames.cend(), frame->Filename ) == m_InputFilenames.cend() )
+  {
+    // callers are required to tell us about the filenames they are interested in
+    std::stringstream errorstring;
+    errorstring << "Invalid call to DICOMPersistentTagCache::GetTagValue( "
+                << "'" << frame->Filename << "', frame " << frame->FrameNo
+                << " ). Filename was never mentioned before!";
+    MITK_ERROR << errorstring.str();
+    throw std::invalid_argument( errorstring.str() );
+  }
+
+  return DICOMDatasetFinding();
+}
+
+mitk::DICOMDatasetAccess::FindingsListType
+mitk::DICOMPersistentTagCache::GetTagValue(DICOMImageFrameInfo* frame, const DICOMTagPath& path) const
+{
+  FindingsListType result;
+  if (path.Size() == 1 && path.IsExplicit())
+  {
+    result.push_back(this->GetTagValue(frame, path.GetFirstNode().tag));
+  }
+  return result;
+}
+
+mitk::DICOMDatasetAccessingImageFrameList mitk::DICOMPersistentTagCache::GetFrameInfoList() const
+{
+  return m_ScanResult;
+}
+
+void
+mitk::DICOMPersistentTagCache::InitCache(const std::set<DICOMTag>& scannedTags, const std::vector<DICOMPersistentTagIndex::FileRecordConstPointer>& records, const StringList& inputFiles)
+{
+  if (records.size() != inputFiles.size())
+  {
+    mitkThrow() << "Invalid call to DICOMPersistentTagCache::InitCache(). Each input file needs exactly one record. "
+                << "Number of records: " << records.size() << "; number of input files: " << inputFiles.size();
+  }
+
+  m_ScannedTags = scannedTags;
+  m_InputFilenames = inputFiles;
+  m_Records = records;
+
+  m_ScanResult.clear();
+  m_ScanResult.reserve(m_InputFilenames.size());
+
+  for (std::size_t fileIndex = 0; fileIndex < m_InputFilenames.size(); ++fileIndex)
+  {
+    // Offer the values like gdcm::Scanner does, so that the frame infos behave
+    // exactly like the ones of DICOMGDCMTagCache.
+    gdcm::Scanner::TagToValue mapping;
+
+    if (nullptr != m_Records[fileIndex])
+    {
+      for (const auto& value : m_Records[fileIndex]->Values)
+      {
+        if (m_ScannedTags.find(value.first) != m_ScannedTags.cend())
+        {
+          mapping[gdcm::Tag(value.first.GetGroup(), value.first.GetElement())] = value.second.c_str();
+        }
+      }
+    }
+
+    m_ScanResult.push_back(DICOMGDCMImageFrameInfo::New(DICOMImageFrameInfo::New(m_InputFilenames[fileIndex], 0),
+      mapping).GetPointer());
+  }
+}
@@ -0,0 +1,335 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkDICOMPersistentTagIndex.h"
+
+#include <mitkExceptionMacro.h>
+#include <mitkFileSystem.h>
+#include <mitkLog.h>
+
+#include <algorithm>
+#include <fstream>
+
+namespace
+{
+  /** Identifies the index file format. Has to be changed whenever the layout changes.*/
+  const char IndexFileMagic[8] = { 'M', 'I', 'T', 'K', 'D', 'T', 'I', '1' };
+
+  template <typename T>
+  void WriteValue(std::ostream& stream, T value)
+  {
+    stream.write(reinterpret_cast<const char*>(&value), sizeof(T));
+  }
+
+  template <typename T>
+  bool ReadValue(std::istream& stream, T& value)
+  {
+    stream.read(reinterpret_cast<char*>(&value), sizeof(T));
+    return stream.good();
+  }
+
+  void WriteString(std::ostream& stream, const std::string& value)
+  {
+    WriteValue(stream, static_cast<std::uint32_t>(value.size()));
+    stream.write(value.data(), value.size());
+  }
+
+  /** Reads a string, whose size is checked against the end of the stream (streamLength) before anything is allocated.*/
+  bool ReadString(std::istream& stream, std::uint64_t streamLength, std::string& value)
+  {
+    std::uint32_t size = 0;
+    if (!ReadValue(stream, size))
+      return false;
+
+    const auto position = stream.tellg();
+    if (position < 0 || static_cast<std::uint64_t>(position) + size > streamLength)
+      return false;
+
+    value.resize(size);
+    stream.read(&value[0], size);
+    return stream.good() || (0 == size && !stream.bad());
+  }
+
+  void WriteTag(std::ostream& stream, const mitk::DICOMTag& tag)
+  {
+    WriteValue(stream, static_cast<std::uint16_t>(tag.GetGroup()));
+    WriteValue(stream, static_cast<std::uint16_t>(tag.GetElement()));
+  }
+
+  bool ReadTag(std::istream& stream, mitk::DICOMTag& tag)
+  {
+    std::uint16_t group = 0;
+    std::uint16_t element = 0;
+    if (!ReadValue(stream, group) || !ReadValue(stream, element))
+      return false;
+
+    tag = mitk::DICOMTag(group, element);
+    return true;
+  }
+}
+
+mitk::DICOMPersistentTagIndex::DICOMPersistentTagIndex(const std::string& indexFile)
+  : m_IndexFile(indexFile), m_Dirty(false)
+{
+}
+
+mitk::DICOMPersistentTagIndex::~DICOMPersistentTagIndex()
+{
+}
+
+std::string mitk::DICOMPersistentTagIndex::GetIndexFile() const
+{
+  return m_IndexFile;
+}
+
+bool mitk::DICOMPersistentTagIndex::GetFileStamp(const std::string& filename, std::uint64_t& fileSize, std::int64_t& modificationTime)
+{
+  std::error_code errorCode;
+
+  const auto size = fs::file_size(filename, errorCode);
+  if (errorCode)
+    return false;
+
+  const auto time = fs::last_write_time(filename, errorCode);
+  if (errorCode)
+    return false;
+
+  fileSize = static_cast<std::uint64_t>(size);
+  modificationTime = static_cast<std::int64_t>(time.time_since_epoch().count());
+  return true;
+}
+
+std::string mitk::DICOMPersistentTagIndex::GetKey(const std::string& filename)
+{
+  std::error_code errorCode;
+  const auto absolutePath = fs::absolute(filename, errorCode);
+
+  return errorCode ? filename : absolutePath.string();
+}
+
+bool mitk::DICOMPersistentTagIndex::Load()
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+
+  m_Records.clear();
+  m_Dirty = false;
+
+  std::ifstream stream(m_IndexFile, std::ios::binary | std::ios::ate);
+  if (!stream.is_open())
+    return false;
+
+  const auto streamEnd = stream.tellg();
+  stream.seekg(0);
+  const std::uint64_t streamLength = streamEnd < 0 ? 0 : static_cast<std::uint64_t>(streamEnd);
+
+  char magic[sizeof(IndexFileMagic)];
+  std::uint64_t numberOfRecords = 0;
+
+  stream.read(magic, sizeof(magic));
+  if (!stream.good() || !std::equal(magic, magic + sizeof(magic), IndexFileMagic) || !ReadValue(stream, numberOfRecords))
+  {
+    MITK_WARN << "Ignoring DICOM tag index file with unknown format: " << m_IndexFile;
+    return false;
+  }
+
+  std::map<std::string, FileRecordConstPointer> records;
+  DICOMTag tag(0, 0);
+
+  for (std::uint64_t i = 0; i < numberOfRecords; ++i)
+  {
+    std::string key;
+    auto record = std::make_shared<FileRecord>();
+    std::uint32_t numberOfScannedTags = 0;
+    std::uint32_t numberOfValues = 0;
+
+    bool valid = ReadString(stream, streamLength, key) && ReadValue(stream, record->FileSize) && ReadValue(stream, record->ModificationTime)
+                 && ReadValue(stream, numberOfScannedTags);
+
+    for (std::uint32_t j = 0; valid && j < numberOfScannedTags; ++j)
+    {
+      valid = ReadTag(stream, tag);
+      record->ScannedTags.insert(tag);
+    }
+
+    valid = valid && ReadValue(stream, numberOfValues);
+
+    for (std::uint32_t j = 0; valid && j < numberOfValues; ++j)
+    {
+      std::string value;
+      valid = ReadTag(stream, tag) && ReadString(stream, streamLength, value);
+      record->Values.emplace(tag, value);
+    }
+
+    if (!valid)
+    {
+      MITK_WARN << "Ignoring corrupted DICOM tag index file: " << m_IndexFile;
+      return false;
+    }
+
+    records.emplace(key, record);
+  }
+
+  m_Records.swap(records);
+  return true;
+}
+
+void mitk::DICOMPersistentTagIndex::Save()
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+
+  if (!m_Dirty)
+    return;
+
+  const std::string tempFile = m_IndexFile + ".tmp";
+
+  {
+    std::ofstream stream(tempFile, std::ios::binary | std::ios::trunc);
+    if (!stream.is_open())
+    {
+      mitkThrow() << "Cannot write DICOM tag index file: " << tempFile;
+    }
+
+    stream.write(IndexFileMagic, sizeof(IndexFileMagic));
+    WriteValue(stream, static_cast<std::uint64_t>(m_Records.size()));
+
+    for (const auto& entry : m_Records)
+    {
+      const auto& record = *(entry.second);
+
+      WriteString(stream, entry.first);
+      WriteValue(stream, record.FileSize);
+      WriteValue(stream, record.ModificationTime);
+
+      WriteValue(stream, static_cast<std::uint32_t>(record.ScannedTags.size()));
+      for (const auto& tag : record.ScannedTags)
+      {
+        WriteTag(stream, tag);
+      }
+
+      WriteValue(stream, static_cast<std::uint32_t>(record.Values.size()));
+      for (const auto& value : record.Values)
+      {
+        WriteTag(stream, value.first);
+        WriteString(stream, value.second);
+      }
+    }
+
+    if (!stream.good())
+    {
+      mitkThrow() << "Error while writing DICOM tag index file: " << tempFile;
+    }
+  }
+
+  std::error_code errorCode;
+  fs::rename(tempFile, m_IndexFile, errorCode);
+  if (errorCode)
+  {
+    mitkThrow() << "Cannot replace DICOM tag index file " << m_IndexFile << ": " << errorCode.message();
+  }
+
+  m_Dirty = false;
+}
+
+mitk::DICOMPersistentTagIndex::FileRecordConstPointer
+mitk::DICOMPersistentTagIndex::Lookup(const std::string& filename, const std::set<DICOMTag>& tags) const
+{
+  std::uint64_t fileSize = 0;
+  std::int64_t modificationTime = 0;
+
+  if (!GetFileStamp(filename, fileSize, modificationTime))
+    return nullptr;
+
+  const auto key = GetKey(filename);
+
+  std::lock_guard<std::mutex> lock(m_Mutex);
+
+  const auto finding = m_Records.find(key);
+  if (finding == m_Records.cend())
+    return nullptr;
+
+  const auto& record = finding->second;
+  if (record->FileSize != fileSize || record->ModificationTime != modificationTime)
+    return nullptr;
+
+  if (!std::includes(record->ScannedTags.cbegin(), record->ScannedTags.cend(), tags.cbegin(), tags.cend()))
+    return nullptr;
+
+  return record;
+}
+
+mitk::DICOMPersistentTagIndex::FileRecordConstPointer
+mitk::DICOMPersistentTagIndex::Store(const std::string& filename, const std::set<DICOMTag>& tags, const std::map<DICOMTag, std::string>& values)
+{
+  std::uint64_t fileSize = 0;
+  std::int64_t modificationTime = 0;
+
+  if (!GetFileStamp(filename, fileSize, modificationTime))
+    return nullptr;
+
+  return this->Store(filename, fileSize, modificationTime, tags, values);
+}
+
+mitk::DICOMPersistentTagIndex::FileRecordConstPointer
+mitk::DICOMPersistentTagIndex::Store(const std::string& filename,
+                                     std::uint64_t fileSize,
+                                     std::int64_t modificationTime,
+                                     const std::set<DICOMTag>& tags,
+                                     const std::map<DICOMTag, std::string>& values)
+{
+  auto record = std::make_shared<FileRecord>();
+  record->FileSize = fileSize;
+  record->ModificationTime = modificationTime;
+  record->ScannedTags = tags;
+  record->Values = values;
+
+  const auto key = GetKey(filename);
+
+  std::lock_guard<std::mutex> lock(m_Mutex);
+
+  auto& storedRecord = m_Records[key];
+
+  if (nullptr != storedRecord && storedRecord->FileSize == record->FileSize && storedRecord->ModificationTime == record->ModificationTime)
+  {
+    // keep the values of tags that were not scanned this time
+    for (const auto& tag : storedRecord->ScannedTags)
+    {
+      if (record->ScannedTags.insert(tag).second)
+      {
+        const auto value = storedRecord->Values.find(tag);
+        if (value != storedRecord->Values.cend())
+        {
+          record->Values.insert(*value);
+        }
+      }
+    }
+  }
+
+  storedRecord = record;
+  m_Dirty = true;
+
+  return record;
+}
+
+void mitk::DICOMPersistentTagIndex::Clear()
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+
+  m_Dirty = m_Dirty || !m_Records.empty();
+  m_Records.clear();
+}
+
+std::size_t mitk::DICOMPersistentTagIndex::GetNumberOfRecords() const
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+
+  return m_Records.size();
+}
@@ -12,9 +12,15 @@ found in the LICENSE file.
 
 #include "mitkDICOMTagScanner.h"
 
+#include <itkMultiThreaderBase.h>
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+
 std::mutex mitk::DICOMTagScanner::s_LocaleMutex;
 
-mitk::DICOMTagScanner::DICOMTagScanner()
+mitk::DICOMTagScanner::DICOMTagScanner() : m_NumberOfWorkers(1)
 {
 }
 
@@ -70,3 +76,61 @@ std::string mitk::DICOMTagScanner::GetActiveLocale()
 {
   return setlocale(LC_NUMERIC, nullptr);
 }
+
+unsigned int mitk::DICOMTagScanner::GetEffectiveNumberOfWorkers(std::size_t numberOfJobs) const
+{
+  std::size_t numberOfWorkers = m_NumberOfWorkers;
+
+  if (0 == numberOfWorkers)
+  {
+    numberOfWorkers = std::max(1u, itk::MultiThreaderBase::GetGlobalDefaultNumberOfThreads());
+  }
+
+  return static_cast<unsigned int>(std::max<std::size_t>(1, std::min(numberOfWorkers, numberOfJobs)));
+}
+
+void mitk::DICOMTagScanner::ProcessJobs(std::size_t numberOfJobs, const std::function<void(std::size_t)>& job) const
+{
+  const auto numberOfWorkers = this->GetEffectiveNumberOfWorkers(numberOfJobs);
+
+  std::atomic<std::size_t> nextJob(0);
+  std::exception_ptr firstException;
+  std::mutex exceptionMutex;
+
+  auto worker = [&](itk::SizeValueType)
+  {
+    for (std::size_t jobIndex = nextJob++; jobIndex < numberOfJobs; jobIndex = nextJob++)
+    {
+      try
+      {
+        job(jobIndex);
+      }
+      catch (...)
+      {
+        std::lock_guard<std::mutex> lock(exceptionMutex);
+        if (!firstException)
+        {
+          firstException = std::current_exception();
+        }
+        nextJob = numberOfJobs;
+      }
+    }
+  };
+
+  if (1 == numberOfWorkers)
+  {
+    worker(0);
+  }
+  else
+  {
+    // every work unit takes jobs until none are left, so slow files do not hold up a fixed share of the input
+    auto multiThreader = itk::MultiThreaderBase::New();
+    multiThreader->SetNumberOfWorkUnits(numberOfWorkers);
+    multiThreader->ParallelizeArray(0, numberOfWorkers, worker, nullptr);
+  }
+
+  if (firstException)
+  {
+    std::rethrow_exception(firstException);
+  }
+}
@@ -24,6 +24,7 @@ class mitkDICOMDCMTKTagScannerTestSuite : public mitk::TestFixture
 
   MITK_TEST(DeepScanning);
   MITK_TEST(MultiFileScanning);
+  MITK_TEST(ParallelScanning);
 
   CPPUNIT_TEST_SUITE_END();
 
@@ -119,6 +120,51 @@ public:
     CPPUNIT_ASSERT_MESSAGE("Testing value of instance uid finding of frame 3", findings.front().value == "1.2.276.0.99.1.4.8323329.3795.1303917947.940055");
   }
 
+  void ParallelScanning()
+  {
+    mitk::DICOMTagPath instanceUID(0x0008, 0x0018);
+    mitk::DICOMTagPath imagePosition(0x0020, 0x0032);
+
+    mitk::StringList files = ctFiles;
+    files.push_back(GetTestDataFilePath("RT/Dose/RD.dcm"));
+    files.push_back(GetTestDataFilePath("TinyCTAbdomen/103"));
+
+    scanner->SetInputFiles(files);
+    scanner->AddTagPath(instanceUID);
+    scanner->AddTagPath(imagePosition);
+    scanner->Scan();
+
+    mitk::DICOMDatasetAccessingImageFrameList serialFrames = scanner->GetFrameInfoList();
+
+    for (unsigned int numberOfWorkers : { 0u, 2u, 3u, 16u })
+    {
+      scanner->SetNumberOfWorkers(numberOfWorkers);
+      scanner->Scan();
+
+      mitk::DICOMDatasetAccessingImageFrameList frames = scanner->GetFrameInfoList();
+      CPPUNIT_ASSERT_EQUAL_MESSAGE("Testing number of frames of parallel scan", serialFrames.size(), frames.size());
+
+      for (std::size_t i = 0; i < frames.size(); ++i)
+      {
+        CPPUNIT_ASSERT_EQUAL_MESSAGE("Testing frame order of parallel scan", serialFrames[i]->GetFilenameIfAvailable(), frames[i]->GetFilenameIfAvailable());
+
+        for (const auto& path : { instanceUID, imagePosition })
+        {
+          auto serialFindings = serialFrames[i]->GetTagValueAsString(path);
+          auto findings = frames[i]->GetTagValueAsString(path);
+          CPPUNIT_ASSERT_EQUAL_MESSAGE("Testing number of findings of parallel scan", serialFindings.size(), findings.size());
+
+          for (auto serialIter = serialFindings.cbegin(), iter = findings.cbegin(); iter != findings.cend(); ++serialIter, ++iter)
+          {
+            CPPUNIT_ASSERT_MESSAGE("Testing validity of finding of parallel scan", serialIter->isValid == iter->isValid);
+            CPPUNIT_ASSERT_MESSAGE("Testing path of finding of parallel scan", serialIter->path == iter->path);
+            CPPUNIT_ASSERT_EQUAL_MESSAGE("Testing value of finding of parallel scan", serialIter->value, iter->value);
+          }
+        }
+      }
+    }
+  }
+
 };
 
 MITK_TEST_SUITE_REGISTRATION(mitkDICOMDCMTKTagScanner)
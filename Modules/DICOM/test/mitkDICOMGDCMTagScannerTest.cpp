@@ -0,0 +1,275 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkDICOMGDCMTagScanner.h"
+#include "mitkDICOMPersistentTagCache.h"
+
+#include "mitkFileSystem.h"
+#include "mitkIOUtil.h"
+#include "mitkTestFixture.h"
+#include "mitkTestingMacros.h"
+
+#include <itksys/SystemTools.hxx>
+
+#include <fstream>
+
+class mitkDICOMGDCMTagScannerTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkDICOMGDCMTagScannerTestSuite);
+
+  MITK_TEST(MultiFileScanning);
+  MITK_TEST(ParallelScanning);
+  MITK_TEST(PersistentTagIndexScanning);
+  MITK_TEST(PersistentTagIndexDetectsChangedFiles);
+  MITK_TEST(PersistentTagIndexStoresStampBeforeScan);
+  MITK_TEST(PersistentTagIndexRejectsCorruptedFile);
+
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+
+  mitk::DICOMGDCMTagScanner::Pointer scanner;
+
+  mitk::StringList ctFiles;
+
+  mitk::DICOMTag instanceUID = mitk::DICOMTag(0x0008, 0x0018);
+  mitk::DICOMTag imagePosition = mitk::DICOMTag(0x0020, 0x0032);
+
+  std::string tempDirectory;
+
+  void AssertEqualFrames(const mitk::DICOMDatasetAccessingImageFrameList& expectedFrames, const mitk::DICOMDatasetAccessingImageFrameList& frames)
+  {
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Testing number of frames", expectedFrames.size(), frames.size());
+
+    for (std::size_t i = 0; i < frames.size(); ++i)
+    {
+      CPPUNIT_ASSERT_EQUAL_MESSAGE("Testing frame order", expectedFrames[i]->GetFilenameIfAvailable(), frames[i]->GetFilenameIfAvailable());
+
+      for (const auto& tag : { instanceUID, imagePosition })
+      {
+        auto expectedFinding = expectedFrames[i]->GetTagValueAsString(tag);
+        auto finding = frames[i]->GetTagValueAsString(tag);
+
+        CPPUNIT_ASSERT_MESSAGE("Testing validity of finding", expectedFinding.isValid == finding.isValid);
+        CPPUNIT_ASSERT_EQUAL_MESSAGE("Testing value of finding", expectedFinding.value, finding.value);
+      }
+    }
+  }
+
+public:
+
+  void setUp() override
+  {
+    ctFiles.clear();
+    ctFiles.push_back(GetTestDataFilePath("TinyCTAbdomen/100"));
+    ctFiles.push_back(GetTestDataFilePath("TinyCTAbdomen/101"));
+    ctFiles.push_back(GetTestDataFilePath("TinyCTAbdomen/102"));
+    ctFiles.push_back(GetTestDataFilePath("TinyCTAbdomen/104"));
+    ctFiles.push_back(GetTestDataFilePath("TinyCTAbdomen/103"));
+
+    scanner = mitk::DICOMGDCMTagScanner::New();
+    scanner->AddTag(instanceUID);
+    scanner->AddTag(imagePosition);
+
+    tempDirectory = mitk::IOUtil::CreateTemporaryDirectory("mitkDICOMGDCMTagScannerTest_XXXXXX");
+  }
+
+  void tearDown() override
+  {
+    itksys::SystemTools::RemoveADirectory(tempDirectory);
+  }
+
+  void MultiFileScanning()
+  {
+    scanner->SetInputFiles(ctFiles);
+    scanner->Scan();
+
+    mitk::DICOMDatasetAccessingImageFrameList frames = scanner->GetFrameInfoList();
+    CPPUNIT_ASSERT_MESSAGE("Testing DICOMGDCMTagScanner::GetFrameInfoList()", frames.size() == 5);
+
+    mitk::DICOMDatasetFinding finding = frames[0]->GetTagValueAsString(instanceUID);
+    CPPUNIT_ASSERT_MESSAGE("Testing validity of instance uid finding of frame 0", finding.isValid);
+    CPPUNIT_ASSERT_MESSAGE("Testing value of instance uid finding of frame 0", finding.value == "1.2.276.0.99.1.4.8323329.3795.1303917947.940051");
+
+    finding = frames[3]->GetTagValueAsString(instanceUID);
+    CPPUNIT_ASSERT_MESSAGE("Testing validity of instance uid finding of frame 3", finding.isValid);
+    CPPUNIT_ASSERT_MESSAGE("Testing value of instance uid finding of frame 3", finding.value == "1.2.276.0.99.1.4.8323329.3795.1303917947.940055");
+  }
+
+  void ParallelScanning()
+  {
+    scanner->SetInputFiles(ctFiles);
+    scanner->Scan();
+
+    mitk::DICOMDatasetAccessingImageFrameList serialFrames = scanner->GetFrameInfoList();
+
+    for (unsigned int numberOfWorkers : { 0u, 2u, 3u, 16u })
+    {
+      // a new scanner per run, as the partial results must not depend on previous scans
+      auto parallelScanner = mitk::DICOMGDCMTagScanner::New();
+      parallelScanner->AddTag(instanceUID);
+      parallelScanner->AddTag(imagePosition);
+      parallelScanner->SetInputFiles(ctFiles);
+      parallelScanner->SetNumberOfWorkers(numberOfWorkers);
+      parallelScanner->Scan();
+
+      mitk::DICOMDatasetAccessingImageFrameList frames = parallelScanner->GetFrameInfoList();
+      AssertEqualFrames(serialFrames, frames);
+
+      for (std::size_t i = 0; i < frames.size(); ++i)
+      {
+        // the cache has to answer requests for the frames like the serial one
+        auto serialCacheFinding = scanner->GetTagValue(serialFrames[i], instanceUID);
+        auto cacheFinding = parallelScanner->GetTagValue(frames[i], instanceUID);
+        CPPUNIT_ASSERT_EQUAL_MESSAGE("Testing cache value of parallel scan", serialCacheFinding.value, cacheFinding.value);
+      }
+    }
+  }
+
+  void PersistentTagIndexScanning()
+  {
+    scanner->SetInputFiles(ctFiles);
+    scanner->Scan();
+    mitk::DICOMDatasetAccessingImageFrameList expectedFrames = scanner->GetFrameInfoList();
+
+    const std::string indexFile = tempDirectory + "/tagindex.bin";
+
+    // first scan fills and saves the index
+    auto index = mitk::DICOMPersistentTagIndex::New(indexFile);
+    CPPUNIT_ASSERT_MESSAGE("Testing Load() of not existing index file", !index->Load());
+
+    auto indexedScanner = mitk::DICOMGDCMTagScanner::New();
+    indexedScanner->AddTag(instanceUID);
+    indexedScanner->AddTag(imagePosition);
+    indexedScanner->SetInputFiles(ctFiles);
+    indexedScanner->SetPersistentTagIndex(index);
+    indexedScanner->Scan();
+
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Testing number of index records", ctFiles.size(), index->GetNumberOfRecords());
+    CPPUNIT_ASSERT_MESSAGE("Testing type of scan cache", nullptr != dynamic_cast<mitk::DICOMPersistentTagCache*>(indexedScanner->GetScanCache().GetPointer()));
+    AssertEqualFrames(expectedFrames, indexedScanner->GetFrameInfoList());
+
+    // second scan (new session) only uses the index
+    auto reloadedIndex = mitk::DICOMPersistentTagIndex::New(indexFile);
+    CPPUNIT_ASSERT_MESSAGE("Testing Load() of saved index file", reloadedIndex->Load());
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Testing number of loaded index records", ctFiles.size(), reloadedIndex->GetNumberOfRecords());
+
+    std::set<mitk::DICOMTag> tags = { instanceUID, imagePosition };
+    for (const auto& file : ctFiles)
+    {
+      CPPUNIT_ASSERT_MESSAGE("Testing Lookup() of unchanged file", nullptr != reloadedIndex->Lookup(file, tags));
+    }
+    tags.insert(mitk::DICOMTag(0x0020, 0x0013));
+    CPPUNIT_ASSERT_MESSAGE("Testing Lookup() with tags that were not scanned", nullptr == reloadedIndex->Lookup(ctFiles.front(), tags));
+
+    indexedScanner = mitk::DICOMGDCMTagScanner::New();
+    indexedScanner->AddTag(instanceUID);
+    indexedScanner->AddTag(imagePosition);
+    indexedScanner->SetInputFiles(ctFiles);
+    indexedScanner->SetPersistentTagIndex(reloadedIndex);
+    indexedScanner->Scan();
+
+    AssertEqualFrames(expectedFrames, indexedScanner->GetFrameInfoList());
+
+    auto cacheFinding = indexedScanner->GetTagValue(indexedScanner->GetFrameInfoList().front(), instanceUID);
+    CPPUNIT_ASSERT_MESSAGE("Testing cache value of indexed scan", cacheFinding.value == "1.2.276.0.99.1.4.8323329.3795.1303917947.940051");
+  }
+
+  void PersistentTagIndexDetectsChangedFiles()
+  {
+    const std::string file = tempDirectory + "/changing.dcm";
+    const std::set<mitk::DICOMTag> tags = { instanceUID };
+
+    {
+      std::ofstream stream(file, std::ios::binary);
+      stream << "first version";
+    }
+
+    auto index = mitk::DICOMPersistentTagIndex::New(tempDirectory + "/tagindex.bin");
+    index->Store(file, tags, { { instanceUID, "1.2.3" } });
+
+    auto record = index->Lookup(file, tags);
+    CPPUNIT_ASSERT_MESSAGE("Testing Lookup() of stored file", nullptr != record);
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Testing stored value", std::string("1.2.3"), record->Values.at(instanceUID));
+
+    {
+      std::ofstream stream(file, std::ios::binary | std::ios::trunc);
+      stream << "second, longer version";
+    }
+
+    CPPUNIT_ASSERT_MESSAGE("Testing Lookup() of changed file", nullptr == index->Lookup(file, tags));
+    CPPUNIT_ASSERT_MESSAGE("Testing Lookup() of not existing file", nullptr == index->Lookup(tempDirectory + "/missing.dcm", tags));
+  }
+
+  void PersistentTagIndexStoresStampBeforeScan()
+  {
+    const std::string file = tempDirectory + "/modified_during_scan.dcm";
+    const std::set<mitk::DICOMTag> tags = { instanceUID };
+
+    {
+      std::ofstream stream(file, std::ios::binary);
+      stream << "first version";
+    }
+
+    std::uint64_t fileSize = 0;
+    std::int64_t modificationTime = 0;
+    CPPUNIT_ASSERT_MESSAGE("Testing GetFileStamp()", mitk::DICOMPersistentTagIndex::GetFileStamp(file, fileSize, modificationTime));
+
+    // the file changes while it is scanned
+    {
+      std::ofstream stream(file, std::ios::binary | std::ios::trunc);
+      stream << "second, longer version";
+    }
+
+    auto index = mitk::DICOMPersistentTagIndex::New(tempDirectory + "/tagindex_stamp.bin");
+    index->Store(file, fileSize, modificationTime, tags, { { instanceUID, "1.2.3" } });
+
+    CPPUNIT_ASSERT_MESSAGE("Testing Lookup() of file modified during scan", nullptr == index->Lookup(file, tags));
+  }
+
+  void PersistentTagIndexRejectsCorruptedFile()
+  {
+    const std::string file = tempDirectory + "/indexed.dcm";
+    const std::string indexFile = tempDirectory + "/tagindex_corrupted.bin";
+    const std::set<mitk::DICOMTag> tags = { instanceUID };
+
+    {
+      std::ofstream stream(file, std::ios::binary);
+      stream << "content";
+    }
+
+    auto index = mitk::DICOMPersistentTagIndex::New(indexFile);
+    index->Store(file, tags, { { instanceUID, "1.2.3" } });
+    index->Save();
+
+    // replace the size of the first key by a huge value, the file is far too short for it
+    {
+      std::fstream stream(indexFile, std::ios::binary | std::ios::in | std::ios::out);
+      stream.seekp(8 + sizeof(std::uint64_t));
+      const std::uint32_t hugeSize = 0xFFFFFFF0;
+      stream.write(reinterpret_cast<const char*>(&hugeSize), sizeof(hugeSize));
+    }
+
+    auto reloadedIndex = mitk::DICOMPersistentTagIndex::New(indexFile);
+    CPPUNIT_ASSERT_MESSAGE("Testing Load() of corrupted index", !reloadedIndex->Load());
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Testing records of corrupted index", std::size_t(0), reloadedIndex->GetNumberOfRecords());
+
+    // a truncated index is rejected as well
+    index->Store(file, tags, { { instanceUID, "1.2.3.4" } });
+    index->Save();
+    fs::resize_file(indexFile, fs::file_size(indexFile) - 3);
+
+    CPPUNIT_ASSERT_MESSAGE("Testing Load() of truncated index", !reloadedIndex->Load());
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkDICOMGDCMTagScanner)
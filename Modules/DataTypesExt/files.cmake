@@ -12,6 +12,7 @@ set(CPP_FILES
   mitkColorSequenceCycleH.cpp
   mitkColorSequenceRainbow.cpp
   mitkCompressedImageContainer.cpp
+  mitkCompressedImageDiff.cpp
   mitkCone.cpp
   mitkCuboid.cpp
   mitkCylinder.cpp
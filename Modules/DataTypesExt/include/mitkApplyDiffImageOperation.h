@@ -81,6 +81,8 @@ namespace mitk
     Image::Pointer GetDiffImage();
 
     bool IsImageStillValid() { return m_ImageStillValid; }
+
+    std::size_t GetMemorySize() const override;
   };
 
 } // namespace mitk
@@ -16,14 +16,31 @@ found in the LICENSE file.
 #include <MitkDataTypesExtExports.h>
 #include <mitkImage.h>
 #include <array>
+#include <functional>
 #include <memory>
 #include <utility>
+#include <vector>
 
 namespace mitk
 {
+  /**
+    \brief Holds an LZ4 compressed copy of an image.
+
+    Every slice of every time step is compressed independently, so slices are compressed
+    and decompressed in parallel (see SetNumberOfThreads()). Slices that do not shrink
+    (e.g. noise) are stored raw, which makes both directions a plain copy for them.
+  */
   class MITKDATATYPESEXT_EXPORT CompressedImageContainer
   {
   public:
+    enum class Codec
+    {
+      /** Fast default LZ4 compression.*/
+      LZ4,
+      /** LZ4 high compression: considerably slower compression, smaller data, equally fast decompression.*/
+      LZ4HC
+    };
+
     CompressedImageContainer();
     ~CompressedImageContainer();
 
@@ -33,12 +50,39 @@ namespace mitk
     void CompressImage(const Image* image);
     Image::Pointer DecompressImage() const;
 
+    /** \brief Number of bytes of the compressed image data.*/
+    std::size_t GetCompressedSize() const;
+
+    /** \brief Codec used by CompressImage() (default: Codec::LZ4).*/
+    void SetCodec(Codec codec);
+    Codec GetCodec() const;
+
+    /** \brief Compression level of Codec::LZ4HC (default: LZ4HC_CLEVEL_DEFAULT, i.e. 9).*/
+    void SetCompressionLevel(int level);
+    int GetCompressionLevel() const;
+
+    /** \brief Number of threads used to (de)compress slices.
+      0 (default) uses the number of work units of the default ITK multi-threader, 1 disables parallelization.
+    */
+    void SetNumberOfThreads(unsigned int numberOfThreads);
+    unsigned int GetNumberOfThreads() const;
+
   private:
-    using CompressedSliceData = std::pair<int, char*>;
+    struct CompressedSliceData
+    {
+      /** Number of bytes of Data.*/
+      int Size = 0;
+      char* Data = nullptr;
+      /** Data is an uncompressed copy of the slice.*/
+      bool Raw = false;
+    };
+
     using CompressedTimeStepData = std::vector<CompressedSliceData>;
     using CompressedImageData = std::vector<CompressedTimeStepData>;
 
     void ClearCompressedImageData();
+    CompressedSliceData CompressSlice(const char* src, int numSliceBytes) const;
+    void ProcessSlices(std::size_t numberOfSlices, const std::function<void(std::size_t)>& processSlice) const;
 
     CompressedImageData m_CompressedImageData;
 
@@ -46,6 +90,10 @@ namespace mitk
     TimeGeometry::Pointer m_TimeGeometry;
     std::array<unsigned int, 2> m_SliceDimensions;
     unsigned int m_Dimension;
+
+    Codec m_Codec;
+    int m_CompressionLevel;
+    unsigned int m_NumberOfThreads;
   };
 }
 
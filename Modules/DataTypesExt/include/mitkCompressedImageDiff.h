@@ -0,0 +1,88 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef mitkCompressedImageDiff_h
+#define mitkCompressedImageDiff_h
+
+#include <MitkDataTypesExtExports.h>
+#include <mitkImage.h>
+
+#include <cstddef>
+#include <vector>
+
+namespace mitk
+{
+  /**
+    \brief Sparse difference between two images of equal size and pixel type.
+
+    The difference is stored as the XOR of the image buffers, restricted to runs of
+    changed bytes. Runs that are separated by only a few unchanged bytes are merged.
+    The XOR bytes of all runs are compressed with LZ4 if that saves memory, which is
+    the case for typical segmentation edits (many pixels changed to the same label).
+
+    As XOR is its own inverse, ApplyDiff() converts either of the two images into the
+    other one. Thus, a single diff serves as undo and redo information of an edit,
+    as long as it is applied to the current state of the image.
+
+    \ingroup Undo
+  */
+  class MITKDATATYPESEXT_EXPORT CompressedImageDiff
+  {
+  public:
+    CompressedImageDiff();
+    ~CompressedImageDiff();
+
+    CompressedImageDiff(const CompressedImageDiff&) = delete;
+    CompressedImageDiff& operator=(const CompressedImageDiff&) = delete;
+
+    /**
+      \brief Computes the difference between the buffers of both images.
+      \throw mitk::Exception if an image is missing or the images differ in size or pixel type.
+    */
+    void ComputeDiff(const Image* reference, const Image* image);
+
+    /**
+      \brief Applies the difference to the buffer of the image in place.
+      \throw mitk::Exception if the image differs in size from the images of ComputeDiff().
+    */
+    void ApplyDiff(Image* image) const;
+
+    /** \brief True if both images were equal.*/
+    bool IsEmpty() const;
+
+    /** \brief Number of bytes covered by the stored runs (including merged gaps).*/
+    std::size_t GetNumberOfDiffBytes() const;
+
+    /** \brief Approximate number of bytes this object occupies in memory.*/
+    std::size_t GetMemorySize() const;
+
+  private:
+    struct Run
+    {
+      std::size_t Offset;
+      std::size_t Length;
+    };
+
+    void Clear();
+
+    std::vector<Run> m_Runs;
+
+    /** XOR bytes of all runs, LZ4 compressed if m_Compressed is true.*/
+    std::vector<char> m_Data;
+    std::size_t m_NumberOfDiffBytes;
+    bool m_Compressed;
+
+    std::size_t m_NumberOfImageBytes;
+  };
+}
+
+#endif
@@ -15,12 +15,18 @@ found in the LICENSE file.
 #include <mitkImageReadAccessor.h>
 #include <mitkImageWriteAccessor.h>
 
+#include <itkMultiThreaderBase.h>
+
 #include <lz4.h>
+#include <lz4hc.h>
 
 #include <algorithm>
 
 mitk::CompressedImageContainer::CompressedImageContainer()
-  : m_Dimension(0)
+  : m_Dimension(0),
+    m_Codec(Codec::LZ4),
+    m_CompressionLevel(LZ4HC_CLEVEL_DEFAULT),
+    m_NumberOfThreads(0)
 {
 }
 
@@ -33,8 +39,8 @@ void mitk::CompressedImageContainer::ClearCompressedImageData()
 {
   for (const auto& image : m_CompressedImageData)
   {
-    for (auto slice : image)
-      delete[] slice.second;
+    for (const auto& slice : image)
+      delete[] slice.Data;
   }
 
   m_CompressedImageData.clear();
@@ -46,6 +52,60 @@ void mitk::CompressedImageContainer::ClearCompressedImageData()
   m_Dimension = 0;
 }
 
+void mitk::CompressedImageContainer::ProcessSlices(std::size_t numberOfSlices, const std::function<void(std::size_t)>& processSlice) const
+{
+  if (1 == m_NumberOfThreads || 2 > numberOfSlices)
+  {
+    for (std::size_t i = 0; i < numberOfSlices; ++i)
+      processSlice(i);
+
+    return;
+  }
+
+  auto multiThreader = itk::MultiThreaderBase::New();
+
+  if (0 != m_NumberOfThreads)
+    multiThreader->SetNumberOfWorkUnits(m_NumberOfThreads);
+
+  multiThreader->ParallelizeArray(0, numberOfSlices, [&processSlice](itk::SizeValueType i) { processSlice(i); }, nullptr);
+}
+
+mitk::CompressedImageContainer::CompressedSliceData mitk::CompressedImageContainer::CompressSlice(const char* src, int numSliceBytes) const
+{
+  CompressedSliceData slice;
+
+  const auto destCapacity = LZ4_compressBound(numSliceBytes);
+
+  if (0 < destCapacity)
+  {
+    char* dest = new char[destCapacity];
+
+    const auto destSize = Codec::LZ4HC == m_Codec
+      ? LZ4_compress_HC(src, dest, numSliceBytes, destCapacity, m_CompressionLevel)
+      : LZ4_compress_default(src, dest, numSliceBytes, destCapacity);
+
+    if (0 < destSize && destSize < numSliceBytes)
+    {
+      slice.Size = destSize;
+      slice.Data = new char[destSize];
+      std::copy(dest, dest + destSize, slice.Data);
+    }
+
+    delete[] dest;
+  }
+
+  if (nullptr == slice.Data)
+  {
+    // Incompressible slices (or slices too large for LZ4) are stored raw.
+    slice.Size = numSliceBytes;
+    slice.Data = new char[numSliceBytes];
+    slice.Raw = true;
+    std::copy(src, src + numSliceBytes, slice.Data);
+  }
+
+  return slice;
+}
+
 void mitk::CompressedImageContainer::CompressImage(const Image* image)
 {
   this->ClearCompressedImageData();
@@ -63,38 +123,22 @@ void mitk::CompressedImageContainer::CompressImage(const Image* image)
   const auto numSlices = image->GetDimension(2);
   const auto numSliceBytes = image->GetPixelType().GetSize() * image->GetDimension(0) * image->GetDimension(1);
 
-  m_CompressedImageData.reserve(numTimeSteps);
+  std::vector<std::unique_ptr<ImageReadAccessor>> accessors;
+  accessors.reserve(numTimeSteps);
 
   for (std::remove_const_t<decltype(numTimeSteps)> t = 0; t < numTimeSteps; ++t)
   {
-    CompressedTimeStepData slices;
-    slices.reserve(numSlices);
-
-    ImageReadAccessor accessor(image, image->GetVolumeData(t));
+    accessors.push_back(std::make_unique<ImageReadAccessor>(image, image->GetVolumeData(t)));
+    m_CompressedImageData.emplace_back(numSlices);
+  }
 
-    for (std::remove_const_t<decltype(numSlices)> s = 0; s < numSlices; ++s)
-    {
-      const auto* src = reinterpret_cast<const char*>(accessor.GetData()) + numSliceBytes * s;
-      char* dest = new char[numSliceBytes];
-      const auto destSize = LZ4_compress_default(src, dest, static_cast<int>(numSliceBytes), static_cast<int>(numSliceBytes));
-
-      if (0 == destSize)
-      {
-        MITK_ERROR << "LZ4 compression failed!";
-        delete[] dest;
-        slices.emplace_back(0, nullptr);
-      }
-      else
-      {
-        char* shrinkedDest = new char[destSize];
-        std::copy(dest, dest + destSize, shrinkedDest);
-        delete[] dest;
-        slices.emplace_back(destSize, shrinkedDest);
-      }
-    }
+  this->ProcessSlices(static_cast<std::size_t>(numTimeSteps) * numSlices, [&](std::size_t i) {
+    const auto t = i / numSlices;
+    const auto s = i % numSlices;
 
-    m_CompressedImageData.push_back(slices);
-  }
+    const auto* src = reinterpret_cast<const char*>(accessors[t]->GetData()) + numSliceBytes * s;
+    m_CompressedImageData[t][s] = this->CompressSlice(src, static_cast<int>(numSliceBytes));
+  });
 }
 
 mitk::Image::Pointer mitk::CompressedImageContainer::DecompressImage() const
@@ -115,22 +159,77 @@ mitk::Image::Pointer mitk::CompressedImageContainer::DecompressImage() const
   auto image = Image::New();
   image->Initialize(*m_PixelType, m_Dimension, dimensions.data());
 
+  std::vector<std::unique_ptr<ImageWriteAccessor>> accessors;
+  accessors.reserve(numTimeSteps);
+
   for (std::remove_const_t<decltype(numTimeSteps)> t = 0; t < numTimeSteps; ++t)
-  {
-    ImageWriteAccessor accessor(image, image->GetVolumeData(static_cast<int>(t)));
+    accessors.push_back(std::make_unique<ImageWriteAccessor>(image, image->GetVolumeData(static_cast<int>(t))));
 
-    for (std::remove_const_t<decltype(numSlices)> s = 0; s < numSlices; ++s)
-    {
-      auto* dest = reinterpret_cast<char*>(accessor.GetData()) + numSliceBytes * s;
-      const auto& slice = m_CompressedImageData[t][s];
-      const auto destSize = LZ4_decompress_safe(slice.second, dest, slice.first, static_cast<int>(numSliceBytes));
+  this->ProcessSlices(static_cast<std::size_t>(numTimeSteps) * numSlices, [&](std::size_t i) {
+    const auto t = i / numSlices;
+    const auto s = i % numSlices;
+
+    auto* dest = reinterpret_cast<char*>(accessors[t]->GetData()) + numSliceBytes * s;
+    const auto& slice = m_CompressedImageData[t][s];
 
-      if (0 > destSize)
-        MITK_ERROR << "LZ4 decompression failed!";
+    if (slice.Raw)
+    {
+      std::copy(slice.Data, slice.Data + slice.Size, dest);
     }
-  }
+    else if (0 > LZ4_decompress_safe(slice.Data, dest, slice.Size, static_cast<int>(numSliceBytes)))
+    {
+      MITK_ERROR << "LZ4 decompression failed!";
+    }
+  });
+
+  accessors.clear();
 
   image->SetTimeGeometry(m_TimeGeometry->Clone());
 
   return image;
 }
+
+std::size_t mitk::CompressedImageContainer::GetCompressedSize() const
+{
+  std::size_t size = 0;
+
+  for (const auto& timeStep : m_CompressedImageData)
+  {
+    size += timeStep.capacity() * sizeof(CompressedSliceData);
+
+    for (const auto& slice : timeStep)
+      size += static_cast<std::size_t>(slice.Size);
+  }
+
+  return size;
+}
+
+void mitk::CompressedImageContainer::SetCodec(Codec codec)
+{
+  m_Codec = codec;
+}
+
+mitk::CompressedImageContainer::Codec mitk::CompressedImageContainer::GetCodec() const
+{
+  return m_Codec;
+}
+
+void mitk::CompressedImageContainer::SetCompressionLevel(int level)
+{
+  m_CompressionLevel = level;
+}
+
+int mitk::CompressedImageContainer::GetCompressionLevel() const
+{
+  return m_CompressionLevel;
+}
+
+void mitk::CompressedImageContainer::SetNumberOfThreads(unsigned int numberOfThreads)
+{
+  m_NumberOfThreads = numberOfThreads;
+}
+
+unsigned int mitk::CompressedImageContainer::GetNumberOfThreads() const
+{
+  return m_NumberOfThreads;
+}
@@ -0,0 +1,215 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include <mitkCompressedImageDiff.h>
+
+#include <mitkExceptionMacro.h>
+#include <mitkImageReadAccessor.h>
+#include <mitkImageWriteAccessor.h>
+
+#include <lz4.h>
+
+#include <cstdint>
+#include <cstring>
+
+namespace
+{
+  std::size_t GetNumberOfImageBytes(const mitk::Image* image)
+  {
+    std::size_t numberOfBytes = image->GetPixelType().GetSize();
+
+    for (unsigned int i = 0; i < image->GetDimension(); ++i)
+      numberOfBytes *= image->GetDimension(i);
+
+    return numberOfBytes;
+  }
+
+  /** Skips equal bytes word by word and returns the offset of the first different byte (or size).*/
+  std::size_t FindNextDifference(const char* a, const char* b, std::size_t offset, std::size_t size)
+  {
+    std::uint64_t wordA, wordB;
+
+    while (offset + sizeof(std::uint64_t) <= size)
+    {
+      std::memcpy(&wordA, a + offset, sizeof(std::uint64_t));
+      std::memcpy(&wordB, b + offset, sizeof(std::uint64_t));
+
+      if (wordA != wordB)
+        break;
+
+      offset += sizeof(std::uint64_t);
+    }
+
+    while (offset < size && a[offset] == b[offset])
+      ++offset;
+
+    return offset;
+  }
+}
+
+mitk::CompressedImageDiff::CompressedImageDiff()
+  : m_NumberOfDiffBytes(0),
+    m_Compressed(false),
+    m_NumberOfImageBytes(0)
+{
+}
+
+mitk::CompressedImageDiff::~CompressedImageDiff()
+{
+}
+
+void mitk::CompressedImageDiff::Clear()
+{
+  m_Runs.clear();
+  m_Data.clear();
+  m_NumberOfDiffBytes = 0;
+  m_Compressed = false;
+  m_NumberOfImageBytes = 0;
+}
+
+void mitk::CompressedImageDiff::ComputeDiff(const Image* reference, const Image* image)
+{
+  this->Clear();
+
+  if (nullptr == reference || nullptr == image)
+    mitkThrow() << "Cannot compute image difference. At least one of the images is missing.";
+
+  if (reference->GetPixelType() != image->GetPixelType())
+    mitkThrow() << "Cannot compute image difference. The images have different pixel types.";
+
+  if (reference->GetDimension() != image->GetDimension())
+    mitkThrow() << "Cannot compute image difference. The images have different dimensions.";
+
+  for (unsigned int i = 0; i < image->GetDimension(); ++i)
+  {
+    if (reference->GetDimension(i) != image->GetDimension(i))
+      mitkThrow() << "Cannot compute image difference. The images have different sizes.";
+  }
+
+  m_NumberOfImageBytes = GetNumberOfImageBytes(image);
+
+  ImageReadAccessor referenceAccessor(reference);
+  ImageReadAccessor imageAccessor(image);
+
+  const auto* referenceData = static_cast<const char*>(referenceAccessor.GetData());
+  const auto* imageData = static_cast<const char*>(imageAccessor.GetData());
+
+  // A gap of unchanged bytes that is shorter than a run descriptor is cheaper to store as part of the runs.
+  constexpr std::size_t maximumGap = sizeof(Run);
+
+  std::size_t offset = FindNextDifference(referenceData, imageData, 0, m_NumberOfImageBytes);
+
+  while (offset < m_NumberOfImageBytes)
+  {
+    Run run = { offset, 0 };
+    std::size_t end = offset;
+
+    while (end < m_NumberOfImageBytes)
+    {
+      while (end < m_NumberOfImageBytes && referenceData[end] != imageData[end])
+        ++end;
+
+      const auto next = FindNextDifference(referenceData, imageData, end, m_NumberOfImageBytes);
+
+      if (next == m_NumberOfImageBytes || next - end > maximumGap)
+        break;
+
+      end = next;
+    }
+
+    run.Length = end - run.Offset;
+    m_Runs.push_back(run);
+
+    for (std::size_t i = run.Offset; i < end; ++i)
+      m_Data.push_back(referenceData[i] ^ imageData[i]);
+
+    offset = FindNextDifference(referenceData, imageData, end, m_NumberOfImageBytes);
+  }
+
+  m_NumberOfDiffBytes = m_Data.size();
+
+  if (!m_Data.empty() && m_Data.size() <= LZ4_MAX_INPUT_SIZE)
+  {
+    std::vector<char> compressedData(LZ4_compressBound(static_cast<int>(m_Data.size())));
+    const auto compressedSize = LZ4_compress_default(m_Data.data(),
+                                                     compressedData.data(),
+                                                     static_cast<int>(m_Data.size()),
+                                                     static_cast<int>(compressedData.size()));
+
+    if (0 < compressedSize && static_cast<std::size_t>(compressedSize) < m_Data.size())
+    {
+      compressedData.resize(compressedSize);
+      m_Data.swap(compressedData);
+      m_Compressed = true;
+    }
+  }
+
+  m_Data.shrink_to_fit();
+  m_Runs.shrink_to_fit();
+}
+
+void mitk::CompressedImageDiff::ApplyDiff(Image* image) const
+{
+  if (nullptr == image)
+    mitkThrow() << "Cannot apply image difference. No image given.";
+
+  if (GetNumberOfImageBytes(image) != m_NumberOfImageBytes)
+    mitkThrow() << "Cannot apply image difference. The image differs in size from the compared images.";
+
+  if (m_Runs.empty())
+    return;
+
+  std::vector<char> decompressedData;
+  const char* diffData = m_Data.data();
+
+  if (m_Compressed)
+  {
+    decompressedData.resize(m_NumberOfDiffBytes);
+    const auto decompressedSize = LZ4_decompress_safe(m_Data.data(),
+                                                      decompressedData.data(),
+                                                      static_cast<int>(m_Data.size()),
+                                                      static_cast<int>(decompressedData.size()));
+
+    if (decompressedSize != static_cast<int>(m_NumberOfDiffBytes))
+      mitkThrow() << "LZ4 decompression of image difference failed!";
+
+    diffData = decompressedData.data();
+  }
+
+  ImageWriteAccessor accessor(image);
+  auto* data = static_cast<char*>(accessor.GetData());
+
+  for (const auto& run : m_Runs)
+  {
+    auto* dest = data + run.Offset;
+
+    for (std::size_t i = 0; i < run.Length; ++i)
+      dest[i] ^= diffData[i];
+
+    diffData += run.Length;
+  }
+}
+
+bool mitk::CompressedImageDiff::IsEmpty() const
+{
+  return m_Runs.empty();
+}
+
+std::size_t mitk::CompressedImageDiff::GetNumberOfDiffBytes() const
+{
+  return m_NumberOfDiffBytes;
+}
+
+std::size_t mitk::CompressedImageDiff::GetMemorySize() const
+{
+  return sizeof(*this) + m_Runs.capacity() * sizeof(Run) + m_Data.capacity();
+}
@@ -1,5 +1,7 @@
 set(MODULE_TESTS
   mitkColorSequenceRainbowTest.cpp
+  mitkCompressedImageContainerParallelTest.cpp
+  mitkCompressedImageDiffTest.cpp
   mitkMultiStepperTest.cpp
   mitkUnstructuredGridTest.cpp
 )
@@ -0,0 +1,152 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+// Testing
+#include "mitkTestFixture.h"
+#include "mitkTestingMacros.h"
+
+// MITK includes
+#include <mitkCompressedImageContainer.h>
+#include <mitkImageReadAccessor.h>
+#include <mitkImageWriteAccessor.h>
+
+// std includes
+#include <cstring>
+#include <random>
+
+class mitkCompressedImageContainerParallelTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkCompressedImageContainerParallelTestSuite);
+  MITK_TEST(CompressImage_AllCodecsAndThreads_RoundTripIsExact);
+  MITK_TEST(CompressImage_IncompressibleSlices_AreStoredRaw);
+  MITK_TEST(CompressImage_LZ4HC_IsNotLargerThanLZ4);
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+  /** 3D+t image of smooth (compressible) slices, of which the given fraction is replaced by noise (incompressible).*/
+  static mitk::Image::Pointer CreateImage(unsigned int size, unsigned int numberOfSlices, unsigned int numberOfTimeSteps, double noiseFraction)
+  {
+    unsigned int dimensions[] = { size, size, numberOfSlices, numberOfTimeSteps };
+
+    auto image = mitk::Image::New();
+    image->Initialize(mitk::MakeScalarPixelType<short>(), 4, dimensions);
+
+    std::mt19937 generator(42);
+    std::uniform_int_distribution<int> noise(-32768, 32767);
+    std::uniform_real_distribution<double> random(0.0, 1.0);
+
+    for (unsigned int t = 0; t < numberOfTimeSteps; ++t)
+    {
+      mitk::ImageWriteAccessor accessor(image, image->GetVolumeData(t));
+      auto* data = static_cast<short*>(accessor.GetData());
+
+      for (unsigned int z = 0; z < numberOfSlices; ++z)
+      {
+        const bool isNoise = random(generator) < noiseFraction;
+
+        for (unsigned int i = 0; i < size * size; ++i)
+        {
+          const auto x = i % size;
+          const auto y = i / size;
+
+          data[(z * size * size) + i] = isNoise
+            ? static_cast<short>(noise(generator))
+            : static_cast<short>(((x / 16 + y / 16 + z + t) % 8) * 100);
+        }
+      }
+    }
+
+    return image;
+  }
+
+  static std::size_t GetNumberOfBytes(const mitk::Image* image)
+  {
+    std::size_t numberOfBytes = image->GetPixelType().GetSize();
+
+    for (unsigned int i = 0; i < image->GetDimension(); ++i)
+      numberOfBytes *= image->GetDimension(i);
+
+    return numberOfBytes;
+  }
+
+  static bool AreEqual(const mitk::Image* a, const mitk::Image* b)
+  {
+    if (a->GetDimension() != b->GetDimension() || a->GetPixelType() != b->GetPixelType())
+      return false;
+
+    for (unsigned int i = 0; i < a->GetDimension(); ++i)
+    {
+      if (a->GetDimension(i) != b->GetDimension(i))
+        return false;
+    }
+
+    mitk::ImageReadAccessor accessorA(a);
+    mitk::ImageReadAccessor accessorB(b);
+
+    return 0 == std::memcmp(accessorA.GetData(), accessorB.GetData(), GetNumberOfBytes(a));
+  }
+
+public:
+  void CompressImage_AllCodecsAndThreads_RoundTripIsExact()
+  {
+    auto image = CreateImage(64, 16, 3, 0.3);
+
+    for (auto codec : { mitk::CompressedImageContainer::Codec::LZ4, mitk::CompressedImageContainer::Codec::LZ4HC })
+    {
+      for (unsigned int numberOfThreads : { 1u, 0u, 3u })
+      {
+        mitk::CompressedImageContainer container;
+        container.SetCodec(codec);
+        container.SetNumberOfThreads(numberOfThreads);
+        container.CompressImage(image);
+
+        auto decompressedImage = container.DecompressImage();
+
+        CPPUNIT_ASSERT(decompressedImage.IsNotNull());
+        CPPUNIT_ASSERT_MESSAGE("Decompressed image is identical to the original image.", AreEqual(image, decompressedImage));
+        CPPUNIT_ASSERT_EQUAL(image->GetTimeSteps(), decompressedImage->GetTimeSteps());
+      }
+    }
+  }
+
+  void CompressImage_IncompressibleSlices_AreStoredRaw()
+  {
+    auto image = CreateImage(64, 8, 2, 1.0);
+
+    mitk::CompressedImageContainer container;
+    container.CompressImage(image);
+
+    const auto numberOfBytes = GetNumberOfBytes(image);
+
+    // raw slices have no LZ4 overhead, only the bookkeeping of the slices is added
+    CPPUNIT_ASSERT(container.GetCompressedSize() >= numberOfBytes);
+    CPPUNIT_ASSERT(container.GetCompressedSize() < numberOfBytes + 1024);
+    CPPUNIT_ASSERT(AreEqual(image, container.DecompressImage()));
+  }
+
+  void CompressImage_LZ4HC_IsNotLargerThanLZ4()
+  {
+    auto image = CreateImage(128, 8, 2, 0.0);
+
+    mitk::CompressedImageContainer lz4Container;
+    lz4Container.CompressImage(image);
+
+    mitk::CompressedImageContainer lz4hcContainer;
+    lz4hcContainer.SetCodec(mitk::CompressedImageContainer::Codec::LZ4HC);
+    lz4hcContainer.CompressImage(image);
+
+    CPPUNIT_ASSERT(lz4Container.GetCompressedSize() < GetNumberOfBytes(image) / 4);
+    CPPUNIT_ASSERT(lz4hcContainer.GetCompressedSize() <= lz4Container.GetCompressedSize());
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkCompressedImageContainerParallel)
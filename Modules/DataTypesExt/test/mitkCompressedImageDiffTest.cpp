@@ -0,0 +1,168 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+// Testing
+#include "mitkTestFixture.h"
+#include "mitkTestingMacros.h"
+
+// MITK includes
+#include <mitkCompressedImageDiff.h>
+#include <mitkImagePixelReadAccessor.h>
+#include <mitkImagePixelWriteAccessor.h>
+
+#include <algorithm>
+
+class mitkCompressedImageDiffTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkCompressedImageDiffTestSuite);
+  MITK_TEST(ComputeDiff_EqualImages_IsEmpty);
+  MITK_TEST(ApplyDiff_RestoresBothImages);
+  MITK_TEST(ComputeDiff_SparseEdit_IsSmallerThanImage);
+  MITK_TEST(ComputeDiff_DifferentSizes_Throws);
+  MITK_TEST(ComputeDiff_DifferentPixelTypes_Throws);
+  MITK_TEST(ApplyDiff_DifferentSize_Throws);
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+  static constexpr unsigned int Size = 256;
+
+  mitk::Image::Pointer m_Reference;
+  mitk::Image::Pointer m_Image;
+
+  static mitk::Image::Pointer CreateSlice(unsigned int size)
+  {
+    unsigned int dimensions[] = { size, size };
+
+    auto image = mitk::Image::New();
+    image->Initialize(mitk::MakeScalarPixelType<unsigned short>(), 2, dimensions);
+
+    mitk::ImagePixelWriteAccessor<unsigned short, 2> accessor(image);
+    std::fill(accessor.GetData(), accessor.GetData() + size * size, 0);
+
+    return image;
+  }
+
+  static void Paint(mitk::Image *image, unsigned int x0, unsigned int y0, unsigned int x1, unsigned int y1, unsigned short value)
+  {
+    mitk::ImagePixelWriteAccessor<unsigned short, 2> accessor(image);
+
+    for (unsigned int y = y0; y < y1; ++y)
+    {
+      for (unsigned int x = x0; x < x1; ++x)
+        accessor.GetData()[y * Size + x] = value;
+    }
+  }
+
+  static bool AreEqual(mitk::Image *a, mitk::Image *b)
+  {
+    mitk::ImagePixelReadAccessor<unsigned short, 2> accessorA(a);
+    mitk::ImagePixelReadAccessor<unsigned short, 2> accessorB(b);
+
+    return std::equal(accessorA.GetData(), accessorA.GetData() + Size * Size, accessorB.GetData());
+  }
+
+public:
+  void setUp() override
+  {
+    m_Reference = CreateSlice(Size);
+    Paint(m_Reference, 10, 10, 50, 50, 1);
+
+    m_Image = CreateSlice(Size);
+    Paint(m_Image, 10, 10, 50, 50, 1);
+    Paint(m_Image, 100, 100, 140, 120, 3);
+    Paint(m_Image, 20, 20, 30, 30, 0);
+  }
+
+  void tearDown() override
+  {
+    m_Reference = nullptr;
+    m_Image = nullptr;
+  }
+
+  void ComputeDiff_EqualImages_IsEmpty()
+  {
+    auto copy = CreateSlice(Size);
+    Paint(copy, 10, 10, 50, 50, 1);
+
+    mitk::CompressedImageDiff diff;
+    diff.ComputeDiff(m_Reference, copy);
+
+    CPPUNIT_ASSERT(diff.IsEmpty());
+    CPPUNIT_ASSERT_EQUAL(std::size_t(0), diff.GetNumberOfDiffBytes());
+
+    diff.ApplyDiff(copy);
+    CPPUNIT_ASSERT(AreEqual(m_Reference, copy));
+  }
+
+  void ApplyDiff_RestoresBothImages()
+  {
+    mitk::CompressedImageDiff diff;
+    diff.ComputeDiff(m_Reference, m_Image);
+
+    CPPUNIT_ASSERT(!diff.IsEmpty());
+
+    // undo: modified -> reference
+    diff.ApplyDiff(m_Image);
+    CPPUNIT_ASSERT_MESSAGE("Applying the diff to the modified image restores the reference.", AreEqual(m_Reference, m_Image));
+
+    // redo: reference -> modified
+    auto expected = CreateSlice(Size);
+    Paint(expected, 10, 10, 50, 50, 1);
+    Paint(expected, 100, 100, 140, 120, 3);
+    Paint(expected, 20, 20, 30, 30, 0);
+
+    diff.ApplyDiff(m_Image);
+    CPPUNIT_ASSERT_MESSAGE("Applying the diff to the reference restores the modified image.", AreEqual(expected, m_Image));
+  }
+
+  void ComputeDiff_SparseEdit_IsSmallerThanImage()
+  {
+    mitk::CompressedImageDiff diff;
+    diff.ComputeDiff(m_Reference, m_Image);
+
+    const std::size_t numberOfImageBytes = Size * Size * sizeof(unsigned short);
+
+    // Changed pixels: 40x20 + 10x10; merged gaps add at most the row remainders of the edited rows.
+    CPPUNIT_ASSERT(diff.GetNumberOfDiffBytes() < numberOfImageBytes / 10);
+    CPPUNIT_ASSERT(diff.GetMemorySize() < numberOfImageBytes / 10);
+  }
+
+  void ComputeDiff_DifferentSizes_Throws()
+  {
+    mitk::CompressedImageDiff diff;
+    auto smallImage = CreateSlice(Size / 2);
+
+    CPPUNIT_ASSERT_THROW(diff.ComputeDiff(m_Reference, smallImage), mitk::Exception);
+    CPPUNIT_ASSERT_THROW(diff.ComputeDiff(m_Reference, nullptr), mitk::Exception);
+  }
+
+  void ComputeDiff_DifferentPixelTypes_Throws()
+  {
+    unsigned int dimensions[] = { Size, Size };
+    auto image = mitk::Image::New();
+    image->Initialize(mitk::MakeScalarPixelType<short>(), 2, dimensions);
+
+    mitk::CompressedImageDiff diff;
+    CPPUNIT_ASSERT_THROW(diff.ComputeDiff(m_Reference, image), mitk::Exception);
+  }
+
+  void ApplyDiff_DifferentSize_Throws()
+  {
+    mitk::CompressedImageDiff diff;
+    diff.ComputeDiff(m_Reference, m_Image);
+
+    auto smallImage = CreateSlice(Size / 2);
+    CPPUNIT_ASSERT_THROW(diff.ApplyDiff(smallImage), mitk::Exception);
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkCompressedImageDiff)
@@ -1,7 +1,9 @@
 set(CPP_FILES
+  itkLiveWireDijkstraTree.cpp
   itkShortestPathNode.cpp
 )
 set(H_FILES
+  itkLiveWireDijkstraTree.h
   itkShortestPathCostFunction.h
   itkShortestPathCostFunctionTbss.h
   itkShortestPathNode.h
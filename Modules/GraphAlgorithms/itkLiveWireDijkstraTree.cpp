@@ -0,0 +1,362 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+#include "itkLiveWireDijkstraTree.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace
+{
+  std::uint32_t Quantize(double cost, double resolution)
+  {
+    // invalid costs (e.g. of a constant image) are treated as the worst local costs
+    if (!std::isfinite(cost))
+      cost = 1.0;
+
+    const double quantizedCost = std::round(std::max(0.0, cost) * resolution);
+
+    return quantizedCost < static_cast<double>(std::numeric_limits<std::uint32_t>::max() / 2)
+             ? static_cast<std::uint32_t>(quantizedCost)
+             : std::numeric_limits<std::uint32_t>::max() / 2;
+  }
+}
+
+namespace itk
+{
+  LiveWireDijkstraTree::LiveWireDijkstraTree()
+    : m_RepulsiveCost(1000.0),
+      m_CostResolution(256.0),
+      m_CostImageMTime(0),
+      m_CostsAreValid(false),
+      m_TreeIsValid(false),
+      m_Width(0),
+      m_Height(0),
+      m_QuantizedRepulsiveCost(0),
+      m_NumberOfSettledPixels(0),
+      m_CurrentDistance(0),
+      m_QueueSize(0)
+  {
+    m_Seed.Fill(0);
+    m_Origin.Fill(0);
+  }
+
+  LiveWireDijkstraTree::~LiveWireDijkstraTree()
+  {
+  }
+
+  void LiveWireDijkstraTree::SetCostImage(const CostImageType *costImage)
+  {
+    if (m_CostImage != costImage)
+    {
+      m_CostImage = costImage;
+      m_CostsAreValid = false;
+      this->Modified();
+    }
+  }
+
+  void LiveWireDijkstraTree::SetMaskImage(const MaskImageType *maskImage)
+  {
+    if (m_MaskImage != maskImage)
+    {
+      m_MaskImage = maskImage;
+      m_TreeIsValid = false;
+      this->Modified();
+    }
+  }
+
+  void LiveWireDijkstraTree::SetRepulsiveCost(double repulsiveCost)
+  {
+    if (m_RepulsiveCost != repulsiveCost)
+    {
+      m_RepulsiveCost = repulsiveCost;
+      m_CostsAreValid = false;
+      this->Modified();
+    }
+  }
+
+  void LiveWireDijkstraTree::SetCostResolution(double costResolution)
+  {
+    if (costResolution <= 0.0)
+      itkExceptionMacro("The cost resolution must be positive.");
+
+    if (m_CostResolution != costResolution)
+    {
+      m_CostResolution = costResolution;
+      m_CostsAreValid = false;
+      this->Modified();
+    }
+  }
+
+  void LiveWireDijkstraTree::SetSeed(const IndexType &seed)
+  {
+    if (m_Seed != seed)
+    {
+      m_Seed = seed;
+      m_TreeIsValid = false;
+      this->Modified();
+    }
+  }
+
+  void LiveWireDijkstraTree::Reset()
+  {
+    m_TreeIsValid = false;
+  }
+
+  bool LiveWireDijkstraTree::ToNode(const IndexType &index, NodeType &node) const
+  {
+    const auto x = index[0] - m_Origin[0];
+    const auto y = index[1] - m_Origin[1];
+
+    if (x < 0 || y < 0 || static_cast<SizeValueType>(x) >= m_Width || static_cast<SizeValueType>(y) >= m_Height)
+      return false;
+
+    node = static_cast<NodeType>(static_cast<SizeValueType>(y) * m_Width + static_cast<SizeValueType>(x));
+    return true;
+  }
+
+  LiveWireDijkstraTree::IndexType LiveWireDijkstraTree::ToIndex(NodeType node) const
+  {
+    IndexType index;
+    index[0] = m_Origin[0] + static_cast<IndexValueType>(node % m_Width);
+    index[1] = m_Origin[1] + static_cast<IndexValueType>(node / m_Width);
+    return index;
+  }
+
+  bool LiveWireDijkstraTree::Prepare()
+  {
+    if (m_CostImage.IsNull())
+      return false;
+
+    if (!m_CostsAreValid || m_CostImage->GetMTime() != m_CostImageMTime)
+    {
+      this->UpdateQuantizedCosts();
+      m_CostImageMTime = m_CostImage->GetMTime();
+      m_CostsAreValid = true;
+      m_TreeIsValid = false;
+    }
+
+    if (m_MaskImage.IsNotNull() &&
+        m_MaskImage->GetBufferedRegion().GetNumberOfPixels() != static_cast<SizeValueType>(m_Width * m_Height))
+      itkExceptionMacro("The mask image differs in size from the cost image.");
+
+    NodeType seed;
+    if (!this->ToNode(m_Seed, seed))
+      return false;
+
+    if (!m_TreeIsValid)
+      this->InitializeTree();
+
+    return true;
+  }
+
+  void LiveWireDijkstraTree::UpdateQuantizedCosts()
+  {
+    const auto &region = m_CostImage->GetBufferedRegion();
+
+    m_Origin = region.GetIndex();
+    m_Width = region.GetSize(0);
+    m_Height = region.GetSize(1);
+
+    const SizeValueType numberOfPixels = m_Width * m_Height;
+
+    if (numberOfPixels >= static_cast<SizeValueType>(NoNode))
+      itkExceptionMacro("The cost image is too large.");
+
+    m_StraightCosts.resize(numberOfPixels);
+    m_DiagonalCosts.resize(numberOfPixels);
+
+    const auto *costs = m_CostImage->GetBufferPointer();
+    const double diagonalResolution = std::sqrt(2.0) * m_CostResolution;
+
+    for (SizeValueType i = 0; i < numberOfPixels; ++i)
+    {
+      m_StraightCosts[i] = Quantize(costs[i], m_CostResolution);
+      m_DiagonalCosts[i] = Quantize(costs[i], diagonalResolution);
+    }
+
+    m_QuantizedRepulsiveCost = Quantize(m_RepulsiveCost, m_CostResolution);
+
+    // Every queued distance lies within [current distance, current distance + maximum link costs],
+    // so this many buckets never contain nodes of different distances.
+    std::uint32_t maximumLinkCosts = m_QuantizedRepulsiveCost;
+
+    if (0 < numberOfPixels)
+      maximumLinkCosts = std::max(maximumLinkCosts, *std::max_element(m_DiagonalCosts.begin(), m_DiagonalCosts.end()));
+
+    m_Buckets.assign(static_cast<std::size_t>(maximumLinkCosts) + 1, NoNode);
+  }
+
+  void LiveWireDijkstraTree::InitializeTree()
+  {
+    const SizeValueType numberOfPixels = m_Width * m_Height;
+
+    m_Distances.assign(numberOfPixels, std::numeric_limits<DistanceType>::max());
+    m_Parents.assign(numberOfPixels, NoNode);
+    m_States.assign(numberOfPixels, Unvisited);
+    m_Next.resize(numberOfPixels);
+    m_Previous.resize(numberOfPixels);
+    std::fill(m_Buckets.begin(), m_Buckets.end(), NoNode);
+
+    m_NumberOfSettledPixels = 0;
+    m_CurrentDistance = 0;
+    m_QueueSize = 0;
+
+    NodeType seed;
+    this->ToNode(m_Seed, seed);
+    this->Enqueue(seed, 0);
+
+    m_TreeIsValid = true;
+  }
+
+  void LiveWireDijkstraTree::Enqueue(NodeType node, DistanceType distance)
+  {
+    auto &head = m_Buckets[distance % m_Buckets.size()];
+
+    m_Distances[node] = distance;
+    m_States[node] = Queued;
+    m_Previous[node] = NoNode;
+    m_Next[node] = head;
+
+    if (NoNode != head)
+      m_Previous[head] = node;
+
+    head = node;
+    ++m_QueueSize;
+  }
+
+  void LiveWireDijkstraTree::Dequeue(NodeType node)
+  {
+    const auto next = m_Next[node];
+    const auto previous = m_Previous[node];
+
+    if (NoNode != previous)
+      m_Next[previous] = next;
+    else
+      m_Buckets[m_Distances[node] % m_Buckets.size()] = next;
+
+    if (NoNode != next)
+      m_Previous[next] = previous;
+
+    --m_QueueSize;
+  }
+
+  void LiveWireDijkstraTree::GrowUntilSettled(NodeType target)
+  {
+    const auto numberOfBuckets = m_Buckets.size();
+    const unsigned char *mask = m_MaskImage.IsNotNull() ? m_MaskImage->GetBufferPointer() : nullptr;
+    const auto width = static_cast<std::int64_t>(m_Width);
+    const auto height = static_cast<std::int64_t>(m_Height);
+
+    while (Settled != m_States[target] && 0 < m_QueueSize)
+    {
+      auto node = m_Buckets[m_CurrentDistance % numberOfBuckets];
+
+      while (NoNode == node)
+      {
+        ++m_CurrentDistance;
+        node = m_Buckets[m_CurrentDistance % numberOfBuckets];
+      }
+
+      this->Dequeue(node);
+      m_States[node] = Settled;
+      ++m_NumberOfSettledPixels;
+
+      const auto x = static_cast<std::int64_t>(node % m_Width);
+      const auto y = static_cast<std::int64_t>(node / m_Width);
+      const bool nodeIsRepulsive = nullptr != mask && 0 != mask[node];
+
+      for (std::int64_t dy = -1; dy <= 1; ++dy)
+      {
+        if (y + dy < 0 || y + dy >= height)
+          continue;
+
+        for (std::int64_t dx = -1; dx <= 1; ++dx)
+        {
+          if ((0 == dx && 0 == dy) || x + dx < 0 || x + dx >= width)
+            continue;
+
+          const auto neighbor = static_cast<NodeType>((y + dy) * width + x + dx);
+
+          if (Settled == m_States[neighbor])
+            continue;
+
+          std::uint32_t linkCosts;
+
+          if (nodeIsRepulsive || (nullptr != mask && 0 != mask[neighbor]))
+            linkCosts = m_QuantizedRepulsiveCost;
+          else
+            linkCosts = (0 == dx || 0 == dy) ? m_StraightCosts[neighbor] : m_DiagonalCosts[neighbor];
+
+          const auto distance = m_Distances[node] + linkCosts;
+
+          if (distance < m_Distances[neighbor])
+          {
+            if (Queued == m_States[neighbor])
+              this->Dequeue(neighbor);
+
+            this->Enqueue(neighbor, distance);
+            m_Parents[neighbor] = node;
+          }
+        }
+      }
+    }
+  }
+
+  LiveWireDijkstraTree::PathType LiveWireDijkstraTree::GetPath(const IndexType &end)
+  {
+    PathType path;
+
+    NodeType node;
+    if (!this->Prepare() || !this->ToNode(end, node))
+      return path;
+
+    this->GrowUntilSettled(node);
+
+    if (Settled != m_States[node])
+      return path;
+
+    while (NoNode != node)
+    {
+      path.push_back(this->ToIndex(node));
+      node = m_Parents[node];
+    }
+
+    std::reverse(path.begin(), path.end());
+
+    return path;
+  }
+
+  double LiveWireDijkstraTree::GetPathCost(const IndexType &end)
+  {
+    NodeType node;
+    if (!this->Prepare() || !this->ToNode(end, node))
+      return -1.0;
+
+    this->GrowUntilSettled(node);
+
+    if (Settled != m_States[node])
+      return -1.0;
+
+    return static_cast<double>(m_Distances[node]) / m_CostResolution;
+  }
+
+  void LiveWireDijkstraTree::PrintSelf(std::ostream &os, Indent indent) const
+  {
+    Superclass::PrintSelf(os, indent);
+
+    os << indent << "Seed: " << m_Seed << std::endl;
+    os << indent << "RepulsiveCost: " << m_RepulsiveCost << std::endl;
+    os << indent << "CostResolution: " << m_CostResolution << std::endl;
+    os << indent << "NumberOfSettledPixels: " << m_NumberOfSettledPixels << std::endl;
+  }
+} // namespace itk
@@ -0,0 +1,160 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+#ifndef __itkLiveWireDijkstraTree_h
+#define __itkLiveWireDijkstraTree_h
+
+#include "MitkGraphAlgorithmsExports.h"
+
+#include <itkImage.h>
+#include <itkObject.h>
+#include <itkObjectFactory.h>
+
+#include <cstdint>
+#include <vector>
+
+namespace itk
+{
+  /**
+  \brief Shortest path tree of an 8-connected 2D image, grown from a single seed ("intelligent scissors").
+
+  In contrast to ShortestPathImageFilter, which searches the path between a start and an end point from
+  scratch, the tree is grown once from the seed and kept between queries. A query for another end point
+  only continues the growth until that point is settled (if it is not already) and traces the path back
+  along the parent links, which is O(path length) for every pixel already reached.
+
+  The costs of entering a pixel are given as a cost image, e.g. ShortestPathCostFunctionLiveWire::GetLocalCostImage().
+  Diagonal links cost sqrt(2) times as much. Every link from or to a pixel that is set in the (optional) mask
+  image costs the repulsive cost.
+
+  The costs are quantized to integers (see SetCostResolution()), so that a circular bucket queue (Dial's
+  algorithm) can be used instead of a binary heap.
+
+  The tree has to be reset by Reset() if the mask image was modified in place (pixel changes do not modify
+  the image). Changing the seed, the cost image, the mask image or the costs resets the tree automatically.
+  */
+  class MITKGRAPHALGORITHMS_EXPORT LiveWireDijkstraTree : public Object
+  {
+  public:
+    typedef LiveWireDijkstraTree Self;
+    typedef Object Superclass;
+    typedef SmartPointer<Self> Pointer;
+    typedef SmartPointer<const Self> ConstPointer;
+
+    itkNewMacro(Self);
+    itkTypeMacro(LiveWireDijkstraTree, Object);
+
+    typedef Image<float, 2> CostImageType;
+    typedef Image<unsigned char, 2> MaskImageType;
+    typedef CostImageType::IndexType IndexType;
+    typedef std::vector<IndexType> PathType;
+
+    /** \brief Set the costs of entering each pixel (by a horizontal or vertical link).*/
+    void SetCostImage(const CostImageType *costImage);
+    itkGetConstObjectMacro(CostImage, CostImageType);
+
+    /** \brief Set the mask of repulsive pixels (may be nullptr). It must have the size of the cost image.*/
+    void SetMaskImage(const MaskImageType *maskImage);
+    itkGetConstObjectMacro(MaskImage, MaskImageType);
+
+    /** \brief Set the costs of every link from or to a repulsive pixel (default: 1000).*/
+    void SetRepulsiveCost(double repulsiveCost);
+    itkGetConstMacro(RepulsiveCost, double);
+
+    /** \brief Set the number of quantization steps per cost unit (default: 256).*/
+    void SetCostResolution(double costResolution);
+    itkGetConstMacro(CostResolution, double);
+
+    /** \brief Set the root of the tree. Setting a different seed resets the tree.*/
+    void SetSeed(const IndexType &seed);
+    itkGetConstReferenceMacro(Seed, IndexType);
+
+    /** \brief Discard the grown tree. It is grown again from the seed by the next query.*/
+    void Reset();
+
+    /** \brief Get the shortest path from the seed to the given end point (both included).
+      The path is empty if no cost image is set or if the seed or the end point is outside of it.*/
+    PathType GetPath(const IndexType &end);
+
+    /** \brief Get the costs of the shortest path from the seed to the given end point (or -1, see GetPath()).*/
+    double GetPathCost(const IndexType &end);
+
+    /** \brief Get the number of pixels whose shortest path is already known.*/
+    SizeValueType GetNumberOfSettledPixels() const { return m_NumberOfSettledPixels; }
+
+  protected:
+    LiveWireDijkstraTree();
+    ~LiveWireDijkstraTree() override;
+
+    void PrintSelf(std::ostream &os, Indent indent) const override;
+
+  private:
+    typedef std::uint32_t NodeType;
+    typedef std::uint64_t DistanceType;
+
+    enum NodeState : unsigned char
+    {
+      Unvisited,
+      Queued,
+      Settled
+    };
+
+    static constexpr NodeType NoNode = static_cast<NodeType>(-1);
+
+    bool ToNode(const IndexType &index, NodeType &node) const;
+    IndexType ToIndex(NodeType node) const;
+
+    /** Quantizes the cost image if it (or the cost parameters) changed and (re)starts the tree if necessary.*/
+    bool Prepare();
+
+    void UpdateQuantizedCosts();
+    void InitializeTree();
+
+    /** Continues Dijkstra's algorithm until the node is settled or all nodes are settled.*/
+    void GrowUntilSettled(NodeType target);
+
+    void Enqueue(NodeType node, DistanceType distance);
+    void Dequeue(NodeType node);
+
+    CostImageType::ConstPointer m_CostImage;
+    MaskImageType::ConstPointer m_MaskImage;
+    double m_RepulsiveCost;
+    double m_CostResolution;
+    IndexType m_Seed;
+
+    ModifiedTimeType m_CostImageMTime;
+    bool m_CostsAreValid;
+    bool m_TreeIsValid;
+
+    IndexType m_Origin;
+    SizeValueType m_Width;
+    SizeValueType m_Height;
+
+    /** Quantized costs of entering a pixel by a straight and by a diagonal link.*/
+    std::vector<std::uint32_t> m_StraightCosts;
+    std::vector<std::uint32_t> m_DiagonalCosts;
+    std::uint32_t m_QuantizedRepulsiveCost;
+
+    std::vector<DistanceType> m_Distances;
+    std::vector<NodeType> m_Parents;
+    std::vector<NodeState> m_States;
+    SizeValueType m_NumberOfSettledPixels;
+
+    /** Circular bucket queue: a doubly linked list of nodes per distance modulo the number of buckets.*/
+    std::vector<NodeType> m_Buckets;
+    std::vector<NodeType> m_Next;
+    std::vector<NodeType> m_Previous;
+    DistanceType m_CurrentDistance;
+    SizeValueType m_QueueSize;
+  };
+} // namespace itk
+
+#endif
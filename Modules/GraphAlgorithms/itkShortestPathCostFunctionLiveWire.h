@@ -35,6 +35,10 @@ namespace itk
   To compute  the costs of the gradient magnitude dynamically
   an iverted map of the histogram of gradient magnitude image is used.
 
+  As the costs of a link only depend on the pixel that is entered (and
+  the link direction), they are available as a precomputed image of local
+  costs (GetLocalCostImage()), which is used by LiveWireDijkstraTree.
+
   */
   template <class TInputImageType>
   class ITK_EXPORT ShortestPathCostFunctionLiveWire : public ShortestPathCostFunction<TInputImageType>
@@ -68,6 +72,18 @@ namespace itk
     /** \brief calculates the costs for going from p1 to p2*/
     double GetCost(IndexType p1, IndexType p2) override;
 
+    /** \brief Costs of entering pixel p by a horizontal or vertical link, ignoring repulsive points.
+      GetCost() of a diagonal link is sqrt(2) times this value. Requires Initialize().*/
+    double GetLocalCost(const IndexType &p);
+
+    /** \brief Image of GetLocalCost() of every pixel for the current image and cost map settings.
+      It is computed on the first request after the image or the cost map changed. Both variants (with
+      and without dynamic cost map) are cached, as tools switch between them while interacting.*/
+    const FloatImageType *GetLocalCostImage();
+
+    /** \brief Costs of every link from or to a repulsive point.*/
+    static constexpr double RepulsiveCost = 1000.0;
+
     /** \brief returns the minimal costs possible (needed for A*)*/
     double GetMinCost() override;
 
@@ -93,6 +109,7 @@ namespace itk
       this->m_CostMap = costMap;
       this->m_UseCostMap = true;
       this->m_MaxMapCosts = -1;
+      this->m_LocalCostImages[1] = nullptr;
       this->Modified();
     }
 
@@ -100,7 +117,11 @@ namespace itk
     /**
      \brief Set the maximum of the dynamic cost map to save computation time.
     */
-    void SetCostMapMaximum(double max) { this->m_MaxMapCosts = max; }
+    void SetCostMapMaximum(double max)
+    {
+      this->m_MaxMapCosts = max;
+      this->m_LocalCostImages[1] = nullptr;
+    }
     enum Constants
     {
       MAPSCALEFACTOR = 10
@@ -152,6 +173,9 @@ namespace itk
 
     double m_MaxMapCosts;
 
+    /** Local cost images without [0] and with [1] dynamic cost map.*/
+    FloatImageType::Pointer m_LocalCostImages[2];
+
   private:
     double SigmoidFunction(double I, double max, double min, double alpha, double beta);
   };
@@ -21,7 +21,9 @@ found in the LICENSE file.
 #include <itkCastImageFilter.h>
 #include <itkGradientImageFilter.h>
 #include <itkGradientMagnitudeImageFilter.h>
+#include <itkImageRegionIteratorWithIndex.h>
 #include <itkLaplacianImageFilter.h>
+#include <itkMultiThreaderBase.h>
 #include <itkStatisticsImageFilter.h>
 #include <itkZeroCrossingImageFilter.h>
 
@@ -64,6 +66,8 @@ namespace itk
 
       this->Modified();
       this->m_Initialized = false;
+      this->m_LocalCostImages[0] = nullptr;
+      this->m_LocalCostImages[1] = nullptr;
     }
   }
 
@@ -76,6 +80,36 @@ namespace itk
 
   template <class TInputImageType>
   double ShortestPathCostFunctionLiveWire<TInputImageType>::GetCost(IndexType p1, IndexType p2)
+  {
+    // if we are on the mask, return asap
+    if (m_UseRepulsivePoints)
+    {
+      if ((this->m_MaskImage->GetPixel(p1) != 0) || (this->m_MaskImage->GetPixel(p2) != 0))
+        return RepulsiveCost;
+    }
+
+    double costs = this->GetLocalCost(p2);
+
+    // scale by euclidean distance
+    double costScale;
+    if (p1[0] == p2[0] || p1[1] == p2[1])
+    {
+      // horizontal or vertical neighbor
+      costScale = 1.0;
+    }
+    else
+    {
+      // diagonal neighbor
+      costScale = sqrt(2.0);
+    }
+
+    costs *= costScale;
+
+    return costs;
+  }
+
+  template <class TInputImageType>
+  double ShortestPathCostFunctionLiveWire<TInputImageType>::GetLocalCost(const IndexType &p)
   {
     // local component costs
     // weights
@@ -84,13 +118,6 @@ namespace itk
     double w3;
     double costs = 0.0;
 
-    // if we are on the mask, return asap
-    if (m_UseRepulsivePoints)
-    {
-      if ((this->m_MaskImage->GetPixel(p1) != 0) || (this->m_MaskImage->GetPixel(p2) != 0))
-        return 1000;
-    }
-
     double gradientX, gradientY;
     gradientX = gradientY = 0.0;
 
@@ -99,9 +126,9 @@ namespace itk
     double gradientMagnitude;
 
     // Gradient Magnitude costs
-    gradientMagnitude = this->m_GradientMagnitudeImage->GetPixel(p2);
-    gradientX = m_GradientImage->GetPixel(p2)[0];
-    gradientY = m_GradientImage->GetPixel(p2)[1];
+    gradientMagnitude = this->m_GradientMagnitudeImage->GetPixel(p);
+    gradientX = m_GradientImage->GetPixel(p)[0];
+    gradientY = m_GradientImage->GetPixel(p)[1];
 
     if (m_UseCostMap && !m_CostMap.empty())
     {
@@ -214,7 +241,7 @@ namespace itk
     double laplacianCost;
     typename Superclass::PixelType laplaceImageValue;
 
-    laplaceImageValue = m_EdgeImage->GetPixel(p2);
+    laplaceImageValue = m_EdgeImage->GetPixel(p);
 
     if (laplaceImageValue < 0 || laplaceImageValue > 0)
     {
@@ -225,26 +252,33 @@ namespace itk
       laplacianCost = 0.0;
     }
 
-    // gradient vector at p1
-    double nGradientAtP1[2];
-    nGradientAtP1[0] = gradientX; // previously computed for gradient magnitude
-    nGradientAtP1[1] = gradientY;
+    // gradient direction costs; the direction of a vanishing gradient is undefined and costs nothing
+    double scalarProduct = 1.0;
+
+    if (gradientMagnitude > 0.0)
+    {
+      // gradient vector at p1
+      double nGradientAtP1[2];
+      nGradientAtP1[0] = gradientX; // previously computed for gradient magnitude
+      nGradientAtP1[1] = gradientY;
+
+      // gradient direction unit vector of p1
+      nGradientAtP1[0] /= gradientMagnitude;
+      nGradientAtP1[1] /= gradientMagnitude;
+      //-------
 
-    // gradient direction unit vector of p1
-    nGradientAtP1[0] /= gradientMagnitude;
-    nGradientAtP1[1] /= gradientMagnitude;
-    //-------
+      // gradient vector at p1
+      double nGradientAtP2[2];
 
-    // gradient vector at p1
-    double nGradientAtP2[2];
+      nGradientAtP2[0] = m_GradientImage->GetPixel(p)[0];
+      nGradientAtP2[1] = m_GradientImage->GetPixel(p)[1];
 
-    nGradientAtP2[0] = m_GradientImage->GetPixel(p2)[0];
-    nGradientAtP2[1] = m_GradientImage->GetPixel(p2)[1];
+      nGradientAtP2[0] /= m_GradientMagnitudeImage->GetPixel(p);
+      nGradientAtP2[1] /= m_GradientMagnitudeImage->GetPixel(p);
 
-    nGradientAtP2[0] /= m_GradientMagnitudeImage->GetPixel(p2);
-    nGradientAtP2[1] /= m_GradientMagnitudeImage->GetPixel(p2);
+      scalarProduct = (nGradientAtP1[0] * nGradientAtP2[0]) + (nGradientAtP1[1] * nGradientAtP2[1]);
+    }
 
-    double scalarProduct = (nGradientAtP1[0] * nGradientAtP2[0]) + (nGradientAtP1[1] * nGradientAtP2[1]);
     if (std::abs(scalarProduct) >= 1.0)
     {
       // this should probably not happen; make sure the input for acos is valid
@@ -267,22 +301,39 @@ namespace itk
     }
     costs = w1 * laplacianCost + w2 * gradientCost + w3 * gradientDirectionCost;
 
-    // scale by euclidean distance
-    double costScale;
-    if (p1[0] == p2[0] || p1[1] == p2[1])
-    {
-      // horizontal or vertical neighbor
-      costScale = 1.0;
-    }
-    else
+    return costs;
+  }
+
+  template <class TInputImageType>
+  const typename ShortestPathCostFunctionLiveWire<TInputImageType>::FloatImageType *
+    ShortestPathCostFunctionLiveWire<TInputImageType>::GetLocalCostImage()
+  {
+    this->Initialize();
+
+    auto &localCostImage = this->m_LocalCostImages[m_UseCostMap ? 1 : 0];
+
+    if (localCostImage.IsNull())
     {
-      // diagonal neighbor
-      costScale = sqrt(2.0);
+      localCostImage = FloatImageType::New();
+      localCostImage->SetRegions(this->m_Image->GetLargestPossibleRegion());
+      localCostImage->SetOrigin(this->m_Image->GetOrigin());
+      localCostImage->SetSpacing(this->m_Image->GetSpacing());
+      localCostImage->SetDirection(this->m_Image->GetDirection());
+      localCostImage->Allocate();
+
+      // the cost of every pixel is independent of all other pixels, so the image is filled in parallel chunks
+      MultiThreaderBase::New()->ParallelizeImageRegion<2>(
+        localCostImage->GetLargestPossibleRegion(),
+        [this, &localCostImage](const typename FloatImageType::RegionType &region) {
+          ImageRegionIteratorWithIndex<FloatImageType> it(localCostImage, region);
+
+          for (it.GoToBegin(); !it.IsAtEnd(); ++it)
+            it.Set(static_cast<float>(this->GetLocalCost(it.GetIndex())));
+        },
+        nullptr);
     }
 
-    costs *= costScale;
-
-    return costs;
+    return localCostImage;
   }
 
   template <class TInputImageType>
@@ -0,0 +1,281 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+// Testing
+#include "mitkTestFixture.h"
+#include "mitkTestingMacros.h"
+
+// ITK includes
+#include <itkImageRegionIteratorWithIndex.h>
+#include <itkLiveWireDijkstraTree.h>
+#include <itkShortestPathCostFunctionLiveWire.h>
+#include <itkShortestPathImageFilter.h>
+
+// std includes
+#include <algorithm>
+#include <cmath>
+#include <random>
+
+class mitkLiveWireDijkstraTreeTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkLiveWireDijkstraTreeTestSuite);
+  MITK_TEST(GetPath_CostsMatchShortestPathImageFilter);
+  MITK_TEST(GetPath_ConnectsSeedAndEndPoint);
+  MITK_TEST(GetPath_AvoidsRepulsivePoints);
+  MITK_TEST(GetPath_ReusesGrownTree);
+  MITK_TEST(SetSeed_ResetsTree);
+  MITK_TEST(GetPath_OutsideOfImage_IsEmpty);
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+  typedef itk::Image<float, 2> ImageType;
+  typedef itk::ShortestPathCostFunctionLiveWire<ImageType> CostFunctionType;
+  typedef itk::ShortestPathImageFilter<ImageType, ImageType> ShortestPathImageFilterType;
+  typedef itk::LiveWireDijkstraTree::IndexType IndexType;
+  typedef itk::LiveWireDijkstraTree::PathType PathType;
+
+  CostFunctionType::Pointer m_CostFunction;
+  itk::LiveWireDijkstraTree::Pointer m_Tree;
+
+  /** Noisy image of two bright discs, whose borders are the cheapest paths.*/
+  static ImageType::Pointer CreateImage(unsigned int size)
+  {
+    ImageType::SizeType imageSize;
+    imageSize.Fill(size);
+
+    auto image = ImageType::New();
+    image->SetRegions(ImageType::RegionType(imageSize));
+    image->Allocate();
+
+    std::mt19937 generator(42);
+    std::normal_distribution<float> noise(0.0f, 5.0f);
+
+    const double radius = size / 4.0;
+
+    itk::ImageRegionIteratorWithIndex<ImageType> it(image, image->GetLargestPossibleRegion());
+    for (it.GoToBegin(); !it.IsAtEnd(); ++it)
+    {
+      const auto index = it.GetIndex();
+      const double dx1 = index[0] - size / 3.0, dy1 = index[1] - size / 2.0;
+      const double dx2 = index[0] - 2.0 * size / 3.0, dy2 = index[1] - size / 3.0;
+      const bool isInside = std::sqrt(dx1 * dx1 + dy1 * dy1) < radius || std::sqrt(dx2 * dx2 + dy2 * dy2) < radius / 2.0;
+
+      it.Set((isInside ? 200.0f : 50.0f) + noise(generator));
+    }
+
+    return image;
+  }
+
+  static IndexType MakeIndex(itk::IndexValueType x, itk::IndexValueType y)
+  {
+    IndexType index;
+    index[0] = x;
+    index[1] = y;
+    return index;
+  }
+
+  void InitializeCostFunction(ImageType *image, const IndexType &start, const IndexType &end)
+  {
+    m_CostFunction = CostFunctionType::New();
+    m_CostFunction->SetImage(image);
+    m_CostFunction->SetStartIndex(start);
+    m_CostFunction->SetEndIndex(end);
+    m_CostFunction->SetRequestedRegion(image->GetLargestPossibleRegion());
+    m_CostFunction->SetUseCostMap(false);
+    m_CostFunction->Initialize();
+
+    m_Tree = itk::LiveWireDijkstraTree::New();
+    m_Tree->SetCostImage(m_CostFunction->GetLocalCostImage());
+    m_Tree->SetMaskImage(m_CostFunction->GetMaskImage());
+    m_Tree->SetRepulsiveCost(CostFunctionType::RepulsiveCost);
+    m_Tree->SetSeed(start);
+  }
+
+  /** Costs of a path according to the (unquantized) cost function.*/
+  double GetCosts(const PathType &path)
+  {
+    double costs = 0.0;
+
+    for (std::size_t i = 1; i < path.size(); ++i)
+      costs += m_CostFunction->GetCost(path[i - 1], path[i]);
+
+    return costs;
+  }
+
+  static bool IsConnected(const PathType &path)
+  {
+    for (std::size_t i = 1; i < path.size(); ++i)
+    {
+      const auto dx = std::abs(path[i][0] - path[i - 1][0]);
+      const auto dy = std::abs(path[i][1] - path[i - 1][1]);
+
+      if (dx > 1 || dy > 1 || (0 == dx && 0 == dy))
+        return false;
+    }
+
+    return true;
+  }
+
+  PathType GetShortestPathImageFilterPath(ImageType *image, const IndexType &start, const IndexType &end)
+  {
+    auto filter = ShortestPathImageFilterType::New();
+    filter->SetInput(image);
+    filter->SetCostFunction(m_CostFunction);
+    filter->SetFullNeighborsMode(true);
+    filter->SetMakeOutputImage(false);
+    filter->SetStartIndex(start);
+    filter->SetEndIndex(end);
+    filter->Update();
+
+    return filter->GetVectorPath();
+  }
+
+public:
+  void tearDown() override
+  {
+    m_CostFunction = nullptr;
+    m_Tree = nullptr;
+  }
+
+  void GetPath_CostsMatchShortestPathImageFilter()
+  {
+    auto image = CreateImage(64);
+    const auto start = MakeIndex(5, 7);
+
+    for (const auto &end : { MakeIndex(60, 58), MakeIndex(32, 10), MakeIndex(6, 50) })
+    {
+      this->InitializeCostFunction(image, start, end);
+
+      const auto path = m_Tree->GetPath(end);
+      const auto referencePath = this->GetShortestPathImageFilterPath(image, start, end);
+
+      CPPUNIT_ASSERT(!path.empty());
+      CPPUNIT_ASSERT(!referencePath.empty());
+
+      const auto costs = this->GetCosts(path);
+      const auto referenceCosts = this->GetCosts(referencePath);
+
+      // quantization may pick a path that is slightly more expensive (at most one quantization step per link)
+      const double tolerance = static_cast<double>(path.size()) / m_Tree->GetCostResolution();
+
+      CPPUNIT_ASSERT_DOUBLES_EQUAL(referenceCosts, costs, tolerance);
+      CPPUNIT_ASSERT_DOUBLES_EQUAL(costs, m_Tree->GetPathCost(end), tolerance);
+    }
+  }
+
+  void GetPath_ConnectsSeedAndEndPoint()
+  {
+    auto image = CreateImage(64);
+    const auto start = MakeIndex(10, 20);
+    const auto end = MakeIndex(50, 40);
+
+    this->InitializeCostFunction(image, start, end);
+
+    const auto path = m_Tree->GetPath(end);
+
+    CPPUNIT_ASSERT(path.size() >= 41);
+    CPPUNIT_ASSERT(path.front() == start);
+    CPPUNIT_ASSERT(path.back() == end);
+    CPPUNIT_ASSERT(IsConnected(path));
+
+    const auto trivialPath = m_Tree->GetPath(start);
+    CPPUNIT_ASSERT_EQUAL(std::size_t(1), trivialPath.size());
+    CPPUNIT_ASSERT(trivialPath.front() == start);
+  }
+
+  void GetPath_AvoidsRepulsivePoints()
+  {
+    auto image = CreateImage(64);
+    const auto start = MakeIndex(10, 32);
+    const auto end = MakeIndex(54, 32);
+
+    this->InitializeCostFunction(image, start, end);
+
+    // wall between start and end point with a gap at the top
+    for (itk::IndexValueType y = 8; y < 64; ++y)
+      m_CostFunction->AddRepulsivePoint(MakeIndex(32, y));
+
+    m_Tree->Reset();
+
+    const auto path = m_Tree->GetPath(end);
+
+    CPPUNIT_ASSERT(IsConnected(path));
+
+    for (const auto &index : path)
+      CPPUNIT_ASSERT_MESSAGE("Path avoids repulsive points.", 0 == m_CostFunction->GetMaskImage()->GetPixel(index));
+
+    const auto isInGap = [](const IndexType &index) { return 32 == index[0] && index[1] < 8; };
+    CPPUNIT_ASSERT_MESSAGE("Path passes the gap of the wall.", std::any_of(path.begin(), path.end(), isInGap));
+
+    m_CostFunction->ClearRepulsivePoints();
+    m_Tree->Reset();
+
+    CPPUNIT_ASSERT(m_Tree->GetPathCost(end) < this->GetCosts(path));
+  }
+
+  void GetPath_ReusesGrownTree()
+  {
+    auto image = CreateImage(64);
+    const auto start = MakeIndex(5, 5);
+    const auto end = MakeIndex(58, 60);
+
+    this->InitializeCostFunction(image, start, end);
+
+    const auto path = m_Tree->GetPath(end);
+    const auto numberOfSettledPixels = m_Tree->GetNumberOfSettledPixels();
+
+    CPPUNIT_ASSERT(numberOfSettledPixels > 0);
+
+    // every pixel on the path is settled, so querying it neither grows the tree nor changes the path
+    const auto &middle = path[path.size() / 2];
+    const auto subPath = m_Tree->GetPath(middle);
+
+    CPPUNIT_ASSERT_EQUAL(numberOfSettledPixels, m_Tree->GetNumberOfSettledPixels());
+    CPPUNIT_ASSERT(std::equal(subPath.begin(), subPath.end(), path.begin()));
+
+    // setting the same seed again keeps the tree
+    m_Tree->SetSeed(start);
+    m_Tree->GetPath(end);
+    CPPUNIT_ASSERT_EQUAL(numberOfSettledPixels, m_Tree->GetNumberOfSettledPixels());
+  }
+
+  void SetSeed_ResetsTree()
+  {
+    auto image = CreateImage(64);
+    const auto end = MakeIndex(40, 40);
+
+    this->InitializeCostFunction(image, MakeIndex(5, 5), end);
+    m_Tree->GetPath(end);
+
+    const auto newSeed = MakeIndex(60, 10);
+    m_Tree->SetSeed(newSeed);
+
+    const auto path = m_Tree->GetPath(end);
+    CPPUNIT_ASSERT(path.front() == newSeed);
+    CPPUNIT_ASSERT(path.back() == end);
+  }
+
+  void GetPath_OutsideOfImage_IsEmpty()
+  {
+    auto image = CreateImage(32);
+    this->InitializeCostFunction(image, MakeIndex(5, 5), MakeIndex(10, 10));
+
+    CPPUNIT_ASSERT(m_Tree->GetPath(MakeIndex(32, 10)).empty());
+    CPPUNIT_ASSERT(m_Tree->GetPath(MakeIndex(-1, 10)).empty());
+    CPPUNIT_ASSERT_EQUAL(-1.0, m_Tree->GetPathCost(MakeIndex(10, 32)));
+
+    m_Tree->SetSeed(MakeIndex(40, 5));
+    CPPUNIT_ASSERT(m_Tree->GetPath(MakeIndex(10, 10)).empty());
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkLiveWireDijkstraTree)
@@ -4,7 +4,8 @@ set(MODULE_TESTS
   mitkPointSetDifferenceStatisticsCalculatorTest.cpp
   mitkImageStatisticsTextureAnalysisTest.cpp
   mitkImageStatisticsContainerTest.cpp
-  mitkImageStatisticsContainerManagerTest.cpp
+  mitkImageStatisticsContainerManagerTest.cpp
+  mitkMultiLabelStatisticsCalculatorTest.cpp
 )
 
 set(MODULE_CUSTOM_TESTS
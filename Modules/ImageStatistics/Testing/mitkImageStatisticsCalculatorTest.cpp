@@ -20,6 +20,12 @@ found in the LICENSE file.
 #include <mitkPlanarFigureMaskGenerator.h>
 #include <mitkImageMaskGenerator.h>
 #include <mitkImageStatisticsConstants.h>
+#include <mitkImagePixelWriteAccessor.h>
+#include <mitkITKImageImport.h>
+
+#include <itkImageRegionIteratorWithIndex.h>
+
+#include <random>
 
 /**
  * \brief Test class for mitkImageStatisticsCalculator
@@ -54,6 +60,7 @@ class mitkImageStatisticsCalculatorTestSuite : public mitk::TestFixture
   MITK_TEST(TestUS4DCroppedPlanarFigureTimeStep1);
   MITK_TEST(TestUS4DCroppedAllTimesteps);
   MITK_TEST(TestUS4DCropped3DMask);
+  MITK_TEST(TestIncrementalUpdate);
   CPPUNIT_TEST_SUITE_END();
 
 public:
@@ -84,6 +91,8 @@ public:
   void TestUS4DCroppedPlanarFigureTimeStep1();
   void TestUS4DCroppedAllTimesteps();
   void TestUS4DCropped3DMask();
+
+  void TestIncrementalUpdate();
 private:
   mitk::Image::ConstPointer m_TestImage;
 
@@ -127,6 +136,9 @@ private:
   void VerifyStatistics(mitk::ImageStatisticsContainer::ImageStatisticsObject stats,
     mitk::ImageStatisticsContainer::RealType testMean, mitk::ImageStatisticsContainer::RealType testSD, mitk::ImageStatisticsContainer::RealType testMedian = 0);
 
+  // compares the statistics of all labels of an incremental update with a complete computation
+  void VerifyIncrementalStatistics(const mitk::ImageStatisticsContainer* incrementalStatistics, mitk::Image::ConstPointer image, mitk::Image::Pointer mask);
+
   // T26098 histogram statistics need to be tested (median, uniformity, UPP, entropy)
   void VerifyStatistics(mitk::ImageStatisticsContainer::ImageStatisticsObject stats,
     mitk::ImageStatisticsContainer::VoxelCountType N,
@@ -1053,6 +1065,162 @@ mitk::PlanarPolygon::Pointer mitkImageStatisticsCalculatorTestSuite::GeneratePla
   return figure;
 }
 
+void mitkImageStatisticsCalculatorTestSuite::TestIncrementalUpdate()
+{
+  MITK_INFO << std::endl << "Test incremental update:-----------------------------------------------------------------------------------";
+
+  using ImageType = itk::Image<short, 3>;
+  using MaskType = itk::Image<unsigned short, 3>;
+
+  ImageType::SizeType size = { { 24, 20, 16 } };
+  ImageType::RegionType region(size);
+
+  auto itkImage = ImageType::New();
+  itkImage->SetRegions(region);
+  itkImage->Allocate();
+
+  auto itkMask = MaskType::New();
+  itkMask->SetRegions(region);
+  itkMask->Allocate();
+
+  std::mt19937 generator(42);
+  std::uniform_int_distribution<int> distribution(-1000, 1000);
+
+  itk::ImageRegionIteratorWithIndex<ImageType> imageIter(itkImage, region);
+  itk::ImageRegionIteratorWithIndex<MaskType> maskIter(itkMask, region);
+  for (; !imageIter.IsAtEnd(); ++imageIter, ++maskIter)
+  {
+    imageIter.Set(static_cast<short>(distribution(generator)));
+    const auto index = maskIter.GetIndex();
+    maskIter.Set(index[0] < 12 && index[2] > 2 ? 1 : (index[1] > 10 ? 2 : 0));
+  }
+
+  mitk::Image::Pointer image = mitk::GrabItkImageMemory(itkImage.GetPointer());
+  mitk::Image::Pointer mask = mitk::GrabItkImageMemory(itkMask.GetPointer());
+
+  mitk::ImageMaskGenerator::Pointer maskGenerator = mitk::ImageMaskGenerator::New();
+  maskGenerator->SetImageMask(mask);
+  maskGenerator->SetInputImage(image);
+
+  mitk::ImageStatisticsCalculator::Pointer calculator = mitk::ImageStatisticsCalculator::New();
+  calculator->SetUseIncrementalUpdate(true);
+  calculator->SetInputImage(image);
+  calculator->SetMask(maskGenerator.GetPointer());
+
+  mitk::ImageStatisticsContainer::Pointer statistics;
+  CPPUNIT_ASSERT_NO_THROW(statistics = calculator->GetStatistics());
+  VerifyIncrementalStatistics(statistics, image.GetPointer(), mask);
+
+  // unchanged inputs keep the statistics
+  CPPUNIT_ASSERT_MESSAGE("Statistics were recomputed without modification", statistics.GetPointer() == calculator->GetStatistics());
+
+  // paint into one slice of the mask (including a new label) without reporting the slice
+  {
+    mitk::ImagePixelWriteAccessor<unsigned short, 3> maskAccessor(mask);
+    for (itk::IndexValueType x = 0; x < 20; ++x)
+    {
+      for (itk::IndexValueType y = 5; y < 15; ++y)
+      {
+        maskAccessor.SetPixelByIndex({ { x, y, 7 } }, x < 10 ? 3 : 2);
+      }
+    }
+  }
+  mask->Modified();
+
+  CPPUNIT_ASSERT_NO_THROW(statistics = calculator->GetStatistics());
+  CPPUNIT_ASSERT_MESSAGE("Painted label is missing", statistics->StatisticsExist(3, 0));
+  VerifyIncrementalStatistics(statistics, image.GetPointer(), mask);
+
+  // paint into another slice and report it like a segmentation tool does
+  {
+    mitk::ImagePixelWriteAccessor<unsigned short, 3> maskAccessor(mask);
+    for (itk::IndexValueType x = 4; x < 16; ++x)
+    {
+      for (itk::IndexValueType y = 0; y < 8; ++y)
+      {
+        maskAccessor.SetPixelByIndex({ { x, y, 10 } }, 4);
+      }
+    }
+  }
+  mask->Modified();
+
+  auto maskSliceGeometry = mitk::PlaneGeometry::New();
+  maskSliceGeometry->InitializeStandardPlane(mask->GetGeometry(), mitk::AnatomicalPlane::Axial, 10, true, false);
+  mask->InvokeEvent(mitk::ImageRegionModifiedEvent(0, maskSliceGeometry));
+
+  CPPUNIT_ASSERT_NO_THROW(statistics = calculator->GetStatistics());
+  CPPUNIT_ASSERT_MESSAGE("Reported label is missing", statistics->StatisticsExist(4, 0));
+  VerifyIncrementalStatistics(statistics, image.GetPointer(), mask);
+
+  // modify the image in one slice and report the slice like an undo operation would do
+  {
+    mitk::ImagePixelWriteAccessor<short, 3> imageAccessor(image);
+    for (itk::IndexValueType x = 0; x < 24; ++x)
+    {
+      imageAccessor.SetPixelByIndex({ { x, 12, 4 } }, 2000);
+    }
+  }
+  image->Modified();
+
+  auto sliceGeometry = mitk::PlaneGeometry::New();
+  sliceGeometry->InitializeStandardPlane(image->GetGeometry(), mitk::AnatomicalPlane::Axial, 4, true, false);
+  calculator->NotifySliceModified(0, sliceGeometry);
+
+  CPPUNIT_ASSERT_NO_THROW(statistics = calculator->GetStatistics());
+  VerifyIncrementalStatistics(statistics, image.GetPointer(), mask);
+
+  // a modification without notification triggers the update of all slices
+  {
+    mitk::ImagePixelWriteAccessor<short, 3> imageAccessor(image);
+    imageAccessor.SetPixelByIndex({ { 3, 3, 13 } }, -2000);
+  }
+  image->Modified();
+
+  CPPUNIT_ASSERT_NO_THROW(statistics = calculator->GetStatistics());
+  VerifyIncrementalStatistics(statistics, image.GetPointer(), mask);
+}
+
+void mitkImageStatisticsCalculatorTestSuite::VerifyIncrementalStatistics(const mitk::ImageStatisticsContainer* incrementalStatistics, mitk::Image::ConstPointer image, mitk::Image::Pointer mask)
+{
+  mitk::ImageMaskGenerator::Pointer maskGenerator = mitk::ImageMaskGenerator::New();
+  maskGenerator->SetImageMask(mask);
+  maskGenerator->SetInputImage(image);
+
+  auto expectedStatistics = ComputeStatistics(image, maskGenerator.GetPointer());
+
+  const auto labels = expectedStatistics->GetExistingLabelValues();
+  CPPUNIT_ASSERT_MESSAGE("Incremental update yields different labels", labels == incrementalStatistics->GetExistingLabelValues());
+
+  const std::vector<std::string> realStatistics = { mitk::ImageStatisticsConstants::MEAN(),
+    mitk::ImageStatisticsConstants::STANDARDDEVIATION(), mitk::ImageStatisticsConstants::VARIANCE(),
+    mitk::ImageStatisticsConstants::SKEWNESS(), mitk::ImageStatisticsConstants::KURTOSIS(),
+    mitk::ImageStatisticsConstants::MINIMUM(), mitk::ImageStatisticsConstants::MAXIMUM(),
+    mitk::ImageStatisticsConstants::RMS(), mitk::ImageStatisticsConstants::MPP(), mitk::ImageStatisticsConstants::VOLUME(),
+    mitk::ImageStatisticsConstants::MEDIAN(), mitk::ImageStatisticsConstants::ENTROPY(),
+    mitk::ImageStatisticsConstants::UNIFORMITY(), mitk::ImageStatisticsConstants::UPP() };
+
+  for (const auto label : labels)
+  {
+    const auto expected = expectedStatistics->GetStatistics(label, 0);
+    const auto incremental = incrementalStatistics->GetStatistics(label, 0);
+
+    CPPUNIT_ASSERT_EQUAL(expected.GetValueConverted<mitk::ImageStatisticsContainer::VoxelCountType>(mitk::ImageStatisticsConstants::NUMBEROFVOXELS()),
+      incremental.GetValueConverted<mitk::ImageStatisticsContainer::VoxelCountType>(mitk::ImageStatisticsConstants::NUMBEROFVOXELS()));
+
+    for (const auto &name : realStatistics)
+    {
+      const auto expectedValue = expected.GetValueConverted<mitk::ImageStatisticsContainer::RealType>(name);
+      const auto incrementalValue = incremental.GetValueConverted<mitk::ImageStatisticsContainer::RealType>(name);
+      CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE("Incremental statistic " + name + " differs", expectedValue, incrementalValue, 1e-6 * std::max(1., std::abs(expectedValue)));
+    }
+
+    for (unsigned int bin = 0; bin < expected.m_Histogram->GetSize(0); ++bin)
+    {
+      CPPUNIT_ASSERT_EQUAL(expected.m_Histogram->GetFrequency(bin), incremental.m_Histogram->GetFrequency(bin));
+    }
+  }
+}
+
 void mitkImageStatisticsCalculatorTestSuite::VerifyStatistics(mitk::ImageStatisticsContainer::ImageStatisticsObject stats,
   mitk::ImageStatisticsContainer::RealType testMean, mitk::ImageStatisticsContainer::RealType testSD, mitk::ImageStatisticsContainer::RealType testMedian)
 {
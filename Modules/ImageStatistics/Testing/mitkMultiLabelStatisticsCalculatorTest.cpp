@@ -0,0 +1,223 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include <mitkMultiLabelStatisticsCalculator.h>
+#include <mitkLabelStatisticsImageFilter.h>
+#include <mitkMinMaxLabelmageFilterWithIndex.h>
+#include <mitkTestFixture.h>
+#include <mitkTestingMacros.h>
+
+#include <itkImageRegionIteratorWithIndex.h>
+
+#include <random>
+#include <unordered_map>
+
+/**
+ * \brief Test class for mitk::MultiLabelStatisticsCalculator
+ *
+ * Compares the single pass statistics with the results of MinMaxLabelImageFilterWithIndex and
+ * LabelStatisticsImageFilter, which need two passes.
+ */
+class mitkMultiLabelStatisticsCalculatorTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkMultiLabelStatisticsCalculatorTestSuite);
+  MITK_TEST(TestIntegralImage);
+  MITK_TEST(TestFloatingPointImage);
+  MITK_TEST(TestValueRangeTooSmall);
+  MITK_TEST(TestWithoutLabelImage);
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+  using LabelImageType = itk::Image<mitk::Label::PixelType, 3>;
+
+  template <typename TImage>
+  typename TImage::Pointer CreateRandomImage(typename TImage::SizeType size, double minimum, double maximum)
+  {
+    auto image = TImage::New();
+    image->SetRegions(size);
+    image->Allocate();
+
+    std::mt19937 generator(17);
+    std::uniform_real_distribution<double> distribution(minimum, maximum);
+
+    itk::ImageRegionIterator<TImage> iter(image, image->GetLargestPossibleRegion());
+    for (; !iter.IsAtEnd(); ++iter)
+      iter.Set(static_cast<typename TImage::PixelType>(distribution(generator)));
+
+    return image;
+  }
+
+  /** Labels are blocks along x, so every label has a different value range and position.*/
+  LabelImageType::Pointer CreateLabelImage(LabelImageType::SizeType size, unsigned int numberOfLabels)
+  {
+    auto labelImage = LabelImageType::New();
+    labelImage->SetRegions(size);
+    labelImage->Allocate();
+
+    itk::ImageRegionIteratorWithIndex<LabelImageType> iter(labelImage, labelImage->GetLargestPossibleRegion());
+    for (; !iter.IsAtEnd(); ++iter)
+    {
+      const auto index = iter.GetIndex();
+      const auto position = (index[2] * size[1] + index[1]) * size[0] + index[0];
+      iter.Set(static_cast<mitk::Label::PixelType>(position % (numberOfLabels + 1)));
+    }
+
+    return labelImage;
+  }
+
+  template <typename TImage>
+  void CompareWithLabelStatisticsImageFilter(const TImage *image, const LabelImageType *labelImage,
+    const mitk::MultiLabelStatisticsCalculator<TImage> *calculator)
+  {
+    using MinMaxFilterType = itk::MinMaxLabelImageFilterWithIndex<TImage, LabelImageType>;
+    using StatisticsFilterType = mitk::LabelStatisticsImageFilter<TImage>;
+    using LabelPixelType = mitk::Label::PixelType;
+    using RealType = typename StatisticsFilterType::RealType;
+
+    auto minMaxFilter = MinMaxFilterType::New();
+    minMaxFilter->SetInput(image);
+    minMaxFilter->SetLabelInput(labelImage);
+    minMaxFilter->UpdateLargestPossibleRegion();
+
+    std::unordered_map<LabelPixelType, unsigned int> sizes;
+    std::unordered_map<LabelPixelType, RealType> lowerBounds, upperBounds;
+    for (auto label : minMaxFilter->GetRelevantLabels())
+    {
+      sizes[label] = calculator->GetNumberOfBins();
+      lowerBounds[label] = minMaxFilter->GetMin(label);
+      upperBounds[label] = minMaxFilter->GetMax(label);
+    }
+
+    auto statisticsFilter = StatisticsFilterType::New();
+    statisticsFilter->SetInput(image);
+    statisticsFilter->SetLabelInput(labelImage);
+    statisticsFilter->SetHistogramParameters(sizes, lowerBounds, upperBounds);
+    statisticsFilter->Update();
+
+    CPPUNIT_ASSERT_EQUAL(statisticsFilter->GetNumberOfLabels() - 1, static_cast<unsigned int>(calculator->GetLabels().size()));
+
+    for (auto label : calculator->GetLabels())
+    {
+      const auto &statistics = calculator->GetStatistics(label);
+      const auto tolerance = 1e-9;
+
+      CPPUNIT_ASSERT_EQUAL(static_cast<itk::SizeValueType>(statisticsFilter->GetCount(label)), statistics.m_Count);
+      CPPUNIT_ASSERT_DOUBLES_EQUAL(statisticsFilter->GetMinimum(label), statistics.m_Min, tolerance);
+      CPPUNIT_ASSERT_DOUBLES_EQUAL(statisticsFilter->GetMaximum(label), statistics.m_Max, tolerance);
+      CPPUNIT_ASSERT_EQUAL(minMaxFilter->GetMinIndex(label), statistics.m_MinIndex);
+      CPPUNIT_ASSERT_EQUAL(minMaxFilter->GetMaxIndex(label), statistics.m_MaxIndex);
+      CPPUNIT_ASSERT_DOUBLES_EQUAL(statisticsFilter->GetMean(label), statistics.m_Mean, tolerance * std::abs(statistics.m_Mean) + tolerance);
+      CPPUNIT_ASSERT_DOUBLES_EQUAL(statisticsFilter->GetSigma(label), statistics.m_Sigma, tolerance * statistics.m_Sigma);
+      CPPUNIT_ASSERT_DOUBLES_EQUAL(statisticsFilter->GetSkewness(label), statistics.m_Skewness, 1e-6);
+      CPPUNIT_ASSERT_DOUBLES_EQUAL(statisticsFilter->GetKurtosis(label), statistics.m_Kurtosis, 1e-6);
+      CPPUNIT_ASSERT_DOUBLES_EQUAL(statisticsFilter->GetMPP(label), statistics.m_MPP, tolerance * std::abs(statistics.m_MPP));
+      CPPUNIT_ASSERT_DOUBLES_EQUAL(statisticsFilter->GetMedian(label), statistics.m_Median, tolerance);
+      CPPUNIT_ASSERT_DOUBLES_EQUAL(statisticsFilter->GetEntropy(label), statistics.m_Entropy, tolerance);
+      CPPUNIT_ASSERT_DOUBLES_EQUAL(statisticsFilter->GetUniformity(label), statistics.m_Uniformity, tolerance);
+
+      const auto expectedHistogram = statisticsFilter->GetHistogram(label);
+      CPPUNIT_ASSERT_EQUAL(expectedHistogram->GetSize(0), statistics.m_Histogram->GetSize(0));
+      for (unsigned int bin = 0; bin < expectedHistogram->GetSize(0); ++bin)
+      {
+        CPPUNIT_ASSERT_EQUAL(expectedHistogram->GetFrequency(bin), statistics.m_Histogram->GetFrequency(bin));
+      }
+    }
+  }
+
+public:
+  void TestIntegralImage()
+  {
+    using ImageType = itk::Image<short, 3>;
+    ImageType::SizeType size = { { 40, 30, 20 } };
+
+    auto image = CreateRandomImage<ImageType>(size, -1024, 3071);
+    auto labelImage = CreateLabelImage(size, 25);
+
+    auto calculator = mitk::MultiLabelStatisticsCalculator<ImageType>::New();
+    calculator->SetImage(image);
+    calculator->SetLabelImage(labelImage);
+    calculator->SetIgnoredLabel(0);
+    calculator->IgnoreLabelOn();
+    calculator->SetValueRange(-1024, 3071);
+    calculator->Compute();
+
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Exact fixed bins need a single pass", 1u, calculator->GetNumberOfPasses());
+    CPPUNIT_ASSERT_EQUAL(std::size_t(25), calculator->GetLabels().size());
+    CPPUNIT_ASSERT(!calculator->HasLabel(0));
+
+    CompareWithLabelStatisticsImageFilter<ImageType>(image, labelImage, calculator);
+  }
+
+  void TestFloatingPointImage()
+  {
+    using ImageType = itk::Image<float, 3>;
+    ImageType::SizeType size = { { 40, 30, 20 } };
+
+    auto image = CreateRandomImage<ImageType>(size, -5, 5);
+    auto labelImage = CreateLabelImage(size, 7);
+
+    auto calculator = mitk::MultiLabelStatisticsCalculator<ImageType>::New();
+    calculator->SetImage(image);
+    calculator->SetLabelImage(labelImage);
+    calculator->SetIgnoredLabel(0);
+    calculator->IgnoreLabelOn();
+    calculator->SetNumberOfBins(50);
+    calculator->Compute();
+
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Floating point values need value range and histogram passes", 3u, calculator->GetNumberOfPasses());
+
+    CompareWithLabelStatisticsImageFilter<ImageType>(image, labelImage, calculator);
+  }
+
+  void TestValueRangeTooSmall()
+  {
+    using ImageType = itk::Image<unsigned char, 3>;
+    ImageType::SizeType size = { { 16, 16, 16 } };
+
+    auto image = CreateRandomImage<ImageType>(size, 0, 255);
+    auto labelImage = CreateLabelImage(size, 3);
+
+    auto calculator = mitk::MultiLabelStatisticsCalculator<ImageType>::New();
+    calculator->SetImage(image);
+    calculator->SetLabelImage(labelImage);
+    calculator->SetIgnoredLabel(0);
+    calculator->IgnoreLabelOn();
+    calculator->SetValueRange(10, 200);
+    calculator->Compute();
+
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Values outside of the range need the histogram pass", 2u, calculator->GetNumberOfPasses());
+
+    CompareWithLabelStatisticsImageFilter<ImageType>(image, labelImage, calculator);
+  }
+
+  void TestWithoutLabelImage()
+  {
+    using ImageType = itk::Image<short, 2>;
+    ImageType::SizeType size = { { 64, 48 } };
+
+    auto image = CreateRandomImage<ImageType>(size, -100, 100);
+
+    auto calculator = mitk::MultiLabelStatisticsCalculator<ImageType>::New();
+    calculator->SetImage(image);
+    calculator->Compute();
+
+    CPPUNIT_ASSERT_EQUAL(std::size_t(1), calculator->GetLabels().size());
+
+    const auto &statistics = calculator->GetStatistics(mitk::Label::UNLABELED_VALUE);
+    CPPUNIT_ASSERT_EQUAL(static_cast<itk::SizeValueType>(64 * 48), statistics.m_Count);
+    CPPUNIT_ASSERT_EQUAL(image->GetPixel(statistics.m_MinIndex), static_cast<short>(statistics.m_Min));
+    CPPUNIT_ASSERT_EQUAL(image->GetPixel(statistics.m_MaxIndex), static_cast<short>(statistics.m_Max));
+    CPPUNIT_ASSERT_EQUAL(static_cast<double>(statistics.m_Count), statistics.m_Histogram->GetTotalFrequency());
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkMultiLabelStatisticsCalculator)
@@ -27,6 +27,7 @@ set(H_FILES
   mitkPointSetStatisticsCalculator.h
   mitkStatisticsImageFilter.h
   mitkLabelStatisticsImageFilter.h
+  mitkMultiLabelStatisticsCalculator.h
   mitkHotspotMaskGenerator.h
   mitkMaskGenerator.h
   mitkPlanarFigureMaskGenerator.h
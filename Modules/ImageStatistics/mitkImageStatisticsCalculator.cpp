@@ -11,8 +11,6 @@ found in the LICENSE file.
 ============================================================================*/
 
 #include "mitkImageStatisticsCalculator.h"
-#include <mitkLabelStatisticsImageFilter.h>
-#include <mitkStatisticsImageFilter.h>
 #include <mitkImage.h>
 #include <mitkImageAccessByItk.h>
 #include <mitkImageCast.h>
@@ -20,10 +18,16 @@ found in the LICENSE file.
 #include <mitkImageTimeSelector.h>
 #include <mitkImageToItk.h>
 #include <mitkMaskUtilities.h>
-#include <mitkMinMaxImageFilterWithIndex.h>
-#include <mitkMinMaxLabelmageFilterWithIndex.h>
+#include <mitkMultiLabelStatisticsCalculator.h>
 #include <mitkitkMaskImageFilter.h>
 #include <mitkNodePredicateGeometry.h>
+#include <mitkHistogramStatisticsCalculator.h>
+
+#include <itkMultiThreaderBase.h>
+
+#include <algorithm>
+#include <atomic>
+#include <limits>
 
 namespace mitk
 {
@@ -91,6 +95,94 @@ namespace mitk
 
   double ImageStatisticsCalculator::GetBinSizeForHistogramStatistics() const { return m_binSizeForHistogramStatistics; }
 
+  void ImageStatisticsCalculator::SetUseIncrementalUpdate(bool useIncrementalUpdate)
+  {
+    if (useIncrementalUpdate != m_UseIncrementalUpdate)
+    {
+      m_UseIncrementalUpdate = useIncrementalUpdate;
+      m_SlicePartialStatistics.clear();
+      this->UpdateModificationObservers({});
+
+      std::lock_guard<std::mutex> lock(m_SliceModificationsMutex);
+      m_SliceModifications.clear();
+    }
+  }
+
+  bool ImageStatisticsCalculator::GetUseIncrementalUpdate() const { return m_UseIncrementalUpdate; }
+
+  void ImageStatisticsCalculator::NotifySliceModified(TimeStepType timeStep, const BaseGeometry *geometry)
+  {
+    if (m_UseIncrementalUpdate && nullptr != geometry)
+    {
+      SliceModification modification;
+      modification.TimeStep = timeStep;
+      modification.Geometry = geometry;
+
+      std::lock_guard<std::mutex> lock(m_SliceModificationsMutex);
+      m_SliceModifications.push_back(modification);
+    }
+  }
+
+  void ImageStatisticsCalculator::UpdateModificationObservers(const std::vector<const mitk::Image*>& images)
+  {
+    std::map<const mitk::Image*, ITKEventObserverGuard> observers;
+
+    for (const auto image : images)
+    {
+      if (observers.count(image) > 0)
+        continue;
+
+      auto finding = m_ModificationObservers.find(image);
+      if (finding != m_ModificationObservers.end())
+      {
+        observers.emplace(image, std::move(finding->second));
+        continue;
+      }
+
+      observers.emplace(image, ITKEventObserverGuard(image, ImageRegionModifiedEvent(), [this, image](const itk::EventObject& event)
+      {
+        const auto regionEvent = dynamic_cast<const ImageRegionModifiedEvent*>(&event);
+        if (nullptr == regionEvent || nullptr == regionEvent->GetGeometry())
+          return;
+
+        SliceModification modification;
+        modification.Image = image;
+        modification.ImageMTime = image->GetMTime();
+        modification.TimeStep = regionEvent->GetTimeStep();
+        modification.Geometry = regionEvent->GetGeometry();
+
+        std::lock_guard<std::mutex> lock(m_SliceModificationsMutex);
+        m_SliceModifications.push_back(modification);
+      }));
+    }
+
+    // guards of images that are not used anymore remove their observers
+    m_ModificationObservers = std::move(observers);
+  }
+
+  void ImageStatisticsCalculator::SelectInternalImages(TimeStepType timeStep, unsigned int maskID)
+  {
+    if (m_MaskGenerator.IsNotNull())
+    {
+      m_MaskGenerator->SetTimePoint(m_Image->GetTimeGeometry()->TimeStepToTimePoint(timeStep));
+      m_InternalMask = m_MaskGenerator->GetMask(maskID);
+      if (m_MaskGenerator->GetReferenceImage().IsNotNull())
+      {
+        m_InternalImageForStatistics = m_MaskGenerator->GetReferenceImage();
+      }
+      else
+      {
+        m_InternalImageForStatistics = m_Image;
+      }
+    }
+    else
+    {
+      m_InternalImageForStatistics = m_Image;
+    }
+
+    m_ImageTimeSlice = SelectImageByTimeStep(m_InternalImageForStatistics, timeStep);
+  }
+
   mitk::ImageStatisticsContainer* ImageStatisticsCalculator::GetStatistics()
   {
     if (m_Image.IsNull())
@@ -103,6 +195,18 @@ namespace mitk
       mitkThrow() << "Image not initialized!";
     }
 
+    if (m_UseIncrementalUpdate && m_MaskGenerator.IsNotNull() && m_SecondaryMaskGenerator.IsNull())
+    {
+      if (this->UpdateStatisticsIncrementally())
+      {
+        return m_StatisticContainer;
+      }
+
+      // The inputs are not supported by the incremental update. Modifications of the mask pixels do not change the
+      // time stamps checked by IsUpdateRequired(), so the complete computation has to be done unconditionally.
+      m_StatisticContainer = nullptr;
+    }
+
     if (IsUpdateRequired())
     {
       auto timeGeometry = m_Image->GetTimeGeometry();
@@ -129,25 +233,7 @@ namespace mitk
 
         for (unsigned int maskID = 0; maskID < numbersOfMasks; ++maskID)
         {
-          if (m_MaskGenerator.IsNotNull())
-          {
-            m_MaskGenerator->SetTimePoint(timePoint);
-            m_InternalMask = m_MaskGenerator->GetMask(maskID);
-            if (m_MaskGenerator->GetReferenceImage().IsNotNull())
-            {
-              m_InternalImageForStatistics = m_MaskGenerator->GetReferenceImage();
-            }
-            else
-            {
-              m_InternalImageForStatistics = m_Image;
-            }
-          }
-          else
-          {
-            m_InternalImageForStatistics = m_Image;
-          }
-
-          m_ImageTimeSlice = SelectImageByTimeStep(m_InternalImageForStatistics, timeStep);
+          this->SelectInternalImages(timeStep, maskID);
 
           // Calculate statistics with/without mask
           if (m_MaskGenerator.IsNull() && m_SecondaryMaskGenerator.IsNull())
@@ -172,100 +258,86 @@ namespace mitk
     const itk::Image<TPixel, VImageDimension> *image, TimeStepType timeStep)
   {
     typedef typename itk::Image<TPixel, VImageDimension> ImageType;
-    typedef typename mitk::StatisticsImageFilter<ImageType> ImageStatisticsFilterType;
-    typedef typename itk::MinMaxImageFilterWithIndex<ImageType> MinMaxFilterType;
+    typedef MultiLabelStatisticsCalculator<ImageType> StatisticsCalculatorType;
 
     auto statObj = ImageStatisticsContainer::ImageStatisticsObject();
 
-    typename ImageStatisticsFilterType::Pointer statisticsFilter = ImageStatisticsFilterType::New();
-    statisticsFilter->SetInput(image);
-    statisticsFilter->SetCoordinateTolerance(NODE_PREDICATE_GEOMETRY_DEFAULT_CHECK_COORDINATE_PRECISION);
-    statisticsFilter->SetDirectionTolerance(NODE_PREDICATE_GEOMETRY_DEFAULT_CHECK_DIRECTION_PRECISION);
-
-    // TODO: this is single threaded. Implement our own image filter that does this multi threaded
-    //        typename itk::MinimumMaximumImageCalculator<ImageType>::Pointer imgMinMaxFilter =
-    //        itk::MinimumMaximumImageCalculator<ImageType>::New(); imgMinMaxFilter->SetImage(image);
-    //        imgMinMaxFilter->Compute();
-    vnl_vector<int> minIndex, maxIndex;
+    // moments, extrema and histogram are computed in one pass (without label image all pixels have the same label)
+    typename StatisticsCalculatorType::Pointer statisticsCalculator = StatisticsCalculatorType::New();
+    statisticsCalculator->SetImage(image);
+    this->InitializeStatisticsCalculator(statisticsCalculator.GetPointer(), timeStep);
 
-    typename MinMaxFilterType::Pointer minMaxFilter = MinMaxFilterType::New();
-    minMaxFilter->SetInput(image);
-    minMaxFilter->UpdateLargestPossibleRegion();
-    typename ImageType::PixelType minval = minMaxFilter->GetMin();
-    typename ImageType::PixelType maxval = minMaxFilter->GetMax();
+    try
+    {
+      statisticsCalculator->Compute();
+    }
+    catch (const itk::ExceptionObject &e)
+    {
+      mitkThrow() << "Image statistics calculation failed due to following ITK Exception: \n " << e.what();
+    }
 
-    typename ImageType::IndexType tmpMinIndex = minMaxFilter->GetMinIndex();
-    typename ImageType::IndexType tmpMaxIndex = minMaxFilter->GetMaxIndex();
+    const auto &statistics = statisticsCalculator->GetStatistics(Label::UNLABELED_VALUE);
 
-    //        typename ImageType::IndexType tmpMinIndex = imgMinMaxFilter->GetIndexOfMinimum();
-    //        typename ImageType::IndexType tmpMaxIndex = imgMinMaxFilter->GetIndexOfMaximum();
+    vnl_vector<int> minIndex, maxIndex;
 
-    minIndex.set_size(tmpMaxIndex.GetIndexDimension());
-    maxIndex.set_size(tmpMaxIndex.GetIndexDimension());
+    minIndex.set_size(statistics.m_MaxIndex.GetIndexDimension());
+    maxIndex.set_size(statistics.m_MaxIndex.GetIndexDimension());
 
-    for (unsigned int i = 0; i < tmpMaxIndex.GetIndexDimension(); i++)
+    for (unsigned int i = 0; i < statistics.m_MaxIndex.GetIndexDimension(); i++)
     {
-      minIndex[i] = tmpMinIndex[i];
-      maxIndex[i] = tmpMaxIndex[i];
+      minIndex[i] = statistics.m_MinIndex[i];
+      maxIndex[i] = statistics.m_MaxIndex[i];
     }
 
     statObj.AddStatistic(mitk::ImageStatisticsConstants::MINIMUMPOSITION(), minIndex);
     statObj.AddStatistic(mitk::ImageStatisticsConstants::MAXIMUMPOSITION(), maxIndex);
 
-    // convert m_binSize in m_nBins if necessary
-    unsigned int nBinsForHistogram;
-    if (m_UseBinSizeOverNBins)
-    {
-      nBinsForHistogram = std::max(static_cast<double>(std::ceil(maxval - minval)) / m_binSizeForHistogramStatistics,
-                                   10.); // do not allow less than 10 bins
-    }
-    else
-    {
-      nBinsForHistogram = m_nBinsForHistogramStatistics;
-    }
-
-    statisticsFilter->SetHistogramParameters(nBinsForHistogram, minval, maxval);
-
-    try
-    {
-      statisticsFilter->Update();
-    }
-    catch (const itk::ExceptionObject &e)
-    {
-      mitkThrow() << "Image statistics calculation failed due to following ITK Exception: \n " << e.what();
-    }
-
     auto voxelVolume = GetVoxelVolume<TPixel, VImageDimension>(image);
 
     auto numberOfPixels = image->GetLargestPossibleRegion().GetNumberOfPixels();
     auto volume = static_cast<double>(numberOfPixels) * voxelVolume;
-    auto variance = statisticsFilter->GetSigma() * statisticsFilter->GetSigma();
-    auto rms =
-      std::sqrt(std::pow(statisticsFilter->GetMean(), 2.) + statisticsFilter->GetVariance()); // variance = sigma^2
+    auto variance = statistics.m_Sigma * statistics.m_Sigma;
+    auto rms = std::sqrt(std::pow(statistics.m_Mean, 2.) + statistics.m_Variance); // variance = sigma^2
 
     statObj.AddStatistic(ImageStatisticsConstants::NUMBEROFVOXELS(),
                          static_cast<ImageStatisticsContainer::VoxelCountType>(numberOfPixels));
     statObj.AddStatistic(ImageStatisticsConstants::VOLUME(), volume);
-    statObj.AddStatistic(ImageStatisticsConstants::MEAN(), statisticsFilter->GetMean());
-    statObj.AddStatistic(ImageStatisticsConstants::MINIMUM(),
-                         static_cast<ImageStatisticsContainer::RealType>(statisticsFilter->GetMinimum()));
-    statObj.AddStatistic(ImageStatisticsConstants::MAXIMUM(),
-                         static_cast<ImageStatisticsContainer::RealType>(statisticsFilter->GetMaximum()));
-    statObj.AddStatistic(ImageStatisticsConstants::STANDARDDEVIATION(), statisticsFilter->GetSigma());
+    statObj.AddStatistic(ImageStatisticsConstants::MEAN(), statistics.m_Mean);
+    statObj.AddStatistic(ImageStatisticsConstants::MINIMUM(), static_cast<ImageStatisticsContainer::RealType>(statistics.m_Min));
+    statObj.AddStatistic(ImageStatisticsConstants::MAXIMUM(), static_cast<ImageStatisticsContainer::RealType>(statistics.m_Max));
+    statObj.AddStatistic(ImageStatisticsConstants::STANDARDDEVIATION(), statistics.m_Sigma);
     statObj.AddStatistic(ImageStatisticsConstants::VARIANCE(), variance);
-    statObj.AddStatistic(ImageStatisticsConstants::SKEWNESS(), statisticsFilter->GetSkewness());
-    statObj.AddStatistic(ImageStatisticsConstants::KURTOSIS(), statisticsFilter->GetKurtosis());
+    statObj.AddStatistic(ImageStatisticsConstants::SKEWNESS(), statistics.m_Skewness);
+    statObj.AddStatistic(ImageStatisticsConstants::KURTOSIS(), statistics.m_Kurtosis);
     statObj.AddStatistic(ImageStatisticsConstants::RMS(), rms);
-    statObj.AddStatistic(ImageStatisticsConstants::MPP(), statisticsFilter->GetMPP());
-    statObj.AddStatistic(ImageStatisticsConstants::ENTROPY(), statisticsFilter->GetEntropy());
-    statObj.AddStatistic(ImageStatisticsConstants::MEDIAN(), statisticsFilter->GetMedian());
-    statObj.AddStatistic(ImageStatisticsConstants::UNIFORMITY(), statisticsFilter->GetUniformity());
-    statObj.AddStatistic(ImageStatisticsConstants::UPP(), statisticsFilter->GetUPP());
-    statObj.m_Histogram = statisticsFilter->GetHistogram();
+    statObj.AddStatistic(ImageStatisticsConstants::MPP(), statistics.m_MPP);
+    statObj.AddStatistic(ImageStatisticsConstants::ENTROPY(), statistics.m_Entropy);
+    statObj.AddStatistic(ImageStatisticsConstants::MEDIAN(), statistics.m_Median);
+    statObj.AddStatistic(ImageStatisticsConstants::UNIFORMITY(), statistics.m_Uniformity);
+    statObj.AddStatistic(ImageStatisticsConstants::UPP(), statistics.m_UPP);
+    statObj.m_Histogram = statistics.m_Histogram.GetPointer();
 
     m_StatisticContainer->SetStatistics(ImageStatisticsContainer::NO_MASK_LABEL_VALUE, timeStep, statObj);
   }
 
+  template <typename TStatisticsCalculator>
+  void ImageStatisticsCalculator::InitializeStatisticsCalculator(TStatisticsCalculator *statisticsCalculator,
+                                                                 TimeStepType timeStep)
+  {
+    statisticsCalculator->SetNumberOfBins(m_nBinsForHistogramStatistics);
+    statisticsCalculator->SetBinSize(m_binSizeForHistogramStatistics);
+    statisticsCalculator->SetUseBinSize(m_UseBinSizeOverNBins);
+
+    // The value range of the image is cached by the image itself (it is usually already known for rendering),
+    // it lets the statistics calculator fix its histogram bins before its single pass.
+    if (timeStep < m_InternalImageForStatistics->GetTimeSteps())
+    {
+      auto imageStatistics = m_InternalImageForStatistics->GetStatistics();
+      statisticsCalculator->SetValueRange(imageStatistics->GetScalarValueMin(timeStep),
+                                          imageStatistics->GetScalarValueMax(timeStep));
+    }
+  }
+
   template <typename TPixel, unsigned int VImageDimension>
   double ImageStatisticsCalculator::GetVoxelVolume(const itk::Image<TPixel, VImageDimension> *image) const
   {
@@ -284,10 +356,8 @@ namespace mitk
   {
     typedef itk::Image<TPixel, VImageDimension> ImageType;
     typedef itk::Image<MaskPixelType, VImageDimension> MaskType;
-    typedef typename MaskType::PixelType LabelPixelType;
-    typedef LabelStatisticsImageFilter<ImageType> ImageStatisticsFilterType;
+    typedef MultiLabelStatisticsCalculator<ImageType> StatisticsCalculatorType;
     typedef MaskUtilities<TPixel, VImageDimension> MaskUtilType;
-    typedef typename itk::MinMaxLabelImageFilterWithIndex<ImageType, MaskType> MinMaxLabelFilterType;
 
     // workaround: if m_SecondaryMaskGenerator is not null but m_MaskGenerator is! (this is the case if we request a
     // 'ignore zero valued pixels' mask in the gui but do not define a primary mask)
@@ -358,80 +428,500 @@ namespace mitk
 
     adaptedImage = maskUtil->ExtractMaskImageRegion(); // this also checks mask sanity
 
-    // find min, max, minindex and maxindex
-    typename MinMaxLabelFilterType::Pointer minMaxFilter = MinMaxLabelFilterType::New();
-    minMaxFilter->SetInput(adaptedImage);
-    minMaxFilter->SetLabelInput(maskImage);
-    minMaxFilter->SetCoordinateTolerance(NODE_PREDICATE_GEOMETRY_DEFAULT_CHECK_COORDINATE_PRECISION);
-    minMaxFilter->SetDirectionTolerance(NODE_PREDICATE_GEOMETRY_DEFAULT_CHECK_DIRECTION_PRECISION);
-    minMaxFilter->UpdateLargestPossibleRegion();
+    // moments, extrema and histograms of all labels are computed in one pass
+    typename StatisticsCalculatorType::Pointer statisticsCalculator = StatisticsCalculatorType::New();
+    statisticsCalculator->SetImage(adaptedImage);
+    statisticsCalculator->SetLabelImage(maskImage);
+    // we ignore the background of a mask if we compute mask statistics.
+    statisticsCalculator->SetIgnoredLabel(ImageStatisticsContainer::NO_MASK_LABEL_VALUE);
+    statisticsCalculator->IgnoreLabelOn();
+    this->InitializeStatisticsCalculator(statisticsCalculator.GetPointer(), timeStep);
+    statisticsCalculator->Compute();
+
+    for (auto labelValue : statisticsCalculator->GetLabels())
+    {
+      const auto &statistics = statisticsCalculator->GetStatistics(labelValue);
+      ImageStatisticsContainer::ImageStatisticsObject statObj;
+
+      vnl_vector<int> minIndex, maxIndex;
+      Point3D worldCoordinateMin;
+      Point3D worldCoordinateMax;
+      Point3D indexCoordinateMin;
+      Point3D indexCoordinateMax;
+      m_InternalImageForStatistics->GetGeometry()->IndexToWorld(statistics.m_MinIndex, worldCoordinateMin);
+      m_InternalImageForStatistics->GetGeometry()->IndexToWorld(statistics.m_MaxIndex, worldCoordinateMax);
+      m_Image->GetGeometry()->WorldToIndex(worldCoordinateMin, indexCoordinateMin);
+      m_Image->GetGeometry()->WorldToIndex(worldCoordinateMax, indexCoordinateMax);
+
+      minIndex.set_size(3);
+      maxIndex.set_size(3);
+
+      // for (unsigned int i=0; i < tmpMaxIndex.GetIndexDimension(); i++)
+      for (unsigned int i = 0; i < 3; i++)
+      {
+        minIndex[i] = indexCoordinateMin[i];
+        maxIndex[i] = indexCoordinateMax[i];
+      }
+
+      statObj.AddStatistic(ImageStatisticsConstants::MINIMUMPOSITION(), minIndex);
+      statObj.AddStatistic(ImageStatisticsConstants::MAXIMUMPOSITION(), maxIndex);
+
+      auto voxelVolume = GetVoxelVolume<TPixel, VImageDimension>(image);
+      auto numberOfVoxels = static_cast<unsigned long>(statistics.m_Count);
+      auto volume = static_cast<double>(numberOfVoxels) * voxelVolume;
+      auto rms = std::sqrt(std::pow(statistics.m_Mean, 2.) + statistics.m_Variance); // variance = sigma^2
+      auto variance = statistics.m_Sigma * statistics.m_Sigma;
 
-    // set histogram parameters for each label individually (min/max may be different for each label)
-    typedef typename std::unordered_map<LabelPixelType, ScalarType> MapType;
+      statObj.AddStatistic(ImageStatisticsConstants::NUMBEROFVOXELS(), numberOfVoxels);
+      statObj.AddStatistic(ImageStatisticsConstants::VOLUME(), volume);
+      statObj.AddStatistic(ImageStatisticsConstants::MEAN(), statistics.m_Mean);
+      statObj.AddStatistic(ImageStatisticsConstants::MINIMUM(), static_cast<ImageStatisticsContainer::RealType>(statistics.m_Min));
+      statObj.AddStatistic(ImageStatisticsConstants::MAXIMUM(), static_cast<ImageStatisticsContainer::RealType>(statistics.m_Max));
+      statObj.AddStatistic(ImageStatisticsConstants::STANDARDDEVIATION(), statistics.m_Sigma);
+      statObj.AddStatistic(ImageStatisticsConstants::VARIANCE(), variance);
+      statObj.AddStatistic(ImageStatisticsConstants::SKEWNESS(), statistics.m_Skewness);
+      statObj.AddStatistic(ImageStatisticsConstants::KURTOSIS(), statistics.m_Kurtosis);
+      statObj.AddStatistic(ImageStatisticsConstants::RMS(), rms);
+      statObj.AddStatistic(ImageStatisticsConstants::MPP(), statistics.m_MPP);
+      statObj.AddStatistic(ImageStatisticsConstants::ENTROPY(), statistics.m_Entropy);
+      statObj.AddStatistic(ImageStatisticsConstants::MEDIAN(), statistics.m_Median);
+      statObj.AddStatistic(ImageStatisticsConstants::UNIFORMITY(), statistics.m_Uniformity);
+      statObj.AddStatistic(ImageStatisticsConstants::UPP(), statistics.m_UPP);
+      statObj.m_Histogram = statistics.m_Histogram.GetPointer();
 
-    std::vector<LabelPixelType> relevantLabels = minMaxFilter->GetRelevantLabels();
-    MapType minVals;
-    MapType maxVals;
-    std::unordered_map<LabelPixelType, unsigned int> nBins;
+      if (m_StatisticContainer->StatisticsExist(labelValue, timeStep))
+        mitkThrow() << "Invalid state/input data. Statistic for a specific label/time step pair was computed more then once. Conflicting label ID: "
+        << labelValue << " ; conflicting time step: " << timeStep;
+      m_StatisticContainer->SetStatistics(labelValue, timeStep, statObj);
+    }
 
-    for (LabelPixelType label : relevantLabels)
+    // swap maskGenerators back
+    if (swapMasks)
     {
-      minVals[label] = static_cast<ScalarType>(minMaxFilter->GetMin(label));
-      maxVals[label] = static_cast<ScalarType>(minMaxFilter->GetMax(label));
+      m_SecondaryMask = m_InternalMask;
+      m_InternalMask = nullptr;
+    }
+  }
 
-      unsigned int nBinsForHistogram;
-      if (m_UseBinSizeOverNBins)
+  bool ImageStatisticsCalculator::UpdateStatisticsIncrementally()
+  {
+    m_IncrementalUpdateSupported = true;
+    m_SlicePartialsModified = this->IsUpdateRequired();
+    m_UpdatedImages.clear();
+
+    // modifications reported while the update is running are kept for the next update
+    std::vector<SliceModification> modifications;
+    {
+      std::lock_guard<std::mutex> lock(m_SliceModificationsMutex);
+      modifications.swap(m_SliceModifications);
+    }
+
+    std::map<SlicePartialStatisticsCacheKey, SlicePartialStatisticsCache> usedCaches;
+
+    for (TimeStepType timeStep = 0; timeStep < m_Image->GetTimeSteps() && m_IncrementalUpdateSupported; timeStep++)
+    {
+      for (unsigned int maskID = 0; maskID < m_MaskGenerator->GetNumberOfMasks(); ++maskID)
+      {
+        this->SelectInternalImages(timeStep, maskID);
+
+        if (m_InternalMask.IsNull() || m_InternalMask->GetDimension() != 3 || m_ImageTimeSlice->GetDimension() != 3)
+        {
+          m_IncrementalUpdateSupported = false;
+          break;
+        }
+
+        AccessByItk_n(m_ImageTimeSlice, InternalUpdateSlicePartials, (timeStep, maskID, modifications));
+
+        if (!m_IncrementalUpdateSupported)
+          break;
+
+        const SlicePartialStatisticsCacheKey key(timeStep, maskID);
+        usedCaches[key] = std::move(m_SlicePartialStatistics[key]);
+      }
+    }
+
+    if (!m_IncrementalUpdateSupported)
+    {
+      m_SlicePartialStatistics.clear();
+      this->UpdateModificationObservers({});
+      return false;
+    }
+
+    this->UpdateModificationObservers(m_UpdatedImages);
+
+    // caches of masks that do not exist anymore are dropped
+    if (usedCaches.size() != m_SlicePartialStatistics.size())
+      m_SlicePartialsModified = true;
+
+    m_SlicePartialStatistics = std::move(usedCaches);
+
+    if (m_SlicePartialsModified)
+    {
+      m_StatisticContainer = ImageStatisticsContainer::New();
+      m_StatisticContainer->SetTimeGeometry(m_Image->GetTimeGeometry()->Clone());
+
+      for (const auto &cache : m_SlicePartialStatistics)
+      {
+        this->MergeSlicePartials(cache.second, cache.first.first);
+      }
+    }
+
+    return true;
+  }
+
+  void ImageStatisticsCalculator::MarkModifiedSlices(const mitk::Image* input, itk::ModifiedTimeType cachedMTime,
+    TimeStepType timeStep, const std::vector<SliceModification>& modifications, std::vector<char>& dirtySlices) const
+  {
+    const auto mTime = input->GetMTime();
+    if (mTime == cachedMTime)
+      return;
+
+    // the modifications only suffice, if the image was not modified after the last reported modification
+    bool reported = false;
+    for (const auto& modification : modifications)
+    {
+      if (modification.TimeStep == timeStep &&
+          (nullptr == modification.Image || (modification.Image == input && modification.ImageMTime >= mTime)))
+      {
+        reported = true;
+        break;
+      }
+    }
+
+    if (!reported)
+    {
+      std::fill(dirtySlices.begin(), dirtySlices.end(), 1);
+      return;
+    }
+
+    const auto numberOfSlices = static_cast<double>(dirtySlices.size());
+    const auto sliceGeometry = m_ImageTimeSlice->GetGeometry();
+
+    for (const auto& modification : modifications)
+    {
+      if (modification.TimeStep != timeStep || (nullptr != modification.Image && modification.Image != input))
+        continue;
+
+      auto minZ = std::numeric_limits<ScalarType>::max();
+      auto maxZ = std::numeric_limits<ScalarType>::lowest();
+      for (unsigned int i = 0; i < 8; ++i)
+      {
+        Point3D indexPoint;
+        sliceGeometry->WorldToIndex(modification.Geometry->GetCornerPoint(i), indexPoint);
+        minZ = std::min(minZ, indexPoint[2]);
+        maxZ = std::max(maxZ, indexPoint[2]);
+      }
+
+      const auto firstSlice = std::max<double>(0., std::floor(minZ));
+      const auto lastSlice = std::min<double>(numberOfSlices - 1., std::ceil(maxZ));
+      for (auto slice = static_cast<itk::IndexValueType>(firstSlice); slice <= lastSlice; ++slice)
+        dirtySlices[slice] = 1;
+    }
+  }
+
+  template <typename TPixel, unsigned int VImageDimension>
+  void ImageStatisticsCalculator::InternalUpdateSlicePartials(const itk::Image<TPixel, VImageDimension> *image,
+    TimeStepType timeStep, unsigned int maskID, const std::vector<SliceModification>& modifications)
+  {
+    if constexpr (VImageDimension != 3)
+    {
+      m_IncrementalUpdateSupported = false;
+    }
+    else
+    {
+      typedef itk::Image<MaskPixelType, 3> MaskType;
+
+      typename MaskType::ConstPointer maskImage;
+      try
+      {
+        maskImage = ImageToItkImage<MaskPixelType, 3>(m_InternalMask);
+      }
+      catch (const itk::ExceptionObject &)
       {
-        nBinsForHistogram =
-          std::max(static_cast<double>(std::ceil(minMaxFilter->GetMax(label) - minMaxFilter->GetMin(label))) /
-                     m_binSizeForHistogramStatistics,
-                   10.); // do not allow less than 10 bins
+        typename MaskType::Pointer noneConstMaskImage;
+        CastToItkImage(m_InternalMask, noneConstMaskImage);
+        maskImage = noneConstMaskImage;
+      }
+
+      const auto region = image->GetBufferedRegion();
+
+      if (maskImage->GetBufferedRegion() != region ||
+          !Equal(*(m_InternalMask->GetGeometry()), *(m_ImageTimeSlice->GetGeometry()),
+                 NODE_PREDICATE_GEOMETRY_DEFAULT_CHECK_COORDINATE_PRECISION,
+                 NODE_PREDICATE_GEOMETRY_DEFAULT_CHECK_DIRECTION_PRECISION, false))
+      {
+        m_IncrementalUpdateSupported = false;
+        return;
+      }
+
+      m_UpdatedImages.push_back(m_InternalImageForStatistics);
+      m_UpdatedImages.push_back(m_InternalMask);
+
+      // the modification times are taken before the pixels are read, so modifications during the update are not lost
+      const auto imageMTime = m_InternalImageForStatistics->GetMTime();
+      const auto maskMTime = m_InternalMask->GetMTime();
+
+      auto valueMin = 0.;
+      auto valueMax = 0.;
+      if (timeStep < m_InternalImageForStatistics->GetTimeSteps())
+      {
+        auto imageStatistics = m_InternalImageForStatistics->GetStatistics();
+        valueMin = imageStatistics->GetScalarValueMin(timeStep);
+        valueMax = imageStatistics->GetScalarValueMax(timeStep);
+      }
+
+      auto &cache = m_SlicePartialStatistics[SlicePartialStatisticsCacheKey(timeStep, maskID)];
+      const auto numberOfSlices = region.GetSize(2);
+
+      // A time step of a 4D mask is a new image on every update, so it is always recomputed completely.
+      // The histogram bins of floating point images depend on the value range.
+      const bool rebuild = cache.Slices.size() != numberOfSlices || cache.Region != region ||
+                           cache.Mask != m_InternalMask || cache.MaskGenerator != m_MaskGenerator.GetPointer() ||
+                           cache.MaskGeneratorMTime != m_MaskGenerator->GetMTime() ||
+                           cache.Image != m_InternalImageForStatistics ||
+                           (!std::numeric_limits<TPixel>::is_integer && (cache.ValueMin != valueMin || cache.ValueMax != valueMax));
+
+      std::vector<char> dirtySlices(numberOfSlices, rebuild ? 1 : 0);
+
+      if (rebuild)
+      {
+        cache.Slices.assign(numberOfSlices, SlicePartialStatistics());
       }
       else
       {
-        nBinsForHistogram = m_nBinsForHistogramStatistics;
+        this->MarkModifiedSlices(m_InternalImageForStatistics, cache.ImageMTime, timeStep, modifications, dirtySlices);
+        this->MarkModifiedSlices(m_InternalMask, cache.MaskMTime, timeStep, modifications, dirtySlices);
       }
 
-      nBins[label] = nBinsForHistogram;
+      const auto sliceSize = region.GetSize(0) * region.GetSize(1);
+      const TPixel *imageBuffer = image->GetBufferPointer();
+      const MaskPixelType *maskBuffer = maskImage->GetBufferPointer();
+      std::atomic<bool> modified(false);
+
+      itk::MultiThreaderBase::New()->ParallelizeArray(
+        0,
+        numberOfSlices,
+        [&](itk::SizeValueType slice) {
+          if (0 == dirtySlices[slice])
+            return;
+
+          ComputeSlicePartialStatistics(imageBuffer + slice * sliceSize,
+                                        maskBuffer + slice * sliceSize,
+                                        region,
+                                        static_cast<itk::IndexValueType>(slice),
+                                        valueMin,
+                                        valueMax,
+                                        cache.Slices[slice]);
+          modified = true;
+        },
+        nullptr);
+
+      if (modified || rebuild)
+        m_SlicePartialsModified = true;
+
+      cache.Image = m_InternalImageForStatistics;
+      cache.ImageMTime = imageMTime;
+      cache.Mask = m_InternalMask;
+      cache.MaskMTime = maskMTime;
+      cache.MaskGenerator = m_MaskGenerator.GetPointer();
+      cache.MaskGeneratorMTime = m_MaskGenerator->GetMTime();
+      cache.Region = region;
+      cache.Geometry = m_InternalImageForStatistics->GetGeometry();
+      cache.VoxelVolume = GetVoxelVolume<TPixel, 3>(image);
+      cache.ValueMin = valueMin;
+      cache.ValueMax = valueMax;
+    }
+  }
+
+  template <typename TPixel>
+  void ImageStatisticsCalculator::ComputeSlicePartialStatistics(const TPixel *image,
+    const MaskPixelType *mask, const itk::ImageRegion<3> &region, itk::IndexValueType slice, double valueMin,
+    double valueMax, SlicePartialStatistics &partials)
+  {
+    partials.clear();
+
+    std::map<MaskPixelType, std::vector<double>> valuesOfLabels;
+    itk::Index<3> index = region.GetIndex();
+    index[2] += slice;
+
+    const auto sizeX = region.GetSize(0);
+    const auto sizeY = region.GetSize(1);
+    const auto binWidth = (valueMax - valueMin) / HistogramResolution;
+    itk::SizeValueType offset = 0;
+
+    for (itk::SizeValueType y = 0; y < sizeY; ++y)
+    {
+      for (itk::SizeValueType x = 0; x < sizeX; ++x, ++offset)
+      {
+        const auto label = mask[offset];
+        if (label == ImageStatisticsContainer::NO_MASK_LABEL_VALUE)
+          continue;
+
+        const auto value = static_cast<double>(image[offset]);
+        auto &partial = partials[label];
+        index[0] = region.GetIndex(0) + x;
+        index[1] = region.GetIndex(1) + y;
+
+        if (0 == partial.Count || value < partial.Min)
+        {
+          partial.Min = value;
+          partial.MinIndex = index;
+        }
+        if (0 == partial.Count || value > partial.Max)
+        {
+          partial.Max = value;
+          partial.MaxIndex = index;
+        }
+
+        const auto squareValue = value * value;
+        partial.Sum += value;
+        partial.SumOfSquares += squareValue;
+        partial.SumOfCubes += squareValue * value;
+        partial.SumOfQuadruples += squareValue * squareValue;
+        ++partial.Count;
+
+        if (0 < value)
+        {
+          partial.SumOfPositivePixels += value;
+          ++partial.CountOfPositivePixels;
+        }
+
+        if (std::numeric_limits<TPixel>::is_integer || !(binWidth > 0.))
+        {
+          valuesOfLabels[label].push_back(value);
+        }
+        else
+        {
+          // the center of the bin represents the value
+          const auto bin = std::min<double>(std::floor((value - valueMin) / binWidth), HistogramResolution - 1.);
+          valuesOfLabels[label].push_back(valueMin + (std::max(bin, 0.) + 0.5) * binWidth);
+        }
+      }
     }
 
-    typename ImageStatisticsFilterType::Pointer imageStatisticsFilter = ImageStatisticsFilterType::New();
-    imageStatisticsFilter->SetCoordinateTolerance(NODE_PREDICATE_GEOMETRY_DEFAULT_CHECK_COORDINATE_PRECISION);
-    imageStatisticsFilter->SetDirectionTolerance(NODE_PREDICATE_GEOMETRY_DEFAULT_CHECK_DIRECTION_PRECISION);
-    imageStatisticsFilter->SetInput(adaptedImage);
-    imageStatisticsFilter->SetLabelInput(maskImage);
-    imageStatisticsFilter->SetHistogramParameters(nBins, minVals, maxVals);
-    imageStatisticsFilter->Update();
+    // run length encoding of the sorted values gives the sparse histogram
+    for (auto &values : valuesOfLabels)
+    {
+      std::sort(values.second.begin(), values.second.end());
+      auto &histogram = partials[values.first].Histogram;
 
-    const auto labels = imageStatisticsFilter->GetValidLabelValues();
+      for (const auto value : values.second)
+      {
+        if (histogram.empty() || histogram.back().first != value)
+          histogram.emplace_back(value, 0);
+        ++histogram.back().second;
+      }
+    }
+  }
+
+  void ImageStatisticsCalculator::MergeSlicePartials(const SlicePartialStatisticsCache &cache, TimeStepType timeStep)
+  {
+    std::map<MaskPixelType, std::vector<const LabelPartialStatistics *>> partialsOfLabels;
+    for (const auto &slice : cache.Slices)
+    {
+      for (const auto &partial : slice)
+        partialsOfLabels[partial.first].push_back(&partial.second);
+    }
 
-    for (auto labelValue : labels)
+    for (const auto &partialsOfLabel : partialsOfLabels)
     {
-      if (labelValue == ImageStatisticsContainer::NO_MASK_LABEL_VALUE)
+      const auto labelValue = partialsOfLabel.first;
+      const auto &partials = partialsOfLabel.second;
+
+      itk::CompensatedSummation<double> sum, sumOfPositivePixels, sumOfSquares, sumOfCubes, sumOfQuadruples;
+      itk::SizeValueType numberOfVoxels = 0;
+      itk::SizeValueType numberOfPositivePixels = 0;
+      const LabelPartialStatistics *minPartial = partials.front();
+      const LabelPartialStatistics *maxPartial = partials.front();
+
+      // partials are in slice order, so the first occurrence of the extrema wins like in a scan of the volume
+      for (const auto partial : partials)
       {
-        //we ignore the background of a mask if we compute mask statistics.
-        continue;
+        sum += partial->Sum;
+        sumOfPositivePixels += partial->SumOfPositivePixels;
+        sumOfSquares += partial->SumOfSquares;
+        sumOfCubes += partial->SumOfCubes;
+        sumOfQuadruples += partial->SumOfQuadruples;
+        numberOfVoxels += partial->Count;
+        numberOfPositivePixels += partial->CountOfPositivePixels;
+
+        if (partial->Min < minPartial->Min)
+          minPartial = partial;
+        if (partial->Max > maxPartial->Max)
+          maxPartial = partial;
       }
 
-      ImageStatisticsContainer::ImageStatisticsObject statObj;
+      const auto minValue = minPartial->Min;
+      const auto maxValue = maxPartial->Max;
+
+      unsigned int nBinsForHistogram;
+      if (m_UseBinSizeOverNBins)
+      {
+        nBinsForHistogram = std::max(static_cast<double>(std::ceil(maxValue - minValue)) / m_binSizeForHistogramStatistics,
+                                     10.); // do not allow less than 10 bins
+      }
+      else
+      {
+        nBinsForHistogram = m_nBinsForHistogramStatistics;
+      }
+
+      HistogramType::SizeType histogramSize(1);
+      histogramSize[0] = nBinsForHistogram;
+      HistogramType::MeasurementVectorType lowerBound(1), upperBound(1);
+      lowerBound[0] = minValue;
+      upperBound[0] = maxValue;
 
-      // find min, max, minindex and maxindex
-      // make sure to only look in the masked region, use a masker for this
+      auto histogram = HistogramType::New();
+      histogram->SetMeasurementVectorSize(1);
+      histogram->Initialize(histogramSize, lowerBound, upperBound);
+
+      HistogramType::MeasurementVectorType measurement(1);
+      HistogramType::IndexType histogramIndex(1);
+      for (const auto partial : partials)
+      {
+        for (const auto &bin : partial->Histogram)
+        {
+          measurement[0] = std::min(std::max(bin.first, minValue), maxValue);
+          histogram->GetIndex(measurement, histogramIndex);
+          histogram->IncreaseFrequencyOfIndex(histogramIndex, bin.second);
+        }
+      }
+
+      HistogramStatisticsCalculator histogramStatisticsCalculator;
+      histogramStatisticsCalculator.SetHistogram(histogram);
+      histogramStatisticsCalculator.CalculateStatistics();
+
+      // same formulas as LabelStatisticsImageFilter
+      const double count = numberOfVoxels;
+      const double mean = sum.GetSum() / count;
+      const double variance =
+        count > 1 ? (sumOfSquares.GetSum() - sum.GetSum() * sum.GetSum() / count) / (count - 1.0) : 0.0;
+      const double sigma = std::sqrt(variance);
+      const auto secondMoment = sumOfSquares.GetSum() / count;
+      const auto thirdMoment = sumOfCubes.GetSum() / count;
+      const auto fourthMoment = sumOfQuadruples.GetSum() / count;
+      const auto skewness = (thirdMoment - 3 * secondMoment * mean + 2 * std::pow(mean, 3)) /
+                            std::pow(secondMoment - std::pow(mean, 2), 1.5);
+      const auto kurtosis =
+        (fourthMoment - 4 * thirdMoment * mean + 6 * secondMoment * std::pow(mean, 2) - 3 * std::pow(mean, 4)) /
+        std::pow(secondMoment - std::pow(mean, 2), 2);
+      const auto mpp = sumOfPositivePixels.GetSum() / static_cast<double>(numberOfPositivePixels);
+
+      ImageStatisticsContainer::ImageStatisticsObject statObj;
 
       vnl_vector<int> minIndex, maxIndex;
       Point3D worldCoordinateMin;
       Point3D worldCoordinateMax;
       Point3D indexCoordinateMin;
       Point3D indexCoordinateMax;
-      m_InternalImageForStatistics->GetGeometry()->IndexToWorld(minMaxFilter->GetMinIndex(labelValue), worldCoordinateMin);
-      m_InternalImageForStatistics->GetGeometry()->IndexToWorld(minMaxFilter->GetMaxIndex(labelValue), worldCoordinateMax);
+      cache.Geometry->IndexToWorld(minPartial->MinIndex, worldCoordinateMin);
+      cache.Geometry->IndexToWorld(maxPartial->MaxIndex, worldCoordinateMax);
       m_Image->GetGeometry()->WorldToIndex(worldCoordinateMin, indexCoordinateMin);
       m_Image->GetGeometry()->WorldToIndex(worldCoordinateMax, indexCoordinateMax);
 
       minIndex.set_size(3);
       maxIndex.set_size(3);
 
-      // for (unsigned int i=0; i < tmpMaxIndex.GetIndexDimension(); i++)
       for (unsigned int i = 0; i < 3; i++)
       {
         minIndex[i] = indexCoordinateMin[i];
@@ -440,46 +930,29 @@ namespace mitk
 
       statObj.AddStatistic(ImageStatisticsConstants::MINIMUMPOSITION(), minIndex);
       statObj.AddStatistic(ImageStatisticsConstants::MAXIMUMPOSITION(), maxIndex);
-
-      auto voxelVolume = GetVoxelVolume<TPixel, VImageDimension>(image);
-      auto numberOfVoxels =
-        static_cast<unsigned long>(imageStatisticsFilter->GetCount(labelValue));
-      auto volume = static_cast<double>(numberOfVoxels) * voxelVolume;
-      auto rms = std::sqrt(std::pow(imageStatisticsFilter->GetMean(labelValue), 2.) +
-                           imageStatisticsFilter->GetVariance(labelValue)); // variance = sigma^2
-      auto variance = imageStatisticsFilter->GetSigma(labelValue) * imageStatisticsFilter->GetSigma(labelValue);
-
-      statObj.AddStatistic(ImageStatisticsConstants::NUMBEROFVOXELS(), numberOfVoxels);
-      statObj.AddStatistic(ImageStatisticsConstants::VOLUME(), volume);
-      statObj.AddStatistic(ImageStatisticsConstants::MEAN(), imageStatisticsFilter->GetMean(labelValue));
-      statObj.AddStatistic(ImageStatisticsConstants::MINIMUM(),
-        static_cast<ImageStatisticsContainer::RealType>(imageStatisticsFilter->GetMinimum(labelValue)));
-      statObj.AddStatistic(ImageStatisticsConstants::MAXIMUM(),
-        static_cast<ImageStatisticsContainer::RealType>(imageStatisticsFilter->GetMaximum(labelValue)));
-      statObj.AddStatistic(ImageStatisticsConstants::STANDARDDEVIATION(), imageStatisticsFilter->GetSigma(labelValue));
-      statObj.AddStatistic(ImageStatisticsConstants::VARIANCE(), variance);
-      statObj.AddStatistic(ImageStatisticsConstants::SKEWNESS(), imageStatisticsFilter->GetSkewness(labelValue));
-      statObj.AddStatistic(ImageStatisticsConstants::KURTOSIS(), imageStatisticsFilter->GetKurtosis(labelValue));
-      statObj.AddStatistic(ImageStatisticsConstants::RMS(), rms);
-      statObj.AddStatistic(ImageStatisticsConstants::MPP(), imageStatisticsFilter->GetMPP(labelValue));
-      statObj.AddStatistic(ImageStatisticsConstants::ENTROPY(), imageStatisticsFilter->GetEntropy(labelValue));
-      statObj.AddStatistic(ImageStatisticsConstants::MEDIAN(), imageStatisticsFilter->GetMedian(labelValue));
-      statObj.AddStatistic(ImageStatisticsConstants::UNIFORMITY(), imageStatisticsFilter->GetUniformity(labelValue));
-      statObj.AddStatistic(ImageStatisticsConstants::UPP(), imageStatisticsFilter->GetUPP(labelValue));
-      statObj.m_Histogram = imageStatisticsFilter->GetHistogram(labelValue);
+      statObj.AddStatistic(ImageStatisticsConstants::NUMBEROFVOXELS(),
+                           static_cast<ImageStatisticsContainer::VoxelCountType>(numberOfVoxels));
+      statObj.AddStatistic(ImageStatisticsConstants::VOLUME(), count * cache.VoxelVolume);
+      statObj.AddStatistic(ImageStatisticsConstants::MEAN(), mean);
+      statObj.AddStatistic(ImageStatisticsConstants::MINIMUM(), minValue);
+      statObj.AddStatistic(ImageStatisticsConstants::MAXIMUM(), maxValue);
+      statObj.AddStatistic(ImageStatisticsConstants::STANDARDDEVIATION(), sigma);
+      statObj.AddStatistic(ImageStatisticsConstants::VARIANCE(), sigma * sigma);
+      statObj.AddStatistic(ImageStatisticsConstants::SKEWNESS(), skewness);
+      statObj.AddStatistic(ImageStatisticsConstants::KURTOSIS(), kurtosis);
+      statObj.AddStatistic(ImageStatisticsConstants::RMS(), std::sqrt(std::pow(mean, 2.) + variance));
+      statObj.AddStatistic(ImageStatisticsConstants::MPP(), mpp);
+      statObj.AddStatistic(ImageStatisticsConstants::ENTROPY(), histogramStatisticsCalculator.GetEntropy());
+      statObj.AddStatistic(ImageStatisticsConstants::MEDIAN(), histogramStatisticsCalculator.GetMedian());
+      statObj.AddStatistic(ImageStatisticsConstants::UNIFORMITY(), histogramStatisticsCalculator.GetUniformity());
+      statObj.AddStatistic(ImageStatisticsConstants::UPP(), histogramStatisticsCalculator.GetUPP());
+      statObj.m_Histogram = histogram.GetPointer();
 
       if (m_StatisticContainer->StatisticsExist(labelValue, timeStep))
         mitkThrow() << "Invalid state/input data. Statistic for a specific label/time step pair was computed more then once. Conflicting label ID: "
         << labelValue << " ; conflicting time step: " << timeStep;
       m_StatisticContainer->SetStatistics(labelValue, timeStep, statObj);
     }
-
-    // swap maskGenerators back
-    if (swapMasks)
-    {
-      m_SecondaryMask = m_InternalMask;
-      m_InternalMask = nullptr;
-    }
   }
 
   bool ImageStatisticsCalculator::IsUpdateRequired() const
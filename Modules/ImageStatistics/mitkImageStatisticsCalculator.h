@@ -17,6 +17,11 @@ found in the LICENSE file.
 #include <mitkImage.h>
 #include <mitkMaskGenerator.h>
 #include <mitkImageStatisticsContainer.h>
+#include <mitkITKEventObserverGuard.h>
+
+#include <map>
+#include <mutex>
+#include <vector>
 
 namespace mitk
 {
@@ -75,11 +80,32 @@ namespace mitk
          */
         ImageStatisticsContainer* GetStatistics();
 
+        /**Documentation
+        @brief Enables the incremental update of masked statistics of 3D images (default: off).
+        The calculator then keeps partial statistics (sums, moments, minimum/maximum and a histogram) per label and image slice
+        (along the third image axis). The calculator observes the ImageRegionModifiedEvent of the image and the mask (invoked
+        e.g. by segmentation tools and their undo operations). Subsequent calls of GetStatistics() only recompute the slices
+        reported by these events or by NotifySliceModified() and merge the partials. Median and the other histogram statistics
+        are derived from the merged histogram.
+        Secondary masks, masks that do not share the grid of the image and 4D masks fall back to the complete computation.
+        Modifications of the image or the mask that were not reported cause the recomputation of all slices.*/
+        void SetUseIncrementalUpdate(bool useIncrementalUpdate);
+        bool GetUseIncrementalUpdate() const;
+
+        /**Documentation
+        @brief Reports a modification of the input image or mask for the incremental update, if the modified image does not
+        invoke an ImageRegionModifiedEvent itself. All image slices intersected by the bounding box of the geometry are
+        recomputed by the next call of GetStatistics().*/
+        void NotifySliceModified(TimeStepType timeStep, const BaseGeometry* geometry);
+
     protected:
         ImageStatisticsCalculator(){
             m_nBinsForHistogramStatistics = 100;
             m_binSizeForHistogramStatistics = 10;
             m_UseBinSizeOverNBins = false;
+            m_UseIncrementalUpdate = false;
+            m_IncrementalUpdateSupported = true;
+            m_SlicePartialsModified = false;
         };
 
 
@@ -91,11 +117,94 @@ namespace mitk
         template < typename TPixel, unsigned int VImageDimension >
         void InternalCalculateStatisticsMasked(const itk::Image< TPixel, VImageDimension >* image, TimeStepType timeStep);
 
+        /** Passes the histogram settings and the value range of the image for the time step to a MultiLabelStatisticsCalculator.*/
+        template < typename TStatisticsCalculator >
+        void InitializeStatisticsCalculator(TStatisticsCalculator* statisticsCalculator, TimeStepType timeStep);
+
         template < typename TPixel, unsigned int VImageDimension >
         double GetVoxelVolume(const itk::Image<TPixel, VImageDimension>* image) const;
 
         bool IsUpdateRequired() const;
 
+        /** Partial statistics of one label within one image slice.*/
+        struct LabelPartialStatistics
+        {
+          itk::SizeValueType Count = 0;
+          itk::SizeValueType CountOfPositivePixels = 0;
+          double Min = 0;
+          double Max = 0;
+          itk::Index<3> MinIndex;
+          itk::Index<3> MaxIndex;
+          double Sum = 0;
+          double SumOfPositivePixels = 0;
+          double SumOfSquares = 0;
+          double SumOfCubes = 0;
+          double SumOfQuadruples = 0;
+          /** Sparse histogram (pixel value and frequency, sorted by value). Floating point values are binned into
+          HistogramResolution bins over the value range of the image, so the histogram is bounded.*/
+          std::vector<std::pair<double, itk::SizeValueType>> Histogram;
+        };
+
+        using SlicePartialStatistics = std::map<MaskPixelType, LabelPartialStatistics>;
+
+        /** Partial statistics of all slices for one time step and mask.*/
+        struct SlicePartialStatisticsCache
+        {
+          mitk::Image::ConstPointer Image;
+          itk::ModifiedTimeType ImageMTime = 0;
+          mitk::Image::ConstPointer Mask;
+          itk::ModifiedTimeType MaskMTime = 0;
+          const mitk::MaskGenerator* MaskGenerator = nullptr;
+          itk::ModifiedTimeType MaskGeneratorMTime = 0;
+          itk::ImageRegion<3> Region;
+          BaseGeometry::ConstPointer Geometry;
+          double VoxelVolume = 1.;
+          double ValueMin = 0.;
+          double ValueMax = 0.;
+          std::vector<SlicePartialStatistics> Slices;
+        };
+
+        /** Modification of the image or the mask, reported by an ImageRegionModifiedEvent or NotifySliceModified().*/
+        struct SliceModification
+        {
+          /** Modified image or nullptr, if reported by NotifySliceModified() (applies to the image and the mask).*/
+          const itk::Object* Image = nullptr;
+          /** Modification time of the image when the event was invoked.*/
+          itk::ModifiedTimeType ImageMTime = 0;
+          TimeStepType TimeStep = 0;
+          BaseGeometry::ConstPointer Geometry;
+        };
+
+        /** Number of bins of the sparse histograms of floating point images.*/
+        static constexpr unsigned int HistogramResolution = 65536;
+
+        using SlicePartialStatisticsCacheKey = std::pair<TimeStepType, unsigned int>;
+
+        /** Selects m_InternalMask, m_InternalImageForStatistics and m_ImageTimeSlice for a time step and mask.*/
+        void SelectInternalImages(TimeStepType timeStep, unsigned int maskID);
+
+        /** Updates the slice partials of all time steps and masks and merges them into a new statistics container if anything
+        changed. Returns false if the incremental update is not supported for the current inputs.*/
+        bool UpdateStatisticsIncrementally();
+
+        template < typename TPixel, unsigned int VImageDimension >
+        void InternalUpdateSlicePartials(const itk::Image< TPixel, VImageDimension >* image, TimeStepType timeStep, unsigned int maskID,
+          const std::vector<SliceModification>& modifications);
+
+        /** Observes the ImageRegionModifiedEvent of the passed images and stops observing all other images.*/
+        void UpdateModificationObservers(const std::vector<const mitk::Image*>& images);
+
+        /** Marks the slices of a cached image or mask that were modified since the cached modification time. All slices are
+        marked, if the last modification was not reported.*/
+        void MarkModifiedSlices(const mitk::Image* input, itk::ModifiedTimeType cachedMTime, TimeStepType timeStep,
+          const std::vector<SliceModification>& modifications, std::vector<char>& dirtySlices) const;
+
+        template < typename TPixel >
+        static void ComputeSlicePartialStatistics(const TPixel* image, const MaskPixelType* mask, const itk::ImageRegion<3>& region,
+          itk::IndexValueType slice, double valueMin, double valueMax, SlicePartialStatistics& partials);
+
+        void MergeSlicePartials(const SlicePartialStatisticsCache& cache, TimeStepType timeStep);
+
         mitk::Image::ConstPointer m_Image;
         mitk::Image::ConstPointer m_ImageTimeSlice;
         mitk::Image::ConstPointer m_InternalImageForStatistics;
@@ -111,6 +220,16 @@ namespace mitk
         bool m_UseBinSizeOverNBins;
 
         ImageStatisticsContainer::Pointer m_StatisticContainer;
+
+        bool m_UseIncrementalUpdate;
+        bool m_IncrementalUpdateSupported;
+        bool m_SlicePartialsModified;
+        std::map<SlicePartialStatisticsCacheKey, SlicePartialStatisticsCache> m_SlicePartialStatistics;
+        /** Modifications since the last update. Events may be invoked by other threads during the update.*/
+        std::vector<SliceModification> m_SliceModifications;
+        std::mutex m_SliceModificationsMutex;
+        std::vector<const mitk::Image*> m_UpdatedImages;
+        std::map<const mitk::Image*, ITKEventObserverGuard> m_ModificationObservers;
     };
 
 }
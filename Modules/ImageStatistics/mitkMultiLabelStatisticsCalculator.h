@@ -0,0 +1,210 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef mitkMultiLabelStatisticsCalculator_h
+#define mitkMultiLabelStatisticsCalculator_h
+
+#include <itkCompensatedSummation.h>
+#include <itkHistogram.h>
+#include <itkImage.h>
+#include <itkNumericTraits.h>
+#include <itkObject.h>
+
+#include <map>
+#include <vector>
+
+#include <mitkLabel.h>
+
+namespace mitk
+{
+  /**
+   * @brief Computes the statistics of all labels of a label image in a single threaded pass over the image.
+   *
+   * Moments, minimum/maximum (with index) and a histogram of every label are accumulated together. Each work unit
+   * processes chunks of the image buffer and accumulates into its own flat arrays, which are indexed by a slot
+   * assigned to each label on its first occurrence. The accumulators are merged after the pass.
+   *
+   * The histogram of a label has the requested number of bins between the minimum and maximum of the label, like
+   * LabelStatisticsImageFilter. As these bounds are not known before the pass, the pass accumulates a histogram with
+   * fixed bins over the value range of the image (see SetValueRange()) that is rebinned afterwards. For integral
+   * pixel types with up to GetMaximumNumberOfFixedBins() different values there is one fixed bin per value, so the
+   * rebinned histogram is exact. Otherwise a second pass that only computes the histograms is done.
+   *
+   * Without a label image, all pixels are treated as label Label::UNLABELED_VALUE.
+   */
+  template <typename TInputImage>
+  class MultiLabelStatisticsCalculator : public itk::Object
+  {
+  public:
+    using Self = MultiLabelStatisticsCalculator;
+    using Superclass = itk::Object;
+    using Pointer = itk::SmartPointer<Self>;
+    using ConstPointer = itk::SmartPointer<const Self>;
+
+    itkFactorylessNewMacro(Self);
+
+    itkTypeMacro(MultiLabelStatisticsCalculator, itk::Object);
+
+    static constexpr unsigned int ImageDimension = TInputImage::ImageDimension;
+
+    using ImageType = TInputImage;
+    using PixelType = typename TInputImage::PixelType;
+    using IndexType = typename TInputImage::IndexType;
+    using RegionType = typename TInputImage::RegionType;
+    using LabelPixelType = typename mitk::Label::PixelType;
+    using LabelImageType = itk::Image<LabelPixelType, ImageDimension>;
+    using RealType = typename itk::NumericTraits<PixelType>::RealType;
+    using HistogramType = itk::Statistics::Histogram<RealType>;
+    using HistogramPointer = typename HistogramType::Pointer;
+
+    class LabelStatistics
+    {
+    public:
+      itk::SizeValueType m_Count = 0;
+      itk::SizeValueType m_CountOfPositivePixels = 0;
+      RealType m_Min = 0;
+      RealType m_Max = 0;
+      IndexType m_MinIndex;
+      IndexType m_MaxIndex;
+      RealType m_Sum = 0;
+      RealType m_Mean = 0;
+      RealType m_Sigma = 0;
+      RealType m_Variance = 0;
+      RealType m_Skewness = 0;
+      RealType m_Kurtosis = 0;
+      RealType m_MPP = 0;
+      RealType m_Median = 0;
+      RealType m_Uniformity = 0;
+      RealType m_UPP = 0;
+      RealType m_Entropy = 0;
+      HistogramPointer m_Histogram;
+    };
+
+    using LabelValueVectorType = std::vector<LabelPixelType>;
+
+    itkSetConstObjectMacro(Image, ImageType);
+    itkGetConstObjectMacro(Image, ImageType);
+
+    /** Optional label image. It has to have the same buffered region as the image.*/
+    itkSetConstObjectMacro(LabelImage, LabelImageType);
+    itkGetConstObjectMacro(LabelImage, LabelImageType);
+
+    /** Pixels of this label are skipped if IgnoreLabel is on (e.g. the background of a mask).*/
+    itkSetMacro(IgnoredLabel, LabelPixelType);
+    itkGetConstMacro(IgnoredLabel, LabelPixelType);
+    itkSetMacro(IgnoreLabel, bool);
+    itkGetConstMacro(IgnoreLabel, bool);
+    itkBooleanMacro(IgnoreLabel);
+
+    /** Number of histogram bins of each label. Used unless UseBinSize is on.*/
+    itkSetMacro(NumberOfBins, unsigned int);
+    itkGetConstMacro(NumberOfBins, unsigned int);
+
+    /** If UseBinSize is on, the number of bins of a label is derived from its value range (at least 10 bins).*/
+    itkSetMacro(BinSize, double);
+    itkGetConstMacro(BinSize, double);
+    itkSetMacro(UseBinSize, bool);
+    itkGetConstMacro(UseBinSize, bool);
+    itkBooleanMacro(UseBinSize);
+
+    /**
+     * @brief Sets the value range of the image that defines the fixed histogram bins of the pass.
+     * Callers usually know it already (e.g. from mitk::Image::GetStatistics()). If it is not set, it is computed
+     * by an additional pass. Values outside of the range are handled correctly, but require the second pass.
+     */
+    void SetValueRange(RealType lowerBound, RealType upperBound);
+
+    itkSetMacro(MaximumNumberOfFixedBins, unsigned int);
+    itkGetConstMacro(MaximumNumberOfFixedBins, unsigned int);
+
+    /** Number of work units; 0 uses the number of work units of the global default multi-threader.*/
+    itkSetMacro(NumberOfWorkUnits, unsigned int);
+    itkGetConstMacro(NumberOfWorkUnits, unsigned int);
+
+    /**
+     * @brief Computes the statistics.
+     * @throw mitk::Exception if no image is set or the label image does not match the image.
+     */
+    void Compute();
+
+    /** Labels with at least one pixel (sorted, ignored label excluded).*/
+    const LabelValueVectorType &GetLabels() const;
+
+    bool HasLabel(LabelPixelType label) const;
+
+    /** @throw mitk::Exception if the label has no pixels.*/
+    const LabelStatistics &GetStatistics(LabelPixelType label) const;
+
+    /** Number of passes over the image of the last Compute() (1 if the fixed bins were exact).*/
+    itkGetConstMacro(NumberOfPasses, unsigned int);
+
+  protected:
+    MultiLabelStatisticsCalculator();
+    ~MultiLabelStatisticsCalculator() override = default;
+
+  private:
+    /** Flat per-slot arrays of one work unit.*/
+    struct Accumulator
+    {
+      std::vector<int> SlotOfLabel;
+      std::vector<LabelPixelType> Labels;
+      std::vector<itk::SizeValueType> Count;
+      std::vector<itk::SizeValueType> CountOfPositivePixels;
+      std::vector<RealType> Min;
+      std::vector<RealType> Max;
+      std::vector<itk::OffsetValueType> MinOffset;
+      std::vector<itk::OffsetValueType> MaxOffset;
+      std::vector<itk::CompensatedSummation<RealType>> Sum;
+      std::vector<itk::CompensatedSummation<RealType>> SumOfPositivePixels;
+      std::vector<itk::CompensatedSummation<RealType>> SumOfSquares;
+      std::vector<itk::CompensatedSummation<RealType>> SumOfCubes;
+      std::vector<itk::CompensatedSummation<RealType>> SumOfQuadruples;
+      /** slot * number of fixed bins + bin*/
+      std::vector<itk::SizeValueType> FixedBinHistograms;
+      bool OutOfValueRange = false;
+
+      int AddSlot(LabelPixelType label, unsigned int numberOfFixedBins);
+    };
+
+    void ComputeValueRange();
+    unsigned int GetNumberOfWorkUnitsToUse() const;
+    void AccumulateChunk(Accumulator &accumulator, itk::OffsetValueType begin, itk::OffsetValueType end) const;
+    void ComputeHistogramsFromFixedBins(const Accumulator &merged);
+    void ComputeHistogramsInSecondPass();
+    void FinalizeStatistics(const Accumulator &merged);
+
+    typename ImageType::ConstPointer m_Image;
+    typename LabelImageType::ConstPointer m_LabelImage;
+    LabelPixelType m_IgnoredLabel;
+    bool m_IgnoreLabel;
+    unsigned int m_NumberOfBins;
+    double m_BinSize;
+    bool m_UseBinSize;
+    bool m_ValueRangeSet;
+    RealType m_LowerBound;
+    RealType m_UpperBound;
+    unsigned int m_MaximumNumberOfFixedBins;
+    unsigned int m_NumberOfWorkUnits;
+
+    unsigned int m_NumberOfFixedBins;
+    RealType m_FixedBinWidth;
+    bool m_ExactFixedBins;
+    unsigned int m_NumberOfPasses;
+
+    LabelValueVectorType m_Labels;
+    std::map<LabelPixelType, LabelStatistics> m_LabelStatistics;
+  };
+}
+
+#include <mitkMultiLabelStatisticsCalculator.hxx>
+
+#endif
@@ -0,0 +1,515 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef mitkMultiLabelStatisticsCalculator_hxx
+#define mitkMultiLabelStatisticsCalculator_hxx
+
+#include <mitkExceptionMacro.h>
+#include <mitkHistogramStatisticsCalculator.h>
+
+#include <itkMultiThreaderBase.h>
+
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <limits>
+
+namespace mitk
+{
+  namespace MultiLabelStatistics
+  {
+    /** Number of pixels a work unit processes at once.*/
+    constexpr itk::OffsetValueType ChunkSize = 65536;
+  }
+}
+
+template <typename TInputImage>
+mitk::MultiLabelStatisticsCalculator<TInputImage>::MultiLabelStatisticsCalculator()
+  : m_IgnoredLabel(Label::UNLABELED_VALUE),
+    m_IgnoreLabel(false),
+    m_NumberOfBins(100),
+    m_BinSize(10),
+    m_UseBinSize(false),
+    m_ValueRangeSet(false),
+    m_LowerBound(0),
+    m_UpperBound(0),
+    m_MaximumNumberOfFixedBins(4096),
+    m_NumberOfWorkUnits(0),
+    m_NumberOfFixedBins(1),
+    m_FixedBinWidth(1),
+    m_ExactFixedBins(false),
+    m_NumberOfPasses(0)
+{
+}
+
+template <typename TInputImage>
+void mitk::MultiLabelStatisticsCalculator<TInputImage>::SetValueRange(RealType lowerBound, RealType upperBound)
+{
+  if (!m_ValueRangeSet || lowerBound != m_LowerBound || upperBound != m_UpperBound)
+  {
+    m_LowerBound = std::min(lowerBound, upperBound);
+    m_UpperBound = std::max(lowerBound, upperBound);
+    m_ValueRangeSet = true;
+    this->Modified();
+  }
+}
+
+template <typename TInputImage>
+int mitk::MultiLabelStatisticsCalculator<TInputImage>::Accumulator::AddSlot(LabelPixelType label,
+                                                                            unsigned int numberOfFixedBins)
+{
+  const auto slot = static_cast<int>(Labels.size());
+  SlotOfLabel[label] = slot;
+
+  Labels.push_back(label);
+  Count.push_back(0);
+  CountOfPositivePixels.push_back(0);
+  Min.push_back(itk::NumericTraits<RealType>::max());
+  Max.push_back(itk::NumericTraits<RealType>::NonpositiveMin());
+  MinOffset.push_back(std::numeric_limits<itk::OffsetValueType>::max());
+  MaxOffset.push_back(std::numeric_limits<itk::OffsetValueType>::max());
+  Sum.emplace_back();
+  SumOfPositivePixels.emplace_back();
+  SumOfSquares.emplace_back();
+  SumOfCubes.emplace_back();
+  SumOfQuadruples.emplace_back();
+  FixedBinHistograms.resize(FixedBinHistograms.size() + numberOfFixedBins, 0);
+
+  return slot;
+}
+
+template <typename TInputImage>
+unsigned int mitk::MultiLabelStatisticsCalculator<TInputImage>::GetNumberOfWorkUnitsToUse() const
+{
+  return 0 != m_NumberOfWorkUnits ? m_NumberOfWorkUnits
+                                  : std::max(1u, itk::MultiThreaderBase::GetGlobalDefaultNumberOfThreads());
+}
+
+template <typename TInputImage>
+void mitk::MultiLabelStatisticsCalculator<TInputImage>::ComputeValueRange()
+{
+  const PixelType *image = m_Image->GetBufferPointer();
+  const auto numberOfPixels = static_cast<itk::OffsetValueType>(m_Image->GetBufferedRegion().GetNumberOfPixels());
+  const auto numberOfChunks = (numberOfPixels + MultiLabelStatistics::ChunkSize - 1) / MultiLabelStatistics::ChunkSize;
+  const auto numberOfWorkUnits = this->GetNumberOfWorkUnitsToUse();
+
+  std::vector<RealType> minima(numberOfWorkUnits, itk::NumericTraits<RealType>::max());
+  std::vector<RealType> maxima(numberOfWorkUnits, itk::NumericTraits<RealType>::NonpositiveMin());
+  std::atomic<itk::OffsetValueType> nextChunk(0);
+
+  itk::MultiThreaderBase::New()->ParallelizeArray(
+    0,
+    numberOfWorkUnits,
+    [&](itk::SizeValueType workUnit) {
+      for (auto chunk = nextChunk++; chunk < numberOfChunks; chunk = nextChunk++)
+      {
+        const auto end = std::min(numberOfPixels, (chunk + 1) * MultiLabelStatistics::ChunkSize);
+        for (auto offset = chunk * MultiLabelStatistics::ChunkSize; offset < end; ++offset)
+        {
+          const auto value = static_cast<RealType>(image[offset]);
+          minima[workUnit] = std::min(minima[workUnit], value);
+          maxima[workUnit] = std::max(maxima[workUnit], value);
+        }
+      }
+    },
+    nullptr);
+
+  m_LowerBound = *std::min_element(minima.cbegin(), minima.cend());
+  m_UpperBound = *std::max_element(maxima.cbegin(), maxima.cend());
+  ++m_NumberOfPasses;
+}
+
+template <typename TInputImage>
+void mitk::MultiLabelStatisticsCalculator<TInputImage>::AccumulateChunk(Accumulator &accumulator,
+                                                                        itk::OffsetValueType begin,
+                                                                        itk::OffsetValueType end) const
+{
+  const PixelType *image = m_Image->GetBufferPointer();
+  const LabelPixelType *labels = m_LabelImage.IsNotNull() ? m_LabelImage->GetBufferPointer() : nullptr;
+
+  for (auto offset = begin; offset < end; ++offset)
+  {
+    const LabelPixelType label = nullptr != labels ? labels[offset] : Label::UNLABELED_VALUE;
+
+    if (m_IgnoreLabel && label == m_IgnoredLabel)
+      continue;
+
+    auto slot = accumulator.SlotOfLabel[label];
+    if (slot < 0)
+      slot = accumulator.AddSlot(label, m_ExactFixedBins ? m_NumberOfFixedBins : 0);
+
+    const auto value = static_cast<RealType>(image[offset]);
+
+    // strict comparisons keep the first occurrence, chunks of a work unit are processed in increasing order
+    if (value < accumulator.Min[slot])
+    {
+      accumulator.Min[slot] = value;
+      accumulator.MinOffset[slot] = offset;
+    }
+    if (value > accumulator.Max[slot])
+    {
+      accumulator.Max[slot] = value;
+      accumulator.MaxOffset[slot] = offset;
+    }
+
+    const auto squareValue = value * value;
+    accumulator.Sum[slot] += value;
+    accumulator.SumOfSquares[slot] += squareValue;
+    accumulator.SumOfCubes[slot] += squareValue * value;
+    accumulator.SumOfQuadruples[slot] += squareValue * squareValue;
+    ++accumulator.Count[slot];
+
+    if (0 < value)
+    {
+      accumulator.SumOfPositivePixels[slot] += value;
+      ++accumulator.CountOfPositivePixels[slot];
+    }
+
+    // the fixed bins are only used, if they are exact (otherwise the histograms are computed in a second pass)
+    if (m_ExactFixedBins)
+    {
+      if (value >= m_LowerBound && value <= m_UpperBound)
+      {
+        const auto bin = std::min(static_cast<unsigned int>((value - m_LowerBound) / m_FixedBinWidth), m_NumberOfFixedBins - 1);
+        ++accumulator.FixedBinHistograms[static_cast<std::size_t>(slot) * m_NumberOfFixedBins + bin];
+      }
+      else
+      {
+        accumulator.OutOfValueRange = true;
+      }
+    }
+  }
+}
+
+template <typename TInputImage>
+void mitk::MultiLabelStatisticsCalculator<TInputImage>::Compute()
+{
+  if (m_Image.IsNull())
+  {
+    mitkThrow() << "No image set.";
+  }
+
+  const auto region = m_Image->GetBufferedRegion();
+
+  if (m_LabelImage.IsNotNull() && m_LabelImage->GetBufferedRegion() != region)
+  {
+    mitkThrow() << "The buffered region of the label image " << m_LabelImage->GetBufferedRegion()
+                << " does not match the buffered region of the image " << region;
+  }
+
+  m_Labels.clear();
+  m_LabelStatistics.clear();
+  m_NumberOfPasses = 0;
+
+  if (!m_ValueRangeSet)
+  {
+    this->ComputeValueRange();
+  }
+
+  const auto range = m_UpperBound - m_LowerBound;
+
+  if (std::numeric_limits<PixelType>::is_integer && std::floor(m_LowerBound) == m_LowerBound &&
+      range < static_cast<RealType>(m_MaximumNumberOfFixedBins))
+  {
+    // one bin per value
+    m_NumberOfFixedBins = static_cast<unsigned int>(range) + 1;
+    m_FixedBinWidth = 1;
+    m_ExactFixedBins = true;
+  }
+  else
+  {
+    m_NumberOfFixedBins = std::max(1u, m_MaximumNumberOfFixedBins);
+    m_FixedBinWidth = range > 0 ? range / m_NumberOfFixedBins : 1;
+    m_ExactFixedBins = false;
+  }
+
+  const auto numberOfPixels = static_cast<itk::OffsetValueType>(region.GetNumberOfPixels());
+  const auto numberOfChunks = (numberOfPixels + MultiLabelStatistics::ChunkSize - 1) / MultiLabelStatistics::ChunkSize;
+  const auto numberOfWorkUnits = this->GetNumberOfWorkUnitsToUse();
+
+  std::vector<Accumulator> accumulators(numberOfWorkUnits);
+  std::atomic<itk::OffsetValueType> nextChunk(0);
+
+  // chunks are handed out dynamically, so work units that hit many labels do not hold up the others
+  itk::MultiThreaderBase::New()->ParallelizeArray(
+    0,
+    numberOfWorkUnits,
+    [&](itk::SizeValueType workUnit) {
+      auto &accumulator = accumulators[workUnit];
+      accumulator.SlotOfLabel.assign(static_cast<std::size_t>(std::numeric_limits<LabelPixelType>::max()) + 1, -1);
+
+      for (auto chunk = nextChunk++; chunk < numberOfChunks; chunk = nextChunk++)
+      {
+        this->AccumulateChunk(accumulator,
+                              chunk * MultiLabelStatistics::ChunkSize,
+                              std::min(numberOfPixels, (chunk + 1) * MultiLabelStatistics::ChunkSize));
+      }
+    },
+    nullptr);
+
+  ++m_NumberOfPasses;
+
+  Accumulator merged;
+  merged.SlotOfLabel.assign(static_cast<std::size_t>(std::numeric_limits<LabelPixelType>::max()) + 1, -1);
+
+  for (const auto &accumulator : accumulators)
+  {
+    merged.OutOfValueRange = merged.OutOfValueRange || accumulator.OutOfValueRange;
+
+    for (std::size_t slot = 0; slot < accumulator.Labels.size(); ++slot)
+    {
+      const auto label = accumulator.Labels[slot];
+      auto mergedSlot = merged.SlotOfLabel[label];
+      if (mergedSlot < 0)
+        mergedSlot = merged.AddSlot(label, m_ExactFixedBins ? m_NumberOfFixedBins : 0);
+
+      merged.Count[mergedSlot] += accumulator.Count[slot];
+      merged.CountOfPositivePixels[mergedSlot] += accumulator.CountOfPositivePixels[slot];
+      merged.Sum[mergedSlot] += accumulator.Sum[slot].GetSum();
+      merged.SumOfPositivePixels[mergedSlot] += accumulator.SumOfPositivePixels[slot].GetSum();
+      merged.SumOfSquares[mergedSlot] += accumulator.SumOfSquares[slot].GetSum();
+      merged.SumOfCubes[mergedSlot] += accumulator.SumOfCubes[slot].GetSum();
+      merged.SumOfQuadruples[mergedSlot] += accumulator.SumOfQuadruples[slot].GetSum();
+
+      if (accumulator.Min[slot] < merged.Min[mergedSlot] ||
+          (accumulator.Min[slot] == merged.Min[mergedSlot] && accumulator.MinOffset[slot] < merged.MinOffset[mergedSlot]))
+      {
+        merged.Min[mergedSlot] = accumulator.Min[slot];
+        merged.MinOffset[mergedSlot] = accumulator.MinOffset[slot];
+      }
+      if (accumulator.Max[slot] > merged.Max[mergedSlot] ||
+          (accumulator.Max[slot] == merged.Max[mergedSlot] && accumulator.MaxOffset[slot] < merged.MaxOffset[mergedSlot]))
+      {
+        merged.Max[mergedSlot] = accumulator.Max[slot];
+        merged.MaxOffset[mergedSlot] = accumulator.MaxOffset[slot];
+      }
+
+      if (m_ExactFixedBins)
+      {
+        const auto source = accumulator.FixedBinHistograms.cbegin() + slot * m_NumberOfFixedBins;
+        auto target = merged.FixedBinHistograms.begin() + static_cast<std::size_t>(mergedSlot) * m_NumberOfFixedBins;
+        std::transform(source, source + m_NumberOfFixedBins, target, target, std::plus<itk::SizeValueType>());
+      }
+    }
+  }
+
+  this->FinalizeStatistics(merged);
+
+  if (m_ExactFixedBins && !merged.OutOfValueRange)
+  {
+    this->ComputeHistogramsFromFixedBins(merged);
+  }
+  else
+  {
+    this->ComputeHistogramsInSecondPass();
+  }
+
+  for (auto &labelStatistics : m_LabelStatistics)
+  {
+    auto &statistics = labelStatistics.second;
+
+    HistogramStatisticsCalculator histogramStatisticsCalculator;
+    histogramStatisticsCalculator.SetHistogram(statistics.m_Histogram);
+    histogramStatisticsCalculator.CalculateStatistics();
+
+    statistics.m_Entropy = histogramStatisticsCalculator.GetEntropy();
+    statistics.m_Uniformity = histogramStatisticsCalculator.GetUniformity();
+    statistics.m_UPP = histogramStatisticsCalculator.GetUPP();
+    statistics.m_Median = histogramStatisticsCalculator.GetMedian();
+  }
+}
+
+template <typename TInputImage>
+void mitk::MultiLabelStatisticsCalculator<TInputImage>::FinalizeStatistics(const Accumulator &merged)
+{
+  for (std::size_t slot = 0; slot < merged.Labels.size(); ++slot)
+  {
+    auto &stats = m_LabelStatistics[merged.Labels[slot]];
+
+    stats.m_Count = merged.Count[slot];
+    stats.m_CountOfPositivePixels = merged.CountOfPositivePixels[slot];
+    stats.m_Min = merged.Min[slot];
+    stats.m_Max = merged.Max[slot];
+    stats.m_MinIndex = m_Image->ComputeIndex(merged.MinOffset[slot]);
+    stats.m_MaxIndex = m_Image->ComputeIndex(merged.MaxOffset[slot]);
+
+    // same formulas as LabelStatisticsImageFilter
+    const auto sum = merged.Sum[slot].GetSum();
+    const auto sumOfSquares = merged.SumOfSquares[slot].GetSum();
+    const auto sumOfCubes = merged.SumOfCubes[slot].GetSum();
+    const auto sumOfQuadruples = merged.SumOfQuadruples[slot].GetSum();
+    const auto sumOfPositivePixels = merged.SumOfPositivePixels[slot].GetSum();
+
+    const RealType count = stats.m_Count;
+    const RealType countOfPositivePixels = stats.m_CountOfPositivePixels;
+
+    stats.m_Sum = sum;
+    stats.m_Mean = sum / count;
+    const auto &mean = stats.m_Mean;
+
+    stats.m_Variance = count > 1 ? (sumOfSquares - sum * sum / count) / (count - 1.0) : 0.0;
+    stats.m_Sigma = std::sqrt(stats.m_Variance);
+
+    const auto secondMoment = sumOfSquares / count;
+    const auto thirdMoment = sumOfCubes / count;
+    const auto fourthMoment = sumOfQuadruples / count;
+
+    stats.m_Skewness = (thirdMoment - 3 * secondMoment * mean + 2 * std::pow(mean, 3)) / std::pow(secondMoment - std::pow(mean, 2), 1.5);
+    stats.m_Kurtosis = (fourthMoment - 4 * thirdMoment * mean + 6 * secondMoment * std::pow(mean, 2) - 3 * std::pow(mean, 4)) / std::pow(secondMoment - std::pow(mean, 2), 2);
+    stats.m_MPP = sumOfPositivePixels / countOfPositivePixels;
+
+    unsigned int numberOfBins = m_NumberOfBins;
+    if (m_UseBinSize)
+    {
+      numberOfBins = std::max(static_cast<double>(std::ceil(stats.m_Max - stats.m_Min)) / m_BinSize, 10.); // do not allow less than 10 bins
+    }
+
+    typename HistogramType::SizeType histogramSize(1);
+    histogramSize[0] = numberOfBins;
+    typename HistogramType::MeasurementVectorType lowerBound(1);
+    lowerBound[0] = stats.m_Min;
+    typename HistogramType::MeasurementVectorType upperBound(1);
+    upperBound[0] = stats.m_Max;
+
+    stats.m_Histogram = HistogramType::New();
+    stats.m_Histogram->SetMeasurementVectorSize(1);
+    stats.m_Histogram->Initialize(histogramSize, lowerBound, upperBound);
+
+    m_Labels.push_back(merged.Labels[slot]);
+  }
+
+  std::sort(m_Labels.begin(), m_Labels.end());
+}
+
+template <typename TInputImage>
+void mitk::MultiLabelStatisticsCalculator<TInputImage>::ComputeHistogramsFromFixedBins(const Accumulator &merged)
+{
+  typename HistogramType::MeasurementVectorType measurement(1);
+  typename HistogramType::IndexType histogramIndex(1);
+
+  for (std::size_t slot = 0; slot < merged.Labels.size(); ++slot)
+  {
+    auto histogram = m_LabelStatistics[merged.Labels[slot]].m_Histogram;
+    const auto fixedBins = merged.FixedBinHistograms.cbegin() + slot * m_NumberOfFixedBins;
+
+    for (unsigned int bin = 0; bin < m_NumberOfFixedBins; ++bin)
+    {
+      const auto frequency = fixedBins[bin];
+      if (0 == frequency)
+        continue;
+
+      // the fixed bins are exact, so each of them is the pixel value itself
+      measurement[0] = m_LowerBound + bin;
+      histogram->GetIndex(measurement, histogramIndex);
+      histogram->IncreaseFrequencyOfIndex(histogramIndex, frequency);
+    }
+  }
+}
+
+template <typename TInputImage>
+void mitk::MultiLabelStatisticsCalculator<TInputImage>::ComputeHistogramsInSecondPass()
+{
+  std::vector<int> slotOfLabel(static_cast<std::size_t>(std::numeric_limits<LabelPixelType>::max()) + 1, -1);
+  std::vector<const HistogramType *> histograms;
+  std::vector<std::size_t> firstBinOfSlot;
+  std::size_t numberOfBins = 0;
+
+  for (const auto &labelStatistics : m_LabelStatistics)
+  {
+    slotOfLabel[labelStatistics.first] = static_cast<int>(histograms.size());
+    histograms.push_back(labelStatistics.second.m_Histogram.GetPointer());
+    firstBinOfSlot.push_back(numberOfBins);
+    numberOfBins += labelStatistics.second.m_Histogram->GetSize(0);
+  }
+
+  const PixelType *image = m_Image->GetBufferPointer();
+  const LabelPixelType *labels = m_LabelImage.IsNotNull() ? m_LabelImage->GetBufferPointer() : nullptr;
+  const auto numberOfPixels = static_cast<itk::OffsetValueType>(m_Image->GetBufferedRegion().GetNumberOfPixels());
+  const auto numberOfChunks = (numberOfPixels + MultiLabelStatistics::ChunkSize - 1) / MultiLabelStatistics::ChunkSize;
+  const auto numberOfWorkUnits = this->GetNumberOfWorkUnitsToUse();
+
+  std::vector<std::vector<itk::SizeValueType>> frequencies(numberOfWorkUnits);
+  std::atomic<itk::OffsetValueType> nextChunk(0);
+
+  itk::MultiThreaderBase::New()->ParallelizeArray(
+    0,
+    numberOfWorkUnits,
+    [&](itk::SizeValueType workUnit) {
+      auto &workUnitFrequencies = frequencies[workUnit];
+      workUnitFrequencies.assign(numberOfBins, 0);
+
+      typename HistogramType::MeasurementVectorType measurement(1);
+      typename HistogramType::IndexType histogramIndex(1);
+
+      for (auto chunk = nextChunk++; chunk < numberOfChunks; chunk = nextChunk++)
+      {
+        const auto end = std::min(numberOfPixels, (chunk + 1) * MultiLabelStatistics::ChunkSize);
+        for (auto offset = chunk * MultiLabelStatistics::ChunkSize; offset < end; ++offset)
+        {
+          const LabelPixelType label = nullptr != labels ? labels[offset] : Label::UNLABELED_VALUE;
+          const auto slot = slotOfLabel[label];
+
+          if (slot < 0 || (m_IgnoreLabel && label == m_IgnoredLabel))
+            continue;
+
+          measurement[0] = static_cast<RealType>(image[offset]);
+          if (histograms[slot]->GetIndex(measurement, histogramIndex))
+            ++workUnitFrequencies[firstBinOfSlot[slot] + histogramIndex[0]];
+        }
+      }
+    },
+    nullptr);
+
+  ++m_NumberOfPasses;
+
+  for (const auto &labelStatistics : m_LabelStatistics)
+  {
+    const auto slot = slotOfLabel[labelStatistics.first];
+    auto histogram = labelStatistics.second.m_Histogram;
+
+    for (itk::SizeValueType bin = 0; bin < histogram->GetSize(0); ++bin)
+    {
+      itk::SizeValueType frequency = 0;
+      for (const auto &workUnitFrequencies : frequencies)
+        frequency += workUnitFrequencies[firstBinOfSlot[slot] + bin];
+
+      histogram->SetFrequency(bin, frequency);
+    }
+  }
+}
+
+template <typename TInputImage>
+auto mitk::MultiLabelStatisticsCalculator<TInputImage>::GetLabels() const -> const LabelValueVectorType &
+{
+  return m_Labels;
+}
+
+template <typename TInputImage>
+bool mitk::MultiLabelStatisticsCalculator<TInputImage>::HasLabel(LabelPixelType label) const
+{
+  return m_LabelStatistics.find(label) != m_LabelStatistics.cend();
+}
+
+template <typename TInputImage>
+auto mitk::MultiLabelStatisticsCalculator<TInputImage>::GetStatistics(LabelPixelType label) const -> const LabelStatistics &
+{
+  const auto iter = m_LabelStatistics.find(label);
+
+  if (iter == m_LabelStatistics.cend())
+  {
+    mitkThrow() << "No statistics for label " << label;
+  }
+
+  return iter->second;
+}
+
+#endif
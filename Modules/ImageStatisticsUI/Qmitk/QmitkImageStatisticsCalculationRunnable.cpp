@@ -84,6 +84,11 @@ unsigned int QmitkImageStatisticsCalculationRunnable::GetHistogramNBins() const
   return this->m_HistogramNBins;
 }
 
+void QmitkImageStatisticsCalculationRunnable::SetSharedCalculator(std::shared_ptr<SharedCalculator> sharedCalculator)
+{
+  this->m_SharedCalculator = sharedCalculator;
+}
+
 QmitkDataGenerationJobBase::ResultMapType QmitkImageStatisticsCalculationRunnable::GetResults() const
 {
   ResultMapType result;
@@ -94,7 +99,22 @@ QmitkDataGenerationJobBase::ResultMapType QmitkImageStatisticsCalculationRunnabl
 bool QmitkImageStatisticsCalculationRunnable::RunComputation()
 {
   bool statisticCalculationSuccessful = true;
-  mitk::ImageStatisticsCalculator::Pointer calculator = mitk::ImageStatisticsCalculator::New();
+  mitk::ImageStatisticsCalculator::Pointer calculator;
+
+  std::unique_lock<std::mutex> sharedCalculatorLock;
+  if (nullptr != m_SharedCalculator)
+  {
+    sharedCalculatorLock = std::unique_lock<std::mutex>(m_SharedCalculator->Mutex);
+    calculator = m_SharedCalculator->Calculator;
+  }
+
+  if (calculator.IsNotNull())
+  {
+    // the shared calculator was configured by a previous job for the same image and mask
+    return this->ComputeStatistics(calculator);
+  }
+
+  calculator = mitk::ImageStatisticsCalculator::New();
 
   if (this->m_StatisticsImage.IsNotNull())
   {
@@ -154,6 +174,19 @@ bool QmitkImageStatisticsCalculationRunnable::RunComputation()
     calculator->SetSecondaryMask(nullptr);
   }
 
+  if (statisticCalculationSuccessful && nullptr != m_SharedCalculator)
+  {
+    calculator->SetUseIncrementalUpdate(true);
+    m_SharedCalculator->Calculator = calculator;
+  }
+
+  return statisticCalculationSuccessful && this->ComputeStatistics(calculator);
+}
+
+bool QmitkImageStatisticsCalculationRunnable::ComputeStatistics(mitk::ImageStatisticsCalculator* calculator)
+{
+  bool statisticCalculationSuccessful = true;
+
   calculator->SetNBinsForHistogramStatistics(m_HistogramNBins);
 
   try
@@ -13,10 +13,14 @@ found in the LICENSE file.
 #define QmitkImageStatisticsCalculationRunnable_h
 
 //mitk headers
+#include <mitkImageStatisticsCalculator.h>
 #include <mitkImageStatisticsContainer.h>
 
 #include "QmitkDataGenerationJobBase.h"
 
+#include <memory>
+#include <mutex>
+
 // itk headers
 #ifndef __itkHistogram_h
 #include <itkHistogram.h>
@@ -37,6 +41,15 @@ public:
 
   typedef itk::Statistics::Histogram<double> HistogramType;
 
+  /** Calculator that is kept by the caller and reused by all jobs for the same image and mask, so the statistics of
+  image masks can be updated incrementally (see mitk::ImageStatisticsCalculator::SetUseIncrementalUpdate()).
+  The calculator is created and configured by the first job. Jobs that share it are serialized by the mutex.*/
+  struct SharedCalculator
+  {
+    std::mutex Mutex;
+    mitk::ImageStatisticsCalculator::Pointer Calculator;
+  };
+
   /*!
   /brief standard constructor. */
   QmitkImageStatisticsCalculationRunnable();
@@ -67,16 +80,25 @@ public:
   /brief Get bin size for histogram resolution.*/
   unsigned int GetHistogramNBins() const;
 
+  /*!
+  /brief Sets the calculator that is shared with other jobs for the same image and mask (optional).
+  Must not be used for planar figure masks or if zero value voxels are ignored.*/
+  void SetSharedCalculator(std::shared_ptr<SharedCalculator> sharedCalculator);
+
   ResultMapType GetResults() const override;
 
 protected:
   bool RunComputation() override;
 
 private:
+  /** Computes the statistics with a configured calculator and prepares the result container.*/
+  bool ComputeStatistics(mitk::ImageStatisticsCalculator* calculator);
+
   mitk::Image::ConstPointer m_StatisticsImage;                         ///< member variable holds the input image for which the statistics need to be calculated.
   mitk::BaseData::ConstPointer m_MaskData;                             ///< member variable holds the data that should be used as mask statistics calculation.
   mitk::ImageStatisticsContainer::Pointer m_StatisticsContainer;
   bool m_IgnoreZeros;                                             ///< member variable holds flag to indicate if zero valued voxel should be suppressed
   unsigned int m_HistogramNBins;                                      ///< member variable holds the bin size for histogram resolution.
+  std::shared_ptr<SharedCalculator> m_SharedCalculator;
 };
 #endif
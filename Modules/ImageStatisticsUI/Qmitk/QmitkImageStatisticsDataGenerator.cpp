@@ -24,6 +24,8 @@ found in the LICENSE file.
 
 #include "QmitkImageStatisticsCalculationRunnable.h"
 
+#include <algorithm>
+
 void QmitkImageStatisticsDataGenerator::SetIgnoreZeroValueVoxel(bool _arg)
 {
   if (m_IgnoreZeroValueVoxel != _arg)
@@ -178,6 +180,7 @@ std::pair<QmitkDataGenerationJobBase*, mitk::DataNode::Pointer> QmitkImageStatis
     newJob->Initialize(image, mask);
     newJob->SetIgnoreZeroValueVoxel(m_IgnoreZeroValueVoxel);
     newJob->SetHistogramNBins(m_HistogramNBins);
+    newJob->SetSharedCalculator(this->GetSharedCalculator(image, mask));
 
     return std::pair<QmitkDataGenerationJobBase*, mitk::DataNode::Pointer>(newJob, resultDataNode.GetPointer());
   }
@@ -188,6 +191,38 @@ std::pair<QmitkDataGenerationJobBase*, mitk::DataNode::Pointer> QmitkImageStatis
   return std::pair<QmitkDataGenerationJobBase*, mitk::DataNode::Pointer>(nullptr, nullptr);
 }
 
+std::shared_ptr<QmitkImageStatisticsCalculationRunnable::SharedCalculator> QmitkImageStatisticsDataGenerator::GetSharedCalculator(const mitk::Image* image, const mitk::BaseData* mask) const
+{
+  const auto combinations = this->GetAllImageROICombinations();
+
+  std::lock_guard<std::mutex> mutexguard(m_DataMutex);
+
+  for (auto iter = m_SharedCalculators.begin(); iter != m_SharedCalculators.end();)
+  {
+    auto finding = std::find_if(combinations.begin(), combinations.end(), [iter](const InputPairVectorType::value_type& combination)
+    {
+      return combination.first->GetData() == iter->first.first &&
+             combination.second.IsNotNull() && combination.second->GetData() == iter->first.second;
+    });
+
+    iter = finding == combinations.end() ? m_SharedCalculators.erase(iter) : std::next(iter);
+  }
+
+  // planar figures are cloned by the job and a secondary mask is not supported by the incremental update
+  if (nullptr == dynamic_cast<const mitk::Image*>(mask) || m_IgnoreZeroValueVoxel)
+  {
+    return nullptr;
+  }
+
+  auto& sharedCalculator = m_SharedCalculators[std::make_pair(image, mask)];
+  if (nullptr == sharedCalculator)
+  {
+    sharedCalculator = std::make_shared<QmitkImageStatisticsCalculationRunnable::SharedCalculator>();
+  }
+
+  return sharedCalculator;
+}
+
 void QmitkImageStatisticsDataGenerator::RemoveObsoleteDataNodes(const mitk::DataNode* imageNode, const mitk::DataNode* roiNode) const
 {
   if (imageNode == nullptr || !imageNode->GetData())
@@ -14,6 +14,7 @@ found in the LICENSE file.
 #define QmitkImageStatisticsDataGenerator_h
 
 #include "QmitkImageAndRoiDataGeneratorBase.h"
+#include "QmitkImageStatisticsCalculationRunnable.h"
 
 #include <MitkImageStatisticsUIExports.h>
 
@@ -59,11 +60,19 @@ protected:
   void RemoveObsoleteDataNodes(const mitk::DataNode* imageNode, const mitk::DataNode* roiNode) const;
   mitk::DataNode::Pointer PrepareResultForStorage(const std::string& label, mitk::BaseData* result, const QmitkDataGenerationJobBase* job) const;
 
+  /** Returns the calculator shared by the jobs for an image and an image mask, so that edits of the mask (e.g. by
+  segmentation tools) only recompute the modified slices. Calculators of pairs that are not generated anymore are
+  released. Returns nullptr if the statistics cannot be updated incrementally for the pair and the current settings.*/
+  std::shared_ptr<QmitkImageStatisticsCalculationRunnable::SharedCalculator> GetSharedCalculator(const mitk::Image* image, const mitk::BaseData* mask) const;
+
   QmitkImageStatisticsDataGenerator(const QmitkImageStatisticsDataGenerator&) = delete;
   QmitkImageStatisticsDataGenerator& operator = (const QmitkImageStatisticsDataGenerator&) = delete;
 
   bool m_IgnoreZeroValueVoxel = false;
   unsigned int m_HistogramNBins = 100;
+
+  using SharedCalculatorMapType = std::map<std::pair<const mitk::BaseData*, const mitk::BaseData*>, std::shared_ptr<QmitkImageStatisticsCalculationRunnable::SharedCalculator>>;
+  mutable SharedCalculatorMapType m_SharedCalculators;
 };
 
 #endif
@@ -15,6 +15,7 @@ found in the LICENSE file.
 
 #include <mitkLogBackendBase.h>
 
+#include <cstddef>
 #include <sstream>
 
 #include <MitkLogExports.h>
@@ -60,6 +61,59 @@ namespace mitk
    */
   bool MITKLOG_EXPORT IsBackendEnabled(LogBackendBase::OutputType type);
 
+  /** \brief Behavior of the asynchronous log mechanism if its message queue is full.
+   */
+  enum class LogOverflowPolicy
+  {
+    /** The logging thread waits until there is space in the queue. No message is lost. */
+    Block,
+    /** The message is discarded and counted, see GetNumberOfDroppedLogMessages(). */
+    Drop
+  };
+
+  /** \brief Switch to asynchronous logging.
+   *
+   * Messages are put into a bounded lock-free queue and distributed to the backends by a dedicated writer thread,
+   * which also flushes the backends after each batch of messages. Logging threads therefore neither format
+   * messages nor wait for output. Fatal messages are still written before the logging call returns.
+   *
+   * Calling this method while asynchronous logging is already enabled restarts it with the new settings.
+   *
+   * \param capacity Maximum number of queued messages (rounded up to the next power of two).
+   * \param policy Behavior if the queue is full.
+   */
+  void MITKLOG_EXPORT EnableAsynchronousLogging(std::size_t capacity = 8192, LogOverflowPolicy policy = LogOverflowPolicy::Block);
+
+  /** \brief Write all queued messages and switch back to synchronous logging.
+   */
+  void MITKLOG_EXPORT DisableAsynchronousLogging();
+
+  /** \brief Check whether messages are distributed by the writer thread of the asynchronous log mechanism.
+   */
+  bool MITKLOG_EXPORT IsAsynchronousLoggingEnabled();
+
+  /** \brief Wait until all messages that were queued before this call have been written.
+   *
+   * Does nothing if asynchronous logging is disabled.
+   */
+  void MITKLOG_EXPORT FlushLog();
+
+  /** \brief Number of messages of the given level that were emitted since start or the last ResetLogCounters().
+   *
+   * Includes dropped messages.
+   */
+  std::size_t MITKLOG_EXPORT GetNumberOfLogMessages(LogLevel level);
+
+  /** \brief Number of messages of the given level that were dropped since start or the last ResetLogCounters().
+   *
+   * Messages are only dropped by the asynchronous log mechanism with LogOverflowPolicy::Drop.
+   */
+  std::size_t MITKLOG_EXPORT GetNumberOfDroppedLogMessages(LogLevel level);
+
+  /** \brief Reset the message counters of all levels.
+   */
+  void MITKLOG_EXPORT ResetLogCounters();
+
   /** \brief Simulates a std::cout stream.
    *
    * Should only be used by the macros defined in the file mitkLog.h.
@@ -40,6 +40,12 @@ namespace mitk
      */
     virtual void ProcessMessage(const LogMessage& message) = 0;
 
+    /** \brief Called by the MITK log mechanism after one or more messages were processed.
+     *
+     * Backends that buffer their output should write it here. Does nothing by default.
+     */
+    virtual void Flush();
+
     /**
      * \return The type of this backend.
      */
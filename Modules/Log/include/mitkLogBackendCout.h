@@ -30,6 +30,8 @@ namespace mitk
 
     void ProcessMessage(const LogMessage &message) override;
 
+    void Flush() override;
+
     /** \brief Sets the formatting mode.
      *
      * If true, long messages will be displayed. Default is false (short/smart messages). Long messages provide all
@@ -15,6 +15,7 @@ found in the LICENSE file.
 
 #include <mitkLogLevel.h>
 
+#include <chrono>
 #include <string>
 
 #include <MitkLogExports.h>
@@ -31,6 +32,10 @@ namespace mitk
   public:
     LogMessage(const LogLevel level, const std::string& filePath, const int lineNumber, const std::string& functionName);
 
+    /** \brief Point in time when the log message was emitted.
+     */
+    const std::chrono::steady_clock::time_point TimeStamp;
+
     /** \brief Log level of the emitted log message.
      */
     const LogLevel Level;
@@ -13,19 +13,306 @@ found in the LICENSE file.
 #include <mitkLog.h>
 #include <mitkLogBackendCout.h>
 
+#include "mitkLogRingBuffer.h"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
 #include <list>
+#include <mutex>
 #include <set>
+#include <thread>
 
 static std::list<mitk::LogBackendBase*> backends;
 static std::set<mitk::LogBackendBase::OutputType> disabledBackendTypes;
 
+// recursive, since backends may log themselves while processing a message
+static std::recursive_mutex backendsMutex;
+
+namespace
+{
+  constexpr std::size_t NumberOfLogLevels = static_cast<std::size_t>(mitk::LogLevel::Debug) + 1;
+
+  std::array<std::atomic<std::size_t>, NumberOfLogLevels> numberOfMessages = {};
+  std::array<std::atomic<std::size_t>, NumberOfLogLevels> numberOfDroppedMessages = {};
+
+  std::size_t GetLevelIndex(mitk::LogLevel level)
+  {
+    return static_cast<std::size_t>(level);
+  }
+
+  /** Calls the ProcessMessage() methods of all enabled backends. */
+  void WriteToBackends(const mitk::LogMessage& message, bool flush)
+  {
+    std::lock_guard<std::recursive_mutex> lock(backendsMutex);
+
+    // create dummy backend if there is no backend registered (so we have an output anyway)
+    static mitk::LogBackendCout* dummyBackend = nullptr;
+
+    if (backends.empty() && dummyBackend == nullptr)
+    {
+      dummyBackend = new mitk::LogBackendCout;
+      mitk::RegisterBackend(dummyBackend);
+    }
+    else if (backends.size() > 1 && dummyBackend != nullptr)
+    {
+      // if there was added another backend remove the dummy backend and delete it
+      mitk::UnregisterBackend(dummyBackend);
+      delete dummyBackend;
+      dummyBackend = nullptr;
+    }
+
+    // iterate through all registered images and call the ProcessMessage() methods of the backends
+    for (auto i = backends.begin(); i != backends.end(); ++i)
+    {
+      if (mitk::IsBackendEnabled((*i)->GetOutputType()))
+      {
+        (*i)->ProcessMessage(message);
+
+        if (flush)
+          (*i)->Flush();
+      }
+    }
+  }
+
+  void FlushBackends()
+  {
+    std::lock_guard<std::recursive_mutex> lock(backendsMutex);
+
+    for (auto i = backends.begin(); i != backends.end(); ++i)
+    {
+      if (mitk::IsBackendEnabled((*i)->GetOutputType()))
+        (*i)->Flush();
+    }
+  }
+
+  /** Messages are distributed to the backends by a single writer thread. Logging threads only push their
+   * messages into a lock-free ring buffer and wake the writer if it sleeps. Mutexes and condition variables
+   * are only used for sleeping, i.e., if the writer has nothing to do or if the buffer is full. */
+  class AsynchronousLogger
+  {
+  public:
+    ~AsynchronousLogger()
+    {
+      this->Disable();
+    }
+
+    void Enable(std::size_t capacity, mitk::LogOverflowPolicy policy)
+    {
+      std::lock_guard<std::mutex> lock(m_ControlMutex);
+
+      this->Stop();
+
+      m_Buffer = std::make_unique<mitk::LogRingBuffer<mitk::LogMessage>>(capacity);
+      m_Policy = policy;
+      m_Stopping = false;
+      m_NumberOfWrittenMessages = 0;
+      m_Writer = std::thread(&AsynchronousLogger::Write, this);
+      m_Enabled.store(true);
+    }
+
+    void Disable()
+    {
+      std::lock_guard<std::mutex> lock(m_ControlMutex);
+      this->Stop();
+    }
+
+    bool IsEnabled() const
+    {
+      return m_Enabled.load();
+    }
+
+    bool IsWriterThread() const
+    {
+      return std::this_thread::get_id() == m_WriterID.load();
+    }
+
+    /** Returns false if asynchronous logging is disabled. The caller has to write the message itself then. */
+    bool Push(mitk::LogMessage& message)
+    {
+      // Stop() waits for all producers to leave before the buffer is drained and released
+      ProducerGuard guard(m_NumberOfProducers);
+
+      if (!m_Enabled.load())
+        return false;
+
+      const bool isFatal = mitk::LogLevel::Fatal == message.Level;
+      const auto level = message.Level;
+
+      std::size_t ticket = 0;
+
+      while (!m_Buffer->TryPush(message, ticket))
+      {
+        if (mitk::LogOverflowPolicy::Drop == m_Policy && !isFatal)
+        {
+          ++numberOfDroppedMessages[GetLevelIndex(level)];
+          return true;
+        }
+
+        std::unique_lock<std::mutex> lock(m_Mutex);
+        m_SpaceAvailable.wait_for(lock, std::chrono::milliseconds(1));
+      }
+
+      this->WakeWriter();
+
+      if (isFatal)
+        this->WaitFor(ticket);
+
+      return true;
+    }
+
+    void Flush()
+    {
+      ProducerGuard guard(m_NumberOfProducers);
+
+      if (!m_Enabled.load() || this->IsWriterThread())
+        return;
+
+      this->WaitFor(m_Buffer->GetNumberOfPushes());
+    }
+
+  private:
+    class ProducerGuard
+    {
+    public:
+      explicit ProducerGuard(std::atomic<std::size_t>& counter)
+        : m_Counter(counter)
+      {
+        ++m_Counter;
+      }
+
+      ~ProducerGuard()
+      {
+        --m_Counter;
+      }
+
+    private:
+      std::atomic<std::size_t>& m_Counter;
+    };
+
+    void WakeWriter()
+    {
+      if (m_WriterSleeping.load())
+      {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        m_MessageAvailable.notify_one();
+      }
+    }
+
+    void WaitFor(std::size_t ticket)
+    {
+      std::unique_lock<std::mutex> lock(m_Mutex);
+      m_MessagesWritten.wait(lock, [this, ticket]() { return m_NumberOfWrittenMessages.load() >= ticket; });
+    }
+
+    /** Must be called with m_ControlMutex locked. */
+    void Stop()
+    {
+      if (!m_Writer.joinable())
+        return;
+
+      m_Enabled.store(false);
+
+      while (0 != m_NumberOfProducers.load())
+        std::this_thread::yield();
+
+      {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        m_Stopping = true;
+        m_MessageAvailable.notify_one();
+      }
+
+      m_Writer.join();
+      m_Buffer.reset();
+    }
+
+    void Write()
+    {
+      m_WriterID.store(std::this_thread::get_id());
+
+      std::optional<mitk::LogMessage> message;
+      constexpr std::size_t MaximumBatchSize = 256;
+
+      while (true)
+      {
+        std::size_t batchSize = 0;
+
+        {
+          std::lock_guard<std::recursive_mutex> lock(backendsMutex);
+
+          while (batchSize < MaximumBatchSize && m_Buffer->TryPop(message))
+          {
+            WriteToBackends(*message, false);
+            message.reset();
+            ++batchSize;
+          }
+
+          if (0 != batchSize)
+            FlushBackends();
+        }
+
+        if (0 != batchSize)
+        {
+          std::lock_guard<std::mutex> lock(m_Mutex);
+          m_NumberOfWrittenMessages += batchSize;
+          m_MessagesWritten.notify_all();
+          m_SpaceAvailable.notify_all();
+          continue;
+        }
+
+        std::unique_lock<std::mutex> lock(m_Mutex);
+
+        if (m_Stopping && m_NumberOfWrittenMessages.load() >= m_Buffer->GetNumberOfPushes())
+          break;
+
+        // re-check after announcing the sleep, a producer may have pushed in between
+        m_WriterSleeping.store(true);
+
+        if (m_NumberOfWrittenMessages.load() >= m_Buffer->GetNumberOfPushes() && !m_Stopping)
+          m_MessageAvailable.wait_for(lock, std::chrono::milliseconds(100));
+
+        m_WriterSleeping.store(false);
+      }
+
+      m_WriterID.store(std::thread::id());
+    }
+
+    std::unique_ptr<mitk::LogRingBuffer<mitk::LogMessage>> m_Buffer;
+    mitk::LogOverflowPolicy m_Policy = mitk::LogOverflowPolicy::Block;
+
+    std::thread m_Writer;
+    std::atomic<std::thread::id> m_WriterID{std::thread::id()};
+    std::atomic<bool> m_Enabled{false};
+    std::atomic<bool> m_WriterSleeping{false};
+    bool m_Stopping = false;
+
+    std::atomic<std::size_t> m_NumberOfProducers{0};
+    std::atomic<std::size_t> m_NumberOfWrittenMessages{0};
+
+    std::mutex m_ControlMutex;
+    std::mutex m_Mutex;
+    std::condition_variable m_MessageAvailable;
+    std::condition_variable m_SpaceAvailable;
+    std::condition_variable m_MessagesWritten;
+  };
+
+  AsynchronousLogger& GetAsynchronousLogger()
+  {
+    static AsynchronousLogger logger;
+    return logger;
+  }
+}
+
 void mitk::RegisterBackend(LogBackendBase* backend)
 {
+  std::lock_guard<std::recursive_mutex> lock(backendsMutex);
   backends.push_back(backend);
 }
 
 void mitk::UnregisterBackend(LogBackendBase* backend)
 {
+  std::lock_guard<std::recursive_mutex> lock(backendsMutex);
   backends.remove(backend);
 }
 
@@ -40,41 +327,70 @@ void mitk::DistributeToBackends(LogMessage& message)
       : "";
   }
 
-  // create dummy backend if there is no backend registered (so we have an output anyway)
-  static LogBackendCout* dummyBackend = nullptr;
+  ++numberOfMessages[GetLevelIndex(message.Level)];
 
-  if (backends.empty() && dummyBackend == nullptr)
-  {
-    dummyBackend = new LogBackendCout;
-    RegisterBackend(dummyBackend);
-  }
-  else if (backends.size() > 1 && dummyBackend != nullptr)
-  {
-    // if there was added another backend remove the dummy backend and delete it
-    UnregisterBackend(dummyBackend);
-    delete dummyBackend;
-    dummyBackend = nullptr;
-  }
+  auto& logger = GetAsynchronousLogger();
 
-  // iterate through all registered images and call the ProcessMessage() methods of the backends
-  for (auto i = backends.begin(); i != backends.end(); ++i)
-  {
-    if (IsBackendEnabled((*i)->GetOutputType()))
-      (*i)->ProcessMessage(message);
-  }
+  // messages of the writer thread itself (e.g. logged by a backend) are written directly to avoid a deadlock
+  if (!logger.IsWriterThread() && logger.Push(message))
+    return;
+
+  WriteToBackends(message, true);
 }
 
 void mitk::EnableBackends(LogBackendBase::OutputType type)
 {
+  std::lock_guard<std::recursive_mutex> lock(backendsMutex);
   disabledBackendTypes.erase(type);
 }
 
 void mitk::DisableBackends(LogBackendBase::OutputType type)
 {
+  std::lock_guard<std::recursive_mutex> lock(backendsMutex);
   disabledBackendTypes.insert(type);
 }
 
 bool mitk::IsBackendEnabled(LogBackendBase::OutputType type)
 {
+  std::lock_guard<std::recursive_mutex> lock(backendsMutex);
   return disabledBackendTypes.find(type) == disabledBackendTypes.end();
 }
+
+void mitk::EnableAsynchronousLogging(std::size_t capacity, LogOverflowPolicy policy)
+{
+  GetAsynchronousLogger().Enable(capacity, policy);
+}
+
+void mitk::DisableAsynchronousLogging()
+{
+  GetAsynchronousLogger().Disable();
+}
+
+bool mitk::IsAsynchronousLoggingEnabled()
+{
+  return GetAsynchronousLogger().IsEnabled();
+}
+
+void mitk::FlushLog()
+{
+  GetAsynchronousLogger().Flush();
+}
+
+std::size_t mitk::GetNumberOfLogMessages(LogLevel level)
+{
+  return numberOfMessages[GetLevelIndex(level)].load();
+}
+
+std::size_t mitk::GetNumberOfDroppedLogMessages(LogLevel level)
+{
+  return numberOfDroppedMessages[GetLevelIndex(level)].load();
+}
+
+void mitk::ResetLogCounters()
+{
+  for (std::size_t i = 0; i < NumberOfLogLevels; ++i)
+  {
+    numberOfMessages[i] = 0;
+    numberOfDroppedMessages[i] = 0;
+  }
+}
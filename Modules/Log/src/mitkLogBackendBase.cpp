@@ -15,3 +15,7 @@ found in the LICENSE file.
 mitk::LogBackendBase::~LogBackendBase()
 {
 }
+
+void mitk::LogBackendBase::Flush()
+{
+}
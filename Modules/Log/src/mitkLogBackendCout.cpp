@@ -12,6 +12,8 @@ found in the LICENSE file.
 
 #include <mitkLogBackendCout.h>
 
+#include <iostream>
+
 mitk::LogBackendCout::LogBackendCout()
   : m_UseFullOutput(false)
 {
@@ -38,6 +40,11 @@ void mitk::LogBackendCout::ProcessMessage(const LogMessage& message)
   }
 }
 
+void mitk::LogBackendCout::Flush()
+{
+  std::cout.flush();
+}
+
 mitk::LogBackendCout::OutputType mitk::LogBackendCout::GetOutputType() const
 {
   return OutputType::Console;
@@ -13,6 +13,7 @@ found in the LICENSE file.
 #include <mitkLogBackendText.h>
 #include <mitkLogLevel.h>
 
+#include <chrono>
 #include <ctime>
 #include <iomanip>
 #include <iostream>
@@ -26,6 +27,16 @@ found in the LICENSE file.
 
 static bool g_init = false;
 
+static const std::chrono::steady_clock::time_point g_startTime = std::chrono::steady_clock::now();
+
+/** Messages are formatted with the time of their emission, which may be earlier than the time of
+ * formatting if the message was queued by the asynchronous log mechanism.
+ */
+static double GetSecondsSinceStart(const mitk::LogMessage &message)
+{
+  return std::chrono::duration<double>(message.TimeStamp - g_startTime).count();
+}
+
 mitk::LogBackendText::~LogBackendText()
 {
 }
@@ -286,14 +297,14 @@ void mitk::LogBackendText::FormatSmart(std::ostream &out, const LogMessage &mess
   {
     g_init = true;
     AppendTimeStamp(out);
-    out << std::endl;
+    out << '\n';
   }
 
   std::locale C("C");
   std::locale originalLocale = out.getloc();
   out.imbue(C);
 
-  out << std::fixed << std::setprecision(3) << ((double)std::clock()) / CLOCKS_PER_SEC;
+  out << std::fixed << std::setprecision(3) << GetSecondsSinceStart(message);
 
   out.imbue(originalLocale);
 
@@ -326,7 +337,7 @@ void mitk::LogBackendText::FormatSmart(std::ostream &out, const LogMessage &mess
       break;
   }
 
-  out << message.Message << std::endl;
+  out << message.Message << '\n';
 }
 
 void mitk::LogBackendText::FormatFull(std::ostream &out, const LogMessage &message, int threadID)
@@ -365,7 +376,7 @@ void mitk::LogBackendText::FormatFull(std::ostream &out, const LogMessage &messa
   out << "|" << message.ModuleName;
   out << "|" << message.Category;
 
-  out << message.Message << std::endl;
+  out << message.Message << '\n';
 }
 
 void mitk::LogBackendText::FormatSmart(const LogMessage &l, int threadID)
@@ -520,7 +531,7 @@ void mitk::LogBackendText::FormatSmartWindows(const LogMessage &message, int /*t
   std::locale originalLocale = std::cout.getloc();
   std::cout.imbue(C);
 
-  std::cout << std::fixed << std::setprecision(2) << ((double)std::clock()) / CLOCKS_PER_SEC << " ";
+  std::cout << std::fixed << std::setprecision(2) << GetSecondsSinceStart(message) << " ";
 
   std::cout.imbue(originalLocale);
 
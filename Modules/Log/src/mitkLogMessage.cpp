@@ -14,7 +14,8 @@ found in the LICENSE file.
 
 mitk::LogMessage::LogMessage(const LogLevel level, const std::string& filePath, const int lineNumber,
                              const std::string& functionName)
-  : Level(level),
+  : TimeStamp(std::chrono::steady_clock::now()),
+    Level(level),
     FilePath(filePath),
     LineNumber(lineNumber),
     FunctionName(functionName)
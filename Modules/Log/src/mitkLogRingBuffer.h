@@ -0,0 +1,142 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef mitkLogRingBuffer_h
+#define mitkLogRingBuffer_h
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <optional>
+
+namespace mitk
+{
+  /** \brief Bounded lock-free queue for the asynchronous log mechanism.
+   *
+   * Any number of threads may push concurrently, messages are popped by a single thread in the order in which
+   * their pushes succeeded. Every cell carries a sequence number that tells producers and the consumer whether
+   * the cell is free or filled for their current round through the buffer (D. Vyukov's bounded queue).
+   */
+  template <typename T>
+  class LogRingBuffer
+  {
+  public:
+    /** \brief The capacity is rounded up to the next power of two (at least 2).
+     */
+    explicit LogRingBuffer(std::size_t capacity)
+    {
+      std::size_t size = 2;
+
+      while (size < capacity)
+        size <<= 1;
+
+      m_Mask = size - 1;
+      m_Cells = std::make_unique<Cell[]>(size);
+
+      for (std::size_t i = 0; i < size; ++i)
+        m_Cells[i].Sequence.store(i, std::memory_order_relaxed);
+
+      m_PushPosition.store(0, std::memory_order_relaxed);
+      m_PopPosition.store(0, std::memory_order_relaxed);
+    }
+
+    LogRingBuffer(const LogRingBuffer&) = delete;
+    LogRingBuffer& operator=(const LogRingBuffer&) = delete;
+
+    std::size_t GetCapacity() const
+    {
+      return m_Mask + 1;
+    }
+
+    /** \brief Number of successful or ongoing pushes since construction.
+     */
+    std::size_t GetNumberOfPushes() const
+    {
+      return m_PushPosition.load();
+    }
+
+    /** \brief Returns false without modifying value if the buffer is full.
+     *
+     * On success, ticket is set to the number of pushes up to and including this one, i.e., the value is popped
+     * as soon as ticket values have been popped.
+     */
+    bool TryPush(T& value, std::size_t& ticket)
+    {
+      auto position = m_PushPosition.load(std::memory_order_relaxed);
+      Cell* cell = nullptr;
+
+      while (true)
+      {
+        cell = &m_Cells[position & m_Mask];
+        const auto sequence = cell->Sequence.load(std::memory_order_acquire);
+        const auto difference = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(position);
+
+        if (0 == difference)
+        {
+          if (m_PushPosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+            break;
+        }
+        else if (difference < 0)
+        {
+          return false;
+        }
+        else
+        {
+          position = m_PushPosition.load(std::memory_order_relaxed);
+        }
+      }
+
+      cell->Value.emplace(std::move(value));
+      cell->Sequence.store(position + 1, std::memory_order_release);
+
+      ticket = position + 1;
+
+      return true;
+    }
+
+    /** \brief Returns false if the buffer is empty. Must only be called by the consumer thread.
+     */
+    bool TryPop(std::optional<T>& value)
+    {
+      const auto position = m_PopPosition.load(std::memory_order_relaxed);
+      Cell& cell = m_Cells[position & m_Mask];
+      const auto sequence = cell.Sequence.load(std::memory_order_acquire);
+
+      if (sequence != position + 1)
+        return false;
+
+      m_PopPosition.store(position + 1, std::memory_order_relaxed);
+
+      value.emplace(std::move(*cell.Value));
+      cell.Value.reset();
+      cell.Sequence.store(position + m_Mask + 1, std::memory_order_release);
+
+      return true;
+    }
+
+  private:
+    struct Cell
+    {
+      std::atomic<std::size_t> Sequence;
+      std::optional<T> Value;
+    };
+
+    std::unique_ptr<Cell[]> m_Cells;
+    std::size_t m_Mask;
+
+    // separate cache lines, producers and the consumer should not invalidate each other's position
+    alignas(64) std::atomic<std::size_t> m_PushPosition;
+    alignas(64) std::atomic<std::size_t> m_PopPosition;
+  };
+}
+
+#endif
@@ -14,6 +14,17 @@ found in the LICENSE file.
 #include "mitkTestFixture.h"
 
 #include "mitkTimeFramesRegistrationHelper.h"
+#include "mitkImagePixelWriteAccessor.h"
+#include "mitkImageReadAccessor.h"
+
+#include "mitkFastSymmetricForcesDemonsMultiResDefaultRegistrationAlgorithm.h"
+
+#include <itkCommand.h>
+
+#include <atomic>
+#include <cmath>
+#include <string>
+#include <vector>
 
 class mitkTimeFramesRegistrationHelperTestSuite : public mitk::TestFixture
 {
@@ -25,11 +36,84 @@ class mitkTimeFramesRegistrationHelperTestSuite : public mitk::TestFixture
   MITK_TEST(SetAllowUnregPixels_GetAllowUnregPixels);
   MITK_TEST(SetInterpolatorType_GetInterpolatorType);
   MITK_TEST(Set_Get_Clear_IgnoreList);
+  MITK_TEST(Generate_Concurrent_MatchesSequential);
   CPPUNIT_TEST_SUITE_END();
 private:
+  using AlgorithmImageType = map::core::discrete::Elements<3>::InternalImageType;
+  using AlgorithmType = mitk::FastSymmetricForcesDemonsMultiResDefaultRegistrationAlgorithm<AlgorithmImageType>;
+
   mitk::TimeFramesRegistrationHelper::Pointer frameRegHelper;
   mitk::TimeFramesRegistrationHelper::IgnoreListType ignoreList;
 
+  /** Generates a 4D image whose frames show a blob that moves by one voxel per frame.*/
+  static mitk::Image::Pointer GenerateMovingBlobImage(unsigned int numberOfFrames)
+  {
+    unsigned int dimensions[4] = { 24, 24, 24, numberOfFrames };
+
+    auto image = mitk::Image::New();
+    image->Initialize(mitk::MakeScalarPixelType<float>(), 4, dimensions);
+
+    mitk::ImagePixelWriteAccessor<float, 4> accessor(image);
+    itk::Index<4> index;
+
+    for (index[3] = 0; index[3] < numberOfFrames; ++index[3])
+    {
+      for (index[2] = 0; index[2] < 24; ++index[2])
+      {
+        for (index[1] = 0; index[1] < 24; ++index[1])
+        {
+          for (index[0] = 0; index[0] < 24; ++index[0])
+          {
+            const double dx = index[0] - 10.0 - index[3];
+            const double dy = index[1] - 12.0;
+            const double dz = index[2] - 12.0;
+            accessor.SetPixelByIndex(index, static_cast<float>(100.0 * std::exp(-(dx * dx + dy * dy + dz * dz) / 18.0)));
+          }
+        }
+      }
+    }
+
+    return image;
+  }
+
+  /** Records the events invoked by a helper in the order of invocation.*/
+  static itk::CStyleCommand::Pointer CreateEventRecorder(std::vector<std::string>& events)
+  {
+    auto command = itk::CStyleCommand::New();
+    command->SetClientData(&events);
+    command->SetConstCallback([](const itk::Object*, const itk::EventObject& event, void* clientData)
+    {
+      auto* recordedEvents = static_cast<std::vector<std::string>*>(clientData);
+      const auto* mapEvent = dynamic_cast<const ::map::events::AnyMatchPointEvent*>(&event);
+
+      recordedEvents->push_back(std::string(event.GetEventName()) + (nullptr != mapEvent ? ": " + mapEvent->getComment() : ""));
+    });
+
+    return command;
+  }
+
+  static mitk::Image::Pointer GenerateRegisteredImage(const mitk::Image* image,
+                                                      const mitk::TimeFramesRegistrationHelper::IgnoreListType& ignoreList,
+                                                      const mitk::TimeFramesRegistrationHelper::AlgorithmProviderType& provider,
+                                                      std::vector<std::string>& events)
+  {
+    auto helper = mitk::TimeFramesRegistrationHelper::New();
+    helper->Set4DImage(image);
+    helper->SetAlgorithm(AlgorithmType::New());
+    helper->SetAlgorithmProvider(provider);
+    helper->SetMaximumNumberOfThreads(3);
+    helper->SetIgnoreList(ignoreList);
+
+    auto recorder = CreateEventRecorder(events);
+    helper->AddObserver(::map::events::AnyMatchPointEvent(), recorder);
+    helper->AddObserver(::itk::ProgressEvent(), recorder);
+
+    auto result = helper->GetRegisteredImage();
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(1.0, helper->GetProgress(), 1e-10);
+
+    return result;
+  }
+
 public:
   void setUp() override
   {
@@ -102,6 +186,70 @@ public:
     CPPUNIT_ASSERT(frameRegHelper->GetIgnoreList().empty());
   }
 
+  void Generate_Concurrent_MatchesSequential()
+  {
+    const unsigned int numberOfFrames = 6;
+    auto image = GenerateMovingBlobImage(numberOfFrames);
+    const mitk::TimeFramesRegistrationHelper::IgnoreListType ignoredFrames = { 3 };
+
+    std::vector<std::string> sequentialEvents;
+    auto sequentialResult = GenerateRegisteredImage(image, ignoredFrames,
+                                                    mitk::TimeFramesRegistrationHelper::AlgorithmProviderType(), sequentialEvents);
+
+    std::atomic<unsigned int> numberOfProvidedAlgorithms(0);
+    std::vector<std::string> concurrentEvents;
+    auto concurrentResult = GenerateRegisteredImage(image, ignoredFrames, [&numberOfProvidedAlgorithms]()
+    {
+      ++numberOfProvidedAlgorithms;
+      return mitk::TimeFramesRegistrationHelper::RegistrationAlgorithmPointer(AlgorithmType::New().GetPointer());
+    }, concurrentEvents);
+
+    CPPUNIT_ASSERT_MESSAGE("Check that the frames were processed by the provided algorithms",
+                           numberOfProvidedAlgorithms >= 1 && numberOfProvidedAlgorithms <= 3);
+
+    // events in frame order, the ignored frame only reports progress
+    std::vector<std::string> expectedEvents;
+
+    for (unsigned int i = 1; i < numberOfFrames; ++i)
+    {
+      if (3 != i)
+      {
+        expectedEvents.push_back("FrameRegistrationEvent: Registered frame #" + std::to_string(i));
+        expectedEvents.push_back("FrameMappingEvent: Mapped frame #" + std::to_string(i));
+      }
+
+      expectedEvents.push_back("ProgressEvent");
+    }
+
+    CPPUNIT_ASSERT(expectedEvents == sequentialEvents);
+    CPPUNIT_ASSERT(expectedEvents == concurrentEvents);
+
+    // both paths register every frame with an identically configured algorithm
+    CPPUNIT_ASSERT_EQUAL(numberOfFrames, concurrentResult->GetTimeSteps());
+
+    for (unsigned int t = 0; t < numberOfFrames; ++t)
+    {
+      mitk::ImageReadAccessor sequentialAccessor(sequentialResult, sequentialResult->GetVolumeData(t));
+      mitk::ImageReadAccessor concurrentAccessor(concurrentResult, concurrentResult->GetVolumeData(t));
+      mitk::ImageReadAccessor inputAccessor(image, image->GetVolumeData(t));
+
+      const auto* sequentialData = static_cast<const float*>(sequentialAccessor.GetData());
+      const auto* concurrentData = static_cast<const float*>(concurrentAccessor.GetData());
+      const auto* inputData = static_cast<const float*>(inputAccessor.GetData());
+
+      bool differsFromInput = false;
+
+      for (unsigned int i = 0; i < 24 * 24 * 24; ++i)
+      {
+        CPPUNIT_ASSERT_DOUBLES_EQUAL(sequentialData[i], concurrentData[i], 1e-3);
+        differsFromInput = differsFromInput || std::abs(inputData[i] - concurrentData[i]) > 1e-3;
+      }
+
+      // only registered frames are changed
+      CPPUNIT_ASSERT_EQUAL_MESSAGE("Check frame #" + std::to_string(t), 0 != t && 3 != t, differsFromInput);
+    }
+  }
+
 };
 
 MITK_TEST_SUITE_REGISTRATION(mitkTimeFramesRegistrationHelper)
@@ -24,6 +24,8 @@ found in the LICENSE file.
 
 #include "MitkMatchPointRegistrationExports.h"
 
+#include <functional>
+
 namespace mitk
 {
 
@@ -39,6 +41,13 @@ namespace mitk
    * - mitk::FrameRegistrationEvent: when ever a frame was registered.
    * - mitk::FrameMappingEvent: when ever a frame was mapped registered.
    * - itk::ProgressEvent: when ever a new frame was added to the result image.
+   *
+   * If an algorithm provider is set, frames are registered and mapped concurrently. Every worker thread
+   * requests its own algorithm instance from the provider, because a registration algorithm can only process
+   * one registration at a time. The number of concurrently processed frames is limited by
+   * MaximumNumberOfThreads and by the MemoryBudget. Mapped frames are written into the result image as soon
+   * as they are available. All events are still invoked by the thread calling Generate() and in frame order.
+   * Without provider, the frames are processed sequentially with the algorithm set via SetAlgorithm().
    */
   class MITKMATCHPOINTREGISTRATION_EXPORT TimeFramesRegistrationHelper : public itk::Object
   {
@@ -54,6 +63,10 @@ namespace mitk
 
     typedef std::vector<mitk::TimeStepType> IgnoreListType;
 
+    /** Function that returns a new, configured algorithm instance on each call. It is called from the worker
+     * threads and therefore must be thread-safe.*/
+    typedef std::function<RegistrationAlgorithmPointer()> AlgorithmProviderType;
+
     itkSetConstObjectMacro(4DImage, Image);
     itkGetConstObjectMacro(4DImage, Image);
 
@@ -63,6 +76,23 @@ namespace mitk
     itkSetObjectMacro(Algorithm, RegistrationAlgorithmBaseType);
     itkGetObjectMacro(Algorithm, RegistrationAlgorithmBaseType);
 
+    /** Sets the provider of the algorithm instances used for the concurrent processing of frames.
+     * Pass an empty function to process the frames sequentially with the algorithm set via SetAlgorithm().*/
+    void SetAlgorithmProvider(const AlgorithmProviderType& provider);
+    const AlgorithmProviderType& GetAlgorithmProvider() const;
+
+    /** Maximum number of frames processed concurrently. Defaults to the number of hardware threads;
+     * 0 also uses the number of hardware threads. Only relevant if an algorithm provider is set.*/
+    itkSetMacro(MaximumNumberOfThreads, unsigned int);
+    itkGetConstMacro(MaximumNumberOfThreads, unsigned int);
+
+    /** Memory in bytes that may be occupied by the frames in process. The number of concurrently processed
+     * frames is reduced accordingly, but at least one frame is processed. Defaults to half of the physical
+     * memory that is available when the helper is created. 0 means no limit.
+     * Only relevant if an algorithm provider is set. @sa EstimateFrameMemory()*/
+    itkSetMacro(MemoryBudget, unsigned long long);
+    itkGetConstMacro(MemoryBudget, unsigned long long);
+
     itkSetMacro(AllowUndefPixels, bool);
     itkGetConstMacro(AllowUndefPixels, bool);
 
@@ -104,23 +134,14 @@ namespace mitk
     Image::Pointer GetRegisteredImage();
 
   protected:
-    TimeFramesRegistrationHelper() :
-      m_AllowUndefPixels(true),
-      m_PaddingValue(0),
-      m_AllowUnregPixels(true),
-      m_ErrorValue(0),
-      m_InterpolatorType(mitk::ImageMappingInterpolator::Linear),
-      m_Progress(0)
-    {
-      m_4DImage = nullptr;
-      m_TargetMask = nullptr;
-      m_Registered4DImage = nullptr;
-    };
+    TimeFramesRegistrationHelper();
 
     ~TimeFramesRegistrationHelper() override {};
 
     RegistrationPointer DoFrameRegistration(const mitk::Image* movingFrame,
                                             const mitk::Image* targetFrame, const mitk::Image* targetMask) const;
+    RegistrationPointer DoFrameRegistration(RegistrationAlgorithmBaseType* algorithm, const mitk::Image* movingFrame,
+                                            const mitk::Image* targetFrame, const mitk::Image* targetMask) const;
 
     mitk::Image::Pointer DoFrameMapping(const mitk::Image* movingFrame, const RegistrationType* reg,
                                         const mitk::Image* targetFrame) const;
@@ -132,6 +153,14 @@ namespace mitk
 
     mitk::Image::Pointer GetFrameImage(const mitk::Image* image, mitk::TimePointType timePoint) const;
 
+    /** Estimated peak memory in bytes needed to register and map one frame: the extracted moving frame,
+     * the mapped frame and the working copies of the registration algorithm (e.g. images casted to its
+     * internal pixel type and resolution pyramids).*/
+    virtual unsigned long long EstimateFrameMemory() const;
+
+    /** Number of frames that may be processed concurrently given the thread and memory limits.*/
+    unsigned int GetNumberOfConcurrentFrames(unsigned int numberOfFrames) const;
+
     RegistrationAlgorithmPointer m_Algorithm;
 
   private:
@@ -153,6 +182,15 @@ namespace mitk
     mitk::ImageMappingInterpolator::Type m_InterpolatorType;
 
     double m_Progress;
+
+    AlgorithmProviderType m_AlgorithmProvider;
+    unsigned int m_MaximumNumberOfThreads;
+    unsigned long long m_MemoryBudget;
+
+    void GenerateSequential(const IgnoreListType& frames, const mitk::Image* targetFrame, const mitk::Image* mask);
+    void GenerateConcurrent(const IgnoreListType& frames, const mitk::Image* targetFrame, const mitk::Image* mask,
+                            unsigned int numberOfThreads);
+    void StoreMappedFrame(const mitk::Image* mappedFrame, mitk::TimeStepType timeStep);
   };
 
 }
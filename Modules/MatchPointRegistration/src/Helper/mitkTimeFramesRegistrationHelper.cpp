@@ -19,6 +19,35 @@ found in the LICENSE file.
 #include <mitkMaskedAlgorithmHelper.h>
 #include <mitkMAPAlgorithmHelper.h>
 
+#include <itksys/SystemInformation.hxx>
+
+#include <algorithm>
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+#include <thread>
+
+mitk::TimeFramesRegistrationHelper::TimeFramesRegistrationHelper() :
+  m_AllowUndefPixels(true),
+  m_PaddingValue(0),
+  m_AllowUnregPixels(true),
+  m_ErrorValue(0),
+  m_InterpolatorType(mitk::ImageMappingInterpolator::Linear),
+  m_Progress(0),
+  m_MaximumNumberOfThreads(std::max(1u, std::thread::hardware_concurrency())),
+  m_MemoryBudget(0)
+{
+  m_4DImage = nullptr;
+  m_TargetMask = nullptr;
+  m_Registered4DImage = nullptr;
+
+  itksys::SystemInformation systemInformation;
+  systemInformation.QueryMemory();
+
+  // the memory is reported in MiB; if it cannot be determined, the budget stays unlimited
+  m_MemoryBudget = static_cast<unsigned long long>(systemInformation.GetAvailablePhysicalMemory()) * 1024 * 1024 / 2;
+};
+
 mitk::Image::Pointer
 mitk::TimeFramesRegistrationHelper::GetFrameImage(const mitk::Image* image,
     mitk::TimePointType timePoint) const
@@ -56,39 +85,56 @@ mitk::TimeFramesRegistrationHelper::Generate()
     }
   }
 
-  double progressDelta = 1.0 / ((this->m_4DImage->GetTimeSteps() - 1) * 3.0);
-  m_Progress = 0.0;
+  IgnoreListType frames;
 
-  //process the frames
   for (unsigned int i = 1; i < this->m_4DImage->GetTimeSteps(); ++i)
   {
-    Image::Pointer movingFrame = GetFrameImage(this->m_4DImage, i);
-    Image::Pointer mappedFrame;
+    if (std::find(m_IgnoreList.begin(), m_IgnoreList.end(), i) == m_IgnoreList.end())
+    {
+      frames.push_back(i);
+    }
+  }
+
+  m_Progress = 0.0;
 
-    IgnoreListType::iterator finding = std::find(m_IgnoreList.begin(), m_IgnoreList.end(), i);
+  const unsigned int numberOfThreads = this->GetNumberOfConcurrentFrames(static_cast<unsigned int>(frames.size()));
 
+  if (numberOfThreads > 1)
+  {
+    this->GenerateConcurrent(frames, targetFrame, mask, numberOfThreads);
+  }
+  else
+  {
+    this->GenerateSequential(frames, targetFrame, mask);
+  }
+};
 
-    if (finding == m_IgnoreList.end())
+void
+mitk::TimeFramesRegistrationHelper::GenerateSequential(const IgnoreListType& frames,
+    const mitk::Image* targetFrame, const mitk::Image* mask)
+{
+  double progressDelta = 1.0 / ((this->m_4DImage->GetTimeSteps() - 1) * 3.0);
+
+  //process the frames
+  for (unsigned int i = 1; i < this->m_4DImage->GetTimeSteps(); ++i)
+  {
+    if (std::find(frames.begin(), frames.end(), i) != frames.end())
     {
       //frame should be processed
+      Image::Pointer movingFrame = GetFrameImage(this->m_4DImage, i);
       RegistrationPointer reg = DoFrameRegistration(movingFrame, targetFrame, mask);
 
       m_Progress += progressDelta;
       this->InvokeEvent(::mitk::FrameRegistrationEvent(nullptr,
                         "Registered frame #" +::map::core::convert::toStr(i)));
 
-      mappedFrame = DoFrameMapping(movingFrame, reg, targetFrame);
+      Image::Pointer mappedFrame = DoFrameMapping(movingFrame, reg, targetFrame);
 
       m_Progress += progressDelta;
       this->InvokeEvent(::mitk::FrameMappingEvent(nullptr,
                         "Mapped frame #" + ::map::core::convert::toStr(i)));
 
-      mitk::ImageReadAccessor accessor(mappedFrame, mappedFrame->GetVolumeData(0, 0, nullptr,
-                                       mitk::Image::ReferenceMemory));
-
-
-      this->m_Registered4DImage->SetVolume(accessor.GetData(), i);
-      this->m_Registered4DImage->GetTimeGeometry()->SetTimeStepGeometry(mappedFrame->GetGeometry(), i);
+      this->StoreMappedFrame(mappedFrame, i);
 
       m_Progress += progressDelta;
     }
@@ -98,9 +144,241 @@ mitk::TimeFramesRegistrationHelper::Generate()
     }
 
     this->InvokeEvent(::itk::ProgressEvent());
+  }
+};
 
+void
+mitk::TimeFramesRegistrationHelper::GenerateConcurrent(const IgnoreListType& frames,
+    const mitk::Image* targetFrame, const mitk::Image* mask, unsigned int numberOfThreads)
+{
+  /* Workers take the next unprocessed frame, register and map it and write the result into the output
+   * image. The calling thread waits for the frames in order and invokes the events, so that observers see
+   * the same sequence of events as in the sequential case.*/
+  enum class FrameState
+  {
+    Pending,
+    Registered,
+    Mapped,
+    Stored,
+    Failed
+  };
+
+  std::vector<FrameState> states(frames.size(), FrameState::Pending);
+  std::vector<std::exception_ptr> errors(frames.size());
+  std::size_t nextFrame = 0;
+  bool abort = false;
+
+  std::mutex mutex;
+  // time selection and SetVolume() initialize the volumes of the 4D images, which is not thread-safe
+  std::mutex volumeMutex;
+  std::condition_variable stateChanged;
+
+  auto setState = [&](std::size_t frameIndex, FrameState state)
+  {
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      states[frameIndex] = state;
+    }
+    stateChanged.notify_all();
+  };
+
+  auto worker = [&]()
+  {
+    RegistrationAlgorithmPointer algorithm;
+
+    while (true)
+    {
+      std::size_t frameIndex = 0;
+
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+
+        if (abort || nextFrame >= frames.size())
+        {
+          return;
+        }
+
+        frameIndex = nextFrame++;
+      }
+
+      try
+      {
+        if (algorithm.IsNull())
+        {
+          algorithm = m_AlgorithmProvider();
+
+          if (algorithm.IsNull())
+          {
+            mitkThrow() << "Cannot register image. Algorithm provider did not return an algorithm.";
+          }
+        }
+
+        Image::Pointer movingFrame;
+
+        {
+          std::lock_guard<std::mutex> lock(volumeMutex);
+          movingFrame = GetFrameImage(this->m_4DImage, frames[frameIndex]);
+        }
+
+        RegistrationPointer reg = DoFrameRegistration(algorithm, movingFrame, targetFrame, mask);
+        setState(frameIndex, FrameState::Registered);
+
+        Image::Pointer mappedFrame = DoFrameMapping(movingFrame, reg, targetFrame);
+        movingFrame = nullptr;
+        reg = nullptr;
+        setState(frameIndex, FrameState::Mapped);
+
+        {
+          std::lock_guard<std::mutex> lock(volumeMutex);
+          this->StoreMappedFrame(mappedFrame, frames[frameIndex]);
+        }
+
+        setState(frameIndex, FrameState::Stored);
+      }
+      catch (...)
+      {
+        errors[frameIndex] = std::current_exception();
+        setState(frameIndex, FrameState::Failed);
+      }
+    }
+  };
+
+  std::vector<std::thread> threads;
+
+  auto stopWorkers = [&]()
+  {
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      abort = true;
+    }
+
+    for (auto& thread : threads)
+    {
+      thread.join();
+    }
+
+    threads.clear();
+  };
+
+  for (unsigned int i = 0; i < numberOfThreads; ++i)
+  {
+    threads.emplace_back(worker);
   }
 
+  try
+  {
+    double progressDelta = 1.0 / ((this->m_4DImage->GetTimeSteps() - 1) * 3.0);
+    std::size_t frameIndex = 0;
+
+    auto waitFor = [&](FrameState state)
+    {
+      std::unique_lock<std::mutex> lock(mutex);
+      stateChanged.wait(lock, [&]() { return states[frameIndex] >= state; });
+
+      if (FrameState::Failed == states[frameIndex])
+      {
+        std::rethrow_exception(errors[frameIndex]);
+      }
+    };
+
+    for (unsigned int i = 1; i < this->m_4DImage->GetTimeSteps(); ++i)
+    {
+      if (frameIndex < frames.size() && frames[frameIndex] == i)
+      {
+        waitFor(FrameState::Registered);
+        m_Progress += progressDelta;
+        this->InvokeEvent(::mitk::FrameRegistrationEvent(nullptr,
+                          "Registered frame #" + ::map::core::convert::toStr(i)));
+
+        waitFor(FrameState::Mapped);
+        m_Progress += progressDelta;
+        this->InvokeEvent(::mitk::FrameMappingEvent(nullptr,
+                          "Mapped frame #" + ::map::core::convert::toStr(i)));
+
+        waitFor(FrameState::Stored);
+        m_Progress += progressDelta;
+        ++frameIndex;
+      }
+      else
+      {
+        m_Progress += 3 * progressDelta;
+      }
+
+      this->InvokeEvent(::itk::ProgressEvent());
+    }
+  }
+  catch (...)
+  {
+    stopWorkers();
+    throw;
+  }
+
+  stopWorkers();
+};
+
+void
+mitk::TimeFramesRegistrationHelper::StoreMappedFrame(const mitk::Image* mappedFrame, mitk::TimeStepType timeStep)
+{
+  mitk::ImageReadAccessor accessor(mappedFrame, mappedFrame->GetVolumeData(0, 0, nullptr,
+                                   mitk::Image::ReferenceMemory));
+
+  this->m_Registered4DImage->SetVolume(accessor.GetData(), timeStep);
+  this->m_Registered4DImage->GetTimeGeometry()->SetTimeStepGeometry(mappedFrame->GetGeometry(), timeStep);
+};
+
+unsigned long long
+mitk::TimeFramesRegistrationHelper::EstimateFrameMemory() const
+{
+  unsigned long long frameVoxels = 1;
+
+  for (unsigned int i = 0; i < this->m_4DImage->GetDimension(); ++i)
+  {
+    frameVoxels *= this->m_4DImage->GetDimension(i);
+  }
+
+  frameVoxels /= std::max(1u, this->m_4DImage->GetTimeSteps());
+
+  const unsigned long long frameSize = frameVoxels * this->m_4DImage->GetPixelType().GetSize();
+
+  // moving and mapped frame, plus two double precision working copies in the algorithm
+  return 2 * frameSize + 2 * frameVoxels * sizeof(double);
+};
+
+unsigned int
+mitk::TimeFramesRegistrationHelper::GetNumberOfConcurrentFrames(unsigned int numberOfFrames) const
+{
+  if (!m_AlgorithmProvider || numberOfFrames < 2)
+  {
+    return 1;
+  }
+
+  unsigned int result = m_MaximumNumberOfThreads;
+
+  if (0 == result)
+  {
+    result = std::max(1u, std::thread::hardware_concurrency());
+  }
+
+  if (0 != m_MemoryBudget)
+  {
+    const unsigned long long frameMemory = std::max(1ull, this->EstimateFrameMemory());
+    result = static_cast<unsigned int>(std::min<unsigned long long>(result, m_MemoryBudget / frameMemory));
+  }
+
+  return std::max(1u, std::min(result, numberOfFrames));
+};
+
+void
+mitk::TimeFramesRegistrationHelper::SetAlgorithmProvider(const AlgorithmProviderType& provider)
+{
+  m_AlgorithmProvider = provider;
+  this->Modified();
+};
+
+const mitk::TimeFramesRegistrationHelper::AlgorithmProviderType&
+mitk::TimeFramesRegistrationHelper::GetAlgorithmProvider() const
+{
+  return m_AlgorithmProvider;
 };
 
 mitk::Image::Pointer
@@ -134,13 +412,20 @@ mitk::TimeFramesRegistrationHelper::RegistrationPointer
 mitk::TimeFramesRegistrationHelper::DoFrameRegistration(const mitk::Image* movingFrame,
     const mitk::Image* targetFrame, const mitk::Image* targetMask) const
 {
-  mitk::MAPAlgorithmHelper algHelper(m_Algorithm);
+  return DoFrameRegistration(m_Algorithm, movingFrame, targetFrame, targetMask);
+};
+
+mitk::TimeFramesRegistrationHelper::RegistrationPointer
+mitk::TimeFramesRegistrationHelper::DoFrameRegistration(RegistrationAlgorithmBaseType* algorithm,
+    const mitk::Image* movingFrame, const mitk::Image* targetFrame, const mitk::Image* targetMask) const
+{
+  mitk::MAPAlgorithmHelper algHelper(algorithm);
   algHelper.SetAllowImageCasting(true);
   algHelper.SetData(movingFrame, targetFrame);
 
   if (targetMask)
   {
-    mitk::MaskedAlgorithmHelper maskHelper(m_Algorithm);
+    mitk::MaskedAlgorithmHelper maskHelper(algorithm);
     maskHelper.SetMasks(nullptr, targetMask);
   }
 
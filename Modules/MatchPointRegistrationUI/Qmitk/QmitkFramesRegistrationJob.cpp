@@ -174,6 +174,7 @@ void QmitkFramesRegistrationJob::run()
     m_helper->Set4DImage(this->GetTargetDataAsImage());
     m_helper->SetTargetMask(this->m_spTargetMask);
     m_helper->SetAlgorithm(this->m_spLoadedAlgorithm);
+    m_helper->SetAlgorithmProvider(this->m_AlgorithmProvider);
     m_helper->SetIgnoreList(this->m_IgnoreList);
 
     m_helper->SetAllowUndefPixels(this->m_allowUndefPixels);
@@ -74,6 +74,9 @@ public:
 
   // job settings
   mitk::TimeFramesRegistrationHelper::IgnoreListType m_IgnoreList;
+  /** Optional provider of additional algorithm instances. If set, frames are registered concurrently
+   * (see mitk::TimeFramesRegistrationHelper). Events of these instances are not forwarded.*/
+  mitk::TimeFramesRegistrationHelper::AlgorithmProviderType m_AlgorithmProvider;
   mitk::NodeUIDType m_TargetDataUID;
   mitk::NodeUIDType m_TargetMaskDataUID;
 
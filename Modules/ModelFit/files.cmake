@@ -75,6 +75,7 @@ set(CPP_FILES
 
 set(TPP_FILES
     include/itkMultiOutputNaryFunctorImageFilter.tpp
+    include/itkMultiOutputTimeCurveFunctorImageFilter.tpp
     include/itkMaskedStatisticsImageFilter.hxx
     include/itkMaskedNaryStatisticsImageFilter.hxx
 	include/mitkModelFitProviderBase.tpp
@@ -0,0 +1,152 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef __itkMultiOutputTimeCurveFunctorImageFilter_h
+#define __itkMultiOutputTimeCurveFunctorImageFilter_h
+
+#include "itkImageToImageFilter.h"
+
+namespace itk
+{
+/** \class MultiOutputTimeCurveFunctorImageFilter
+ * \brief Perform a generic voxel-wise operation on the time curves of a dynamic image and produce m output images.
+ *
+ * This is the counterpart of the itk::MultiOutputNaryFunctorImageFilter for dynamic images that are already
+ * given as one image with time as last dimension (e.g. a 4D image for 3D outputs). It does not need one input
+ * image per time frame. The time curves of the voxels are read directly from the buffer of the dynamic image.
+ * For each block of voxels the frames are first copied into a buffer in which the frames of a voxel are
+ * stored contiguously (interleaved per voxel), before the functor is called for each voxel of the block.\n
+ * The voxel blocks are distributed dynamically: every worker thread takes the next unprocessed block
+ * from a shared counter as soon as it has finished its current block. Voxels that take considerably
+ * longer to process (e.g. slowly converging fits) therefore do not stall a statically assigned
+ * image region of a thread.\n
+ * The functor has the same interface as the functors of itk::MultiOutputNaryFunctorImageFilter.
+ * After an update, the number of processed (unmasked) voxels and the achieved throughput can be
+ * retrieved.
+ *
+ * \ingroup IntensityImageFilters MultiThreaded
+ */
+template< class TInputImage, class TOutputImage, class TFunction, class TMaskImage = ::itk::Image<unsigned char, TOutputImage::ImageDimension> >
+class ITK_EXPORT MultiOutputTimeCurveFunctorImageFilter:
+  public ImageToImageFilter< TInputImage, TOutputImage >
+{
+public:
+  /** Standard class typedefs. */
+  typedef MultiOutputTimeCurveFunctorImageFilter          Self;
+  typedef ImageToImageFilter< TInputImage, TOutputImage > Superclass;
+  typedef SmartPointer< Self >                            Pointer;
+  typedef SmartPointer< const Self >                      ConstPointer;
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** Run-time type information (and related methods). */
+  itkTypeMacro(MultiOutputTimeCurveFunctorImageFilter, ImageToImageFilter);
+
+  /** Some typedefs. */
+  typedef TFunction                            FunctorType;
+  typedef TInputImage                          InputImageType;
+  typedef typename InputImageType::Pointer     InputImagePointer;
+  typedef typename InputImageType::RegionType  InputImageRegionType;
+  typedef typename InputImageType::PixelType   InputImagePixelType;
+  typedef TOutputImage                         OutputImageType;
+  typedef typename OutputImageType::Pointer    OutputImagePointer;
+  typedef typename OutputImageType::RegionType OutputImageRegionType;
+  typedef typename OutputImageType::PixelType  OutputImagePixelType;
+  typedef typename FunctorType::InputPixelArrayType     NaryInputArrayType;
+  typedef typename FunctorType::OutputPixelArrayType    NaryOutputArrayType;
+  typedef TMaskImage MaskImageType;
+  typedef typename MaskImageType::Pointer     MaskImagePointer;
+  typedef typename MaskImageType::RegionType  MaskImageRegionType;
+
+  /** Get the functor object.  The functor is returned by reference.
+   * (Functors do not have to derive from itk::LightObject, so they do
+   * not necessarily have a reference count. So we cannot return a
+   * SmartPointer). */
+  FunctorType & GetFunctor() { return m_Functor; }
+
+  /** Set the functor object.  This replaces the current Functor with a
+   * copy of the specified Functor. This method requires an operator!=()
+   * be defined on the functor. */
+  void SetFunctor(FunctorType & functor)
+  {
+    if ( m_Functor != functor )
+      {
+      m_Functor = functor;
+      this->ActualizeOutputs();
+      this->Modified();
+      }
+  }
+
+  itkSetObjectMacro(Mask, MaskImageType);
+  itkGetConstObjectMacro(Mask, MaskImageType);
+
+  /** Number of voxels that are handed to a worker thread at once. Small blocks
+   * give a better load balance, large blocks reduce the scheduling overhead.*/
+  itkSetClampMacro(NumberOfVoxelsPerBlock, SizeValueType, 1, NumericTraits<SizeValueType>::max());
+  itkGetConstMacro(NumberOfVoxelsPerBlock, SizeValueType);
+
+  /** Number of voxels passed to the functor during the last update (voxels outside of the mask are not counted).*/
+  itkGetConstMacro(NumberOfProcessedVoxels, SizeValueType);
+
+  /** Throughput (processed voxels per second) of the last update.*/
+  itkGetConstMacro(VoxelsPerSecond, double);
+
+  /** ImageDimension constants */
+  itkStaticConstMacro(
+    InputImageDimension, unsigned int, TInputImage::ImageDimension);
+  itkStaticConstMacro(
+    OutputImageDimension, unsigned int, TOutputImage::ImageDimension);
+
+#ifdef ITK_USE_CONCEPT_CHECKING
+  /** Begin concept checking */
+  itkConceptMacro( TimeDimensionCheck,
+                   ( Concept::SameDimension< InputImageDimension, OutputImageDimension + 1 > ) );
+  itkConceptMacro( OutputHasZeroCheck,
+                   ( Concept::HasZero< OutputImagePixelType > ) );
+  /** End concept checking */
+#endif
+protected:
+  MultiOutputTimeCurveFunctorImageFilter();
+  ~MultiOutputTimeCurveFunctorImageFilter() override {}
+
+  /** The outputs have the geometry of the spatial dimensions of the input.*/
+  void GenerateOutputInformation() override;
+
+  /** The filter always needs the complete dynamic image.*/
+  void GenerateInputRequestedRegion() override;
+
+  /** The filter always generates the complete outputs.*/
+  void EnlargeOutputRequestedRegion(DataObject * output) override;
+
+  void GenerateData() override;
+
+  /** Methods actualize the output settings of the filter according to the current functor*/
+  void ActualizeOutputs();
+
+private:
+  MultiOutputTimeCurveFunctorImageFilter(const Self &); //purposely not implemented
+  void operator=(const Self &);         //purposely not implemented
+
+  FunctorType m_Functor;
+  MaskImagePointer m_Mask;
+
+  SizeValueType m_NumberOfVoxelsPerBlock;
+  SizeValueType m_NumberOfProcessedVoxels;
+  double m_VoxelsPerSecond;
+};
+} // end namespace itk
+
+#ifndef ITK_MANUAL_INSTANTIATION
+#include "itkMultiOutputTimeCurveFunctorImageFilter.tpp"
+#endif
+
+#endif
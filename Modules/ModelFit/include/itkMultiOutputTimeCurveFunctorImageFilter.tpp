@@ -0,0 +1,260 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef __itkMultiOutputTimeCurveFunctorImageFilter_hxx
+#define __itkMultiOutputTimeCurveFunctorImageFilter_hxx
+
+#include "itkMultiOutputTimeCurveFunctorImageFilter.h"
+#include "itkMultiThreaderBase.h"
+#include "itkTotalProgressReporter.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+
+namespace itk
+{
+  /**
+  * Constructor
+  */
+  template< class TInputImage, class TOutputImage, class TFunction, class TMaskImage >
+  MultiOutputTimeCurveFunctorImageFilter< TInputImage, TOutputImage, TFunction, TMaskImage >
+    ::MultiOutputTimeCurveFunctorImageFilter() : m_NumberOfVoxelsPerBlock(64), m_NumberOfProcessedVoxels(0), m_VoxelsPerSecond(0.0)
+  {
+    this->SetNumberOfRequiredInputs(1);
+
+    this->ActualizeOutputs();
+  }
+
+  template< class TInputImage, class TOutputImage, class TFunction, class TMaskImage >
+  void
+    MultiOutputTimeCurveFunctorImageFilter< TInputImage, TOutputImage, TFunction, TMaskImage >
+    ::ActualizeOutputs()
+  {
+    this->SetNumberOfRequiredOutputs(m_Functor.GetNumberOfOutputs());
+
+    for (typename Superclass::DataObjectPointerArraySizeType i = this->GetNumberOfIndexedOutputs(); i< m_Functor.GetNumberOfOutputs(); ++i)
+    {
+      this->SetNthOutput( i, this->MakeOutput(i) );
+    }
+
+    while(this->GetNumberOfIndexedOutputs() > m_Functor.GetNumberOfOutputs())
+    {
+      this->RemoveOutput(this->GetNumberOfIndexedOutputs()-1);
+    }
+  };
+
+  template< class TInputImage, class TOutputImage, class TFunction, class TMaskImage >
+  void
+    MultiOutputTimeCurveFunctorImageFilter< TInputImage, TOutputImage, TFunction, TMaskImage >
+    ::GenerateOutputInformation()
+  {
+    const InputImageType* input = this->GetInput();
+
+    if (nullptr == input)
+    {
+      return;
+    }
+
+    const auto inputRegion = input->GetLargestPossibleRegion();
+    const auto inputSpacing = input->GetSpacing();
+    const auto inputOrigin = input->GetOrigin();
+    const auto inputDirection = input->GetDirection();
+
+    OutputImageRegionType outputRegion;
+    typename OutputImageType::SpacingType outputSpacing;
+    typename OutputImageType::PointType outputOrigin;
+    typename OutputImageType::DirectionType outputDirection;
+
+    for (unsigned int i = 0; i < OutputImageDimension; ++i)
+    {
+      outputRegion.SetIndex(i, inputRegion.GetIndex(i));
+      outputRegion.SetSize(i, inputRegion.GetSize(i));
+      outputSpacing[i] = inputSpacing[i];
+      outputOrigin[i] = inputOrigin[i];
+
+      for (unsigned int j = 0; j < OutputImageDimension; ++j)
+      {
+        outputDirection[i][j] = inputDirection[i][j];
+      }
+    }
+
+    for (unsigned int i = 0; i < this->GetNumberOfIndexedOutputs(); ++i)
+    {
+      auto* output = dynamic_cast<OutputImageType*>(this->ProcessObject::GetOutput(i));
+
+      if (nullptr != output)
+      {
+        output->SetLargestPossibleRegion(outputRegion);
+        output->SetSpacing(outputSpacing);
+        output->SetOrigin(outputOrigin);
+        output->SetDirection(outputDirection);
+      }
+    }
+  }
+
+  template< class TInputImage, class TOutputImage, class TFunction, class TMaskImage >
+  void
+    MultiOutputTimeCurveFunctorImageFilter< TInputImage, TOutputImage, TFunction, TMaskImage >
+    ::GenerateInputRequestedRegion()
+  {
+    Superclass::GenerateInputRequestedRegion();
+
+    auto* input = const_cast<InputImageType*>(this->GetInput());
+
+    if (nullptr != input)
+    {
+      input->SetRequestedRegionToLargestPossibleRegion();
+    }
+  }
+
+  template< class TInputImage, class TOutputImage, class TFunction, class TMaskImage >
+  void
+    MultiOutputTimeCurveFunctorImageFilter< TInputImage, TOutputImage, TFunction, TMaskImage >
+    ::EnlargeOutputRequestedRegion(DataObject* output)
+  {
+    Superclass::EnlargeOutputRequestedRegion(output);
+    output->SetRequestedRegionToLargestPossibleRegion();
+  }
+
+  template< class TInputImage, class TOutputImage, class TFunction, class TMaskImage >
+  void
+    MultiOutputTimeCurveFunctorImageFilter< TInputImage, TOutputImage, TFunction, TMaskImage >
+    ::GenerateData()
+  {
+    this->AllocateOutputs();
+
+    m_NumberOfProcessedVoxels = 0;
+    m_VoxelsPerSecond = 0.0;
+
+    const InputImageType* input = this->GetInput();
+    const auto inputRegion = input->GetBufferedRegion();
+    const InputImagePixelType* inputBuffer = input->GetBufferPointer();
+
+    const unsigned int numberOfOutputImages = static_cast<unsigned int>(this->GetNumberOfIndexedOutputs());
+
+    if (0 == numberOfOutputImages)
+    {
+      return;
+    }
+
+    std::vector<OutputImageType*> outputs;
+    std::vector<OutputImagePixelType*> outputBuffers;
+
+    for (unsigned int i = 0; i < numberOfOutputImages; ++i)
+    {
+      outputs.push_back(this->GetOutput(i));
+      outputBuffers.push_back(outputs.back()->GetBufferPointer());
+    }
+
+    const OutputImageRegionType outputRegion = outputs.front()->GetBufferedRegion();
+
+    if (nullptr != m_Mask && !m_Mask->GetLargestPossibleRegion().IsInside(outputRegion))
+    {
+      itkExceptionMacro("Mask of filter is set but does not cover the output region. Mask region: " << m_Mask->GetLargestPossibleRegion() << "Output region: " << outputRegion);
+    }
+
+    const SizeValueType numberOfVoxels = outputRegion.GetNumberOfPixels();
+    const SizeValueType numberOfFrames = inputRegion.GetSize(InputImageDimension - 1);
+    const SizeValueType numberOfBlocks = (numberOfVoxels + m_NumberOfVoxelsPerBlock - 1) / m_NumberOfVoxelsPerBlock;
+
+    std::atomic<SizeValueType> nextBlock(0);
+    std::atomic<SizeValueType> processedVoxels(0);
+
+    auto worker = [&](SizeValueType)
+    {
+      TotalProgressReporter progress(this, numberOfVoxels);
+
+      // Time curves of the current block; frames are interleaved per voxel
+      std::vector<typename NaryInputArrayType::value_type> blockCurves(m_NumberOfVoxelsPerBlock * numberOfFrames);
+      NaryInputArrayType curve(numberOfFrames);
+      NaryOutputArrayType result(numberOfOutputImages);
+
+      for (SizeValueType block = nextBlock++; block < numberOfBlocks; block = nextBlock++)
+      {
+        const SizeValueType blockBegin = block * m_NumberOfVoxelsPerBlock;
+        const SizeValueType blockEnd = std::min(numberOfVoxels, blockBegin + m_NumberOfVoxelsPerBlock);
+        const SizeValueType blockSize = blockEnd - blockBegin;
+
+        // Each frame of the block is a contiguous range in the input buffer.
+        for (SizeValueType frame = 0; frame < numberOfFrames; ++frame)
+        {
+          const InputImagePixelType* frameBuffer = inputBuffer + frame * numberOfVoxels + blockBegin;
+
+          for (SizeValueType voxel = 0; voxel < blockSize; ++voxel)
+          {
+            blockCurves[voxel * numberOfFrames + frame] = frameBuffer[voxel];
+          }
+        }
+
+        SizeValueType blockProcessedVoxels = 0;
+
+        for (SizeValueType voxel = 0; voxel < blockSize; ++voxel)
+        {
+          const SizeValueType offset = blockBegin + voxel;
+          const auto index = outputs.front()->ComputeIndex(static_cast<OffsetValueType>(offset));
+
+          bool isValid = true;
+          if (nullptr != m_Mask)
+          {
+            isValid = m_Mask->GetPixel(index) > 0;
+          }
+
+          if (isValid)
+          {
+            const auto curveBegin = blockCurves.begin() + voxel * numberOfFrames;
+            std::copy(curveBegin, curveBegin + numberOfFrames, curve.begin());
+
+            result = m_Functor(curve, index);
+
+            if (numberOfOutputImages != result.size())
+            {
+              itkExceptionMacro("Error. Number of output images do not equal number of outputs required by functor. Number of outputs: " << numberOfOutputImages << "; needed output number:" << this->m_Functor.GetNumberOfOutputs());
+            }
+
+            for (unsigned int i = 0; i < numberOfOutputImages; ++i)
+            {
+              outputBuffers[i][offset] = result[i];
+            }
+
+            ++blockProcessedVoxels;
+          }
+          else
+          {
+            for (unsigned int i = 0; i < numberOfOutputImages; ++i)
+            {
+              outputBuffers[i][offset] = NumericTraits<OutputImagePixelType>::ZeroValue();
+            }
+          }
+        }
+
+        processedVoxels += blockProcessedVoxels;
+        progress.Completed(blockSize);
+      }
+    };
+
+    const auto numberOfWorkers = std::max<SizeValueType>(1, std::min<SizeValueType>(this->GetNumberOfWorkUnits(), numberOfBlocks));
+
+    const auto start = std::chrono::steady_clock::now();
+    this->GetMultiThreader()->ParallelizeArray(0, numberOfWorkers, worker, nullptr);
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+    m_NumberOfProcessedVoxels = processedVoxels;
+
+    if (elapsed.count() > 0.0)
+    {
+      m_VoxelsPerSecond = static_cast<double>(m_NumberOfProcessedVoxels) / elapsed.count();
+    }
+  }
+} // end namespace itk
+
+#endif
@@ -28,6 +28,8 @@ namespace mitk
 
   /** Class for generators for pixel based parameter fits of a given model based on a given 4D mitk image.
    * The class uses a model fit functor (based on ModelFitFunctorBase) given by the use.
+   * The voxels are fitted in parallel; their time curves are read directly from the dynamic image
+   * (see itk::MultiOutputTimeCurveFunctorImageFilter).
    * @remark This generator fits every pixel on its own. If you want to fit the mean value of the given mask use
    * ROIBasedParameterFitImageGenerator.
    * The generator creates 4 types of images:
@@ -73,6 +75,9 @@ public:
 
     double GetProgress() const override;
 
+    /** Returns the throughput (fitted voxels per second) of the last fit.*/
+    itkGetConstMacro(VoxelsPerSecond, double);
+
     ParameterNamesType GetParameterNames() const override;
 
     ParameterNamesType GetDerivedParameterNames() const override;
@@ -82,7 +87,7 @@ public:
     ParameterNamesType GetEvaluationParameterNames() const override;
 
 protected:
-  PixelBasedParameterFitImageGenerator() : m_Progress(0), m_TimeGridByParameterizer(false)
+  PixelBasedParameterFitImageGenerator() : m_Progress(0), m_VoxelsPerSecond(0), m_TimeGridByParameterizer(false)
   {
     m_InternalMask = nullptr;
     m_Mask = nullptr;
@@ -120,6 +125,7 @@ private:
     ParameterImageMapType m_TempCriterionResultMap;
 
     double m_Progress;
+    double m_VoxelsPerSecond;
     /**Indicates if the time grid defined in the parameterizer should be used (True)
     or if the filter should extract the time grid from the input image (False).*/
     bool m_TimeGridByParameterizer;
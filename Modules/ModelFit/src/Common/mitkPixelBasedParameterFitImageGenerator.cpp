@@ -11,10 +11,9 @@ found in the LICENSE file.
 ============================================================================*/
 
 #include "itkCommand.h"
-#include "itkMultiOutputNaryFunctorImageFilter.h"
+#include "itkMultiOutputTimeCurveFunctorImageFilter.h"
 
 #include "mitkPixelBasedParameterFitImageGenerator.h"
-#include "mitkImageTimeSelector.h"
 #include "mitkImageAccessByItk.h"
 #include "mitkImageCast.h"
 #include "mitkModelFitFunctorPolicy.h"
@@ -79,12 +78,13 @@ mitk::PixelBasedParameterFitImageGenerator::ParameterImageMapType StoreResultIma
 
 template <typename TPixel, unsigned int VDim>
 void
-  mitk::PixelBasedParameterFitImageGenerator::DoParameterFit(itk::Image<TPixel, VDim>* /*image*/)
+  mitk::PixelBasedParameterFitImageGenerator::DoParameterFit(itk::Image<TPixel, VDim>* image)
 {
-  using InputFrameImageType = itk::Image<TPixel, VDim-1>;
+  using InputImageType = itk::Image<TPixel, VDim>;
   using ParameterImageType = itk::Image<ScalarType, VDim-1>;
 
-  using FitFilterType = itk::MultiOutputNaryFunctorImageFilter<InputFrameImageType, ParameterImageType, ModelFitFunctorPolicy, InternalMaskType>;
+  //the fit filter reads the time curves directly from the dynamic image, so no frame images have to be generated.
+  using FitFilterType = itk::MultiOutputTimeCurveFunctorImageFilter<InputImageType, ParameterImageType, ModelFitFunctorPolicy, InternalMaskType>;
 
   typename FitFilterType::Pointer fitFilter = FitFilterType::New();
 
@@ -92,21 +92,7 @@ void
   spProgressCommand->SetCallbackFunction(this, &Self::onFitProgressEvent);
   fitFilter->AddObserver(::itk::ProgressEvent(), spProgressCommand);
 
-  //add the time frames to the fit filter
-  mitk::ImageTimeSelector::Pointer imageTimeSelector = mitk::ImageTimeSelector::New();
-  imageTimeSelector->SetInput(this->m_DynamicImage);
-  std::vector<Image::Pointer> frameCache;
-  for (unsigned int i = 0; i < this->m_DynamicImage->GetTimeSteps(); ++i)
-  {
-    typename InputFrameImageType::Pointer frameImage;
-    imageTimeSelector->SetTimeNr(i);
-    imageTimeSelector->UpdateLargestPossibleRegion();
-
-    Image::Pointer frameMITKImage = imageTimeSelector->GetOutput();
-    frameCache.push_back(frameMITKImage);
-    mitk::CastToItkImage(frameMITKImage, frameImage);
-    fitFilter->SetInput(i,frameImage);
-  }
+  fitFilter->SetInput(image);
 
   ModelBaseType::TimeGridType timeGrid = ExtractTimeGrid(m_DynamicImage);
   if (m_TimeGridByParameterizer)
@@ -135,6 +121,10 @@ void
   //generate the fits
   fitFilter->Update();
 
+  this->m_VoxelsPerSecond = fitFilter->GetVoxelsPerSecond();
+  MITK_DEBUG << "Parameter Fit Generator. Fitted " << fitFilter->GetNumberOfProcessedVoxels() << " voxels ("
+             << this->m_VoxelsPerSecond << " voxels/s).";
+
   //convert the outputs into mitk images and fill the parameter image map
   ModelBaseType::Pointer refModel = this->m_ModelParameterizer->GenerateParameterizedModel();
   ModelFitFunctorBase::ParameterNamesType paramNames = refModel->GetParameterNames();
@@ -214,6 +204,7 @@ void
 void mitk::PixelBasedParameterFitImageGenerator::DoFitAndGetResults(ParameterImageMapType& parameterImages, ParameterImageMapType& derivedParameterImages, ParameterImageMapType& criterionImages, ParameterImageMapType& evaluationParameterImages)
 {
   this->m_Progress = 0;
+  this->m_VoxelsPerSecond = 0;
 
   if(this->m_Mask.IsNotNull())
   {
@@ -1,5 +1,6 @@
 SET(MODULE_TESTS
   itkMultiOutputNaryFunctorImageFilterTest.cpp
+  itkMultiOutputTimeCurveFunctorImageFilterTest.cpp
   itkMaskedStatisticsImageFilterTest.cpp
   itkMaskedNaryStatisticsImageFilterTest.cpp
   mitkLevenbergMarquardtModelFitFunctorTest.cpp
@@ -0,0 +1,196 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "itkImage.h"
+#include "itkImageRegionConstIteratorWithIndex.h"
+
+#include "itkMultiOutputTimeCurveFunctorImageFilter.h"
+
+#include "mitkTestingMacros.h"
+#include "mitkVector.h"
+
+#include "mitkTestDynamicImageGenerator.h"
+
+class TestFunctor
+{
+public:
+  typedef std::vector<int> InputPixelArrayType;
+  typedef std::vector<int> OutputPixelArrayType;
+  typedef itk::Index<2> IndexType;
+
+  TestFunctor()
+  {
+    secondOutputSelection = 0;
+  };
+
+  ~TestFunctor() {};
+
+  int secondOutputSelection;
+
+  unsigned int GetNumberOfOutputs() const
+  {
+    return 4;
+  }
+
+  bool operator!=( const TestFunctor & other) const
+  {
+    return !(*this == other);
+  }
+
+  bool operator==( const TestFunctor & other ) const
+  {
+    return secondOutputSelection == other.secondOutputSelection;
+  }
+
+  inline OutputPixelArrayType operator()( const InputPixelArrayType & value, const IndexType& currentIndex ) const
+  {
+    OutputPixelArrayType result;
+
+    int sum = 0;
+    for (InputPixelArrayType::const_iterator pos = value.begin(); pos != value.end(); ++pos)
+    {
+      sum += *pos;
+    }
+
+    result.push_back(sum);
+    result.push_back(value[secondOutputSelection]);
+    result.push_back(currentIndex[0]);
+    result.push_back(currentIndex[1]);
+
+    return result;
+  }
+};
+
+typedef itk::Image<int, 3> DynamicTestImageType;
+
+/** Joins the passed 2D frames to one image with time as last dimension.*/
+DynamicTestImageType::Pointer JoinFrames(const std::vector<mitk::TestImageType::Pointer>& frames)
+{
+  DynamicTestImageType::RegionType region;
+  region.SetSize(0, frames.front()->GetLargestPossibleRegion().GetSize(0));
+  region.SetSize(1, frames.front()->GetLargestPossibleRegion().GetSize(1));
+  region.SetSize(2, frames.size());
+
+  DynamicTestImageType::Pointer image = DynamicTestImageType::New();
+  image->SetRegions(region);
+  image->Allocate();
+
+  DynamicTestImageType::IndexType index;
+  for (unsigned int t = 0; t < frames.size(); ++t)
+  {
+    itk::ImageRegionConstIteratorWithIndex<mitk::TestImageType> it(frames[t], frames[t]->GetLargestPossibleRegion());
+    for (; !it.IsAtEnd(); ++it)
+    {
+      index[0] = it.GetIndex()[0];
+      index[1] = it.GetIndex()[1];
+      index[2] = t;
+      image->SetPixel(index, it.Get());
+    }
+  }
+
+  return image;
+}
+
+int itkMultiOutputTimeCurveFunctorImageFilterTest(int  /*argc*/, char*[] /*argv[]*/)
+{
+  // always start with this!
+  MITK_TEST_BEGIN("itkMultiOutputTimeCurveFunctorImageFilter")
+
+  //Prepare test artifacts and helper
+  DynamicTestImageType::Pointer dynamicImage = JoinFrames({ mitk::GenerateTestImage(), mitk::GenerateTestImage(10), mitk::GenerateTestImage(100) });
+
+  mitk::TestImageType::IndexType testIndex1;
+  testIndex1[0] =   0;
+  testIndex1[1] =   0;
+
+  mitk::TestImageType::IndexType testIndex2;
+  testIndex2[0] =   2;
+  testIndex2[1] =   0;
+
+  mitk::TestImageType::IndexType testIndex3;
+  testIndex3[0] =   0;
+  testIndex3[1] =   1;
+
+  mitk::TestImageType::IndexType testIndex4;
+  testIndex4[0] =   1;
+  testIndex4[1] =   1;
+
+  mitk::TestImageType::IndexType testIndex5;
+  testIndex5[0] =   2;
+  testIndex5[1] =   2;
+
+  //Test default usage of filter (use small blocks to have several of them distributed over the threads)
+  typedef itk::MultiOutputTimeCurveFunctorImageFilter<DynamicTestImageType,mitk::TestImageType,TestFunctor> FilterType;
+  FilterType::Pointer testFilter = FilterType::New();
+
+  testFilter->SetInput(dynamicImage);
+  testFilter->SetNumberOfVoxelsPerBlock(2);
+
+  testFilter->Update();
+
+  mitk::TestImageType::Pointer out1 = testFilter->GetOutput(0);
+  mitk::TestImageType::Pointer out2 = testFilter->GetOutput(1);
+  mitk::TestImageType::Pointer out3 = testFilter->GetOutput(2);
+  mitk::TestImageType::Pointer out4 = testFilter->GetOutput(3);
+
+  CPPUNIT_ASSERT_MESSAGE("Check output size", out1->GetLargestPossibleRegion().GetSize() == mitk::GenerateTestImage()->GetLargestPossibleRegion().GetSize());
+  CPPUNIT_ASSERT_MESSAGE("Check number of processed voxels", 9 == testFilter->GetNumberOfProcessedVoxels());
+
+  CPPUNIT_ASSERT_MESSAGE("Check pixel of output #1 index #1 (functor #1)",111 == out1->GetPixel(testIndex1));
+  CPPUNIT_ASSERT_MESSAGE("Check pixel of output #1 index #2 (functor #1)",333 == out1->GetPixel(testIndex2));
+  CPPUNIT_ASSERT_MESSAGE("Check pixel of output #1 index #3 (functor #1)",444 == out1->GetPixel(testIndex3));
+  CPPUNIT_ASSERT_MESSAGE("Check pixel of output #1 index #4 (functor #1)",555 == out1->GetPixel(testIndex4));
+  CPPUNIT_ASSERT_MESSAGE("Check pixel of output #1 index #5 (functor #1)",999 == out1->GetPixel(testIndex5));
+
+  CPPUNIT_ASSERT_MESSAGE("Check pixel of output #2 index #1 (functor #1)",1 == out2->GetPixel(testIndex1));
+  CPPUNIT_ASSERT_MESSAGE("Check pixel of output #2 index #2 (functor #1)",3 == out2->GetPixel(testIndex2));
+  CPPUNIT_ASSERT_MESSAGE("Check pixel of output #2 index #5 (functor #1)",9 == out2->GetPixel(testIndex5));
+
+  CPPUNIT_ASSERT_MESSAGE("Check pixel of output #3 index #2 (functor #1)",2 == out3->GetPixel(testIndex2));
+  CPPUNIT_ASSERT_MESSAGE("Check pixel of output #3 index #4 (functor #1)",1 == out3->GetPixel(testIndex4));
+  CPPUNIT_ASSERT_MESSAGE("Check pixel of output #4 index #3 (functor #1)",1 == out4->GetPixel(testIndex3));
+  CPPUNIT_ASSERT_MESSAGE("Check pixel of output #4 index #5 (functor #1)",2 == out4->GetPixel(testIndex5));
+
+  //Test with functor set by user
+  TestFunctor funct2;
+  funct2.secondOutputSelection = 2;
+
+  testFilter->SetFunctor(funct2);
+
+  testFilter->Update();
+
+  out2 = testFilter->GetOutput(1);
+
+  CPPUNIT_ASSERT_MESSAGE("Check pixel of output #2 index #1 (functor #2)",100 == out2->GetPixel(testIndex1));
+  CPPUNIT_ASSERT_MESSAGE("Check pixel of output #2 index #2 (functor #2)",300 == out2->GetPixel(testIndex2));
+  CPPUNIT_ASSERT_MESSAGE("Check pixel of output #2 index #5 (functor #2)",900 == out2->GetPixel(testIndex5));
+
+  //Test with mask set
+  mitk::TestMaskType::Pointer mask = mitk::GenerateTestMask();
+  testFilter->SetMask(mask);
+
+  testFilter->Update();
+
+  out1 = testFilter->GetOutput(0);
+  out2 = testFilter->GetOutput(1);
+
+  CPPUNIT_ASSERT_MESSAGE("Check number of processed voxels with mask", 3 == testFilter->GetNumberOfProcessedVoxels());
+
+  CPPUNIT_ASSERT_MESSAGE("Check pixel of masked output #1 index #1 (functor #2)",0 == out1->GetPixel(testIndex1));
+  CPPUNIT_ASSERT_MESSAGE("Check pixel of masked output #1 index #2 (functor #2)",333 == out1->GetPixel(testIndex2));
+  CPPUNIT_ASSERT_MESSAGE("Check pixel of masked output #1 index #3 (functor #2)",444 == out1->GetPixel(testIndex3));
+  CPPUNIT_ASSERT_MESSAGE("Check pixel of masked output #1 index #4 (functor #2)",0 == out1->GetPixel(testIndex4));
+  CPPUNIT_ASSERT_MESSAGE("Check pixel of masked output #2 index #2 (functor #2)",300 == out2->GetPixel(testIndex2));
+  CPPUNIT_ASSERT_MESSAGE("Check pixel of masked output #2 index #5 (functor #2)",0 == out2->GetPixel(testIndex5));
+
+  MITK_TEST_END()
+}
@@ -0,0 +1,304 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include <mitkImagePixelWriteAccessor.h>
+#include <mitkMultiLabelSurfaceNetsFilter.h>
+#include <mitkTestFixture.h>
+#include <mitkTestingMacros.h>
+
+#include <vtkCellArray.h>
+#include <vtkIdList.h>
+#include <vtkPolyData.h>
+
+#include <algorithm>
+#include <map>
+#include <utility>
+
+class mitkMultiLabelSurfaceNetsFilterTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkMultiLabelSurfaceNetsFilterTestSuite);
+  MITK_TEST(Update_ExtractsAllLabels);
+  MITK_TEST(Update_ComputesBoundingBoxes);
+  MITK_TEST(Update_SurfacesAreClosedAndOriented);
+  MITK_TEST(Update_SurfacesAreInWorldCoordinates);
+  MITK_TEST(Update_SelectedLabels);
+  MITK_TEST(Update_SingleThreaded_IsIdentical);
+  MITK_TEST(Update_EmptyImage_HasEmptyOutput);
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+  typedef mitk::MultiLabelSurfaceNetsFilter::LabelType LabelType;
+
+  mitk::Image::Pointer m_Image;
+
+  static mitk::Image::Pointer CreateImage(unsigned int x, unsigned int y, unsigned int z)
+  {
+    unsigned int dimensions[] = {x, y, z};
+
+    auto image = mitk::Image::New();
+    image->Initialize(mitk::MakeScalarPixelType<LabelType>(), 3, dimensions);
+
+    mitk::ImagePixelWriteAccessor<LabelType, 3> accessor(image);
+    std::fill(accessor.GetData(), accessor.GetData() + x * y * z, 0);
+
+    return image;
+  }
+
+  static void Paint(mitk::Image *image, LabelType label, const itk::Index<3> &min, const itk::Index<3> &max)
+  {
+    mitk::ImagePixelWriteAccessor<LabelType, 3> accessor(image);
+
+    itk::Index<3> index;
+    for (index[2] = min[2]; index[2] <= max[2]; ++index[2])
+      for (index[1] = min[1]; index[1] <= max[1]; ++index[1])
+        for (index[0] = min[0]; index[0] <= max[0]; ++index[0])
+          accessor.SetPixelByIndex(index, label);
+  }
+
+  static itk::Index<3> MakeIndex(itk::IndexValueType x, itk::IndexValueType y, itk::IndexValueType z)
+  {
+    itk::Index<3> index;
+    index[0] = x;
+    index[1] = y;
+    index[2] = z;
+    return index;
+  }
+
+  static mitk::MultiLabelSurfaceNetsFilter::Pointer Extract(const mitk::Image *image)
+  {
+    auto filter = mitk::MultiLabelSurfaceNetsFilter::New();
+    filter->SetInput(image);
+    filter->Update();
+    return filter;
+  }
+
+  /** Signed volume enclosed by the triangles (positive for outward facing triangles).*/
+  static double GetVolume(vtkPolyData *polyData)
+  {
+    double volume = 0.0;
+    auto ids = vtkSmartPointer<vtkIdList>::New();
+    auto polys = polyData->GetPolys();
+
+    for (polys->InitTraversal(); polys->GetNextCell(ids);)
+    {
+      double a[3], b[3], c[3];
+      polyData->GetPoint(ids->GetId(0), a);
+      polyData->GetPoint(ids->GetId(1), b);
+      polyData->GetPoint(ids->GetId(2), c);
+
+      volume += (a[0] * (b[1] * c[2] - b[2] * c[1]) - a[1] * (b[0] * c[2] - b[2] * c[0]) +
+                 a[2] * (b[0] * c[1] - b[1] * c[0])) / 6.0;
+    }
+
+    return volume;
+  }
+
+  /** Every directed edge of a closed and consistently oriented surface has a reverse edge.*/
+  static bool IsClosedAndOriented(vtkPolyData *polyData)
+  {
+    std::map<std::pair<vtkIdType, vtkIdType>, int> edges;
+    auto ids = vtkSmartPointer<vtkIdList>::New();
+    auto polys = polyData->GetPolys();
+
+    for (polys->InitTraversal(); polys->GetNextCell(ids);)
+    {
+      for (vtkIdType i = 0; i < ids->GetNumberOfIds(); ++i)
+        ++edges[std::make_pair(ids->GetId(i), ids->GetId((i + 1) % ids->GetNumberOfIds()))];
+    }
+
+    for (const auto &edge : edges)
+    {
+      auto reverse = edges.find(std::make_pair(edge.first.second, edge.first.first));
+
+      if (reverse == edges.end() || reverse->second != edge.second)
+        return false;
+    }
+
+    return !edges.empty();
+  }
+
+public:
+  void setUp() override
+  {
+    m_Image = CreateImage(40, 32, 20);
+
+    mitk::Vector3D spacing;
+    spacing[0] = 0.5;
+    spacing[1] = 1.0;
+    spacing[2] = 2.0;
+    m_Image->SetSpacing(spacing);
+
+    mitk::Point3D origin;
+    origin[0] = 10.0;
+    origin[1] = 20.0;
+    origin[2] = 30.0;
+    m_Image->SetOrigin(origin);
+
+    // two touching boxes and a box inside of the first one
+    Paint(m_Image, 1, MakeIndex(5, 5, 5), MakeIndex(24, 24, 14));
+    Paint(m_Image, 2, MakeIndex(25, 5, 5), MakeIndex(34, 24, 14));
+    Paint(m_Image, 5, MakeIndex(10, 10, 8), MakeIndex(13, 13, 10));
+  }
+
+  void tearDown() override
+  {
+    m_Image = nullptr;
+  }
+
+  void Update_ExtractsAllLabels()
+  {
+    auto filter = Extract(m_Image);
+
+    const mitk::MultiLabelSurfaceNetsFilter::LabelVectorType expectedLabels = {1, 2, 5};
+    CPPUNIT_ASSERT(expectedLabels == filter->GetExtractedLabels());
+    CPPUNIT_ASSERT_EQUAL(std::size_t(3), static_cast<std::size_t>(filter->GetNumberOfIndexedOutputs()));
+
+    for (unsigned int i = 0; i < 3; ++i)
+    {
+      CPPUNIT_ASSERT_EQUAL(expectedLabels[i], filter->GetLabelForNthOutput(i));
+      CPPUNIT_ASSERT(filter->GetOutputForLabel(expectedLabels[i]) == filter->GetOutput(i));
+      CPPUNIT_ASSERT(filter->GetOutput(i)->GetVtkPolyData()->GetNumberOfPolys() > 0);
+    }
+
+    CPPUNIT_ASSERT(nullptr == filter->GetOutputForLabel(3));
+    CPPUNIT_ASSERT_THROW(filter->GetLabelForNthOutput(3), mitk::Exception);
+  }
+
+  void Update_ComputesBoundingBoxes()
+  {
+    auto filter = Extract(m_Image);
+
+    CPPUNIT_ASSERT_EQUAL(std::size_t(3), filter->GetBoundingBoxes().size());
+
+    const auto box1 = filter->GetBoundingBoxForLabel(1);
+    CPPUNIT_ASSERT(MakeIndex(5, 5, 5) == box1.GetIndex());
+    CPPUNIT_ASSERT(MakeIndex(24, 24, 14) == box1.GetUpperIndex());
+
+    const auto box2 = filter->GetBoundingBoxForLabel(2);
+    CPPUNIT_ASSERT(MakeIndex(25, 5, 5) == box2.GetIndex());
+    CPPUNIT_ASSERT(MakeIndex(34, 24, 14) == box2.GetUpperIndex());
+
+    const auto box5 = filter->GetBoundingBoxForLabel(5);
+    CPPUNIT_ASSERT(MakeIndex(10, 10, 8) == box5.GetIndex());
+    CPPUNIT_ASSERT(MakeIndex(13, 13, 10) == box5.GetUpperIndex());
+
+    CPPUNIT_ASSERT_THROW(filter->GetBoundingBoxForLabel(3), mitk::Exception);
+  }
+
+  void Update_SurfacesAreClosedAndOriented()
+  {
+    auto filter = Extract(m_Image);
+
+    for (LabelType label : {1, 2, 5})
+    {
+      auto polyData = filter->GetOutputForLabel(label)->GetVtkPolyData();
+      CPPUNIT_ASSERT_MESSAGE("Surface is closed and consistently oriented.", IsClosedAndOriented(polyData));
+    }
+
+    // The voxel volume is 0.5 * 1 * 2 = 1. Surface nets only bevel the edges and corners of the boxes.
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(2000.0, GetVolume(filter->GetOutputForLabel(2)->GetVtkPolyData()), 60.0);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(4000.0 - 48.0, GetVolume(filter->GetOutputForLabel(1)->GetVtkPolyData()), 120.0);
+
+    const auto innerVolume = GetVolume(filter->GetOutputForLabel(5)->GetVtkPolyData());
+    CPPUNIT_ASSERT(innerVolume > 30.0 && innerVolume < 48.0);
+  }
+
+  void Update_SurfacesAreInWorldCoordinates()
+  {
+    auto filter = Extract(m_Image);
+    auto geometry = m_Image->GetGeometry();
+
+    for (LabelType label : {1, 2, 5})
+    {
+      const auto box = filter->GetBoundingBoxForLabel(label);
+
+      // all vertices lie within half a voxel around the voxels of the label
+      mitk::Point3D minIndex, maxIndex, minWorld, maxWorld;
+      for (int d = 0; d < 3; ++d)
+      {
+        minIndex[d] = box.GetIndex()[d] - 0.5;
+        maxIndex[d] = box.GetUpperIndex()[d] + 0.5;
+      }
+
+      geometry->IndexToWorld(minIndex, minWorld);
+      geometry->IndexToWorld(maxIndex, maxWorld);
+
+      double bounds[6];
+      filter->GetOutputForLabel(label)->GetVtkPolyData()->GetBounds(bounds);
+
+      for (int d = 0; d < 3; ++d)
+      {
+        CPPUNIT_ASSERT_DOUBLES_EQUAL(minWorld[d], bounds[2 * d], 1e-4);
+        CPPUNIT_ASSERT_DOUBLES_EQUAL(maxWorld[d], bounds[2 * d + 1], 1e-4);
+      }
+    }
+  }
+
+  void Update_SelectedLabels()
+  {
+    auto allLabelsFilter = Extract(m_Image);
+
+    auto filter = mitk::MultiLabelSurfaceNetsFilter::New();
+    filter->SetInput(m_Image);
+    filter->SetLabels({2, 3});
+    filter->Update();
+
+    CPPUNIT_ASSERT_EQUAL(std::size_t(1), filter->GetExtractedLabels().size());
+    CPPUNIT_ASSERT_EQUAL(LabelType(2), filter->GetLabelForNthOutput(0));
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Bounding boxes are computed for all labels.", std::size_t(3), filter->GetBoundingBoxes().size());
+
+    // label 1 still separates label 2 from the background, so the surface of label 2 is the same
+    auto expected = allLabelsFilter->GetOutputForLabel(2)->GetVtkPolyData();
+    auto actual = filter->GetOutput(0)->GetVtkPolyData();
+
+    CPPUNIT_ASSERT_EQUAL(expected->GetNumberOfPoints(), actual->GetNumberOfPoints());
+    CPPUNIT_ASSERT_EQUAL(expected->GetNumberOfPolys(), actual->GetNumberOfPolys());
+  }
+
+  void Update_SingleThreaded_IsIdentical()
+  {
+    auto parallelFilter = Extract(m_Image);
+
+    auto filter = mitk::MultiLabelSurfaceNetsFilter::New();
+    filter->SetInput(m_Image);
+    filter->SetNumberOfWorkUnits(1);
+    filter->Update();
+
+    for (LabelType label : {1, 2, 5})
+    {
+      auto expected = parallelFilter->GetOutputForLabel(label)->GetVtkPolyData();
+      auto actual = filter->GetOutputForLabel(label)->GetVtkPolyData();
+
+      CPPUNIT_ASSERT_EQUAL(expected->GetNumberOfPoints(), actual->GetNumberOfPoints());
+
+      for (vtkIdType i = 0; i < expected->GetNumberOfPoints(); ++i)
+      {
+        double a[3], b[3];
+        expected->GetPoint(i, a);
+        actual->GetPoint(i, b);
+        CPPUNIT_ASSERT(a[0] == b[0] && a[1] == b[1] && a[2] == b[2]);
+      }
+    }
+  }
+
+  void Update_EmptyImage_HasEmptyOutput()
+  {
+    auto filter = Extract(CreateImage(8, 8, 8));
+
+    CPPUNIT_ASSERT(filter->GetExtractedLabels().empty());
+    CPPUNIT_ASSERT(filter->GetBoundingBoxes().empty());
+    CPPUNIT_ASSERT(filter->GetOutput() != nullptr);
+    CPPUNIT_ASSERT_EQUAL(vtkIdType(0), filter->GetOutput()->GetVtkPolyData()->GetNumberOfPoints());
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkMultiLabelSurfaceNetsFilter)
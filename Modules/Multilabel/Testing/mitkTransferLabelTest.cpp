@@ -11,6 +11,7 @@ found in the LICENSE file.
 ============================================================================*/
 
 #include <mitkIOUtil.h>
+#include <mitkImageReadAccessor.h>
 #include <mitkLabelSetImage.h>
 #include <mitkTestFixture.h>
 #include <mitkTestingMacros.h>
@@ -29,6 +30,7 @@ class mitkTransferLabelTestSuite : public mitk::TestFixture
   MITK_TEST(TestTransfer_Replace_RegardLocks_AtTimeStep);
   MITK_TEST(TestTransfer_Replace_IgnoreLocks_AtTimeStep);
   MITK_TEST(TestTransfer_multipleLabels_AtTimeStep);
+  MITK_TEST(TestTransfer_swapLabels_sameInstance);
   CPPUNIT_TEST_SUITE_END();
 
 private:
@@ -224,6 +226,29 @@ public:
   }
 
 
+  void TestTransfer_swapLabels_sameInstance()
+  {
+    auto image = m_SourceImage->Clone();
+
+    std::vector<mitk::Label::PixelType> expected;
+    {
+      mitk::ImageReadAccessor accessor(m_SourceImage);
+      auto data = static_cast<const mitk::Label::PixelType*>(accessor.GetData());
+      const auto numberOfPixels = m_SourceImage->GetDimension(0) * m_SourceImage->GetDimension(1) * m_SourceImage->GetDimension(2);
+
+      for (std::size_t i = 0; i < numberOfPixels; ++i)
+        expected.push_back(1 == data[i] ? 2 : (2 == data[i] ? 1 : data[i]));
+    }
+
+    mitk::TransferLabelContent(image, image, { {1,2}, {2,1} }, mitk::MultiLabelSegmentation::MergeStyle::Merge, mitk::MultiLabelSegmentation::OverwriteStyle::IgnoreLocks);
+
+    mitk::ImageReadAccessor accessor(image);
+    auto data = static_cast<const mitk::Label::PixelType*>(accessor.GetData());
+
+    for (std::size_t i = 0; i < expected.size(); ++i)
+      CPPUNIT_ASSERT_EQUAL_MESSAGE("Swapping labels (1->2, 2->1) within the same image failed", expected[i], data[i]);
+  }
+
 };
 
 MITK_TEST_SUITE_REGISTRATION(mitkTransferLabel)
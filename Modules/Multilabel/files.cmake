@@ -16,4 +16,5 @@ set(CPP_FILES
   mitkMultilabelObjectFactory.cpp
   mitkMultiLabelPredicateHelper.cpp
   mitkMultiLabelSegmentationVtkMapper3D.cpp
+  mitkMultiLabelSurfaceNetsFilter.cpp
 )
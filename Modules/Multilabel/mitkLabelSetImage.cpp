@@ -22,7 +22,10 @@ found in the LICENSE file.
 
 #include <itkLabelGeometryImageFilter.h>
 #include <itkCommand.h>
-#include <itkBinaryFunctorImageFilter.h>
+#include <itkImageRegionIterator.h>
+#include <itkMultiThreaderBase.h>
+
+#include <limits>
 
 
 namespace mitk
@@ -1470,113 +1473,185 @@ ConstLabelMapType ConvertLabelVectorToMap(const mitk::ConstLabelVector& labelV)
 }
 
 
-/** Functor class that implements the label transfer and is used in conjunction with the itk::BinaryFunctorImageFilter.
-* For details regarding the usage of the filter and the functor patterns, please see info of itk::BinaryFunctorImageFilter.
+/** Lookup tables that implement a complete label mapping (all mapping elements of a TransferLabelContentAtTimeStep
+* call) in a single pass over the image.
+* For a given source pixel value, the sequence of mapping elements applied to a destination pixel only depends on the
+* source value. Therefore the tables precompute the combined effect of the whole mapping per relevant source value. The
+* result only depends on whether the destination value is one of the values referenced by the mapping (destination labels
+* and destination background) and, for all other values, on the lock state of the destination value. Everything is stored in
+* flat tables indexed by label value, so no map lookups or per-label passes are needed while iterating the image.
 */
-template <class TDestinationPixel, class TSourcePixel, class TOutputpixel>
-class LabelTransferFunctor
+class LabelTransferLookupTables
 {
-
 public:
-  LabelTransferFunctor() {};
-
-  LabelTransferFunctor(const ConstLabelMapType& destinationLabels, mitk::Label::PixelType sourceBackground,
-    mitk::Label::PixelType destinationBackground, bool destinationBackgroundLocked,
-    mitk::Label::PixelType sourceLabel, mitk::Label::PixelType newDestinationLabel, mitk::MultiLabelSegmentation::MergeStyle mergeStyle,
-    mitk::MultiLabelSegmentation::OverwriteStyle overwriteStyle) :
-    m_DestinationLabels(destinationLabels), m_SourceBackground(sourceBackground),
-    m_DestinationBackground(destinationBackground), m_DestinationBackgroundLocked(destinationBackgroundLocked),
-    m_SourceLabel(sourceLabel), m_NewDestinationLabel(newDestinationLabel), m_MergeStyle(mergeStyle), m_OverwriteStyle(overwriteStyle)
+  LabelTransferLookupTables(const mitk::ConstLabelVector& destinationLabels, mitk::Label::PixelType sourceBackground,
+    mitk::Label::PixelType destinationBackground, bool destinationBackgroundLocked, const mitk::LabelValueMappingVector& labelMapping,
+    mitk::MultiLabelSegmentation::MergeStyle mergeStyle, mitk::MultiLabelSegmentation::OverwriteStyle overwriteStyle)
+    : m_RuleOfSourceValue(TableSize, NO_RULE),
+      m_ClassOfDestinationValue(TableSize, NO_CLASS),
+      m_Locked(TableSize, 0)
   {
-  };
+    const bool ignoreLocks = mitk::MultiLabelSegmentation::OverwriteStyle::IgnoreLocks == overwriteStyle;
+
+    if (!ignoreLocks)
+    {
+      for (const auto& label : destinationLabels)
+        m_Locked[label->GetValue()] = label->GetLocked() ? 1 : 0;
+
+      m_Locked[destinationBackground] = destinationBackgroundLocked ? 1 : 0;
+    }
+
+    // Destination values that are treated explicitly by the mapping.
+    this->AddDestinationClass(destinationBackground);
+    for (const auto& mappingElement : labelMapping)
+      this->AddDestinationClass(mappingElement.second);
+
+    // Source values for which at least one mapping element changes destination pixels.
+    const bool clearDestination = mitk::MultiLabelSegmentation::MergeStyle::Replace == mergeStyle && (ignoreLocks || !destinationBackgroundLocked);
+
+    std::vector<mitk::Label::PixelType> relevantSourceValues;
+    for (const auto& mappingElement : labelMapping)
+      relevantSourceValues.push_back(mappingElement.first);
+    if (clearDestination)
+      relevantSourceValues.push_back(sourceBackground);
+
+    for (const auto sourceValue : relevantSourceValues)
+    {
+      if (NO_RULE != m_RuleOfSourceValue[sourceValue])
+        continue;
+
+      // Sequence of mapping elements (in mapping order) as they would be applied to pixels with this source value
+      OperationVector operations;
+      for (const auto& [mappedSourceValue, newDestinationValue] : labelMapping)
+      {
+        if (sourceValue == mappedSourceValue)
+        {
+          operations.emplace_back(true, newDestinationValue);
+        }
+        else if (clearDestination && sourceValue == sourceBackground)
+        {
+          operations.emplace_back(false, newDestinationValue);
+        }
+      }
 
-  ~LabelTransferFunctor() {};
+      Rule rule;
 
-  bool operator!=(const LabelTransferFunctor& other)const
+      for (const auto classValue : m_ClassValues)
+      {
+        rule.ClassResult.push_back(this->Apply(operations, classValue, destinationBackground, ignoreLocks));
+      }
+
+      this->ApplyToUnlistedValue(operations, false, destinationBackground, ignoreLocks, rule.UnlockedKeeps, rule.UnlockedResult);
+      this->ApplyToUnlistedValue(operations, true, destinationBackground, ignoreLocks, rule.LockedKeeps, rule.LockedResult);
+
+      m_RuleOfSourceValue[sourceValue] = static_cast<int>(m_Rules.size());
+      m_Rules.push_back(rule);
+    }
+  }
+
+  inline mitk::Label::PixelType operator()(mitk::Label::PixelType destinationValue, mitk::Label::PixelType sourceValue) const
   {
-    return !(*this == other);
+    const auto ruleIndex = m_RuleOfSourceValue[sourceValue];
+
+    if (NO_RULE == ruleIndex)
+      return destinationValue;
+
+    const auto& rule = m_Rules[ruleIndex];
+    const auto classIndex = m_ClassOfDestinationValue[destinationValue];
+
+    if (NO_CLASS != classIndex)
+      return rule.ClassResult[classIndex];
+
+    if (0 != m_Locked[destinationValue])
+      return rule.LockedKeeps ? destinationValue : rule.LockedResult;
+
+    return rule.UnlockedKeeps ? destinationValue : rule.UnlockedResult;
   }
-  bool operator==(const LabelTransferFunctor& other) const
+
+  bool IsIdentity() const
   {
-    return this->m_SourceBackground == other.m_SourceBackground &&
-      this->m_DestinationBackground == other.m_DestinationBackground &&
-      this->m_DestinationBackgroundLocked == other.m_DestinationBackgroundLocked &&
-      this->m_SourceLabel == other.m_SourceLabel &&
-      this->m_NewDestinationLabel == other.m_NewDestinationLabel &&
-      this->m_MergeStyle == other.m_MergeStyle &&
-      this->m_OverwriteStyle == other.m_OverwriteStyle &&
-      this->m_DestinationLabels == other.m_DestinationLabels;
+    return m_Rules.empty();
   }
 
-  LabelTransferFunctor& operator=(const LabelTransferFunctor& other)
+private:
+  static constexpr std::size_t TableSize = std::numeric_limits<mitk::Label::PixelType>::max() + std::size_t(1);
+  static constexpr int NO_RULE = -1;
+  static constexpr int NO_CLASS = -1;
+
+  /** Mapping elements as applied to a pixel: (true: transfer, false: clear) and the destination label of the element.*/
+  using OperationVector = std::vector<std::pair<bool, mitk::Label::PixelType>>;
+
+  struct Rule
   {
-    this->m_DestinationLabels = other.m_DestinationLabels;
-    this->m_SourceBackground = other.m_SourceBackground;
-    this->m_DestinationBackground = other.m_DestinationBackground;
-    this->m_DestinationBackgroundLocked = other.m_DestinationBackgroundLocked;
-    this->m_SourceLabel = other.m_SourceLabel;
-    this->m_NewDestinationLabel = other.m_NewDestinationLabel;
-    this->m_MergeStyle = other.m_MergeStyle;
-    this->m_OverwriteStyle = other.m_OverwriteStyle;
+    std::vector<mitk::Label::PixelType> ClassResult;
+    bool UnlockedKeeps = true;
+    mitk::Label::PixelType UnlockedResult = 0;
+    bool LockedKeeps = true;
+    mitk::Label::PixelType LockedResult = 0;
+  };
 
-    return *this;
+  void AddDestinationClass(mitk::Label::PixelType value)
+  {
+    if (NO_CLASS == m_ClassOfDestinationValue[value])
+    {
+      m_ClassOfDestinationValue[value] = static_cast<int>(m_ClassValues.size());
+      m_ClassValues.push_back(value);
+    }
   }
 
-  inline TOutputpixel operator()(const TDestinationPixel& existingDestinationValue, const TSourcePixel& existingSourceValue)
+  /** Applies the operation sequence to a concrete destination value.*/
+  mitk::Label::PixelType Apply(const OperationVector& operations, mitk::Label::PixelType value,
+    mitk::Label::PixelType destinationBackground, bool ignoreLocks) const
   {
-    if (existingSourceValue == this->m_SourceLabel)
+    for (const auto& [transfer, newDestinationValue] : operations)
     {
-      if (mitk::MultiLabelSegmentation::OverwriteStyle::IgnoreLocks == this->m_OverwriteStyle)
+      if (transfer)
       {
-        return this->m_NewDestinationLabel;
+        if (ignoreLocks || 0 == m_Locked[value])
+          value = newDestinationValue;
       }
-      else
+      else if (value == newDestinationValue)
       {
-        if (existingDestinationValue == m_DestinationBackground)
-        {
-          if (!m_DestinationBackgroundLocked)
-          {
-            return this->m_NewDestinationLabel;
-          }
-        }
-        else
-        {
-          auto labelFinding = this->m_DestinationLabels.find(existingDestinationValue);
-          if (labelFinding==this->m_DestinationLabels.end() || !labelFinding->second->GetLocked())
-          {
-            return this->m_NewDestinationLabel;
-          }
-        }
+        value = destinationBackground;
       }
     }
-    else if (mitk::MultiLabelSegmentation::MergeStyle::Replace == this->m_MergeStyle
-      && existingSourceValue == this->m_SourceBackground
-      && existingDestinationValue == this->m_NewDestinationLabel
-      && (mitk::MultiLabelSegmentation::OverwriteStyle::IgnoreLocks == this->m_OverwriteStyle
-          || !this->m_DestinationBackgroundLocked))
+
+    return value;
+  }
+
+  /** Applies the operation sequence to a destination value that is not referenced by the mapping. As long as the value is
+  not changed, clear operations never affect it and transfer operations only depend on its lock state.*/
+  void ApplyToUnlistedValue(const OperationVector& operations, bool locked,
+    mitk::Label::PixelType destinationBackground, bool ignoreLocks, bool& keeps, mitk::Label::PixelType& result) const
+  {
+    keeps = true;
+
+    auto firstChange = operations.begin();
+    for (; firstChange != operations.end(); ++firstChange)
     {
-      return this->m_DestinationBackground;
+      if (firstChange->first && (ignoreLocks || !locked))
+        break;
     }
 
-    return existingDestinationValue;
+    if (operations.end() != firstChange)
+    {
+      keeps = false;
+      const OperationVector remainingOperations(std::next(firstChange), operations.end());
+      result = this->Apply(remainingOperations, firstChange->second, destinationBackground, ignoreLocks);
+    }
   }
 
-private:
-  ConstLabelMapType m_DestinationLabels;
-  mitk::Label::PixelType m_SourceBackground = 0;
-  mitk::Label::PixelType m_DestinationBackground = 0;
-  bool m_DestinationBackgroundLocked = false;
-  mitk::Label::PixelType m_SourceLabel = 1;
-  mitk::Label::PixelType m_NewDestinationLabel = 1;
-  mitk::MultiLabelSegmentation::MergeStyle m_MergeStyle = mitk::MultiLabelSegmentation::MergeStyle::Replace;
-  mitk::MultiLabelSegmentation::OverwriteStyle m_OverwriteStyle = mitk::MultiLabelSegmentation::OverwriteStyle::RegardLocks;
+  std::vector<int> m_RuleOfSourceValue;
+  std::vector<int> m_ClassOfDestinationValue;
+  std::vector<unsigned char> m_Locked;
+  std::vector<mitk::Label::PixelType> m_ClassValues;
+  std::vector<Rule> m_Rules;
 };
 
 /**Helper function used by TransferLabelContentAtTimeStep to allow the templating over different image dimensions in conjunction of AccessFixedPixelTypeByItk_n.*/
 template<unsigned int VImageDimension>
 void TransferLabelContentAtTimeStepHelper(const itk::Image<mitk::Label::PixelType, VImageDimension>* itkSourceImage, mitk::Image* destinationImage,
-  const mitk::ConstLabelVector& destinationLabels, mitk::Label::PixelType sourceBackground, mitk::Label::PixelType destinationBackground,
-  bool destinationBackgroundLocked, mitk::Label::PixelType sourceLabel, mitk::Label::PixelType newDestinationLabel, mitk::MultiLabelSegmentation::MergeStyle mergeStyle, mitk::MultiLabelSegmentation::OverwriteStyle overwriteStyle)
+  const LabelTransferLookupTables& lookupTables)
 {
   typedef itk::Image<mitk::Label::PixelType, VImageDimension> ContentImageType;
   typename ContentImageType::Pointer itkDestinationImage;
@@ -1591,21 +1666,18 @@ void TransferLabelContentAtTimeStepHelper(const itk::Image<mitk::Label::PixelTyp
     mitkThrow() << "Invalid call of TransferLabelContentAtTimeStep; sourceImage and destinationImage seem to have no overlapping image region.";
   }
 
-  typedef LabelTransferFunctor <mitk::Label::PixelType, mitk::Label::PixelType, mitk::Label::PixelType> LabelTransferFunctorType;
-  typedef itk::BinaryFunctorImageFilter<ContentImageType, ContentImageType, ContentImageType, LabelTransferFunctorType> FilterType;
-
-  LabelTransferFunctorType transferFunctor(ConvertLabelVectorToMap(destinationLabels), sourceBackground, destinationBackground,
-    destinationBackgroundLocked, sourceLabel, newDestinationLabel, mergeStyle, overwriteStyle);
-
-  auto transferFilter = FilterType::New();
-
-  transferFilter->SetFunctor(transferFunctor);
-  transferFilter->InPlaceOn();
-  transferFilter->SetInput1(itkDestinationImage);
-  transferFilter->SetInput2(itkSourceImage);
-  transferFilter->GetOutput()->SetRequestedRegion(relevantRegion);
+  auto multiThreader = itk::MultiThreaderBase::New();
+  multiThreader->ParallelizeImageRegion<VImageDimension>(relevantRegion,
+    [&](const typename ContentImageType::RegionType& region)
+    {
+      itk::ImageRegionConstIterator<ContentImageType> sourceIter(itkSourceImage, region);
+      itk::ImageRegionIterator<ContentImageType> destinationIter(itkDestinationImage, region);
 
-  transferFilter->Update();
+      for (; !sourceIter.IsAtEnd(); ++sourceIter, ++destinationIter)
+      {
+        destinationIter.Set(lookupTables(destinationIter.Get(), sourceIter.Get()));
+      }
+    }, nullptr);
 }
 
 void mitk::TransferLabelContentAtTimeStep(
@@ -1622,11 +1694,6 @@ void mitk::TransferLabelContentAtTimeStep(
     mitkThrow() << "Invalid call of TransferLabelContentAtTimeStep; destinationImage must not be null.";
   }
 
-  if (sourceImage == destinationImage && labelMapping.size() > 1)
-  {
-    MITK_DEBUG << "Warning. Using TransferLabelContentAtTimeStep or TransferLabelContent with equal source and destination and more then on label to transfer, can lead to wrong results. Please see documentation and verify that the usage is OK.";
-  }
-
   Image::ConstPointer sourceImageAtTimeStep = SelectImageByTimeStep(sourceImage, timeStep);
   Image::Pointer destinationImageAtTimeStep = SelectImageByTimeStep(destinationImage, timeStep);
 
@@ -1670,8 +1737,14 @@ void mitk::TransferLabelContentAtTimeStep(
     {
       mitkThrow() << "Invalid call of TransferLabelContentAtTimeStep. Defined destination label does not exist in destinationImage. newDestinationLabel: " << newDestinationLabel;
     }
+  }
+
+  const LabelTransferLookupTables lookupTables(destinationLabels, sourceBackground, destinationBackground, destinationBackgroundLocked,
+    labelMapping, mergeStyle, overwriteStlye);
 
-    AccessFixedPixelTypeByItk_n(sourceImageAtTimeStep, TransferLabelContentAtTimeStepHelper, (Label::PixelType), (destinationImageAtTimeStep, destinationLabels, sourceBackground, destinationBackground, destinationBackgroundLocked, sourceLabel, newDestinationLabel, mergeStyle, overwriteStlye));
+  if (!lookupTables.IsIdentity())
+  {
+    AccessFixedPixelTypeByItk_n(sourceImageAtTimeStep, TransferLabelContentAtTimeStepHelper, (Label::PixelType), (destinationImageAtTimeStep, lookupTables));
   }
   destinationImage->Modified();
 }
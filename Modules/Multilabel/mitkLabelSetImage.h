@@ -623,10 +623,9 @@ namespace mitk
   a specified destination label for a specific time step. Function processes the whole image volume of the specified time step.
   @remark in its current implementation the function only transfers contents of the active layer of the passed LabelSetImages.
   @remark the function assumes that it is only called with source and destination image of same geometry.
-  @remark CAUTION: The function is not save if sourceImage and destinationImage are the same instance and more than one label is transferred,
-  because the changes are made in-place for performance reasons in multiple passes. If a mapped value A equals an "old value"
-  that occurs later in the mapping, one ends up with a wrong transfer, as a pixel would be first mapped to A and then later again, because
-  it is also an "old" value in the mapping table.
+  @remark All mapping elements are applied in a single (multi-threaded) pass over the image. The result is the same as if the
+  elements were applied one after another in the order of the labelMapping. As every source pixel is read before its destination
+  pixel is changed, the function can also be used if sourceImage and destinationImage are the same instance.
   @param sourceImage Pointer to the LabelSetImage which active layer should be used as source for the transfer.
   @param destinationImage Pointer to the LabelSetImage which active layer should be used as destination for the transfer.
   @param labelMapping Map that encodes the mappings of all label pixel transfers that should be done. First element is the
@@ -661,10 +660,9 @@ namespace mitk
   /**Helper function that transfers pixels of the specified source label from source image to the destination image by using
   a specified destination label for a specific time step. Function processes the whole image volume of the specified time step.
   @remark the function assumes that it is only called with source and destination image of same geometry.
-  @remark CAUTION: The function is not save, if sourceImage and destinationImage are the same instance and you transfer more then one
-  label, because the changes are made in-place for performance reasons but not in one pass. If a mapped value A equals a "old value"
-  that is later in the mapping, one ends up with a wrong transfer, as a pixel would be first mapped to A and then latter again, because
-  it is also an "old" value in the mapping table.
+  @remark All mapping elements are applied in a single (multi-threaded) pass over the image. The result is the same as if the
+  elements were applied one after another in the order of the labelMapping. As every source pixel is read before its destination
+  pixel is changed, the function can also be used if sourceImage and destinationImage are the same instance.
   @param sourceImage Pointer to the image that should be used as source for the transfer.
   @param destinationImage Pointer to the image that should be used as destination for the transfer.
   @param destinationLabelVector Reference to the vector of labels (incl. lock states) in the destination image. Unknown pixel
@@ -40,6 +40,14 @@ found in the LICENSE file.
 
 namespace
 {
+  const mitk::PropertyKey VisibleKey("visible");
+  const mitk::PropertyKey OpacityKey("opacity");
+  const mitk::PropertyKey LayerKey("layer");
+  const mitk::PropertyKey TextureInterpolationKey("texture interpolation");
+  const mitk::PropertyKey InPlaneResampleExtentByGeometryKey("in plane resample extent by geometry");
+  const mitk::PropertyKey ContourActiveKey("labelset.contour.active");
+  const mitk::PropertyKey ContourWidthKey("labelset.contour.width");
+
   itk::ModifiedTimeType PropertyTimeStampIsNewer(const mitk::IPropertyProvider* provider, mitk::BaseRenderer* renderer, const std::string& propName, itk::ModifiedTimeType refMT)
   {
     const std::string context = renderer != nullptr ? renderer->GetName() : "";
@@ -244,7 +252,7 @@ void mitk::LabelSetImageVtkMapper2D::GenerateDataForRenderer(mitk::BaseRenderer
 
 
   float opacity = 1.0f;
-  node->GetOpacity(opacity, renderer, "opacity");
+  node->GetOpacity(opacity, renderer, OpacityKey);
   opacity *= this->GetOpacityFactor();
 
   if (isLookupModified)
@@ -262,7 +270,7 @@ void mitk::LabelSetImageVtkMapper2D::GenerateDataForRenderer(mitk::BaseRenderer
 
     // check for texture interpolation property
     bool textureInterpolation = false;
-    node->GetBoolProperty("texture interpolation", textureInterpolation, renderer);
+    node->GetBoolProperty(TextureInterpolationKey, textureInterpolation, renderer);
 
     // set the interpolation modus according to the property
     localStorage->m_LayerTextureVector[groupID]->SetInterpolate(textureInterpolation);
@@ -360,7 +368,7 @@ void mitk::LabelSetImageVtkMapper2D::GenerateImageSlice(mitk::BaseRenderer* rend
 
     // is the geometry of the slice based on the image image or the worldgeometry?
     bool inPlaneResampleExtentByGeometry = false;
-    node->GetBoolProperty("in plane resample extent by geometry", inPlaneResampleExtentByGeometry, renderer);
+    node->GetBoolProperty(InPlaneResampleExtentByGeometryKey, inPlaneResampleExtentByGeometry, renderer);
     localStorage->m_ReslicerVector[groupID]->SetInPlaneResampleExtentByGeometry(inPlaneResampleExtentByGeometry);
     localStorage->m_ReslicerVector[groupID]->SetInterpolationMode(ExtractSliceFilter::RESLICE_NEAREST);
     localStorage->m_ReslicerVector[groupID]->SetVtkOutputRequest(true);
@@ -404,12 +412,12 @@ void mitk::LabelSetImageVtkMapper2D::GenerateActiveLabelOutline(mitk::BaseRender
   int activeLayer = image->GetActiveLayer();
 
   float opacity = 1.0f;
-  node->GetOpacity(opacity, renderer, "opacity");
+  node->GetOpacity(opacity, renderer, OpacityKey);
   opacity *= this->GetOpacityFactor();
 
   mitk::Label* activeLabel = image->GetActiveLabel();
   bool contourActive = false;
-  node->GetBoolProperty("labelset.contour.active", contourActive, renderer);
+  node->GetBoolProperty(ContourActiveKey, contourActive, renderer);
   if (nullptr != activeLabel && contourActive && activeLabel->GetVisible())
   {
     //generate contours/outlines
@@ -422,7 +430,7 @@ void mitk::LabelSetImageVtkMapper2D::GenerateActiveLabelOutline(mitk::BaseRender
     localStorage->m_OutlineShadowActor->GetProperty()->SetColor(0, 0, 0);
 
     float contourWidth(2.0);
-    node->GetFloatProperty("labelset.contour.width", contourWidth, renderer);
+    node->GetFloatProperty(ContourWidthKey, contourWidth, renderer);
     localStorage->m_OutlineActor->GetProperty()->SetLineWidth(contourWidth);
     localStorage->m_OutlineShadowActor->GetProperty()->SetLineWidth(contourWidth * 1.5);
 
@@ -633,7 +641,7 @@ void mitk::LabelSetImageVtkMapper2D::Update(mitk::BaseRenderer *renderer)
 {
   bool visible = true;
   const DataNode *node = this->GetDataNode();
-  node->GetVisibility(visible, renderer, "visible");
+  node->GetVisibility(visible, renderer, VisibleKey);
 
   if (!visible)
     return;
@@ -705,7 +713,7 @@ float mitk::LabelSetImageVtkMapper2D::CalculateLayerDepth(mitk::BaseRenderer *re
   // Due to a VTK bug, we cannot use the whole clipping range. /100 is empirically determined
   float depth = -maxRange * 0.01; // divide by 100
   int layer = 0;
-  GetDataNode()->GetIntProperty("layer", layer, renderer);
+  GetDataNode()->GetIntProperty(LayerKey, layer, renderer);
   // add the layer property for each image to render images with a higher layer on top of the others
   depth += layer * 10; //*10: keep some room for each image (e.g. for ODFs in between)
   if (depth > 0.0f)
@@ -0,0 +1,497 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include <mitkMultiLabelSurfaceNetsFilter.h>
+
+#include <mitkExceptionMacro.h>
+#include <mitkImageAccessByItk.h>
+#include <mitkImageTimeSelector.h>
+
+#include <itkMultiThreaderBase.h>
+
+#include <vtkCellArray.h>
+#include <vtkPoints.h>
+#include <vtkPolyData.h>
+#include <vtkSmartPointer.h>
+
+#include <vnl/vnl_det.h>
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <map>
+#include <unordered_map>
+#include <vector>
+
+namespace
+{
+  using LabelType = mitk::MultiLabelSurfaceNetsFilter::LabelType;
+  using CellIdType = std::uint64_t;
+
+  /** Everything one z-layer of cells contributes to the surface of one label.*/
+  struct LabelLayerData
+  {
+    /** Boundary cells of the label, one vertex per cell.*/
+    std::vector<CellIdType> Cells;
+    /** World coordinates of the vertices (three per vertex).*/
+    std::vector<float> Points;
+    /** Four cells per quad, counter-clockwise seen from outside of the label.*/
+    std::vector<CellIdType> Quads;
+
+    bool HasVoxels = false;
+    std::array<itk::IndexValueType, 3> Min;
+    std::array<itk::IndexValueType, 3> Max;
+  };
+
+  using LayerDataType = std::map<LabelType, LabelLayerData>;
+
+  /** The 12 edges of a cell as pairs of corners. Corner i is at offset (i & 1, (i >> 1) & 1, (i >> 2) & 1).*/
+  constexpr int CellEdges[12][2] = {
+    {0, 1}, {2, 3}, {4, 5}, {6, 7}, {0, 2}, {1, 3}, {4, 6}, {5, 7}, {0, 4}, {1, 5}, {2, 6}, {3, 7}};
+
+  void AddVoxel(LabelLayerData &data, itk::IndexValueType x, itk::IndexValueType y, itk::IndexValueType z)
+  {
+    if (!data.HasVoxels)
+    {
+      data.Min = {x, y, z};
+      data.Max = {x, y, z};
+      data.HasVoxels = true;
+      return;
+    }
+
+    data.Min[0] = std::min(data.Min[0], x);
+    data.Max[0] = std::max(data.Max[0], x);
+    data.Min[1] = std::min(data.Min[1], y);
+    data.Max[1] = std::max(data.Max[1], y);
+    data.Min[2] = std::min(data.Min[2], z);
+    data.Max[2] = std::max(data.Max[2], z);
+  }
+}
+
+mitk::MultiLabelSurfaceNetsFilter::MultiLabelSurfaceNetsFilter()
+  : m_BackgroundLabel(LabelSetImage::UNLABELED_VALUE), m_TimeStep(0)
+{
+}
+
+mitk::MultiLabelSurfaceNetsFilter::~MultiLabelSurfaceNetsFilter()
+{
+}
+
+void mitk::MultiLabelSurfaceNetsFilter::SetInput(const mitk::Image *image)
+{
+  // Process object is not const-correct so the const_cast is required here
+  this->ProcessObject::SetNthInput(0, const_cast<mitk::Image *>(image));
+}
+
+const mitk::Image *mitk::MultiLabelSurfaceNetsFilter::GetInput()
+{
+  if (this->GetNumberOfInputs() < 1)
+    return nullptr;
+
+  return static_cast<const mitk::Image *>(this->ProcessObject::GetInput(0));
+}
+
+void mitk::MultiLabelSurfaceNetsFilter::SetLabels(const LabelVectorType &labels)
+{
+  if (m_Labels != labels)
+  {
+    m_Labels = labels;
+    this->Modified();
+  }
+}
+
+mitk::MultiLabelSurfaceNetsFilter::LabelType mitk::MultiLabelSurfaceNetsFilter::GetLabelForNthOutput(unsigned int idx) const
+{
+  if (idx >= m_ExtractedLabels.size())
+    mitkThrow() << "No label was extracted for output " << idx << ".";
+
+  return m_ExtractedLabels[idx];
+}
+
+mitk::Surface *mitk::MultiLabelSurfaceNetsFilter::GetOutputForLabel(LabelType label)
+{
+  auto finding = std::find(m_ExtractedLabels.begin(), m_ExtractedLabels.end(), label);
+
+  if (finding == m_ExtractedLabels.end())
+    return nullptr;
+
+  return this->GetOutput(static_cast<unsigned int>(std::distance(m_ExtractedLabels.begin(), finding)));
+}
+
+mitk::MultiLabelSurfaceNetsFilter::RegionType mitk::MultiLabelSurfaceNetsFilter::GetBoundingBoxForLabel(LabelType label) const
+{
+  auto finding = m_BoundingBoxes.find(label);
+
+  if (finding == m_BoundingBoxes.end())
+    mitkThrow() << "Label " << label << " does not exist in the input image.";
+
+  return finding->second;
+}
+
+void mitk::MultiLabelSurfaceNetsFilter::GenerateOutputInformation()
+{
+  itkDebugMacro(<< "GenerateOutputInformation()");
+}
+
+void mitk::MultiLabelSurfaceNetsFilter::GenerateData()
+{
+  Image::ConstPointer input = this->GetInput();
+
+  if (input.IsNull())
+    mitkThrow() << "No input image set.";
+
+  if (3 != input->GetDimension() && 4 != input->GetDimension())
+    mitkThrow() << "The input image has to be a 3D or 3D+t image.";
+
+  auto timeStepImage = SelectImageByTimeStep(input, m_TimeStep);
+
+  if (timeStepImage.IsNull())
+    mitkThrow() << "The input image has no time step " << m_TimeStep << ".";
+
+  AccessFixedTypeByItk_1(timeStepImage,
+                         InternalProcessing,
+                         MITK_ACCESSBYITK_INTEGRAL_PIXEL_TYPES_SEQ,
+                         (3),
+                         input->GetGeometry(m_TimeStep));
+}
+
+template <typename TPixel, unsigned int VDimension>
+void mitk::MultiLabelSurfaceNetsFilter::InternalProcessing(const itk::Image<TPixel, VDimension> *image,
+                                                           const BaseGeometry *geometry)
+{
+  const auto size = image->GetBufferedRegion().GetSize();
+  const auto dimX = static_cast<itk::IndexValueType>(size[0]);
+  const auto dimY = static_cast<itk::IndexValueType>(size[1]);
+  const auto dimZ = static_cast<itk::IndexValueType>(size[2]);
+  const TPixel *buffer = image->GetBufferPointer();
+
+  const LabelType background = m_BackgroundLabel;
+
+  std::vector<bool> isSelected;
+  if (!m_Labels.empty())
+  {
+    isSelected.assign(static_cast<std::size_t>(std::numeric_limits<LabelType>::max()) + 1, false);
+
+    for (auto label : m_Labels)
+      isSelected[label] = true;
+  }
+
+  auto isExtracted = [&](LabelType label) { return label != background && (isSelected.empty() || isSelected[label]); };
+
+  auto getVoxel = [&](itk::IndexValueType x, itk::IndexValueType y, itk::IndexValueType z) {
+    if (x < 0 || y < 0 || z < 0 || x >= dimX || y >= dimY || z >= dimZ)
+      return background;
+
+    return static_cast<LabelType>(buffer[(z * dimY + y) * dimX + x]);
+  };
+
+  // Cells span from voxel -1 to voxel dim in each direction, so that labels touching the image border are closed.
+  const CellIdType cellStrides[3] = {
+    1, static_cast<CellIdType>(dimX + 1), static_cast<CellIdType>(dimX + 1) * static_cast<CellIdType>(dimY + 1)};
+
+  auto getCellId = [&](itk::IndexValueType x, itk::IndexValueType y, itk::IndexValueType z) {
+    return static_cast<CellIdType>(x + 1) * cellStrides[0] + static_cast<CellIdType>(y + 1) * cellStrides[1] +
+           static_cast<CellIdType>(z + 1) * cellStrides[2];
+  };
+
+  // The vertices are transformed into world coordinates right away.
+  const auto *indexToWorld = geometry->GetIndexToWorldTransform();
+  const auto matrix = indexToWorld->GetMatrix();
+  const auto offset = indexToWorld->GetOffset();
+
+  // A mirroring index to world transform turns the orientation of the faces.
+  const bool isMirrored = vnl_det(matrix.GetVnlMatrix()) < 0.0;
+
+  std::vector<LayerDataType> layers(static_cast<std::size_t>(dimZ) + 1);
+
+  auto processLayer = [&](itk::SizeValueType layerIndex) {
+    auto &layer = layers[layerIndex];
+    const auto cz = static_cast<itk::IndexValueType>(layerIndex) - 1;
+
+    // bounding boxes: every layer accounts for the voxels of its upper z-plane
+    if (cz + 1 < dimZ)
+    {
+      const auto z = cz + 1;
+
+      for (itk::IndexValueType y = 0; y < dimY; ++y)
+      {
+        const TPixel *row = buffer + (z * dimY + y) * dimX;
+        LabelType runLabel = background;
+        itk::IndexValueType runStart = 0;
+
+        for (itk::IndexValueType x = 0; x <= dimX; ++x)
+        {
+          const auto label = x < dimX ? static_cast<LabelType>(row[x]) : background;
+
+          if (label == runLabel && x < dimX)
+            continue;
+
+          if (runLabel != background)
+          {
+            auto &data = layer[runLabel];
+            AddVoxel(data, runStart, y, z);
+            AddVoxel(data, x - 1, y, z);
+          }
+
+          runLabel = label;
+          runStart = x;
+        }
+      }
+    }
+
+    LabelType v[8];
+
+    for (itk::IndexValueType cy = -1; cy < dimY; ++cy)
+    {
+      for (itk::IndexValueType cx = -1; cx < dimX; ++cx)
+      {
+        bool isUniform = true;
+
+        for (int i = 0; i < 8; ++i)
+        {
+          v[i] = getVoxel(cx + (i & 1), cy + ((i >> 1) & 1), cz + ((i >> 2) & 1));
+          isUniform = isUniform && v[i] == v[0];
+        }
+
+        if (isUniform)
+          continue;
+
+        const auto cellId = getCellId(cx, cy, cz);
+
+        // one vertex per label present in the cell
+        for (int i = 0; i < 8; ++i)
+        {
+          const auto label = v[i];
+
+          if (!isExtracted(label) || std::find(v, v + i, label) != v + i)
+            continue;
+
+          double sum[3] = {0.0, 0.0, 0.0};
+          int numberOfCrossings = 0;
+
+          for (const auto &edge : CellEdges)
+          {
+            if ((v[edge[0]] == label) != (v[edge[1]] == label))
+            {
+              for (int d = 0; d < 3; ++d)
+                sum[d] += ((edge[0] >> d) & 1) + ((edge[1] >> d) & 1);
+
+              numberOfCrossings += 2;
+            }
+          }
+
+          itk::Point<double, 3> index;
+          index[0] = cx + sum[0] / numberOfCrossings;
+          index[1] = cy + sum[1] / numberOfCrossings;
+          index[2] = cz + sum[2] / numberOfCrossings;
+
+          const auto world = matrix * index + offset;
+
+          auto &data = layer[label];
+          data.Cells.push_back(cellId);
+          data.Points.insert(data.Points.end(),
+                             {static_cast<float>(world[0]), static_cast<float>(world[1]), static_cast<float>(world[2])});
+        }
+
+        // One quad per voxel edge from the upper corner (7) of the cell in negative direction. The four cells
+        // sharing that edge are this cell and its neighbors in the two other directions.
+        for (int k = 0; k < 3; ++k)
+        {
+          const int lower = 7 ^ (1 << k);
+
+          if (v[lower] == v[7])
+            continue;
+
+          const auto u = cellStrides[(k + 1) % 3];
+          const auto w = cellStrides[(k + 2) % 3];
+
+          // counter-clockwise around +k, i.e. seen from the voxel in positive k direction
+          const std::array<CellIdType, 4> quad = {cellId, cellId + u, cellId + u + w, cellId + w};
+          const std::array<CellIdType, 4> reversedQuad = {cellId, cellId + w, cellId + u + w, cellId + u};
+
+          if (isExtracted(v[lower]))
+          {
+            const auto &q = isMirrored ? reversedQuad : quad;
+            auto &quads = layer[v[lower]].Quads;
+            quads.insert(quads.end(), q.begin(), q.end());
+          }
+
+          if (isExtracted(v[7]))
+          {
+            const auto &q = isMirrored ? quad : reversedQuad;
+            auto &quads = layer[v[7]].Quads;
+            quads.insert(quads.end(), q.begin(), q.end());
+          }
+        }
+      }
+    }
+  };
+
+  auto multiThreader = this->GetMultiThreader();
+  multiThreader->SetNumberOfWorkUnits(this->GetNumberOfWorkUnits());
+  multiThreader->ParallelizeArray(0, layers.size(), processLayer, nullptr);
+
+  // merge the bounding boxes and determine the labels to extract
+  m_BoundingBoxes.clear();
+  m_ExtractedLabels.clear();
+
+  std::map<LabelType, std::array<itk::IndexValueType, 6>> bounds;
+
+  for (const auto &layer : layers)
+  {
+    for (const auto &labelData : layer)
+    {
+      if (!labelData.second.HasVoxels)
+        continue;
+
+      const auto &data = labelData.second;
+      auto insertion = bounds.emplace(
+        labelData.first, std::array<itk::IndexValueType, 6>{data.Min[0], data.Min[1], data.Min[2], data.Max[0], data.Max[1], data.Max[2]});
+
+      if (!insertion.second)
+      {
+        auto &b = insertion.first->second;
+
+        for (int d = 0; d < 3; ++d)
+        {
+          b[d] = std::min(b[d], data.Min[d]);
+          b[d + 3] = std::max(b[d + 3], data.Max[d]);
+        }
+      }
+    }
+  }
+
+  for (const auto &labelBounds : bounds)
+  {
+    RegionType::IndexType index;
+    RegionType::SizeType regionSize;
+
+    for (int d = 0; d < 3; ++d)
+    {
+      index[d] = labelBounds.second[d];
+      regionSize[d] = static_cast<itk::SizeValueType>(labelBounds.second[d + 3] - labelBounds.second[d] + 1);
+    }
+
+    m_BoundingBoxes[labelBounds.first] = RegionType(index, regionSize);
+
+    if (isExtracted(labelBounds.first))
+      m_ExtractedLabels.push_back(labelBounds.first);
+  }
+
+  for (auto label : m_Labels)
+  {
+    if (label != background && 0 == m_BoundingBoxes.count(label))
+      MITK_WARN << "Label " << label << " does not exist in the input image. No surface is generated for it.";
+  }
+
+  // assemble one mesh per label (in parallel over the labels)
+  const auto numberOfLabels = m_ExtractedLabels.size();
+  std::vector<vtkSmartPointer<vtkPolyData>> meshes(numberOfLabels);
+
+  auto assembleMesh = [&](itk::SizeValueType labelIndex) {
+    const auto label = m_ExtractedLabels[labelIndex];
+
+    std::size_t numberOfPoints = 0;
+    std::size_t numberOfQuads = 0;
+
+    for (const auto &layer : layers)
+    {
+      auto finding = layer.find(label);
+
+      if (finding != layer.end())
+      {
+        numberOfPoints += finding->second.Cells.size();
+        numberOfQuads += finding->second.Quads.size() / 4;
+      }
+    }
+
+    auto points = vtkSmartPointer<vtkPoints>::New();
+    points->SetDataTypeToFloat();
+    points->SetNumberOfPoints(static_cast<vtkIdType>(numberOfPoints));
+
+    std::unordered_map<CellIdType, vtkIdType> cellToPoint;
+    cellToPoint.reserve(numberOfPoints);
+
+    vtkIdType pointId = 0;
+
+    for (const auto &layer : layers)
+    {
+      auto finding = layer.find(label);
+
+      if (finding == layer.end())
+        continue;
+
+      const auto &data = finding->second;
+
+      for (std::size_t i = 0; i < data.Cells.size(); ++i, ++pointId)
+      {
+        cellToPoint.emplace(data.Cells[i], pointId);
+        points->SetPoint(pointId, data.Points[3 * i], data.Points[3 * i + 1], data.Points[3 * i + 2]);
+      }
+    }
+
+    auto polys = vtkSmartPointer<vtkCellArray>::New();
+    polys->AllocateExact(static_cast<vtkIdType>(2 * numberOfQuads), static_cast<vtkIdType>(6 * numberOfQuads));
+
+    for (const auto &layer : layers)
+    {
+      auto finding = layer.find(label);
+
+      if (finding == layer.end())
+        continue;
+
+      const auto &quads = finding->second.Quads;
+
+      for (std::size_t i = 0; i < quads.size(); i += 4)
+      {
+        const vtkIdType ids[4] = {
+          cellToPoint.at(quads[i]), cellToPoint.at(quads[i + 1]), cellToPoint.at(quads[i + 2]), cellToPoint.at(quads[i + 3])};
+
+        const vtkIdType firstTriangle[3] = {ids[0], ids[1], ids[2]};
+        const vtkIdType secondTriangle[3] = {ids[0], ids[2], ids[3]};
+
+        polys->InsertNextCell(3, firstTriangle);
+        polys->InsertNextCell(3, secondTriangle);
+      }
+    }
+
+    auto mesh = vtkSmartPointer<vtkPolyData>::New();
+    mesh->SetPoints(points);
+    mesh->SetPolys(polys);
+
+    meshes[labelIndex] = mesh;
+  };
+
+  if (0 < numberOfLabels)
+    multiThreader->ParallelizeArray(0, numberOfLabels, assembleMesh, nullptr);
+
+  // one output per extracted label (at least the primary output)
+  if (meshes.empty())
+    meshes.push_back(vtkSmartPointer<vtkPolyData>::New());
+
+  const auto numberOfOutputs = meshes.size();
+  this->SetNumberOfIndexedOutputs(numberOfOutputs);
+
+  for (std::size_t i = 0; i < numberOfOutputs; ++i)
+  {
+    Surface::Pointer output = this->GetOutput(i);
+
+    if (output.IsNull())
+    {
+      output = static_cast<Surface *>(this->MakeOutput(i).GetPointer());
+      this->SetNthOutput(i, output);
+    }
+
+    output->SetVtkPolyData(meshes[i], 0);
+  }
+}
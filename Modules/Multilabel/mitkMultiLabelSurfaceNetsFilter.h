@@ -0,0 +1,115 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef mitkMultiLabelSurfaceNetsFilter_h
+#define mitkMultiLabelSurfaceNetsFilter_h
+
+#include <MitkMultilabelExports.h>
+#include <mitkLabelSetImage.h>
+#include <mitkSurface.h>
+#include <mitkSurfaceSource.h>
+
+#include <itkImage.h>
+#include <itkImageRegion.h>
+
+#include <map>
+
+namespace mitk
+{
+  /**
+   * \brief Generates the surface meshes of all labels of a label (group) image in one sweep.
+   *
+   * In contrast to LabelSetImageToSurfaceFilter, which runs a complete marching cubes pipeline per label,
+   * this filter visits every cell (2x2x2 voxels) of the image only once and extracts the boundaries of all
+   * labels at the same time (multi-label surface nets). The z-layers of cells are processed in parallel
+   * (see itk::ProcessObject::SetNumberOfWorkUnits()). Every label surface gets one vertex per boundary cell,
+   * placed at the mean of the crossed cell edges, and one quad (two triangles) per voxel face between the
+   * label and any other label, so neighboring labels share their boundaries without gaps.
+   *
+   * The vertices are transformed into world coordinates when they are created. The index bounding box of
+   * every label is determined in the same sweep (see GetBoundingBoxForLabel()).
+   *
+   * Each extracted label gets one output of the filter, in ascending order of the label values. Use
+   * GetLabelForNthOutput() or GetOutputForLabel() to map between outputs and labels.
+   *
+   * The input has to be a 3D image (e.g. a group image of a LabelSetImage) of an integral pixel type.
+   */
+  class MITKMULTILABEL_EXPORT MultiLabelSurfaceNetsFilter : public SurfaceSource
+  {
+  public:
+    mitkClassMacro(MultiLabelSurfaceNetsFilter, SurfaceSource);
+    itkFactorylessNewMacro(Self);
+
+    using LabelType = LabelSetImage::LabelValueType;
+    using LabelVectorType = LabelSetImage::LabelValueVectorType;
+    using RegionType = itk::ImageRegion<3>;
+    using BoundingBoxMapType = std::map<LabelType, RegionType>;
+
+    using ProcessObject::SetInput;
+    virtual void SetInput(const Image *image);
+    const Image *GetInput();
+
+    /**
+     * Set the labels to extract. If the vector is empty (default), all labels found in the image are extracted.
+     * Labels that are not extracted still separate the extracted labels from each other.
+     */
+    void SetLabels(const LabelVectorType &labels);
+    itkGetConstReferenceMacro(Labels, LabelVectorType);
+
+    /** The value of the background. No surface is generated for it. By default LabelSetImage::UNLABELED_VALUE.*/
+    itkSetMacro(BackgroundLabel, LabelType);
+    itkGetConstMacro(BackgroundLabel, LabelType);
+
+    /** The time step of the input image to process. By default 0.*/
+    itkSetMacro(TimeStep, TimeStepType);
+    itkGetConstMacro(TimeStep, TimeStepType);
+
+    /** The labels that were extracted by the last update, in the order of the outputs.
+     * If no label was extracted, the (only) output is an empty surface.*/
+    itkGetConstReferenceMacro(ExtractedLabels, LabelVectorType);
+
+    /** Returns the label of the n-th output.*/
+    LabelType GetLabelForNthOutput(unsigned int idx) const;
+
+    /** Returns the output of the given label or nullptr if the label was not extracted.*/
+    Surface *GetOutputForLabel(LabelType label);
+
+    /**
+     * Returns the index bounding box of the voxels of the given label (of every label found in the image,
+     * not only of the extracted ones). An exception is thrown if the label does not exist in the image.
+     */
+    RegionType GetBoundingBoxForLabel(LabelType label) const;
+
+    /** The index bounding boxes of all labels found in the image.*/
+    itkGetConstReferenceMacro(BoundingBoxes, BoundingBoxMapType);
+
+  protected:
+    MultiLabelSurfaceNetsFilter();
+    ~MultiLabelSurfaceNetsFilter() override;
+
+    void GenerateOutputInformation() override;
+    void GenerateData() override;
+
+    template <typename TPixel, unsigned int VDimension>
+    void InternalProcessing(const itk::Image<TPixel, VDimension> *image, const BaseGeometry *geometry);
+
+  private:
+    LabelVectorType m_Labels;
+    LabelType m_BackgroundLabel;
+    TimeStepType m_TimeStep;
+
+    LabelVectorType m_ExtractedLabels;
+    BoundingBoxMapType m_BoundingBoxes;
+  };
+}
+
+#endif
@@ -57,6 +57,8 @@ protected:
 
   void StartOrResetTimer() override;
 
+  bool HasLODTimer() const override;
+
   int pendingTimerCallbacks;
 
 protected slots:
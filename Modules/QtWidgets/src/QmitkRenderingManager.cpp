@@ -47,6 +47,11 @@ void QmitkRenderingManager::StartOrResetTimer()
   pendingTimerCallbacks++;
 }
 
+bool QmitkRenderingManager::HasLODTimer() const
+{
+  return true;
+}
+
 void QmitkRenderingManager::TimerCallback()
 {
   if (!--pendingTimerCallbacks)
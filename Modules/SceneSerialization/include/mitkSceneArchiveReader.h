@@ -0,0 +1,114 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef mitkSceneArchiveReader_h
+#define mitkSceneArchiveReader_h
+
+#include <MitkSceneSerializationExports.h>
+
+#include <future>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace Poco
+{
+  namespace Zip
+  {
+    class ZipArchive;
+  }
+}
+
+namespace mitk
+{
+  /**
+    \brief Provides the entries of a scene archive on demand.
+
+    Only the directory of the archive is parsed on construction. Entries are read into
+    memory (ReadEntry()) or extracted into the working directory when a scene reader
+    requests them (RequestEntry()) and removed again when it releases them (ReleaseEntry()).
+    Entries that share the name of the requested entry except for the extension (like
+    .mhd/.raw pairs) are extracted together with it.
+
+    While an entry is read, the following entries of the archive are extracted in the
+    background by up to "number of threads" tasks. Extracted but not yet released
+    entries are limited to the same number, so the temporary disk space stays bounded.
+  */
+  class MITKSCENESERIALIZATION_EXPORT SceneArchiveReader
+  {
+  public:
+    /**
+      \throw mitk::Exception if the file is not a readable zip file.
+    */
+    SceneArchiveReader(const std::string &filename, const std::string &workingDirectory, unsigned int numberOfThreads);
+
+    /** Waits for background extractions and removes all extracted files.*/
+    ~SceneArchiveReader();
+
+    bool HasEntry(const std::string &entryName) const;
+
+    /**
+      \brief Decompresses an entry into memory.
+      \throw mitk::Exception if the entry does not exist or is corrupted.
+    */
+    std::string ReadEntry(const std::string &entryName) const;
+
+    /**
+      \brief Makes the entry available as file in the working directory.
+      Unknown entries are ignored, so the calling reader reports the missing file as usual.
+      \return False if the entry exists but could not be extracted.
+    */
+    bool RequestEntry(const std::string &entryName);
+
+    /** Removes the files extracted for the entry.*/
+    void ReleaseEntry(const std::string &entryName);
+
+    /** Number of entries that could not be extracted.*/
+    unsigned int GetNumberOfErrors() const;
+
+  private:
+    /** Extracted files of a requested entry and its siblings.*/
+    struct Group
+    {
+      std::vector<std::string> EntryNames;
+      std::shared_future<bool> Extraction;
+      bool Prefetched = false;
+    };
+
+    std::vector<std::string> GetGroupEntryNames(const std::string &entryName) const;
+    bool ExtractEntries(const std::vector<std::string> &entryNames) const;
+    Group &StartExtraction(const std::string &entryName, bool prefetch);
+    void PrefetchFollowingEntries(const std::string &entryName);
+    void RemoveFiles(const Group &group);
+
+    std::string m_Filename;
+    std::string m_WorkingDirectory;
+    std::size_t m_MaximumNumberOfPrefetchedGroups;
+    std::unique_ptr<Poco::Zip::ZipArchive> m_Archive;
+
+    /** Names of the file entries in archive order.*/
+    std::vector<std::string> m_EntryNames;
+
+    /** Extracted groups by the name of the entry that was requested or prefetched.*/
+    std::map<std::string, Group> m_Groups;
+
+    /** Group of each extracted entry.*/
+    std::map<std::string, std::string> m_GroupOfEntry;
+    std::size_t m_NumberOfPrefetchedGroups;
+    mutable unsigned int m_NumberOfErrors;
+    mutable std::mutex m_ErrorMutex;
+  };
+}
+
+#endif
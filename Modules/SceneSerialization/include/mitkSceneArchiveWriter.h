@@ -0,0 +1,138 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef mitkSceneArchiveWriter_h
+#define mitkSceneArchiveWriter_h
+
+#include <MitkSceneSerializationExports.h>
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <fstream>
+#include <future>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace mitk
+{
+  /**
+    \brief Writes the ZIP archive of a scene while the scene is still being serialized.
+
+    SceneIO adds each serialized file right after it was written. The file is read in
+    chunks that are deflated independently by a pool of worker threads and appended to
+    the archive in their original order (the chunks are concatenated like pigz does).
+    The file is not needed anymore when AddFile() returns, so the temporary disk space
+    of a scene is bounded by the size of its largest file.
+
+    Entries and the central directory use ZIP64 extensions where sizes or offsets
+    require them, so scenes larger than 4 GB can be written.
+
+    The archive is written to a temporary file next to the target file, which replaces
+    the target only when Close() succeeds. If writing fails or the writer is destroyed
+    without Close(), the temporary file is removed and an existing target file is kept.
+  */
+  class MITKSCENESERIALIZATION_EXPORT SceneArchiveWriter
+  {
+  public:
+    /**
+      \param filename the archive to create; an existing file is replaced by Close().
+      \param numberOfThreads number of compression threads; 0 uses one thread per core.
+      \param compressionLevel zlib compression level (1 = fastest, 9 = smallest).
+    */
+    SceneArchiveWriter(const std::string &filename, unsigned int numberOfThreads, int compressionLevel);
+    ~SceneArchiveWriter();
+
+    /**
+      \brief Adds a file as entry of the archive.
+      Compression of the last chunks of the file may still be in progress when the method returns,
+      but the file itself has been read completely and may be removed.
+      \throw mitk::Exception if the file cannot be read or the archive cannot be written.
+    */
+    void AddFile(const std::string &path, const std::string &entryName);
+
+    /**
+      \brief Waits for all entries, writes the central directory and moves the archive to its target file.
+      \throw mitk::Exception if the archive cannot be written. The target file is unchanged in this case.
+    */
+    void Close();
+
+    std::uint64_t GetUncompressedSize() const;
+    std::uint64_t GetCompressedSize() const;
+
+  private:
+    struct Entry
+    {
+      std::string Name;
+      std::uint64_t LocalHeaderOffset = 0;
+      std::uint64_t UncompressedSize = 0;
+      std::uint64_t CompressedSize = 0;
+      std::uint32_t CRC = 0;
+      bool Zip64 = false;
+    };
+
+    /** Items are written to the archive strictly in the order they were queued.*/
+    struct PendingItem
+    {
+      enum class Type
+      {
+        LocalHeader,
+        Chunk,
+        Finish
+      };
+
+      Type ItemType;
+      std::size_t EntryIndex;
+      std::future<std::string> Chunk;
+    };
+
+    void StartWorkers(unsigned int numberOfThreads);
+    void StopWorkers();
+    void WorkerLoop();
+
+    std::future<std::string> QueueChunk(std::vector<char> &&data, bool isLastChunk);
+
+    /** Writes all pending items whose data is available. If wait is true, blocks until the first item can be written.*/
+    void WritePendingItems(bool waitForFirst);
+    void WritePendingItem(PendingItem &item);
+
+    void WriteLocalHeader(Entry &entry);
+    void PatchLocalHeader(const Entry &entry);
+    void WriteCentralDirectory();
+
+    /** Removes the temporary file, if the archive was not moved to the target file.*/
+    void RemoveTemporaryFile();
+
+    std::ofstream m_Stream;
+    std::string m_Filename;
+    std::string m_TemporaryFilename;
+    int m_CompressionLevel;
+    std::uint16_t m_DosTime;
+    std::uint16_t m_DosDate;
+    bool m_Closed;
+
+    std::deque<Entry> m_Entries;
+    std::deque<PendingItem> m_PendingItems;
+    std::size_t m_NumberOfPendingChunks;
+    std::size_t m_MaximumNumberOfPendingChunks;
+
+    std::vector<std::thread> m_Workers;
+    std::deque<std::packaged_task<std::string()>> m_Tasks;
+    std::mutex m_TaskMutex;
+    std::condition_variable m_TaskCondition;
+    bool m_StopWorkers;
+  };
+}
+
+#endif
@@ -18,7 +18,8 @@ found in the LICENSE file.
 #include "mitkDataStorage.h"
 #include "mitkNodePredicateBase.h"
 
-#include <Poco/Zip/ZipLocalFileHeader.h>
+#include <utility>
+#include <vector>
 
 namespace tinyxml2
 {
@@ -40,6 +41,23 @@ namespace mitk
 
       typedef DataStorage::SetOfObjects FailedBaseDataListType;
 
+    /** Pairs of a name (node name or scene file) and the seconds needed to save or load it.*/
+    typedef std::vector<std::pair<std::string, double>> TimingListType;
+
+    /**
+     * \brief Number of threads used to compress and decompress scene files.
+     *
+     * 0 (default) uses one thread per core.
+     */
+    itkSetMacro(NumberOfThreads, unsigned int);
+    itkGetConstMacro(NumberOfThreads, unsigned int);
+
+    /**
+     * \brief Compression level of scene files, from 1 (fastest) to 9 (smallest). Default is 6.
+     */
+    itkSetClampMacro(CompressionLevel, int, 1, 9);
+    itkGetConstMacro(CompressionLevel, int);
+
     /**
      * \brief Load a scene of objects from file
      * \return DataStorage with all scene objects and their relations. If loading failed, query GetFailedNodes() and
@@ -48,6 +66,10 @@ namespace mitk
      * Attempts to read the provided file and create objects with
      * parent/child relations into a DataStorage.
      *
+     * Only the directory of the scene file is read up front. The files of the scene are
+     * extracted on demand right before they are loaded (and prefetched in parallel) and
+     * removed right after, so only a few of them exist in the temporary directory at a time.
+     *
      * \param filename full filename of the scene file
      * \param storage If given, this DataStorage is used instead of a newly created one
      * \param clearStorageFirst If set, the provided DataStorage will be cleared before populating it with the loaded
@@ -86,6 +108,10 @@ namespace mitk
      * Attempts to write a scene file, which contains the nodes of the
      * provided DataStorage, their parent/child relations, and properties.
      *
+     * The files of each node are compressed into the scene file in parallel right after the node
+     * was serialized and removed from the temporary directory afterwards. Scene files larger than
+     * 4 GB are written with ZIP64 extensions.
+     *
      * \param sceneNodes
      * \param storage a DataStorage containing all nodes that should be saved
      * \param filename
@@ -115,6 +141,13 @@ namespace mitk
      */
     const PropertyList *GetFailedProperties();
 
+    /**
+     * \brief Get the timings of the last call to SaveScene (per node) or LoadScene (per scene file).
+     *
+     * Load timings include the time needed to extract the file from the scene file.
+     */
+    const TimingListType &GetTimings() const;
+
   protected:
     SceneIO();
     ~SceneIO() override;
@@ -124,14 +157,15 @@ namespace mitk
     tinyxml2::XMLElement *SaveBaseData(tinyxml2::XMLDocument &doc, BaseData *data, const std::string &filenamehint, bool &error);
     tinyxml2::XMLElement *SavePropertyList(tinyxml2::XMLDocument &doc, PropertyList *propertyList, const std::string &filenamehint);
 
-    void OnUnzipError(const void *pSender, std::pair<const Poco::Zip::ZipLocalFileHeader, const std::string> &info);
-    void OnUnzipOk(const void *pSender, std::pair<const Poco::Zip::ZipLocalFileHeader, const Poco::Path> &info);
-
     FailedBaseDataListType::Pointer m_FailedNodes;
     PropertyList::Pointer m_FailedProperties;
 
     std::string m_WorkingDirectory;
     unsigned int m_UnzipErrors;
+
+    unsigned int m_NumberOfThreads;
+    int m_CompressionLevel;
+    TimingListType m_Timings;
   };
 }
 
@@ -19,6 +19,8 @@ found in the LICENSE file.
 
 #include "mitkDataStorage.h"
 
+#include <functional>
+
 namespace tinyxml2
 {
   class XMLDocument;
@@ -34,6 +36,26 @@ namespace mitk
     itkCloneMacro(Self);
 
     virtual bool LoadScene(tinyxml2::XMLDocument &document, const std::string &workingDirectory, DataStorage *storage);
+
+    /**
+     * \brief Callback that is called with the name of a scene file (relative to the working directory).
+     */
+    using FileCallback = std::function<void(const std::string &filename)>;
+
+    /**
+     * \brief Sets callbacks that are called right before a file of the scene is read and right after it was read.
+     *
+     * Allows to provide the files of a scene on demand, e.g. to extract them from the scene archive
+     * only when they are needed (see SceneIO::LoadScene()).
+     */
+    void SetFileCallbacks(const FileCallback &requestFile, const FileCallback &releaseFile);
+
+  protected:
+    void RequestFile(const std::string &filename) const;
+    void ReleaseFile(const std::string &filename) const;
+
+    FileCallback m_RequestFileCallback;
+    FileCallback m_ReleaseFileCallback;
   };
 }
 
@@ -0,0 +1,283 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkSceneArchiveReader.h"
+
+#include <mitkExceptionMacro.h>
+#include <mitkLog.h>
+
+#include <Poco/File.h>
+#include <Poco/Path.h>
+#include <Poco/StreamCopier.h>
+#include <Poco/Zip/ZipArchive.h>
+#include <Poco/Zip/ZipStream.h>
+
+#include <algorithm>
+#include <fstream>
+#include <thread>
+
+mitk::SceneArchiveReader::SceneArchiveReader(const std::string &filename,
+                                             const std::string &workingDirectory,
+                                             unsigned int numberOfThreads)
+  : m_Filename(filename),
+    m_WorkingDirectory(workingDirectory),
+    m_MaximumNumberOfPrefetchedGroups(0),
+    m_NumberOfPrefetchedGroups(0),
+    m_NumberOfErrors(0)
+{
+  if (0 == numberOfThreads)
+  {
+    numberOfThreads = std::max(1u, std::thread::hardware_concurrency());
+  }
+
+  m_MaximumNumberOfPrefetchedGroups = numberOfThreads;
+
+  std::ifstream file(filename, std::ios::binary);
+  if (!file.good())
+  {
+    mitkThrow() << "Cannot open '" << filename << "' for reading";
+  }
+
+  try
+  {
+    m_Archive = std::make_unique<Poco::Zip::ZipArchive>(file);
+  }
+  catch (const std::exception &e)
+  {
+    mitkThrow() << "Cannot read the zip directory of '" << filename << "': " << e.what();
+  }
+
+  std::vector<std::pair<std::streamoff, std::string>> entries;
+  for (auto iter = m_Archive->headersBegin(); iter != m_Archive->headersEnd(); ++iter)
+  {
+    if (iter->second.isFile())
+      entries.emplace_back(iter->second.getStartPos(), iter->first);
+  }
+
+  std::sort(entries.begin(), entries.end());
+
+  for (const auto &entry : entries)
+  {
+    m_EntryNames.push_back(entry.second);
+  }
+}
+
+mitk::SceneArchiveReader::~SceneArchiveReader()
+{
+  for (auto &group : m_Groups)
+  {
+    group.second.Extraction.wait();
+    this->RemoveFiles(group.second);
+  }
+}
+
+bool mitk::SceneArchiveReader::HasEntry(const std::string &entryName) const
+{
+  return std::find(m_EntryNames.cbegin(), m_EntryNames.cend(), entryName) != m_EntryNames.cend();
+}
+
+std::string mitk::SceneArchiveReader::ReadEntry(const std::string &entryName) const
+{
+  const auto header = m_Archive->findHeader(entryName);
+  if (header == m_Archive->headersEnd())
+  {
+    mitkThrow() << "'" << m_Filename << "' does not contain '" << entryName << "'";
+  }
+
+  std::string content;
+
+  try
+  {
+    std::ifstream file(m_Filename, std::ios::binary);
+    Poco::Zip::ZipInputStream zipStream(file, header->second);
+    Poco::StreamCopier::copyToString(zipStream, content);
+  }
+  catch (const std::exception &e)
+  {
+    mitkThrow() << "Cannot decompress '" << entryName << "' from '" << m_Filename << "': " << e.what();
+  }
+
+  return content;
+}
+
+std::vector<std::string> mitk::SceneArchiveReader::GetGroupEntryNames(const std::string &entryName) const
+{
+  std::vector<std::string> result = { entryName };
+
+  const auto extensionPos = entryName.find_last_of('.');
+  const auto directoryPos = entryName.find_last_of('/');
+
+  if (extensionPos == std::string::npos || (directoryPos != std::string::npos && extensionPos < directoryPos))
+    return result;
+
+  const auto prefix = entryName.substr(0, extensionPos + 1);
+
+  for (const auto &name : m_EntryNames)
+  {
+    if (name != entryName && name.size() > prefix.size() && 0 == name.compare(0, prefix.size(), prefix) &&
+        name.find('/', prefix.size()) == std::string::npos)
+    {
+      result.push_back(name);
+    }
+  }
+
+  return result;
+}
+
+bool mitk::SceneArchiveReader::ExtractEntries(const std::vector<std::string> &entryNames) const
+{
+  bool success = true;
+
+  for (const auto &entryName : entryNames)
+  {
+    try
+    {
+      const auto header = m_Archive->findHeader(entryName);
+
+      Poco::Path targetPath(m_WorkingDirectory);
+      targetPath.makeDirectory();
+      targetPath.append(Poco::Path(entryName, Poco::Path::PATH_UNIX));
+
+      Poco::File(targetPath.parent()).createDirectories();
+
+      // Every extraction uses its own stream, so entries can be extracted concurrently.
+      std::ifstream file(m_Filename, std::ios::binary);
+      Poco::Zip::ZipInputStream zipStream(file, header->second);
+
+      std::ofstream target(targetPath.toString(), std::ios::binary | std::ios::trunc);
+      Poco::StreamCopier::copyStream(zipStream, target);
+
+      if (!target.good())
+      {
+        mitkThrow() << "Cannot write '" << targetPath.toString() << "'";
+      }
+    }
+    catch (const std::exception &e)
+    {
+      MITK_ERROR << "Error while unzipping '" << entryName << "': " << e.what();
+      success = false;
+
+      std::lock_guard<std::mutex> lock(m_ErrorMutex);
+      ++m_NumberOfErrors;
+    }
+  }
+
+  return success;
+}
+
+mitk::SceneArchiveReader::Group &mitk::SceneArchiveReader::StartExtraction(const std::string &entryName, bool prefetch)
+{
+  auto &group = m_Groups[entryName];
+
+  for (const auto &name : this->GetGroupEntryNames(entryName))
+  {
+    // siblings might have been extracted as part of another group already
+    if (m_GroupOfEntry.emplace(name, entryName).second)
+      group.EntryNames.push_back(name);
+  }
+
+  const auto entryNames = group.EntryNames;
+  group.Extraction = std::async(std::launch::async, [this, entryNames]() { return this->ExtractEntries(entryNames); }).share();
+
+  if (prefetch)
+  {
+    group.Prefetched = true;
+    ++m_NumberOfPrefetchedGroups;
+  }
+
+  return group;
+}
+
+void mitk::SceneArchiveReader::PrefetchFollowingEntries(const std::string &entryName)
+{
+  auto iter = std::find(m_EntryNames.cbegin(), m_EntryNames.cend(), entryName);
+
+  if (iter == m_EntryNames.cend())
+    return;
+
+  for (++iter; iter != m_EntryNames.cend() && m_NumberOfPrefetchedGroups < m_MaximumNumberOfPrefetchedGroups; ++iter)
+  {
+    if (m_GroupOfEntry.find(*iter) == m_GroupOfEntry.cend())
+      this->StartExtraction(*iter, true);
+  }
+}
+
+bool mitk::SceneArchiveReader::RequestEntry(const std::string &entryName)
+{
+  if (!this->HasEntry(entryName))
+    return true;
+
+  const auto groupName = m_GroupOfEntry.find(entryName);
+
+  auto &group = groupName != m_GroupOfEntry.cend() ? m_Groups[groupName->second] : this->StartExtraction(entryName, false);
+
+  if (group.Prefetched)
+  {
+    group.Prefetched = false;
+    --m_NumberOfPrefetchedGroups;
+  }
+
+  auto extraction = group.Extraction;
+
+  this->PrefetchFollowingEntries(entryName);
+
+  return extraction.get();
+}
+
+void mitk::SceneArchiveReader::ReleaseEntry(const std::string &entryName)
+{
+  const auto groupName = m_GroupOfEntry.find(entryName);
+
+  if (groupName == m_GroupOfEntry.cend())
+    return;
+
+  const auto groupIter = m_Groups.find(groupName->second);
+  auto &group = groupIter->second;
+
+  group.Extraction.wait();
+  this->RemoveFiles(group);
+
+  if (group.Prefetched)
+    --m_NumberOfPrefetchedGroups;
+
+  for (const auto &name : group.EntryNames)
+    m_GroupOfEntry.erase(name);
+
+  m_Groups.erase(groupIter);
+}
+
+void mitk::SceneArchiveReader::RemoveFiles(const Group &group)
+{
+  for (const auto &entryName : group.EntryNames)
+  {
+    try
+    {
+      Poco::Path targetPath(m_WorkingDirectory);
+      targetPath.makeDirectory();
+      targetPath.append(Poco::Path(entryName, Poco::Path::PATH_UNIX));
+
+      Poco::File file(targetPath);
+      if (file.exists())
+        file.remove();
+    }
+    catch (const std::exception &e)
+    {
+      MITK_WARN << "Could not remove extracted file '" << entryName << "': " << e.what();
+    }
+  }
+}
+
+unsigned int mitk::SceneArchiveReader::GetNumberOfErrors() const
+{
+  std::lock_guard<std::mutex> lock(m_ErrorMutex);
+  return m_NumberOfErrors;
+}
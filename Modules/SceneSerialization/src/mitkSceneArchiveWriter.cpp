@@ -0,0 +1,532 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkSceneArchiveWriter.h"
+
+#include <mitkExceptionMacro.h>
+#include <mitkLog.h>
+
+#include <Poco/Checksum.h>
+#include <Poco/DeflatingStream.h>
+#include <Poco/Exception.h>
+#include <Poco/File.h>
+
+#include <algorithm>
+#include <chrono>
+#include <ctime>
+#include <limits>
+#include <sstream>
+
+namespace
+{
+  /** Size of the parts of a file that are compressed independently.*/
+  const std::size_t ChunkSize = 4 * 1024 * 1024;
+
+  /** Files from this size on get ZIP64 headers. Leaves enough room for the worst case expansion of deflate.*/
+  const std::uint64_t Zip64SizeThreshold = 0xF0000000;
+
+  const std::uint32_t Max32 = std::numeric_limits<std::uint32_t>::max();
+  const std::uint16_t Max16 = std::numeric_limits<std::uint16_t>::max();
+
+  const std::uint16_t VersionDefault = 20;
+  const std::uint16_t VersionZip64 = 45;
+  const std::uint16_t MethodDeflate = 8;
+  const std::uint16_t Zip64ExtraFieldId = 0x0001;
+
+  void WriteUInt16(std::ostream &stream, std::uint16_t value)
+  {
+    const char bytes[2] = { static_cast<char>(value & 0xFF), static_cast<char>((value >> 8) & 0xFF) };
+    stream.write(bytes, 2);
+  }
+
+  void WriteUInt32(std::ostream &stream, std::uint32_t value)
+  {
+    WriteUInt16(stream, static_cast<std::uint16_t>(value & 0xFFFF));
+    WriteUInt16(stream, static_cast<std::uint16_t>(value >> 16));
+  }
+
+  void WriteUInt64(std::ostream &stream, std::uint64_t value)
+  {
+    WriteUInt32(stream, static_cast<std::uint32_t>(value & 0xFFFFFFFF));
+    WriteUInt32(stream, static_cast<std::uint32_t>(value >> 32));
+  }
+
+  std::uint32_t Clamp32(std::uint64_t value)
+  {
+    return static_cast<std::uint32_t>(std::min<std::uint64_t>(value, Max32));
+  }
+
+  /**
+    Compresses one chunk of a file to raw deflate data. All chunks except the last one end with a
+    sync flush instead of a final block, so the compressed chunks can simply be concatenated.
+  */
+  std::string DeflateChunk(const std::vector<char> &data, int compressionLevel, bool isLastChunk)
+  {
+    std::ostringstream buffer;
+
+    // negative window bits produce raw deflate data without zlib header, as required by ZIP
+    Poco::DeflatingOutputStream deflater(buffer, -15, compressionLevel);
+    deflater.write(data.data(), data.size());
+
+    if (isLastChunk)
+    {
+      deflater.close();
+      return buffer.str();
+    }
+
+    deflater.flush();
+    auto result = buffer.str();
+    deflater.close();
+
+    return result;
+  }
+}
+
+mitk::SceneArchiveWriter::SceneArchiveWriter(const std::string &filename, unsigned int numberOfThreads, int compressionLevel)
+  : m_Filename(filename),
+    m_TemporaryFilename(filename + ".tmp"),
+    m_CompressionLevel(std::max(1, std::min(9, compressionLevel))),
+    m_DosTime(0),
+    m_DosDate(0),
+    m_Closed(false),
+    m_NumberOfPendingChunks(0),
+    m_MaximumNumberOfPendingChunks(0),
+    m_StopWorkers(false)
+{
+  // an existing scene file must survive failures while the new one is written
+  m_Stream.open(m_TemporaryFilename, std::ios::binary | std::ios::out | std::ios::trunc);
+  if (!m_Stream.is_open())
+  {
+    mitkThrow() << "Could not open a zip file for writing: '" << m_TemporaryFilename << "'";
+  }
+
+  const auto now = std::time(nullptr);
+  const auto *localTime = std::localtime(&now);
+  if (nullptr != localTime)
+  {
+    m_DosTime = static_cast<std::uint16_t>((localTime->tm_hour << 11) | (localTime->tm_min << 5) | (localTime->tm_sec / 2));
+    m_DosDate = static_cast<std::uint16_t>(((std::max(1980, localTime->tm_year + 1900) - 1980) << 9) | ((localTime->tm_mon + 1) << 5) | localTime->tm_mday);
+  }
+
+  if (0 == numberOfThreads)
+  {
+    numberOfThreads = std::max(1u, std::thread::hardware_concurrency());
+  }
+
+  // Keep all workers busy while the next chunk is read, but limit the memory of compressed chunks that wait to be written.
+  m_MaximumNumberOfPendingChunks = 2 * numberOfThreads;
+
+  this->StartWorkers(numberOfThreads);
+}
+
+mitk::SceneArchiveWriter::~SceneArchiveWriter()
+{
+  this->StopWorkers();
+  this->RemoveTemporaryFile();
+}
+
+void mitk::SceneArchiveWriter::RemoveTemporaryFile()
+{
+  if (m_TemporaryFilename.empty())
+    return;
+
+  if (m_Stream.is_open())
+    m_Stream.close();
+
+  try
+  {
+    Poco::File temporaryFile(m_TemporaryFilename);
+    if (temporaryFile.exists())
+      temporaryFile.remove();
+  }
+  catch (const Poco::Exception &e)
+  {
+    MITK_WARN << "Could not remove temporary zip file '" << m_TemporaryFilename << "': " << e.displayText();
+  }
+
+  m_TemporaryFilename.clear();
+}
+
+void mitk::SceneArchiveWriter::StartWorkers(unsigned int numberOfThreads)
+{
+  for (unsigned int i = 0; i < numberOfThreads; ++i)
+  {
+    m_Workers.emplace_back(&SceneArchiveWriter::WorkerLoop, this);
+  }
+}
+
+void mitk::SceneArchiveWriter::StopWorkers()
+{
+  {
+    std::lock_guard<std::mutex> lock(m_TaskMutex);
+    m_StopWorkers = true;
+  }
+
+  m_TaskCondition.notify_all();
+
+  for (auto &worker : m_Workers)
+  {
+    if (worker.joinable())
+      worker.join();
+  }
+
+  m_Workers.clear();
+  m_Tasks.clear();
+}
+
+void mitk::SceneArchiveWriter::WorkerLoop()
+{
+  while (true)
+  {
+    std::packaged_task<std::string()> task;
+
+    {
+      std::unique_lock<std::mutex> lock(m_TaskMutex);
+      m_TaskCondition.wait(lock, [this]() { return m_StopWorkers || !m_Tasks.empty(); });
+
+      if (m_StopWorkers)
+        return;
+
+      task = std::move(m_Tasks.front());
+      m_Tasks.pop_front();
+    }
+
+    task();
+  }
+}
+
+std::future<std::string> mitk::SceneArchiveWriter::QueueChunk(std::vector<char> &&data, bool isLastChunk)
+{
+  const int compressionLevel = m_CompressionLevel;
+
+  std::packaged_task<std::string()> task([chunk = std::move(data), compressionLevel, isLastChunk]()
+  {
+    return DeflateChunk(chunk, compressionLevel, isLastChunk);
+  });
+
+  auto result = task.get_future();
+
+  {
+    std::lock_guard<std::mutex> lock(m_TaskMutex);
+    m_Tasks.push_back(std::move(task));
+  }
+
+  m_TaskCondition.notify_one();
+
+  return result;
+}
+
+void mitk::SceneArchiveWriter::AddFile(const std::string &path, const std::string &entryName)
+{
+  if (m_Closed)
+  {
+    mitkThrow() << "Cannot add '" << entryName << "' to the already closed zip file '" << m_Filename << "'";
+  }
+
+  std::ifstream file(path, std::ios::binary);
+  if (!file.is_open())
+  {
+    mitkThrow() << "Could not open '" << path << "' for reading";
+  }
+
+  file.seekg(0, std::ios::end);
+  const auto fileSize = static_cast<std::uint64_t>(file.tellg());
+  file.seekg(0, std::ios::beg);
+
+  m_Entries.emplace_back();
+  const std::size_t entryIndex = m_Entries.size() - 1;
+
+  auto &entry = m_Entries.back();
+  entry.Name = entryName;
+  entry.UncompressedSize = fileSize;
+  entry.Zip64 = fileSize >= Zip64SizeThreshold;
+
+  m_PendingItems.push_back({ PendingItem::Type::LocalHeader, entryIndex, {} });
+
+  Poco::Checksum checksum(Poco::Checksum::TYPE_CRC32);
+  std::uint64_t remainingSize = fileSize;
+
+  do
+  {
+    const auto chunkSize = static_cast<std::size_t>(std::min<std::uint64_t>(remainingSize, ChunkSize));
+
+    std::vector<char> chunk(chunkSize);
+    file.read(chunk.data(), chunkSize);
+    if (static_cast<std::size_t>(file.gcount()) != chunkSize)
+    {
+      mitkThrow() << "Error while reading '" << path << "'";
+    }
+
+    checksum.update(chunk.data(), static_cast<unsigned int>(chunkSize));
+    remainingSize -= chunkSize;
+
+    while (m_NumberOfPendingChunks >= m_MaximumNumberOfPendingChunks)
+    {
+      this->WritePendingItems(true);
+    }
+
+    m_PendingItems.push_back({ PendingItem::Type::Chunk, entryIndex, this->QueueChunk(std::move(chunk), 0 == remainingSize) });
+    ++m_NumberOfPendingChunks;
+
+    this->WritePendingItems(false);
+  } while (remainingSize > 0);
+
+  entry.CRC = checksum.checksum();
+  m_PendingItems.push_back({ PendingItem::Type::Finish, entryIndex, {} });
+
+  this->WritePendingItems(false);
+}
+
+void mitk::SceneArchiveWriter::WritePendingItems(bool waitForFirst)
+{
+  while (!m_PendingItems.empty())
+  {
+    auto &item = m_PendingItems.front();
+
+    if (!waitForFirst && PendingItem::Type::Chunk == item.ItemType &&
+        std::future_status::ready != item.Chunk.wait_for(std::chrono::seconds(0)))
+    {
+      break;
+    }
+
+    this->WritePendingItem(item);
+    m_PendingItems.pop_front();
+
+    waitForFirst = false;
+  }
+}
+
+void mitk::SceneArchiveWriter::WritePendingItem(PendingItem &item)
+{
+  auto &entry = m_Entries[item.EntryIndex];
+
+  switch (item.ItemType)
+  {
+    case PendingItem::Type::LocalHeader:
+      this->WriteLocalHeader(entry);
+      break;
+
+    case PendingItem::Type::Chunk:
+    {
+      const auto data = item.Chunk.get();
+      --m_NumberOfPendingChunks;
+
+      m_Stream.write(data.data(), data.size());
+      entry.CompressedSize += data.size();
+      break;
+    }
+
+    case PendingItem::Type::Finish:
+      if (!entry.Zip64 && entry.CompressedSize >= Max32)
+      {
+        mitkThrow() << "Compressed size of '" << entry.Name << "' exceeds the size reserved in the zip file";
+      }
+
+      this->PatchLocalHeader(entry);
+      break;
+  }
+
+  if (!m_Stream.good())
+  {
+    mitkThrow() << "Error while writing zip file '" << m_Filename << "'";
+  }
+}
+
+void mitk::SceneArchiveWriter::WriteLocalHeader(Entry &entry)
+{
+  entry.LocalHeaderOffset = static_cast<std::uint64_t>(m_Stream.tellp());
+
+  // CRC and sizes are patched as soon as the entry is complete
+  WriteUInt32(m_Stream, 0x04034b50);
+  WriteUInt16(m_Stream, entry.Zip64 ? VersionZip64 : VersionDefault);
+  WriteUInt16(m_Stream, 0);
+  WriteUInt16(m_Stream, MethodDeflate);
+  WriteUInt16(m_Stream, m_DosTime);
+  WriteUInt16(m_Stream, m_DosDate);
+  WriteUInt32(m_Stream, 0);
+  WriteUInt32(m_Stream, entry.Zip64 ? Max32 : 0);
+  WriteUInt32(m_Stream, entry.Zip64 ? Max32 : 0);
+  WriteUInt16(m_Stream, static_cast<std::uint16_t>(entry.Name.size()));
+  WriteUInt16(m_Stream, entry.Zip64 ? 20 : 0);
+  m_Stream.write(entry.Name.data(), entry.Name.size());
+
+  if (entry.Zip64)
+  {
+    WriteUInt16(m_Stream, Zip64ExtraFieldId);
+    WriteUInt16(m_Stream, 16);
+    WriteUInt64(m_Stream, 0);
+    WriteUInt64(m_Stream, 0);
+  }
+}
+
+void mitk::SceneArchiveWriter::PatchLocalHeader(const Entry &entry)
+{
+  const auto endPosition = m_Stream.tellp();
+
+  m_Stream.seekp(static_cast<std::streamoff>(entry.LocalHeaderOffset + 14));
+  WriteUInt32(m_Stream, entry.CRC);
+
+  if (entry.Zip64)
+  {
+    m_Stream.seekp(static_cast<std::streamoff>(entry.LocalHeaderOffset + 30 + entry.Name.size() + 4));
+    WriteUInt64(m_Stream, entry.UncompressedSize);
+    WriteUInt64(m_Stream, entry.CompressedSize);
+  }
+  else
+  {
+    WriteUInt32(m_Stream, static_cast<std::uint32_t>(entry.CompressedSize));
+    WriteUInt32(m_Stream, static_cast<std::uint32_t>(entry.UncompressedSize));
+  }
+
+  m_Stream.seekp(endPosition);
+}
+
+void mitk::SceneArchiveWriter::WriteCentralDirectory()
+{
+  const auto centralDirectoryOffset = static_cast<std::uint64_t>(m_Stream.tellp());
+
+  for (const auto &entry : m_Entries)
+  {
+    const bool zip64Offset = entry.LocalHeaderOffset >= Max32;
+
+    std::uint16_t extraFieldSize = 0;
+    if (entry.Zip64)
+      extraFieldSize += 16;
+    if (zip64Offset)
+      extraFieldSize += 8;
+
+    const std::uint16_t version = (entry.Zip64 || zip64Offset) ? VersionZip64 : VersionDefault;
+
+    WriteUInt32(m_Stream, 0x02014b50);
+    WriteUInt16(m_Stream, version);
+    WriteUInt16(m_Stream, version);
+    WriteUInt16(m_Stream, 0);
+    WriteUInt16(m_Stream, MethodDeflate);
+    WriteUInt16(m_Stream, m_DosTime);
+    WriteUInt16(m_Stream, m_DosDate);
+    WriteUInt32(m_Stream, entry.CRC);
+    WriteUInt32(m_Stream, entry.Zip64 ? Max32 : static_cast<std::uint32_t>(entry.CompressedSize));
+    WriteUInt32(m_Stream, entry.Zip64 ? Max32 : static_cast<std::uint32_t>(entry.UncompressedSize));
+    WriteUInt16(m_Stream, static_cast<std::uint16_t>(entry.Name.size()));
+    WriteUInt16(m_Stream, extraFieldSize > 0 ? extraFieldSize + 4 : 0);
+    WriteUInt16(m_Stream, 0);
+    WriteUInt16(m_Stream, 0);
+    WriteUInt16(m_Stream, 0);
+    WriteUInt32(m_Stream, 0);
+    WriteUInt32(m_Stream, zip64Offset ? Max32 : static_cast<std::uint32_t>(entry.LocalHeaderOffset));
+    m_Stream.write(entry.Name.data(), entry.Name.size());
+
+    if (extraFieldSize > 0)
+    {
+      WriteUInt16(m_Stream, Zip64ExtraFieldId);
+      WriteUInt16(m_Stream, extraFieldSize);
+
+      if (entry.Zip64)
+      {
+        WriteUInt64(m_Stream, entry.UncompressedSize);
+        WriteUInt64(m_Stream, entry.CompressedSize);
+      }
+
+      if (zip64Offset)
+        WriteUInt64(m_Stream, entry.LocalHeaderOffset);
+    }
+  }
+
+  const auto endOfCentralDirectoryOffset = static_cast<std::uint64_t>(m_Stream.tellp());
+  const auto centralDirectorySize = endOfCentralDirectoryOffset - centralDirectoryOffset;
+  const auto numberOfEntries = static_cast<std::uint64_t>(m_Entries.size());
+
+  if (numberOfEntries >= Max16 || centralDirectorySize >= Max32 || centralDirectoryOffset >= Max32)
+  {
+    // ZIP64 end of central directory record and locator
+    WriteUInt32(m_Stream, 0x06064b50);
+    WriteUInt64(m_Stream, 44);
+    WriteUInt16(m_Stream, VersionZip64);
+    WriteUInt16(m_Stream, VersionZip64);
+    WriteUInt32(m_Stream, 0);
+    WriteUInt32(m_Stream, 0);
+    WriteUInt64(m_Stream, numberOfEntries);
+    WriteUInt64(m_Stream, numberOfEntries);
+    WriteUInt64(m_Stream, centralDirectorySize);
+    WriteUInt64(m_Stream, centralDirectoryOffset);
+
+    WriteUInt32(m_Stream, 0x07064b50);
+    WriteUInt32(m_Stream, 0);
+    WriteUInt64(m_Stream, endOfCentralDirectoryOffset);
+    WriteUInt32(m_Stream, 1);
+  }
+
+  WriteUInt32(m_Stream, 0x06054b50);
+  WriteUInt16(m_Stream, 0);
+  WriteUInt16(m_Stream, 0);
+  WriteUInt16(m_Stream, static_cast<std::uint16_t>(std::min<std::uint64_t>(numberOfEntries, Max16)));
+  WriteUInt16(m_Stream, static_cast<std::uint16_t>(std::min<std::uint64_t>(numberOfEntries, Max16)));
+  WriteUInt32(m_Stream, Clamp32(centralDirectorySize));
+  WriteUInt32(m_Stream, Clamp32(centralDirectoryOffset));
+  WriteUInt16(m_Stream, 0);
+}
+
+void mitk::SceneArchiveWriter::Close()
+{
+  if (m_Closed)
+    return;
+
+  while (!m_PendingItems.empty())
+  {
+    this->WritePendingItems(true);
+  }
+
+  this->WriteCentralDirectory();
+
+  m_Stream.close();
+  m_Closed = true;
+
+  this->StopWorkers();
+
+  if (m_Stream.fail())
+  {
+    this->RemoveTemporaryFile();
+    mitkThrow() << "Error while writing zip file '" << m_Filename << "'";
+  }
+
+  try
+  {
+    Poco::File(m_TemporaryFilename).renameTo(m_Filename);
+  }
+  catch (const Poco::Exception &e)
+  {
+    this->RemoveTemporaryFile();
+    mitkThrow() << "Could not replace zip file '" << m_Filename << "': " << e.displayText();
+  }
+
+  m_TemporaryFilename.clear();
+}
+
+std::uint64_t mitk::SceneArchiveWriter::GetUncompressedSize() const
+{
+  std::uint64_t size = 0;
+
+  for (const auto &entry : m_Entries)
+    size += entry.UncompressedSize;
+
+  return size;
+}
+
+std::uint64_t mitk::SceneArchiveWriter::GetCompressedSize() const
+{
+  std::uint64_t size = 0;
+
+  for (const auto &entry : m_Entries)
+    size += entry.CompressedSize;
+
+  return size;
+}
@@ -10,14 +10,15 @@ found in the LICENSE file.
 
 ============================================================================*/
 
-#include <Poco/Delegate.h>
+#include <Poco/DirectoryIterator.h>
+#include <Poco/File.h>
 #include <Poco/Path.h>
 #include <Poco/TemporaryFile.h>
-#include <Poco/Zip/Compress.h>
-#include <Poco/Zip/Decompress.h>
 
 #include "mitkBaseDataSerializer.h"
 #include "mitkPropertyListSerializer.h"
+#include "mitkSceneArchiveReader.h"
+#include "mitkSceneArchiveWriter.h"
 #include "mitkSceneIO.h"
 #include "mitkSceneReader.h"
 
@@ -31,7 +32,10 @@ found in the LICENSE file.
 
 #include <itkObjectFactoryBase.h>
 
+#include <chrono>
 #include <fstream>
+#include <map>
+#include <memory>
 #include <mitkIOUtil.h>
 #include <sstream>
 
@@ -39,7 +43,57 @@ found in the LICENSE file.
 
 #include <tinyxml2.h>
 
-mitk::SceneIO::SceneIO() : m_WorkingDirectory(""), m_UnzipErrors(0)
+namespace
+{
+  double SecondsSince(const std::chrono::steady_clock::time_point &start)
+  {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  }
+
+  /**
+    Adds all files of the directory to the archive and removes them. The serializers
+    only write new files, so this is called after each node.
+  */
+  void MoveFilesToArchive(const std::string &directory, const std::string &entryPrefix, mitk::SceneArchiveWriter &writer)
+  {
+    std::vector<Poco::File> files;
+
+    for (Poco::DirectoryIterator iter(directory), end; iter != end; ++iter)
+    {
+      files.push_back(*iter);
+    }
+
+    for (auto &file : files)
+    {
+      const auto entryName = entryPrefix + Poco::Path(file.path()).getFileName();
+
+      if (file.isDirectory())
+      {
+        MoveFilesToArchive(file.path(), entryName + "/", writer);
+      }
+      else
+      {
+        writer.AddFile(Poco::Path::transcode(file.path()), entryName);
+      }
+
+      file.remove(true);
+    }
+  }
+
+  void ClearStorage(mitk::DataStorage *storage)
+  {
+    try
+    {
+      storage->Remove(storage->GetAll());
+    }
+    catch (...)
+    {
+      MITK_ERROR << "DataStorage cannot be cleared properly.";
+    }
+  }
+}
+
+mitk::SceneIO::SceneIO() : m_WorkingDirectory(""), m_UnzipErrors(0), m_NumberOfThreads(0), m_CompressionLevel(6)
 {
 }
 
@@ -110,6 +164,8 @@ mitk::DataStorage::Pointer mitk::SceneIO::LoadScene(const std::string &filename,
     return storage;
   }
 
+  file.close();
+
   // get new temporary directory
   m_WorkingDirectory = CreateEmptyTempDirectory();
   if (m_WorkingDirectory.empty())
@@ -118,30 +174,69 @@ mitk::DataStorage::Pointer mitk::SceneIO::LoadScene(const std::string &filename,
     return storage;
   }
 
-  // unzip all filenames contents to temp dir
+  // transcode locale-dependent string
+  const std::string workingDirectory = Poco::Path::transcode(m_WorkingDirectory);
+
   m_UnzipErrors = 0;
-  Poco::Zip::Decompress unzipper(file, Poco::Path(m_WorkingDirectory));
-  unzipper.EError += Poco::Delegate<SceneIO, std::pair<const Poco::Zip::ZipLocalFileHeader, const std::string>>(
-    this, &SceneIO::OnUnzipError);
-  unzipper.EOk += Poco::Delegate<SceneIO, std::pair<const Poco::Zip::ZipLocalFileHeader, const Poco::Path>>(
-    this, &SceneIO::OnUnzipOk);
-  unzipper.decompressAllFiles();
-  unzipper.EError -= Poco::Delegate<SceneIO, std::pair<const Poco::Zip::ZipLocalFileHeader, const std::string>>(
-    this, &SceneIO::OnUnzipError);
-  unzipper.EOk -= Poco::Delegate<SceneIO, std::pair<const Poco::Zip::ZipLocalFileHeader, const Poco::Path>>(
-    this, &SceneIO::OnUnzipOk);
+  m_Timings.clear();
+
+  const auto start = std::chrono::steady_clock::now();
+
+  try
+  {
+    // Only the zip directory is read here, the entries are extracted when the scene reader requests them.
+    SceneArchiveReader archive(filename, workingDirectory, m_NumberOfThreads);
+
+    const auto index = archive.ReadEntry("index.xml");
+
+    tinyxml2::XMLDocument document;
+    if (tinyxml2::XML_SUCCESS != document.Parse(index.c_str(), index.size()))
+    {
+      MITK_ERROR << "Could not parse index.xml of " << filename << "\nTinyXML reports: " << document.ErrorStr() << std::endl;
+    }
+    else
+    {
+      if (clearStorageFirst)
+        ClearStorage(storage);
+
+      std::map<std::string, std::chrono::steady_clock::time_point> requestTimes;
+
+      SceneReader::Pointer reader = SceneReader::New();
+      reader->SetFileCallbacks(
+        [&archive, &requestTimes](const std::string &sceneFile)
+        {
+          requestTimes[sceneFile] = std::chrono::steady_clock::now();
+          archive.RequestEntry(sceneFile);
+        },
+        [&archive, &requestTimes, this](const std::string &sceneFile)
+        {
+          archive.ReleaseEntry(sceneFile);
+
+          const auto seconds = SecondsSince(requestTimes[sceneFile]);
+          m_Timings.emplace_back(sceneFile, seconds);
+          MITK_DEBUG << "Loaded " << sceneFile << " in " << seconds << " s";
+        });
+
+      if (!reader->LoadScene(document, workingDirectory, storage))
+      {
+        MITK_ERROR << "There were errors while loading scene file " << filename << ". Your data may be corrupted";
+      }
+    }
+
+    m_UnzipErrors = archive.GetNumberOfErrors();
+  }
+  catch (std::exception &e)
+  {
+    MITK_ERROR << "Could not load scene file '" << filename << "'\nReason: " << e.what();
+  }
 
   if (m_UnzipErrors)
   {
     MITK_ERROR << "There were " << m_UnzipErrors << " errors unzipping '" << filename
-               << "'. Will attempt to read whatever could be unzipped.";
+               << "'. The loaded scene contains whatever could be unzipped.";
   }
 
-  // transcode locale-dependent string
-  m_WorkingDirectory = Poco::Path::transcode (m_WorkingDirectory);
-
-  auto indexFile = m_WorkingDirectory + mitk::IOUtil::GetDirectorySeparator() + "index.xml";
-  storage = LoadSceneUnzipped(indexFile, storage, clearStorageFirst);
+  MITK_INFO << "Loaded scene " << filename << " in " << SecondsSince(start) << " s";
 
   // delete temp directory
   try
@@ -173,14 +268,7 @@ mitk::DataStorage::Pointer mitk::SceneIO::LoadSceneUnzipped(const std::string &i
 
   if (clearStorageFirst)
   {
-    try
-    {
-      storage->Remove(storage->GetAll());
-    }
-    catch (...)
-    {
-      MITK_ERROR << "DataStorage cannot be cleared properly.";
-    }
+    ClearStorage(storage);
   }
 
   // test input filename
@@ -239,10 +327,39 @@ bool mitk::SceneIO::SaveScene(DataStorage::SetOfObjects::ConstPointer sceneNodes
 
   mitk::LocaleSwitch localeSwitch("C");
 
+  // The archive is written while the nodes are serialized, see MoveFilesToArchive()
+  std::unique_ptr<SceneArchiveWriter> archive;
+  const auto start = std::chrono::steady_clock::now();
+
+  auto removeWorkingDirectory = [this]()
+  {
+    try
+    {
+      Poco::File deleteDir(m_WorkingDirectory);
+      deleteDir.remove(true); // recursive
+    }
+    catch (...)
+    {
+      MITK_ERROR << "Could not delete temporary directory " << m_WorkingDirectory;
+      return false;
+    }
+    return true;
+  };
+
   try
   {
     m_FailedNodes = DataStorage::SetOfObjects::New();
     m_FailedProperties = PropertyList::New();
+    m_Timings.clear();
+
+    m_WorkingDirectory = CreateEmptyTempDirectory();
+    if (m_WorkingDirectory.empty())
+    {
+      MITK_ERROR << "Could not create temporary directory. Cannot create scene files.";
+      return false;
+    }
+
+    archive = std::make_unique<SceneArchiveWriter>(filename, m_NumberOfThreads, m_CompressionLevel);
 
     // start XML DOM
     tinyxml2::XMLDocument document;
@@ -269,13 +386,6 @@ bool mitk::SceneIO::SaveScene(DataStorage::SetOfObjects::ConstPointer sceneNodes
 
       MITK_INFO << "Storing scene with " << sceneNodes->size() << " objects to " << filename;
 
-      m_WorkingDirectory = CreateEmptyTempDirectory();
-      if (m_WorkingDirectory.empty())
-      {
-        MITK_ERROR << "Could not create temporary directory. Cannot create scene files.";
-        return false;
-      }
-
       ProgressBar::GetInstance()->AddStepsToDo(sceneNodes->size());
 
       // find out about dependencies
@@ -325,6 +435,8 @@ bool mitk::SceneIO::SaveScene(DataStorage::SetOfObjects::ConstPointer sceneNodes
 
         if (node)
         {
+          const auto nodeStart = std::chrono::steady_clock::now();
+
           auto *nodeElement = document.NewElement("node");
           std::string filenameHint(node->GetName());
           filenameHint = itksys::SystemTools::MakeCindentifier(
@@ -398,6 +510,13 @@ bool mitk::SceneIO::SaveScene(DataStorage::SetOfObjects::ConstPointer sceneNodes
             nodeElement->InsertEndChild(propertiesElement);
           }
           document.InsertEndChild(nodeElement);
+
+          // compress the files of this node while the next one is serialized
+          MoveFilesToArchive(m_WorkingDirectory, "", *archive);
+
+          const auto seconds = SecondsSince(nodeStart);
+          m_Timings.emplace_back(node->GetName(), seconds);
+          MITK_DEBUG << "Saved node " << node->GetName() << " in " << seconds << " s";
         }
         else
         {
@@ -415,54 +534,34 @@ bool mitk::SceneIO::SaveScene(DataStorage::SetOfObjects::ConstPointer sceneNodes
     {
       MITK_ERROR << "Could not write scene to " << defaultLocale_WorkingDirectory << Poco::Path::separator() << "index.xml"
                  << "\nTinyXML reports '" << document.ErrorStr() << "'";
+      archive.reset();
+      removeWorkingDirectory();
       return false;
     }
-    else
-    {
-      try
-      {
-        Poco::File deleteFile(filename.c_str());
-        if (deleteFile.exists())
-        {
-          deleteFile.remove();
-        }
 
-        // create zip at filename
-        std::ofstream file(filename.c_str(), std::ios::binary | std::ios::out);
-        if (!file.good())
-        {
-          MITK_ERROR << "Could not open a zip file for writing: '" << filename << "'";
-          return false;
-        }
-        else
-        {
-          Poco::Zip::Compress zipper(file, true);
-          Poco::Path tmpdir(m_WorkingDirectory);
-          zipper.addRecursive(tmpdir);
-          zipper.close();
-        }
-        try
-        {
-          Poco::File deleteDir(m_WorkingDirectory);
-          deleteDir.remove(true); // recursive
-        }
-        catch (...)
-        {
-          MITK_ERROR << "Could not delete temporary directory " << m_WorkingDirectory;
-          return false; // ok?
-        }
-      }
-      catch (std::exception &e)
-      {
-        MITK_ERROR << "Could not create ZIP file from " << m_WorkingDirectory << "\nReason: " << e.what();
-        return false;
-      }
-      return true;
+    try
+    {
+      MoveFilesToArchive(m_WorkingDirectory, "", *archive);
+      archive->Close();
+    }
+    catch (std::exception &e)
+    {
+      MITK_ERROR << "Could not create ZIP file from " << m_WorkingDirectory << "\nReason: " << e.what();
+      archive.reset();
+      removeWorkingDirectory();
+      return false;
     }
+
+    MITK_INFO << "Stored scene in " << SecondsSince(start) << " s (" << archive->GetUncompressedSize()
+              << " bytes compressed to " << archive->GetCompressedSize() << " bytes)";
+
+    return removeWorkingDirectory();
   }
   catch (std::exception &e)
   {
     MITK_ERROR << "Caught exception during saving temporary files to disk. Error description: '" << e.what() << "'";
+    archive.reset();
+    removeWorkingDirectory();
     return false;
   }
 }
@@ -564,15 +663,7 @@ const mitk::PropertyList *mitk::SceneIO::GetFailedProperties()
   return m_FailedProperties;
 }
 
-void mitk::SceneIO::OnUnzipError(const void * /*pSender*/,
-                                 std::pair<const Poco::Zip::ZipLocalFileHeader, const std::string> &info)
-{
-  ++m_UnzipErrors;
-  MITK_ERROR << "Error while unzipping: " << info.second;
-}
-
-void mitk::SceneIO::OnUnzipOk(const void * /*pSender*/,
-                              std::pair<const Poco::Zip::ZipLocalFileHeader, const Poco::Path> & /*info*/)
+const mitk::SceneIO::TimingListType &mitk::SceneIO::GetTimings() const
 {
-  // MITK_INFO << "Unzipped ok: " << info.second.toString();
+  return m_Timings;
 }
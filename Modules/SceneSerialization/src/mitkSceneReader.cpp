@@ -46,6 +46,8 @@ bool mitk::SceneReader::LoadScene(tinyxml2::XMLDocument &document, const std::st
   {
     if (auto *reader = dynamic_cast<SceneReader *>(iter->GetPointer()))
     {
+      reader->SetFileCallbacks(m_RequestFileCallback, m_ReleaseFileCallback);
+
       if (!reader->LoadScene(document, workingDirectory, storage))
       {
         MITK_ERROR << "There were errors while loading scene file "
@@ -60,3 +62,21 @@ bool mitk::SceneReader::LoadScene(tinyxml2::XMLDocument &document, const std::st
   }
   return false;
 }
+
+void mitk::SceneReader::SetFileCallbacks(const FileCallback &requestFile, const FileCallback &releaseFile)
+{
+  m_RequestFileCallback = requestFile;
+  m_ReleaseFileCallback = releaseFile;
+}
+
+void mitk::SceneReader::RequestFile(const std::string &filename) const
+{
+  if (m_RequestFileCallback)
+    m_RequestFileCallback(filename);
+}
+
+void mitk::SceneReader::ReleaseFile(const std::string &filename) const
+{
+  if (m_ReleaseFileCallback)
+    m_ReleaseFileCallback(filename);
+}
@@ -140,7 +140,16 @@ bool mitk::SceneReaderV1::LoadScene(tinyxml2::XMLDocument &document, const std::
 
     if (dataElement != nullptr)
     {
-      auto properties = DeserializeProperties(dataElement->FirstChildElement("properties"), workingDirectory);
+      const auto *propertiesElement = dataElement->FirstChildElement("properties");
+      const char *propertiesFile = propertiesElement != nullptr ? propertiesElement->Attribute("file") : nullptr;
+
+      if (propertiesFile != nullptr)
+        this->RequestFile(propertiesFile);
+
+      auto properties = DeserializeProperties(propertiesElement, workingDirectory);
+
+      if (propertiesFile != nullptr)
+        this->ReleaseFile(propertiesFile);
 
       if (properties.IsNotNull())
         baseDataPropertyLists[uid] = properties;
@@ -332,6 +341,8 @@ mitk::DataNode::Pointer mitk::SceneReaderV1::LoadBaseDataFromDataTag(const tinyx
     const char *filename = dataElement->Attribute("file");
     if (filename && strlen(filename) != 0)
     {
+      this->RequestFile(filename);
+
       try
       {
         auto baseData = IOUtil::Load(workingDirectory + Poco::Path::separator() + filename, properties);
@@ -345,6 +356,8 @@ mitk::DataNode::Pointer mitk::SceneReaderV1::LoadBaseDataFromDataTag(const tinyx
         error = true;
       }
 
+      this->ReleaseFile(filename);
+
       if (node.IsNull())
       {
         MITK_ERROR << "Error during attempt to read '" << filename << "'. Factory returned nullptr object.";
@@ -448,7 +461,9 @@ bool mitk::SceneReaderV1::DecorateNodeWithProperties(DataNode *node,
     PropertyListDeserializer::Pointer deserializer = PropertyListDeserializer::New();
 
     deserializer->SetFilename(workingDirectory + Poco::Path::separator() + propertiesfile);
+    this->RequestFile(propertiesfile);
     bool success = deserializer->Deserialize();
+    this->ReleaseFile(propertiesfile);
     error |= !success;
     PropertyList::Pointer readProperties = deserializer->GetOutput();
 
@@ -1,4 +1,5 @@
 set(MODULE_TESTS
+  mitkSceneArchiveTest.cpp
   mitkSceneIOTest2.cpp
 )
 
@@ -0,0 +1,152 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+// Testing
+#include "mitkTestFixture.h"
+#include "mitkTestingMacros.h"
+
+// MITK includes
+#include <mitkExceptionMacro.h>
+#include <mitkIOUtil.h>
+#include <mitkSceneArchiveReader.h>
+#include <mitkSceneArchiveWriter.h>
+
+#include <itksys/SystemTools.hxx>
+
+// std includes
+#include <fstream>
+#include <sstream>
+
+class mitkSceneArchiveTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkSceneArchiveTestSuite);
+  MITK_TEST(Close_WritesReadableArchive);
+  MITK_TEST(Close_ManyEntries_WritesZip64Directory);
+  MITK_TEST(Failure_KeepsExistingArchive);
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+  std::string m_TempDirectory;
+  std::string m_ArchiveFilename;
+
+  std::string WriteFile(const std::string &name, const std::string &content) const
+  {
+    const auto path = m_TempDirectory + "/" + name;
+    std::ofstream stream(path, std::ios::binary);
+    stream << content;
+    return path;
+  }
+
+  static std::string ReadFile(const std::string &path)
+  {
+    std::ifstream stream(path, std::ios::binary);
+    std::ostringstream content;
+    content << stream.rdbuf();
+    return content.str();
+  }
+
+public:
+  void setUp() override
+  {
+    m_TempDirectory = mitk::IOUtil::CreateTemporaryDirectory("SceneArchiveTest_XXXXXX");
+    m_ArchiveFilename = m_TempDirectory + "/scene.mitk";
+  }
+
+  void tearDown() override
+  {
+    itksys::SystemTools::RemoveADirectory(m_TempDirectory);
+  }
+
+  void Close_WritesReadableArchive()
+  {
+    // several chunks of 4 MB
+    std::string largeContent(9 * 1024 * 1024 + 17, '\0');
+    for (std::size_t i = 0; i < largeContent.size(); ++i)
+      largeContent[i] = static_cast<char>((i * 7919) % 251);
+
+    const auto largeFile = this->WriteFile("large.raw", largeContent);
+    const auto smallFile = this->WriteFile("index.xml", "<Version FileVersion=\"1\"/>");
+
+    {
+      mitk::SceneArchiveWriter writer(m_ArchiveFilename, 3, 1);
+      writer.AddFile(largeFile, "large.raw");
+      writer.AddFile(smallFile, "index.xml");
+      writer.Close();
+
+      CPPUNIT_ASSERT_EQUAL(static_cast<std::uint64_t>(largeContent.size() + 26), writer.GetUncompressedSize());
+    }
+
+    CPPUNIT_ASSERT(!itksys::SystemTools::FileExists(m_ArchiveFilename + ".tmp"));
+
+    mitk::SceneArchiveReader reader(m_ArchiveFilename, m_TempDirectory + "/extracted", 2);
+    CPPUNIT_ASSERT(reader.HasEntry("large.raw"));
+    CPPUNIT_ASSERT(largeContent == reader.ReadEntry("large.raw"));
+    CPPUNIT_ASSERT_EQUAL(std::string("<Version FileVersion=\"1\"/>"), reader.ReadEntry("index.xml"));
+  }
+
+  void Close_ManyEntries_WritesZip64Directory()
+  {
+    // more entries than the classic end of central directory record can count
+    const unsigned int numberOfEntries = 65540;
+    const auto file = this->WriteFile("entry.txt", "entry");
+
+    {
+      mitk::SceneArchiveWriter writer(m_ArchiveFilename, 2, 1);
+
+      for (unsigned int i = 0; i < numberOfEntries; ++i)
+        writer.AddFile(file, "entry" + std::to_string(i) + ".txt");
+
+      writer.Close();
+    }
+
+    mitk::SceneArchiveReader reader(m_ArchiveFilename, m_TempDirectory + "/extracted", 2);
+    CPPUNIT_ASSERT(reader.HasEntry("entry0.txt"));
+    CPPUNIT_ASSERT(reader.HasEntry("entry65535.txt"));
+    CPPUNIT_ASSERT(reader.HasEntry("entry" + std::to_string(numberOfEntries - 1) + ".txt"));
+    CPPUNIT_ASSERT_EQUAL(std::string("entry"), reader.ReadEntry("entry" + std::to_string(numberOfEntries - 1) + ".txt"));
+  }
+
+  void Failure_KeepsExistingArchive()
+  {
+    const std::string existingContent = "existing scene";
+    this->WriteFile("scene.mitk", existingContent);
+    const auto file = this->WriteFile("data.txt", "data");
+
+    // destroyed without Close(), e.g. because serializing a node threw
+    {
+      mitk::SceneArchiveWriter writer(m_ArchiveFilename, 2, 1);
+      writer.AddFile(file, "data.txt");
+    }
+
+    CPPUNIT_ASSERT_EQUAL(existingContent, ReadFile(m_ArchiveFilename));
+    CPPUNIT_ASSERT(!itksys::SystemTools::FileExists(m_ArchiveFilename + ".tmp"));
+
+    {
+      mitk::SceneArchiveWriter writer(m_ArchiveFilename, 2, 1);
+      CPPUNIT_ASSERT_THROW(writer.AddFile(m_TempDirectory + "/missing.txt", "missing.txt"), mitk::Exception);
+    }
+
+    CPPUNIT_ASSERT_EQUAL(existingContent, ReadFile(m_ArchiveFilename));
+
+    // a successful write replaces the file
+    {
+      mitk::SceneArchiveWriter writer(m_ArchiveFilename, 2, 1);
+      writer.AddFile(file, "data.txt");
+      writer.Close();
+    }
+
+    mitk::SceneArchiveReader reader(m_ArchiveFilename, m_TempDirectory + "/extracted", 1);
+    CPPUNIT_ASSERT_EQUAL(std::string("data"), reader.ReadEntry("data.txt"));
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkSceneArchive)
@@ -16,8 +16,17 @@ found in the LICENSE file.
 
 #include "mitkDataStorageCompare.h"
 #include "mitkIOUtil.h"
+#include "mitkImageGenerator.h"
 #include "mitkSceneIO.h"
 #include "mitkSceneIOTestScenarioProvider.h"
+#include "mitkStandaloneDataStorage.h"
+
+#include <Poco/Zip/Decompress.h>
+
+#include <itksys/SystemTools.hxx>
+
+#include <fstream>
+#include <vector>
 
 /**
   \brief Test cases for SceneIO.
@@ -78,15 +87,33 @@ class mitkSceneIOTest2Suite : public mitk::TestFixture
   CPPUNIT_TEST_SUITE(mitkSceneIOTest2Suite);
   MITK_TEST(Test_SceneIOInterfaces);
   MITK_TEST(Test_ReconstructionOfScenes);
+  MITK_TEST(Test_ParallelCompressionOfLargeData);
   CPPUNIT_TEST_SUITE_END();
 
   mitk::SceneIOTestScenarioProvider m_TestCaseProvider;
 
+  /** Removed by tearDown().*/
+  std::vector<std::string> m_TempDirectories;
+
+  std::string CreateTemporaryDirectory(const std::string &templateName)
+  {
+    m_TempDirectories.push_back(mitk::IOUtil::CreateTemporaryDirectory(templateName));
+    return m_TempDirectories.back();
+  }
+
 public:
+  void tearDown() override
+  {
+    for (const auto &directory : m_TempDirectories)
+      itksys::SystemTools::RemoveADirectory(directory);
+
+    m_TempDirectories.clear();
+  }
+
   void Test_SceneIOInterfaces() { CPPUNIT_ASSERT_MESSAGE("Not urgent", true); }
   void Test_ReconstructionOfScenes()
   {
-    std::string tempDir = mitk::IOUtil::CreateTemporaryDirectory("SceneIOTest_XXXXXX");
+    std::string tempDir = this->CreateTemporaryDirectory("SceneIOTest_XXXXXX");
 
     mitk::SceneIOTestScenarioProvider::ScenarioList scenarios = m_TestCaseProvider.GetAllScenarios();
     MITK_TEST_OUTPUT(<< "Executing " << scenarios.size() << " test scenarios");
@@ -125,6 +152,56 @@ public:
     }
   }
 
+  void Test_ParallelCompressionOfLargeData()
+  {
+    std::string tempDir = this->CreateTemporaryDirectory("SceneIOTest_XXXXXX");
+    std::string archiveFilename = mitk::IOUtil::CreateTemporaryFile("scene_XXXXXX.mitk", tempDir);
+
+    // large enough to be compressed in several chunks
+    auto largeImage = mitk::ImageGenerator::GenerateRandomImage<short>(256, 256, 128);
+    auto smallImage = mitk::ImageGenerator::GenerateRandomImage<unsigned char>(10, 10, 10);
+
+    auto originalStorage = mitk::StandaloneDataStorage::New();
+
+    auto largeNode = mitk::DataNode::New();
+    largeNode->SetName("large");
+    largeNode->SetData(largeImage);
+    originalStorage->Add(largeNode);
+
+    auto smallNode = mitk::DataNode::New();
+    smallNode->SetName("small");
+    smallNode->SetData(smallImage);
+    originalStorage->Add(smallNode, largeNode);
+
+    mitk::SceneIO::Pointer writer = mitk::SceneIO::New();
+    writer->SetNumberOfThreads(4);
+    writer->SetCompressionLevel(1);
+    CPPUNIT_ASSERT(writer->SaveScene(originalStorage->GetAll(), originalStorage, archiveFilename));
+    CPPUNIT_ASSERT_EQUAL(std::size_t(2), writer->GetTimings().size());
+
+    mitk::SceneIO::Pointer reader = mitk::SceneIO::New();
+    reader->SetNumberOfThreads(2);
+    mitk::DataStorage::Pointer restoredStorage;
+    CPPUNIT_ASSERT_NO_THROW(restoredStorage = reader->LoadScene(archiveFilename));
+    CPPUNIT_ASSERT(!reader->GetTimings().empty());
+
+    CPPUNIT_ASSERT_MESSAGE("Comparing restored scene",
+                           mitk::DataStorageCompare(originalStorage,
+                                                    restoredStorage,
+                                                    mitk::DataStorageCompare::CMP_Hierarchy |
+                                                      mitk::DataStorageCompare::CMP_Data |
+                                                      mitk::DataStorageCompare::CMP_Properties)
+                             .CompareVerbose());
+
+    // the scene file has to stay readable by standard zip implementations
+    std::string extractDir = this->CreateTemporaryDirectory("SceneIOTestExtract_XXXXXX");
+    std::ifstream archive(archiveFilename, std::ios::binary);
+    Poco::Zip::Decompress unzipper(archive, Poco::Path(extractDir));
+    Poco::Zip::ZipArchive extractedArchive = unzipper.decompressAllFiles();
+    CPPUNIT_ASSERT(extractedArchive.findHeader("index.xml") != extractedArchive.headersEnd());
+    CPPUNIT_ASSERT(std::ifstream(extractDir + "/index.xml").good());
+  }
+
 }; // class
 
 int mitkSceneIOTest2(int /*argc*/, char * /*argv*/ [])
@@ -0,0 +1,360 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkAlignedSliceMapping.h"
+
+#include <mitkAbstractTransformGeometry.h>
+#include <mitkExceptionMacro.h>
+#include <mitkExtractSliceFilter.h>
+#include <mitkImageReadAccessor.h>
+#include <mitkImageWriteAccessor.h>
+
+#include <cmath>
+#include <cstring>
+
+namespace
+{
+  /** Maximum deviation (in voxels) of the slice pixels from the voxel centers. */
+  constexpr double Tolerance = 1e-3;
+
+  bool IsUnitStep(const itk::Offset<3> &offset)
+  {
+    unsigned int numberOfUnitComponents = 0;
+
+    for (unsigned int i = 0; i < 3; ++i)
+    {
+      if (std::abs(offset[i]) == 1)
+        ++numberOfUnitComponents;
+      else if (offset[i] != 0)
+        return false;
+    }
+
+    return numberOfUnitComponents == 1;
+  }
+
+  mitk::Image::Pointer CreateRegionImage(const mitk::PixelType &pixelType, const itk::ImageRegion<2> &region)
+  {
+    unsigned int dimensions[2] = {static_cast<unsigned int>(region.GetSize(0)),
+                                  static_cast<unsigned int>(region.GetSize(1))};
+
+    auto image = mitk::Image::New();
+    image->Initialize(pixelType, 2, dimensions);
+    return image;
+  }
+
+  void CheckRegionImage(const mitk::Image *regionImage, const mitk::PixelType &pixelType, const itk::ImageRegion<2> &region)
+  {
+    if (nullptr == regionImage)
+      mitkThrow() << "Region image is missing.";
+
+    if (regionImage->GetPixelType() != pixelType)
+      mitkThrow() << "Pixel type of the region image does not match.";
+
+    if (regionImage->GetDimension(0) != region.GetSize(0) || regionImage->GetDimension(1) != region.GetSize(1))
+      mitkThrow() << "Size of the region image does not match the region " << region.GetIndex() << " + "
+                  << region.GetSize() << ".";
+  }
+
+  itk::ImageRegion<2> GetLargestPossibleSliceRegion(const mitk::Image *slice)
+  {
+    itk::ImageRegion<2> sliceRegion;
+    sliceRegion.SetSize(0, slice->GetDimension(0));
+    sliceRegion.SetSize(1, slice->GetDimension(1));
+    return sliceRegion;
+  }
+
+  /** Offset (in bytes) of the first pixel of the given row of the region in the buffer of a 2D slice. */
+  std::size_t GetSliceRowOffset(const mitk::Image *slice, const itk::ImageRegion<2> &region, itk::SizeValueType row)
+  {
+    const auto sliceWidth = static_cast<std::size_t>(slice->GetDimension(0));
+    const auto y = static_cast<std::size_t>(region.GetIndex(1)) + row;
+
+    return (y * sliceWidth + static_cast<std::size_t>(region.GetIndex(0))) * slice->GetPixelType().GetSize();
+  }
+
+  void CheckSlice(const mitk::Image *slice, const itk::ImageRegion<2> &region)
+  {
+    if (nullptr == slice || slice->GetDimension() < 2 ||
+        (slice->GetDimension() > 2 && slice->GetDimension(2) != 1))
+      mitkThrow() << "Invalid slice, a 2D image is required.";
+
+    if (!GetLargestPossibleSliceRegion(slice).IsInside(region))
+      mitkThrow() << "Region " << region.GetIndex() << " + " << region.GetSize() << " is not inside of the slice.";
+  }
+}
+
+mitk::AlignedSliceMapping::AlignedSliceMapping()
+  : m_IsValid(false),
+    m_TimeStep(0)
+{
+  m_Origin.Fill(0);
+  m_Axis0.Fill(0);
+  m_Axis1.Fill(0);
+  m_VolumeSize.Fill(0);
+}
+
+mitk::AlignedSliceMapping mitk::AlignedSliceMapping::Compute(const Image *volume,
+                                                             const PlaneGeometry *plane,
+                                                             TimeStepType timeStep)
+{
+  AlignedSliceMapping mapping;
+
+  if (nullptr == volume || nullptr == plane || volume->GetDimension() < 3 ||
+      !volume->GetTimeGeometry()->IsValidTimeStep(timeStep))
+    return mapping;
+
+  if (nullptr != dynamic_cast<const AbstractTransformGeometry *>(plane))
+    return mapping;
+
+  // Let the slice filter determine the geometry of the slice exactly as for extracting or
+  // overwriting it. Only the output information is needed, nothing is resliced.
+  auto extractor = ExtractSliceFilter::New();
+  extractor->SetInput(volume);
+  extractor->SetTimeStep(timeStep);
+  extractor->SetWorldGeometry(plane);
+  extractor->SetResliceTransformByGeometry(volume->GetTimeGeometry()->GetGeometryForTimeStep(timeStep));
+  extractor->UpdateOutputInformation();
+
+  const auto slice = extractor->GetOutput();
+
+  if (!slice->IsInitialized() || slice->GetDimension() < 2)
+    return mapping;
+
+  const auto *sliceGeometry = slice->GetGeometry();
+  const auto volumeGeometry = volume->GetTimeGeometry()->GetGeometryForTimeStep(timeStep);
+  const auto width = slice->GetDimension(0);
+  const auto height = slice->GetDimension(1);
+
+  auto toVolumeIndex = [&](double i, double j) {
+    Point3D sliceIndex, world, volumeIndex;
+    sliceIndex[0] = i;
+    sliceIndex[1] = j;
+    sliceIndex[2] = 0.0;
+    sliceGeometry->IndexToWorld(sliceIndex, world);
+    volumeGeometry->WorldToIndex(world, volumeIndex);
+    return volumeIndex;
+  };
+
+  const auto origin = toVolumeIndex(0.0, 0.0);
+  const auto originPlusAxis0 = toVolumeIndex(1.0, 0.0);
+  const auto originPlusAxis1 = toVolumeIndex(0.0, 1.0);
+
+  for (unsigned int i = 0; i < 3; ++i)
+  {
+    mapping.m_Origin[i] = std::lround(origin[i]);
+    mapping.m_Axis0[i] = std::lround(originPlusAxis0[i] - origin[i]);
+    mapping.m_Axis1[i] = std::lround(originPlusAxis1[i] - origin[i]);
+
+    if (std::abs(originPlusAxis0[i] - origin[i] - mapping.m_Axis0[i]) > Tolerance ||
+        std::abs(originPlusAxis1[i] - origin[i] - mapping.m_Axis1[i]) > Tolerance)
+      return mapping;
+  }
+
+  if (!IsUnitStep(mapping.m_Axis0) || !IsUnitStep(mapping.m_Axis1))
+    return mapping;
+
+  for (unsigned int i = 0; i < 3; ++i)
+  {
+    if (mapping.m_Axis0[i] != 0 && mapping.m_Axis1[i] != 0)
+      return mapping;
+
+    mapping.m_VolumeSize[i] = volume->GetDimension(i);
+  }
+
+  // The mapping is affine, so if the corners of the slice hit voxel centers and lie inside of
+  // the volume, all pixels do. Nearest neighbor reslicing then addresses exactly these voxels.
+  for (const auto j : {0u, height - 1})
+  {
+    for (const auto i : {0u, width - 1})
+    {
+      RegionType::IndexType sliceIndex;
+      sliceIndex[0] = i;
+      sliceIndex[1] = j;
+
+      const auto expected = mapping.GetVolumeIndex(sliceIndex);
+      const auto actual = toVolumeIndex(i, j);
+
+      for (unsigned int k = 0; k < 3; ++k)
+      {
+        if (std::abs(actual[k] - expected[k]) > Tolerance || expected[k] < 0 ||
+            expected[k] >= static_cast<itk::IndexValueType>(mapping.m_VolumeSize[k]))
+          return mapping;
+      }
+    }
+  }
+
+  mapping.m_SliceRegion.SetSize(0, width);
+  mapping.m_SliceRegion.SetSize(1, height);
+  mapping.m_TimeStep = timeStep;
+  mapping.m_IsValid = true;
+
+  return mapping;
+}
+
+bool mitk::AlignedSliceMapping::IsValid() const
+{
+  return m_IsValid;
+}
+
+const mitk::AlignedSliceMapping::RegionType &mitk::AlignedSliceMapping::GetSliceRegion() const
+{
+  return m_SliceRegion;
+}
+
+mitk::TimeStepType mitk::AlignedSliceMapping::GetTimeStep() const
+{
+  return m_TimeStep;
+}
+
+const mitk::AlignedSliceMapping::VolumeIndexType &mitk::AlignedSliceMapping::GetOrigin() const
+{
+  return m_Origin;
+}
+
+const mitk::AlignedSliceMapping::VolumeOffsetType &mitk::AlignedSliceMapping::GetAxis0() const
+{
+  return m_Axis0;
+}
+
+const mitk::AlignedSliceMapping::VolumeOffsetType &mitk::AlignedSliceMapping::GetAxis1() const
+{
+  return m_Axis1;
+}
+
+mitk::AlignedSliceMapping::VolumeIndexType mitk::AlignedSliceMapping::GetVolumeIndex(
+  const RegionType::IndexType &sliceIndex) const
+{
+  VolumeIndexType volumeIndex;
+
+  for (unsigned int i = 0; i < 3; ++i)
+    volumeIndex[i] = m_Origin[i] + m_Axis0[i] * sliceIndex[0] + m_Axis1[i] * sliceIndex[1];
+
+  return volumeIndex;
+}
+
+void mitk::AlignedSliceMapping::CheckVolume(const Image *volume, const RegionType &region) const
+{
+  if (!m_IsValid)
+    mitkThrow() << "Invalid slice mapping.";
+
+  if (nullptr == volume || volume->GetDimension() < 3 || volume->GetDimension(0) != m_VolumeSize[0] ||
+      volume->GetDimension(1) != m_VolumeSize[1] || volume->GetDimension(2) != m_VolumeSize[2] ||
+      m_TimeStep >= volume->GetTimeSteps())
+    mitkThrow() << "Volume does not match the slice mapping.";
+
+  if (!m_SliceRegion.IsInside(region))
+    mitkThrow() << "Region " << region.GetIndex() << " + " << region.GetSize() << " is not inside of the slice.";
+}
+
+template <typename TFunction>
+void mitk::AlignedSliceMapping::ForEachRow(const RegionType &region, TFunction copyRow) const
+{
+  const auto sliceStride = static_cast<itk::OffsetValueType>(m_VolumeSize[0]);
+  const auto volumeStride = m_Axis0[0] + m_Axis0[1] * sliceStride + m_Axis0[2] * sliceStride * static_cast<itk::OffsetValueType>(m_VolumeSize[1]);
+
+  RegionType::IndexType sliceIndex = region.GetIndex();
+
+  for (itk::SizeValueType y = 0; y < region.GetSize(1); ++y, ++sliceIndex[1])
+  {
+    const auto volumeIndex = this->GetVolumeIndex(sliceIndex);
+    const auto volumeOffset = volumeIndex[0] + (volumeIndex[1] + volumeIndex[2] * static_cast<itk::OffsetValueType>(m_VolumeSize[1])) * sliceStride;
+
+    copyRow(volumeOffset, volumeStride, y * region.GetSize(0), region.GetSize(0));
+  }
+}
+
+mitk::Image::Pointer mitk::AlignedSliceMapping::ReadRegion(const Image *volume, const RegionType &region) const
+{
+  this->CheckVolume(volume, region);
+
+  auto regionImage = CreateRegionImage(volume->GetPixelType(), region);
+  const auto pixelSize = volume->GetPixelType().GetSize();
+
+  ImageReadAccessor volumeAccessor(volume, volume->GetVolumeData(m_TimeStep));
+  ImageWriteAccessor regionAccessor(regionImage);
+
+  const auto *volumeData = static_cast<const char *>(volumeAccessor.GetData());
+  auto *regionData = static_cast<char *>(regionAccessor.GetData());
+
+  this->ForEachRow(region, [&](itk::OffsetValueType volumeOffset, itk::OffsetValueType volumeStride, std::size_t regionOffset, std::size_t length) {
+    if (volumeStride == 1)
+    {
+      std::memcpy(regionData + regionOffset * pixelSize, volumeData + volumeOffset * pixelSize, length * pixelSize);
+      return;
+    }
+
+    for (std::size_t i = 0; i < length; ++i, volumeOffset += volumeStride)
+      std::memcpy(regionData + (regionOffset + i) * pixelSize, volumeData + volumeOffset * pixelSize, pixelSize);
+  });
+
+  return regionImage;
+}
+
+void mitk::AlignedSliceMapping::WriteRegion(Image *volume, const Image *regionImage, const RegionType &region) const
+{
+  this->CheckVolume(volume, region);
+  CheckRegionImage(regionImage, volume->GetPixelType(), region);
+
+  const auto pixelSize = volume->GetPixelType().GetSize();
+
+  ImageWriteAccessor volumeAccessor(volume, volume->GetVolumeData(m_TimeStep));
+  ImageReadAccessor regionAccessor(regionImage);
+
+  auto *volumeData = static_cast<char *>(volumeAccessor.GetData());
+  const auto *regionData = static_cast<const char *>(regionAccessor.GetData());
+
+  this->ForEachRow(region, [&](itk::OffsetValueType volumeOffset, itk::OffsetValueType volumeStride, std::size_t regionOffset, std::size_t length) {
+    if (volumeStride == 1)
+    {
+      std::memcpy(volumeData + volumeOffset * pixelSize, regionData + regionOffset * pixelSize, length * pixelSize);
+      return;
+    }
+
+    for (std::size_t i = 0; i < length; ++i, volumeOffset += volumeStride)
+      std::memcpy(volumeData + volumeOffset * pixelSize, regionData + (regionOffset + i) * pixelSize, pixelSize);
+  });
+}
+
+mitk::Image::Pointer mitk::AlignedSliceMapping::CropSlice(const Image *slice, const RegionType &region)
+{
+  CheckSlice(slice, region);
+
+  auto regionImage = CreateRegionImage(slice->GetPixelType(), region);
+
+  ImageReadAccessor sliceAccessor(slice);
+  ImageWriteAccessor regionAccessor(regionImage);
+
+  const auto *sliceData = static_cast<const char *>(sliceAccessor.GetData());
+  auto *regionData = static_cast<char *>(regionAccessor.GetData());
+  const auto rowSize = region.GetSize(0) * slice->GetPixelType().GetSize();
+
+  for (itk::SizeValueType y = 0; y < region.GetSize(1); ++y)
+    std::memcpy(regionData + y * rowSize, sliceData + GetSliceRowOffset(slice, region, y), rowSize);
+
+  return regionImage;
+}
+
+void mitk::AlignedSliceMapping::PasteIntoSlice(Image *slice, const Image *regionImage, const RegionType &region)
+{
+  CheckSlice(slice, region);
+  CheckRegionImage(regionImage, slice->GetPixelType(), region);
+
+  ImageWriteAccessor sliceAccessor(slice);
+  ImageReadAccessor regionAccessor(regionImage);
+
+  auto *sliceData = static_cast<char *>(sliceAccessor.GetData());
+  const auto *regionData = static_cast<const char *>(regionAccessor.GetData());
+  const auto rowSize = region.GetSize(0) * slice->GetPixelType().GetSize();
+
+  for (itk::SizeValueType y = 0; y < region.GetSize(1); ++y)
+    std::memcpy(sliceData + GetSliceRowOffset(slice, region, y), regionData + y * rowSize, rowSize);
+}
@@ -0,0 +1,117 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef mitkAlignedSliceMapping_h
+#define mitkAlignedSliceMapping_h
+
+#include <mitkImage.h>
+#include <mitkPlaneGeometry.h>
+#include <MitkSegmentationExports.h>
+
+#include <itkImageRegion.h>
+#include <itkOffset.h>
+
+namespace mitk
+{
+  /**
+    \brief Maps the pixels of a 2D slice to the voxels of the volume it was extracted from.
+
+    Slices of planes that are aligned with the voxel grid of a volume (e.g. the standard axial,
+    sagittal and coronal planes of the volume) do not need reslicing: every slice pixel corresponds
+    to exactly one voxel. For such planes this class determines that correspondence, so regions of
+    the slice can be read from and written to the volume buffer directly.
+
+    The slice is the one that mitk::ExtractSliceFilter (and thus SegTool2D::GetAffectedImageSliceAs2DImage())
+    extracts for the plane. Pixel (i, j) of the slice corresponds to the voxel
+    GetOrigin() + i * GetAxis0() + j * GetAxis1() of the volume.
+  */
+  class MITKSEGMENTATION_EXPORT AlignedSliceMapping
+  {
+  public:
+    typedef itk::ImageRegion<2> RegionType;
+    typedef itk::Index<3> VolumeIndexType;
+    typedef itk::Offset<3> VolumeOffsetType;
+
+    /** \brief Constructs an invalid mapping. */
+    AlignedSliceMapping();
+
+    /**
+      \brief Determines the mapping for the slice of the plane in the given time step of the volume.
+
+      The returned mapping is invalid if the plane is not aligned with the voxel grid, if the slice
+      is not completely inside of the volume or if the volume is not a 3D(+t) image.
+    */
+    static AlignedSliceMapping Compute(const Image *volume, const PlaneGeometry *plane, TimeStepType timeStep);
+
+    bool IsValid() const;
+
+    /** \brief Region of the whole slice. */
+    const RegionType &GetSliceRegion() const;
+
+    TimeStepType GetTimeStep() const;
+
+    const VolumeIndexType &GetOrigin() const;
+    const VolumeOffsetType &GetAxis0() const;
+    const VolumeOffsetType &GetAxis1() const;
+
+    /** \brief Voxel that corresponds to the given slice pixel. */
+    VolumeIndexType GetVolumeIndex(const RegionType::IndexType &sliceIndex) const;
+
+    /**
+      \brief Copies the voxels that correspond to a region of the slice into a new 2D image of the size of the region.
+      \throw mitk::Exception if the mapping is invalid, the region is not inside of the slice or the volume does not
+      match the volume the mapping was computed for.
+    */
+    Image::Pointer ReadRegion(const Image *volume, const RegionType &region) const;
+
+    /**
+      \brief Writes a 2D image of the size of the region into the voxels that correspond to the region of the slice.
+
+      The volume is not marked as modified.
+      \throw mitk::Exception if the mapping is invalid, the region is not inside of the slice or the images
+      do not match the region or the volume the mapping was computed for.
+    */
+    void WriteRegion(Image *volume, const Image *regionImage, const RegionType &region) const;
+
+    /**
+      \brief Copies a region of a 2D image into a new 2D image of the size of the region.
+      \throw mitk::Exception if the region is not inside of the image.
+    */
+    static Image::Pointer CropSlice(const Image *slice, const RegionType &region);
+
+    /**
+      \brief Copies a 2D image into a region of a 2D image of the same pixel type.
+      \throw mitk::Exception if the region is not inside of the slice or the images do not match.
+    */
+    static void PasteIntoSlice(Image *slice, const Image *regionImage, const RegionType &region);
+
+  private:
+    void CheckVolume(const Image *volume, const RegionType &region) const;
+
+    /** Calls copyRow(volumeOffset, volumeStride, regionOffset, length) with pixel offsets for every row of the region. */
+    template <typename TFunction>
+    void ForEachRow(const RegionType &region, TFunction copyRow) const;
+
+    bool m_IsValid;
+    RegionType m_SliceRegion;
+    TimeStepType m_TimeStep;
+
+    VolumeIndexType m_Origin;
+    VolumeOffsetType m_Axis0;
+    VolumeOffsetType m_Axis1;
+
+    /** Size of the volume the mapping was computed for. */
+    itk::Size<3> m_VolumeSize;
+  };
+}
+
+#endif
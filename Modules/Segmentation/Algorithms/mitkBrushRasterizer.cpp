@@ -0,0 +1,287 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkBrushRasterizer.h"
+
+#include <mitkImageAccessByItk.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace
+{
+  constexpr double Epsilon = 1e-9;
+
+  /** Restricts [lower, upper] to the values of x with minimum <= a * x + c <= maximum. */
+  void RestrictInterval(double a, double c, double minimum, double maximum, double &lower, double &upper)
+  {
+    if (a == 0.0)
+    {
+      if (c < minimum - Epsilon || c > maximum + Epsilon)
+      {
+        lower = std::numeric_limits<double>::infinity();
+        upper = -std::numeric_limits<double>::infinity();
+      }
+      return;
+    }
+
+    auto x1 = (minimum - c) / a;
+    auto x2 = (maximum - c) / a;
+
+    if (x1 > x2)
+      std::swap(x1, x2);
+
+    lower = std::max(lower, x1);
+    upper = std::min(upper, x2);
+  }
+
+  template <typename TPixel, unsigned int VImageDimension>
+  void FillSpans(itk::Image<TPixel, VImageDimension> *image,
+                 const mitk::BrushRasterizer::SpanListType &spans,
+                 int value,
+                 mitk::BrushRasterizer::RegionType &dirtyRegion)
+  {
+    const auto region = image->GetBufferedRegion();
+    const auto minX = region.GetIndex(0);
+    const auto maxX = minX + static_cast<itk::IndexValueType>(region.GetSize(0)) - 1;
+    const auto minY = region.GetIndex(1);
+    const auto maxY = minY + static_cast<itk::IndexValueType>(region.GetSize(1)) - 1;
+
+    const auto pixelValue = static_cast<TPixel>(value);
+    auto buffer = image->GetBufferPointer();
+
+    itk::IndexValueType dirtyMinX = maxX + 1, dirtyMaxX = minX - 1;
+    itk::IndexValueType dirtyMinY = maxY + 1, dirtyMaxY = minY - 1;
+
+    for (const auto &span : spans)
+    {
+      if (span.Y < minY || span.Y > maxY)
+        continue;
+
+      const auto begin = std::max(span.XBegin, minX);
+      const auto end = std::min(span.XEnd, maxX);
+
+      if (begin > end)
+        continue;
+
+      typename itk::Image<TPixel, VImageDimension>::IndexType index;
+      index[0] = begin;
+      index[1] = span.Y;
+
+      auto row = buffer + image->ComputeOffset(index);
+      std::fill(row, row + (end - begin + 1), pixelValue);
+
+      dirtyMinX = std::min(dirtyMinX, begin);
+      dirtyMaxX = std::max(dirtyMaxX, end);
+      dirtyMinY = std::min(dirtyMinY, span.Y);
+      dirtyMaxY = std::max(dirtyMaxY, span.Y);
+    }
+
+    if (dirtyMinX > dirtyMaxX)
+      return;
+
+    mitk::BrushRasterizer::IndexType dirtyIndex;
+    dirtyIndex[0] = dirtyMinX;
+    dirtyIndex[1] = dirtyMinY;
+
+    mitk::BrushRasterizer::RegionType::SizeType dirtySize;
+    dirtySize[0] = static_cast<itk::SizeValueType>(dirtyMaxX - dirtyMinX + 1);
+    dirtySize[1] = static_cast<itk::SizeValueType>(dirtyMaxY - dirtyMinY + 1);
+
+    dirtyRegion.SetIndex(dirtyIndex);
+    dirtyRegion.SetSize(dirtySize);
+  }
+}
+
+mitk::BrushRasterizer::BrushRasterizer(unsigned int size)
+  : m_Size(0)
+{
+  this->SetSize(size);
+}
+
+void mitk::BrushRasterizer::SetSize(unsigned int size)
+{
+  m_Size = std::max(1u, size);
+
+  if (m_Footprints.find(m_Size) == m_Footprints.end())
+    m_Footprints.emplace(m_Size, ComputeFootprint(m_Size));
+}
+
+unsigned int mitk::BrushRasterizer::GetSize() const
+{
+  return m_Size;
+}
+
+const mitk::BrushRasterizer::SpanListType &mitk::BrushRasterizer::GetFootprint() const
+{
+  return m_Footprints.at(m_Size);
+}
+
+mitk::BrushRasterizer::SpanListType mitk::BrushRasterizer::ComputeFootprint(unsigned int size)
+{
+  // Work in doubled integer coordinates to decide exactly which pixel centers are covered:
+  // (2 * dx - e)^2 + (2 * dy - e)^2 <= size^2, with the center offset e = 1 for even sizes.
+  const itk::IndexValueType e = (size % 2 == 0) ? 1 : 0;
+  const itk::IndexValueType s = size;
+  const itk::IndexValueType extent = s / 2 + 1;
+
+  SpanListType footprint;
+
+  for (auto dy = -extent; dy <= extent; ++dy)
+  {
+    const auto y = 2 * dy - e;
+
+    Span span = { dy, extent + 1, -extent - 1 };
+
+    for (auto dx = -extent; dx <= extent; ++dx)
+    {
+      const auto x = 2 * dx - e;
+
+      if (x * x + y * y <= s * s)
+      {
+        span.XBegin = std::min(span.XBegin, dx);
+        span.XEnd = std::max(span.XEnd, dx);
+      }
+    }
+
+    if (span.XBegin <= span.XEnd)
+      footprint.push_back(span);
+  }
+
+  return footprint;
+}
+
+mitk::BrushRasterizer::SpanListType mitk::BrushRasterizer::RasterizeStamp(const IndexType &position) const
+{
+  SpanListType spans = this->GetFootprint();
+
+  for (auto &span : spans)
+  {
+    span.Y += position[1];
+    span.XBegin += position[0];
+    span.XEnd += position[0];
+  }
+
+  return spans;
+}
+
+mitk::BrushRasterizer::SpanListType mitk::BrushRasterizer::RasterizeStroke(const IndexType &from,
+                                                                           const IndexType &to) const
+{
+  if (from == to)
+    return this->RasterizeStamp(from);
+
+  const auto &footprint = this->GetFootprint();
+  const auto firstFootprintRow = footprint.front().Y;
+  const auto lastFootprintRow = footprint.back().Y;
+
+  // The capsule is the union of both footprints and the band that is swept between them.
+  // Its intersection with a row is convex, so the pixels of a row are bounded by the
+  // leftmost and rightmost pixel of the three parts.
+  const double offset = (m_Size % 2 == 0) ? 0.5 : 0.0;
+  const double radius = m_Size / 2.0;
+
+  const double fromX = from[0] + offset;
+  const double fromY = from[1] + offset;
+  const double directionX = static_cast<double>(to[0] - from[0]);
+  const double directionY = static_cast<double>(to[1] - from[1]);
+  const double lengthSquared = directionX * directionX + directionY * directionY;
+  const double length = std::sqrt(lengthSquared);
+
+  const auto minY = std::min(from[1], to[1]) + firstFootprintRow;
+  const auto maxY = std::max(from[1], to[1]) + lastFootprintRow;
+
+  SpanListType spans;
+  spans.reserve(static_cast<std::size_t>(maxY - minY + 1));
+
+  for (auto y = minY; y <= maxY; ++y)
+  {
+    Span span = { y, std::numeric_limits<itk::IndexValueType>::max(), std::numeric_limits<itk::IndexValueType>::min() };
+
+    for (const auto &center : { from, to })
+    {
+      const auto row = y - center[1];
+
+      if (row < firstFootprintRow || row > lastFootprintRow)
+        continue;
+
+      const auto &footprintSpan = footprint[static_cast<std::size_t>(row - firstFootprintRow)];
+      span.XBegin = std::min(span.XBegin, center[0] + footprintSpan.XBegin);
+      span.XEnd = std::max(span.XEnd, center[0] + footprintSpan.XEnd);
+    }
+
+    // band: projection onto the stroke within [0, length^2], distance to the stroke <= radius
+    const double relativeY = y - fromY;
+    double lower = -std::numeric_limits<double>::infinity();
+    double upper = std::numeric_limits<double>::infinity();
+
+    RestrictInterval(directionX, relativeY * directionY - fromX * directionX, 0.0, lengthSquared, lower, upper);
+    RestrictInterval(-directionY, relativeY * directionX + fromX * directionY, -radius * length, radius * length, lower, upper);
+
+    if (lower <= upper)
+    {
+      const auto bandBegin = static_cast<itk::IndexValueType>(std::ceil(lower - Epsilon));
+      const auto bandEnd = static_cast<itk::IndexValueType>(std::floor(upper + Epsilon));
+
+      if (bandBegin <= bandEnd)
+      {
+        span.XBegin = std::min(span.XBegin, bandBegin);
+        span.XEnd = std::max(span.XEnd, bandEnd);
+      }
+    }
+
+    if (span.XBegin <= span.XEnd)
+      spans.push_back(span);
+  }
+
+  return spans;
+}
+
+mitk::BrushRasterizer::RegionType mitk::BrushRasterizer::Fill(Image *slice, const SpanListType &spans, int value)
+{
+  RegionType dirtyRegion;
+
+  if (nullptr == slice || spans.empty())
+    return dirtyRegion;
+
+  AccessFixedDimensionByItk_n(slice, FillSpans, 2, (spans, value, dirtyRegion));
+
+  if (dirtyRegion.GetNumberOfPixels() > 0)
+    slice->Modified();
+
+  return dirtyRegion;
+}
+
+mitk::BrushRasterizer::RegionType mitk::BrushRasterizer::MergeRegions(const RegionType &region1,
+                                                                      const RegionType &region2)
+{
+  if (region1.GetNumberOfPixels() == 0)
+    return region2;
+
+  if (region2.GetNumberOfPixels() == 0)
+    return region1;
+
+  IndexType index;
+  RegionType::SizeType size;
+
+  for (unsigned int i = 0; i < 2; ++i)
+  {
+    const auto begin = std::min(region1.GetIndex(i), region2.GetIndex(i));
+    const auto end = std::max(region1.GetUpperIndex()[i], region2.GetUpperIndex()[i]);
+
+    index[i] = begin;
+    size[i] = static_cast<itk::SizeValueType>(end - begin + 1);
+  }
+
+  return RegionType(index, size);
+}
@@ -0,0 +1,92 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef mitkBrushRasterizer_h
+#define mitkBrushRasterizer_h
+
+#include <mitkImage.h>
+#include <MitkSegmentationExports.h>
+
+#include <itkImageRegion.h>
+
+#include <map>
+#include <vector>
+
+namespace mitk
+{
+  /**
+    \brief Rasterizes circular brushes and brush strokes directly into 2D slices.
+
+    The footprint of a brush of a given size (in pixels) is computed once and cached as
+    a list of horizontal spans. Pixels are part of the footprint if their center lies within
+    the circle of diameter size around the brush center. For even sizes the brush center is
+    the corner at +0.5/+0.5 of the pixel the brush points to, as for the contour that is
+    shown by mitk::PaintbrushTool.
+
+    Strokes between two brush positions are rasterized as swept capsule, i.e. the two
+    footprints and every pixel in between that is covered by the moving brush.
+
+    Filling spans into an image returns the region of pixels that were touched, so that
+    callers only have to process this (dirty) region further.
+  */
+  class MITKSEGMENTATION_EXPORT BrushRasterizer
+  {
+  public:
+    /** \brief Pixels XBegin to XEnd (inclusive) of row Y. */
+    struct Span
+    {
+      itk::IndexValueType Y;
+      itk::IndexValueType XBegin;
+      itk::IndexValueType XEnd;
+    };
+
+    typedef std::vector<Span> SpanListType;
+    typedef itk::Index<2> IndexType;
+    typedef itk::ImageRegion<2> RegionType;
+
+    explicit BrushRasterizer(unsigned int size = 1);
+
+    /** \brief Diameter of the brush in pixels (at least 1). */
+    void SetSize(unsigned int size);
+    unsigned int GetSize() const;
+
+    /** \brief Footprint of the current brush size relative to the brush position, sorted by rows. */
+    const SpanListType &GetFootprint() const;
+
+    /** \brief Spans of a single brush stamp at the given pixel. */
+    SpanListType RasterizeStamp(const IndexType &position) const;
+
+    /** \brief Spans of the capsule swept by the brush from one pixel to another (one span per row). */
+    SpanListType RasterizeStroke(const IndexType &from, const IndexType &to) const;
+
+    /**
+      \brief Sets all pixels of the given spans to value.
+
+      Spans are clipped to the largest possible region of the 2D image. The image is only
+      marked as modified if at least one pixel was written.
+
+      \return The bounding region of the written pixels (empty if no pixel was written).
+    */
+    static RegionType Fill(Image *slice, const SpanListType &spans, int value);
+
+    /** \brief Bounding region of both regions, empty regions are ignored. */
+    static RegionType MergeRegions(const RegionType &region1, const RegionType &region2);
+
+  private:
+    static SpanListType ComputeFootprint(unsigned int size);
+
+    unsigned int m_Size;
+    std::map<unsigned int, SpanListType> m_Footprints;
+  };
+}
+
+#endif
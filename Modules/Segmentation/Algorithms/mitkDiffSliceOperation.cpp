@@ -13,6 +13,7 @@ found in the LICENSE file.
 #include "mitkDiffSliceOperation.h"
 
 #include <mitkImage.h>
+#include <mitkSegTool2D.h>
 
 #include <itkCommand.h>
 
@@ -24,6 +25,7 @@ mitk::DiffSliceOperation::DiffSliceOperation() : Operation(1)
   m_SliceGeometry = nullptr;
   m_ImageIsValid = false;
   m_DeleteObserverTag = 0;
+  m_SliceDiffMemorySize = 0;
 }
 
 mitk::DiffSliceOperation::DiffSliceOperation(Image *imageVolume,
@@ -33,6 +35,42 @@ mitk::DiffSliceOperation::DiffSliceOperation(Image *imageVolume,
                                              const BaseGeometry *currentWorldGeometry)
   : Operation(1)
 
+{
+  m_CompressedImageContainer.CompressImage(slice);
+
+  this->Initialize(imageVolume, sliceGeometry, timestep, currentWorldGeometry);
+}
+
+mitk::DiffSliceOperation::DiffSliceOperation(Image *imageVolume,
+                                             std::shared_ptr<const CompressedImageDiff> sliceDiff,
+                                             const SlicedGeometry3D *sliceGeometry,
+                                             TimeStepType timestep,
+                                             const BaseGeometry *currentWorldGeometry)
+  : Operation(1),
+    m_SliceDiff(sliceDiff)
+{
+  this->Initialize(imageVolume, sliceGeometry, timestep, currentWorldGeometry);
+}
+
+mitk::DiffSliceOperation::DiffSliceOperation(Image *imageVolume,
+                                             std::shared_ptr<const CompressedImageDiff> regionDiff,
+                                             const AlignedSliceMapping &sliceMapping,
+                                             const itk::ImageRegion<2> &sliceRegion,
+                                             const SlicedGeometry3D *sliceGeometry,
+                                             TimeStepType timestep,
+                                             const BaseGeometry *currentWorldGeometry)
+  : Operation(1),
+    m_SliceDiff(regionDiff),
+    m_SliceMapping(sliceMapping),
+    m_SliceRegion(sliceRegion)
+{
+  this->Initialize(imageVolume, sliceGeometry, timestep, currentWorldGeometry);
+}
+
+void mitk::DiffSliceOperation::Initialize(Image *imageVolume,
+                                          const SlicedGeometry3D *sliceGeometry,
+                                          TimeStepType timestep,
+                                          const BaseGeometry *currentWorldGeometry)
 {
   m_WorldGeometry = currentWorldGeometry->Clone();
 
@@ -47,11 +85,12 @@ mitk::DiffSliceOperation::DiffSliceOperation(Image *imageVolume,
 
   m_TimeStep = timestep;
 
-  m_CompressedImageContainer.CompressImage(slice);
-
   m_Image = imageVolume;
   m_DeleteObserverTag = 0;
 
+  // fixed, so the undo stack frees the same size when the operation is deleted as it added
+  m_SliceDiffMemorySize = nullptr != m_SliceDiff ? (m_SliceDiff->GetMemorySize() + 1) / 2 : 0;
+
   if (m_Image)
   {
     /*add an observer to listen to the delete event of the image, this is necessary because the operation is then
@@ -81,7 +120,34 @@ mitk::DiffSliceOperation::~DiffSliceOperation()
 
 mitk::Image::Pointer mitk::DiffSliceOperation::GetSlice()
 {
-  return m_CompressedImageContainer.DecompressImage();
+  if (nullptr == m_SliceDiff)
+    return m_CompressedImageContainer.DecompressImage();
+
+  if (!this->IsValid())
+    return nullptr;
+
+  auto slice = SegTool2D::GetAffectedImageSliceAs2DImage(
+    dynamic_cast<const PlaneGeometry *>(m_WorldGeometry.GetPointer()), m_Image, m_TimeStep);
+
+  if (this->IsRegionOperation())
+  {
+    auto region = AlignedSliceMapping::CropSlice(slice, m_SliceRegion);
+    m_SliceDiff->ApplyDiff(region);
+    AlignedSliceMapping::PasteIntoSlice(slice, region, m_SliceRegion);
+    return slice;
+  }
+
+  m_SliceDiff->ApplyDiff(slice);
+
+  return slice;
+}
+
+std::size_t mitk::DiffSliceOperation::GetMemorySize() const
+{
+  if (nullptr == m_SliceDiff)
+    return sizeof(*this) + m_CompressedImageContainer.GetCompressedSize();
+
+  return sizeof(*this) + m_SliceDiffMemorySize;
 }
 
 bool mitk::DiffSliceOperation::IsValid()
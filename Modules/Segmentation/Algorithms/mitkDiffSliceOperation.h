@@ -13,12 +13,16 @@ found in the LICENSE file.
 #ifndef mitkDiffSliceOperation_h
 #define mitkDiffSliceOperation_h
 
+#include "mitkAlignedSliceMapping.h"
 #include "mitkCompressedImageContainer.h"
+#include "mitkCompressedImageDiff.h"
 #include <MitkSegmentationExports.h>
 #include <mitkOperation.h>
 
 #include <vtkSmartPointer.h>
 
+#include <memory>
+
 namespace mitk
 {
   class Image;
@@ -34,6 +38,14 @@ namespace mitk
      currentWorldGeometry   specifies the axis where the slice has to be applied in the volume.
 
     This Operation can be used to realize undo-redo functionality for e.g. segmentation purposes.
+
+    Instead of the slice itself, the operation can hold a CompressedImageDiff between the slice
+    before and after an edit. The slice to be applied is then reconstructed from the current slice
+    of the volume, so one diff can be shared by the undo and the redo operation of an edit.
+
+    For slices that are aligned with the voxel grid, the diff may cover only the changed region of
+    the slice (see IsRegionOperation()). The region is then read from and written to the volume
+    directly through an AlignedSliceMapping.
   */
   class MITKSEGMENTATION_EXPORT DiffSliceOperation : public Operation
   {
@@ -57,6 +69,26 @@ namespace mitk
                        const TimeStepType timestep,
                        const BaseGeometry *currentWorldGeometry);
 
+    /** \brief Creates an operation that applies a slice difference to the current slice of the volume.
+      Applying the same difference twice restores the original slice.
+    */
+    DiffSliceOperation(mitk::Image *imageVolume,
+                       std::shared_ptr<const CompressedImageDiff> sliceDiff,
+                       const SlicedGeometry3D *sliceGeometry,
+                       const TimeStepType timestep,
+                       const BaseGeometry *currentWorldGeometry);
+
+    /** \brief Creates an operation that applies the difference of a region of an aligned slice to the volume.
+      The difference has to be computed between images of the size of the region.
+    */
+    DiffSliceOperation(mitk::Image *imageVolume,
+                       std::shared_ptr<const CompressedImageDiff> regionDiff,
+                       const AlignedSliceMapping &sliceMapping,
+                       const itk::ImageRegion<2> &sliceRegion,
+                       const SlicedGeometry3D *sliceGeometry,
+                       const TimeStepType timestep,
+                       const BaseGeometry *currentWorldGeometry);
+
     /** \brief Check if it is a valid operation.*/
     bool IsValid();
 
@@ -67,20 +99,49 @@ namespace mitk
     /** \brief Get the slice that is applied in the operation.*/
     Image::Pointer GetSlice();
 
+    /** \brief True if the operation only holds the difference of a region of the slice.*/
+    bool IsRegionOperation() const { return this->m_SliceMapping.IsValid(); }
+    /** \brief Get the mapping of the slice pixels to the voxels (only valid for region operations).*/
+    const AlignedSliceMapping &GetSliceMapping() const { return this->m_SliceMapping; }
+    /** \brief Get the region of the slice that is changed by a region operation.*/
+    const itk::ImageRegion<2> &GetSliceRegion() const { return this->m_SliceRegion; }
+    /** \brief Get the difference of the slice or region (nullptr if the operation holds the slice itself).*/
+    std::shared_ptr<const CompressedImageDiff> GetSliceDiff() const { return this->m_SliceDiff; }
+
     /** \brief Set timeStep*/
     TimeStepType GetTimeStep() const { return this->m_TimeStep; }
     /** \brief Get the axis where the slice has to be applied in the volume.*/
     const SlicedGeometry3D *GetSliceGeometry() const { return this->m_SliceGeometry; }
     /** \brief Get the axis where the slice has to be applied in the volume.*/
     const BaseGeometry *GetWorldGeometry() const { return this->m_WorldGeometry; }
+
+    /** \brief Memory of the compressed slice or of this operation's share of the slice difference.
+      The slice difference is shared by the undo and the redo operation of an edit, so each operation accounts
+      for half of it.
+    */
+    std::size_t GetMemorySize() const override;
+
   protected:
     ~DiffSliceOperation() override;
 
+    void Initialize(mitk::Image *imageVolume,
+                    const SlicedGeometry3D *sliceGeometry,
+                    TimeStepType timestep,
+                    const BaseGeometry *currentWorldGeometry);
+
     /** \brief Callback for image observer.*/
     void OnImageDeleted();
 
     CompressedImageContainer m_CompressedImageContainer;
 
+    std::shared_ptr<const CompressedImageDiff> m_SliceDiff;
+
+    std::size_t m_SliceDiffMemorySize;
+
+    AlignedSliceMapping m_SliceMapping;
+
+    itk::ImageRegion<2> m_SliceRegion;
+
     mitk::Image *m_Image;
 
     vtkSmartPointer<vtkImageData> m_Slice;
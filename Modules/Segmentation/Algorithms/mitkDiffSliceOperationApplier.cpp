@@ -15,10 +15,12 @@ found in the LICENSE file.
 #include "mitkDiffSliceOperation.h"
 #include "mitkRenderingManager.h"
 #include "mitkSegTool2D.h"
+#include "mitkSegmentationInterpolationController.h"
 #include <mitkExtractSliceFilter.h>
 #include <mitkVtkImageOverwrite.h>
 
 // VTK
+#include <vtkImageData.h>
 #include <vtkSmartPointer.h>
 
 mitk::DiffSliceOperationApplier::DiffSliceOperationApplier()
@@ -40,31 +42,84 @@ void mitk::DiffSliceOperationApplier::ExecuteOperation(Operation *operation)
   // check if the operation is valid
   if (imageOperation->IsValid())
   {
-    // the actual overwrite filter (vtk)
-    vtkSmartPointer<mitkVtkImageOverwrite> reslice = vtkSmartPointer<mitkVtkImageOverwrite>::New();
-
-    mitk::Image::Pointer slice = imageOperation->GetSlice();
-    // Set the slice as 'input'
-    reslice->SetInputSlice(slice->GetVtkImageData());
-
-    // set overwrite mode to true to write back to the image volume
-    reslice->SetOverwriteMode(true);
-    reslice->Modified();
-
-    // a wrapper for vtkImageOverwrite
-    mitk::ExtractSliceFilter::Pointer extractor = mitk::ExtractSliceFilter::New(reslice);
-    extractor->SetInput(imageOperation->GetImage());
-    extractor->SetTimeStep(imageOperation->GetTimeStep());
-    extractor->SetWorldGeometry(dynamic_cast<const PlaneGeometry *>(imageOperation->GetWorldGeometry()));
-    extractor->SetVtkOutputRequest(true);
-    extractor->SetResliceTransformByGeometry(imageOperation->GetImage()->GetGeometry(imageOperation->GetTimeStep()));
-
-    extractor->Modified();
-    extractor->Update();
+    if (imageOperation->IsRegionOperation())
+    {
+      // write the changed region directly, the slice does not need to be resliced
+      const auto &sliceMapping = imageOperation->GetSliceMapping();
+      const auto &sliceRegion = imageOperation->GetSliceRegion();
+      auto image = imageOperation->GetImage();
+
+      auto originalRegion = sliceMapping.ReadRegion(image, sliceRegion);
+      auto modifiedRegion = originalRegion->Clone();
+      imageOperation->GetSliceDiff()->ApplyDiff(modifiedRegion);
+
+      auto interpolator = SegmentationInterpolationController::InterpolatorForImage(image);
+      if (nullptr != interpolator)
+      {
+        interpolator->BlockModified(true);
+        interpolator->SetChangedRegion(originalRegion,
+                                       modifiedRegion,
+                                       sliceMapping.GetVolumeIndex(sliceRegion.GetIndex()),
+                                       sliceMapping.GetAxis0(),
+                                       sliceMapping.GetAxis1(),
+                                       imageOperation->GetTimeStep());
+      }
+
+      // the interpolation of a single label of a multi-label segmentation
+      auto labelInterpolator = SegmentationInterpolationController::InterpolatorForLabelSegmentation(image);
+      if (nullptr != labelInterpolator)
+      {
+        labelInterpolator->BlockModified(true);
+        labelInterpolator->SetChangedLabelRegion(originalRegion,
+                                                 modifiedRegion,
+                                                 sliceMapping.GetVolumeIndex(sliceRegion.GetIndex()),
+                                                 sliceMapping.GetAxis0(),
+                                                 sliceMapping.GetAxis1(),
+                                                 imageOperation->GetTimeStep());
+      }
+
+      sliceMapping.WriteRegion(image, modifiedRegion, sliceRegion);
+      image->Modified();
+      image->GetVtkImageData(imageOperation->GetTimeStep())->Modified();
+      image->InvokeEvent(ImageRegionModifiedEvent(imageOperation->GetTimeStep(), imageOperation->GetWorldGeometry()));
+
+      if (nullptr != interpolator)
+        interpolator->BlockModified(false);
+
+      if (nullptr != labelInterpolator)
+        labelInterpolator->BlockModified(false);
+    }
+    else
+    {
+      // the actual overwrite filter (vtk)
+      vtkSmartPointer<mitkVtkImageOverwrite> reslice = vtkSmartPointer<mitkVtkImageOverwrite>::New();
+
+      mitk::Image::Pointer slice = imageOperation->GetSlice();
+      // Set the slice as 'input'
+      reslice->SetInputSlice(slice->GetVtkImageData());
+
+      // set overwrite mode to true to write back to the image volume
+      reslice->SetOverwriteMode(true);
+      reslice->Modified();
+
+      // a wrapper for vtkImageOverwrite
+      mitk::ExtractSliceFilter::Pointer extractor = mitk::ExtractSliceFilter::New(reslice);
+      extractor->SetInput(imageOperation->GetImage());
+      extractor->SetTimeStep(imageOperation->GetTimeStep());
+      extractor->SetWorldGeometry(dynamic_cast<const PlaneGeometry *>(imageOperation->GetWorldGeometry()));
+      extractor->SetVtkOutputRequest(true);
+      extractor->SetResliceTransformByGeometry(imageOperation->GetImage()->GetGeometry(imageOperation->GetTimeStep()));
+
+      extractor->Modified();
+      extractor->Update();
+
+      imageOperation->GetImage()->Modified();
+      imageOperation->GetImage()->InvokeEvent(
+        ImageRegionModifiedEvent(imageOperation->GetTimeStep(), imageOperation->GetWorldGeometry()));
+    }
 
     // make sure the modification is rendered
     RenderingManager::GetInstance()->RequestUpdateAll();
-    imageOperation->GetImage()->Modified();
 
     PlaneGeometry::ConstPointer plane = dynamic_cast<const PlaneGeometry *>(imageOperation->GetWorldGeometry());
     SegTool2D::UpdateAllSurfaceInterpolations(dynamic_cast<LabelSetImage*>(imageOperation->GetImage()), imageOperation->GetTimeStep(), plane, true);
@@ -27,6 +27,9 @@ mitk::ImageLiveWireContourModelFilter::ImageLiveWireContourModelFilter()
   m_CostFunction = CostFunctionType::New();
   m_ShortestPathFilter = ShortestPathImageFilterType::New();
   m_ShortestPathFilter->SetCostFunction(m_CostFunction);
+  m_LiveWireTree = itk::LiveWireDijkstraTree::New();
+  m_LiveWireTree->SetRepulsiveCost(CostFunctionType::RepulsiveCost);
+  m_UseCostFunction = true;
   m_UseDynamicCostMap = false;
   m_TimeStep = 0;
 }
@@ -134,16 +137,19 @@ void mitk::ImageLiveWireContourModelFilter::ItkPreProcessImage(const itk::Image<
   m_InternalImage = castFilter->GetOutput();
   m_CostFunction->SetImage(m_InternalImage);
   m_ShortestPathFilter->SetInput(m_InternalImage);
+  m_LiveWireTree->SetCostImage(nullptr);
 }
 
 void mitk::ImageLiveWireContourModelFilter::ClearRepulsivePoints()
 {
   m_CostFunction->ClearRepulsivePoints();
+  m_LiveWireTree->Reset();
 }
 
 void mitk::ImageLiveWireContourModelFilter::AddRepulsivePoint(const itk::Index<2> &idx)
 {
   m_CostFunction->AddRepulsivePoint(idx);
+  m_LiveWireTree->Reset();
 }
 
 void mitk::ImageLiveWireContourModelFilter::DumpMaskImage()
@@ -157,6 +163,7 @@ void mitk::ImageLiveWireContourModelFilter::DumpMaskImage()
 void mitk::ImageLiveWireContourModelFilter::RemoveRepulsivePoint(const itk::Index<2> &idx)
 {
   m_CostFunction->RemoveRepulsivePoint(idx);
+  m_LiveWireTree->Reset();
 }
 
 void mitk::ImageLiveWireContourModelFilter::SetRepulsivePoints(const ShortestPathType &points)
@@ -168,6 +175,8 @@ void mitk::ImageLiveWireContourModelFilter::SetRepulsivePoints(const ShortestPat
   {
     m_CostFunction->AddRepulsivePoint((*iter));
   }
+
+  m_LiveWireTree->Reset();
 }
 
 void mitk::ImageLiveWireContourModelFilter::UpdateLiveWire()
@@ -204,20 +213,35 @@ void mitk::ImageLiveWireContourModelFilter::UpdateLiveWire()
   m_CostFunction->SetRequestedRegion(region);
   m_CostFunction->SetUseCostMap(m_UseDynamicCostMap);
 
-  // calculate shortest path between start and end point
-  m_ShortestPathFilter->SetFullNeighborsMode(true);
-  // m_ShortestPathFilter->SetInput( m_CostFunction->SetImage(m_InternalImage) );
-  m_ShortestPathFilter->SetMakeOutputImage(false);
+  ShortestPathType shortestPath;
+
+  if (m_UseCostFunction)
+  {
+    // The local costs are computed once per image and cost map. The tree is kept as long as the start point
+    // and the costs do not change, so that moving the end point only traces back the new path.
+    m_LiveWireTree->SetCostImage(m_CostFunction->GetLocalCostImage());
+    m_LiveWireTree->SetMaskImage(m_CostFunction->GetMaskImage());
+    m_LiveWireTree->SetSeed(startPoint);
+
+    shortestPath = m_LiveWireTree->GetPath(endPoint);
+  }
+  else
+  {
+    // calculate shortest path between start and end point
+    m_ShortestPathFilter->SetFullNeighborsMode(true);
+    // m_ShortestPathFilter->SetInput( m_CostFunction->SetImage(m_InternalImage) );
+    m_ShortestPathFilter->SetMakeOutputImage(false);
 
-  // m_ShortestPathFilter->SetCalcAllDistances(true);
-  m_ShortestPathFilter->SetStartIndex(startPoint);
-  m_ShortestPathFilter->SetEndIndex(endPoint);
+    // m_ShortestPathFilter->SetCalcAllDistances(true);
+    m_ShortestPathFilter->SetStartIndex(startPoint);
+    m_ShortestPathFilter->SetEndIndex(endPoint);
 
-  m_ShortestPathFilter->Update();
+    m_ShortestPathFilter->Update();
 
-  // construct contour from path image
-  // get the shortest path as vector
-  ShortestPathType shortestPath = m_ShortestPathFilter->GetVectorPath();
+    // construct contour from path image
+    // get the shortest path as vector
+    shortestPath = m_ShortestPathFilter->GetVectorPath();
+  }
 
   // fill the output contour with control points from the path
   OutputType::Pointer output = dynamic_cast<OutputType *>(this->MakeOutput(0).GetPointer());
@@ -22,6 +22,7 @@ found in the LICENSE file.
 #include <mitkImageAccessByItk.h>
 #include <mitkImageCast.h>
 
+#include <itkLiveWireDijkstraTree.h>
 #include <itkShortestPathCostFunctionLiveWire.h>
 #include <itkShortestPathImageFilter.h>
 
@@ -35,6 +36,12 @@ namespace mitk
    value.
    \sa ShortestPathCostFunctionLiveWire
 
+   The shortest paths are taken from a LiveWireDijkstraTree that is grown from the start point over the
+   precomputed local costs of the image. As long as the start point, the image, the cost map and the repulsive
+   points stay the same, an update for another end point only traces the path back in the tree, which keeps
+   updates during mouse moves cheap.
+   \sa itk::LiveWireDijkstraTree
+
    The filter is able to create dynamic cost transfer map and thus use on the fly training.
    \note On the fly training will only be used for next update.
    The computation uses the last calculated segment to map cost according to features in the area of the segment.
@@ -108,7 +115,11 @@ namespace mitk
     /** \brief Create dynamic cost transfer map - on the fly training*/
     bool CreateDynamicCostMap(mitk::ContourModel *path = nullptr);
 
-    void SetUseCostFunction(bool doUseCostFunction) { m_ShortestPathFilter->SetUseCostFunction(doUseCostFunction); };
+    void SetUseCostFunction(bool doUseCostFunction)
+    {
+      m_UseCostFunction = doUseCostFunction;
+      m_ShortestPathFilter->SetUseCostFunction(doUseCostFunction);
+    };
 
   protected:
     ImageLiveWireContourModelFilter();
@@ -139,6 +150,12 @@ namespace mitk
     /** \brief Shortest path filter according to cost function m_CostFunction*/
     ShortestPathImageFilterType::Pointer m_ShortestPathFilter;
 
+    /** \brief Shortest path tree from the start point over the local costs of m_CostFunction*/
+    itk::LiveWireDijkstraTree::Pointer m_LiveWireTree;
+
+    /** \brief Flag to use the cost function or to connect start and end point directly*/
+    bool m_UseCostFunction;
+
     /** \brief Flag to use a dynamic cost map or not*/
     bool m_UseDynamicCostMap;
 
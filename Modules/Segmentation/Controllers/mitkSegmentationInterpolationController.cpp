@@ -17,6 +17,8 @@ found in the LICENSE file.
 #include "mitkImageTimeSelector.h"
 #include <mitkExtractSliceFilter.h>
 #include <mitkImageAccessByItk.h>
+#include <mitkImageWriteAccessor.h>
+#include <mitkLabelSetImageConverter.h>
 //#include <mitkPlaneGeometry.h>
 
 #include <itkCommand.h>
@@ -37,10 +39,27 @@ namespace
       object->RemoveObserver(observerTag);
     }
   }
+
+  // index of the voxel at (u, v) of a region that is mapped to the volume by origin and axes
+  itk::Index<3> GetVoxelOfRegion(const itk::Index<3> &origin,
+                                 const itk::Offset<3> &axis0,
+                                 const itk::Offset<3> &axis1,
+                                 itk::SizeValueType u,
+                                 itk::SizeValueType v)
+  {
+    itk::Index<3> voxel;
+
+    for (unsigned int dim = 0; dim < 3; ++dim)
+      voxel[dim] = origin[dim] + static_cast<itk::IndexValueType>(u) * axis0[dim] + static_cast<itk::IndexValueType>(v) * axis1[dim];
+
+    return voxel;
+  }
 }
 
 mitk::SegmentationInterpolationController::InterpolatorMapType
   mitk::SegmentationInterpolationController::s_InterpolatorForImage; // static member initialization
+mitk::SegmentationInterpolationController::InterpolatorMapType
+  mitk::SegmentationInterpolationController::s_InterpolatorForLabelSegmentation;
 
 mitk::SegmentationInterpolationController *mitk::SegmentationInterpolationController::InterpolatorForImage(
   const Image *image)
@@ -56,8 +75,24 @@ mitk::SegmentationInterpolationController *mitk::SegmentationInterpolationContro
   }
 }
 
+mitk::SegmentationInterpolationController *mitk::SegmentationInterpolationController::InterpolatorForLabelSegmentation(
+  const Image *image)
+{
+  auto iter = s_InterpolatorForLabelSegmentation.find(image);
+  if (iter != s_InterpolatorForLabelSegmentation.end())
+  {
+    return iter->second;
+  }
+  else
+  {
+    return nullptr;
+  }
+}
+
 mitk::SegmentationInterpolationController::SegmentationInterpolationController()
   : m_SegmentationModifiedObserverTag(std::make_pair(0UL, false)),
+    m_LabelSegmentationModifiedObserverTag(std::make_pair(0UL, false)),
+    m_LabelValue(0),
     m_BlockModified(false),
     m_2DInterpolationActivated(false),
     m_EnableSliceImageCache(false)
@@ -91,22 +126,98 @@ mitk::SegmentationInterpolationController::~SegmentationInterpolationController(
       break;
     }
   }
+
+  this->ResetLabelSegmentation();
 }
 
 void mitk::SegmentationInterpolationController::OnImageModified(const itk::EventObject &)
 {
   if (!m_BlockModified && m_Segmentation.IsNotNull() && m_2DInterpolationActivated)
   {
-    SetSegmentationVolume(m_Segmentation);
+    this->InitializeSegmentationVolume(m_Segmentation);
+  }
+}
+
+void mitk::SegmentationInterpolationController::OnLabelSegmentationModified(const itk::EventObject &)
+{
+  if (m_BlockModified || m_LabelSegmentation.IsNull() || !m_2DInterpolationActivated)
+    return;
+
+  // the segmentation was changed without SetChangedLabelRegion(), so the mask has to be created again
+  LabelSetImage::ConstPointer segmentation = m_LabelSegmentation;
+
+  if (segmentation->ExistLabel(m_LabelValue))
+  {
+    this->SetSegmentationVolume(segmentation, m_LabelValue);
+  }
+  else
+  {
+    this->SetSegmentationVolume(nullptr);
   }
 }
 
+void mitk::SegmentationInterpolationController::ResetLabelSegmentation()
+{
+  if (m_LabelSegmentationModifiedObserverTag.second)
+  {
+    RemoveObserverFromConstObject(m_LabelSegmentation, m_LabelSegmentationModifiedObserverTag.first);
+    m_LabelSegmentationModifiedObserverTag.second = false;
+  }
+
+  for (auto iter = s_InterpolatorForLabelSegmentation.begin(); iter != s_InterpolatorForLabelSegmentation.end(); ++iter)
+  {
+    if (iter->second == this)
+    {
+      s_InterpolatorForLabelSegmentation.erase(iter);
+      break;
+    }
+  }
+
+  m_LabelSegmentation = nullptr;
+  m_LabelMask = nullptr;
+}
+
 void mitk::SegmentationInterpolationController::BlockModified(bool block)
 {
   m_BlockModified = block;
 }
 
 void mitk::SegmentationInterpolationController::SetSegmentationVolume(const Image *segmentation)
+{
+  this->ResetLabelSegmentation();
+  this->InitializeSegmentationVolume(segmentation);
+}
+
+void mitk::SegmentationInterpolationController::SetSegmentationVolume(const LabelSetImage *segmentation,
+                                                                      LabelSetImage::LabelValueType labelValue)
+{
+  if (nullptr == segmentation)
+  {
+    this->SetSegmentationVolume(nullptr);
+    return;
+  }
+
+  auto labelMask = CreateLabelMask(segmentation, labelValue);
+
+  this->ResetLabelSegmentation();
+  this->InitializeSegmentationVolume(labelMask);
+
+  if (m_Segmentation.IsNull())
+    return;
+
+  m_LabelSegmentation = segmentation;
+  m_LabelValue = labelValue;
+  m_LabelMask = labelMask;
+
+  auto command = itk::ReceptorMemberCommand<SegmentationInterpolationController>::New();
+  command->SetCallbackFunction(this, &SegmentationInterpolationController::OnLabelSegmentationModified);
+  m_LabelSegmentationModifiedObserverTag.first = segmentation->AddObserver(itk::ModifiedEvent(), command);
+  m_LabelSegmentationModifiedObserverTag.second = true;
+
+  s_InterpolatorForLabelSegmentation[segmentation] = this;
+}
+
+void mitk::SegmentationInterpolationController::InitializeSegmentationVolume(const Image *segmentation)
 {
   // clear old information (remove all time steps
   m_SegmentationCountInSlice.clear();
@@ -118,6 +229,13 @@ void mitk::SegmentationInterpolationController::SetSegmentationVolume(const Imag
     s_InterpolatorForImage.erase(iter);
   }
 
+  // the previous segmentation (e.g. a label mask that is replaced) is not interpolated by this anymore
+  iter = s_InterpolatorForImage.find(m_Segmentation);
+  if (iter != s_InterpolatorForImage.end() && iter->second == this)
+  {
+    s_InterpolatorForImage.erase(iter);
+  }
+
   if (m_SegmentationModifiedObserverTag.second)
   {
     RemoveObserverFromConstObject(m_Segmentation, m_SegmentationModifiedObserverTag.first);
@@ -264,6 +382,160 @@ void mitk::SegmentationInterpolationController::SetChangedSlice(const Image *sli
   Modified();
 }
 
+void mitk::SegmentationInterpolationController::SetChangedRegion(const Image *before,
+                                                                 const Image *after,
+                                                                 const itk::Index<3> &origin,
+                                                                 const itk::Offset<3> &axis0,
+                                                                 const itk::Offset<3> &axis1,
+                                                                 unsigned int timeStep)
+{
+  if (!before || !after)
+    return;
+  if (before->GetDimension() != 2 || before->GetPixelType() != after->GetPixelType() ||
+      before->GetDimension(0) != after->GetDimension(0) || before->GetDimension(1) != after->GetDimension(1))
+    return;
+  if (timeStep >= m_SegmentationCountInSlice.size())
+    return;
+
+  // without active interpolation the counts are not kept up to date (see OnImageModified())
+  if (!m_2DInterpolationActivated)
+    return;
+
+  AccessFixedDimensionByItk_n(before, ScanChangedRegion, 2, (after, origin, axis0, axis1, timeStep));
+
+  Modified();
+}
+
+template <typename TPixel, unsigned int VImageDimension>
+void mitk::SegmentationInterpolationController::ScanChangedRegion(const itk::Image<TPixel, VImageDimension> *before,
+                                                                  const Image *after,
+                                                                  const itk::Index<3> &origin,
+                                                                  const itk::Offset<3> &axis0,
+                                                                  const itk::Offset<3> &axis1,
+                                                                  unsigned int timeStep)
+{
+  mitk::ImageReadAccessor readAccess(after);
+  const auto *afterPixels = static_cast<const TPixel *>(readAccess.GetData());
+  const auto *beforePixels = before->GetBufferPointer();
+
+  const auto size = before->GetLargestPossibleRegion().GetSize();
+
+  for (itk::SizeValueType v = 0; v < size[1]; ++v)
+  {
+    for (itk::SizeValueType u = 0; u < size[0]; ++u, ++beforePixels, ++afterPixels)
+    {
+      if (*beforePixels == *afterPixels)
+        continue;
+
+      // the counts are the sums of the pixel values of the slices
+      const auto difference = static_cast<long long>(*afterPixels) - static_cast<long long>(*beforePixels);
+
+      this->ChangeCountsOfVoxel(GetVoxelOfRegion(origin, axis0, axis1, u, v), difference, timeStep);
+    }
+  }
+}
+
+void mitk::SegmentationInterpolationController::ChangeCountsOfVoxel(const itk::Index<3> &voxel,
+                                                                    long long difference,
+                                                                    unsigned int timeStep)
+{
+  auto &counts = m_SegmentationCountInSlice[timeStep];
+
+  for (unsigned int dim = 0; dim < 3; ++dim)
+  {
+    const auto index = voxel[dim];
+
+    if (index < 0 || index >= static_cast<itk::IndexValueType>(counts[dim].size()))
+      continue;
+
+    assert(static_cast<long long>(counts[dim][index]) + difference >= 0);
+    counts[dim][index] = static_cast<unsigned int>(counts[dim][index] + difference);
+  }
+}
+
+void mitk::SegmentationInterpolationController::SetChangedLabelRegion(const Image *before,
+                                                                      const Image *after,
+                                                                      const itk::Index<3> &origin,
+                                                                      const itk::Offset<3> &axis0,
+                                                                      const itk::Offset<3> &axis1,
+                                                                      unsigned int timeStep)
+{
+  if (m_LabelSegmentation.IsNull() || m_LabelMask.IsNull())
+    return;
+  if (!before || !after)
+    return;
+  if (before->GetDimension() != 2 || before->GetPixelType() != after->GetPixelType() ||
+      before->GetDimension(0) != after->GetDimension(0) || before->GetDimension(1) != after->GetDimension(1))
+    return;
+  if (timeStep >= m_SegmentationCountInSlice.size())
+    return;
+
+  // without active interpolation the mask is created again on the next activation
+  if (!m_2DInterpolationActivated)
+    return;
+
+  // the region is part of the active group, which does not contain the label
+  if (!m_LabelSegmentation->ExistLabel(m_LabelValue) ||
+      m_LabelSegmentation->GetGroupIndexOfLabel(m_LabelValue) != m_LabelSegmentation->GetActiveLayer())
+    return;
+
+  AccessFixedDimensionByItk_n(before, ScanChangedLabelRegion, 2, (after, origin, axis0, axis1, timeStep));
+
+  // the counts are already up to date, the mask must not be scanned again
+  const auto blockModified = m_BlockModified;
+  m_BlockModified = true;
+  m_LabelMask->Modified();
+  m_LabelMask->GetVtkImageData(timeStep)->Modified();
+  m_BlockModified = blockModified;
+
+  Modified();
+}
+
+template <typename TPixel, unsigned int VImageDimension>
+void mitk::SegmentationInterpolationController::ScanChangedLabelRegion(const itk::Image<TPixel, VImageDimension> *before,
+                                                                       const Image *after,
+                                                                       const itk::Index<3> &origin,
+                                                                       const itk::Offset<3> &axis0,
+                                                                       const itk::Offset<3> &axis1,
+                                                                       unsigned int timeStep)
+{
+  mitk::ImageReadAccessor readAccess(after);
+  const auto *afterPixels = static_cast<const TPixel *>(readAccess.GetData());
+  const auto *beforePixels = before->GetBufferPointer();
+
+  mitk::ImageWriteAccessor writeAccess(m_LabelMask, m_LabelMask->GetVolumeData(timeStep));
+  auto *maskPixels = static_cast<TPixel *>(writeAccess.GetData());
+
+  const auto size = before->GetLargestPossibleRegion().GetSize();
+  const auto labelValue = static_cast<TPixel>(m_LabelValue);
+
+  const itk::IndexValueType maskSize[3] = {static_cast<itk::IndexValueType>(m_LabelMask->GetDimension(0)),
+                                           static_cast<itk::IndexValueType>(m_LabelMask->GetDimension(1)),
+                                           static_cast<itk::IndexValueType>(m_LabelMask->GetDimension(2))};
+
+  for (itk::SizeValueType v = 0; v < size[1]; ++v)
+  {
+    for (itk::SizeValueType u = 0; u < size[0]; ++u, ++beforePixels, ++afterPixels)
+    {
+      const bool wasLabel = labelValue == *beforePixels;
+      const bool isLabel = labelValue == *afterPixels;
+
+      if (wasLabel == isLabel)
+        continue;
+
+      const auto voxel = GetVoxelOfRegion(origin, axis0, axis1, u, v);
+
+      if (voxel[0] < 0 || voxel[0] >= maskSize[0] || voxel[1] < 0 || voxel[1] >= maskSize[1] || voxel[2] < 0 ||
+          voxel[2] >= maskSize[2])
+        continue;
+
+      maskPixels[voxel[0] + maskSize[0] * (voxel[1] + maskSize[1] * voxel[2])] = isLabel ? 1 : 0;
+
+      this->ChangeCountsOfVoxel(voxel, isLabel ? 1 : -1, timeStep);
+    }
+  }
+}
+
 template <typename DATATYPE>
 void mitk::SegmentationInterpolationController::ScanChangedSlice(const itk::Image<DATATYPE, 2> *,
                                                                  const SetChangedSliceOptions &options)
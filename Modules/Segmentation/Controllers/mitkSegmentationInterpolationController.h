@@ -15,6 +15,7 @@ found in the LICENSE file.
 
 #include "mitkCommon.h"
 #include "mitkImage.h"
+#include <mitkLabelSetImage.h>
 #include <MitkSegmentationExports.h>
 #include <mitkShapeBasedInterpolationAlgorithm.h>
 
@@ -55,6 +56,11 @@ namespace mitk
     is an interpolator
     instance for a specified image. OverwriteImageFilter uses this to get to know its interpolator.
 
+    To interpolate one label of a multi-label segmentation, pass the segmentation and the label to
+    SetSegmentationVolume(const LabelSetImage*, LabelSetImage::LabelValueType). The controller then interpolates
+    a binary mask of the label, which it keeps up to date when a region of the segmentation changes
+    (see InterpolatorForLabelSegmentation() and SetChangedLabelRegion()).
+
     SegmentationInterpolationController needs to maintain some information about the image slices (in every dimension).
     This information is stored internally in m_SegmentationCountInSlice, which is basically three std::vectors (one for
     each dimension).
@@ -78,6 +84,12 @@ namespace mitk
        */
       static SegmentationInterpolationController *InterpolatorForImage(const Image *);
 
+    /**
+      \brief Find the interpolator that interpolates a label of the given multi-label segmentation.
+      \return nullptr if there is none.
+     */
+    static SegmentationInterpolationController *InterpolatorForLabelSegmentation(const Image *);
+
     /**
       \brief Block reaction to an images Modified() events.
 
@@ -99,6 +111,17 @@ namespace mitk
     */
     void SetSegmentationVolume(const Image *segmentation);
 
+    /**
+      \brief Initialize with one label of a multi-label segmentation.
+
+      Creates the binary mask of the label (see CreateLabelMask()) and initializes the controller with it.
+      Changed regions of the segmentation can be passed by SetChangedLabelRegion(). Any other modification of
+      the segmentation creates the mask again, unless it is blocked by BlockModified().
+
+      \throw mitk::Exception if the label does not exist.
+    */
+    void SetSegmentationVolume(const LabelSetImage *segmentation, LabelSetImage::LabelValueType labelValue);
+
     /**
       \brief Set a reference image (original patient image) - optional.
 
@@ -126,6 +149,41 @@ namespace mitk
                          unsigned int timeStep);
     void SetChangedVolume(const Image *sliceDiff, unsigned int timeStep);
 
+    /**
+      \brief Update after changing a region of a single slice.
+
+      Only the changed voxels are scanned, which is much cheaper than SetChangedSlice() for small edits.
+      The voxel of pixel (i, j) of the region images is origin + i * axis0 + j * axis1.
+
+      \param before 2D image with the voxel values of the region before the change.
+      \param after 2D image of the same size and pixel type with the voxel values after the change.
+      \param origin Index of the voxel of the first pixel of the region images.
+      \param axis0 Offset between the voxels of neighboring pixels in the first dimension of the region images.
+      \param axis1 Offset between the voxels of neighboring pixels in the second dimension of the region images.
+      \param timeStep Which time step is changed
+    */
+    void SetChangedRegion(const Image *before,
+                          const Image *after,
+                          const itk::Index<3> &origin,
+                          const itk::Offset<3> &axis0,
+                          const itk::Offset<3> &axis1,
+                          unsigned int timeStep);
+
+    /**
+      \brief Update after changing a region of a single slice of the multi-label segmentation.
+
+      The parameters are the same as for SetChangedRegion(), but the region images contain the label values of the
+      active group of the segmentation passed to SetSegmentationVolume(const LabelSetImage*, LabelSetImage::LabelValueType).
+      The changed voxels of the interpolated label are written into its mask and counted. Changes of other groups
+      are ignored.
+    */
+    void SetChangedLabelRegion(const Image *before,
+                               const Image *after,
+                               const itk::Index<3> &origin,
+                               const itk::Offset<3> &axis0,
+                               const itk::Offset<3> &axis1,
+                               unsigned int timeStep);
+
     /**
       \brief Generates an interpolated image for the given slice.
 
@@ -201,6 +259,33 @@ namespace mitk
     template <typename DATATYPE>
     void ScanChangedSlice(const itk::Image<DATATYPE, 2> *, const SetChangedSliceOptions &options);
 
+    template <typename TPixel, unsigned int VImageDimension>
+    void ScanChangedRegion(const itk::Image<TPixel, VImageDimension> *before,
+                           const Image *after,
+                           const itk::Index<3> &origin,
+                           const itk::Offset<3> &axis0,
+                           const itk::Offset<3> &axis1,
+                           unsigned int timeStep);
+
+    template <typename TPixel, unsigned int VImageDimension>
+    void ScanChangedLabelRegion(const itk::Image<TPixel, VImageDimension> *before,
+                                const Image *after,
+                                const itk::Index<3> &origin,
+                                const itk::Offset<3> &axis0,
+                                const itk::Offset<3> &axis1,
+                                unsigned int timeStep);
+
+    /// adds difference to the counts of the three slices that contain the voxel
+    void ChangeCountsOfVoxel(const itk::Index<3> &voxel, long long difference, unsigned int timeStep);
+
+    /// initializes the counts and registers this controller, without touching the label segmentation
+    void InitializeSegmentationVolume(const Image *segmentation);
+
+    /// forgets the label segmentation and removes this controller from the list of label interpolators
+    void ResetLabelSegmentation();
+
+    void OnLabelSegmentationModified(const itk::EventObject &);
+
     template <typename TPixel, unsigned int VImageDimension>
     void ScanChangedVolume(const itk::Image<TPixel, VImageDimension> *, unsigned int timeStep);
 
@@ -226,9 +311,14 @@ namespace mitk
     TimeResolvedDirtyVectorType m_SegmentationCountInSlice;
 
     static InterpolatorMapType s_InterpolatorForImage;
+    static InterpolatorMapType s_InterpolatorForLabelSegmentation;
 
     Image::ConstPointer m_Segmentation;
     std::pair<unsigned long, bool> m_SegmentationModifiedObserverTag; // first: actual tag, second: tag assigned / valid?
+    LabelSetImage::ConstPointer m_LabelSegmentation;
+    std::pair<unsigned long, bool> m_LabelSegmentationModifiedObserverTag;
+    LabelSetImage::LabelValueType m_LabelValue;
+    Image::Pointer m_LabelMask; // the segmentation in label mode, i.e. the binary mask of the label
     Image::ConstPointer m_ReferenceImage;
     bool m_BlockModified;
     bool m_2DInterpolationActivated;
@@ -0,0 +1,728 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include <mitkInferenceWorker.h>
+
+#include <mitkExceptionMacro.h>
+#include <mitkImageReadAccessor.h>
+#include <mitkLabel.h>
+
+#include <itksys/Process.h>
+
+#include <nlohmann/json.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <list>
+#include <mutex>
+#include <sstream>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#ifndef _WIN32
+#include <cerrno>
+#include <csignal>
+#include <fcntl.h>
+#include <pthread.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace
+{
+  const std::string READY_SIGNAL = "READY";
+  const std::string DONE_SIGNAL = "DONE";
+  const std::string ERROR_SIGNAL = "ERROR";
+
+  // seconds a worker is given to exit after its stdin was closed
+  constexpr double StopGracePeriod = 10.0;
+
+  std::string TrimLine(const std::string &line)
+  {
+    const auto end = line.find_last_not_of(" \t\r\n");
+    return std::string::npos != end ? line.substr(0, end + 1) : std::string();
+  }
+
+#ifndef _WIN32
+  /** Shared memory segment that is kept mapped and reused for subsequent requests of the same or smaller size. */
+  class SharedMemorySegment
+  {
+  public:
+    explicit SharedMemorySegment(const std::string &name)
+      : m_Name(name)
+    {
+    }
+
+    ~SharedMemorySegment()
+    {
+      this->Release();
+    }
+
+    SharedMemorySegment(const SharedMemorySegment &) = delete;
+    SharedMemorySegment &operator=(const SharedMemorySegment &) = delete;
+
+    const std::string &GetName() const
+    {
+      return m_Name;
+    }
+
+    void *Reserve(std::size_t size)
+    {
+      if (size <= m_Size)
+        return m_Data;
+
+      this->Release();
+
+      const int fd = shm_open(m_Name.c_str(), O_CREAT | O_RDWR, S_IRUSR | S_IWUSR);
+
+      if (-1 == fd)
+        mitkThrow() << "Could not create shared memory \"" << m_Name << "\": " << std::strerror(errno);
+
+      if (-1 == ftruncate(fd, static_cast<off_t>(size)))
+      {
+        const auto error = errno;
+        close(fd);
+        shm_unlink(m_Name.c_str());
+        mitkThrow() << "Could not resize shared memory \"" << m_Name << "\" to " << size << " bytes: " << std::strerror(error);
+      }
+
+      void *data = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+      const auto error = errno;
+      close(fd);
+
+      if (MAP_FAILED == data)
+      {
+        shm_unlink(m_Name.c_str());
+        mitkThrow() << "Could not map shared memory \"" << m_Name << "\": " << std::strerror(error);
+      }
+
+      m_Data = data;
+      m_Size = size;
+
+      return m_Data;
+    }
+
+    void Release()
+    {
+      if (nullptr != m_Data)
+      {
+        munmap(m_Data, m_Size);
+        shm_unlink(m_Name.c_str());
+        m_Data = nullptr;
+        m_Size = 0;
+      }
+    }
+
+  private:
+    std::string m_Name;
+    void *m_Data = nullptr;
+    std::size_t m_Size = 0;
+  };
+
+  /** Writes to a pipe without raising SIGPIPE if the reading process has already exited. */
+  bool WriteToPipe(int fd, const std::string &data)
+  {
+    sigset_t sigPipeSet;
+    sigset_t previousSet;
+    sigemptyset(&sigPipeSet);
+    sigaddset(&sigPipeSet, SIGPIPE);
+    pthread_sigmask(SIG_BLOCK, &sigPipeSet, &previousSet);
+
+    sigset_t pendingSet;
+    sigpending(&pendingSet);
+    const bool wasPending = 1 == sigismember(&pendingSet, SIGPIPE);
+
+    const char *buffer = data.data();
+    std::size_t remaining = data.size();
+    bool success = true;
+
+    while (0 < remaining)
+    {
+      const auto written = write(fd, buffer, remaining);
+
+      if (written < 0)
+      {
+        if (EINTR == errno)
+          continue;
+
+        success = false;
+        break;
+      }
+
+      buffer += written;
+      remaining -= static_cast<std::size_t>(written);
+    }
+
+    if (!success && !wasPending)
+    {
+      // consume the SIGPIPE raised by this write before it is unblocked again
+      sigpending(&pendingSet);
+
+      if (1 == sigismember(&pendingSet, SIGPIPE))
+      {
+        int signal = 0;
+        sigwait(&sigPipeSet, &signal);
+      }
+    }
+
+    pthread_sigmask(SIG_SETMASK, &previousSet, nullptr);
+
+    return success;
+  }
+#endif
+}
+
+class mitk::InferenceWorker::Impl
+{
+public:
+  struct Reply
+  {
+    bool Success;
+    std::string Message;
+  };
+
+  /** Key of cached results: content hash and description of the geometry, pixel type and parameters. */
+  using CacheKeyType = std::pair<std::size_t, std::string>;
+
+  /** Cached result. The input pixels are kept to rule out hash collisions on lookup. */
+  struct CacheEntry
+  {
+    CacheKeyType Key;
+    std::vector<char> Input;
+    Image::Pointer Output;
+    std::size_t Size;
+  };
+
+  Impl();
+  ~Impl();
+
+  void Launch(const std::string &workingDirectory);
+  bool Send(const std::string &line);
+  void Shutdown();
+  void ReadOutput();
+  void ProcessOutput(std::string &buffer, const char *data, int length, bool isStdOut);
+  void ShrinkCache(std::size_t maximumCacheSize);
+
+  ArgumentListType Command;
+
+  itksysProcess *Process;
+  int StdIn;
+  std::thread Reader;
+  std::atomic<bool> StopRequested;
+
+  std::mutex Mutex;
+  std::condition_variable Condition;
+  bool IsReady;
+  bool HasExited;
+  std::map<std::string, Reply> Replies;
+
+#ifndef _WIN32
+  SharedMemorySegment InputSegment;
+  SharedMemorySegment OutputSegment;
+#endif
+
+  unsigned int NumberOfRequests;
+  std::list<CacheEntry> Cache;
+  std::size_t CacheSize;
+};
+
+namespace
+{
+  std::string CreateSegmentName(const char *suffix)
+  {
+    static std::atomic<unsigned int> count(0);
+    std::ostringstream name;
+#ifndef _WIN32
+    name << "/mitk-iw-" << getpid() << '-' << count++ << '-' << suffix;
+#else
+    name << "mitk-iw-" << count++ << '-' << suffix;
+#endif
+    return name.str();
+  }
+}
+
+mitk::InferenceWorker::Impl::Impl()
+  : Process(nullptr),
+    StdIn(-1),
+    StopRequested(false),
+    IsReady(false),
+    HasExited(true),
+#ifndef _WIN32
+    InputSegment(CreateSegmentName("in")),
+    OutputSegment(CreateSegmentName("out")),
+#endif
+    NumberOfRequests(0),
+    CacheSize(0)
+{
+}
+
+mitk::InferenceWorker::Impl::~Impl()
+{
+  this->Shutdown();
+}
+
+void mitk::InferenceWorker::Impl::Launch(const std::string &workingDirectory)
+{
+#ifndef _WIN32
+  int pipeFds[2];
+
+  if (0 != pipe(pipeFds))
+    mitkThrow() << "Could not create pipe for inference worker: " << std::strerror(errno);
+
+  // neither end must leak into the worker (its stdin is a duplicate of the read end)
+  fcntl(pipeFds[0], F_SETFD, FD_CLOEXEC);
+  fcntl(pipeFds[1], F_SETFD, FD_CLOEXEC);
+
+  std::vector<const char *> arguments;
+
+  for (const auto &argument : this->Command)
+    arguments.push_back(argument.c_str());
+
+  arguments.push_back(nullptr);
+
+  this->Process = itksysProcess_New();
+  itksysProcess_SetCommand(this->Process, arguments.data());
+
+  if (!workingDirectory.empty())
+    itksysProcess_SetWorkingDirectory(this->Process, workingDirectory.c_str());
+
+  itksysProcess_SetPipeNative(this->Process, itksysProcess_Pipe_STDIN, pipeFds);
+  itksysProcess_Execute(this->Process);
+  close(pipeFds[0]);
+
+  if (itksysProcess_State_Executing != itksysProcess_GetState(this->Process))
+  {
+    close(pipeFds[1]);
+    const std::string error = itksysProcess_GetErrorString(this->Process);
+    itksysProcess_Delete(this->Process);
+    this->Process = nullptr;
+
+    mitkThrow() << "Could not start inference worker \"" << this->Command.front() << "\": " << error;
+  }
+
+  this->StdIn = pipeFds[1];
+
+  {
+    std::lock_guard<std::mutex> lock(this->Mutex);
+    this->IsReady = false;
+    this->HasExited = false;
+    this->Replies.clear();
+  }
+
+  this->StopRequested = false;
+  this->Reader = std::thread(&Impl::ReadOutput, this);
+#else
+  (void)workingDirectory;
+  mitkThrow() << "Inference workers are not supported on this platform.";
+#endif
+}
+
+bool mitk::InferenceWorker::Impl::Send(const std::string &line)
+{
+#ifndef _WIN32
+  return -1 != this->StdIn && WriteToPipe(this->StdIn, line + '\n');
+#else
+  (void)line;
+  return false;
+#endif
+}
+
+void mitk::InferenceWorker::Impl::Shutdown()
+{
+  if (nullptr == this->Process)
+    return;
+
+#ifndef _WIN32
+  if (-1 != this->StdIn)
+  {
+    close(this->StdIn);
+    this->StdIn = -1;
+  }
+#endif
+
+  this->StopRequested = true;
+
+  if (this->Reader.joinable())
+    this->Reader.join();
+
+  itksysProcess_Delete(this->Process);
+  this->Process = nullptr;
+
+  std::lock_guard<std::mutex> lock(this->Mutex);
+  this->IsReady = false;
+  this->HasExited = true;
+}
+
+void mitk::InferenceWorker::Impl::ReadOutput()
+{
+  std::string stdOut;
+  std::string stdErr;
+  std::chrono::steady_clock::time_point stopTime;
+  bool isStopping = false;
+
+  while (true)
+  {
+    char *data = nullptr;
+    int length = 0;
+    double timeout = 0.1;
+
+    const int pipe = itksysProcess_WaitForData(this->Process, &data, &length, &timeout);
+
+    if (itksysProcess_Pipe_STDOUT == pipe)
+    {
+      this->ProcessOutput(stdOut, data, length, true);
+    }
+    else if (itksysProcess_Pipe_STDERR == pipe)
+    {
+      this->ProcessOutput(stdErr, data, length, false);
+    }
+    else if (itksysProcess_Pipe_None == pipe)
+    {
+      break;
+    }
+    else if (this->StopRequested)
+    {
+      if (!isStopping)
+      {
+        stopTime = std::chrono::steady_clock::now();
+        isStopping = true;
+      }
+      else if (std::chrono::duration<double>(std::chrono::steady_clock::now() - stopTime).count() > StopGracePeriod)
+      {
+        MITK_WARN << "Inference worker did not exit in time and is killed.";
+        itksysProcess_Kill(this->Process);
+      }
+    }
+  }
+
+  itksysProcess_WaitForExit(this->Process, nullptr);
+
+  if (itksysProcess_State_Exited != itksysProcess_GetState(this->Process) && !this->StopRequested)
+    MITK_ERROR << "Inference worker terminated abnormally.";
+
+  std::lock_guard<std::mutex> lock(this->Mutex);
+  this->IsReady = false;
+  this->HasExited = true;
+  this->Condition.notify_all();
+}
+
+void mitk::InferenceWorker::Impl::ProcessOutput(std::string &buffer, const char *data, int length, bool isStdOut)
+{
+  buffer.append(data, static_cast<std::size_t>(length));
+
+  std::string::size_type lineEnd;
+
+  while (std::string::npos != (lineEnd = buffer.find('\n')))
+  {
+    const auto line = TrimLine(buffer.substr(0, lineEnd));
+    buffer.erase(0, lineEnd + 1);
+
+    if (line.empty())
+      continue;
+
+    if (!isStdOut)
+    {
+      MITK_WARN << "Inference worker: " << line;
+      continue;
+    }
+
+    std::istringstream stream(line);
+    std::string signal;
+    std::string uid;
+    stream >> signal >> uid;
+
+    if (READY_SIGNAL == signal)
+    {
+      std::lock_guard<std::mutex> lock(this->Mutex);
+      this->IsReady = true;
+      this->Condition.notify_all();
+    }
+    else if ((DONE_SIGNAL == signal || ERROR_SIGNAL == signal) && !uid.empty())
+    {
+      std::string message;
+      std::getline(stream >> std::ws, message);
+
+      std::lock_guard<std::mutex> lock(this->Mutex);
+      this->Replies[uid] = Reply{ DONE_SIGNAL == signal, message };
+      this->Condition.notify_all();
+    }
+    else
+    {
+      MITK_INFO << "Inference worker: " << line;
+    }
+  }
+}
+
+void mitk::InferenceWorker::Impl::ShrinkCache(std::size_t maximumCacheSize)
+{
+  // least recently used results are at the back
+  while (this->CacheSize > maximumCacheSize)
+  {
+    this->CacheSize -= this->Cache.back().Size;
+    this->Cache.pop_back();
+  }
+}
+
+bool mitk::InferenceWorker::IsSupported()
+{
+#ifndef _WIN32
+  return true;
+#else
+  return false;
+#endif
+}
+
+mitk::InferenceWorker::InferenceWorker()
+  : m_Impl(std::make_unique<Impl>()),
+    m_Timeout(3600.0),
+    m_MaximumCacheSize(512 * 1024 * 1024),
+    m_NumberOfCacheHits(0)
+{
+}
+
+mitk::InferenceWorker::~InferenceWorker()
+{
+}
+
+void mitk::InferenceWorker::SetCommand(const ArgumentListType &command)
+{
+  if (m_Impl->Command != command)
+  {
+    // results of another worker must not be returned
+    m_Impl->Shutdown();
+    this->ClearCache();
+
+    m_Impl->Command = command;
+    this->Modified();
+  }
+}
+
+const mitk::InferenceWorker::ArgumentListType &mitk::InferenceWorker::GetCommand() const
+{
+  return m_Impl->Command;
+}
+
+void mitk::InferenceWorker::SetMaximumCacheSize(std::size_t maximumCacheSize)
+{
+  if (m_MaximumCacheSize != maximumCacheSize)
+  {
+    m_MaximumCacheSize = maximumCacheSize;
+    m_Impl->ShrinkCache(m_MaximumCacheSize);
+    this->Modified();
+  }
+}
+
+std::size_t mitk::InferenceWorker::GetCacheSize() const
+{
+  return m_Impl->CacheSize;
+}
+
+void mitk::InferenceWorker::Start()
+{
+  if (!IsSupported())
+    mitkThrow() << "Inference workers are not supported on this platform.";
+
+  if (this->IsRunning())
+    return;
+
+  // clean up a worker that exited on its own
+  m_Impl->Shutdown();
+
+  if (m_Impl->Command.empty())
+    mitkThrow() << "No inference worker command specified.";
+
+  m_Impl->Launch(m_WorkingDirectory);
+
+  std::unique_lock<std::mutex> lock(m_Impl->Mutex);
+
+  m_Impl->Condition.wait_for(lock, std::chrono::duration<double>(m_Timeout), [this]() {
+    return m_Impl->IsReady || m_Impl->HasExited;
+  });
+
+  if (!m_Impl->IsReady)
+  {
+    const bool hasExited = m_Impl->HasExited;
+    lock.unlock();
+    this->Stop();
+
+    if (hasExited)
+      mitkThrow() << "Inference worker exited before it got ready.";
+
+    mitkThrow() << "Inference worker did not get ready within " << m_Timeout << " s.";
+  }
+}
+
+void mitk::InferenceWorker::Stop()
+{
+  m_Impl->Shutdown();
+}
+
+bool mitk::InferenceWorker::IsRunning() const
+{
+  std::lock_guard<std::mutex> lock(m_Impl->Mutex);
+  return nullptr != m_Impl->Process && !m_Impl->HasExited;
+}
+
+void mitk::InferenceWorker::ClearCache()
+{
+  m_Impl->Cache.clear();
+  m_Impl->CacheSize = 0;
+}
+
+mitk::Image::Pointer mitk::InferenceWorker::Run(const Image *input, const ParametersType &parameters)
+{
+  if (nullptr == input || !input->IsInitialized())
+    mitkThrow() << "Invalid input image for inference worker.";
+
+  const auto pixelType = input->GetPixelType();
+
+  if (1 != pixelType.GetNumberOfComponents())
+    mitkThrow() << "Inference workers only support scalar images.";
+
+  if (3 < input->GetDimension())
+    mitkThrow() << "Inference workers only support 2D and 3D images.";
+
+  ImageReadAccessor accessor(input);
+
+  std::vector<unsigned int> dimensions(3, 1);
+  std::size_t numberOfPixels = 1;
+
+  for (unsigned int i = 0; i < input->GetDimension(); ++i)
+  {
+    dimensions[i] = input->GetDimension(i);
+    numberOfPixels *= dimensions[i];
+  }
+
+  const auto *geometry = input->GetGeometry();
+  const auto spacing = geometry->GetSpacing();
+  const auto origin = geometry->GetOrigin();
+  const auto matrix = geometry->GetIndexToWorldTransform()->GetMatrix();
+
+  std::vector<double> direction;
+
+  for (unsigned int row = 0; row < 3; ++row)
+  {
+    for (unsigned int column = 0; column < 3; ++column)
+      direction.push_back(matrix[row][column] / spacing[column]);
+  }
+
+  nlohmann::json inputDescription = {
+    {"pixelType", pixelType.GetComponentTypeAsString()},
+    {"dimensions", dimensions},
+    {"spacing", {spacing[0], spacing[1], spacing[2]}},
+    {"origin", {origin[0], origin[1], origin[2]}},
+    {"direction", direction}
+  };
+
+  nlohmann::json parametersDescription(parameters);
+
+  const auto inputBytes = numberOfPixels * pixelType.GetSize();
+  const auto *inputData = static_cast<const char *>(accessor.GetData());
+
+  const Impl::CacheKeyType cacheKey(
+    std::hash<std::string_view>()(std::string_view(inputData, inputBytes)),
+    inputDescription.dump() + parametersDescription.dump());
+
+  auto &cache = m_Impl->Cache;
+
+  for (auto iter = cache.begin(); iter != cache.end(); ++iter)
+  {
+    if (iter->Key == cacheKey && std::equal(iter->Input.begin(), iter->Input.end(), inputData, inputData + inputBytes))
+    {
+      cache.splice(cache.begin(), cache, iter);
+      ++m_NumberOfCacheHits;
+      return cache.front().Output;
+    }
+  }
+
+  this->Start();
+
+#ifndef _WIN32
+  const auto outputBytes = numberOfPixels * sizeof(Label::PixelType);
+
+  std::memcpy(m_Impl->InputSegment.Reserve(inputBytes), inputData, inputBytes);
+  auto *outputData = m_Impl->OutputSegment.Reserve(outputBytes);
+  std::memset(outputData, 0, outputBytes);
+
+  inputDescription["shm"] = m_Impl->InputSegment.GetName();
+  inputDescription["bytes"] = inputBytes;
+
+  const auto uid = "request-" + std::to_string(++m_Impl->NumberOfRequests);
+
+  nlohmann::json request = {
+    {"uid", uid},
+    {"input", inputDescription},
+    {"output", {
+      {"shm", m_Impl->OutputSegment.GetName()},
+      {"bytes", outputBytes},
+      {"pixelType", MakeScalarPixelType<Label::PixelType>().GetComponentTypeAsString()}
+    }},
+    {"parameters", parametersDescription}
+  };
+
+  if (!m_Impl->Send(request.dump()))
+  {
+    this->Stop();
+    mitkThrow() << "Could not send request to inference worker.";
+  }
+
+  std::unique_lock<std::mutex> lock(m_Impl->Mutex);
+
+  m_Impl->Condition.wait_for(lock, std::chrono::duration<double>(m_Timeout), [this, &uid]() {
+    return 0 != m_Impl->Replies.count(uid) || m_Impl->HasExited;
+  });
+
+  auto replyIter = m_Impl->Replies.find(uid);
+
+  if (m_Impl->Replies.end() == replyIter)
+  {
+    const bool hasExited = m_Impl->HasExited;
+    lock.unlock();
+    this->Stop();
+
+    if (hasExited)
+      mitkThrow() << "Inference worker exited unexpectedly.";
+
+    mitkThrow() << "Inference worker did not answer within " << m_Timeout << " s.";
+  }
+
+  const auto reply = replyIter->second;
+  m_Impl->Replies.erase(replyIter);
+  lock.unlock();
+
+  if (!reply.Success)
+    mitkThrow() << "Inference failed: " << reply.Message;
+
+  auto output = Image::New();
+  output->Initialize(MakeScalarPixelType<Label::PixelType>(), input->GetDimension(), input->GetDimensions());
+  output->SetGeometry(geometry->Clone());
+  output->SetVolume(outputData);
+
+  const auto entrySize = inputBytes + outputBytes;
+
+  if (entrySize <= m_MaximumCacheSize)
+  {
+    m_Impl->ShrinkCache(m_MaximumCacheSize - entrySize);
+    cache.push_front({cacheKey, std::vector<char>(inputData, inputData + inputBytes), output, entrySize});
+    m_Impl->CacheSize += entrySize;
+  }
+
+  return output;
+#else
+  mitkThrow() << "Inference workers are not supported on this platform.";
+#endif
+}
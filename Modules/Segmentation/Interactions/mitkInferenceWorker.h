@@ -0,0 +1,142 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef mitkInferenceWorker_h
+#define mitkInferenceWorker_h
+
+#include <MitkSegmentationExports.h>
+#include <mitkImage.h>
+#include <mitkProcessExecutor.h>
+
+#include <map>
+#include <memory>
+#include <string>
+
+namespace mitk
+{
+  /**
+   * @brief Client of a persistent local inference worker process.
+   *
+   * Instead of starting a new process for every inference, the worker is started once and keeps its models
+   * loaded between requests. Image buffers are exchanged through POSIX shared memory and results are cached
+   * by a hash of the input content and the request parameters, so that repeated preview updates of the same
+   * input do not run the inference again. The cache keeps a copy of each input next to its result and is
+   * bounded by their total size in bytes, see SetMaximumCacheSize().
+   *
+   * The worker is an arbitrary command that implements the following line-based protocol:
+   *
+   * - It prints "READY" to stdout as soon as it accepts requests.
+   * - It reads one JSON object per line from stdin:
+   *   \code
+   *   {
+   *     "uid": "<request id>",
+   *     "input": { "shm": "<shared memory name>", "bytes": 0, "pixelType": "short",
+   *                "dimensions": [x, y, z], "spacing": [x, y, z], "origin": [x, y, z],
+   *                "direction": [9 values, row-major] },
+   *     "output": { "shm": "<shared memory name>", "bytes": 0, "pixelType": "unsigned_short" },
+   *     "parameters": { "<key>": "<value>", ... }
+   *   }
+   *   \endcode
+   *   Pixel types are named like in mitk::PixelType::GetComponentTypeAsString(). Shared memory names are
+   *   given as passed to shm_open(), i.e., including the leading slash.
+   * - It writes the label image into the output shared memory (same dimensions as the input, x fastest) and
+   *   prints "DONE <uid>", or prints "ERROR <uid> <message>" if the request failed.
+   * - It exits when stdin is closed.
+   *
+   * Any other output of the worker is logged.
+   *
+   * @remark Shared memory exchange is only supported on POSIX systems, see IsSupported(). Tools fall back
+   * to running a process per inference otherwise.
+   */
+  class MITKSEGMENTATION_EXPORT InferenceWorker : public itk::Object
+  {
+  public:
+    mitkClassMacroItkParent(InferenceWorker, itk::Object);
+    itkFactorylessNewMacro(Self);
+
+    using ArgumentListType = ProcessExecutor::ArgumentListType;
+    using ParametersType = std::map<std::string, std::string>;
+
+    /** @brief Returns true if inference workers are supported on this platform. */
+    static bool IsSupported();
+
+    /**
+     * @brief Executable and arguments of the worker (executable first).
+     *
+     * Changing the command stops a running worker and clears the cache, the new worker is started on the
+     * next request.
+     */
+    void SetCommand(const ArgumentListType &command);
+    const ArgumentListType &GetCommand() const;
+
+    itkSetMacro(WorkingDirectory, std::string);
+    itkGetConstMacro(WorkingDirectory, std::string);
+
+    /** @brief Seconds to wait for the worker to get ready or to answer a request (default 3600). */
+    itkSetMacro(Timeout, double);
+    itkGetConstMacro(Timeout, double);
+
+    /**
+     * @brief Maximum total size in bytes of the cached inputs and results (default 512 MiB). 0 disables the cache.
+     *
+     * The least recently used results are evicted first. Results whose input and output alone exceed the
+     * maximum are not cached at all.
+     */
+    void SetMaximumCacheSize(std::size_t maximumCacheSize);
+    itkGetConstMacro(MaximumCacheSize, std::size_t);
+
+    /** @brief Current total size in bytes of the cached inputs and results. */
+    std::size_t GetCacheSize() const;
+
+    /** @brief Number of requests that were answered from the cache. */
+    itkGetConstMacro(NumberOfCacheHits, unsigned int);
+
+    /**
+     * @brief Starts the worker if it is not running yet and waits until it is ready.
+     *
+     * @throw mitk::Exception if the worker could not be started or did not get ready in time.
+     */
+    void Start();
+
+    /** @brief Closes stdin of the worker and waits for it to exit, or kills it after a grace period. */
+    void Stop();
+
+    bool IsRunning() const;
+
+    /**
+     * @brief Returns the label image the worker computed for the given 3D scalar image.
+     *
+     * The worker is started if necessary. The result has the geometry of the input and is shared with the
+     * cache, i.e., it must not be modified.
+     *
+     * @throw mitk::Exception if the input is not supported, the worker failed or did not answer in time.
+     */
+    Image::Pointer Run(const Image *input, const ParametersType &parameters);
+
+    void ClearCache();
+
+  protected:
+    InferenceWorker();
+    ~InferenceWorker() override;
+
+  private:
+    class Impl;
+    std::unique_ptr<Impl> m_Impl;
+
+    std::string m_WorkingDirectory;
+    double m_Timeout;
+    std::size_t m_MaximumCacheSize;
+    unsigned int m_NumberOfCacheHits;
+  };
+}
+
+#endif
@@ -383,60 +383,16 @@ void mitk::PaintbrushTool::MouseMoved(mitk::InteractionEvent *interactionEvent,
 
   if (leftMouseButtonPressed)
   {
-    ContourModelUtils::FillContourInSlice2(contour, m_PaintingSlice, m_InternalFillValue);
-
-    const double dist = indexCoordinates.EuclideanDistanceTo(m_LastPosition);
-    const double radius = static_cast<double>(m_Size) / 2.0;
-
-    // if points are >= radius away draw rectangle to fill empty holes
-    // in between the 2 points
-    if (dist > radius)
-    {
-      const mitk::Point3D &currentPos = indexCoordinates;
-      mitk::Point3D direction;
-      mitk::Point3D vertex;
-      mitk::Point3D normal;
-
-      direction[0] = indexCoordinates[0] - m_LastPosition[0];
-      direction[1] = indexCoordinates[1] - m_LastPosition[1];
-      direction[2] = indexCoordinates[2] - m_LastPosition[2];
-
-      direction[0] = direction.GetVnlVector().normalize()[0];
-      direction[1] = direction.GetVnlVector().normalize()[1];
-      direction[2] = direction.GetVnlVector().normalize()[2];
-
-      // 90 degrees rotation of direction
-      normal[0] = -1.0 * direction[1];
-      normal[1] = direction[0];
-
-      auto gapContour = ContourModel::New();
-
-      // upper left corner
-      vertex[0] = m_LastPosition[0] + (normal[0] * radius);
-      vertex[1] = m_LastPosition[1] + (normal[1] * radius);
-
-      gapContour->AddVertex(vertex);
-
-      // upper right corner
-      vertex[0] = currentPos[0] + (normal[0] * radius);
-      vertex[1] = currentPos[1] + (normal[1] * radius);
-
-      gapContour->AddVertex(vertex);
-
-      // lower right corner
-      vertex[0] = currentPos[0] - (normal[0] * radius);
-      vertex[1] = currentPos[1] - (normal[1] * radius);
-
-      gapContour->AddVertex(vertex);
-
-      // lower left corner
-      vertex[0] = m_LastPosition[0] - (normal[0] * radius);
-      vertex[1] = m_LastPosition[1] - (normal[1] * radius);
-
-      gapContour->AddVertex(vertex);
-
-      ContourModelUtils::FillContourInSlice2(gapContour, m_PaintingSlice, m_InternalFillValue);
-    }
+    // stamp the brush and fill the capsule swept since the last event
+    BrushRasterizer::IndexType from, to;
+    from[0] = static_cast<itk::IndexValueType>(std::round(m_LastPosition[0]));
+    from[1] = static_cast<itk::IndexValueType>(std::round(m_LastPosition[1]));
+    to[0] = static_cast<itk::IndexValueType>(indexCoordinates[0]);
+    to[1] = static_cast<itk::IndexValueType>(indexCoordinates[1]);
+
+    m_Rasterizer.SetSize(static_cast<unsigned int>(std::max(m_Size, 1)));
+    const auto dirtyRegion = BrushRasterizer::Fill(m_PaintingSlice, m_Rasterizer.RasterizeStroke(from, to), m_InternalFillValue);
+    m_StrokeRegion = BrushRasterizer::MergeRegions(m_StrokeRegion, dirtyRegion);
   }
   else
   {
@@ -495,15 +451,20 @@ void mitk::PaintbrushTool::OnMouseReleased(StateMachineAction *, InteractionEven
   }
 
 
-  TransferLabelContentAtTimeStep(m_PaintingSlice, m_WorkingSlice, destinationLabels, 0, LabelSetImage::UNLABELED_VALUE, LabelSetImage::UNLABELED_VALUE, false, { {m_InternalFillValue, activePixelValue} }, mitk::MultiLabelSegmentation::MergeStyle::Merge);
+  if (m_StrokeRegion.GetNumberOfPixels() > 0)
+  {
+    TransferLabelContentAtTimeStep(m_PaintingSlice, m_WorkingSlice, destinationLabels, 0, LabelSetImage::UNLABELED_VALUE, LabelSetImage::UNLABELED_VALUE, false, { {m_InternalFillValue, activePixelValue} }, mitk::MultiLabelSegmentation::MergeStyle::Merge);
 
-  this->WriteBackSegmentationResult(positionEvent, m_WorkingSlice->Clone());
+    // only the pixels of the stroke changed, so only this region has to be written into the volume
+    this->WriteBackSegmentationResult(positionEvent, m_WorkingSlice->Clone(), m_StrokeRegion);
+  }
 
   // deactivate visibility of helper node
   m_PaintingNode->SetVisibility(false);
   m_PaintingNode->SetData(nullptr);
   m_PaintingSlice = nullptr;
   m_WorkingSlice = nullptr;
+  m_StrokeRegion = BrushRasterizer::RegionType();
 
   RenderingManager::GetInstance()->RequestUpdateAll();
 }
@@ -578,6 +539,7 @@ void mitk::PaintbrushTool::ResetWorkingSlice(const InteractionPositionEvent* eve
   m_WorkingSlice = nullptr;
   m_PaintingSlice = nullptr;
   m_PaintingNode->SetData(nullptr);
+  m_StrokeRegion = BrushRasterizer::RegionType();
 
   DataNode* workingNode = this->GetToolManager()->GetWorkingData(0);
   if (nullptr == workingNode)
@@ -13,6 +13,7 @@ found in the LICENSE file.
 #ifndef mitkPaintbrushTool_h
 #define mitkPaintbrushTool_h
 
+#include "mitkBrushRasterizer.h"
 #include "mitkCommon.h"
 #include "mitkFeedbackContourTool.h"
 #include <MitkSegmentationExports.h>
@@ -34,6 +35,10 @@ namespace mitk
 
    Simple paintbrush drawing tool. Right now there are only circular pens of varying size.
 
+   Brush stamps and the gaps between consecutive mouse positions are rasterized directly
+   into the painting slice by a BrushRasterizer. The region touched by the current stroke
+   is tracked in m_StrokeRegion.
+
 
    \warning Only to be instantiated by mitk::ToolManager.
    $Author: maleike $
@@ -100,6 +105,9 @@ namespace mitk
     DataNode::Pointer m_PaintingNode;
     mitk::Point3D m_LastPosition;
 
+    BrushRasterizer m_Rasterizer;
+    BrushRasterizer::RegionType m_StrokeRegion;
+
   };
 
 } // namespace
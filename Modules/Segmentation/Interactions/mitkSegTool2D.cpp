@@ -42,6 +42,9 @@ found in the LICENSE file.
 #include "mitkOperationEvent.h"
 #include "mitkUndoController.h"
 #include <mitkDiffSliceOperationApplier.h>
+#include <mitkCompressedImageDiff.h>
+#include <mitkAlignedSliceMapping.h>
+#include "mitkSegmentationInterpolationController.h"
 
 #include "mitkAbstractTransformGeometry.h"
 #include "mitkLabelSetImage.h"
@@ -511,7 +514,9 @@ mitk::Image* mitk::SegTool2D::GetReferenceData() const
 }
 
 
-void mitk::SegTool2D::WriteBackSegmentationResult(const InteractionPositionEvent *positionEvent, const Image * segmentationResult)
+void mitk::SegTool2D::WriteBackSegmentationResult(const InteractionPositionEvent *positionEvent,
+                                                  const Image * segmentationResult,
+                                                  const itk::ImageRegion<2>& changedRegion)
 {
   if (!positionEvent)
     return;
@@ -525,7 +530,7 @@ void mitk::SegTool2D::WriteBackSegmentationResult(const InteractionPositionEvent
     const auto workingNode = this->GetWorkingDataNode();
     auto *image = dynamic_cast<Image *>(workingNode->GetData());
     const auto timeStep = positionEvent->GetSender()->GetTimeStep(image);
-    this->WriteBackSegmentationResult(planeGeometry, segmentationResult, timeStep);
+    this->WriteBackSegmentationResult(planeGeometry, segmentationResult, timeStep, changedRegion);
   }
 }
 
@@ -540,7 +545,8 @@ void mitk::SegTool2D::WriteBackSegmentationResult(const DataNode* workingNode, c
 
 void mitk::SegTool2D::WriteBackSegmentationResult(const PlaneGeometry *planeGeometry,
                                                   const Image * segmentationResult,
-                                                  TimeStepType timeStep)
+                                                  TimeStepType timeStep,
+                                                  const itk::ImageRegion<2>& changedRegion)
 {
   if (!planeGeometry || !segmentationResult)
     return;
@@ -552,6 +558,7 @@ void mitk::SegTool2D::WriteBackSegmentationResult(const PlaneGeometry *planeGeom
   unsigned int currentSlicePosition = m_LastEventSender->GetSliceNavigationController()->GetStepper()->GetPos();
   SliceInformation sliceInfo(segmentationResult, const_cast<mitk::PlaneGeometry *>(planeGeometry), timeStep);
   sliceInfo.slicePosition = currentSlicePosition;
+  sliceInfo.changedRegion = changedRegion;
   WriteBackSegmentationResults({ sliceInfo }, true);
 }
 
@@ -649,19 +656,16 @@ void mitk::SegTool2D::WriteSliceToVolume(Image* workingImage, const SliceInforma
     mitkThrow() << "Cannot write slice to working node. Working node does not contain an image.";
   }
 
-  DiffSliceOperation* undoOperation = nullptr;
+  if (WriteSliceRegionToVolume(workingImage, sliceInfo, allowUndo))
+    return;
+
+  mitk::Image::Pointer originalSlice;
 
   if (allowUndo)
   {
     /*============= BEGIN undo/redo feature block ========================*/
-    // Create undo operation by caching the not yet modified slices
-    mitk::Image::Pointer originalSlice = GetAffectedImageSliceAs2DImage(sliceInfo.plane, workingImage, sliceInfo.timestep);
-    undoOperation =
-      new DiffSliceOperation(workingImage,
-        originalSlice,
-        dynamic_cast<SlicedGeometry3D*>(originalSlice->GetGeometry()),
-        sliceInfo.timestep,
-        sliceInfo.plane);
+    // Keep the not yet modified slice to compute the difference caused by the edit
+    originalSlice = GetAffectedImageSliceAs2DImage(sliceInfo.plane, workingImage, sliceInfo.timestep);
     /*============= END undo/redo feature block ========================*/
   }
 
@@ -694,14 +698,27 @@ void mitk::SegTool2D::WriteSliceToVolume(Image* workingImage, const SliceInforma
   // the image was modified within the pipeline, but not marked so
   workingImage->Modified();
   workingImage->GetVtkImageData()->Modified();
+  workingImage->InvokeEvent(ImageRegionModifiedEvent(sliceInfo.timestep, sliceInfo.plane));
 
   if (allowUndo)
   {
     /*============= BEGIN undo/redo feature block ========================*/
-    // specify the redo operation with the edited slice
+    // Only the (sparse) difference between the original and the edited slice is kept.
+    // It is applied to the current slice of the volume, so it serves as undo and as redo operation.
+    auto modifiedSlice = GetAffectedImageSliceAs2DImage(sliceInfo.plane, workingImage, sliceInfo.timestep);
+    auto sliceDiff = std::make_shared<CompressedImageDiff>();
+    sliceDiff->ComputeDiff(originalSlice, modifiedSlice);
+
+    auto* undoOperation =
+      new DiffSliceOperation(workingImage,
+        sliceDiff,
+        dynamic_cast<SlicedGeometry3D*>(originalSlice->GetGeometry()),
+        sliceInfo.timestep,
+        sliceInfo.plane);
+
     auto* doOperation =
       new DiffSliceOperation(workingImage,
-        extractor->GetOutput(),
+        sliceDiff,
         dynamic_cast<SlicedGeometry3D*>(sliceInfo.slice->GetGeometry()),
         sliceInfo.timestep,
         sliceInfo.plane);
@@ -718,6 +735,114 @@ void mitk::SegTool2D::WriteSliceToVolume(Image* workingImage, const SliceInforma
   }
 }
 
+bool mitk::SegTool2D::WriteSliceRegionToVolume(Image* workingImage, const SliceInformation &sliceInfo, bool allowUndo)
+{
+  const auto sliceMapping = AlignedSliceMapping::Compute(workingImage, sliceInfo.plane, sliceInfo.timestep);
+
+  if (!sliceMapping.IsValid())
+    return false;
+
+  // the slice has to be the one that would be extracted for the plane
+  const auto& sliceRegion = sliceMapping.GetSliceRegion();
+
+  if (sliceInfo.slice->GetDimension() < 2 ||
+      sliceInfo.slice->GetDimension(0) != sliceRegion.GetSize(0) ||
+      sliceInfo.slice->GetDimension(1) != sliceRegion.GetSize(1) ||
+      sliceInfo.slice->GetPixelType() != workingImage->GetPixelType())
+    return false;
+
+  auto changedRegion = sliceInfo.changedRegion;
+
+  if (changedRegion.GetNumberOfPixels() == 0)
+  {
+    changedRegion = sliceRegion;
+  }
+  else if (!changedRegion.Crop(sliceRegion))
+  {
+    return true; // nothing of the slice is changed
+  }
+
+  auto originalRegion = sliceMapping.ReadRegion(workingImage, changedRegion);
+  auto modifiedRegion = AlignedSliceMapping::CropSlice(sliceInfo.slice, changedRegion);
+
+  // the interpolation only has to rescan the changed voxels instead of the whole volume
+  auto interpolator = SegmentationInterpolationController::InterpolatorForImage(workingImage);
+  if (nullptr != interpolator)
+  {
+    interpolator->BlockModified(true);
+    interpolator->SetChangedRegion(originalRegion,
+                                   modifiedRegion,
+                                   sliceMapping.GetVolumeIndex(changedRegion.GetIndex()),
+                                   sliceMapping.GetAxis0(),
+                                   sliceMapping.GetAxis1(),
+                                   sliceInfo.timestep);
+  }
+
+  // the interpolation of a single label of a multi-label segmentation
+  auto labelInterpolator = SegmentationInterpolationController::InterpolatorForLabelSegmentation(workingImage);
+  if (nullptr != labelInterpolator)
+  {
+    labelInterpolator->BlockModified(true);
+    labelInterpolator->SetChangedLabelRegion(originalRegion,
+                                             modifiedRegion,
+                                             sliceMapping.GetVolumeIndex(changedRegion.GetIndex()),
+                                             sliceMapping.GetAxis0(),
+                                             sliceMapping.GetAxis1(),
+                                             sliceInfo.timestep);
+  }
+
+  sliceMapping.WriteRegion(workingImage, modifiedRegion, changedRegion);
+
+  // the image was modified directly, but not marked so
+  workingImage->Modified();
+  workingImage->GetVtkImageData(sliceInfo.timestep)->Modified();
+  workingImage->InvokeEvent(ImageRegionModifiedEvent(sliceInfo.timestep, sliceInfo.plane));
+
+  if (nullptr != interpolator)
+    interpolator->BlockModified(false);
+
+  if (nullptr != labelInterpolator)
+    labelInterpolator->BlockModified(false);
+
+  if (allowUndo)
+  {
+    /*============= BEGIN undo/redo feature block ========================*/
+    // Only the difference within the changed region is kept.
+    auto regionDiff = std::make_shared<CompressedImageDiff>();
+    regionDiff->ComputeDiff(originalRegion, modifiedRegion);
+
+    if (!regionDiff->IsEmpty())
+    {
+      auto* undoOperation = new DiffSliceOperation(workingImage,
+        regionDiff,
+        sliceMapping,
+        changedRegion,
+        dynamic_cast<SlicedGeometry3D*>(sliceInfo.slice->GetGeometry()),
+        sliceInfo.timestep,
+        sliceInfo.plane);
+
+      auto* doOperation = new DiffSliceOperation(workingImage,
+        regionDiff,
+        sliceMapping,
+        changedRegion,
+        dynamic_cast<SlicedGeometry3D*>(sliceInfo.slice->GetGeometry()),
+        sliceInfo.timestep,
+        sliceInfo.plane);
+
+      // create an operation event for the undo stack
+      OperationEvent* undoStackItem =
+        new OperationEvent(DiffSliceOperationApplier::GetInstance(), doOperation, undoOperation, "Segmentation");
+
+      // add it to the undo controller
+      UndoStackItem::IncCurrObjectEventId();
+      UndoStackItem::IncCurrGroupEventId();
+      UndoController::GetCurrentUndoModel()->SetOperationEvent(undoStackItem);
+    }
+    /*============= END undo/redo feature block ========================*/
+  }
+
+  return true;
+}
 
 void mitk::SegTool2D::SetShowMarkerNodes(bool status)
 {
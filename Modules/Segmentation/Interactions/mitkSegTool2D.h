@@ -26,6 +26,8 @@ found in the LICENSE file.
 
 #include <mitkDiffSliceOperation.h>
 
+#include <itkImageRegion.h>
+
 #include <usModuleResource.h>
 
 namespace mitk
@@ -167,6 +169,8 @@ namespace mitk
       const mitk::PlaneGeometry *plane = nullptr;
       mitk::TimeStepType timestep = 0;
       unsigned int slicePosition;
+      /** Region of the slice that was changed. An empty region means that the whole slice may have changed. */
+      itk::ImageRegion<2> changedRegion;
 
       SliceInformation() = default;
       SliceInformation(const mitk::Image* aSlice, const mitk::PlaneGeometry* aPlane, mitk::TimeStepType aTimestep);
@@ -215,12 +219,18 @@ namespace mitk
     Image::Pointer GetAffectedReferenceSlice(const PlaneGeometry* planeGeometry, TimeStepType timeStep) const;
 
     /** Convenience version that can be called for a given event (which is used to deduce timepoint and plane) and a slice image.
-     * Calls non static WriteBackSegmentationResults*/
-    void WriteBackSegmentationResult(const InteractionPositionEvent *, const Image* segmentationResult);
+     * Calls non static WriteBackSegmentationResults. If known, the changed region of the slice can be passed
+     * (see SliceInformation::changedRegion).*/
+    void WriteBackSegmentationResult(const InteractionPositionEvent *,
+                                     const Image* segmentationResult,
+                                     const itk::ImageRegion<2>& changedRegion = itk::ImageRegion<2>());
 
     /** Convenience version that can be called for a given planeGeometry, slice image and time step.
      * Calls non static WriteBackSegmentationResults*/
-    void WriteBackSegmentationResult(const PlaneGeometry *planeGeometry, const Image* segmentationResult, TimeStepType timeStep);
+    void WriteBackSegmentationResult(const PlaneGeometry *planeGeometry,
+                                     const Image* segmentationResult,
+                                     TimeStepType timeStep,
+                                     const itk::ImageRegion<2>& changedRegion = itk::ImageRegion<2>());
 
     /** Overloaded version that calls the static version and also adds the contour markers.
      * @remark If the sliceList is empty, this function does nothing.*/
@@ -240,6 +250,9 @@ namespace mitk
     /** Writes a provided slice into the passed working image. The content of working image that is covered
     * by the slice will be completely overwritten. If asked for it also generates the needed
     * undo/redo steps.
+    * If the plane is aligned with the voxel grid of the working image, only the changed region of the slice
+    * (see SliceInformation::changedRegion) is copied into the volume without reslicing, and only this region
+    * is kept for undo/redo.
     * @param workingImage Pointer to the image that is the target of the write operation.
     * @param sliceInfo SliceInfo instance that contains the slice image, the defining plane geometry and time step.
     * @param allowUndo Indicates if undo/redo operations should be registered for the write operation
@@ -248,6 +261,11 @@ namespace mitk
     * @pre workingImage must point to a valid instance.*/
     static void WriteSliceToVolume(Image* workingImage, const SliceInformation &sliceInfo, bool allowUndo);
 
+    /** Writes only the changed region of the slice directly into the working image, if the plane is aligned
+    * with its voxel grid. Used by WriteSliceToVolume().
+    * @return false if the slice cannot be written this way and has to be resliced into the working image.*/
+    static bool WriteSliceRegionToVolume(Image* workingImage, const SliceInformation &sliceInfo, bool allowUndo);
+
     /**
       \brief Adds a new node called Contourmarker to the datastorage which holds a mitk::PlanarFigure.
       By selecting this node the slicestack will be reoriented according to the passed
@@ -95,10 +95,8 @@ void mitk::TotalSegmentatorTool::DoUpdatePreview(const Image *inputAtTimeStep,
                                                  LabelSetImage *previewImage,
                                                  TimeStepType timeStep)
 {
-  if (this->m_MitkTempDir.empty())
-  {
-    this->SetMitkTempDir(IOUtil::CreateTemporaryDirectory("mitk-XXXXXX"));
-  }
+  const bool isSubTask = (this->GetSubTask() != DEFAULT_TOTAL_TASK) && (this->GetSubTask() != DEFAULT_TOTAL_TASK_MRI);
+  const bool useInferenceWorker = m_InferenceWorker.IsNotNull() && !isSubTask;
   ProcessExecutor::Pointer spExec = ProcessExecutor::New();
   itk::CStyleCommand::Pointer spCommand = itk::CStyleCommand::New();
   spCommand->SetCallback(&onPythonProcessEvent);
@@ -106,21 +104,27 @@ void mitk::TotalSegmentatorTool::DoUpdatePreview(const Image *inputAtTimeStep,
   m_ProgressCommand->SetProgress(5);
 
   std::string inDir, outDir, inputImagePath, outputImagePath, scriptPath;
-  inDir = IOUtil::CreateTemporaryDirectory("totalseg-in-XXXXXX", this->GetMitkTempDir());
-  std::ofstream tmpStream;
-  inputImagePath = IOUtil::CreateTemporaryFile(tmpStream, TEMPLATE_FILENAME, inDir + IOUtil::GetDirectorySeparator());
-  tmpStream.close();
-  std::size_t found = inputImagePath.find_last_of(IOUtil::GetDirectorySeparator());
-  std::string fileName = inputImagePath.substr(found + 1);
-  std::string token = fileName.substr(0, fileName.find("_"));
-  outDir = IOUtil::CreateTemporaryDirectory("totalseg-out-XXXXXX", this->GetMitkTempDir());
   LabelSetImage::Pointer outputBuffer;
   m_ProgressCommand->SetProgress(20);
-  IOUtil::Save(inputAtTimeStep, inputImagePath);
+  if (!useInferenceWorker)
+  {
+    if (this->m_MitkTempDir.empty())
+    {
+      this->SetMitkTempDir(IOUtil::CreateTemporaryDirectory("mitk-XXXXXX"));
+    }
+    inDir = IOUtil::CreateTemporaryDirectory("totalseg-in-XXXXXX", this->GetMitkTempDir());
+    std::ofstream tmpStream;
+    inputImagePath = IOUtil::CreateTemporaryFile(tmpStream, TEMPLATE_FILENAME, inDir + IOUtil::GetDirectorySeparator());
+    tmpStream.close();
+    std::size_t found = inputImagePath.find_last_of(IOUtil::GetDirectorySeparator());
+    std::string fileName = inputImagePath.substr(found + 1);
+    std::string token = fileName.substr(0, fileName.find("_"));
+    outDir = IOUtil::CreateTemporaryDirectory("totalseg-out-XXXXXX", this->GetMitkTempDir());
+    outputImagePath = outDir + IOUtil::GetDirectorySeparator() + token + "_000.nii.gz";
+    IOUtil::Save(inputAtTimeStep, inputImagePath);
+  }
   m_ProgressCommand->SetProgress(50);
 
-  outputImagePath = outDir + IOUtil::GetDirectorySeparator() + token + "_000.nii.gz";
-  const bool isSubTask = (this->GetSubTask() != DEFAULT_TOTAL_TASK) && (this->GetSubTask() != DEFAULT_TOTAL_TASK_MRI);
   std::map<mitk::Label::PixelType, std::string> targetLabelMap;
   if (isSubTask)
   {
@@ -142,9 +146,24 @@ void mitk::TotalSegmentatorTool::DoUpdatePreview(const Image *inputAtTimeStep,
   }
   else
   {
-    this->run_totalsegmentator(
-      spExec, inputImagePath, outputImagePath, this->GetFast(), !isSubTask, this->GetGpuId(), this->GetSubTask());
-    Image::Pointer outputImage = IOUtil::Load<Image>(outputImagePath);
+    Image::Pointer outputImage;
+    if (useInferenceWorker)
+    {
+      const InferenceWorker::ParametersType parameters = {
+        {"tool", "TotalSegmentator"},
+        {"task", this->GetSubTask()},
+        {"fast", this->GetFast() ? "1" : "0"},
+        {"device", (this->GetGpuId() < 0) ? "cpu" : "gpu"},
+        {"gpuId", std::to_string(this->GetGpuId())}
+      };
+      outputImage = m_InferenceWorker->Run(inputAtTimeStep, parameters);
+    }
+    else
+    {
+      this->run_totalsegmentator(
+        spExec, inputImagePath, outputImagePath, this->GetFast(), !isSubTask, this->GetGpuId(), this->GetSubTask());
+      outputImage = IOUtil::Load<Image>(outputImagePath);
+    }
     outputBuffer = mitk::LabelSetImage::New();
     outputBuffer->InitializeByLabeledImage(outputImage);
     outputBuffer->SetGeometry(inputAtTimeStep->GetGeometry());
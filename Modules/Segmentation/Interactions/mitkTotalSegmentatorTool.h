@@ -15,6 +15,7 @@ found in the LICENSE file.
 #include "mitkSegWithPreviewTool.h"
 #include <MitkSegmentationExports.h>
 #include "mitkProcessExecutor.h"
+#include <mitkInferenceWorker.h>
 
 
 namespace us
@@ -61,6 +62,16 @@ namespace mitk
     itkGetConstMacro(Fast, bool);
     itkBooleanMacro(Fast);
 
+    /**
+     * @brief Persistent inference worker that is used instead of running TotalSegmentator on every update
+     * (optional). Subtasks, which result in a file per label, are still run by TotalSegmentator.
+     * QmitkTotalSegmentatorToolGUI sets a worker if an inference worker script is selected in the preferences
+     * (TotalSeg/inferenceWorkerScript); other applications have to set one themselves. See
+     * mitk::InferenceWorker for the worker protocol.
+     */
+    itkSetObjectMacro(InferenceWorker, InferenceWorker);
+    itkGetObjectMacro(InferenceWorker, InferenceWorker);
+
     /**
      * @brief Static function to print out everything from itk::EventObject.
      * Used as callback in mitk::ProcessExecutor object.
@@ -134,6 +145,7 @@ namespace mitk
     int m_GpuId = 0;
     std::map<mitk::Label::PixelType, std::string> m_LabelMapTotal;
     std::map<mitk::Label::PixelType, std::string> m_LabelMapTotalMR;
+    InferenceWorker::Pointer m_InferenceWorker;
     bool m_Fast = true;
     const std::string TEMPLATE_FILENAME = "XXXXXX_000_0000.nii.gz";
     const std::string DEFAULT_TOTAL_TASK = "total";
@@ -130,8 +130,46 @@ namespace
   }
 } // namespace
 
+void mitk::nnUNetTool::UpdatePreviewByInferenceWorker(const Image *inputAtTimeStep, LabelSetImage *previewImage)
+{
+  const ModelParams &modelparam = m_ParamQ.front();
+
+  std::string folds;
+  for (const auto &fold : modelparam.folds)
+  {
+    folds += (folds.empty() ? "" : ",") + fold;
+  }
+
+  const InferenceWorker::ParametersType parameters = {
+    {"tool", "nnUNet"},
+    {"task", modelparam.task},
+    {"model", modelparam.model},
+    {"trainer", modelparam.trainer},
+    {"planId", modelparam.planId},
+    {"folds", folds},
+    {"modelDirectory", this->GetModelDirectory()},
+    {"mirror", this->GetMirror() ? "1" : "0"},
+    {"mixedPrecision", this->GetMixedPrecision() ? "1" : "0"},
+    {"gpuId", std::to_string(this->GetGpuId())}
+  };
+
+  Image::Pointer outputImage = m_InferenceWorker->Run(inputAtTimeStep, parameters);
+  previewImage->InitializeByLabeledImage(outputImage);
+  previewImage->SetGeometry(inputAtTimeStep->GetGeometry());
+  m_InputBuffer = inputAtTimeStep;
+  m_OutputBuffer = mitk::LabelSetImage::New();
+  m_OutputBuffer->InitializeByLabeledImage(outputImage);
+  m_OutputBuffer->SetGeometry(inputAtTimeStep->GetGeometry());
+}
+
 void mitk::nnUNetTool::DoUpdatePreview(const Image* inputAtTimeStep, const Image* /*oldSegAtTimeStep*/, LabelSetImage* previewImage, TimeStepType /*timeStep*/)
 {
+  if (m_InferenceWorker.IsNotNull() && !this->GetMultiModal() && 1 == m_ParamQ.size())
+  {
+    this->UpdatePreviewByInferenceWorker(inputAtTimeStep, previewImage);
+    return;
+  }
+
   if (this->GetMitkTempDir().empty())
   {
     this->SetMitkTempDir(IOUtil::CreateTemporaryDirectory("mitk-nnunet-XXXXXX"));
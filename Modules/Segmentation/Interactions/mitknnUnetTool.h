@@ -17,6 +17,7 @@ found in the LICENSE file.
 #include "mitkCommon.h"
 #include "mitkToolManager.h"
 #include <MitkSegmentationExports.h>
+#include <mitkInferenceWorker.h>
 #include <mitkStandardFileLocations.h>
 #include <numeric>
 #include <utility>
@@ -120,6 +121,15 @@ namespace mitk
     itkSetMacro(GpuId, unsigned int);
     itkGetConstMacro(GpuId, unsigned int);
 
+    /**
+     * @brief Persistent inference worker that is used instead of running nnUNet_predict on every update
+     * (optional). It is only used for predictions of a single model on single modality images.
+     * QmitknnUNetToolGUI sets a worker if an inference worker script is selected in its advanced settings;
+     * other applications have to set one themselves. See mitk::InferenceWorker for the worker protocol.
+     */
+    itkSetObjectMacro(InferenceWorker, InferenceWorker);
+    itkGetObjectMacro(InferenceWorker, InferenceWorker);
+
     /**
      * @brief vector of ModelParams.
      * Size > 1 only for ensemble prediction.
@@ -194,6 +204,13 @@ namespace mitk
     void UpdatePrepare() override;
 
   private:
+    /**
+     * @brief Runs the prediction of the single model in the parameter queue by the inference worker.
+     *
+     * @throw mitk::Exception if the worker failed. The exception is reported by SegWithPreviewTool::UpdatePreview().
+     */
+    void UpdatePreviewByInferenceWorker(const Image* inputAtTimeStep, LabelSetImage* previewImage);
+
     std::string m_MitkTempDir;
     std::string m_nnUNetDirectory;
     std::string m_ModelDirectory;
@@ -208,6 +225,7 @@ namespace mitk
     bool m_Ensemble = false;
     bool m_Predict;
     LabelSetImage::Pointer m_OutputBuffer;
+    InferenceWorker::Pointer m_InferenceWorker;
     unsigned int m_GpuId;
     const std::string m_TEMPLATE_FILENAME = "XXXXXX_000_0000.nii.gz";
   };
@@ -1,12 +1,17 @@
 set(MODULE_TESTS
+  mitkAlignedSliceMappingTest.cpp
+  mitkBrushRasterizerTest.cpp
   mitkContourMapper2DTest.cpp
   mitkContourTest.cpp
   mitkContourModelSetToImageFilterTest.cpp
   mitkDataNodeSegmentationTest.cpp
+  mitkDiffSliceOperationTest.cpp
   mitkImageToContourFilterTest.cpp
+  mitkInferenceWorkerTest.cpp
   mitkSegmentationInterpolationTest.cpp
   mitkOverwriteSliceFilterTest.cpp
   mitkOverwriteSliceFilterObliquePlaneTest.cpp
+  mitkSegTool2DRegionWriteTest.cpp
 #  mitkToolManagerTest.cpp
   mitkToolManagerProviderTest.cpp
   mitkManualSegmentationToSurfaceFilterTest.cpp #new cpp unit style
@@ -0,0 +1,244 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+// Testing
+#include "mitkTestFixture.h"
+#include "mitkTestingMacros.h"
+
+// MITK includes
+#include <mitkAlignedSliceMapping.h>
+#include <mitkImagePixelReadAccessor.h>
+#include <mitkImagePixelWriteAccessor.h>
+#include <mitkImageReadAccessor.h>
+#include <mitkInteractionConst.h>
+#include <mitkRotationOperation.h>
+#include <mitkSegTool2D.h>
+
+// std includes
+#include <cstring>
+
+class mitkAlignedSliceMappingTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkAlignedSliceMappingTestSuite);
+  MITK_TEST(Compute_AxialPlane_MapsToVoxels);
+  MITK_TEST(Compute_StandardPlanes_MatchExtractedSlices);
+  MITK_TEST(Compute_ObliquePlane_IsInvalid);
+  MITK_TEST(WriteRegion_ChangesOnlyRegion);
+  MITK_TEST(CropSlice_PasteIntoSlice_RoundTrip);
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+  typedef mitk::AlignedSliceMapping::RegionType RegionType;
+  typedef mitk::AlignedSliceMapping::VolumeIndexType VolumeIndexType;
+
+  mitk::Image::Pointer m_Volume;
+
+  static unsigned short ValueOf(const VolumeIndexType &index)
+  {
+    return static_cast<unsigned short>(index[0] + 10 * index[1] + 100 * index[2]);
+  }
+
+  static RegionType MakeRegion(itk::IndexValueType x, itk::IndexValueType y, itk::SizeValueType width, itk::SizeValueType height)
+  {
+    RegionType region;
+    region.SetIndex(0, x);
+    region.SetIndex(1, y);
+    region.SetSize(0, width);
+    region.SetSize(1, height);
+    return region;
+  }
+
+  mitk::PlaneGeometry::Pointer CreatePlane(mitk::AnatomicalPlane orientation, unsigned int slice) const
+  {
+    auto plane = mitk::PlaneGeometry::New();
+    plane->InitializeStandardPlane(m_Volume->GetGeometry(), orientation, slice + 0.5);
+    return plane;
+  }
+
+  static bool AreEqual(const mitk::Image *image1, const mitk::Image *image2)
+  {
+    if (image1->GetDimension(0) != image2->GetDimension(0) || image1->GetDimension(1) != image2->GetDimension(1))
+      return false;
+
+    mitk::ImageReadAccessor accessor1(image1);
+    mitk::ImageReadAccessor accessor2(image2);
+
+    return 0 == std::memcmp(accessor1.GetData(),
+                            accessor2.GetData(),
+                            image1->GetDimension(0) * image1->GetDimension(1) * sizeof(unsigned short));
+  }
+
+public:
+  void setUp() override
+  {
+    unsigned int dimensions[3] = {5, 4, 3};
+
+    m_Volume = mitk::Image::New();
+    m_Volume->Initialize(mitk::MakeScalarPixelType<unsigned short>(), 3, dimensions);
+
+    mitk::Vector3D spacing;
+    mitk::FillVector3D(spacing, 0.5, 2.0, 1.5);
+    m_Volume->GetGeometry()->SetSpacing(spacing);
+
+    mitk::ImagePixelWriteAccessor<unsigned short, 3> accessor(m_Volume);
+    VolumeIndexType index;
+
+    for (index[2] = 0; index[2] < 3; ++index[2])
+      for (index[1] = 0; index[1] < 4; ++index[1])
+        for (index[0] = 0; index[0] < 5; ++index[0])
+          accessor.SetPixelByIndex(index, ValueOf(index));
+  }
+
+  void tearDown() override
+  {
+    m_Volume = nullptr;
+  }
+
+  void Compute_AxialPlane_MapsToVoxels()
+  {
+    auto plane = this->CreatePlane(mitk::AnatomicalPlane::Axial, 2);
+    auto mapping = mitk::AlignedSliceMapping::Compute(m_Volume, plane, 0);
+
+    CPPUNIT_ASSERT(mapping.IsValid());
+    CPPUNIT_ASSERT_EQUAL(itk::SizeValueType(5), mapping.GetSliceRegion().GetSize(0));
+    CPPUNIT_ASSERT_EQUAL(itk::SizeValueType(4), mapping.GetSliceRegion().GetSize(1));
+
+    VolumeIndexType origin;
+    origin[0] = 0;
+    origin[1] = 0;
+    origin[2] = 2;
+    CPPUNIT_ASSERT_EQUAL(origin, mapping.GetOrigin());
+    CPPUNIT_ASSERT_EQUAL(itk::OffsetValueType(1), mapping.GetAxis0()[0]);
+    CPPUNIT_ASSERT_EQUAL(itk::OffsetValueType(1), mapping.GetAxis1()[1]);
+
+    auto region = mapping.ReadRegion(m_Volume, MakeRegion(1, 2, 3, 2));
+    mitk::ImagePixelReadAccessor<unsigned short, 2> accessor(region);
+
+    itk::Index<2> index;
+    index[0] = 0;
+    index[1] = 0;
+    CPPUNIT_ASSERT_EQUAL(static_cast<unsigned short>(221), accessor.GetPixelByIndex(index));
+    index[0] = 2;
+    index[1] = 1;
+    CPPUNIT_ASSERT_EQUAL(static_cast<unsigned short>(233), accessor.GetPixelByIndex(index));
+  }
+
+  void Compute_StandardPlanes_MatchExtractedSlices()
+  {
+    const std::pair<mitk::AnatomicalPlane, unsigned int> planes[] = {
+      {mitk::AnatomicalPlane::Axial, 0},
+      {mitk::AnatomicalPlane::Axial, 1},
+      {mitk::AnatomicalPlane::Sagittal, 0},
+      {mitk::AnatomicalPlane::Sagittal, 4},
+      {mitk::AnatomicalPlane::Coronal, 0},
+      {mitk::AnatomicalPlane::Coronal, 3}};
+
+    for (const auto &planeDescription : planes)
+    {
+      auto plane = this->CreatePlane(planeDescription.first, planeDescription.second);
+      auto mapping = mitk::AlignedSliceMapping::Compute(m_Volume, plane, 0);
+
+      CPPUNIT_ASSERT(mapping.IsValid());
+
+      auto extractedSlice = mitk::SegTool2D::GetAffectedImageSliceAs2DImage(plane, m_Volume, 0);
+      auto mappedSlice = mapping.ReadRegion(m_Volume, mapping.GetSliceRegion());
+
+      CPPUNIT_ASSERT(AreEqual(extractedSlice, mappedSlice));
+
+      mitk::ImagePixelReadAccessor<unsigned short, 2> accessor(mappedSlice);
+      RegionType::IndexType index;
+
+      for (index[1] = 0; index[1] < static_cast<itk::IndexValueType>(mappedSlice->GetDimension(1)); ++index[1])
+        for (index[0] = 0; index[0] < static_cast<itk::IndexValueType>(mappedSlice->GetDimension(0)); ++index[0])
+          CPPUNIT_ASSERT_EQUAL(ValueOf(mapping.GetVolumeIndex(index)), accessor.GetPixelByIndex(index));
+    }
+  }
+
+  void Compute_ObliquePlane_IsInvalid()
+  {
+    auto plane = this->CreatePlane(mitk::AnatomicalPlane::Axial, 1);
+
+    mitk::Vector3D axis;
+    mitk::FillVector3D(axis, 0.0, 0.0, 1.0);
+    mitk::RotationOperation rotation(mitk::OpROTATE, plane->GetCenter(), axis, 30.0);
+    plane->ExecuteOperation(&rotation);
+
+    CPPUNIT_ASSERT(!mitk::AlignedSliceMapping::Compute(m_Volume, plane, 0).IsValid());
+    CPPUNIT_ASSERT(!mitk::AlignedSliceMapping::Compute(nullptr, plane, 0).IsValid());
+    CPPUNIT_ASSERT(!mitk::AlignedSliceMapping::Compute(m_Volume, plane, 1).IsValid());
+
+    mitk::AlignedSliceMapping invalidMapping;
+    CPPUNIT_ASSERT_THROW(invalidMapping.ReadRegion(m_Volume, MakeRegion(0, 0, 1, 1)), mitk::Exception);
+  }
+
+  void WriteRegion_ChangesOnlyRegion()
+  {
+    auto plane = this->CreatePlane(mitk::AnatomicalPlane::Coronal, 2);
+    auto mapping = mitk::AlignedSliceMapping::Compute(m_Volume, plane, 0);
+    CPPUNIT_ASSERT(mapping.IsValid());
+
+    const auto region = MakeRegion(1, 1, 2, 2);
+    auto regionImage = mapping.ReadRegion(m_Volume, region);
+
+    {
+      mitk::ImagePixelWriteAccessor<unsigned short, 2> accessor(regionImage);
+      RegionType::IndexType index;
+
+      for (index[1] = 0; index[1] < 2; ++index[1])
+        for (index[0] = 0; index[0] < 2; ++index[0])
+          accessor.SetPixelByIndex(index, 1000);
+    }
+
+    mapping.WriteRegion(m_Volume, regionImage, region);
+
+    std::size_t numberOfChangedVoxels = 0;
+    mitk::ImagePixelReadAccessor<unsigned short, 3> accessor(m_Volume);
+    VolumeIndexType index;
+
+    for (index[2] = 0; index[2] < 3; ++index[2])
+      for (index[1] = 0; index[1] < 4; ++index[1])
+        for (index[0] = 0; index[0] < 5; ++index[0])
+          if (accessor.GetPixelByIndex(index) != ValueOf(index))
+            ++numberOfChangedVoxels;
+
+    CPPUNIT_ASSERT_EQUAL(std::size_t(4), numberOfChangedVoxels);
+
+    RegionType::IndexType sliceIndex;
+    sliceIndex[0] = 2;
+    sliceIndex[1] = 2;
+    CPPUNIT_ASSERT_EQUAL(static_cast<unsigned short>(1000), accessor.GetPixelByIndex(mapping.GetVolumeIndex(sliceIndex)));
+
+    // regions outside of the slice and images that do not match the region are rejected
+    CPPUNIT_ASSERT_THROW(mapping.WriteRegion(m_Volume, regionImage, MakeRegion(4, 1, 2, 2)), mitk::Exception);
+    CPPUNIT_ASSERT_THROW(mapping.WriteRegion(m_Volume, regionImage, MakeRegion(0, 0, 3, 2)), mitk::Exception);
+  }
+
+  void CropSlice_PasteIntoSlice_RoundTrip()
+  {
+    auto plane = this->CreatePlane(mitk::AnatomicalPlane::Sagittal, 3);
+    auto slice = mitk::SegTool2D::GetAffectedImageSliceAs2DImage(plane, m_Volume, 0);
+    auto original = slice->Clone();
+
+    const auto region = MakeRegion(1, 0, 2, 3);
+    auto regionImage = mitk::AlignedSliceMapping::CropSlice(slice, region);
+
+    CPPUNIT_ASSERT_EQUAL(2u, regionImage->GetDimension(0));
+    CPPUNIT_ASSERT_EQUAL(3u, regionImage->GetDimension(1));
+
+    mitk::AlignedSliceMapping::PasteIntoSlice(slice, regionImage, region);
+    CPPUNIT_ASSERT(AreEqual(original, slice));
+
+    CPPUNIT_ASSERT_THROW(mitk::AlignedSliceMapping::CropSlice(slice, MakeRegion(3, 0, 2, 3)), mitk::Exception);
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkAlignedSliceMapping)
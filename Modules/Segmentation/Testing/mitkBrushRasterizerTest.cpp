@@ -0,0 +1,211 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+// Testing
+#include "mitkTestFixture.h"
+#include "mitkTestingMacros.h"
+
+// MITK includes
+#include <mitkBrushRasterizer.h>
+#include <mitkImagePixelReadAccessor.h>
+#include <mitkImageWriteAccessor.h>
+
+// std includes
+#include <cstring>
+
+class mitkBrushRasterizerTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkBrushRasterizerTestSuite);
+  MITK_TEST(GetFootprint_MatchesBrushSize);
+  MITK_TEST(GetFootprint_EvenSize_IsShifted);
+  MITK_TEST(RasterizeStroke_FillsCapsule);
+  MITK_TEST(RasterizeStroke_HasNoGaps);
+  MITK_TEST(Fill_ReturnsDirtyRegion);
+  MITK_TEST(Fill_ClipsToImage);
+  MITK_TEST(MergeRegions_IgnoresEmptyRegions);
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+  typedef mitk::BrushRasterizer::IndexType IndexType;
+  typedef mitk::BrushRasterizer::RegionType RegionType;
+
+  mitk::Image::Pointer m_Slice;
+
+  static IndexType MakeIndex(itk::IndexValueType x, itk::IndexValueType y)
+  {
+    IndexType index;
+    index[0] = x;
+    index[1] = y;
+    return index;
+  }
+
+  static std::size_t CountPixels(const mitk::BrushRasterizer::SpanListType &spans)
+  {
+    std::size_t count = 0;
+
+    for (const auto &span : spans)
+      count += static_cast<std::size_t>(span.XEnd - span.XBegin + 1);
+
+    return count;
+  }
+
+  std::size_t CountFilledPixels()
+  {
+    mitk::ImagePixelReadAccessor<unsigned short, 2> accessor(m_Slice);
+    std::size_t count = 0;
+
+    for (itk::IndexValueType y = 0; y < static_cast<itk::IndexValueType>(m_Slice->GetDimension(1)); ++y)
+    {
+      for (itk::IndexValueType x = 0; x < static_cast<itk::IndexValueType>(m_Slice->GetDimension(0)); ++x)
+      {
+        if (accessor.GetPixelByIndex(MakeIndex(x, y)) != 0)
+          ++count;
+      }
+    }
+
+    return count;
+  }
+
+public:
+  void setUp() override
+  {
+    unsigned int dimensions[2] = {32, 24};
+
+    m_Slice = mitk::Image::New();
+    m_Slice->Initialize(mitk::MakeScalarPixelType<unsigned short>(), 2, dimensions);
+
+    mitk::ImageWriteAccessor accessor(m_Slice);
+    std::memset(accessor.GetData(), 0, 32 * 24 * sizeof(unsigned short));
+  }
+
+  void tearDown() override
+  {
+    m_Slice = nullptr;
+  }
+
+  void GetFootprint_MatchesBrushSize()
+  {
+    mitk::BrushRasterizer rasterizer;
+    CPPUNIT_ASSERT_EQUAL(1u, rasterizer.GetSize());
+    CPPUNIT_ASSERT_EQUAL(std::size_t(1), CountPixels(rasterizer.GetFootprint()));
+
+    rasterizer.SetSize(3);
+    CPPUNIT_ASSERT_EQUAL(std::size_t(9), CountPixels(rasterizer.GetFootprint()));
+
+    rasterizer.SetSize(5);
+    CPPUNIT_ASSERT_EQUAL(std::size_t(21), CountPixels(rasterizer.GetFootprint()));
+
+    rasterizer.SetSize(0);
+    CPPUNIT_ASSERT_EQUAL(1u, rasterizer.GetSize());
+  }
+
+  void GetFootprint_EvenSize_IsShifted()
+  {
+    mitk::BrushRasterizer rasterizer(2);
+    const auto &footprint = rasterizer.GetFootprint();
+
+    // the center of even brushes is the corner between the pointed pixel and its successors
+    CPPUNIT_ASSERT_EQUAL(std::size_t(2), footprint.size());
+    CPPUNIT_ASSERT_EQUAL(itk::IndexValueType(0), footprint.front().Y);
+    CPPUNIT_ASSERT_EQUAL(itk::IndexValueType(1), footprint.back().Y);
+    CPPUNIT_ASSERT_EQUAL(itk::IndexValueType(0), footprint.front().XBegin);
+    CPPUNIT_ASSERT_EQUAL(itk::IndexValueType(1), footprint.front().XEnd);
+  }
+
+  void RasterizeStroke_FillsCapsule()
+  {
+    mitk::BrushRasterizer rasterizer(3);
+
+    const auto spans = rasterizer.RasterizeStroke(MakeIndex(10, 10), MakeIndex(20, 10));
+
+    // three rows of 13 pixels: the stroke plus one pixel on each side
+    CPPUNIT_ASSERT_EQUAL(std::size_t(3), spans.size());
+    CPPUNIT_ASSERT_EQUAL(std::size_t(39), CountPixels(spans));
+    CPPUNIT_ASSERT_EQUAL(itk::IndexValueType(9), spans.front().XBegin);
+    CPPUNIT_ASSERT_EQUAL(itk::IndexValueType(21), spans.front().XEnd);
+
+    // a stroke without movement is a single stamp
+    CPPUNIT_ASSERT_EQUAL(std::size_t(9), CountPixels(rasterizer.RasterizeStroke(MakeIndex(5, 5), MakeIndex(5, 5))));
+  }
+
+  void RasterizeStroke_HasNoGaps()
+  {
+    mitk::BrushRasterizer rasterizer(1);
+
+    const auto spans = rasterizer.RasterizeStroke(MakeIndex(0, 0), MakeIndex(7, 20));
+
+    CPPUNIT_ASSERT_EQUAL(std::size_t(21), spans.size());
+
+    for (std::size_t i = 0; i < spans.size(); ++i)
+    {
+      CPPUNIT_ASSERT_EQUAL(static_cast<itk::IndexValueType>(i), spans[i].Y);
+      CPPUNIT_ASSERT(spans[i].XBegin <= spans[i].XEnd);
+
+      if (i > 0)
+        CPPUNIT_ASSERT(spans[i].XBegin <= spans[i - 1].XEnd + 1);
+    }
+  }
+
+  void Fill_ReturnsDirtyRegion()
+  {
+    mitk::BrushRasterizer rasterizer(5);
+    const auto modifiedTime = m_Slice->GetMTime();
+
+    const auto region = mitk::BrushRasterizer::Fill(m_Slice, rasterizer.RasterizeStroke(MakeIndex(10, 10), MakeIndex(14, 12)), 255);
+
+    CPPUNIT_ASSERT_EQUAL(itk::IndexValueType(8), region.GetIndex(0));
+    CPPUNIT_ASSERT_EQUAL(itk::IndexValueType(8), region.GetIndex(1));
+    CPPUNIT_ASSERT_EQUAL(itk::SizeValueType(9), region.GetSize(0));
+    CPPUNIT_ASSERT_EQUAL(itk::SizeValueType(7), region.GetSize(1));
+    CPPUNIT_ASSERT(m_Slice->GetMTime() > modifiedTime);
+
+    CPPUNIT_ASSERT_EQUAL(CountPixels(rasterizer.RasterizeStroke(MakeIndex(10, 10), MakeIndex(14, 12))), this->CountFilledPixels());
+  }
+
+  void Fill_ClipsToImage()
+  {
+    mitk::BrushRasterizer rasterizer(5);
+
+    auto region = mitk::BrushRasterizer::Fill(m_Slice, rasterizer.RasterizeStamp(MakeIndex(0, 23)), 1);
+
+    CPPUNIT_ASSERT_EQUAL(itk::IndexValueType(0), region.GetIndex(0));
+    CPPUNIT_ASSERT_EQUAL(itk::IndexValueType(21), region.GetIndex(1));
+    CPPUNIT_ASSERT_EQUAL(itk::SizeValueType(3), region.GetSize(0));
+    CPPUNIT_ASSERT_EQUAL(itk::SizeValueType(3), region.GetSize(1));
+    CPPUNIT_ASSERT_EQUAL(std::size_t(8), this->CountFilledPixels());
+
+    // completely outside
+    const auto modifiedTime = m_Slice->GetMTime();
+    region = mitk::BrushRasterizer::Fill(m_Slice, rasterizer.RasterizeStamp(MakeIndex(-10, -10)), 1);
+
+    CPPUNIT_ASSERT_EQUAL(itk::SizeValueType(0), region.GetNumberOfPixels());
+    CPPUNIT_ASSERT_EQUAL(modifiedTime, m_Slice->GetMTime());
+  }
+
+  void MergeRegions_IgnoresEmptyRegions()
+  {
+    RegionType::SizeType size;
+    size.Fill(2);
+    const RegionType region1(MakeIndex(1, 5), size);
+    const RegionType region2(MakeIndex(4, 2), size);
+
+    CPPUNIT_ASSERT_EQUAL(region1, mitk::BrushRasterizer::MergeRegions(RegionType(), region1));
+    CPPUNIT_ASSERT_EQUAL(region1, mitk::BrushRasterizer::MergeRegions(region1, RegionType()));
+
+    const auto merged = mitk::BrushRasterizer::MergeRegions(region1, region2);
+    CPPUNIT_ASSERT_EQUAL(MakeIndex(1, 2), merged.GetIndex());
+    CPPUNIT_ASSERT_EQUAL(itk::SizeValueType(5), merged.GetSize(0));
+    CPPUNIT_ASSERT_EQUAL(itk::SizeValueType(5), merged.GetSize(1));
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkBrushRasterizer)
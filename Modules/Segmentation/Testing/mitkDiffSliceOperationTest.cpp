@@ -0,0 +1,153 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+// Testing
+#include "mitkTestFixture.h"
+#include "mitkTestingMacros.h"
+
+// MITK includes
+#include <mitkCompressedImageDiff.h>
+#include <mitkDiffSliceOperation.h>
+#include <mitkImagePixelWriteAccessor.h>
+#include <mitkLimitedLinearUndo.h>
+#include <mitkSegTool2D.h>
+#include <mitkUndoController.h>
+
+// std includes
+#include <algorithm>
+#include <memory>
+
+class mitkDiffSliceOperationTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkDiffSliceOperationTestSuite);
+  MITK_TEST(GetMemorySize_DoesNotDependOnReferencesToDiff);
+  MITK_TEST(UndoStack_PushAndPopEdits_AccountsMemory);
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+  mitk::Image::Pointer m_Image;
+  mitk::LimitedLinearUndo *m_Undo;
+
+  mitk::PlaneGeometry::Pointer CreatePlane(unsigned int slice) const
+  {
+    auto plane = mitk::PlaneGeometry::New();
+    plane->InitializeStandardPlane(m_Image->GetGeometry(), mitk::AnatomicalPlane::Axial, slice + 0.5);
+    return plane;
+  }
+
+  /** Extracts the slice and paints a block into it.*/
+  mitk::Image::Pointer CreateEditedSlice(const mitk::PlaneGeometry *plane) const
+  {
+    auto slice = mitk::SegTool2D::GetAffectedImageSliceAs2DImage(plane, m_Image, 0);
+
+    mitk::ImagePixelWriteAccessor<unsigned char, 2> accessor(slice);
+    itk::Index<2> index;
+
+    for (index[1] = 2; index[1] < 6; ++index[1])
+      for (index[0] = 1; index[0] < 5; ++index[0])
+        accessor.SetPixelByIndex(index, 1);
+
+    return slice;
+  }
+
+public:
+  void setUp() override
+  {
+    unsigned int dimensions[3] = {8, 8, 8};
+
+    m_Image = mitk::Image::New();
+    m_Image->Initialize(mitk::MakeScalarPixelType<unsigned char>(), 3, dimensions);
+
+    mitk::ImagePixelWriteAccessor<unsigned char, 3> accessor(m_Image);
+    std::fill(accessor.GetData(), accessor.GetData() + 8 * 8 * 8, 0);
+
+    mitk::UndoController undoController(mitk::UndoController::LIMITEDLINEARUNDO);
+    m_Undo = dynamic_cast<mitk::LimitedLinearUndo *>(mitk::UndoController::GetCurrentUndoModel());
+    CPPUNIT_ASSERT(nullptr != m_Undo);
+    m_Undo->Clear();
+  }
+
+  void tearDown() override
+  {
+    m_Undo->Clear();
+    m_Image = nullptr;
+  }
+
+  void GetMemorySize_DoesNotDependOnReferencesToDiff()
+  {
+    auto plane = this->CreatePlane(3);
+    auto originalSlice = mitk::SegTool2D::GetAffectedImageSliceAs2DImage(plane, m_Image, 0);
+    auto editedSlice = this->CreateEditedSlice(plane);
+
+    auto sliceDiff = std::make_shared<mitk::CompressedImageDiff>();
+    sliceDiff->ComputeDiff(originalSlice, editedSlice);
+
+    auto sliceGeometry = dynamic_cast<mitk::SlicedGeometry3D *>(editedSlice->GetGeometry());
+    std::unique_ptr<mitk::Operation> undoOperation(
+      new mitk::DiffSliceOperation(m_Image, sliceDiff, sliceGeometry, 0, plane));
+    std::unique_ptr<mitk::Operation> doOperation(
+      new mitk::DiffSliceOperation(m_Image, sliceDiff, sliceGeometry, 0, plane));
+
+    const auto undoSize = undoOperation->GetMemorySize();
+    const auto doSize = doOperation->GetMemorySize();
+
+    CPPUNIT_ASSERT_EQUAL(undoSize, doSize);
+    CPPUNIT_ASSERT(undoSize + doSize >= 2 * sizeof(mitk::DiffSliceOperation) + sliceDiff->GetMemorySize());
+
+    // the share of an operation stays the same, no matter how many references to the diff exist
+    doOperation.reset();
+    CPPUNIT_ASSERT_EQUAL(undoSize, undoOperation->GetMemorySize());
+
+    sliceDiff.reset();
+    CPPUNIT_ASSERT_EQUAL(undoSize, undoOperation->GetMemorySize());
+  }
+
+  void UndoStack_PushAndPopEdits_AccountsMemory()
+  {
+    CPPUNIT_ASSERT_EQUAL(std::size_t(0), m_Undo->GetMemoryUsage());
+
+    std::size_t usage[4] = {0, 0, 0, 0};
+
+    for (unsigned int i = 1; i < 4; ++i)
+    {
+      auto plane = this->CreatePlane(i);
+      mitk::SegTool2D::WriteSliceToVolume(m_Image, plane, this->CreateEditedSlice(plane), 0, true);
+
+      usage[i] = m_Undo->GetMemoryUsage();
+      CPPUNIT_ASSERT(usage[i] > usage[i - 1]);
+    }
+
+    // undone edits stay accounted for on the redo stack
+    for (unsigned int i = 0; i < 3; ++i)
+      CPPUNIT_ASSERT(m_Undo->Undo());
+
+    CPPUNIT_ASSERT_EQUAL(usage[3], m_Undo->GetMemoryUsage());
+
+    CPPUNIT_ASSERT(m_Undo->Redo());
+    CPPUNIT_ASSERT_EQUAL(usage[3], m_Undo->GetMemoryUsage());
+
+    // dropping the undone edits frees exactly what they added
+    m_Undo->ClearRedoList();
+    CPPUNIT_ASSERT_EQUAL(usage[1], m_Undo->GetMemoryUsage());
+
+    auto plane = this->CreatePlane(5);
+    mitk::SegTool2D::WriteSliceToVolume(m_Image, plane, this->CreateEditedSlice(plane), 0, true);
+    CPPUNIT_ASSERT_EQUAL(usage[2], m_Undo->GetMemoryUsage());
+
+    CPPUNIT_ASSERT(m_Undo->Undo());
+    CPPUNIT_ASSERT(m_Undo->Undo());
+    m_Undo->ClearRedoList();
+    CPPUNIT_ASSERT_EQUAL(std::size_t(0), m_Undo->GetMemoryUsage());
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkDiffSliceOperation)
@@ -0,0 +1,109 @@
+#!/usr/bin/env python3
+# ============================================================================
+#
+# The Medical Imaging Interaction Toolkit (MITK)
+#
+# Copyright (c) German Cancer Research Center (DKFZ)
+# All rights reserved.
+#
+# Use of this source code is governed by a 3-clause BSD license that can be
+# found in the LICENSE file.
+#
+# ============================================================================
+
+"""Stub inference worker for mitkInferenceWorkerTest.
+
+Implements the protocol of mitk::InferenceWorker without any model: pixels
+greater than the "threshold" parameter (default 0) are labeled with the
+"label" parameter (default 1). The parameter "fail" makes a request fail and
+"exit" makes the worker exit without answering. Every answer reports the
+number of requests this worker process has processed so far.
+"""
+
+import json
+import sys
+from multiprocessing import shared_memory
+
+FORMATS = {
+    "char": "b",
+    "unsigned_char": "B",
+    "short": "h",
+    "unsigned_short": "H",
+    "int": "i",
+    "unsigned_int": "I",
+    "long": "q",
+    "unsigned_long": "Q",
+    "long_long": "q",
+    "unsigned_long_long": "Q",
+    "float": "f",
+    "double": "d",
+}
+
+
+def open_shared_memory(name):
+    # names are given as passed to shm_open(), Python prepends the slash itself
+    name = name.lstrip("/")
+    try:
+        return shared_memory.SharedMemory(name=name, track=False)
+    except TypeError:
+        memory = shared_memory.SharedMemory(name=name)
+        # the client owns the memory, prevent the resource tracker from unlinking it
+        from multiprocessing import resource_tracker
+        resource_tracker.unregister(memory._name, "shared_memory")
+        return memory
+
+
+def process(request):
+    parameters = request.get("parameters", {})
+
+    if "fail" in parameters:
+        raise RuntimeError(parameters["fail"])
+
+    if "exit" in parameters:
+        sys.exit(1)
+
+    threshold = float(parameters.get("threshold", 0))
+    label = int(parameters.get("label", 1))
+
+    input_memory = open_shared_memory(request["input"]["shm"])
+    output_memory = open_shared_memory(request["output"]["shm"])
+
+    try:
+        input_format = FORMATS[request["input"]["pixelType"]]
+        output_format = FORMATS[request["output"]["pixelType"]]
+        input_size = request["input"]["bytes"]
+        output_size = request["output"]["bytes"]
+
+        pixels = input_memory.buf[:input_size].cast(input_format)
+        labels = output_memory.buf[:output_size].cast(output_format)
+
+        for i, value in enumerate(pixels):
+            labels[i] = label if value > threshold else 0
+
+        del pixels
+        del labels
+    finally:
+        input_memory.close()
+        output_memory.close()
+
+
+def main():
+    number_of_requests = 0
+    print("READY", flush=True)
+
+    for line in sys.stdin:
+        if not line.strip():
+            continue
+
+        request = json.loads(line)
+        number_of_requests += 1
+
+        try:
+            process(request)
+            print("DONE {} {}".format(request["uid"], number_of_requests), flush=True)
+        except Exception as e:
+            print("ERROR {} {}".format(request["uid"], e), flush=True)
+
+
+if __name__ == "__main__":
+    main()
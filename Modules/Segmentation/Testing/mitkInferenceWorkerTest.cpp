@@ -0,0 +1,208 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+// Testing
+#include "mitkTestFixture.h"
+#include "mitkTestingMacros.h"
+
+// MITK includes
+#include <mitkImageGenerator.h>
+#include <mitkImagePixelReadAccessor.h>
+#include <mitkImagePixelWriteAccessor.h>
+#include <mitkInferenceWorker.h>
+
+#include <itksys/SystemTools.hxx>
+
+class mitkInferenceWorkerTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkInferenceWorkerTestSuite);
+  MITK_TEST(Run_ReturnsLabelImage);
+  MITK_TEST(Run_SameInput_ReturnsCachedResult);
+  MITK_TEST(Run_CacheFull_EvictsLeastRecentlyUsedResult);
+  MITK_TEST(Run_ModifiedInput_RunsInference);
+  MITK_TEST(Run_FailedRequest_Throws);
+  MITK_TEST(Run_WorkerExited_Restarts);
+  MITK_TEST(Start_InvalidCommand_Throws);
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+  std::string m_Python;
+  mitk::Image::Pointer m_Image;
+  mitk::InferenceWorker::Pointer m_Worker;
+
+  /** The stub worker requires Python, tests are skipped if it is not available. */
+  bool IsStubWorkerAvailable() const
+  {
+    if (m_Python.empty())
+    {
+      MITK_WARN << "Python 3 or shared memory not available. Skipping test.";
+      return false;
+    }
+
+    return true;
+  }
+
+public:
+  void setUp() override
+  {
+    if (mitk::InferenceWorker::IsSupported())
+      m_Python = itksys::SystemTools::FindProgram("python3");
+
+    // voxel values are their linear indices: x + 4 * y + 12 * z
+    m_Image = mitk::ImageGenerator::GenerateGradientImage<short>(4, 3, 2);
+
+    m_Worker = mitk::InferenceWorker::New();
+    m_Worker->SetCommand({ m_Python, "-u", MITK_INFERENCE_WORKER_STUB });
+    m_Worker->SetTimeout(60.0);
+  }
+
+  void tearDown() override
+  {
+    m_Worker = nullptr;
+    m_Image = nullptr;
+  }
+
+  void Run_ReturnsLabelImage()
+  {
+    if (!this->IsStubWorkerAvailable())
+      return;
+
+    auto labels = m_Worker->Run(m_Image, { {"threshold", "5"}, {"label", "3"} });
+
+    CPPUNIT_ASSERT(labels.IsNotNull());
+    CPPUNIT_ASSERT(m_Worker->IsRunning());
+    CPPUNIT_ASSERT(mitk::Equal(*m_Image->GetGeometry(), *labels->GetGeometry(), mitk::eps, true));
+
+    mitk::ImagePixelReadAccessor<unsigned short, 3> accessor(labels);
+
+    for (itk::IndexValueType z = 0; z < 2; ++z)
+    {
+      for (itk::IndexValueType y = 0; y < 3; ++y)
+      {
+        for (itk::IndexValueType x = 0; x < 4; ++x)
+        {
+          const itk::Index<3> index = {{x, y, z}};
+          const unsigned short expected = x + 4 * y + 12 * z > 5 ? 3 : 0;
+          CPPUNIT_ASSERT_EQUAL(expected, accessor.GetPixelByIndex(index));
+        }
+      }
+    }
+  }
+
+  void Run_SameInput_ReturnsCachedResult()
+  {
+    if (!this->IsStubWorkerAvailable())
+      return;
+
+    auto labels = m_Worker->Run(m_Image, { {"threshold", "5"} });
+    CPPUNIT_ASSERT_EQUAL(0u, m_Worker->GetNumberOfCacheHits());
+
+    CPPUNIT_ASSERT(labels == m_Worker->Run(m_Image, { {"threshold", "5"} }));
+    CPPUNIT_ASSERT_EQUAL(1u, m_Worker->GetNumberOfCacheHits());
+
+    // other parameters are not answered from the cache
+    CPPUNIT_ASSERT(labels != m_Worker->Run(m_Image, { {"threshold", "6"} }));
+    CPPUNIT_ASSERT_EQUAL(1u, m_Worker->GetNumberOfCacheHits());
+
+    // neither are identical contents if the cache is disabled
+    m_Worker->SetMaximumCacheSize(0);
+    CPPUNIT_ASSERT_EQUAL(std::size_t(0), m_Worker->GetCacheSize());
+    m_Worker->Run(m_Image, { {"threshold", "5"} });
+    CPPUNIT_ASSERT_EQUAL(1u, m_Worker->GetNumberOfCacheHits());
+  }
+
+  void Run_CacheFull_EvictsLeastRecentlyUsedResult()
+  {
+    if (!this->IsStubWorkerAvailable())
+      return;
+
+    // 24 short input pixels and 24 unsigned short output pixels
+    const std::size_t entrySize = 24 * (sizeof(short) + sizeof(unsigned short));
+    m_Worker->SetMaximumCacheSize(entrySize);
+
+    m_Worker->Run(m_Image, { {"threshold", "5"} });
+    CPPUNIT_ASSERT_EQUAL(entrySize, m_Worker->GetCacheSize());
+
+    m_Worker->Run(m_Image, { {"threshold", "6"} });
+    CPPUNIT_ASSERT_EQUAL(entrySize, m_Worker->GetCacheSize());
+
+    m_Worker->Run(m_Image, { {"threshold", "5"} });
+    CPPUNIT_ASSERT_EQUAL(0u, m_Worker->GetNumberOfCacheHits());
+
+    // results that do not fit at all are not cached
+    m_Worker->SetMaximumCacheSize(entrySize - 1);
+    CPPUNIT_ASSERT_EQUAL(std::size_t(0), m_Worker->GetCacheSize());
+    m_Worker->Run(m_Image, { {"threshold", "5"} });
+    CPPUNIT_ASSERT_EQUAL(std::size_t(0), m_Worker->GetCacheSize());
+  }
+
+  void Run_ModifiedInput_RunsInference()
+  {
+    if (!this->IsStubWorkerAvailable())
+      return;
+
+    auto labels = m_Worker->Run(m_Image, { {"threshold", "5"} });
+
+    {
+      mitk::ImagePixelWriteAccessor<short, 3> accessor(m_Image);
+      accessor.SetPixelByIndex({{0, 0, 0}}, 100);
+    }
+
+    auto modifiedLabels = m_Worker->Run(m_Image, { {"threshold", "5"} });
+
+    CPPUNIT_ASSERT(labels != modifiedLabels);
+    CPPUNIT_ASSERT_EQUAL(0u, m_Worker->GetNumberOfCacheHits());
+
+    mitk::ImagePixelReadAccessor<unsigned short, 3> accessor(modifiedLabels);
+    CPPUNIT_ASSERT_EQUAL(static_cast<unsigned short>(1), accessor.GetPixelByIndex({{0, 0, 0}}));
+  }
+
+  void Run_FailedRequest_Throws()
+  {
+    if (!this->IsStubWorkerAvailable())
+      return;
+
+    CPPUNIT_ASSERT_THROW(m_Worker->Run(m_Image, { {"fail", "Model not found"} }), mitk::Exception);
+
+    // the worker keeps running and failed requests are not cached
+    CPPUNIT_ASSERT(m_Worker->IsRunning());
+    CPPUNIT_ASSERT_THROW(m_Worker->Run(m_Image, { {"fail", "Model not found"} }), mitk::Exception);
+    CPPUNIT_ASSERT(m_Worker->Run(m_Image, {}).IsNotNull());
+  }
+
+  void Run_WorkerExited_Restarts()
+  {
+    if (!this->IsStubWorkerAvailable())
+      return;
+
+    CPPUNIT_ASSERT_THROW(m_Worker->Run(m_Image, { {"exit", "1"} }), mitk::Exception);
+    CPPUNIT_ASSERT(!m_Worker->IsRunning());
+
+    CPPUNIT_ASSERT(m_Worker->Run(m_Image, {}).IsNotNull());
+    CPPUNIT_ASSERT(m_Worker->IsRunning());
+
+    m_Worker->Stop();
+    CPPUNIT_ASSERT(!m_Worker->IsRunning());
+  }
+
+  void Start_InvalidCommand_Throws()
+  {
+    if (!mitk::InferenceWorker::IsSupported())
+      return;
+
+    m_Worker->SetCommand({ "mitk-inference-worker-that-does-not-exist" });
+    CPPUNIT_ASSERT_THROW(m_Worker->Start(), mitk::Exception);
+    CPPUNIT_ASSERT(!m_Worker->IsRunning());
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkInferenceWorker)
@@ -0,0 +1,308 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+// Testing
+#include "mitkTestFixture.h"
+#include "mitkTestingMacros.h"
+
+// MITK includes
+#include <mitkExtractSliceFilter.h>
+#include <mitkImagePixelWriteAccessor.h>
+#include <mitkImageReadAccessor.h>
+#include <mitkLabelSetImage.h>
+#include <mitkLimitedLinearUndo.h>
+#include <mitkSegTool2D.h>
+#include <mitkSegmentationInterpolationController.h>
+#include <mitkUndoController.h>
+#include <mitkVtkImageOverwrite.h>
+
+// std includes
+#include <algorithm>
+#include <cstring>
+
+namespace
+{
+  /** Gives access to the region write of SegTool2D. Never instantiated.*/
+  class SegTool2DRegionWrite : public mitk::SegTool2D
+  {
+  public:
+    using mitk::SegTool2D::SliceInformation;
+    using mitk::SegTool2D::WriteSliceRegionToVolume;
+  };
+
+  /** Gives access to the counts and the interpolated image of the controller.*/
+  class CountingInterpolationController : public mitk::SegmentationInterpolationController
+  {
+  public:
+    mitkClassMacro(CountingInterpolationController, mitk::SegmentationInterpolationController);
+    itkFactorylessNewMacro(Self);
+
+    const TimeResolvedDirtyVectorType &GetCounts() const { return m_SegmentationCountInSlice; }
+    const mitk::Image *GetInterpolatedImage() const { return m_Segmentation; }
+  };
+}
+
+class mitkSegTool2DRegionWriteTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkSegTool2DRegionWriteTestSuite);
+  MITK_TEST(WriteSliceRegionToVolume_StandardPlanes_MatchesReslicing);
+  MITK_TEST(WriteSliceRegionToVolume_UndoRedo_RestoresBothStates);
+  MITK_TEST(WriteSliceRegionToVolume_Interpolator_CountsMatchRescan);
+  MITK_TEST(WriteSliceRegionToVolume_LabelInterpolator_MaskAndCountsMatchRescan);
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+  typedef mitk::Label::PixelType PixelType;
+
+  mitk::Image::Pointer m_Volume;
+  mitk::LimitedLinearUndo *m_Undo;
+
+  mitk::PlaneGeometry::Pointer CreatePlane(mitk::AnatomicalPlane orientation, unsigned int slice) const
+  {
+    auto plane = mitk::PlaneGeometry::New();
+    plane->InitializeStandardPlane(m_Volume->GetGeometry(), orientation, slice + 0.5);
+    return plane;
+  }
+
+  static itk::ImageRegion<2> MakeRegion(itk::IndexValueType x, itk::IndexValueType y, itk::SizeValueType width, itk::SizeValueType height)
+  {
+    itk::ImageRegion<2> region;
+    region.SetIndex(0, x);
+    region.SetIndex(1, y);
+    region.SetSize(0, width);
+    region.SetSize(1, height);
+    return region;
+  }
+
+  /** Extracts the slice of the image and paints the passed values into the region.*/
+  static mitk::Image::Pointer CreateEditedSlice(const mitk::Image *image,
+                                                const mitk::PlaneGeometry *plane,
+                                                const itk::ImageRegion<2> &region,
+                                                PixelType value0,
+                                                PixelType value1)
+  {
+    auto slice = mitk::SegTool2D::GetAffectedImageSliceAs2DImage(plane, image, 0);
+
+    mitk::ImagePixelWriteAccessor<PixelType, 2> accessor(slice);
+    itk::Index<2> index;
+
+    for (index[1] = region.GetIndex(1); index[1] < region.GetUpperIndex()[1] + 1; ++index[1])
+      for (index[0] = region.GetIndex(0); index[0] < region.GetUpperIndex()[0] + 1; ++index[0])
+        accessor.SetPixelByIndex(index, 0 == (index[0] + index[1]) % 2 ? value0 : value1);
+
+    return slice;
+  }
+
+  /** Writes the region of the edited slice into the image, like the tools do.*/
+  static void WriteRegion(mitk::Image *image,
+                          const mitk::PlaneGeometry *plane,
+                          const mitk::Image *slice,
+                          const itk::ImageRegion<2> &region,
+                          bool allowUndo)
+  {
+    SegTool2DRegionWrite::SliceInformation sliceInfo(slice, plane, 0);
+    sliceInfo.changedRegion = region;
+
+    CPPUNIT_ASSERT(SegTool2DRegionWrite::WriteSliceRegionToVolume(image, sliceInfo, allowUndo));
+  }
+
+  /** Writes the whole slice into the image by reslicing, the path for planes that are not aligned with the voxels.*/
+  static void WriteByReslicing(mitk::Image *image, const mitk::PlaneGeometry *plane, mitk::Image *slice)
+  {
+    auto reslice = vtkSmartPointer<mitkVtkImageOverwrite>::New();
+    reslice->SetInputSlice(slice->GetVtkImageData());
+    reslice->SetOverwriteMode(true);
+    reslice->Modified();
+
+    auto extractor = mitk::ExtractSliceFilter::New(reslice);
+    extractor->SetInput(image);
+    extractor->SetTimeStep(0);
+    extractor->SetWorldGeometry(plane);
+    extractor->SetVtkOutputRequest(false);
+    extractor->SetResliceTransformByGeometry(image->GetGeometry(0));
+    extractor->Modified();
+    extractor->Update();
+  }
+
+  static bool AreEqual(const mitk::Image *image1, const mitk::Image *image2)
+  {
+    for (unsigned int dim = 0; dim < 3; ++dim)
+    {
+      if (image1->GetDimension(dim) != image2->GetDimension(dim))
+        return false;
+    }
+
+    mitk::ImageReadAccessor accessor1(image1);
+    mitk::ImageReadAccessor accessor2(image2);
+
+    return 0 == std::memcmp(accessor1.GetData(),
+                            accessor2.GetData(),
+                            image1->GetDimension(0) * image1->GetDimension(1) * image1->GetDimension(2) * sizeof(PixelType));
+  }
+
+  /** Fills the image with a block of value in the center.*/
+  static void FillBlock(mitk::Image *image, PixelType value)
+  {
+    mitk::ImagePixelWriteAccessor<PixelType, 3> accessor(image);
+    std::fill(accessor.GetData(), accessor.GetData() + 6 * 5 * 4, 0);
+
+    itk::Index<3> index;
+
+    for (index[2] = 1; index[2] < 3; ++index[2])
+      for (index[1] = 1; index[1] < 4; ++index[1])
+        for (index[0] = 2; index[0] < 5; ++index[0])
+          accessor.SetPixelByIndex(index, value);
+  }
+
+public:
+  void setUp() override
+  {
+    unsigned int dimensions[3] = {6, 5, 4};
+
+    m_Volume = mitk::Image::New();
+    m_Volume->Initialize(mitk::MakeScalarPixelType<PixelType>(), 3, dimensions);
+
+    mitk::Vector3D spacing;
+    mitk::FillVector3D(spacing, 0.5, 2.0, 1.5);
+    m_Volume->GetGeometry()->SetSpacing(spacing);
+
+    FillBlock(m_Volume, 1);
+
+    mitk::UndoController undoController(mitk::UndoController::LIMITEDLINEARUNDO);
+    m_Undo = dynamic_cast<mitk::LimitedLinearUndo *>(mitk::UndoController::GetCurrentUndoModel());
+    CPPUNIT_ASSERT(nullptr != m_Undo);
+    m_Undo->Clear();
+  }
+
+  void tearDown() override
+  {
+    m_Undo->Clear();
+    m_Volume = nullptr;
+  }
+
+  void WriteSliceRegionToVolume_StandardPlanes_MatchesReslicing()
+  {
+    const std::pair<mitk::AnatomicalPlane, unsigned int> planes[] = {
+      {mitk::AnatomicalPlane::Axial, 1},
+      {mitk::AnatomicalPlane::Sagittal, 3},
+      {mitk::AnatomicalPlane::Coronal, 2}};
+
+    for (const auto &planeAndSlice : planes)
+    {
+      auto plane = this->CreatePlane(planeAndSlice.first, planeAndSlice.second);
+      auto regionImage = m_Volume->Clone();
+      auto reslicedImage = m_Volume->Clone();
+
+      // the changed region is only a part of the slice, the rest of the slice is not written
+      const auto region = MakeRegion(1, 1, 2, 2);
+      auto slice = CreateEditedSlice(regionImage, plane, region, 2, 0);
+
+      WriteRegion(regionImage, plane, slice, region, false);
+      WriteByReslicing(reslicedImage, plane, slice);
+
+      CPPUNIT_ASSERT(AreEqual(reslicedImage, regionImage));
+      CPPUNIT_ASSERT(!AreEqual(m_Volume, regionImage));
+    }
+  }
+
+  void WriteSliceRegionToVolume_UndoRedo_RestoresBothStates()
+  {
+    auto plane = this->CreatePlane(mitk::AnatomicalPlane::Coronal, 2);
+    auto before = m_Volume->Clone();
+
+    const auto region = MakeRegion(1, 0, 3, 2);
+    WriteRegion(m_Volume, plane, CreateEditedSlice(m_Volume, plane, region, 3, 0), region, true);
+
+    auto after = m_Volume->Clone();
+    CPPUNIT_ASSERT(!AreEqual(before, after));
+
+    CPPUNIT_ASSERT(m_Undo->Undo());
+    CPPUNIT_ASSERT(AreEqual(before, m_Volume));
+
+    CPPUNIT_ASSERT(m_Undo->Redo());
+    CPPUNIT_ASSERT(AreEqual(after, m_Volume));
+
+    CPPUNIT_ASSERT(m_Undo->Undo());
+    CPPUNIT_ASSERT(AreEqual(before, m_Volume));
+  }
+
+  void WriteSliceRegionToVolume_Interpolator_CountsMatchRescan()
+  {
+    auto interpolator = CountingInterpolationController::New();
+    interpolator->SetSegmentationVolume(m_Volume);
+    interpolator->Activate2DInterpolation(true);
+
+    auto plane = this->CreatePlane(mitk::AnatomicalPlane::Axial, 2);
+    WriteRegion(m_Volume, plane, CreateEditedSlice(m_Volume, plane, MakeRegion(0, 0, 4, 3), 0, 2), MakeRegion(0, 0, 4, 3), true);
+
+    plane = this->CreatePlane(mitk::AnatomicalPlane::Sagittal, 3);
+    WriteRegion(m_Volume, plane, CreateEditedSlice(m_Volume, plane, MakeRegion(1, 1, 3, 2), 3, 0), MakeRegion(1, 1, 3, 2), true);
+
+    plane = this->CreatePlane(mitk::AnatomicalPlane::Coronal, 0);
+    WriteRegion(m_Volume, plane, CreateEditedSlice(m_Volume, plane, MakeRegion(2, 0, 2, 4), 1, 1), MakeRegion(2, 0, 2, 4), true);
+
+    // the undo of a region is a region write, too
+    CPPUNIT_ASSERT(m_Undo->Undo());
+
+    const auto counts = interpolator->GetCounts();
+
+    auto rescan = CountingInterpolationController::New();
+    rescan->SetSegmentationVolume(m_Volume);
+
+    CPPUNIT_ASSERT(counts == rescan->GetCounts());
+  }
+
+  void WriteSliceRegionToVolume_LabelInterpolator_MaskAndCountsMatchRescan()
+  {
+    auto segmentation = mitk::LabelSetImage::New();
+    segmentation->Initialize(m_Volume);
+
+    mitk::Color color;
+    color.Set(1.0f, 0.0f, 0.0f);
+    const auto label = segmentation->AddLabel("label", color, 0)->GetValue();
+    const auto otherLabel = segmentation->AddLabel("other label", color, 0)->GetValue();
+
+    FillBlock(segmentation, label);
+
+    // like QmitkSlicesInterpolator, which interpolates the mask of the active label
+    auto interpolator = CountingInterpolationController::New();
+    interpolator->SetSegmentationVolume(segmentation, label);
+    interpolator->Activate2DInterpolation(true);
+
+    CPPUNIT_ASSERT(interpolator.GetPointer() == mitk::SegmentationInterpolationController::InterpolatorForLabelSegmentation(segmentation));
+    CPPUNIT_ASSERT(nullptr == mitk::SegmentationInterpolationController::InterpolatorForImage(segmentation));
+
+    const auto *mask = interpolator->GetInterpolatedImage();
+
+    auto plane = this->CreatePlane(mitk::AnatomicalPlane::Axial, 1);
+    WriteRegion(segmentation, plane, CreateEditedSlice(segmentation, plane, MakeRegion(1, 0, 4, 3), otherLabel, 0), MakeRegion(1, 0, 4, 3), true);
+
+    plane = this->CreatePlane(mitk::AnatomicalPlane::Coronal, 3);
+    WriteRegion(segmentation, plane, CreateEditedSlice(segmentation, plane, MakeRegion(0, 0, 3, 4), label, otherLabel), MakeRegion(0, 0, 3, 4), true);
+
+    plane = this->CreatePlane(mitk::AnatomicalPlane::Sagittal, 2);
+    WriteRegion(segmentation, plane, CreateEditedSlice(segmentation, plane, MakeRegion(2, 1, 2, 2), label, label), MakeRegion(2, 1, 2, 2), true);
+
+    CPPUNIT_ASSERT(m_Undo->Undo());
+
+    // the mask was updated in place instead of being created again
+    CPPUNIT_ASSERT(mask == interpolator->GetInterpolatedImage());
+
+    auto rescan = CountingInterpolationController::New();
+    rescan->SetSegmentationVolume(segmentation, label);
+
+    CPPUNIT_ASSERT(AreEqual(rescan->GetInterpolatedImage(), mask));
+    CPPUNIT_ASSERT(interpolator->GetCounts() == rescan->GetCounts());
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkSegTool2DRegionWrite)
@@ -3,6 +3,8 @@ set(H_FILES
 )
 
 set(CPP_FILES
+  Algorithms/mitkAlignedSliceMapping.cpp
+  Algorithms/mitkBrushRasterizer.cpp
   Algorithms/mitkCalculateSegmentationVolume.cpp
   Algorithms/mitkContourModelSetToImageFilter.cpp
   Algorithms/mitkContourSetToPointSetFilter.cpp
@@ -48,6 +50,7 @@ set(CPP_FILES
   Interactions/mitkFillRegionBaseTool.cpp
   Interactions/mitkFillRegionTool.cpp
   Interactions/mitkGrowCutTool.cpp
+  Interactions/mitkInferenceWorker.cpp
   Interactions/mitkLassoTool.cpp
   Interactions/mitkLiveWireTool2D.cpp
   Interactions/mitkMedSAMTool.cpp
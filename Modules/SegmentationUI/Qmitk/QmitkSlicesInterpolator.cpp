@@ -831,19 +831,17 @@ void QmitkSlicesInterpolator::AcceptAllInterpolations(mitk::SliceNavigationContr
         return;
       }
 
-      mitk::Image::Pointer activeLabelImage;
       try
       {
         auto labelSetImage = dynamic_cast<mitk::LabelSetImage *>(m_Segmentation);
-        activeLabelImage = mitk::CreateLabelMask(labelSetImage, labelSetImage->GetActiveLabel()->GetValue());
+        m_Interpolator->SetSegmentationVolume(labelSetImage, labelSetImage->GetActiveLabel()->GetValue());
       }
       catch (const std::exception& e)
       {
         MITK_ERROR << e.what() << " | NO LABELSETIMAGE IN WORKING NODE\n";
+        m_Interpolator->SetSegmentationVolume(nullptr);
       }
 
-      m_Interpolator->SetSegmentationVolume(activeLabelImage);
-
       timeStep = geometry->TimePointToTimeStep(m_TimePoint);
 
       auto timeSelector = mitk::ImageTimeSelector::New();
@@ -1229,8 +1227,8 @@ void QmitkSlicesInterpolator::OnInterpolationActivated(bool on)
       const auto* segmentation = dynamic_cast<mitk::Image*>(workingNode->GetData());
       if (nullptr != activeLabel && nullptr != segmentation)
       {
-        auto activeLabelImage = mitk::CreateLabelMask(labelSetImage, activeLabel->GetValue());
-        m_Interpolator->SetSegmentationVolume(activeLabelImage);
+        // the interpolator keeps the mask of the label up to date while the segmentation is edited
+        m_Interpolator->SetSegmentationVolume(labelSetImage, activeLabel->GetValue());
 
         if (referenceNode)
         {
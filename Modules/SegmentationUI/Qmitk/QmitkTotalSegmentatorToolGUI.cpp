@@ -16,6 +16,8 @@ found in the LICENSE file.
 #include <mitkProcessExecutor.h>
 #include <mitkTotalSegmentatorTool.h>
 #include <QApplication>
+#include <QDir>
+#include <QFile>
 #include <QIcon>
 #include <QmitkStyleManager.h>
 #include <mitkCoreServices.h>
@@ -133,6 +135,7 @@ void QmitkTotalSegmentatorToolGUI::OnPreviewBtnClicked()
     }
     QString totalPath = QString::fromStdString(m_Preferences->Get("TotalSeg/totalSegPath", ""));
     tool->SetPythonPath(totalPath.toStdString());
+    this->UpdateInferenceWorker(tool);
     tool->SetGpuId(m_Preferences->GetInt("TotalSeg/deviceId", 0));
     tool->SetFast(isFast);
     tool->SetSubTask(subTask.toStdString());
@@ -165,6 +168,29 @@ void QmitkTotalSegmentatorToolGUI::OnPreviewBtnClicked()
   this->WriteStatusMessage("<b>STATUS: </b><i>Segmentation task finished successfully.</i>");
 }
 
+void QmitkTotalSegmentatorToolGUI::UpdateInferenceWorker(mitk::TotalSegmentatorTool *tool)
+{
+  const QString scriptPath = QString::fromStdString(m_Preferences->Get("TotalSeg/inferenceWorkerScript", ""));
+  if (scriptPath.isEmpty() || !mitk::InferenceWorker::IsSupported())
+  {
+    tool->SetInferenceWorker(nullptr);
+    return;
+  }
+  if (!QFile::exists(scriptPath))
+  {
+    throw std::runtime_error("The inference worker script selected in the preferences does not exist: " +
+                             scriptPath.toStdString());
+  }
+  if (m_InferenceWorker.IsNull())
+  {
+    m_InferenceWorker = mitk::InferenceWorker::New();
+  }
+  // a changed python environment or script restarts the worker
+  const QString python = QString::fromStdString(tool->GetPythonPath()) + QDir::separator() + QString("python3");
+  m_InferenceWorker->SetCommand({python.toStdString(), "-u", scriptPath.toStdString()});
+  tool->SetInferenceWorker(m_InferenceWorker);
+}
+
 void QmitkTotalSegmentatorToolGUI::ShowErrorMessage(const std::string &message, QMessageBox::Icon icon)
 {
   this->setCursor(Qt::ArrowCursor);
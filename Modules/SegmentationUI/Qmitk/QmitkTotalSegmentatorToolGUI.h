@@ -16,6 +16,7 @@ found in the LICENSE file.
 #include "QmitkMultiLabelSegWithPreviewToolGUIBase.h"
 
 #include <MitkSegmentationUIExports.h>
+#include <mitkInferenceWorker.h>
 #include <mitkIPreferences.h>
 
 #include <QMessageBox>
@@ -25,6 +26,11 @@ namespace Ui
   class QmitkTotalSegmentatorToolGUIControls;
 }
 
+namespace mitk
+{
+  class TotalSegmentatorTool;
+}
+
 /*
   \ingroup org_mitk_gui_qt_interactivesegmentation_internal
   \brief GUI for mitk::TotalSegmentatorTool.
@@ -77,10 +83,18 @@ protected:
    */
   void OnPreferenceChangedEvent(const mitk::IPreferences::ChangeEvent&);
 
+  /**
+   * @brief Sets the inference worker of the worker script selected in the preferences on the tool, or none
+   * if no script is selected. The worker is run by python3 of the TotalSegmentator environment and kept
+   * alive between previews.
+   */
+  void UpdateInferenceWorker(mitk::TotalSegmentatorTool *tool);
+
   Ui::QmitkTotalSegmentatorToolGUIControls* m_Controls;
   bool m_FirstPreviewComputation = true;
   EnableConfirmSegBtnFunctionType m_SuperclassEnableConfirmSegBtnFnc;
   mitk::IPreferences* m_Preferences;
+  mitk::InferenceWorker::Pointer m_InferenceWorker;
   const QStringList VALID_TASKS = {
     "total",
     "total_mr",
@@ -103,6 +103,7 @@ void QmitknnUNetToolGUI::InitializeUI(QBoxLayout *mainLayout)
   connect(m_Controls.clearCacheButton, SIGNAL(clicked()), this, SLOT(OnClearCachePressed()));
   connect(m_Controls.startDownloadButton, SIGNAL(clicked()), this, SLOT(OnDownloadModel()));
   connect(m_Controls.stopDownloadButton, SIGNAL(clicked()), this, SLOT(OnStopDownload()));
+  connect(m_Controls.inferenceWorkerButton, SIGNAL(clicked()), this, SLOT(OnSelectInferenceWorker()));
 
   // Qthreads
   qRegisterMetaType<mitk::ProcessExecutor::Pointer>();
@@ -145,6 +146,12 @@ void QmitknnUNetToolGUI::InitializeUI(QBoxLayout *mainLayout)
   this->DisableEverything();
   QString lastSelectedPyEnv = m_Settings.value("nnUNet/LastPythonPath").toString();
   m_Controls.pythonEnvComboBox->setCurrentText(lastSelectedPyEnv);
+
+  const bool isInferenceWorkerSupported = mitk::InferenceWorker::IsSupported();
+  m_Controls.inferenceWorkerLabel->setVisible(isInferenceWorkerSupported);
+  m_Controls.inferenceWorkerLineEdit->setVisible(isInferenceWorkerSupported);
+  m_Controls.inferenceWorkerButton->setVisible(isInferenceWorkerSupported);
+  m_Controls.inferenceWorkerLineEdit->setText(m_Settings.value("nnUNet/InferenceWorkerScript").toString());
 }
 
 void QmitknnUNetToolGUI::EnableWidgets(bool enabled)
@@ -634,6 +641,7 @@ void QmitknnUNetToolGUI::OnPreviewRequested()
                                  "python environment or install nnUNet.");
       }
       tool->SetPythonPath(pythonPath.toStdString());
+      this->UpdateInferenceWorker(tool);
       tool->SetModelDirectory(m_ParentFolder->getResultsFolder().toStdString());
       // checkboxes
       tool->SetMirror(m_Controls.mirrorBox->isChecked());
@@ -716,6 +724,7 @@ void QmitknnUNetToolGUI::OnPreviewRequested()
     if (!pythonPathTextItem.isEmpty())
     { // only cache if the prediction ended without errors.
       m_Settings.setValue("nnUNet/LastPythonPath", pythonPathTextItem);
+      m_Settings.setValue("nnUNet/InferenceWorkerScript", m_Controls.inferenceWorkerLineEdit->text().trimmed());
     }
   }
 }
@@ -1199,5 +1208,41 @@ void QmitknnUNetToolGUI::OnStopDownload()
 void QmitknnUNetToolGUI::OnClearCachePressed()
 {
   m_Cache.clear();
+  if (m_InferenceWorker.IsNotNull())
+  {
+    m_InferenceWorker->ClearCache();
+  }
   this->UpdateCacheCountOnUI();
 }
+
+void QmitknnUNetToolGUI::OnSelectInferenceWorker()
+{
+  QString path = QFileDialog::getOpenFileName(
+    m_Controls.inferenceWorkerButton->parentWidget(), "Inference Worker Script", QString(), "Python (*.py)");
+  if (!path.isEmpty())
+  {
+    m_Controls.inferenceWorkerLineEdit->setText(path);
+  }
+}
+
+void QmitknnUNetToolGUI::UpdateInferenceWorker(mitk::nnUNetTool *tool)
+{
+  const QString scriptPath = m_Controls.inferenceWorkerLineEdit->text().trimmed();
+  if (scriptPath.isEmpty() || !mitk::InferenceWorker::IsSupported())
+  {
+    tool->SetInferenceWorker(nullptr);
+    return;
+  }
+  if (!QFile::exists(scriptPath))
+  {
+    throw std::runtime_error("The selected inference worker script does not exist: " + scriptPath.toStdString());
+  }
+  if (m_InferenceWorker.IsNull())
+  {
+    m_InferenceWorker = mitk::InferenceWorker::New();
+  }
+  // a changed python environment or script restarts the worker
+  const QString python = m_PythonPath + QDir::separator() + QString("python3");
+  m_InferenceWorker->SetCommand({python.toStdString(), "-u", scriptPath.toStdString()});
+  tool->SetInferenceWorker(m_InferenceWorker);
+}
@@ -17,6 +17,7 @@ found in the LICENSE file.
 #include "QmitknnUNetFolderParser.h"
 #include "QmitknnUNetGPU.h"
 #include "QmitknnUNetWorker.h"
+#include "mitkInferenceWorker.h"
 #include "mitkProcessExecutor.h"
 #include "mitknnUnetTool.h"
 #include "ui_QmitknnUNetToolGUIControls.h"
@@ -100,6 +101,12 @@ protected slots:
    */
   void OnCheckBoxChanged(int);
 
+  /**
+   * @brief Qt slot
+   *
+   */
+  void OnSelectInferenceWorker();
+
   /**
    * @brief Qthread slot to capture failures from thread worker and
    * shows error message
@@ -345,6 +352,12 @@ private:
    */
   void UpdateCacheCountOnUI();
 
+  /**
+   * @brief Sets the inference worker of the selected worker script on the tool, or none if no script is selected.
+   * The worker is run by python3 of the selected python environment and kept alive between previews.
+   */
+  void UpdateInferenceWorker(mitk::nnUNetTool *tool);
+
   Ui_QmitknnUNetToolGUIControls m_Controls;
   QmitkGPULoader m_GpuLoader;
 
@@ -361,6 +374,8 @@ private:
 
   QString m_PythonPath;
 
+  mitk::InferenceWorker::Pointer m_InferenceWorker;
+
   /**
    * @brief Stores row count of the "advancedSettingsLayout" layout element. This value helps dynamically add
    * ctk-path-line-edit UI elements at the right place. Forced to initialize in the InitializeUI method since there is
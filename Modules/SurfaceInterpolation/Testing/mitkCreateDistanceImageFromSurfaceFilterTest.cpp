@@ -17,7 +17,22 @@ found in the LICENSE file.
 #include <mitkTestFixture.h>
 #include <mitkTestingMacros.h>
 
+#include <mitkImageCast.h>
+
+#include <itkImage.h>
+#include <itkImageRegionConstIterator.h>
+#include <itkMath.h>
+
+#include <vtkCellArray.h>
+#include <vtkCellData.h>
 #include <vtkDebugLeaks.h>
+#include <vtkDoubleArray.h>
+#include <vtkPoints.h>
+#include <vtkPolyData.h>
+#include <vtkSmartPointer.h>
+
+#include <algorithm>
+#include <cmath>
 
 class mitkCreateDistanceImageFromSurfaceFilterTestSuite : public mitk::TestFixture
 {
@@ -26,11 +41,75 @@ class mitkCreateDistanceImageFromSurfaceFilterTestSuite : public mitk::TestFixtu
   // Basically tests the same as the other test below
   // MITK_TEST(TestCreateDistanceImageForLiver);
   MITK_TEST(TestCreateDistanceImageForTube);
+  MITK_TEST(TestCompactlySupportedInterpolation);
+  MITK_TEST(TestCompactlySupportedInterpolationOfManyContours);
   CPPUNIT_TEST_SUITE_END();
 
 private:
   std::vector<mitk::Surface::Pointer> contourList;
 
+  /** Circles on parallel planes through a sphere, with outward normals as computed by ComputeContourSetNormalsFilter */
+  static std::vector<mitk::Surface::Pointer> CreateSphereContours(unsigned int numberOfContours)
+  {
+    const double center = 50.0;
+    const double radius = 30.0;
+    const unsigned int pointsPerContour = 48;
+
+    std::vector<mitk::Surface::Pointer> contours;
+
+    for (unsigned int c = 0; c < numberOfContours; ++c)
+    {
+      const double dz = radius * (-0.9 + 1.8 * c / std::max(1u, numberOfContours - 1));
+      const double circleRadius = std::sqrt(radius * radius - dz * dz);
+
+      auto points = vtkSmartPointer<vtkPoints>::New();
+      auto normals = vtkSmartPointer<vtkDoubleArray>::New();
+      normals->SetNumberOfComponents(3);
+      auto polys = vtkSmartPointer<vtkCellArray>::New();
+      polys->InsertNextCell(pointsPerContour);
+
+      for (unsigned int i = 0; i < pointsPerContour; ++i)
+      {
+        const double angle = 2.0 * itk::Math::pi * i / pointsPerContour;
+        const double offset[3] = { circleRadius * std::cos(angle), circleRadius * std::sin(angle), dz };
+        points->InsertNextPoint(center + offset[0], center + offset[1], center + offset[2]);
+        normals->InsertNextTuple3(offset[0] / radius, offset[1] / radius, offset[2] / radius);
+        polys->InsertCellPoint(i);
+      }
+
+      auto polyData = vtkSmartPointer<vtkPolyData>::New();
+      polyData->SetPoints(points);
+      polyData->SetPolys(polys);
+      polyData->GetCellData()->SetNormals(normals);
+
+      auto contour = mitk::Surface::New();
+      contour->SetVtkPolyData(polyData);
+      contours.push_back(contour);
+    }
+
+    return contours;
+  }
+
+  static mitk::Image::Pointer InterpolateSphere(
+    unsigned int numberOfContours, mitk::CreateDistanceImageFromSurfaceFilter::InterpolationMethod method)
+  {
+    auto referenceImage = itk::Image<unsigned char, 3>::New();
+    itk::Image<unsigned char, 3>::SizeType size;
+    size.Fill(100);
+    referenceImage->SetRegions(size);
+
+    auto filter = mitk::CreateDistanceImageFromSurfaceFilter::New();
+    filter->SetReferenceImage(referenceImage.GetPointer());
+    filter->SetInterpolationMethod(method);
+
+    const auto contours = CreateSphereContours(numberOfContours);
+    for (unsigned int i = 0; i < contours.size(); ++i)
+      filter->SetInput(i, contours[i]);
+
+    filter->Update();
+    return filter->GetOutput();
+  }
+
 public:
   void setUp() override {}
   template <typename TPixel, unsigned int VImageDimension>
@@ -128,6 +207,53 @@ public:
     CPPUNIT_ASSERT_MESSAGE("HolesDistanceImages are not equal!",
                            mitk::Equal(*(holesDistanceImageReference), *(holeDistanceImage), 0.0001, true));
   }
+
+  void TestCompactlySupportedInterpolation()
+  {
+    using Method = mitk::CreateDistanceImageFromSurfaceFilter::InterpolationMethod;
+    using DistanceImageType = mitk::CreateDistanceImageFromSurfaceFilter::DistanceImageType;
+
+    auto dense = InterpolateSphere(10, Method::Dense);
+    auto compact = InterpolateSphere(10, Method::CompactlySupported);
+
+    DistanceImageType::Pointer denseITK, compactITK;
+    mitk::CastToItkImage(dense, denseITK);
+    mitk::CastToItkImage(compact, compactITK);
+
+    CPPUNIT_ASSERT_EQUAL(denseITK->GetLargestPossibleRegion(), compactITK->GetLargestPossibleRegion());
+
+    // Both have to agree on the side of the surface for the pixels in both narrow bands
+    const double bandLimit = 2.5 * dense->GetGeometry()->GetSpacing()[0];
+    unsigned int numberOfBandPixels = 0;
+    unsigned int numberOfEqualSigns = 0;
+
+    itk::ImageRegionConstIterator<DistanceImageType> denseIter(denseITK, denseITK->GetLargestPossibleRegion());
+    itk::ImageRegionConstIterator<DistanceImageType> compactIter(compactITK, compactITK->GetLargestPossibleRegion());
+    for (; !denseIter.IsAtEnd(); ++denseIter, ++compactIter)
+    {
+      if (std::fabs(denseIter.Get()) < bandLimit && std::fabs(compactIter.Get()) < bandLimit)
+      {
+        ++numberOfBandPixels;
+        if ((denseIter.Get() < 0) == (compactIter.Get() < 0))
+          ++numberOfEqualSigns;
+      }
+    }
+
+    CPPUNIT_ASSERT(numberOfBandPixels > 0);
+    CPPUNIT_ASSERT_MESSAGE("Compactly supported interpolation differs from the dense one",
+                           numberOfEqualSigns >= 0.9 * numberOfBandPixels);
+  }
+
+  void TestCompactlySupportedInterpolationOfManyContours()
+  {
+    using Method = mitk::CreateDistanceImageFromSurfaceFilter::InterpolationMethod;
+
+    // beyond the number of contour points the dense interpolation can handle in reasonable time
+    auto compact = InterpolateSphere(80, Method::CompactlySupported);
+
+    CPPUNIT_ASSERT(compact.IsNotNull());
+    CPPUNIT_ASSERT(compact->IsInitialized());
+  }
 };
 
 MITK_TEST_SUITE_REGISTRATION(mitkCreateDistanceImageFromSurfaceFilter)
@@ -16,13 +16,68 @@ found in the LICENSE file.
 #include "vtkCellArray.h"
 #include "vtkCellData.h"
 #include "vtkDoubleArray.h"
+#include "vtkPoints.h"
 #include "vtkPolyData.h"
 #include "vtkSmartPointer.h"
+#include "vtkStaticPointLocator.h"
 
 #include "itkImageRegionIteratorWithIndex.h"
-#include "itkNeighborhoodIterator.h"
+#include "itkMultiThreaderBase.h"
 
-#include <queue>
+#include <itkeigen/Eigen/Sparse>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <unordered_set>
+
+namespace
+{
+  using CenterGridCell = std::array<std::int64_t, 3>;
+
+  CenterGridCell GetCenterGridCell(const mitk::CreateDistanceImageFromSurfaceFilter::PointType &p, double cellSize)
+  {
+    return { { static_cast<std::int64_t>(std::floor(p[0] / cellSize)),
+               static_cast<std::int64_t>(std::floor(p[1] / cellSize)),
+               static_cast<std::int64_t>(std::floor(p[2] / cellSize)) } };
+  }
+
+  // 21 bits per dimension are sufficient for any grid of contour points
+  std::uint64_t GetCenterGridKey(std::int64_t x, std::int64_t y, std::int64_t z)
+  {
+    const std::int64_t bias = 1 << 20;
+    const std::uint64_t mask = (1 << 21) - 1;
+    return (static_cast<std::uint64_t>(x + bias) & mask) | ((static_cast<std::uint64_t>(y + bias) & mask) << 21) |
+           ((static_cast<std::uint64_t>(z + bias) & mask) << 42);
+  }
+
+  /** Wendland's C2 function for q = r / supportRadius, positive definite in 3D */
+  double Wendland(double q)
+  {
+    if (q >= 1.0)
+      return 0.0;
+
+    const double t = 1.0 - q;
+    const double t2 = t * t;
+    return t2 * t2 * (4.0 * q + 1.0);
+  }
+
+  /** Hash of the exact coordinates of a contour point, so duplicates are found in constant time */
+  struct ContourPointHash
+  {
+    std::size_t operator()(const std::array<double, 3> &p) const
+    {
+      std::size_t hash = 0;
+      for (auto value : p)
+      {
+        // + 0.0 maps -0.0 to 0.0, which compare equal
+        hash = hash * 31 + std::hash<double>()(value + 0.0);
+      }
+      return hash;
+    }
+  };
+}
 
 void mitk::CreateDistanceImageFromSurfaceFilter::CreateEmptyDistanceImage()
 {
@@ -104,7 +159,14 @@ void mitk::CreateDistanceImageFromSurfaceFilter::CreateEmptyDistanceImage()
 }
 
 mitk::CreateDistanceImageFromSurfaceFilter::CreateDistanceImageFromSurfaceFilter()
-  : m_DistanceImageSpacing(0.0), m_DistanceImageDefaultBufferValue(0.0)
+  : m_InterpolationMethod(InterpolationMethod::Dense),
+    m_MaximumNumberOfDenseContourPoints(1000),
+    m_SupportRadius(0.0),
+    m_UseCompactSupport(false),
+    m_UsedSupportRadius(0.0),
+    m_CenterGridCellSize(1.0),
+    m_DistanceImageSpacing(0.0),
+    m_DistanceImageDefaultBufferValue(0.0)
 {
   m_DistanceImageVolume = 50000;
   this->m_UseProgressBar = false;
@@ -123,13 +185,27 @@ void mitk::CreateDistanceImageFromSurfaceFilter::GenerateData()
   this->PreprocessContourPoints();
   this->CreateEmptyDistanceImage();
 
+  m_UseCompactSupport = m_InterpolationMethod == InterpolationMethod::CompactlySupported ||
+                        (m_InterpolationMethod == InterpolationMethod::Automatic &&
+                         m_Centers.size() > m_MaximumNumberOfDenseContourPoints);
+
+  if (m_UseCompactSupport)
+    m_UsedSupportRadius = this->DetermineSupportRadius();
+
   // First of all we have to build the equation-system from the existing contour-edge-points
   this->CreateSolutionMatrixAndFunctionValues();
 
   if (this->m_UseProgressBar)
     mitk::ProgressBar::GetInstance()->Progress(1);
 
-  m_Weights = m_SolutionMatrix.partialPivLu().solve(m_FunctionValues);
+  if (m_UseCompactSupport)
+  {
+    this->SolveCompactlySupportedSystem();
+  }
+  else
+  {
+    m_Weights = m_SolutionMatrix.partialPivLu().solve(m_FunctionValues);
+  }
 
   if (this->m_UseProgressBar)
     mitk::ProgressBar::GetInstance()->Progress(2);
@@ -142,6 +218,8 @@ void mitk::CreateDistanceImageFromSurfaceFilter::GenerateData()
 
   m_Centers.clear();
   m_Normals.clear();
+  m_InputOfCenter.clear();
+  m_CenterGrid.clear();
 }
 
 void mitk::CreateDistanceImageFromSurfaceFilter::PreprocessContourPoints()
@@ -167,6 +245,8 @@ void mitk::CreateDistanceImageFromSurfaceFilter::PreprocessContourPoints()
   PointType currentPoint;
   PointType normal;
 
+  std::unordered_set<std::array<double, 3>, ContourPointHash> existingCenters;
+
   for (unsigned int i = 0; i < numberOfInputs; i++)
   {
     auto currentSurface = this->GetInput(i);
@@ -198,9 +278,7 @@ void mitk::CreateDistanceImageFromSurfaceFilter::PreprocessContourPoints()
 
         currentPoint.copy_in(p);
 
-        int count = std::count(m_Centers.begin(), m_Centers.end(), currentPoint);
-
-        if (count == 0)
+        if (existingCenters.insert({ { p[0], p[1], p[2] } }).second)
         {
           double currentNormal[3];
           currentCellNormals->GetTuple(cell[j], currentNormal);
@@ -210,6 +288,8 @@ void mitk::CreateDistanceImageFromSurfaceFilter::PreprocessContourPoints()
           m_Normals.push_back(normal);
 
           m_Centers.push_back(currentPoint);
+
+          m_InputOfCenter.push_back(i);
         }
 
       } // end for all points
@@ -241,6 +321,7 @@ void mitk::CreateDistanceImageFromSurfaceFilter::CreateSolutionMatrixAndFunction
     currentPoint[2] = currentPoint[2] - normal[2] * m_DistanceImageSpacing;
 
     m_Centers.push_back(currentPoint);
+    m_InputOfCenter.push_back(m_InputOfCenter.at(i));
 
     m_FunctionValues[numberOfCenters + i] = -m_DistanceImageSpacing;
   }
@@ -256,33 +337,193 @@ void mitk::CreateDistanceImageFromSurfaceFilter::CreateSolutionMatrixAndFunction
     currentPoint[2] = currentPoint[2] + normal[2] * m_DistanceImageSpacing;
 
     m_Centers.push_back(currentPoint);
+    m_InputOfCenter.push_back(m_InputOfCenter.at(i));
 
     m_FunctionValues[numberOfCenters * 2 + i] = m_DistanceImageSpacing;
   }
 
   // Now we have created all centers and all function values. Next step is to create the solution matrix
-  numberOfCenters = m_Centers.size();
+  m_Weights.resize(m_Centers.size());
+
+  if (!m_UseCompactSupport)
+    this->CreateDenseSolutionMatrix();
+}
+
+void mitk::CreateDistanceImageFromSurfaceFilter::CreateDenseSolutionMatrix()
+{
+  const auto numberOfCenters = m_Centers.size();
 
   m_SolutionMatrix.resize(numberOfCenters, numberOfCenters);
 
-  m_Weights.resize(numberOfCenters);
+  // Calculate the RBF value. Currently using Phi(r) = r with r is the euclidean distance between two points
+  itk::MultiThreaderBase::New()->ParallelizeArray(
+    0,
+    numberOfCenters,
+    [this, numberOfCenters](itk::SizeValueType i) {
+      const PointType &p1 = m_Centers[i];
+      for (std::size_t j = 0; j < numberOfCenters; ++j)
+      {
+        m_SolutionMatrix(i, j) = (p1 - m_Centers[j]).two_norm();
+      }
+    },
+    nullptr);
+}
 
-  PointType p1;
-  PointType p2;
-  double norm;
+void mitk::CreateDistanceImageFromSurfaceFilter::BuildCenterGrid(double cellSize)
+{
+  m_CenterGrid.clear();
+  m_CenterGridCellSize = cellSize;
 
-  for (unsigned int i = 0; i < numberOfCenters; i++)
+  for (unsigned int i = 0; i < m_Centers.size(); ++i)
   {
-    for (unsigned int j = 0; j < numberOfCenters; j++)
-    {
-      // Calculate the RBF value. Currently using Phi(r) = r with r is the euclidean distance between two points
-      p1 = m_Centers.at(i);
-      p2 = m_Centers.at(j);
-      p1 = p1 - p2;
-      norm = p1.two_norm();
-      m_SolutionMatrix(i, j) = norm;
-    }
+    const auto cell = GetCenterGridCell(m_Centers[i], cellSize);
+    m_CenterGrid[GetCenterGridKey(cell[0], cell[1], cell[2])].push_back(i);
+  }
+}
+
+double mitk::CreateDistanceImageFromSurfaceFilter::DetermineSupportRadius()
+{
+  if (m_SupportRadius > 0.0)
+    return m_SupportRadius;
+
+  // The support has to contain the off-surface points and should bridge the gaps between the contours
+  const double minimumSupportRadius = 4.0 * m_DistanceImageSpacing;
+
+  if (m_Centers.empty())
+    return 10.0 * m_DistanceImageSpacing;
+
+  // One point locator per contour, so the nearest point of each other contour is a single query
+  const auto numberOfCenters = m_Centers.size();
+  const unsigned int numberOfContours = *std::max_element(m_InputOfCenter.cbegin(), m_InputOfCenter.cend()) + 1;
+
+  std::vector<vtkSmartPointer<vtkPoints>> contourPoints(numberOfContours);
+  for (auto &points : contourPoints)
+    points = vtkSmartPointer<vtkPoints>::New();
+
+  for (std::size_t i = 0; i < numberOfCenters; ++i)
+    contourPoints[m_InputOfCenter[i]]->InsertNextPoint(m_Centers[i].data_block());
+
+  std::vector<vtkSmartPointer<vtkStaticPointLocator>> locators;
+  std::vector<unsigned int> contourOfLocator;
+  for (unsigned int contour = 0; contour < numberOfContours; ++contour)
+  {
+    if (contourPoints[contour]->GetNumberOfPoints() == 0)
+      continue;
+
+    auto dataSet = vtkSmartPointer<vtkPolyData>::New();
+    dataSet->SetPoints(contourPoints[contour]);
+
+    auto locator = vtkSmartPointer<vtkStaticPointLocator>::New();
+    locator->SetDataSet(dataSet);
+    locator->BuildLocator();
+
+    locators.push_back(locator);
+    contourOfLocator.push_back(contour);
+  }
+
+  std::vector<double> distanceToOtherContour(numberOfCenters, std::numeric_limits<double>::infinity());
+
+  // FindClosestPoint() of a built vtkStaticPointLocator is thread-safe
+  itk::MultiThreaderBase::New()->ParallelizeArray(
+    0,
+    numberOfCenters,
+    [&](itk::SizeValueType i) {
+      const auto &center = m_Centers[i];
+      double nearest = std::numeric_limits<double>::infinity();
+
+      for (std::size_t l = 0; l < locators.size(); ++l)
+      {
+        if (contourOfLocator[l] == m_InputOfCenter[i])
+          continue;
+
+        double closestPoint[3];
+        const auto id = locators[l]->FindClosestPoint(center.data_block());
+        locators[l]->GetDataSet()->GetPoint(id, closestPoint);
+        nearest = std::min(nearest, (center - PointType(closestPoint)).two_norm());
+      }
+
+      distanceToOtherContour[i] = nearest;
+    },
+    nullptr);
+
+  distanceToOtherContour.erase(std::remove_if(distanceToOtherContour.begin(),
+                                              distanceToOtherContour.end(),
+                                              [](double distance) { return std::isinf(distance); }),
+                               distanceToOtherContour.end());
+
+  if (distanceToOtherContour.empty())
+    return 10.0 * m_DistanceImageSpacing;
+
+  auto percentile = distanceToOtherContour.begin() + (distanceToOtherContour.size() * 9) / 10;
+  if (percentile == distanceToOtherContour.end())
+    --percentile;
+  std::nth_element(distanceToOtherContour.begin(), percentile, distanceToOtherContour.end());
+
+  return std::max(2.0 * (*percentile), minimumSupportRadius);
+}
+
+void mitk::CreateDistanceImageFromSurfaceFilter::SolveCompactlySupportedSystem()
+{
+  typedef Eigen::Triplet<double> TripletType;
+
+  const auto numberOfCenters = m_Centers.size();
+  const double supportRadius = m_UsedSupportRadius;
+
+  this->BuildCenterGrid(supportRadius);
+
+  // Each row only has entries for the centers within the support radius
+  std::vector<std::vector<TripletType>> rows(numberOfCenters);
+
+  itk::MultiThreaderBase::New()->ParallelizeArray(
+    0,
+    numberOfCenters,
+    [&](itk::SizeValueType i) {
+      const auto cell = GetCenterGridCell(m_Centers[i], supportRadius);
+      for (std::int64_t x = -1; x <= 1; ++x)
+      {
+        for (std::int64_t y = -1; y <= 1; ++y)
+        {
+          for (std::int64_t z = -1; z <= 1; ++z)
+          {
+            const auto gridCell = m_CenterGrid.find(GetCenterGridKey(cell[0] + x, cell[1] + y, cell[2] + z));
+            if (gridCell == m_CenterGrid.end())
+              continue;
+
+            for (auto j : gridCell->second)
+            {
+              const double value = Wendland((m_Centers[i] - m_Centers[j]).two_norm() / supportRadius);
+              if (value > 0.0)
+                rows[i].emplace_back(static_cast<int>(i), static_cast<int>(j), value);
+            }
+          }
+        }
+      }
+    },
+    nullptr);
+
+  std::vector<TripletType> triplets;
+  for (const auto &row : rows)
+    triplets.insert(triplets.end(), row.cbegin(), row.cend());
+
+  Eigen::SparseMatrix<double> solutionMatrix(numberOfCenters, numberOfCenters);
+  solutionMatrix.setFromTriplets(triplets.begin(), triplets.end());
+
+  Eigen::SimplicialLDLT<Eigen::SparseMatrix<double>> solver(solutionMatrix);
+
+  if (solver.info() == Eigen::Success)
+  {
+    m_Weights = solver.solve(m_FunctionValues);
+
+    if (solver.info() == Eigen::Success)
+      return;
   }
+
+  MITK_WARN << "mitk::CreateDistanceImageFromSurfaceFilter: The compactly supported interpolation could not be "
+               "solved. Falling back to the dense interpolation.";
+
+  m_UseCompactSupport = false;
+  this->CreateDenseSolutionMatrix();
+  m_Weights = m_SolutionMatrix.partialPivLu().solve(m_FunctionValues);
 }
 
 void mitk::CreateDistanceImageFromSurfaceFilter::FillDistanceImage()
@@ -291,19 +532,18 @@ void mitk::CreateDistanceImageFromSurfaceFilter::FillDistanceImage()
   * Now we must calculate the distance for each pixel. But instead of calculating the distance value
   * for all of the image's pixels we proceed similar to the region growing algorithm:
   *
-  * 1. Take the first pixel from the narrowband_point_list and calculate the distance for each neighbor (6er)
-  * 2. If the current index's distance value is below a certain threshold push it into the list
-  * 3. Next iteration take the next index from the list and originAsIndex with 1. again
+  * 1. Take the pixels of the current narrow band front and collect their unvisited neighbors (6er)
+  * 2. Calculate the distances of all these neighbors in parallel
+  * 3. Neighbors whose distance value is below a certain threshold form the next front
   *
-  * This is done until the narrowband_point_list is empty.
+  * This is done until the front is empty. The result is the same as growing pixel by pixel.
   */
 
   typedef itk::ImageRegionIteratorWithIndex<DistanceImageType> ImageIterator;
-  typedef itk::NeighborhoodIterator<DistanceImageType> NeighborhoodImageIterator;
 
-  std::queue<DistanceImageType::IndexType> narrowbandPoints;
   PointType currentPoint = m_Centers.at(0);
-  double distance = this->CalculateDistanceValue(currentPoint);
+  bool isInNarrowBand = true;
+  double distance = this->CalculateDistanceValue(currentPoint, isInNarrowBand);
 
   // create itk::Point from vnl_vector
   DistanceImageType::PointType currentPointAsPoint;
@@ -314,49 +554,80 @@ void mitk::CreateDistanceImageFromSurfaceFilter::FillDistanceImage()
   // Transform the input point in world-coordinates to index-coordinates
   auto currentIndex = m_DistanceImageITK->TransformPhysicalPointToIndex(currentPointAsPoint);
 
-  assert(
-    m_DistanceImageITK->GetLargestPossibleRegion().IsInside(currentIndex)); // we are quite certain this should hold
+  const auto region = m_DistanceImageITK->GetLargestPossibleRegion();
+  assert(region.IsInside(currentIndex)); // we are quite certain this should hold
 
-  narrowbandPoints.push(currentIndex);
   m_DistanceImageITK->SetPixel(currentIndex, distance);
 
-  NeighborhoodImageIterator::RadiusType radius;
-  radius.Fill(1);
-  NeighborhoodImageIterator nIt(radius, m_DistanceImageITK, m_DistanceImageITK->GetLargestPossibleRegion());
-  unsigned int relativeNbIdx[] = {4, 10, 12, 14, 16, 22};
+  // Pixels that were already checked are never checked again, as their distance does not change
+  std::vector<bool> visited(region.GetNumberOfPixels(), false);
+  visited[m_DistanceImageITK->ComputeOffset(currentIndex)] = true;
 
-  bool isInBounds = false;
-  while (!narrowbandPoints.empty())
+  std::vector<IndexType> front = { currentIndex };
+  std::vector<IndexType> neighbors;
+  std::vector<double> distances;
+  std::vector<char> accepted;
+
+  auto multiThreader = itk::MultiThreaderBase::New();
+
+  while (!front.empty())
   {
-    nIt.SetLocation(narrowbandPoints.front());
-    narrowbandPoints.pop();
+    neighbors.clear();
 
-    unsigned int *relativeNb = &relativeNbIdx[0];
-    for (int i = 0; i < 6; i++)
+    for (const auto &index : front)
     {
-      nIt.GetPixel(*relativeNb, isInBounds);
-      if (isInBounds && nIt.GetPixel(*relativeNb) == m_DistanceImageDefaultBufferValue)
+      for (unsigned int dim = 0; dim < 3; ++dim)
       {
-        currentIndex = nIt.GetIndex(*relativeNb);
+        for (int step = -1; step <= 1; step += 2)
+        {
+          auto neighbor = index;
+          neighbor[dim] += step;
+
+          if (!region.IsInside(neighbor))
+            continue;
+
+          const auto offset = m_DistanceImageITK->ComputeOffset(neighbor);
+          if (!visited[offset])
+          {
+            visited[offset] = true;
+            neighbors.push_back(neighbor);
+          }
+        }
+      }
+    }
+
+    distances.resize(neighbors.size());
+    accepted.resize(neighbors.size());
 
-        // Transform the currently checked point from index-coordinates to
-        // world-coordinates
-        m_DistanceImageITK->TransformIndexToPhysicalPoint(currentIndex, currentPointAsPoint);
+    multiThreader->ParallelizeArray(
+      0,
+      neighbors.size(),
+      [&](itk::SizeValueType i) {
+        // Transform the currently checked point from index-coordinates to world-coordinates
+        DistanceImageType::PointType neighborAsPoint;
+        m_DistanceImageITK->TransformIndexToPhysicalPoint(neighbors[i], neighborAsPoint);
 
-        // create a vnl_vector
-        currentPoint[0] = currentPointAsPoint[0];
-        currentPoint[1] = currentPointAsPoint[1];
-        currentPoint[2] = currentPointAsPoint[2];
+        PointType neighborPoint;
+        neighborPoint[0] = neighborAsPoint[0];
+        neighborPoint[1] = neighborAsPoint[1];
+        neighborPoint[2] = neighborAsPoint[2];
 
         // and check the distance
-        distance = this->CalculateDistanceValue(currentPoint);
-        if (std::fabs(distance) <= m_DistanceImageSpacing * 2)
-        {
-          nIt.SetPixel(*relativeNb, distance);
-          narrowbandPoints.push(currentIndex);
-        }
+        bool isNeighborInNarrowBand = true;
+        distances[i] = this->CalculateDistanceValue(neighborPoint, isNeighborInNarrowBand);
+        accepted[i] = isNeighborInNarrowBand && std::fabs(distances[i]) <= m_DistanceImageSpacing * 2;
+      },
+      nullptr);
+
+    front.clear();
+
+    for (std::size_t i = 0; i < neighbors.size(); ++i)
+    {
+      if (accepted[i])
+      {
+        m_DistanceImageITK->SetPixel(neighbors[i], distances[i]);
+        front.push_back(neighbors[i]);
       }
-      relativeNb++;
     }
   }
 
@@ -417,23 +688,52 @@ void mitk::CreateDistanceImageFromSurfaceFilter::FillDistanceImage()
   CastToMitkImage(m_DistanceImageITK, resultImage);
 }
 
-double mitk::CreateDistanceImageFromSurfaceFilter::CalculateDistanceValue(PointType p)
+double mitk::CreateDistanceImageFromSurfaceFilter::CalculateDistanceValue(const PointType &p,
+                                                                          bool &isInNarrowBand) const
 {
   double distanceValue(0);
-  PointType p1;
-  PointType p2;
-  double norm;
 
-  CenterList::iterator centerIter;
+  if (m_UseCompactSupport)
+  {
+    // Only the centers in the neighboring grid cells (cell size = support radius) contribute
+    const auto cell = GetCenterGridCell(p, m_CenterGridCellSize);
+    double nearestCenter = std::numeric_limits<double>::infinity();
+
+    for (std::int64_t x = -1; x <= 1; ++x)
+    {
+      for (std::int64_t y = -1; y <= 1; ++y)
+      {
+        for (std::int64_t z = -1; z <= 1; ++z)
+        {
+          const auto gridCell = m_CenterGrid.find(GetCenterGridKey(cell[0] + x, cell[1] + y, cell[2] + z));
+          if (gridCell == m_CenterGrid.end())
+            continue;
+
+          for (auto i : gridCell->second)
+          {
+            const double norm = (p - m_Centers[i]).two_norm();
+            nearestCenter = std::min(nearestCenter, norm);
+            distanceValue += Wendland(norm / m_UsedSupportRadius) * m_Weights[i];
+          }
+        }
+      }
+    }
+
+    // Far from all centers the function vanishes, which must not be taken as surface
+    isInNarrowBand = nearestCenter <= 0.5 * m_UsedSupportRadius;
+    return distanceValue;
+  }
+
+  isInNarrowBand = true;
 
-  unsigned int count(0);
-  for (centerIter = m_Centers.begin(); centerIter != m_Centers.end(); centerIter++)
+  const auto numberOfCenters = m_Centers.size();
+  for (std::size_t i = 0; i < numberOfCenters; ++i)
   {
-    p1 = *centerIter;
-    p2 = p - p1;
-    norm = p2.two_norm();
-    distanceValue = distanceValue + (norm * m_Weights[count]);
-    ++count;
+    const auto &center = m_Centers[i];
+    const double dx = p[0] - center[0];
+    const double dy = p[1] - center[1];
+    const double dz = p[2] - center[2];
+    distanceValue = distanceValue + (std::sqrt(dx * dx + dy * dy + dz * dz) * m_Weights[i]);
   }
   return distanceValue;
 }
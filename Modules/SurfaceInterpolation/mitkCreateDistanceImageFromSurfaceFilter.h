@@ -25,6 +25,9 @@ found in the LICENSE file.
 
 #include <itkeigen/Eigen/Dense>
 
+#include <cstdint>
+#include <unordered_map>
+
 namespace mitk
 {
   /**
@@ -57,6 +60,12 @@ namespace mitk
          adjusted by calling SetDistanceImageVolume(unsigned int volume) which specifies the number ob pixels enclosed
   by the image.
 
+         The dense interpolation (Phi(r) = r) needs a LU decomposition of a full matrix over all centers and evaluates
+         all centers for each pixel. For many contours the compactly supported interpolation can be used instead
+         (see SetInterpolationMethod()). It uses Wendland's C2 function, whose sparse system is solved by a Cholesky
+         decomposition, and only evaluates the centers within the support radius of a pixel. Pixels without a contour
+         point within half of the support radius are treated as outside of the narrow band.
+
   \ingroup Process
 
   $Author: fetzer$
@@ -74,6 +83,16 @@ namespace mitk
 
     typedef std::vector<Surface::Pointer> SurfaceList;
 
+    enum class InterpolationMethod
+    {
+      /** Phi(r) = r, dense equation system. Cubic in the number of contour points. */
+      Dense,
+      /** Wendland's compactly supported C2 function, sparse equation system. */
+      CompactlySupported,
+      /** Dense for up to GetMaximumNumberOfDenseContourPoints() contour points, compactly supported otherwise. */
+      Automatic
+    };
+
     mitkClassMacro(CreateDistanceImageFromSurfaceFilter, ImageSource);
     itkFactorylessNewMacro(Self);
     itkCloneMacro(Self);
@@ -99,6 +118,23 @@ namespace mitk
     */
     itkSetMacro(DistanceImageVolume, unsigned int);
 
+    /**
+    \brief Set how the distance function is interpolated. Default is InterpolationMethod::Dense.
+    */
+    itkSetEnumMacro(InterpolationMethod, InterpolationMethod);
+    itkGetEnumMacro(InterpolationMethod, InterpolationMethod);
+
+    itkSetMacro(MaximumNumberOfDenseContourPoints, unsigned int);
+    itkGetConstMacro(MaximumNumberOfDenseContourPoints, unsigned int);
+
+    /**
+    \brief Set the support radius (in mm) of the compactly supported interpolation.
+           If it is 0 (default), it is derived from the distances between the contours, as the support has to
+           bridge the gaps between them.
+    */
+    itkSetMacro(SupportRadius, double);
+    itkGetConstMacro(SupportRadius, double);
+
     void PrintEquationSystem();
 
     // Resets the filter, i.e. removes all inputs and outputs
@@ -128,7 +164,20 @@ namespace mitk
 
   private:
     void CreateSolutionMatrixAndFunctionValues();
-    double CalculateDistanceValue(PointType p);
+    void SolveCompactlySupportedSystem();
+
+    /**
+    * \brief Evaluates the interpolated distance function. Thread-safe.
+    * \param isInNarrowBand false if p is too far from the contour points to be evaluated (only compactly supported)
+    */
+    double CalculateDistanceValue(const PointType &p, bool &isInNarrowBand) const;
+
+    /** \brief Derives the support radius from the distance of each contour point to the nearest point of another
+    * contour (90th percentile), if no support radius is set. */
+    double DetermineSupportRadius();
+
+    void BuildCenterGrid(double cellSize);
+    void CreateDenseSolutionMatrix();
 
     void FillDistanceImage();
 
@@ -158,6 +207,20 @@ namespace mitk
     CenterList m_Centers;
     NormalList m_Normals;
 
+    /** Index of the input each center was extracted from */
+    std::vector<unsigned int> m_InputOfCenter;
+
+    InterpolationMethod m_InterpolationMethod;
+    unsigned int m_MaximumNumberOfDenseContourPoints;
+    double m_SupportRadius;
+
+    bool m_UseCompactSupport;
+    double m_UsedSupportRadius;
+
+    /** Uniform grid (cell size m_CenterGridCellSize) of the center indices for neighborhood queries */
+    std::unordered_map<std::uint64_t, std::vector<unsigned int>> m_CenterGrid;
+    double m_CenterGridCellSize;
+
     Eigen::MatrixXd m_SolutionMatrix;
     Eigen::VectorXd m_FunctionValues;
     Eigen::VectorXd m_Weights;
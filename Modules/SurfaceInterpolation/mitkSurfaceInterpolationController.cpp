@@ -493,6 +493,7 @@ void mitk::SurfaceInterpolationController::Interpolate(const LabelSetImage* segm
   reduceFilter->SetMaxSpacing(maxSpacing);
   normalsFilter->SetMaxSpacing(maxSpacing);
   interpolateSurfaceFilter->SetDistanceImageVolume(m_DistanceImageVolume);
+  interpolateSurfaceFilter->SetInterpolationMethod(CreateDistanceImageFromSurfaceFilter::InterpolationMethod::Automatic);
 
   reduceFilter->SetUseProgressBar(false);
   normalsFilter->SetUseProgressBar(true);
@@ -54,6 +54,10 @@ found in the LICENSE file.
 #include <mapExceptionObjectMacros.h>
 #include <mapConvert.h>
 #include <mapDeploymentDLLAccess.h>
+#include <mapMetaPropertyAlgorithmInterface.h>
+
+#include <memory>
+#include <mutex>
 
 const std::string QmitkMatchPointFrameCorrection::VIEW_ID =
   "org.mitk.views.matchpoint.algorithm.framereg";
@@ -474,6 +478,49 @@ void QmitkMatchPointFrameCorrection::OnFramesInvertPushed()
   }
 };
 
+mitk::TimeFramesRegistrationHelper::AlgorithmProviderType
+QmitkMatchPointFrameCorrection::GenerateAlgorithmProvider() const
+{
+  using MetaInterfaceType = ::map::algorithm::facet::MetaPropertyAlgorithmInterface;
+
+  auto* configuredInterface = dynamic_cast<MetaInterfaceType*>(m_LoadedAlgorithm.GetPointer());
+
+  if (nullptr == configuredInterface || m_LoadedDLLHandle.IsNull())
+  {
+    // the configuration cannot be transferred to further instances, so frames are processed sequentially
+    return mitk::TimeFramesRegistrationHelper::AlgorithmProviderType();
+  }
+
+  ::map::algorithm::RegistrationAlgorithmBase::Pointer configuredAlgorithm = m_LoadedAlgorithm;
+  ::map::deployment::DLLHandle::Pointer dllHandle = m_LoadedDLLHandle;
+  auto mutex = std::make_shared<std::mutex>();
+
+  return [configuredAlgorithm, dllHandle, mutex]()
+  {
+    std::lock_guard<std::mutex> lock(*mutex);
+
+    ::map::algorithm::RegistrationAlgorithmBase::Pointer algorithm =
+      ::map::deployment::getRegistrationAlgorithm(dllHandle);
+    auto* configuredInterface = dynamic_cast<MetaInterfaceType*>(configuredAlgorithm.GetPointer());
+    auto* algorithmInterface = dynamic_cast<MetaInterfaceType*>(algorithm.GetPointer());
+
+    if (nullptr == algorithmInterface)
+    {
+      return ::map::algorithm::RegistrationAlgorithmBase::Pointer();
+    }
+
+    for (const auto& info : configuredInterface->getPropertyInfos())
+    {
+      if (info->isReadable() && info->isWritable())
+      {
+        algorithmInterface->setProperty(info->getName(), configuredInterface->getProperty(info));
+      }
+    }
+
+    return algorithm;
+  };
+}
+
 mitk::TimeFramesRegistrationHelper::IgnoreListType
 QmitkMatchPointFrameCorrection::GenerateIgnoreList() const
 {
@@ -530,6 +577,7 @@ void QmitkMatchPointFrameCorrection::OnStartRegBtnPushed()
   pJob->m_spTargetData = m_spSelectedTargetData;
   pJob->m_TargetDataUID = mitk::EnsureUID(this->m_spSelectedTargetNode->GetData());
   pJob->m_IgnoreList = this->GenerateIgnoreList();
+  pJob->m_AlgorithmProvider = this->GenerateAlgorithmProvider();
 
   if (m_spSelectedTargetMaskData.IsNotNull())
   {
@@ -130,6 +130,10 @@ private:
   /**generates the ignore list based on the frame list widget selection.*/
   mitk::TimeFramesRegistrationHelper::IgnoreListType GenerateIgnoreList() const;
 
+  /** Returns a provider that creates further instances of the loaded algorithm with its current
+  configuration, so that the frames can be registered concurrently.*/
+  mitk::TimeFramesRegistrationHelper::AlgorithmProviderType GenerateAlgorithmProvider() const;
+
   /** Methods returns a list of all nodes in the data manager containing a registration wrapper.
     * The list may be empty.*/
   mitk::DataStorage::SetOfObjects::Pointer GetRegNodes() const;
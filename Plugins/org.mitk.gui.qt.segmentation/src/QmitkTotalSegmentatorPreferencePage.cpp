@@ -12,6 +12,7 @@ found in the LICENSE file.
 
 #include "QmitkTotalSegmentatorPreferencePage.h"
 #include <mitkCoreServices.h>
+#include <mitkInferenceWorker.h>
 #include <mitkIPreferences.h>
 #include <mitkIPreferencesService.h>
 #include <QApplication>
@@ -97,7 +98,15 @@ void QmitkTotalSegmentatorPreferencePage::CreateQtControl(QWidget *parent)
     m_IsInstalled = false;
   }
 
+  const bool isInferenceWorkerSupported = mitk::InferenceWorker::IsSupported();
+  m_Ui->inferenceWorkerLabel->setVisible(isInferenceWorkerSupported);
+  m_Ui->inferenceWorkerLineEdit->setVisible(isInferenceWorkerSupported);
+  m_Ui->inferenceWorkerButton->setVisible(isInferenceWorkerSupported);
+  m_Ui->inferenceWorkerLineEdit->setText(
+    QString::fromStdString(m_Preferences->Get("TotalSeg/inferenceWorkerScript", "")));
+
   connect(m_Ui->installTotalButton, SIGNAL(clicked()), this, SLOT(OnInstallButtonClicked()));
+  connect(m_Ui->inferenceWorkerButton, SIGNAL(clicked()), this, SLOT(OnInferenceWorkerButtonClicked()));
   connect(m_Ui->clearTotalbutton, SIGNAL(clicked()), this, SLOT(OnClearButtonClicked()));
   connect(m_Ui->overrideBox, SIGNAL(stateChanged(int)), this, SLOT(OnOverrideBoxChecked(int)));
   connect(m_Ui->customEnvComboBox,
@@ -126,6 +135,7 @@ bool QmitkTotalSegmentatorPreferencePage::PerformOk()
   m_Preferences->Put("TotalSeg/sysPythonPath", m_SysPythonPath.toStdString());
   m_Preferences->PutBool("TotalSeg/isCustomInstall", m_Ui->overrideBox->isChecked());
   m_Preferences->PutInt("TotalSeg/deviceId", this->FetchSelectedDeviceFromUI());
+  m_Preferences->Put("TotalSeg/inferenceWorkerScript", m_Ui->inferenceWorkerLineEdit->text().trimmed().toStdString());
   this->UpdateTotalSegPreferencePath();
   return true;
 }
@@ -256,6 +266,16 @@ void QmitkTotalSegmentatorPreferencePage::OnPythonPathChanged(const QString &pyE
   this->UpdateStatusLabel();
 }
 
+void QmitkTotalSegmentatorPreferencePage::OnInferenceWorkerButtonClicked()
+{
+  QString path = QFileDialog::getOpenFileName(
+    m_Ui->inferenceWorkerButton->parentWidget(), "Inference Worker Script", QString(), "Python (*.py)");
+  if (!path.isEmpty())
+  {
+    m_Ui->inferenceWorkerLineEdit->setText(path);
+  }
+}
+
 void QmitkTotalSegmentatorPreferencePage::OnSystemPythonChanged(const QString &pyEnv)
 {
   if (pyEnv == QString("Select..."))
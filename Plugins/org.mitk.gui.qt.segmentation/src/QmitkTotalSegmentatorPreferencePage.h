@@ -135,6 +135,11 @@ protected slots:
    * @brief Qt Slot
    */
   void OnInstallButtonClicked();
+
+  /**
+   * @brief Qt Slot
+   */
+  void OnInferenceWorkerButtonClicked();
 };
 
 #endif